@@ -222,6 +222,18 @@ typedef enum
 #define sEE_I2C_SDA_SOURCE               GPIO_PinSource7
 #define sEE_I2C_SDA_AF                   GPIO_AF_1
 
+#define sEE_I2C_IRQn                     I2C1_IRQn
+
+/* DMA channels of the asynchronous transfers (channels 2/3 serve the board SPI) */
+#define sEE_I2C_DMA                      DMA
+#define sEE_I2C_DMA_CLK                  RCC_AHBPeriph_DMA
+#define sEE_I2C_DMA_CHANNEL_TX           DMA_Channel6
+#define sEE_I2C_DMA_REMAP_TX             DMA_CSELR_CH6_I2C1_TX
+#define sEE_I2C_DMA_FLAG_TX_GL           DMA1_FLAG_GL6
+#define sEE_I2C_DMA_CHANNEL_RX           DMA_Channel7
+#define sEE_I2C_DMA_REMAP_RX             DMA_CSELR_CH7_I2C1_RX
+#define sEE_I2C_DMA_FLAG_RX_GL           DMA1_FLAG_GL7
+
 /**
   * @}
   */
@@ -264,6 +276,32 @@ typedef enum
 #define SD_DETECT_EXTI_PORT_SOURCE       EXTI_PortSourceGPIOB
 #define SD_DETECT_EXTI_IRQn              EXTI4_15_IRQn
 
+/**
+  * @}
+  */
+
+/** @addtogroup HK32FL0XX_EVAL_LOW_LEVEL_SPI_DMA
+  * @{
+  */
+/**
+  * @brief  DMA channels serving the board SPI (shared by the SD card and the SPI FLASH)
+  */
+#define EVAL_SPI                         SPI1
+#define EVAL_SPI_DMA                     DMA
+#define EVAL_SPI_DMA_CLK                 RCC_AHBPeriph_DMA
+
+#define EVAL_SPI_RX_DMA_CHANNEL          DMA_Channel2
+#define EVAL_SPI_RX_DMA_REMAP            DMA_CSELR_CH2_SPI1_RX
+#define EVAL_SPI_RX_DMA_FLAG_TC          DMA1_FLAG_TC2
+#define EVAL_SPI_RX_DMA_FLAG_TE          DMA1_FLAG_TE2
+#define EVAL_SPI_RX_DMA_FLAG_GL          DMA1_FLAG_GL2
+
+#define EVAL_SPI_TX_DMA_CHANNEL          DMA_Channel3
+#define EVAL_SPI_TX_DMA_REMAP            DMA_CSELR_CH3_SPI1_TX
+#define EVAL_SPI_TX_DMA_FLAG_GL          DMA1_FLAG_GL3
+
+#define EVAL_SPI_DMA_IRQn                DMA_CH2_3_IRQn
+
 /* Exported functions ------------------------------------------------------- */
 /** @defgroup HK32FL0XX_EVAL_LOW_LEVEL_Exported_Functions
   * @{
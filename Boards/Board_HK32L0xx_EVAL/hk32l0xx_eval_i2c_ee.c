@@ -21,6 +21,12 @@
 *             @note In this driver, basic read and write functions (sEE_ReadBuffer
 *             and sEE_WritePage) use Polling mode to perform the data transfer
 *             to/from EEPROM memory.
+*             @note The asynchronous functions (sEE_Submit, sEE_ReadBufferAsync
+*             and sEE_WriteBufferAsync) move the data by DMA under control of
+*             the I2C interrupt, split writes on page boundaries and poll the
+*             write cycle end from sEE_AsyncTick(), so the CPU is free during
+*             the transfers. They must not be mixed with the polling functions
+*             while a transfer is pending.
 *             +-----------------------------------------------------------------+
 *             |                        Pin assignment                           |
 *             +---------------------------------------+-----------+-------------+
@@ -63,13 +69,45 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+/* Asynchronous engine states */
+#define sEE_STATE_IDLE            0   /* No transfer pending */
+#define sEE_STATE_ADDRESS         1   /* Memory address bytes sent from the TXIS interrupt */
+#define sEE_STATE_DATA            2   /* Payload moved by DMA */
+#define sEE_STATE_WAIT            3   /* Write cycle running, next tick polls the device */
+#define sEE_STATE_POLL            4   /* Device address sent to check the write cycle end */
+
+/* I2C interrupts used by the asynchronous engine, TXI is only enabled during
+   the memory address phase */
+#define sEE_I2C_IT                (I2C_IT_ERRI | I2C_IT_TCI | I2C_IT_STOPI | I2C_IT_NACKI)
+
+/* Largest NBYTES value, longer reads use the reload mode */
+#define sEE_MAX_NBYTES            255
+
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 __IO uint16_t  sEEAddress = 0;
 __IO uint32_t  sEETimeout = sEE_LONG_TIMEOUT;
 __IO uint16_t  sEEDataNum;
 
+static sEE_TransferTypeDef* sEE_Head = 0;
+static sEE_TransferTypeDef* sEE_Tail = 0;
+static __IO uint8_t sEE_State = sEE_STATE_IDLE;
+static uint8_t sEE_MemAddress[sEE_ADDRESS_BYTES];
+static uint8_t sEE_MemAddressIndex;
+static uint8_t sEE_Nack;
+static uint8_t sEE_Polls;
+static uint8_t sEE_Timer;
+static uint16_t sEE_Chunk;
+static uint16_t sEE_ReadLeft;
+
 /* Private function prototypes -----------------------------------------------*/
+static void sEE_StartAddress(void);
+static void sEE_StartData(void);
+static void sEE_StartPoll(void);
+static void sEE_Reload(uint8_t Number, uint32_t EndMode);
+static void sEE_StopDMA(void);
+static void sEE_Complete(sEE_TransferStatus Status);
+
 /* Private functions ---------------------------------------------------------*/
 
 
@@ -672,6 +710,518 @@ uint32_t sEE_WaitEepromStandbyState(void)
     return sEE_OK;
 }
 
+/**
+  * @brief  Starts the memory address phase of the transfer at the head of the
+  *         queue, at its current position.
+  * @note   A write is split on page boundaries: each page is sent as a
+  *         separate bus transaction followed by a write cycle.
+  * @param  None
+  * @retval None
+  */
+static void sEE_StartAddress(void)
+{
+    sEE_TransferTypeDef* Transfer = sEE_Head;
+    uint16_t Addr = Transfer->Address + Transfer->Count;
+
+#if (sEE_ADDRESS_BYTES == 1)
+    sEE_MemAddress[0] = (uint8_t)Addr;
+#else
+    sEE_MemAddress[0] = (uint8_t)((Addr & 0xFF00) >> 8);
+    sEE_MemAddress[1] = (uint8_t)(Addr & 0x00FF);
+#endif /* sEE_ADDRESS_BYTES */
+
+    Transfer->Status = sEE_TRANSFER_ACTIVE;
+    sEE_MemAddressIndex = 0;
+    sEE_Nack = 0;
+    sEE_Timer = sEE_ASYNC_TIMEOUT_TICKS;
+    sEE_State = sEE_STATE_ADDRESS;
+
+    I2C_ClearFlag(sEE_I2C, I2C_ICR_NACKCF | I2C_ICR_STOPCF);
+    I2C_ITConfig(sEE_I2C, sEE_I2C_IT | I2C_IT_TXI, ENABLE);
+
+    if (Transfer->Direction == sEE_DIRECTION_WRITE)
+    {
+        /* Bytes left in the current page */
+        sEE_Chunk = sEE_PAGESIZE - (Addr % sEE_PAGESIZE);
+
+        if (sEE_Chunk > (Transfer->Length - Transfer->Count))
+        {
+            sEE_Chunk = Transfer->Length - Transfer->Count;
+        }
+
+        /* The payload follows the address in the same transaction (TCR) */
+        I2C_TransferHandling(sEE_I2C, sEEAddress, sEE_ADDRESS_BYTES, I2C_Reload_Mode, I2C_Generate_Start_Write);
+    }
+    else
+    {
+        /* The read restarts once the address is sent (TC) */
+        I2C_TransferHandling(sEE_I2C, sEEAddress, sEE_ADDRESS_BYTES, I2C_SoftEnd_Mode, I2C_Generate_Start_Write);
+    }
+}
+
+/**
+  * @brief  Starts the DMA payload phase once the memory address is sent.
+  * @param  None
+  * @retval None
+  */
+static void sEE_StartData(void)
+{
+    sEE_TransferTypeDef* Transfer = sEE_Head;
+    DMA_InitTypeDef DMA_InitStructure;
+    uint16_t Chunk;
+
+    I2C_ITConfig(sEE_I2C, I2C_IT_TXI, DISABLE);
+
+    sEE_Timer = sEE_ASYNC_TIMEOUT_TICKS;
+    sEE_State = sEE_STATE_DATA;
+
+    DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)&Transfer->pBuffer[Transfer->Count];
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_Medium;
+    DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+
+    if (Transfer->Direction == sEE_DIRECTION_WRITE)
+    {
+        /* Page payload: buffer -> TXDR, then automatic STOP */
+        DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&sEE_I2C->TXDR;
+        DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralDST;
+        DMA_InitStructure.DMA_BufferSize = sEE_Chunk;
+        DMA_Init(sEE_I2C_DMA_CHANNEL_TX, &DMA_InitStructure);
+        DMA_Cmd(sEE_I2C_DMA_CHANNEL_TX, ENABLE);
+        I2C_DMACmd(sEE_I2C, I2C_DMAReq_Tx, ENABLE);
+
+        sEE_Reload((uint8_t)sEE_Chunk, I2C_AutoEnd_Mode);
+    }
+    else
+    {
+        /* Whole read in one DMA transfer, NBYTES reloaded every 255 bytes */
+        DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&sEE_I2C->RXDR;
+        DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
+        DMA_InitStructure.DMA_BufferSize = Transfer->Length;
+        DMA_Init(sEE_I2C_DMA_CHANNEL_RX, &DMA_InitStructure);
+        DMA_Cmd(sEE_I2C_DMA_CHANNEL_RX, ENABLE);
+        I2C_DMACmd(sEE_I2C, I2C_DMAReq_Rx, ENABLE);
+
+        Chunk = (Transfer->Length > sEE_MAX_NBYTES) ? sEE_MAX_NBYTES : Transfer->Length;
+        sEE_ReadLeft = Transfer->Length - Chunk;
+
+        I2C_TransferHandling(sEE_I2C, sEEAddress, (uint8_t)Chunk,
+                             (sEE_ReadLeft != 0) ? I2C_Reload_Mode : I2C_AutoEnd_Mode,
+                             I2C_Generate_Start_Read);
+    }
+}
+
+/**
+  * @brief  Addresses the EEPROM to check whether its write cycle is over.
+  * @note   The device does not acknowledge its address during the write cycle.
+  *         The result is collected on STOPF by sEE_I2C_IRQHandler().
+  * @param  None
+  * @retval None
+  */
+static void sEE_StartPoll(void)
+{
+    sEE_Nack = 0;
+    sEE_Timer = sEE_ASYNC_TIMEOUT_TICKS;
+    sEE_State = sEE_STATE_POLL;
+
+    I2C_ClearFlag(sEE_I2C, I2C_ICR_NACKCF | I2C_ICR_STOPCF);
+    I2C_TransferHandling(sEE_I2C, sEEAddress, 0, I2C_AutoEnd_Mode, I2C_Generate_Start_Write);
+}
+
+/**
+  * @brief  Continues the current transaction with the next block of bytes.
+  * @note   Unlike I2C_TransferHandling(), the transfer direction is kept.
+  *         Writing NBYTES clears TCR.
+  * @param  Number: number of bytes of the next block.
+  * @param  EndMode: I2C_Reload_Mode or I2C_AutoEnd_Mode.
+  * @retval None
+  */
+static void sEE_Reload(uint8_t Number, uint32_t EndMode)
+{
+    uint32_t tmpreg = sEE_I2C->CR2;
+
+    tmpreg &= (uint32_t)~((uint32_t)(I2C_CR2_NBYTES | I2C_CR2_RELOAD | I2C_CR2_AUTOEND));
+    tmpreg |= (uint32_t)(((uint32_t)Number << 16) & I2C_CR2_NBYTES) | EndMode;
+    sEE_I2C->CR2 = tmpreg;
+}
+
+/**
+  * @brief  Stops the DMA channels and releases the I2C DMA requests.
+  * @param  None
+  * @retval None
+  */
+static void sEE_StopDMA(void)
+{
+    I2C_DMACmd(sEE_I2C, I2C_DMAReq_Tx | I2C_DMAReq_Rx, DISABLE);
+    DMA_Cmd(sEE_I2C_DMA_CHANNEL_TX, DISABLE);
+    DMA_Cmd(sEE_I2C_DMA_CHANNEL_RX, DISABLE);
+    DMA_ClearFlag(sEE_I2C_DMA_FLAG_TX_GL | sEE_I2C_DMA_FLAG_RX_GL);
+}
+
+/**
+  * @brief  Completes the transfer at the head of the queue, starts the next
+  *         queued one then calls the completion callback.
+  * @param  Status: sEE_TRANSFER_DONE or sEE_TRANSFER_ERROR.
+  * @retval None
+  */
+static void sEE_Complete(sEE_TransferStatus Status)
+{
+    sEE_TransferTypeDef* Transfer = sEE_Head;
+
+    sEE_StopDMA();
+
+    if (Status == sEE_TRANSFER_ERROR)
+    {
+        /* Release the bus lines and the transfer state machine */
+        I2C_SoftwareResetCmd(sEE_I2C);
+    }
+
+    sEE_Head = Transfer->pNext;
+
+    if (sEE_Head != 0)
+    {
+        sEE_StartAddress();
+    }
+    else
+    {
+        sEE_Tail = 0;
+        sEE_State = sEE_STATE_IDLE;
+
+        /* Leave the flags to the polling functions */
+        I2C_ITConfig(sEE_I2C, sEE_I2C_IT | I2C_IT_TXI, DISABLE);
+    }
+
+    Transfer->Status = Status;
+
+    if (Transfer->Callback != 0)
+    {
+        Transfer->Callback(Transfer);
+    }
+}
+
+/**
+  * @brief  Initializes the DMA channels and the interrupt used by the
+  *         asynchronous transfers.
+  * @note   sEE_Init() must be called first.
+  * @param  None
+  * @retval None
+  */
+void sEE_AsyncInit(void)
+{
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    /* DMA clock enable */
+    RCC_AHBPeriphClockCmd(sEE_I2C_DMA_CLK, ENABLE);
+
+    /* Route the I2C requests to the TX and RX channels */
+    DMA_RemapConfig(sEE_I2C_DMA, sEE_I2C_DMA_REMAP_TX);
+    DMA_RemapConfig(sEE_I2C_DMA, sEE_I2C_DMA_REMAP_RX);
+
+    sEE_StopDMA();
+    sEE_Head = 0;
+    sEE_Tail = 0;
+    sEE_State = sEE_STATE_IDLE;
+
+    NVIC_InitStructure.NVIC_IRQChannel = sEE_I2C_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPriority = 1;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+}
+
+/**
+  * @brief  Stops the asynchronous transfers and disables their interrupt.
+  * @note   Queued transfers are dropped and left with their current status.
+  * @param  None
+  * @retval None
+  */
+void sEE_AsyncDeInit(void)
+{
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    NVIC_InitStructure.NVIC_IRQChannel = sEE_I2C_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPriority = 1;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = DISABLE;
+    NVIC_Init(&NVIC_InitStructure);
+
+    I2C_ITConfig(sEE_I2C, sEE_I2C_IT | I2C_IT_TXI, DISABLE);
+    sEE_StopDMA();
+    sEE_Head = 0;
+    sEE_Tail = 0;
+    sEE_State = sEE_STATE_IDLE;
+}
+
+/**
+  * @brief  Queues an EEPROM transfer, it is started at once when the driver
+  *         is idle.
+  * @note   Can be called from thread or interrupt context, including from a
+  *         completion callback.
+  * @param  Transfer: pointer to a sEE_TransferTypeDef descriptor.
+  * @retval Status of the transfer after submission: sEE_TRANSFER_ACTIVE,
+  *         sEE_TRANSFER_QUEUED, or sEE_TRANSFER_DONE for a zero length transfer.
+  */
+sEE_TransferStatus sEE_Submit(sEE_TransferTypeDef* Transfer)
+{
+    uint32_t primask;
+
+    Transfer->pNext = 0;
+    Transfer->Count = 0;
+
+    if (Transfer->Length == 0)
+    {
+        Transfer->Status = sEE_TRANSFER_DONE;
+
+        if (Transfer->Callback != 0)
+        {
+            Transfer->Callback(Transfer);
+        }
+
+        return sEE_TRANSFER_DONE;
+    }
+
+    Transfer->Status = sEE_TRANSFER_QUEUED;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (sEE_Head == 0)
+    {
+        sEE_Head = Transfer;
+        sEE_Tail = Transfer;
+        sEE_StartAddress();
+    }
+    else
+    {
+        sEE_Tail->pNext = Transfer;
+        sEE_Tail = Transfer;
+    }
+
+    __set_PRIMASK(primask);
+
+    return Transfer->Status;
+}
+
+/**
+  * @brief  Starts reading a block of data from the EEPROM.
+  * @note   Reads longer than 255 bytes run as one transaction in reload mode.
+  * @param  Transfer: descriptor to use, it is completed by the driver.
+  * @param  pBuffer: pointer to the buffer that receives the data read from
+  *         the EEPROM.
+  * @param  ReadAddr: EEPROM's internal address to start reading from.
+  * @param  NumByteToRead: number of bytes to read from the EEPROM.
+  * @retval Status of the transfer after submission.
+  */
+sEE_TransferStatus sEE_ReadBufferAsync(sEE_TransferTypeDef* Transfer, uint8_t* pBuffer,
+                                       uint16_t ReadAddr, uint16_t NumByteToRead)
+{
+    Transfer->pBuffer = pBuffer;
+    Transfer->Address = ReadAddr;
+    Transfer->Length = NumByteToRead;
+    Transfer->Direction = sEE_DIRECTION_READ;
+    Transfer->Callback = 0;
+    Transfer->pContext = 0;
+
+    return sEE_Submit(Transfer);
+}
+
+/**
+  * @brief  Starts writing a buffer of data to the EEPROM.
+  * @note   The buffer is split on page boundaries, each page write cycle is
+  *         polled from sEE_AsyncTick().
+  * @param  Transfer: descriptor to use, it is completed by the driver.
+  * @param  pBuffer: pointer to the buffer containing the data to be written
+  *         to the EEPROM, it must stay valid until the transfer completes.
+  * @param  WriteAddr: EEPROM's internal address to write to.
+  * @param  NumByteToWrite: number of bytes to write to the EEPROM.
+  * @retval Status of the transfer after submission.
+  */
+sEE_TransferStatus sEE_WriteBufferAsync(sEE_TransferTypeDef* Transfer, uint8_t* pBuffer,
+                                        uint16_t WriteAddr, uint16_t NumByteToWrite)
+{
+    Transfer->pBuffer = pBuffer;
+    Transfer->Address = WriteAddr;
+    Transfer->Length = NumByteToWrite;
+    Transfer->Direction = sEE_DIRECTION_WRITE;
+    Transfer->Callback = 0;
+    Transfer->pContext = 0;
+
+    return sEE_Submit(Transfer);
+}
+
+/**
+  * @brief  Tells whether an asynchronous transfer is pending.
+  * @param  None
+  * @retval 1 if the driver is busy, 0 otherwise.
+  */
+uint8_t sEE_AsyncIsBusy(void)
+{
+    return (sEE_Head != 0) ? 1 : 0;
+}
+
+/**
+  * @brief  Time base of the asynchronous transfers: polls the end of the
+  *         write cycles and fails the bus phases which stall.
+  * @note   To be called periodically, every millisecond, e.g. from
+  *         SysTick_Handler(). A completion callback may be called from here.
+  * @param  None
+  * @retval None
+  */
+void sEE_AsyncTick(void)
+{
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (sEE_State == sEE_STATE_WAIT)
+    {
+        sEE_StartPoll();
+    }
+    else if (sEE_State != sEE_STATE_IDLE)
+    {
+        if (sEE_Timer != 0)
+        {
+            sEE_Timer--;
+        }
+
+        if (sEE_Timer == 0)
+        {
+            sEE_Complete(sEE_TRANSFER_ERROR);
+        }
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Handles the I2C interrupt of the asynchronous transfers.
+  * @note   To be called from I2C1_IRQHandler().
+  * @param  None
+  * @retval None
+  */
+void sEE_I2C_IRQHandler(void)
+{
+    sEE_TransferTypeDef* Transfer = sEE_Head;
+    uint16_t Chunk;
+
+    if ((Transfer == 0) || (sEE_State == sEE_STATE_IDLE) || (sEE_State == sEE_STATE_WAIT))
+    {
+        return;
+    }
+
+    /* Bus error or arbitration lost */
+    if ((I2C_GetFlagStatus(sEE_I2C, I2C_ISR_BERR) != RESET) ||
+        (I2C_GetFlagStatus(sEE_I2C, I2C_ISR_ARLO) != RESET))
+    {
+        I2C_ClearFlag(sEE_I2C, I2C_ICR_BERRCF | I2C_ICR_ARLOCF);
+        sEE_Complete(sEE_TRANSFER_ERROR);
+        return;
+    }
+
+    if (I2C_GetFlagStatus(sEE_I2C, I2C_ISR_NACKF) != RESET)
+    {
+        I2C_ClearFlag(sEE_I2C, I2C_ICR_NACKCF);
+        sEE_Nack = 1;
+
+        /* Only the automatic end mode sends the STOP by itself */
+        if (sEE_State == sEE_STATE_ADDRESS)
+        {
+            I2C_GenerateSTOP(sEE_I2C, ENABLE);
+        }
+    }
+
+    /* Memory address bytes */
+    if ((sEE_State == sEE_STATE_ADDRESS) && (I2C_GetFlagStatus(sEE_I2C, I2C_ISR_TXIS) != RESET))
+    {
+        if (sEE_MemAddressIndex < sEE_ADDRESS_BYTES)
+        {
+            I2C_SendData(sEE_I2C, sEE_MemAddress[sEE_MemAddressIndex++]);
+        }
+    }
+
+    /* Address sent: TCR for a write (reload), TC for a read (software end) */
+    if ((sEE_State == sEE_STATE_ADDRESS) && (sEE_Nack == 0) &&
+        ((I2C_GetFlagStatus(sEE_I2C, I2C_ISR_TCR) != RESET) ||
+         (I2C_GetFlagStatus(sEE_I2C, I2C_ISR_TC) != RESET)))
+    {
+        sEE_StartData();
+    }
+    else if ((sEE_State == sEE_STATE_DATA) && (I2C_GetFlagStatus(sEE_I2C, I2C_ISR_TCR) != RESET))
+    {
+        /* Next block of a long read */
+        Chunk = (sEE_ReadLeft > sEE_MAX_NBYTES) ? sEE_MAX_NBYTES : sEE_ReadLeft;
+        sEE_ReadLeft -= Chunk;
+        sEE_Timer = sEE_ASYNC_TIMEOUT_TICKS;
+
+        sEE_Reload((uint8_t)Chunk, (sEE_ReadLeft != 0) ? I2C_Reload_Mode : I2C_AutoEnd_Mode);
+    }
+
+    if (I2C_GetFlagStatus(sEE_I2C, I2C_ISR_STOPF) == RESET)
+    {
+        return;
+    }
+
+    I2C_ClearFlag(sEE_I2C, I2C_ICR_STOPCF);
+
+    switch (sEE_State)
+    {
+        case sEE_STATE_DATA:
+            if ((sEE_Nack != 0) ||
+                (DMA_GetCurrDataCounter((Transfer->Direction == sEE_DIRECTION_WRITE) ?
+                                        sEE_I2C_DMA_CHANNEL_TX : sEE_I2C_DMA_CHANNEL_RX) != 0))
+            {
+                sEE_Complete(sEE_TRANSFER_ERROR);
+            }
+            else if (Transfer->Direction == sEE_DIRECTION_WRITE)
+            {
+                /* Page sent, the next tick polls the end of its write cycle */
+                sEE_StopDMA();
+                Transfer->Count += sEE_Chunk;
+                sEE_Polls = 0;
+                sEE_State = sEE_STATE_WAIT;
+            }
+            else
+            {
+                Transfer->Count = Transfer->Length;
+                sEE_Complete(sEE_TRANSFER_DONE);
+            }
+
+            break;
+
+        case sEE_STATE_POLL:
+            if (sEE_Nack != 0)
+            {
+                /* Write cycle still running, try again on the next tick */
+                if (++sEE_Polls >= sEE_ASYNC_POLL_TICKS)
+                {
+                    sEE_Complete(sEE_TRANSFER_ERROR);
+                }
+                else
+                {
+                    sEE_State = sEE_STATE_WAIT;
+                }
+            }
+            else if (Transfer->Count < Transfer->Length)
+            {
+                sEE_StartAddress();
+            }
+            else
+            {
+                sEE_Complete(sEE_TRANSFER_DONE);
+            }
+
+            break;
+
+        default:
+            /* STOP before the payload: the memory address was not acknowledged */
+            sEE_Complete(sEE_TRANSFER_ERROR);
+            break;
+    }
+}
+
 #ifdef USE_DEFAULT_TIMEOUT_CALLBACK
 /**
   * @brief  Basic management of the timeout situation.
@@ -42,6 +42,38 @@ extern "C" {
   * @{
   */
 
+/**
+  * @brief  Asynchronous EEPROM transfer status
+  */
+typedef enum
+{
+    sEE_TRANSFER_IDLE     = 0,   /*!< Transfer not submitted or already collected */
+    sEE_TRANSFER_QUEUED   = 1,   /*!< Transfer waiting behind another one */
+    sEE_TRANSFER_ACTIVE   = 2,   /*!< Transfer on the bus or waiting for a write cycle */
+    sEE_TRANSFER_DONE     = 3,   /*!< Transfer completed */
+    sEE_TRANSFER_ERROR    = 4    /*!< NACK, bus error, timeout or DMA error */
+} sEE_TransferStatus;
+
+/**
+  * @brief  Asynchronous EEPROM transfer descriptor.
+  * @note   The descriptor is owned by the driver from sEE_Submit() until its
+  *         status becomes sEE_TRANSFER_DONE or sEE_TRANSFER_ERROR, so it must
+  *         not be allocated on a stack frame which is left before that.
+  */
+typedef struct sEE_Transfer
+{
+    uint8_t* pBuffer;                 /*!< Data to write, or buffer for the data read */
+    uint16_t Address;                 /*!< EEPROM's internal start address */
+    uint16_t Length;                  /*!< Number of bytes to transfer */
+    uint8_t Direction;                /*!< sEE_DIRECTION_READ or sEE_DIRECTION_WRITE */
+    void (*Callback)(struct sEE_Transfer* Transfer); /*!< Called from the I2C or the
+                                           tick interrupt on completion, may be NULL */
+    void* pContext;                   /*!< User data, not used by the driver */
+    __IO sEE_TransferStatus Status;   /*!< Transfer status, updated by the driver */
+    uint16_t Count;                   /*!< Bytes already transferred, managed by the driver */
+    struct sEE_Transfer* pNext;       /*!< Queue link, managed by the driver */
+} sEE_TransferTypeDef;
+
 /**
   * @}
   */
@@ -118,6 +150,23 @@ extern "C" {
 #define sEE_OK                    0
 #define sEE_FAIL                  1
 
+#if defined (sEE_M24C08) || defined (sEE_HK24C02)
+#define sEE_ADDRESS_BYTES         1
+#else
+#define sEE_ADDRESS_BYTES         2
+#endif
+
+/* Asynchronous transfer direction */
+#define sEE_DIRECTION_READ        0
+#define sEE_DIRECTION_WRITE       1
+
+/* Asynchronous transfers: timing in periods of sEE_AsyncTick(), 1 ms expected.
+   An EEPROM write cycle lasts 5 ms at most, the device is polled once per
+   tick until it acknowledges its address. */
+#define sEE_ASYNC_POLL_TICKS      20    /* Ticks before a write cycle is failed */
+#define sEE_ASYNC_TIMEOUT_TICKS   50    /* Ticks before a stalled bus phase is failed,
+                                           covers a 255 bytes block at 100 kHz */
+
 /**
   * @}
   */
@@ -139,6 +188,18 @@ uint32_t sEE_WritePage(uint8_t* pBuffer, uint16_t WriteAddr, uint8_t* NumByteToW
 void     sEE_WriteBuffer(uint8_t* pBuffer, uint16_t WriteAddr, uint16_t NumByteToWrite);
 uint32_t sEE_WaitEepromStandbyState(void);
 
+/* Asynchronous transfers */
+void     sEE_AsyncInit(void);
+void     sEE_AsyncDeInit(void);
+sEE_TransferStatus sEE_Submit(sEE_TransferTypeDef* Transfer);
+sEE_TransferStatus sEE_ReadBufferAsync(sEE_TransferTypeDef* Transfer, uint8_t* pBuffer,
+                                       uint16_t ReadAddr, uint16_t NumByteToRead);
+sEE_TransferStatus sEE_WriteBufferAsync(sEE_TransferTypeDef* Transfer, uint8_t* pBuffer,
+                                        uint16_t WriteAddr, uint16_t NumByteToWrite);
+uint8_t  sEE_AsyncIsBusy(void);
+void     sEE_AsyncTick(void);
+void     sEE_I2C_IRQHandler(void);
+
 /* USER Callbacks: These are functions for which prototypes only are declared in
    EEPROM driver and that should be implemented into user application. */
 /* sEE_TIMEOUT_UserCallback() function is called whenever a timeout condition
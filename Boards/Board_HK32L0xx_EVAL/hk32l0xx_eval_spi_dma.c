@@ -0,0 +1,421 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  hk32l0xx_eval_spi_dma.c
+* @brief:     This file provides a DMA driven full-duplex block transfer engine
+*             for the SPI shared by the SD card and the SPI FLASH mounted on
+*             HK32L0XX-EVAL board.
+*             Each transfer uses a pair of DMA channels: the RX channel stores
+*             the received bytes (or drops them in a scratch byte) and the TX
+*             channel sends the buffer (or repeats a dummy byte). Transfers are
+*             queued and chained from the RX transfer complete interrupt, so the
+*             CPU is free while the data streams.
+*             The needed hardware resources are defined in hk32l0xx_eval.h.
+*             By default the engine polls the RX channel flags from
+*             HK_SPI_DMA_Wait() and HK_SPI_DMA_IsBusy(). An application which
+*             calls HK_SPI_DMA_IRQHandler() from DMA_CH2_3_IRQHandler() can
+*             switch to the interrupt mode with HK_SPI_DMA_ITConfig().
+* @author:    AE Team
+* @version:   V1.0.0/2024-12-02
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "hk32l0xx_eval_spi_dma.h"
+
+/** @addtogroup Boards
+  * @{
+  */
+
+/** @addtogroup HK32_EVAL
+  * @{
+  */
+
+/** @addtogroup HK32FL0XX_EVAL
+  * @{
+  */
+
+/** @defgroup HK32FL0XX_EVAL_SPI_DMA
+  * @brief      This file includes the SPI DMA transfer engine of HK32L0XX-EVAL boards.
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static SPI_DMA_TransferTypeDef* SPI_DMA_Head = 0;
+static SPI_DMA_TransferTypeDef* SPI_DMA_Tail = 0;
+static uint8_t SPI_DMA_TxDummy = 0xFF;
+static uint8_t SPI_DMA_RxDummy = 0;
+static FunctionalState SPI_DMA_ITMode = DISABLE;
+
+/* Private function prototypes -----------------------------------------------*/
+static void SPI_DMA_Start(SPI_DMA_TransferTypeDef* Transfer);
+static void SPI_DMA_Stop(void);
+static void SPI_DMA_Poll(void);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Programs the DMA channels and starts the given transfer.
+  * @param  Transfer: transfer at the head of the queue.
+  * @retval None
+  */
+static void SPI_DMA_Start(SPI_DMA_TransferTypeDef* Transfer)
+{
+    DMA_InitTypeDef DMA_InitStructure;
+
+    Transfer->Status = SPI_DMA_ACTIVE;
+
+    if (Transfer->CsPort != 0)
+    {
+        GPIO_ResetBits(Transfer->CsPort, Transfer->CsPin);
+    }
+
+    /* Drop any byte left in the RX FIFO by a previous polled exchange */
+    while (SPIorI2S_GetFlagStatus(EVAL_SPI, SPI_I2S_FLAG_RXNE) != RESET)
+    {
+        SPI_ReceiveData8(EVAL_SPI);
+    }
+
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&EVAL_SPI->DR;
+    DMA_InitStructure.DMA_BufferSize = Transfer->Length;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+
+    /* RX channel: SPI DR -> buffer, or -> scratch byte when the data is not wanted */
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_VeryHigh;
+
+    if (Transfer->pRxBuffer != 0)
+    {
+        DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)Transfer->pRxBuffer;
+        DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    }
+    else
+    {
+        DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)&SPI_DMA_RxDummy;
+        DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Disable;
+    }
+
+    DMA_Init(EVAL_SPI_RX_DMA_CHANNEL, &DMA_InitStructure);
+
+    /* TX channel: buffer -> SPI DR, or the dummy byte repeated for reads */
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralDST;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+
+    if (Transfer->pTxBuffer != 0)
+    {
+        DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)Transfer->pTxBuffer;
+        DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    }
+    else
+    {
+        SPI_DMA_TxDummy = Transfer->DummyByte;
+        DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)&SPI_DMA_TxDummy;
+        DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Disable;
+    }
+
+    DMA_Init(EVAL_SPI_TX_DMA_CHANNEL, &DMA_InitStructure);
+
+    DMA_ClearFlag(EVAL_SPI_RX_DMA_FLAG_GL | EVAL_SPI_TX_DMA_FLAG_GL);
+    DMA_ITConfig(EVAL_SPI_RX_DMA_CHANNEL, DMA_IT_TC | DMA_IT_TE, ENABLE);
+
+    /* The RX side is armed before the TX side feeds the first byte */
+    SPIorI2S_DMACmd(EVAL_SPI, SPI_I2S_DMAReq_Rx, ENABLE);
+    DMA_Cmd(EVAL_SPI_RX_DMA_CHANNEL, ENABLE);
+    DMA_Cmd(EVAL_SPI_TX_DMA_CHANNEL, ENABLE);
+    SPIorI2S_DMACmd(EVAL_SPI, SPI_I2S_DMAReq_Tx, ENABLE);
+}
+
+/**
+  * @brief  Stops the DMA channels and releases the SPI DMA requests.
+  * @param  None
+  * @retval None
+  */
+static void SPI_DMA_Stop(void)
+{
+    SPIorI2S_DMACmd(EVAL_SPI, SPI_I2S_DMAReq_Tx | SPI_I2S_DMAReq_Rx, DISABLE);
+    DMA_Cmd(EVAL_SPI_TX_DMA_CHANNEL, DISABLE);
+    DMA_Cmd(EVAL_SPI_RX_DMA_CHANNEL, DISABLE);
+    DMA_ClearFlag(EVAL_SPI_RX_DMA_FLAG_GL | EVAL_SPI_TX_DMA_FLAG_GL);
+}
+
+/**
+  * @brief  Completes the current transfer from thread context when the engine
+  *         is not driven by the DMA interrupt.
+  * @param  None
+  * @retval None
+  */
+static void SPI_DMA_Poll(void)
+{
+    if (SPI_DMA_ITMode == DISABLE)
+    {
+        HK_SPI_DMA_IRQHandler();
+    }
+}
+
+/**
+  * @brief  Initializes the DMA channels used by the engine.
+  * @note   The SPI itself is configured by SD_LowLevel_Init() or sFLASH_LowLevel_Init().
+  * @note   The engine starts in polling mode, the interrupt mode set by
+  *         HK_SPI_DMA_ITConfig() is kept across a new initialization.
+  * @param  None
+  * @retval None
+  */
+void HK_SPI_DMA_Init(void)
+{
+    /* DMA clock enable */
+    RCC_AHBPeriphClockCmd(EVAL_SPI_DMA_CLK, ENABLE);
+
+    /* Route the SPI requests to the RX and TX channels */
+    DMA_RemapConfig(EVAL_SPI_DMA, EVAL_SPI_RX_DMA_REMAP);
+    DMA_RemapConfig(EVAL_SPI_DMA, EVAL_SPI_TX_DMA_REMAP);
+
+    SPI_DMA_Stop();
+    SPI_DMA_Head = 0;
+    SPI_DMA_Tail = 0;
+}
+
+/**
+  * @brief  Stops the engine and disables its interrupt.
+  * @note   Queued transfers are dropped and left with their current status.
+  * @param  None
+  * @retval None
+  */
+void HK_SPI_DMA_DeInit(void)
+{
+    HK_SPI_DMA_ITConfig(DISABLE);
+
+    DMA_ITConfig(EVAL_SPI_RX_DMA_CHANNEL, DMA_IT_TC | DMA_IT_TE, DISABLE);
+    SPI_DMA_Stop();
+    SPI_DMA_Head = 0;
+    SPI_DMA_Tail = 0;
+}
+
+/**
+  * @brief  Selects how the end of the transfers is detected.
+  * @note   The interrupt mode needs HK_SPI_DMA_IRQHandler() to be called from
+  *         DMA_CH2_3_IRQHandler(), without it the first transfer would end in
+  *         the default handler. The mode must not be changed while
+  *         HK_SPI_DMA_IsBusy() returns 1.
+  * @param  NewState: ENABLE to complete the transfers from the DMA interrupt
+  *         and sleep in HK_SPI_DMA_Wait(), DISABLE to poll the DMA flags.
+  * @retval None
+  */
+void HK_SPI_DMA_ITConfig(FunctionalState NewState)
+{
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    SPI_DMA_ITMode = NewState;
+
+    /* The channel interrupt is always enabled in the DMA: drop the request
+       latched by the NVIC while the engine was polling */
+    NVIC_ClearPendingIRQ(EVAL_SPI_DMA_IRQn);
+
+    NVIC_InitStructure.NVIC_IRQChannel = EVAL_SPI_DMA_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPriority = 1;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = NewState;
+    NVIC_Init(&NVIC_InitStructure);
+}
+
+/**
+  * @brief  Queues a transfer, it is started at once when the engine is idle.
+  * @note   Can be called from thread or interrupt context, including from a
+  *         completion callback.
+  * @param  Transfer: pointer to a SPI_DMA_TransferTypeDef descriptor.
+  * @retval Status of the transfer after submission: SPI_DMA_ACTIVE,
+  *         SPI_DMA_QUEUED, or SPI_DMA_DONE for a zero length transfer.
+  */
+SPI_DMA_Status HK_SPI_DMA_Submit(SPI_DMA_TransferTypeDef* Transfer)
+{
+    uint32_t primask;
+
+    Transfer->pNext = 0;
+
+    if (Transfer->Length == 0)
+    {
+        Transfer->Status = SPI_DMA_DONE;
+
+        if (Transfer->Callback != 0)
+        {
+            Transfer->Callback(Transfer);
+        }
+
+        return SPI_DMA_DONE;
+    }
+
+    Transfer->Status = SPI_DMA_QUEUED;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (SPI_DMA_Head == 0)
+    {
+        SPI_DMA_Head = Transfer;
+        SPI_DMA_Tail = Transfer;
+        SPI_DMA_Start(Transfer);
+    }
+    else
+    {
+        SPI_DMA_Tail->pNext = Transfer;
+        SPI_DMA_Tail = Transfer;
+    }
+
+    __set_PRIMASK(primask);
+
+    return Transfer->Status;
+}
+
+/**
+  * @brief  Waits for the end of a submitted transfer.
+  * @note   In interrupt mode the core sleeps, this must not be called with
+  *         interrupts masked or from an interrupt with a priority higher than
+  *         or equal to EVAL_SPI_DMA_IRQn. In polling mode the queued transfers
+  *         are completed and chained from here, callbacks included.
+  * @param  Transfer: pointer to a submitted SPI_DMA_TransferTypeDef descriptor.
+  * @retval Final status: SPI_DMA_DONE or SPI_DMA_ERROR.
+  */
+SPI_DMA_Status HK_SPI_DMA_Wait(SPI_DMA_TransferTypeDef* Transfer)
+{
+    while ((Transfer->Status == SPI_DMA_QUEUED) || (Transfer->Status == SPI_DMA_ACTIVE))
+    {
+        if (SPI_DMA_ITMode != DISABLE)
+        {
+            __WFI();
+        }
+        else
+        {
+            SPI_DMA_Poll();
+        }
+    }
+
+    return Transfer->Status;
+}
+
+/**
+  * @brief  Exchanges a buffer on the SPI through DMA and waits for the end.
+  * @note   The caller manages the chip select of the addressed device.
+  * @param  pTxBuffer: data to send, NULL to send DummyByte repeatedly.
+  * @param  pRxBuffer: buffer for the received data, NULL to discard it.
+  * @param  Length: number of bytes to exchange.
+  * @param  DummyByte: byte sent when pTxBuffer is NULL.
+  * @retval Final status: SPI_DMA_DONE or SPI_DMA_ERROR.
+  */
+SPI_DMA_Status HK_SPI_DMA_TransferBlocking(const uint8_t* pTxBuffer, uint8_t* pRxBuffer,
+                                           uint16_t Length, uint8_t DummyByte)
+{
+    SPI_DMA_TransferTypeDef Transfer;
+
+    Transfer.pTxBuffer = pTxBuffer;
+    Transfer.pRxBuffer = pRxBuffer;
+    Transfer.Length = Length;
+    Transfer.DummyByte = DummyByte;
+    Transfer.CsPort = 0;
+    Transfer.CsPin = 0;
+    Transfer.Callback = 0;
+    Transfer.pContext = 0;
+
+    HK_SPI_DMA_Submit(&Transfer);
+
+    return HK_SPI_DMA_Wait(&Transfer);
+}
+
+/**
+  * @brief  Tells whether a transfer is on the bus or queued.
+  * @note   In polling mode this also completes the current transfer, so
+  *         calling it from the main loop keeps a queue of transfers moving.
+  * @param  None
+  * @retval 1 if the engine is busy, 0 otherwise.
+  */
+uint8_t HK_SPI_DMA_IsBusy(void)
+{
+    SPI_DMA_Poll();
+
+    return (SPI_DMA_Head != 0) ? 1 : 0;
+}
+
+/**
+  * @brief  Handles the RX DMA channel interrupt: completes the current transfer,
+  *         starts the next queued one then calls the completion callback.
+  * @note   To be called from DMA_CH2_3_IRQHandler() in interrupt mode, see
+  *         HK_SPI_DMA_ITConfig().
+  * @param  None
+  * @retval None
+  */
+void HK_SPI_DMA_IRQHandler(void)
+{
+    SPI_DMA_TransferTypeDef* Transfer;
+    SPI_DMA_Status Status;
+    uint32_t primask;
+
+    if ((DMA_GetFlagStatus(EVAL_SPI_RX_DMA_FLAG_TC) == RESET) &&
+        (DMA_GetFlagStatus(EVAL_SPI_RX_DMA_FLAG_TE) == RESET))
+    {
+        return;
+    }
+
+    Status = (DMA_GetFlagStatus(EVAL_SPI_RX_DMA_FLAG_TE) != RESET) ? SPI_DMA_ERROR : SPI_DMA_DONE;
+
+    /* In polling mode this runs in thread context: a HK_SPI_DMA_Submit() from
+       an interrupt must not see Head and Tail half updated */
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    SPI_DMA_Stop();
+
+    Transfer = SPI_DMA_Head;
+
+    if (Transfer == 0)
+    {
+        __set_PRIMASK(primask);
+        return;
+    }
+
+    if (Transfer->CsPort != 0)
+    {
+        GPIO_SetBits(Transfer->CsPort, Transfer->CsPin);
+    }
+
+    /* Chain the next transfer before running the callback to keep the bus busy */
+    SPI_DMA_Head = Transfer->pNext;
+
+    if (SPI_DMA_Head != 0)
+    {
+        SPI_DMA_Start(SPI_DMA_Head);
+    }
+    else
+    {
+        SPI_DMA_Tail = 0;
+    }
+
+    __set_PRIMASK(primask);
+
+    Transfer->Status = Status;
+
+    if (Transfer->Callback != 0)
+    {
+        Transfer->Callback(Transfer);
+    }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,106 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  hk32l0xx_eval_spi_dma.h
+* @brief:     This file contains all the functions prototypes for the
+*             hk32l0xx_eval_spi_dma firmware driver.
+* @author:    AE Team
+*******************************************************************************/
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __HK32L0XX_EVAL_SPI_DMA_H
+#define __HK32L0XX_EVAL_SPI_DMA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "hk32l0xx_eval.h"
+
+/** @addtogroup Boards
+  * @{
+  */
+
+/** @addtogroup HK32_EVAL
+  * @{
+  */
+
+/** @addtogroup HK32FL0XX_EVAL
+  * @{
+  */
+
+/** @addtogroup HK32FL0XX_EVAL_SPI_DMA
+  * @{
+  */
+
+/* Exported types ------------------------------------------------------------*/
+/**
+  * @brief  SPI DMA transfer status
+  */
+typedef enum
+{
+    SPI_DMA_IDLE     = 0,   /*!< Transfer not submitted or already collected */
+    SPI_DMA_QUEUED   = 1,   /*!< Transfer waiting behind another one */
+    SPI_DMA_ACTIVE   = 2,   /*!< Transfer on the bus */
+    SPI_DMA_DONE     = 3,   /*!< Transfer completed */
+    SPI_DMA_ERROR    = 4    /*!< DMA transfer error */
+} SPI_DMA_Status;
+
+/**
+  * @brief  SPI DMA transfer descriptor.
+  * @note   The descriptor is owned by the engine from HK_SPI_DMA_Submit() until
+  *         its status becomes SPI_DMA_DONE or SPI_DMA_ERROR, so it must not be
+  *         allocated on a stack frame which is left before that.
+  */
+typedef struct SPI_DMA_Transfer
+{
+    const uint8_t* pTxBuffer;         /*!< Data to send, NULL to clock out DummyByte */
+    uint8_t* pRxBuffer;               /*!< Received data, NULL to discard it */
+    uint16_t Length;                  /*!< Number of bytes to exchange */
+    uint8_t DummyByte;                /*!< Byte sent when pTxBuffer is NULL */
+    GPIO_TypeDef* CsPort;             /*!< Chip select port driven by the engine, NULL if
+                                           the caller already selected the device */
+    uint16_t CsPin;                   /*!< Chip select pin, active low */
+    void (*Callback)(struct SPI_DMA_Transfer* Transfer); /*!< Called on completion from
+                                           the DMA interrupt, or from the polling
+                                           function, may be NULL */
+    void* pContext;                   /*!< User data, not used by the engine */
+    __IO SPI_DMA_Status Status;       /*!< Transfer status, updated by the engine */
+    struct SPI_DMA_Transfer* pNext;   /*!< Queue link, managed by the engine */
+} SPI_DMA_TransferTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void HK_SPI_DMA_Init(void);
+void HK_SPI_DMA_DeInit(void);
+void HK_SPI_DMA_ITConfig(FunctionalState NewState);
+SPI_DMA_Status HK_SPI_DMA_Submit(SPI_DMA_TransferTypeDef* Transfer);
+SPI_DMA_Status HK_SPI_DMA_Wait(SPI_DMA_TransferTypeDef* Transfer);
+SPI_DMA_Status HK_SPI_DMA_TransferBlocking(const uint8_t* pTxBuffer, uint8_t* pRxBuffer,
+                                           uint16_t Length, uint8_t DummyByte);
+uint8_t HK_SPI_DMA_IsBusy(void);
+void HK_SPI_DMA_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*__HK32L0XX_EVAL_SPI_DMA_H */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -35,6 +35,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "hk32l0xx_eval_spi_flash.h"
+#include "hk32l0xx_eval_spi_dma.h"
 
 /** @addtogroup Boards
   * @{
@@ -105,6 +106,9 @@ void sFLASH_Init(void)
 
     /*!< Enable the sFLASH_SPI  */
     SPI_Cmd(sFLASH_SPI, ENABLE);
+
+    /*!< Initialize the DMA engine used for the data phases */
+    HK_SPI_DMA_Init();
 }
 
 /**
@@ -184,14 +188,8 @@ void sFLASH_WritePage(uint8_t* pBuffer, uint32_t WriteAddr, uint16_t NumByteToWr
     /*!< Send WriteAddr low nibble address byte to write to */
     sFLASH_SendByte(WriteAddr & 0xFF);
 
-    /*!< while there is data to be written on the FLASH */
-    while (NumByteToWrite--)
-    {
-        /*!< Send the current byte */
-        sFLASH_SendByte(*pBuffer);
-        /*!< Point on the next byte to be written */
-        pBuffer++;
-    }
+    /*!< Stream the data to the FLASH through DMA */
+    HK_SPI_DMA_TransferBlocking(pBuffer, 0, NumByteToWrite, sFLASH_DUMMY_BYTE);
 
     /*!< Deselect the FLASH: Chip Select high */
     sFLASH_CS_HIGH();
@@ -302,14 +300,8 @@ void sFLASH_ReadBuffer(uint8_t* pBuffer, uint32_t ReadAddr, uint16_t NumByteToRe
     /*!< Send ReadAddr low nibble address byte to read from */
     sFLASH_SendByte(ReadAddr & 0xFF);
 
-    /*!< while there is data to be read */
-    while (NumByteToRead--)
-    {
-        /*!< Read a byte from the FLASH */
-        *pBuffer = sFLASH_SendByte(sFLASH_DUMMY_BYTE);
-        /*!< Point to the next location where the byte read will be saved */
-        pBuffer++;
-    }
+    /*!< Stream the data from the FLASH through DMA */
+    HK_SPI_DMA_TransferBlocking(0, pBuffer, NumByteToRead, sFLASH_DUMMY_BYTE);
 
     /*!< Deselect the FLASH: Chip Select high */
     sFLASH_CS_HIGH();
@@ -394,7 +386,7 @@ uint8_t sFLASH_ReadByte(void)
 uint8_t sFLASH_SendByte(uint8_t byte)
 {
     /*!< Loop while DR register in not emplty */
-    while (SPI_I2SGetFlagStatus(sFLASH_SPI, SPI_I2S_FLAG_TXE) == RESET)
+    while (SPIorI2S_GetFlagStatus(sFLASH_SPI, SPI_I2S_FLAG_TXE) == RESET)
     {
 
     }
@@ -403,7 +395,7 @@ uint8_t sFLASH_SendByte(uint8_t byte)
     SPI_SendData8(sFLASH_SPI, byte);
 
     /*!< Wait to receive a byte */
-    while (SPI_I2SGetFlagStatus(sFLASH_SPI, SPI_I2S_FLAG_RXNE) == RESET)
+    while (SPIorI2S_GetFlagStatus(sFLASH_SPI, SPI_I2S_FLAG_RXNE) == RESET)
     {
 
     }
@@ -421,7 +413,7 @@ uint8_t sFLASH_SendByte(uint8_t byte)
 uint16_t sFLASH_SendHalfWord(uint16_t HalfWord)
 {
     /*!< Loop while DR register in not emplty */
-    while (SPI_I2SGetFlagStatus(sFLASH_SPI, SPI_I2S_FLAG_TXE) == RESET)
+    while (SPIorI2S_GetFlagStatus(sFLASH_SPI, SPI_I2S_FLAG_TXE) == RESET)
     {
 
     }
@@ -430,7 +422,7 @@ uint16_t sFLASH_SendHalfWord(uint16_t HalfWord)
     SPI_SendData8(sFLASH_SPI, HalfWord);
 
     /*!< Wait to receive a Half Word */
-    while (SPI_I2SGetFlagStatus(sFLASH_SPI, SPI_I2S_FLAG_RXNE) == RESET)
+    while (SPIorI2S_GetFlagStatus(sFLASH_SPI, SPI_I2S_FLAG_RXNE) == RESET)
     {
 
     }
@@ -12,6 +12,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "hk32l0xx_eval_spi_sd.h"
+#include "hk32l0xx_eval_spi_dma.h"
 #include "hk32l0xx_eval.h"
 /** @addtogroup Utilities
   * @{
@@ -61,6 +62,9 @@ SD_Error SD_Init(void)
     /* Initialize SD_SPI */
     SD_LowLevel_Init();
 
+    /* Initialize the DMA engine used for the data blocks */
+    HK_SPI_DMA_Init();
+
     /* SD chip select high */
     SD_CS_HIGH();
 
@@ -131,7 +135,6 @@ SD_Error SD_GetCardInfo(SD_CardInfo *cardinfo)
   */
 SD_Error SD_ReadBlock(uint8_t* pBuffer, uint32_t ReadAddr, uint16_t BlockSize)
 {
-    uint32_t i = 0;
     SD_Error rvalue = SD_RESPONSE_FAILURE;
 
     /* SD chip select low */
@@ -147,14 +150,7 @@ SD_Error SD_ReadBlock(uint8_t* pBuffer, uint32_t ReadAddr, uint16_t BlockSize)
         if (!SD_GetResponse(SD_START_DATA_SINGLE_BLOCK_READ))
         {
             /* Read the SD block data : read NumByteToRead data */
-            for (i = 0; i < BlockSize; i++)
-            {
-                /* Save the received data */
-                *pBuffer = SD_ReadByte();
-
-                /* Point to the next location where the byte read will be saved */
-                pBuffer++;
-            }
+            SD_ReadBuffer(pBuffer, BlockSize);
 
             /* Get CRC bytes (not really needed by us, but required by SD) */
             SD_ReadByte();
@@ -177,6 +173,9 @@ SD_Error SD_ReadBlock(uint8_t* pBuffer, uint32_t ReadAddr, uint16_t BlockSize)
 
 /**
   * @brief  Reads multiple block of data from the SD.
+  * @note   The blocks are streamed with a single CMD18 (READ_MULTIPLE_BLOCK)
+  *         and terminated with CMD12 (STOP_TRANSMISSION), so only one command
+  *         round-trip is spent for the whole transfer.
   * @param  pBuffer: pointer to the buffer that receives the data read from the SD card.
   * @param  ReadAddr: SD's internal address to read from.
   * @param  BlockSize: the SD card Data block size.
@@ -187,50 +186,52 @@ SD_Error SD_ReadBlock(uint8_t* pBuffer, uint32_t ReadAddr, uint16_t BlockSize)
   */
 SD_Error SD_ReadMultiBlocks(uint8_t* pBuffer, uint32_t ReadAddr, uint16_t BlockSize, uint32_t NumberOfBlocks)
 {
-    uint32_t i = 0, Offset = 0;
     SD_Error rvalue = SD_RESPONSE_FAILURE;
 
+    if (NumberOfBlocks == 0)
+    {
+        return SD_RESPONSE_FAILURE;
+    }
+
     /* SD chip select low */
     SD_CS_LOW();
 
-    /* Data transfer */
-    while (NumberOfBlocks--)
-    {
-        /* Send CMD17 (SD_CMD_READ_SINGLE_BLOCK) to read one block */
-        SD_SendCmd (SD_CMD_READ_SINGLE_BLOCK, ReadAddr + Offset, 0xFF);
+    /* Send CMD18 (SD_CMD_READ_MULT_BLOCK) to start streaming blocks */
+    SD_SendCmd(SD_CMD_READ_MULT_BLOCK, ReadAddr, 0xFF);
 
-        /* Check if the SD acknowledged the read block command: R1 response (0x00: no errors) */
-        if (SD_GetResponse(SD_RESPONSE_NO_ERROR))
-        {
-            return  SD_RESPONSE_FAILURE;
-        }
+    /* Check if the SD acknowledged the read command: R1 response (0x00: no errors) */
+    if (!SD_GetResponse(SD_RESPONSE_NO_ERROR))
+    {
+        rvalue = SD_RESPONSE_NO_ERROR;
 
-        /* Now look for the data token to signify the start of the data */
-        if (!SD_GetResponse(SD_START_DATA_SINGLE_BLOCK_READ))
+        /* Data transfer */
+        while (NumberOfBlocks--)
         {
-            /* Read the SD block data : read NumByteToRead data */
-            for (i = 0; i < BlockSize; i++)
+            /* Now look for the data token to signify the start of the next block */
+            if (SD_GetResponse(SD_START_DATA_MULTIPLE_BLOCK_READ))
             {
-                /* Read the pointed data */
-                *pBuffer = SD_ReadByte();
-
-                /* Point to the next location where the byte read will be saved */
-                pBuffer++;
+                rvalue = SD_RESPONSE_FAILURE;
+                break;
             }
 
-            /* Set next read address*/
-            Offset += 512;
+            /* Read the SD block data */
+            SD_ReadBuffer(pBuffer, BlockSize);
+            pBuffer += BlockSize;
 
-            /* get CRC bytes (not really needed by us, but required by SD) */
+            /* Get CRC bytes (not really needed by us, but required by SD) */
             SD_ReadByte();
             SD_ReadByte();
-
-            /* Set response value to success */
-            rvalue = SD_RESPONSE_NO_ERROR;
         }
-        else
+
+        /* Send CMD12 (SD_CMD_STOP_TRANSMISSION) to end the stream */
+        SD_SendCmd(SD_CMD_STOP_TRANSMISSION, 0, 0xFF);
+
+        /* Skip the stuff byte sent right after CMD12 */
+        SD_ReadByte();
+
+        /* Wait for the R1 response then for the card to leave the busy state */
+        if (SD_GetResponse(SD_RESPONSE_NO_ERROR) || SD_WaitReady())
         {
-            /* Set response value to failure */
             rvalue = SD_RESPONSE_FAILURE;
         }
     }
@@ -255,7 +256,6 @@ SD_Error SD_ReadMultiBlocks(uint8_t* pBuffer, uint32_t ReadAddr, uint16_t BlockS
   */
 SD_Error SD_WriteBlock(uint8_t* pBuffer, uint32_t WriteAddr, uint16_t BlockSize)
 {
-    uint32_t i = 0;
     SD_Error rvalue = SD_RESPONSE_FAILURE;
 
     /* SD chip select low */
@@ -274,14 +274,7 @@ SD_Error SD_WriteBlock(uint8_t* pBuffer, uint32_t WriteAddr, uint16_t BlockSize)
         SD_WriteByte(0xFE);
 
         /* Write the block data to SD : write count data by block */
-        for (i = 0; i < BlockSize; i++)
-        {
-            /* Send the pointed byte */
-            SD_WriteByte(*pBuffer);
-
-            /* Point to the next location where the byte read will be saved */
-            pBuffer++;
-        }
+        SD_WriteBuffer(pBuffer, BlockSize);
 
         /* Put CRC bytes (not really needed by us, but required by SD) */
         SD_ReadByte();
@@ -305,6 +298,10 @@ SD_Error SD_WriteBlock(uint8_t* pBuffer, uint32_t WriteAddr, uint16_t BlockSize)
 
 /**
   * @brief  Writes many blocks on the SD
+  * @note   The blocks are streamed with a single CMD25 (WRITE_MULTIPLE_BLOCK).
+  *         ACMD23 (SET_WR_BLK_ERASE_COUNT) is sent first so the card can
+  *         pre-erase the whole range; cards that do not support it simply
+  *         ignore the hint.
   * @param  pBuffer: pointer to the buffer containing the data to be written on
   *         the SD card.
   * @param  WriteAddr: address to write on.
@@ -316,53 +313,63 @@ SD_Error SD_WriteBlock(uint8_t* pBuffer, uint32_t WriteAddr, uint16_t BlockSize)
   */
 SD_Error SD_WriteMultiBlocks(uint8_t* pBuffer, uint32_t WriteAddr, uint16_t BlockSize, uint32_t NumberOfBlocks)
 {
-    uint32_t i = 0, Offset = 0;
     SD_Error rvalue = SD_RESPONSE_FAILURE;
 
+    if (NumberOfBlocks == 0)
+    {
+        return SD_RESPONSE_FAILURE;
+    }
+
+    /* Give the card the number of blocks to pre-erase */
+    SD_SetWriteBlockEraseCount(NumberOfBlocks);
+
     /* SD chip select low */
     SD_CS_LOW();
 
-    /* Data transfer */
-    while (NumberOfBlocks--)
-    {
-        /* Send CMD24 (SD_CMD_WRITE_SINGLE_BLOCK) to write blocks */
-        SD_SendCmd(SD_CMD_WRITE_SINGLE_BLOCK, WriteAddr + Offset, 0xFF);
+    /* Send CMD25 (SD_CMD_WRITE_MULT_BLOCK) to start streaming blocks */
+    SD_SendCmd(SD_CMD_WRITE_MULT_BLOCK, WriteAddr, 0xFF);
 
-        /* Check if the SD acknowledged the write block command: R1 response (0x00: no errors) */
-        if (SD_GetResponse(SD_RESPONSE_NO_ERROR))
-        {
-            return SD_RESPONSE_FAILURE;
-        }
+    /* Check if the SD acknowledged the write command: R1 response (0x00: no errors) */
+    if (!SD_GetResponse(SD_RESPONSE_NO_ERROR))
+    {
+        rvalue = SD_RESPONSE_NO_ERROR;
 
         /* Send dummy byte */
         SD_WriteByte(SD_DUMMY_BYTE);
-        /* Send the data token to signify the start of the data */
-        SD_WriteByte(SD_START_DATA_SINGLE_BLOCK_WRITE);
 
-        /* Write the block data to SD : write count data by block */
-        for (i = 0; i < BlockSize; i++)
+        /* Data transfer */
+        while (NumberOfBlocks--)
         {
-            /* Send the pointed byte */
-            SD_WriteByte(*pBuffer);
-            /* Point to the next location where the byte read will be saved */
-            pBuffer++;
+            /* Send the data token to signify the start of the next block */
+            SD_WriteByte(SD_START_DATA_MULTIPLE_BLOCK_WRITE);
+
+            /* Write the block data to SD */
+            SD_WriteBuffer(pBuffer, BlockSize);
+            pBuffer += BlockSize;
+
+            /* Put CRC bytes (not really needed by us, but required by SD) */
+            SD_ReadByte();
+            SD_ReadByte();
+
+            /* Read data response, SD_GetDataResponse also waits the end of programming */
+            if (SD_GetDataResponse() != SD_DATA_OK)
+            {
+                /* A rejected block returns before the busy state: the stop
+                   token is only seen by a ready card */
+                SD_WaitReady();
+                rvalue = SD_RESPONSE_FAILURE;
+                break;
+            }
         }
 
-        /* Set next write address */
-        Offset += 512;
-        /* Put CRC bytes (not really needed by us, but required by SD) */
-        SD_ReadByte();
+        /* Send the stop token to end the stream */
+        SD_WriteByte(SD_STOP_DATA_MULTIPLE_BLOCK_WRITE);
+
+        /* Skip one byte then wait for the card to finish programming */
         SD_ReadByte();
 
-        /* Read data response */
-        if (SD_GetDataResponse() == SD_DATA_OK)
+        if (SD_WaitReady())
         {
-            /* Set response value to success */
-            rvalue = SD_RESPONSE_NO_ERROR;
-        }
-        else
-        {
-            /* Set response value to failure */
             rvalue = SD_RESPONSE_FAILURE;
         }
     }
@@ -375,6 +382,42 @@ SD_Error SD_WriteMultiBlocks(uint8_t* pBuffer, uint32_t WriteAddr, uint16_t Bloc
     return rvalue;
 }
 
+/**
+  * @brief  Sets the number of blocks to be pre-erased before a multiple block write.
+  * @note   Sends CMD55 (APP_CMD) followed by ACMD23 (SET_WR_BLK_ERASE_COUNT).
+  *         The setting only applies to the next CMD25 and is a hint: a card
+  *         which does not implement it still accepts the write.
+  * @param  NumberOfBlocks: number of blocks that are going to be written.
+  * @retval The SD Response:
+  *         - SD_RESPONSE_FAILURE: Sequence failed
+  *         - SD_RESPONSE_NO_ERROR: Sequence succeed
+  */
+SD_Error SD_SetWriteBlockEraseCount(uint32_t NumberOfBlocks)
+{
+    SD_Error rvalue = SD_RESPONSE_FAILURE;
+
+    /* SD chip select low */
+    SD_CS_LOW();
+
+    /* Send CMD55 (SD_CMD_APP_CMD): the next command is an application command */
+    SD_SendCmd(SD_CMD_APP_CMD, 0, 0xFF);
+
+    if (!SD_GetResponse(SD_RESPONSE_NO_ERROR))
+    {
+        /* Send ACMD23, the block count is a 23-bit field */
+        SD_SendCmd(SD_ACMD_SET_WR_BLK_ERASE_COUNT, NumberOfBlocks & 0x007FFFFF, 0xFF);
+
+        rvalue = SD_GetResponse(SD_RESPONSE_NO_ERROR);
+    }
+
+    /* SD chip select high */
+    SD_CS_HIGH();
+    /* Send dummy byte: 8 Clock pulses of delay */
+    SD_WriteByte(SD_DUMMY_BYTE);
+
+    return rvalue;
+}
+
 /**
   * @brief  Read the CSD card register.
   * @note   Reading the contents of the CSD register in SPI mode is a simple
@@ -720,6 +763,25 @@ SD_Error SD_GetResponse(uint8_t Response)
     }
 }
 
+/**
+  * @brief  Waits for the SD card to release the busy state (MISO held low).
+  * @param  None
+  * @retval The SD Response:
+  *         - SD_RESPONSE_FAILURE: Timeout, the card is still busy
+  *         - SD_RESPONSE_NO_ERROR: The card is ready
+  */
+SD_Error SD_WaitReady(void)
+{
+    uint32_t Count = 0xFFFF;
+
+    while ((SD_ReadByte() != SD_DUMMY_BYTE) && Count)
+    {
+        Count--;
+    }
+
+    return (Count == 0) ? SD_RESPONSE_FAILURE : SD_RESPONSE_NO_ERROR;
+}
+
 /**
   * @brief  Returns the SD status.
   * @param  None
@@ -807,6 +869,32 @@ uint8_t SD_WriteByte(uint8_t Data)
     return HK_SPI_WriteRead(Data);
 }
 
+/**
+  * @brief  Reads a buffer of data bytes from the SD.
+  * @note   The card must already be in a data phase (after the start token).
+  *         The bytes are moved by the SPI DMA engine, the CPU sleeps meanwhile.
+  * @param  pBuffer: pointer to the buffer that receives the data.
+  * @param  NumByteToRead: number of bytes to read.
+  * @retval None
+  */
+void SD_ReadBuffer(uint8_t* pBuffer, uint16_t NumByteToRead)
+{
+    HK_SPI_DMA_TransferBlocking(0, pBuffer, NumByteToRead, SD_DUMMY_BYTE);
+}
+
+/**
+  * @brief  Writes a buffer of data bytes to the SD.
+  * @note   The card must already be in a data phase (after the start token).
+  *         The bytes are moved by the SPI DMA engine, the CPU sleeps meanwhile.
+  * @param  pBuffer: pointer to the buffer containing the data.
+  * @param  NumByteToWrite: number of bytes to write.
+  * @retval None
+  */
+void SD_WriteBuffer(const uint8_t* pBuffer, uint16_t NumByteToWrite)
+{
+    HK_SPI_DMA_TransferBlocking(pBuffer, 0, NumByteToWrite, SD_DUMMY_BYTE);
+}
+
 /**
   * @brief  Read a byte from the SD.
   * @note   Transfer on SPI bus management ensured by the HK_SPI_WriteRead() function,
@@ -151,7 +151,7 @@ typedef struct
 #define SD_START_DATA_SINGLE_BLOCK_READ    0xFE  /*!< Data token start byte, Start Single Block Read */
 #define SD_START_DATA_MULTIPLE_BLOCK_READ  0xFE  /*!< Data token start byte, Start Multiple Block Read */
 #define SD_START_DATA_SINGLE_BLOCK_WRITE   0xFE  /*!< Data token start byte, Start Single Block Write */
-#define SD_START_DATA_MULTIPLE_BLOCK_WRITE 0xFD  /*!< Data token start byte, Start Multiple Block Write */
+#define SD_START_DATA_MULTIPLE_BLOCK_WRITE 0xFC  /*!< Data token start byte, Start Multiple Block Write */
 #define SD_STOP_DATA_MULTIPLE_BLOCK_WRITE  0xFD  /*!< Data toke stop byte, Stop Multiple Block Write */
 
 /**
@@ -187,6 +187,12 @@ typedef struct
 #define SD_CMD_ERASE_GRP_END          36  /*!< CMD36 = 0x64 */
 #define SD_CMD_UNTAG_ERASE_GROUP      37  /*!< CMD37 = 0x65 */
 #define SD_CMD_ERASE                  38  /*!< CMD38 = 0x66 */
+#define SD_CMD_APP_CMD                55  /*!< CMD55 = 0x77 */
+
+/**
+  * @brief  Application specific commands, to be preceded by SD_CMD_APP_CMD
+  */
+#define SD_ACMD_SET_WR_BLK_ERASE_COUNT 23 /*!< ACMD23 = 0x57 */
 
 /* Exported macro ------------------------------------------------------------*/
 /**
@@ -209,15 +215,19 @@ SD_Error SD_WriteBlock(uint8_t* pBuffer, uint32_t WriteAddr, uint16_t BlockSize)
 SD_Error SD_WriteMultiBlocks(uint8_t* pBuffer, uint32_t WriteAddr, uint16_t BlockSize, uint32_t NumberOfBlocks);
 SD_Error SD_GetCSDRegister(SD_CSD* SD_csd);
 SD_Error SD_GetCIDRegister(SD_CID* SD_cid);
+SD_Error SD_SetWriteBlockEraseCount(uint32_t NumberOfBlocks);
 
 void SD_SendCmd(uint8_t Cmd, uint32_t Arg, uint8_t Crc);
 SD_Error SD_GetResponse(uint8_t Response);
 uint8_t SD_GetDataResponse(void);
 SD_Error SD_GoIdleState(void);
+SD_Error SD_WaitReady(void);
 uint16_t SD_GetStatus(void);
 
 uint8_t SD_WriteByte(uint8_t byte);
 uint8_t SD_ReadByte(void);
+void SD_ReadBuffer(uint8_t* pBuffer, uint16_t NumByteToRead);
+void SD_WriteBuffer(const uint8_t* pBuffer, uint16_t NumByteToWrite);
 
 #ifdef __cplusplus
 }
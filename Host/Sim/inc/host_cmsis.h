@@ -0,0 +1,211 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  host_cmsis.h
+* @brief:     Host replacement of cmsis_gcc.h. It is pre-included in every host
+*             build unit so that core_cm0.h picks these intrinsics instead of the
+*             ARM inline assembly.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __HOST_CMSIS_H
+#define __HOST_CMSIS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdlib.h>
+
+/* cmsis_gcc.h only holds ARM inline assembly: keep it out of the host build */
+#define __CMSIS_GCC_H
+
+/* Flash routines run in place on the host, there is no RAM copy to place */
+#define FLASH_RAMFUNC
+
+/* Exported functions --------------------------------------------------------*/
+void HostSim_WaitForInterrupt(void);
+void HostSim_WaitForEvent(void);
+void HostSim_SendEvent(void);
+void HostSim_SetPrimask(uint32_t PriMask);
+uint32_t HostSim_GetPrimask(void);
+uint32_t HostSim_GetIpsr(void);
+
+/* Core register access ------------------------------------------------------*/
+extern uint32_t HostSim_Control;
+extern uint32_t HostSim_Psp;
+extern uint32_t HostSim_Msp;
+
+static inline void __enable_irq(void)
+{
+    HostSim_SetPrimask(0);
+}
+
+static inline void __disable_irq(void)
+{
+    HostSim_SetPrimask(1);
+}
+
+static inline uint32_t __get_PRIMASK(void)
+{
+    return HostSim_GetPrimask();
+}
+
+static inline void __set_PRIMASK(uint32_t priMask)
+{
+    HostSim_SetPrimask(priMask & 1U);
+}
+
+static inline uint32_t __get_CONTROL(void)
+{
+    return HostSim_Control;
+}
+
+static inline void __set_CONTROL(uint32_t control)
+{
+    HostSim_Control = control;
+}
+
+static inline uint32_t __get_IPSR(void)
+{
+    return HostSim_GetIpsr();
+}
+
+static inline uint32_t __get_APSR(void)
+{
+    return 0;
+}
+
+static inline uint32_t __get_xPSR(void)
+{
+    return HostSim_GetIpsr();
+}
+
+static inline uint32_t __get_PSP(void)
+{
+    return HostSim_Psp;
+}
+
+static inline void __set_PSP(uint32_t topOfProcStack)
+{
+    HostSim_Psp = topOfProcStack;
+}
+
+static inline uint32_t __get_MSP(void)
+{
+    return HostSim_Msp;
+}
+
+static inline void __set_MSP(uint32_t topOfMainStack)
+{
+    HostSim_Msp = topOfMainStack;
+}
+
+/* Core instructions ---------------------------------------------------------*/
+static inline void __NOP(void)
+{
+    __asm volatile ("" ::: "memory");
+}
+
+static inline void __WFI(void)
+{
+    HostSim_WaitForInterrupt();
+}
+
+static inline void __WFE(void)
+{
+    HostSim_WaitForEvent();
+}
+
+static inline void __SEV(void)
+{
+    HostSim_SendEvent();
+}
+
+static inline void __ISB(void)
+{
+    __asm volatile ("" ::: "memory");
+}
+
+static inline void __DSB(void)
+{
+    __sync_synchronize();
+}
+
+static inline void __DMB(void)
+{
+    __sync_synchronize();
+}
+
+static inline uint32_t __REV(uint32_t value)
+{
+    return __builtin_bswap32(value);
+}
+
+static inline uint32_t __REV16(uint32_t value)
+{
+    return ((value & 0xFF00FF00U) >> 8) | ((value & 0x00FF00FFU) << 8);
+}
+
+static inline int32_t __REVSH(int32_t value)
+{
+    return (int32_t)(int16_t)__builtin_bswap16((uint16_t)value);
+}
+
+static inline uint32_t __ROR(uint32_t op1, uint32_t op2)
+{
+    op2 &= 31U;
+    return (op2 == 0U) ? op1 : ((op1 >> op2) | (op1 << (32U - op2)));
+}
+
+static inline uint32_t __RBIT(uint32_t value)
+{
+    uint32_t result = 0;
+    uint32_t i;
+
+    for (i = 0; i < 32U; i++)
+    {
+        result = (result << 1) | (value & 1U);
+        value >>= 1;
+    }
+    return result;
+}
+
+static inline uint8_t __CLZ(uint32_t value)
+{
+    return (value == 0U) ? 32U : (uint8_t)__builtin_clz(value);
+}
+
+/* arm_math.h brings its own __SSAT() for the Cortex-M0 family */
+#if !defined(ARM_MATH_CM0) && !defined(ARM_MATH_CM0PLUS)
+static inline int32_t __SSAT(int32_t value, uint32_t sat)
+{
+    int32_t max = (int32_t)((1UL << (sat - 1U)) - 1U);
+    int32_t min = -max - 1;
+
+    return (value > max) ? max : ((value < min) ? min : value);
+}
+#endif
+
+static inline uint32_t __USAT(int32_t value, uint32_t sat)
+{
+    uint32_t max = (uint32_t)((1ULL << sat) - 1U);
+
+    return (value < 0) ? 0U : (((uint32_t)value > max) ? max : (uint32_t)value);
+}
+
+#define __BKPT(value)   abort()
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HOST_CMSIS_H */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
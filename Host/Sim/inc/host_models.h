@@ -0,0 +1,208 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  host_models.h
+* @brief:     Test interface of the peripheral models of the host simulator.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __HOST_MODELS_H
+#define __HOST_MODELS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "host_sim.h"
+
+/**
+  * @verbatim
+  ==============================================================================
+                          ##### Modelled peripherals #####
+  ==============================================================================
+    [..]
+      (#) RCC: the ready flags follow the enable bits, SWS follows SW.
+      (#) GPIO: BSRR/BRR act on ODR, IDR returns the outputs and the levels
+          set by HostGpio_SetInput(). A listener sees every ODR change.
+      (#) DMA: 7 channels, one beat every HOSTDMA_BEAT_CYCLES. A channel is
+          served when the model owning CHPAR has a request (CHSELR is not
+          decoded) or in memory to memory mode. HT/TC/TE flags and circular
+          mode as in the reference manual, TE on an unreachable address.
+      (#) CRC: polynomial 0x04C11DB7, 8/16/32 bits writes, REV_IN/REV_OUT.
+      (#) DVSQ: signed/unsigned division, square root and high precision
+          square root with the BUSY flag held for HOSTDVSQ_xxx_CYCLES.
+      (#) EMACC: a write to CLARKE_LDR starts the chain, the stage results
+          and the completion flags of SR are set HOSTEMACC_CHAIN_CYCLES later
+          and the flags cleared by CLRSR. Sine, cosine, Clarke, Park and
+          reverse Park are computed in double precision and rounded to q15,
+          independently of the EMACC_ModelCal() integer arithmetic. The PI
+          keep their integral terms from one chain to the next, the circle
+          limitation uses CIRCLELMT_CFG and the table of the PID RAM. There
+          is no interrupt: the flags are polled.
+      (#) AES: 128/192/256 bits keys, encryption, key derivation and
+          decryption, CCF/RDERR/WRERR, DMA in and out. The model has its
+          own AES, independent of the AES_Model functions of the driver.
+      (#) FLASH: unlock sequence, word programming, page, half page and mass
+          erase with BSY held for the operation time, PGERR, SIZEERR,
+          WRPRTERR, EOP interrupt. HostFlash_PowerLossAt() cuts the power in
+          the middle of an operation and leaves it torn.
+      (#) USART1/2, UART3/4: transmit log, receive queue, TXE/TC/RXNE/ORE/IDLE,
+          interrupts and DMA requests, one character every 10 bits of BRR.
+      (#) SPI1/2: master mode, 4 bytes FIFOs with FRXTH and data packing,
+          TXE/RXNE/BSY/OVR, interrupts and DMA requests, one byte every
+          8 SCK periods. Each byte is exchanged with the devices connected
+          by HostSpi_Connect(): MISO is 0xFF when no device is selected.
+      (#) SD card: standard capacity card in SPI mode on a SPI bus model.
+          CMD0/1/9/10/12/13/16/17/18/24/25/55 and ACMD23, R1 and data
+          tokens, read access time and programming busy time in cycles.
+      (#) SPI FLASH: M25P80 on a SPI bus model, the instruction is decoded
+          while the chip select is low and executed on its rising edge.
+          WREN/WRDI/RDSR/RDID/READ/page program/sector and bulk erase with
+          WIP held for shortened programming and erase times.
+      (#) ADC: calibration leaving HOSTADC_CALIBRATION_FACTOR in DR, scans
+          of the CHSELR channels in the SCANDIR order, started by ADSTART or
+          by HostAdc_Trigger() with EXTEN set, CONT, oversampling, DMA
+          requests on DR. A result ending with DR not read sets OVR: with
+          OVRMOD cleared DR is kept, and with DMAEN the conversions stop
+          and the DMA requests are masked until OVR is cleared. One
+          conversion takes HOSTADC_CONVERSION_CYCLES per oversampled result.
+      (#) DAC: a trigger, SWTRIG or HostDac_Trigger() as TSEL selects, moves
+          DHR12R to DOR and with DMAEN requests the next sample on DHR12R.
+          A trigger before the DMA has served the request sets DMAUDR and
+          DOR keeps its sample, then the DMA requests stop and the output
+          holds until DMAUDR is cleared and DMAEN cleared and set again.
+          Without TEN a write to DHR is output at once.
+      (#) CAN: INAK and SLAK follow INRQ and SLEEP at once. Out of the
+          initialization and sleep modes the pending mailboxes are sent by
+          identifier priority, one frame every HOSTCAN_FRAME_CYCLES, to the
+          transmit log, then RQCP, TXOK and TME are set. A frame written
+          to a pending mailbox is ignored. HostCan_Receive() stores the
+          frame of another node in a FIFO of 3, unfiltered, FOVR on the
+          fourth. FMP, FULL, FOVR and RQCP raise LCD_CAN_IRQn with their
+          enable bits.
+      (#) USB: the packet memory area only, 256 half-words each in the low
+          half of a 32 bits slot, the upper half reads as 0.
+  @endverbatim
+  */
+
+/* Exported constants --------------------------------------------------------*/
+#define HOSTDMA_BEAT_CYCLES         2U
+#define HOSTDVSQ_DIV_CYCLES         9U
+#define HOSTDVSQ_SQRT_CYCLES        17U
+#define HOSTEMACC_CHAIN_CYCLES      40U
+#define HOSTAES_BLOCK_CYCLES        52U
+#define HOSTFLASH_PROGRAM_CYCLES    1200U
+#define HOSTFLASH_HALF_ERASE_CYCLES 40000U
+#define HOSTFLASH_ERASE_CYCLES      64000U
+#define HOSTFLASH_MASS_ERASE_CYCLES 128000U
+#define HOSTSD_MAX_BLOCKS           1024U
+#define HOSTSD_ACCESS_CYCLES        2000U       /*!< Read command or block to start token */
+#define HOSTSD_PROGRAM_CYCLES       6000U       /*!< Busy time of a written block */
+#define HOSTSD_ERASE_CYCLES         10000U      /*!< Added for a block not pre-erased by ACMD23 */
+#define HOSTSD_STOP_CYCLES          1000U       /*!< Busy time after CMD12 or the stop token */
+#define HOSTSFLASH_SIZE             0x100000U
+#define HOSTSFLASH_PAGE_CYCLES      20000U      /*!< Page program time */
+#define HOSTSFLASH_SECTOR_CYCLES    100000U     /*!< Sector erase time */
+#define HOSTSFLASH_BULK_CYCLES      400000U     /*!< Bulk erase time */
+#define HOSTSD_ACMD                 0x40U       /*!< HostSd_Commands() index of ACMDn: n | HOSTSD_ACMD */
+#define HOSTADC_CHANNELS            19U         /*!< Channels 0 to 15, Vrefint 17 and temperature sensor 18 */
+#define HOSTADC_CONVERSION_CYCLES   40U
+#define HOSTADC_CALIBRATION_CYCLES  200U
+#define HOSTADC_CALIBRATION_FACTOR  0x2AU
+#define HOSTCAN_FRAME_CYCLES        240U        /*!< One frame on the bus */
+
+/* Exported types ------------------------------------------------------------*/
+typedef void (*HostGpio_ListenerTypeDef)(GPIO_TypeDef* GPIOx, uint16_t Output, uint16_t Changed);
+
+/**
+  * @brief  Device on a SPI bus model, selected by a low level on CsPin.
+  */
+typedef struct HostSpi_Device HostSpi_DeviceTypeDef;
+struct HostSpi_Device
+{
+    /*!< Called for each byte clocked on the bus, returns the byte driven on MISO */
+    uint8_t (*Exchange)(HostSpi_DeviceTypeDef* Device, uint8_t Mosi, uint8_t Selected);
+    GPIO_TypeDef* CsPort;
+    uint16_t CsPin;
+    void* Context;
+    HostSpi_DeviceTypeDef* Next;
+};
+
+/* Exported functions --------------------------------------------------------*/
+void HostModel_AttachAll(void);
+
+/* GPIO */
+void HostGpio_SetInput(GPIO_TypeDef* GPIOx, uint16_t Pins, uint8_t Level);
+uint16_t HostGpio_GetOutput(GPIO_TypeDef* GPIOx);
+void HostGpio_Listen(HostGpio_ListenerTypeDef Listener);
+
+/* DMA */
+uint32_t HostDma_Beats(void);
+
+/* CRC */
+uint32_t HostCrc_Writes(void);
+
+/* DVSQ */
+uint32_t HostDvsq_Operations(void);
+
+/* EMACC */
+uint32_t HostEmacc_Calculations(void);
+
+/* AES */
+uint32_t HostAes_Blocks(void);
+
+/* FLASH */
+uint32_t HostFlash_Operations(void);
+void HostFlash_PowerLossAt(uint32_t Operation);
+void HostFlash_SetWriteProtection(uint32_t Mask);
+
+/* USART */
+void HostUsart_Receive(USART_TypeDef* USARTx, const uint8_t* Data, uint32_t Length);
+uint32_t HostUsart_Transmitted(USART_TypeDef* USARTx, uint8_t* Data, uint32_t Size);
+uint32_t HostUsart_RxPending(USART_TypeDef* USARTx);
+
+/* SPI */
+void HostSpi_Connect(SPI_TypeDef* SPIx, HostSpi_DeviceTypeDef* Device);
+uint32_t HostSpi_Bytes(void);
+
+/* SD card */
+void HostSd_Insert(SPI_TypeDef* SPIx, GPIO_TypeDef* CsPort, uint16_t CsPin, uint32_t Blocks);
+uint8_t* HostSd_Memory(void);
+void HostSd_WriteErrorAt(uint32_t Block);
+uint32_t HostSd_Commands(uint32_t Command);
+uint32_t HostSd_BlocksRead(void);
+uint32_t HostSd_BlocksWritten(void);
+
+/* SPI FLASH */
+void HostSFlash_Insert(SPI_TypeDef* SPIx, GPIO_TypeDef* CsPort, uint16_t CsPin);
+uint8_t* HostSFlash_Memory(void);
+uint32_t HostSFlash_Programs(void);
+uint32_t HostSFlash_Erases(void);
+
+/* ADC */
+void HostAdc_SetInput(uint32_t Channel, uint16_t Value);
+void HostAdc_Trigger(void);
+uint32_t HostAdc_Conversions(void);
+uint32_t HostAdc_Calibrations(void);
+
+/* DAC */
+void HostDac_Trigger(void);
+uint32_t HostDac_Conversions(void);
+uint32_t HostDac_Underruns(void);
+
+/* CAN */
+void HostCan_Receive(uint8_t FIFONumber, const CanMailbox* Frame, uint32_t Delay);
+uint32_t HostCan_Transmitted(CanMailbox* Frames, uint32_t Size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HOST_MODELS_H */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
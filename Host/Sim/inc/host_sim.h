@@ -0,0 +1,140 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  host_sim.h
+* @brief:     Register level simulator used to run the firmware library on a
+*             Linux x86-64 host.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __HOST_SIM_H
+#define __HOST_SIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <setjmp.h>
+#include "hk32l0xx.h"
+
+/**
+  * @verbatim
+  ==============================================================================
+                        ##### How the simulator works #####
+  ==============================================================================
+    [..]
+      (#) The device memory map is mapped at its real addresses, so the
+          unmodified drivers dereference FLASH, CRC, DMA... as on the target.
+          The program must be linked with -no-pie so that its own variables
+          sit below 4 GB and can be used as DMA addresses. Drivers that
+          cast a pointer to uint32_t (DMA addresses, AES_KeyInit()) must be
+          given static buffers, never locals of the host stack.
+      (#) The peripheral and core (SCS) windows are mapped without access
+          rights. Each CPU access faults, the access is single stepped and the
+          owning model sees it through its Read() and Write() callbacks.
+          Flash and system memory are read-only: reads are free, writes go
+          to the model of the flash array.
+      (#) Simulated time is counted in bus cycles. It only advances on a
+          peripheral access (HOSTSIM_ACCESS_CYCLES each), on __WFI()/__WFE()
+          and in HostSim_Run(). A loop spinning on a RAM variable that only
+          an interrupt sets never lets time pass: use __WFI() in such loops.
+      (#) Interrupt lines are level sensitive and latched by the NVIC model.
+          Handlers are called on the host stack from the access that makes
+          them deliverable, honouring PRIMASK and NVIC priorities.
+      (#) Models reach their registers through the backdoor alias returned by
+          HostSim_Backdoor(), which never faults.
+  @endverbatim
+  */
+
+/* Exported constants --------------------------------------------------------*/
+#define HOSTSIM_FLASH_BASE          ((uint32_t)0x08000000)
+#define HOSTSIM_FLASH_SIZE          ((uint32_t)0x00010000)
+#define HOSTSIM_SYSMEM_BASE         ((uint32_t)0x1FFFF000)
+#define HOSTSIM_SYSMEM_SIZE         ((uint32_t)0x00001000)
+#define HOSTSIM_SRAM_BASE           ((uint32_t)0x20000000)
+#define HOSTSIM_SRAM_SIZE           ((uint32_t)0x00005000)
+#define HOSTSIM_PERIPH_BASE         ((uint32_t)0x40000000)
+#define HOSTSIM_PERIPH_SIZE         ((uint32_t)0x00040000)
+#define HOSTSIM_IOPORT_BASE         ((uint32_t)0x48000000)
+#define HOSTSIM_IOPORT_SIZE         ((uint32_t)0x00002000)
+#define HOSTSIM_SCS_BASE            ((uint32_t)0xE000E000)
+#define HOSTSIM_SCS_SIZE            ((uint32_t)0x00001000)
+
+#define HOSTSIM_ACCESS_CYCLES       2U          /*!< Bus cycles of one CPU access to a register */
+#define HOSTSIM_WFI_TIMEOUT         20000000U   /*!< Cycles after which __WFI() reports a dead lock */
+
+#define HOSTSIM_RESET_POWER_LOSS    1           /*!< HOSTSIM_POWER_ON() result after HostSim_PowerLoss() */
+#define HOSTSIM_RESET_SYSTEM        2           /*!< HOSTSIM_POWER_ON() result after NVIC_SystemReset() */
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct HostSim_Model HostSim_ModelTypeDef;
+
+/**
+  * @brief  Peripheral model. Offsets are relative to Base, Width is 1, 2 or 4.
+  */
+struct HostSim_Model
+{
+    const char* Name;
+    uint32_t Base;
+    uint32_t Size;
+    void (*Reset)(HostSim_ModelTypeDef* Model);
+    /*!< Called before a CPU or DMA read: refreshes the register in memory. */
+    void (*Read)(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width);
+    /*!< Called after a write. Value holds the written bits, Previous the word
+         at the aligned offset before the write. */
+    void (*Write)(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous);
+    /*!< Returns 1 when a DMA channel addressing Offset has a pending request.
+         Write is 1 for a channel writing the peripheral, 0 for a reading one. */
+    uint8_t (*DMARequest)(HostSim_ModelTypeDef* Model, uint32_t Offset, uint8_t Write);
+    /*!< Called once per bus cycle. */
+    void (*Tick)(HostSim_ModelTypeDef* Model);
+    void* Context;
+    uint32_t Index;
+    HostSim_ModelTypeDef* Next;
+    volatile uint8_t* Alias;            /*!< Backdoor view of Base, set by HostSim_Attach() */
+};
+
+/* Exported variables --------------------------------------------------------*/
+extern sigjmp_buf HostSim_ResetPoint;
+extern volatile uint8_t HostSim_ResetArmed;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Registers of a model, through the backdoor alias */
+#define HOSTSIM_REG(Model, Offset)  (*(volatile uint32_t*)((Model)->Alias + (Offset)))
+
+/* Restart point of the firmware: returns 0, then HOSTSIM_RESET_xxx after a reset */
+#define HOSTSIM_POWER_ON()          (HostSim_ResetArmed = 1, sigsetjmp(HostSim_ResetPoint, 1))
+
+/* Exported functions --------------------------------------------------------*/
+void HostSim_Init(void);
+void HostSim_Reset(void);
+void HostSim_Attach(HostSim_ModelTypeDef* Model);
+void* HostSim_Backdoor(uint32_t Address);
+uint8_t HostSim_IsMapped(uint32_t Address, uint32_t Width);
+uint32_t HostSim_BusRead(uint32_t Address, uint32_t Width, uint8_t* Fault);
+void HostSim_BusWrite(uint32_t Address, uint32_t Width, uint32_t Value, uint8_t* Fault);
+HostSim_ModelTypeDef* HostSim_FindModel(uint32_t Address);
+
+void HostSim_SetIrqLine(HostSim_ModelTypeDef* Model, IRQn_Type IRQn, uint8_t Level);
+void HostSim_Run(uint32_t Cycles);
+void HostSim_Stall(uint32_t Cycles);
+uint64_t HostSim_Cycles(void);
+uint64_t HostSim_Accesses(void);
+void HostSim_Dispatch(void);
+
+void HostSim_PowerLoss(void);
+void HostSim_SystemReset(void);
+void HostSim_Fatal(const char* Format, ...) __attribute__((noreturn, format(printf, 1, 2)));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HOST_SIM_H */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,69 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  host_test.h
+* @brief:     Check macros of the host tests.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __HOST_TEST_H
+#define __HOST_TEST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "host_models.h"
+
+/**
+  * @verbatim
+  ==============================================================================
+                             ##### How to use #####
+  ==============================================================================
+    [..]
+      (#) Each test program has a main() that calls HOSTTEST_RUN() for each of
+          its test functions and returns HostTest_End().
+      (#) HostTest_Run() gives every test a freshly reset device: peripherals
+          at their reset values, flash erased, SRAM cleared.
+      (#) HOSTTEST_RUN_ON_SRAM() runs the test with its stack in the device
+          SRAM, for drivers that give locals to the DMA.
+      (#) A failed CHECK() reports the file and line and the test goes on;
+          HostTest_End() returns non zero when any check failed.
+  @endverbatim
+  */
+
+/* Exported macro ------------------------------------------------------------*/
+#define CHECK(Condition) \
+    HostTest_Check((Condition) ? 1 : 0, __FILE__, __LINE__, #Condition)
+
+#define CHECK_EQUAL(Expected, Actual) \
+    HostTest_CheckEqual((long long)(Expected), (long long)(Actual), __FILE__, __LINE__, #Actual)
+
+#define CHECK_MEMORY(Expected, Actual, Size) \
+    HostTest_CheckMemory((Expected), (Actual), (Size), __FILE__, __LINE__, #Actual)
+
+#define HOSTTEST_RUN(Test)          HostTest_Run(#Test, Test)
+#define HOSTTEST_RUN_ON_SRAM(Test)  HostTest_RunOnSram(#Test, Test)
+
+/* Exported functions --------------------------------------------------------*/
+void HostTest_Run(const char* Name, void (*Test)(void));
+void HostTest_RunOnSram(const char* Name, void (*Test)(void));
+int HostTest_End(void);
+uint8_t HostTest_Check(uint8_t Passed, const char* File, int Line, const char* Text);
+uint8_t HostTest_CheckEqual(long long Expected, long long Actual, const char* File, int Line, const char* Text);
+uint8_t HostTest_CheckMemory(const void* Expected, const void* Actual, uint32_t Size, const char* File, int Line, const char* Text);
+void HostTest_EraseFlash(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HOST_TEST_H */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
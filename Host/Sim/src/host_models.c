@@ -0,0 +1,79 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  host_models.c
+* @brief:     List of the peripheral models attached to the simulated bus.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "host_models.h"
+
+/** @addtogroup HostSim
+  * @{
+  */
+
+/* Private variables ---------------------------------------------------------*/
+extern HostSim_ModelTypeDef HostRcc_Model;
+extern HostSim_ModelTypeDef HostGpio_Model;
+extern HostSim_ModelTypeDef HostDma_Model;
+extern HostSim_ModelTypeDef HostCrc_Model;
+extern HostSim_ModelTypeDef HostDvsq_Model;
+extern HostSim_ModelTypeDef HostEmacc_Model;
+extern HostSim_ModelTypeDef HostAes_Model;
+extern HostSim_ModelTypeDef HostFlash_Model;
+extern HostSim_ModelTypeDef HostFlash_ArrayModel;
+extern HostSim_ModelTypeDef HostUsart_Models[4];
+extern HostSim_ModelTypeDef HostSpi_Models[2];
+extern HostSim_ModelTypeDef HostAdc_Model;
+extern HostSim_ModelTypeDef HostDac_Model;
+extern HostSim_ModelTypeDef HostUsb_PmaModel;
+extern HostSim_ModelTypeDef HostCan_Model;
+
+static HostSim_ModelTypeDef* const HostModel_List[] =
+{
+    &HostRcc_Model,
+    &HostGpio_Model,
+    &HostDma_Model,
+    &HostCrc_Model,
+    &HostDvsq_Model,
+    &HostEmacc_Model,
+    &HostAes_Model,
+    &HostFlash_Model,
+    &HostFlash_ArrayModel,
+    &HostUsart_Models[0],
+    &HostUsart_Models[1],
+    &HostUsart_Models[2],
+    &HostUsart_Models[3],
+    &HostSpi_Models[0],
+    &HostSpi_Models[1],
+    &HostAdc_Model,
+    &HostDac_Model,
+    &HostUsb_PmaModel,
+    &HostCan_Model,
+};
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Attaches every peripheral model, called once by HostSim_Init().
+  * @retval None
+  */
+void HostModel_AttachAll(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < sizeof(HostModel_List) / sizeof(HostModel_List[0]); i++)
+    {
+        HostSim_Attach(HostModel_List[i]);
+    }
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,1134 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  host_sim.c
+* @brief:     Register level simulator: memory map, access trapping, simulated
+*             time and the Cortex-M0 system control space (NVIC, SysTick, SCB).
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include "host_sim.h"
+#include "host_models.h"
+
+/** @addtogroup HostSim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+    uint32_t Base;
+    uint32_t Size;
+    int Prot;                      /*!< Protection while no access is in flight */
+    uint8_t* Alias;                /*!< Backdoor view, always read/write */
+} HostSim_RegionTypeDef;
+
+typedef enum
+{
+    HOSTSIM_READ = 0,
+    HOSTSIM_WRITE,
+    HOSTSIM_READ_WRITE
+} HostSim_AccessKindTypeDef;
+
+typedef struct
+{
+    uint8_t Active;
+    HostSim_AccessKindTypeDef Kind;
+    uint32_t Address;
+    uint32_t Width;
+    uint32_t Previous[4];
+    uintptr_t Rip;                      /*!< Address of the faulting instruction */
+    uintptr_t Page;
+    size_t PageSpan;
+    HostSim_RegionTypeDef* Region;
+    HostSim_ModelTypeDef* Model;
+} HostSim_AccessTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define HOSTSIM_PAGE_SIZE           ((uintptr_t)0x1000)
+#define HOSTSIM_MAX_MODELS          32U
+#define HOSTSIM_EXCEPTIONS          48U
+#define HOSTSIM_TRAP_FLAG           ((greg_t)0x100)
+#define HOSTSIM_STORM_LIMIT         100000U
+#define HOSTSIM_POLL_ACCESSES       256U
+
+/* System control space offsets */
+#define SCS_SYST_CSR                0x010U
+#define SCS_SYST_RVR                0x014U
+#define SCS_SYST_CVR                0x018U
+#define SCS_SYST_CALIB              0x01CU
+#define SCS_NVIC_ISER               0x100U
+#define SCS_NVIC_ICER               0x180U
+#define SCS_NVIC_ISPR               0x200U
+#define SCS_NVIC_ICPR               0x280U
+#define SCS_NVIC_IPR                0x300U
+#define SCS_SCB_CPUID               0xD00U
+#define SCS_SCB_ICSR                0xD04U
+#define SCS_SCB_AIRCR               0xD0CU
+#define SCS_SCB_SHPR2               0xD1CU
+#define SCS_SCB_SHPR3               0xD20U
+
+#define EXC_SVCALL                  11U
+#define EXC_PENDSV                  14U
+#define EXC_SYSTICK                 15U
+#define EXC_IRQ0                    16U
+
+/* Private macro -------------------------------------------------------------*/
+#define EXC_BIT(n)                  ((uint64_t)1 << (n))
+
+/* Private variables ---------------------------------------------------------*/
+static HostSim_RegionTypeDef HostSim_Regions[] =
+{
+    {HOSTSIM_FLASH_BASE,  HOSTSIM_FLASH_SIZE,  PROT_READ,              NULL},
+    {HOSTSIM_SYSMEM_BASE, HOSTSIM_SYSMEM_SIZE, PROT_READ,              NULL},
+    {HOSTSIM_SRAM_BASE,   HOSTSIM_SRAM_SIZE,   PROT_READ | PROT_WRITE, NULL},
+    {HOSTSIM_PERIPH_BASE, HOSTSIM_PERIPH_SIZE, PROT_NONE,              NULL},
+    {HOSTSIM_IOPORT_BASE, HOSTSIM_IOPORT_SIZE, PROT_NONE,              NULL},
+    {HOSTSIM_SCS_BASE,    HOSTSIM_SCS_SIZE,    PROT_NONE,              NULL},
+};
+
+#define HOSTSIM_REGIONS             (sizeof(HostSim_Regions) / sizeof(HostSim_Regions[0]))
+
+static HostSim_AccessTypeDef HostSim_Access;
+static HostSim_ModelTypeDef* HostSim_ModelList;
+static HostSim_ModelTypeDef* HostSim_TickList[HOSTSIM_MAX_MODELS];
+static uint32_t HostSim_TickCount;
+static uint32_t HostSim_ModelCount;
+static uint8_t HostSim_Initialized;
+
+static uint64_t HostSim_Clock;
+static uint64_t HostSim_CpuAccesses;
+
+/* NVIC state: bit n is exception number n */
+static uint64_t HostSim_Enabled;
+static uint64_t HostSim_Latched;
+static uint64_t HostSim_Active;
+static uint64_t HostSim_Lines[HOSTSIM_MAX_MODELS];
+static uint32_t HostSim_Primask;
+static uint8_t HostSim_Event;
+static uint32_t HostSim_ActiveStack[HOSTSIM_EXCEPTIONS];
+static uint32_t HostSim_ActiveDepth;
+static uint32_t HostSim_Storm;
+static uint64_t HostSim_Exceptions;
+static uintptr_t HostSim_LastRip;
+static uint32_t HostSim_LastAddress;
+static uint32_t HostSim_LastValue;
+
+/* SysTick state */
+static uint32_t HostSim_SysTickCtrl;
+static uint32_t HostSim_SysTickLoad;
+static uint32_t HostSim_SysTickValue;
+
+uint32_t HostSim_Control;
+uint32_t HostSim_Psp;
+uint32_t HostSim_Msp;
+
+sigjmp_buf HostSim_ResetPoint;
+volatile uint8_t HostSim_ResetArmed;
+
+extern void (* const HostSim_Vectors[HOSTSIM_EXCEPTIONS])(void);
+extern char __executable_start[];
+extern char _end[];
+
+/* Private function prototypes -----------------------------------------------*/
+static void HostSim_ScsReset(HostSim_ModelTypeDef* Model);
+static void HostSim_ScsRead(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width);
+static void HostSim_ScsWrite(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous);
+
+static HostSim_ModelTypeDef HostSim_ScsModel =
+{
+    "SCS", HOSTSIM_SCS_BASE, HOSTSIM_SCS_SIZE,
+    HostSim_ScsReset, HostSim_ScsRead, HostSim_ScsWrite, NULL, NULL, NULL, 0, NULL
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Returns the region holding an address, NULL outside the device map.
+  */
+static HostSim_RegionTypeDef* HostSim_FindRegion(uintptr_t Address)
+{
+    uint32_t i;
+
+    for (i = 0; i < HOSTSIM_REGIONS; i++)
+    {
+        if ((Address >= HostSim_Regions[i].Base) && (Address - HostSim_Regions[i].Base < HostSim_Regions[i].Size))
+        {
+            return &HostSim_Regions[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+  * @brief  Decodes the x86-64 instruction that faulted to find the access width
+  *         and whether it only stores (no read of the old value).
+  */
+static uint32_t HostSim_DecodeWidth(const uint8_t* Code, uint8_t* PureStore)
+{
+    uint32_t width = 4;
+    uint8_t operandSize = 0;
+    uint8_t repeat = 0;
+    uint8_t opcode;
+
+    *PureStore = 0;
+
+    for (;;)
+    {
+        if (*Code == 0x66)
+        {
+            operandSize = 1;
+        }
+        else if ((*Code == 0xF2) || (*Code == 0xF3))
+        {
+            repeat = *Code;
+        }
+        else if ((*Code != 0xF0) && (*Code != 0x2E) && (*Code != 0x36) && (*Code != 0x3E) &&
+                 (*Code != 0x26) && (*Code != 0x64) && (*Code != 0x65) && (*Code != 0x67))
+        {
+            break;
+        }
+        Code++;
+    }
+
+    if (operandSize != 0)
+    {
+        width = 2;
+    }
+    if ((*Code & 0xF0) == 0x40)
+    {
+        if ((*Code & 0x08) != 0)
+        {
+            width = 8;
+        }
+        Code++;
+    }
+
+    opcode = *Code;
+
+    if (opcode == 0x0F)
+    {
+        switch (Code[1])
+        {
+            case 0xB0:
+            case 0xB6:
+            case 0xBE:
+            case 0xC0:
+                return 1;
+
+            case 0xB7:
+            case 0xBF:
+                return 2;
+
+            case 0x11:
+            case 0x29:
+            case 0x2B:
+            case 0x7F:
+            case 0xE7:
+                *PureStore = 1;
+                return (repeat == 0xF3) ? 4 : ((repeat == 0xF2) ? 8 : 16);
+
+            case 0x10:
+            case 0x28:
+            case 0x6F:
+                return (repeat == 0xF3) ? 4 : ((repeat == 0xF2) ? 8 : 16);
+
+            case 0xD6:
+                *PureStore = 1;
+                return 8;
+
+            case 0x6E:
+                return (width == 8) ? 8 : 4;
+
+            case 0x7E:
+                if (repeat == 0xF3)
+                {
+                    return 8;
+                }
+                *PureStore = 1;
+                return (width == 8) ? 8 : 4;
+
+            default:
+                return width;
+        }
+    }
+
+    switch (opcode)
+    {
+        case 0x88:
+        case 0xC6:
+        case 0xA2:
+        case 0xAA:
+            *PureStore = 1;
+            return 1;
+
+        case 0x89:
+        case 0xC7:
+        case 0xA3:
+        case 0xAB:
+            *PureStore = 1;
+            return width;
+
+        case 0x00: case 0x02: case 0x08: case 0x0A: case 0x10: case 0x12:
+        case 0x18: case 0x1A: case 0x20: case 0x22: case 0x28: case 0x2A:
+        case 0x30: case 0x32: case 0x38: case 0x3A: case 0x84: case 0x86:
+        case 0x8A: case 0x80: case 0xF6: case 0xFE: case 0xA0: case 0xAC:
+        case 0xA4: case 0xA6: case 0xAE:
+            return 1;
+
+        default:
+            return width;
+    }
+}
+
+/**
+  * @brief  Returns a host pointer to simulated or host memory.
+  */
+static void* HostSim_Pointer(uint32_t Address)
+{
+    void* alias = HostSim_Backdoor(Address);
+
+    return (alias != NULL) ? alias : (void*)(uintptr_t)Address;
+}
+
+static uint32_t HostSim_Load(const void* Pointer, uint32_t Width)
+{
+    switch (Width)
+    {
+        case 1:
+            return *(const volatile uint8_t*)Pointer;
+        case 2:
+            return *(const volatile uint16_t*)Pointer;
+        default:
+            return *(const volatile uint32_t*)Pointer;
+    }
+}
+
+static void HostSim_Store(void* Pointer, uint32_t Width, uint32_t Value)
+{
+    switch (Width)
+    {
+        case 1:
+            *(volatile uint8_t*)Pointer = (uint8_t)Value;
+            break;
+        case 2:
+            *(volatile uint16_t*)Pointer = (uint16_t)Value;
+            break;
+        default:
+            *(volatile uint32_t*)Pointer = Value;
+            break;
+    }
+}
+
+/**
+  * @brief  Splits an access wider than a register into word accesses.
+  */
+static uint32_t HostSim_Chunk(uint32_t Width, uint32_t Index)
+{
+    return (Width > 4U) ? 4U : ((Index == 0U) ? Width : 0U);
+}
+
+static void HostSim_Protect(uintptr_t Page, size_t Span, int Prot)
+{
+    if (mprotect((void*)Page, Span, Prot) != 0)
+    {
+        HostSim_Fatal("mprotect(0x%08lx) failed", (unsigned long)Page);
+    }
+}
+
+/**
+  * @brief  First half of a trapped access: the instruction has not run yet.
+  */
+static void HostSim_OnFault(int Signal, siginfo_t* Info, void* Context)
+{
+    ucontext_t* context = (ucontext_t*)Context;
+    uintptr_t address = (uintptr_t)Info->si_addr;
+    HostSim_RegionTypeDef* region = HostSim_FindRegion(address);
+    HostSim_AccessTypeDef* access = &HostSim_Access;
+    uint8_t pureStore;
+    uint32_t i;
+    uintptr_t last;
+
+    (void)Signal;
+
+    if ((region == NULL) || (access->Active != 0))
+    {
+        fprintf(stderr, "host: memory fault at 0x%lx\n", (unsigned long)address);
+        signal(SIGSEGV, SIG_DFL);
+        return;
+    }
+
+    access->Address = (uint32_t)address;
+    access->Rip = (uintptr_t)context->uc_mcontext.gregs[REG_RIP];
+    access->Width = HostSim_DecodeWidth((const uint8_t*)context->uc_mcontext.gregs[REG_RIP], &pureStore);
+    access->Region = region;
+    access->Model = HostSim_FindModel(access->Address);
+
+    if ((context->uc_mcontext.gregs[REG_ERR] & 2) == 0)
+    {
+        access->Kind = HOSTSIM_READ;
+    }
+    else
+    {
+        access->Kind = (pureStore != 0) ? HOSTSIM_WRITE : HOSTSIM_READ_WRITE;
+        if ((region->Prot & PROT_WRITE) == 0 && access->Model == NULL)
+        {
+            HostSim_Fatal("write to read-only memory at 0x%08x", access->Address);
+        }
+    }
+
+    for (i = 0; (i < 4U) && (HostSim_Chunk(access->Width, i) != 0U); i++)
+    {
+        uint32_t word = access->Address + (i * 4U);
+
+        if ((access->Kind != HOSTSIM_WRITE) && (access->Model != NULL) && (access->Model->Read != NULL))
+        {
+            access->Model->Read(access->Model, word - access->Model->Base, HostSim_Chunk(access->Width, i));
+        }
+        access->Previous[i] = *(volatile uint32_t*)HostSim_Backdoor(word & ~3U);
+    }
+
+    access->Page = address & ~(HOSTSIM_PAGE_SIZE - 1);
+    last = (address + access->Width - 1) & ~(HOSTSIM_PAGE_SIZE - 1);
+    access->PageSpan = (size_t)(last - access->Page + HOSTSIM_PAGE_SIZE);
+    access->Active = 1;
+
+    HostSim_Protect(access->Page, access->PageSpan, PROT_READ | PROT_WRITE);
+    context->uc_mcontext.gregs[REG_EFL] |= HOSTSIM_TRAP_FLAG;
+}
+
+/**
+  * @brief  Runs the next iterations of a polling loop without trapping them:
+  *         one access time each, as long as the polled word keeps its value
+  *         and no exception is taken, HOSTSIM_POLL_ACCESSES at most. Read()
+  *         is not called, so a register only refreshed by Read() (GPIO IDR)
+  *         is seen late by at most HOSTSIM_POLL_ACCESSES accesses.
+  */
+static void HostSim_Poll(uint32_t Word, uint32_t Value, uint64_t Exceptions)
+{
+    uint32_t n;
+
+    for (n = 0; n < HOSTSIM_POLL_ACCESSES; n++)
+    {
+        if ((*(volatile uint32_t*)HostSim_Backdoor(Word) != Value) || (HostSim_Exceptions != Exceptions))
+        {
+            break;
+        }
+        HostSim_CpuAccesses++;
+        HostSim_Run(HOSTSIM_ACCESS_CYCLES);
+    }
+}
+
+/**
+  * @brief  Second half of a trapped access: the instruction has completed.
+  */
+static void HostSim_OnStep(int Signal, siginfo_t* Info, void* Context)
+{
+    ucontext_t* context = (ucontext_t*)Context;
+    HostSim_AccessTypeDef* access = &HostSim_Access;
+    uint64_t exceptions = HostSim_Exceptions;
+    uint32_t word;
+    uint32_t value;
+    uint8_t poll;
+    uint32_t i;
+
+    (void)Signal;
+    (void)Info;
+
+    context->uc_mcontext.gregs[REG_EFL] &= ~HOSTSIM_TRAP_FLAG;
+
+    if (access->Active == 0)
+    {
+        return;
+    }
+
+    HostSim_Protect(access->Page, access->PageSpan, access->Region->Prot);
+    access->Active = 0;
+
+    /* The same instruction reading the same value at the same address again
+       is a polling loop. Handlers called by HostSim_Run() reuse access. */
+    word = access->Address & ~3U;
+    value = access->Previous[0];
+    poll = (uint8_t)((access->Kind == HOSTSIM_READ) && (access->Width <= 4U) && (access->Rip == HostSim_LastRip) &&
+                     (access->Address == HostSim_LastAddress) && (value == HostSim_LastValue));
+    HostSim_LastRip = (access->Kind == HOSTSIM_READ) ? access->Rip : 0;
+    HostSim_LastAddress = access->Address;
+    HostSim_LastValue = value;
+
+    if ((access->Kind != HOSTSIM_READ) && (access->Model != NULL) && (access->Model->Write != NULL))
+    {
+        for (i = 0; (i < 4U) && (HostSim_Chunk(access->Width, i) != 0U); i++)
+        {
+            uint32_t word = access->Address + (i * 4U);
+            uint32_t width = HostSim_Chunk(access->Width, i);
+
+            access->Model->Write(access->Model, word - access->Model->Base, width,
+                                 HostSim_Load(HostSim_Backdoor(word), width), access->Previous[i]);
+        }
+    }
+
+    HostSim_CpuAccesses++;
+    HostSim_Run(HOSTSIM_ACCESS_CYCLES);
+
+    if (poll != 0)
+    {
+        HostSim_Poll(word, value, exceptions);
+    }
+}
+
+/**
+  * @brief  Priority of an exception, lower value wins.
+  */
+static uint32_t HostSim_Priority(uint32_t Exception)
+{
+    uint32_t irq;
+
+    if (Exception >= EXC_IRQ0)
+    {
+        irq = Exception - EXC_IRQ0;
+        return (HOSTSIM_REG(&HostSim_ScsModel, SCS_NVIC_IPR + (irq & ~3U)) >> ((irq & 3U) * 8U)) & 0xFFU;
+    }
+    if (Exception == EXC_SYSTICK)
+    {
+        return HOSTSIM_REG(&HostSim_ScsModel, SCS_SCB_SHPR3) >> 24;
+    }
+    if (Exception == EXC_PENDSV)
+    {
+        return (HOSTSIM_REG(&HostSim_ScsModel, SCS_SCB_SHPR3) >> 16) & 0xFFU;
+    }
+    return HOSTSIM_REG(&HostSim_ScsModel, SCS_SCB_SHPR2) >> 24;
+}
+
+static uint64_t HostSim_LineLevels(void)
+{
+    uint64_t lines = 0;
+    uint32_t i;
+
+    for (i = 0; i < HostSim_ModelCount; i++)
+    {
+        lines |= HostSim_Lines[i];
+    }
+    return lines;
+}
+
+static uint64_t HostSim_PendingSet(void)
+{
+    return (HostSim_Latched | HostSim_LineLevels()) & (HostSim_Enabled | EXC_BIT(EXC_PENDSV) | EXC_BIT(EXC_SYSTICK));
+}
+
+/**
+  * @brief  Returns the exception to take next, 0 if none can preempt.
+  */
+static uint32_t HostSim_NextException(uint8_t IgnorePrimask)
+{
+    uint64_t pending = HostSim_PendingSet() & ~HostSim_Active;
+    uint32_t current = 0x100;
+    uint32_t best = 0;
+    uint32_t bestPriority = 0x100;
+    uint32_t i;
+
+    if ((HostSim_Primask != 0) && (IgnorePrimask == 0))
+    {
+        return 0;
+    }
+
+    for (i = 0; i < HostSim_ActiveDepth; i++)
+    {
+        if (HostSim_Priority(HostSim_ActiveStack[i]) < current)
+        {
+            current = HostSim_Priority(HostSim_ActiveStack[i]);
+        }
+    }
+
+    for (i = 0; (pending != 0) && (i < HOSTSIM_EXCEPTIONS); i++)
+    {
+        if ((pending & EXC_BIT(i)) != 0)
+        {
+            if (HostSim_Priority(i) < bestPriority)
+            {
+                best = i;
+                bestPriority = HostSim_Priority(i);
+            }
+            pending &= ~EXC_BIT(i);
+        }
+    }
+
+    return (bestPriority < current) ? best : 0;
+}
+
+static void HostSim_SysTickCycle(void)
+{
+    if ((HostSim_SysTickCtrl & SysTick_CTRL_ENABLE_Msk) == 0)
+    {
+        return;
+    }
+    if (HostSim_SysTickValue == 0)
+    {
+        HostSim_SysTickValue = HostSim_SysTickLoad;
+        return;
+    }
+    if (--HostSim_SysTickValue == 0)
+    {
+        HostSim_SysTickCtrl |= SysTick_CTRL_COUNTFLAG_Msk;
+        if ((HostSim_SysTickCtrl & SysTick_CTRL_TICKINT_Msk) != 0)
+        {
+            HostSim_Latched |= EXC_BIT(EXC_SYSTICK);
+        }
+    }
+}
+
+static void HostSim_ScsReset(HostSim_ModelTypeDef* Model)
+{
+    HostSim_SysTickCtrl = 0;
+    HostSim_SysTickLoad = 0;
+    HostSim_SysTickValue = 0;
+    HOSTSIM_REG(Model, SCS_SCB_CPUID) = 0x410CC200;
+    HOSTSIM_REG(Model, SCS_SYST_CALIB) = 0x40000000;
+}
+
+static void HostSim_ScsRead(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width)
+{
+    uint64_t pending;
+    uint32_t next;
+
+    (void)Width;
+
+    switch (Offset & ~3U)
+    {
+        case SCS_SYST_CSR:
+            HOSTSIM_REG(Model, SCS_SYST_CSR) = HostSim_SysTickCtrl;
+            HostSim_SysTickCtrl &= ~SysTick_CTRL_COUNTFLAG_Msk;
+            break;
+
+        case SCS_SYST_RVR:
+            HOSTSIM_REG(Model, SCS_SYST_RVR) = HostSim_SysTickLoad;
+            break;
+
+        case SCS_SYST_CVR:
+            HOSTSIM_REG(Model, SCS_SYST_CVR) = HostSim_SysTickValue;
+            break;
+
+        case SCS_NVIC_ISER:
+        case SCS_NVIC_ICER:
+            HOSTSIM_REG(Model, Offset & ~3U) = (uint32_t)(HostSim_Enabled >> EXC_IRQ0);
+            break;
+
+        case SCS_NVIC_ISPR:
+        case SCS_NVIC_ICPR:
+            pending = HostSim_Latched | HostSim_LineLevels();
+            HOSTSIM_REG(Model, Offset & ~3U) = (uint32_t)(pending >> EXC_IRQ0);
+            break;
+
+        case SCS_SCB_ICSR:
+            pending = HostSim_PendingSet();
+            next = HostSim_NextException(1);
+            HOSTSIM_REG(Model, SCS_SCB_ICSR) = HostSim_GetIpsr() | (next << SCB_ICSR_VECTPENDING_Pos) |
+                                               (((pending & EXC_BIT(EXC_PENDSV)) != 0) ? SCB_ICSR_PENDSVSET_Msk : 0) |
+                                               (((pending & EXC_BIT(EXC_SYSTICK)) != 0) ? SCB_ICSR_PENDSTSET_Msk : 0) |
+                                               ((((pending >> EXC_IRQ0) & (HostSim_Enabled >> EXC_IRQ0)) != 0) ? SCB_ICSR_ISRPENDING_Msk : 0);
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void HostSim_ScsWrite(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous)
+{
+    (void)Model;
+    (void)Width;
+    (void)Previous;
+
+    switch (Offset & ~3U)
+    {
+        case SCS_SYST_CSR:
+            HostSim_SysTickCtrl = (HostSim_SysTickCtrl & SysTick_CTRL_COUNTFLAG_Msk) |
+                                  (Value & (SysTick_CTRL_ENABLE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_CLKSOURCE_Msk));
+            break;
+
+        case SCS_SYST_RVR:
+            HostSim_SysTickLoad = Value & SysTick_LOAD_RELOAD_Msk;
+            break;
+
+        case SCS_SYST_CVR:
+            HostSim_SysTickValue = 0;
+            HostSim_SysTickCtrl &= ~SysTick_CTRL_COUNTFLAG_Msk;
+            break;
+
+        case SCS_NVIC_ISER:
+            HostSim_Enabled |= (uint64_t)Value << EXC_IRQ0;
+            break;
+
+        case SCS_NVIC_ICER:
+            HostSim_Enabled &= ~((uint64_t)Value << EXC_IRQ0);
+            break;
+
+        case SCS_NVIC_ISPR:
+            HostSim_Latched |= (uint64_t)Value << EXC_IRQ0;
+            break;
+
+        case SCS_NVIC_ICPR:
+            HostSim_Latched &= ~((uint64_t)Value << EXC_IRQ0);
+            break;
+
+        case SCS_SCB_ICSR:
+            if ((Value & SCB_ICSR_PENDSVSET_Msk) != 0)
+            {
+                HostSim_Latched |= EXC_BIT(EXC_PENDSV);
+            }
+            if ((Value & SCB_ICSR_PENDSVCLR_Msk) != 0)
+            {
+                HostSim_Latched &= ~EXC_BIT(EXC_PENDSV);
+            }
+            if ((Value & SCB_ICSR_PENDSTSET_Msk) != 0)
+            {
+                HostSim_Latched |= EXC_BIT(EXC_SYSTICK);
+            }
+            if ((Value & SCB_ICSR_PENDSTCLR_Msk) != 0)
+            {
+                HostSim_Latched &= ~EXC_BIT(EXC_SYSTICK);
+            }
+            break;
+
+        case SCS_SCB_AIRCR:
+            if (((Value >> SCB_AIRCR_VECTKEY_Pos) == 0x05FAU) && ((Value & SCB_AIRCR_SYSRESETREQ_Msk) != 0))
+            {
+                HostSim_SystemReset();
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+  * @brief  Puts the simulator back to the reset state of the device and jumps
+  *         to the HOSTSIM_POWER_ON() point.
+  */
+static void HostSim_Restart(int Reason)
+{
+    if (HostSim_ResetArmed == 0)
+    {
+        HostSim_Fatal("device reset without a HOSTSIM_POWER_ON() point");
+    }
+    if (HostSim_Access.Active != 0)
+    {
+        HostSim_Protect(HostSim_Access.Page, HostSim_Access.PageSpan, HostSim_Access.Region->Prot);
+        HostSim_Access.Active = 0;
+    }
+    HostSim_Reset();
+    siglongjmp(HostSim_ResetPoint, Reason);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Maps the device memory, installs the trap handlers and attaches the
+  *         peripheral models. Flash is erased, SRAM is cleared.
+  * @retval None
+  */
+void HostSim_Init(void)
+{
+    struct sigaction action;
+    uint32_t i;
+    int fd;
+    off_t offset = 0;
+
+    if (HostSim_Initialized != 0)
+    {
+        HostSim_Reset();
+        return;
+    }
+
+    fd = memfd_create("hk32l0xx", 0);
+    for (i = 0; i < HOSTSIM_REGIONS; i++)
+    {
+        offset += HostSim_Regions[i].Size;
+    }
+    if ((fd < 0) || (ftruncate(fd, offset) != 0))
+    {
+        HostSim_Fatal("cannot create the device memory");
+    }
+
+    offset = 0;
+    for (i = 0; i < HOSTSIM_REGIONS; i++)
+    {
+        HostSim_RegionTypeDef* region = &HostSim_Regions[i];
+
+        if (mmap((void*)(uintptr_t)region->Base, region->Size, region->Prot,
+                 MAP_SHARED | MAP_FIXED_NOREPLACE, fd, offset) != (void*)(uintptr_t)region->Base)
+        {
+            HostSim_Fatal("cannot map 0x%08x, is the program linked with -no-pie?", region->Base);
+        }
+        region->Alias = mmap(NULL, region->Size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, offset);
+        if (region->Alias == MAP_FAILED)
+        {
+            HostSim_Fatal("cannot map the alias of 0x%08x", region->Base);
+        }
+        offset += region->Size;
+    }
+
+    memset(HostSim_Backdoor(HOSTSIM_FLASH_BASE), 0xFF, HOSTSIM_FLASH_SIZE);
+    memset(HostSim_Backdoor(HOSTSIM_SYSMEM_BASE), 0xFF, HOSTSIM_SYSMEM_SIZE);
+
+    memset(&action, 0, sizeof(action));
+    action.sa_flags = SA_SIGINFO | SA_NODEFER;
+    action.sa_sigaction = HostSim_OnFault;
+    sigaction(SIGSEGV, &action, NULL);
+    action.sa_sigaction = HostSim_OnStep;
+    sigaction(SIGTRAP, &action, NULL);
+
+    HostSim_Initialized = 1;
+    HostSim_Attach(&HostSim_ScsModel);
+    HostModel_AttachAll();
+    HostSim_Reset();
+}
+
+/**
+  * @brief  Resets the core and every peripheral. Memories keep their content.
+  * @retval None
+  */
+void HostSim_Reset(void)
+{
+    HostSim_ModelTypeDef* model;
+
+    memset(HostSim_Backdoor(HOSTSIM_PERIPH_BASE), 0, HOSTSIM_PERIPH_SIZE);
+    memset(HostSim_Backdoor(HOSTSIM_IOPORT_BASE), 0, HOSTSIM_IOPORT_SIZE);
+    memset(HostSim_Backdoor(HOSTSIM_SCS_BASE), 0, HOSTSIM_SCS_SIZE);
+
+    HostSim_Enabled = 0;
+    HostSim_Latched = 0;
+    HostSim_Active = 0;
+    HostSim_ActiveDepth = 0;
+    HostSim_Primask = 0;
+    HostSim_Event = 0;
+    HostSim_Control = 0;
+    memset(HostSim_Lines, 0, sizeof(HostSim_Lines));
+
+    for (model = HostSim_ModelList; model != NULL; model = model->Next)
+    {
+        if (model->Reset != NULL)
+        {
+            model->Reset(model);
+        }
+    }
+}
+
+/**
+  * @brief  Adds a peripheral model to the bus.
+  * @param  Model: model with Name, Base, Size and its callbacks filled in.
+  * @retval None
+  */
+void HostSim_Attach(HostSim_ModelTypeDef* Model)
+{
+    if (HostSim_ModelCount >= HOSTSIM_MAX_MODELS)
+    {
+        HostSim_Fatal("too many models");
+    }
+    Model->Alias = (volatile uint8_t*)HostSim_Backdoor(Model->Base);
+    if (Model->Alias == NULL)
+    {
+        HostSim_Fatal("model %s is outside the device memory map", Model->Name);
+    }
+    Model->Index = HostSim_ModelCount++;
+    Model->Next = HostSim_ModelList;
+    HostSim_ModelList = Model;
+    if (Model->Tick != NULL)
+    {
+        HostSim_TickList[HostSim_TickCount++] = Model;
+    }
+}
+
+/**
+  * @brief  Returns the model owning an address, NULL if none.
+  */
+HostSim_ModelTypeDef* HostSim_FindModel(uint32_t Address)
+{
+    HostSim_ModelTypeDef* model;
+
+    for (model = HostSim_ModelList; model != NULL; model = model->Next)
+    {
+        if ((Address >= model->Base) && (Address - model->Base < model->Size))
+        {
+            return model;
+        }
+    }
+    return NULL;
+}
+
+/**
+  * @brief  Returns the never faulting view of a device address, NULL if the
+  *         address is not in the device memory map.
+  */
+void* HostSim_Backdoor(uint32_t Address)
+{
+    HostSim_RegionTypeDef* region = HostSim_FindRegion(Address);
+
+    return (region != NULL) ? (void*)(region->Alias + (Address - region->Base)) : NULL;
+}
+
+/**
+  * @brief  Tells whether a bus master can reach an address: the device memory
+  *         map or the static data of the host program.
+  */
+uint8_t HostSim_IsMapped(uint32_t Address, uint32_t Width)
+{
+    uintptr_t start = (uintptr_t)Address;
+
+    if ((Address & (Width - 1U)) != 0)
+    {
+        return 0;
+    }
+    if (HostSim_FindRegion(start) != NULL)
+    {
+        return 1;
+    }
+    return (uint8_t)((start >= (uintptr_t)__executable_start) && (start + Width <= (uintptr_t)_end));
+}
+
+/**
+  * @brief  Read of a bus master other than the CPU (DMA).
+  */
+uint32_t HostSim_BusRead(uint32_t Address, uint32_t Width, uint8_t* Fault)
+{
+    HostSim_ModelTypeDef* model;
+
+    if (HostSim_IsMapped(Address, Width) == 0)
+    {
+        *Fault = 1;
+        return 0;
+    }
+    model = HostSim_FindModel(Address);
+    if ((model != NULL) && (model->Read != NULL))
+    {
+        model->Read(model, Address - model->Base, Width);
+    }
+    return HostSim_Load(HostSim_Pointer(Address), Width);
+}
+
+/**
+  * @brief  Write of a bus master other than the CPU (DMA).
+  */
+void HostSim_BusWrite(uint32_t Address, uint32_t Width, uint32_t Value, uint8_t* Fault)
+{
+    HostSim_ModelTypeDef* model;
+    HostSim_RegionTypeDef* region = HostSim_FindRegion(Address);
+    uint32_t previous;
+
+    if ((HostSim_IsMapped(Address, Width) == 0) ||
+        ((region != NULL) && ((region->Prot & PROT_WRITE) == 0) && (region->Base < HOSTSIM_PERIPH_BASE)))
+    {
+        *Fault = 1;
+        return;
+    }
+    model = HostSim_FindModel(Address);
+    previous = *(volatile uint32_t*)HostSim_Pointer(Address & ~3U);
+    HostSim_Store(HostSim_Pointer(Address), Width, Value);
+    if ((model != NULL) && (model->Write != NULL))
+    {
+        model->Write(model, Address - model->Base, Width, Value, previous);
+    }
+}
+
+/**
+  * @brief  Drives the interrupt line of a model. A rising edge latches the
+  *         pending state in the NVIC, the level keeps it pending.
+  */
+void HostSim_SetIrqLine(HostSim_ModelTypeDef* Model, IRQn_Type IRQn, uint8_t Level)
+{
+    uint64_t bit = EXC_BIT(EXC_IRQ0 + (uint32_t)IRQn);
+    uint64_t before = HostSim_LineLevels();
+
+    if (Level != 0)
+    {
+        HostSim_Lines[Model->Index] |= bit;
+        if ((before & bit) == 0)
+        {
+            HostSim_Latched |= bit;
+        }
+    }
+    else
+    {
+        HostSim_Lines[Model->Index] &= ~bit;
+    }
+}
+
+/**
+  * @brief  Lets simulated time pass, then takes the pending interrupts.
+  * @param  Cycles: number of bus cycles.
+  * @retval None
+  */
+void HostSim_Run(uint32_t Cycles)
+{
+    HostSim_Stall(Cycles);
+    HostSim_Dispatch();
+}
+
+/**
+  * @brief  Lets simulated time pass without taking interrupts, as when the
+  *         bus holds the CPU until a peripheral is ready.
+  * @param  Cycles: number of bus cycles.
+  * @retval None
+  */
+void HostSim_Stall(uint32_t Cycles)
+{
+    uint32_t i;
+
+    while (Cycles-- != 0)
+    {
+        HostSim_Clock++;
+        HostSim_SysTickCycle();
+        for (i = 0; i < HostSim_TickCount; i++)
+        {
+            HostSim_TickList[i]->Tick(HostSim_TickList[i]);
+        }
+        HostSim_Storm = 0;
+    }
+}
+
+uint64_t HostSim_Cycles(void)
+{
+    return HostSim_Clock;
+}
+
+uint64_t HostSim_Accesses(void)
+{
+    return HostSim_CpuAccesses;
+}
+
+/**
+  * @brief  Takes every interrupt that can preempt the running code.
+  * @retval None
+  */
+void HostSim_Dispatch(void)
+{
+    uint32_t exception;
+
+    while ((exception = HostSim_NextException(0)) != 0)
+    {
+        if (++HostSim_Storm > HOSTSIM_STORM_LIMIT)
+        {
+            HostSim_Fatal("exception %u keeps firing, its flag is never cleared", exception);
+        }
+
+        HostSim_Exceptions++;
+        HostSim_Latched &= ~EXC_BIT(exception);
+        HostSim_Active |= EXC_BIT(exception);
+        HostSim_ActiveStack[HostSim_ActiveDepth++] = exception;
+
+        HostSim_Vectors[exception]();
+
+        HostSim_ActiveDepth--;
+        HostSim_Active &= ~EXC_BIT(exception);
+    }
+}
+
+/**
+  * @brief  __WFI(): lets time pass until an enabled interrupt is pending.
+  */
+void HostSim_WaitForInterrupt(void)
+{
+    uint64_t start = HostSim_Clock;
+
+    while (HostSim_NextException(1) == 0)
+    {
+        if (HostSim_Clock - start > HOSTSIM_WFI_TIMEOUT)
+        {
+            HostSim_Fatal("__WFI(): no enabled interrupt can wake the core up");
+        }
+        HostSim_Stall(1);
+    }
+    HostSim_Dispatch();
+}
+
+/**
+  * @brief  __WFE(): lets time pass until an event or an enabled interrupt.
+  */
+void HostSim_WaitForEvent(void)
+{
+    uint64_t start = HostSim_Clock;
+
+    while ((HostSim_Event == 0) && (HostSim_NextException(1) == 0))
+    {
+        if (HostSim_Clock - start > HOSTSIM_WFI_TIMEOUT)
+        {
+            HostSim_Fatal("__WFE(): no event can wake the core up");
+        }
+        HostSim_Stall(1);
+    }
+    HostSim_Event = 0;
+    HostSim_Dispatch();
+}
+
+void HostSim_SendEvent(void)
+{
+    HostSim_Event = 1;
+}
+
+void HostSim_SetPrimask(uint32_t PriMask)
+{
+    HostSim_Primask = PriMask;
+    if (PriMask == 0)
+    {
+        HostSim_Dispatch();
+    }
+}
+
+uint32_t HostSim_GetPrimask(void)
+{
+    return HostSim_Primask;
+}
+
+uint32_t HostSim_GetIpsr(void)
+{
+    return (HostSim_ActiveDepth != 0) ? HostSim_ActiveStack[HostSim_ActiveDepth - 1] : 0;
+}
+
+/**
+  * @brief  Cuts the power: the firmware restarts at HOSTSIM_POWER_ON().
+  */
+void HostSim_PowerLoss(void)
+{
+    HostSim_Restart(HOSTSIM_RESET_POWER_LOSS);
+}
+
+/**
+  * @brief  NVIC_SystemReset(): the firmware restarts at HOSTSIM_POWER_ON().
+  */
+void HostSim_SystemReset(void)
+{
+    HostSim_Restart(HOSTSIM_RESET_SYSTEM);
+}
+
+/**
+  * @brief  Reports a simulation error and ends the test program.
+  */
+void HostSim_Fatal(const char* Format, ...)
+{
+    va_list args;
+
+    fflush(stdout);
+    fprintf(stderr, "host: ");
+    va_start(args, Format);
+    vfprintf(stderr, Format, args);
+    va_end(args);
+    fprintf(stderr, " (cycle %llu)\n", (unsigned long long)HostSim_Clock);
+    _exit(2);
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,151 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  host_test.c
+* @brief:     Test runner and checks of the host tests.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <ucontext.h>
+#include "host_test.h"
+
+/** @addtogroup HostSim
+  * @{
+  */
+
+/* Private define ------------------------------------------------------------*/
+#define HOSTTEST_SRAM_STACK_SIZE    0x4000U     /*!< Top of the SRAM, room for the signal frames */
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t HostTest_Failures;
+static uint32_t HostTest_Count;
+static const char* HostTest_Name;
+static ucontext_t HostTest_HostContext;
+static ucontext_t HostTest_SramContext;
+
+/* Private functions ---------------------------------------------------------*/
+static void HostTest_Reset(const char* Name)
+{
+    /* Keep the report in order with the simulator errors on stderr */
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    HostSim_Init();
+    HostFlash_SetWriteProtection(0);
+    HostFlash_PowerLossAt(0);
+    HostTest_EraseFlash();
+    memset(HostSim_Backdoor(HOSTSIM_SRAM_BASE), 0, HOSTSIM_SRAM_SIZE);
+    HostSim_ResetArmed = 0;
+
+    HostTest_Name = Name;
+    HostTest_Count++;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Runs one test on a freshly reset device.
+  * @param  Name: name printed in the report.
+  * @param  Test: test function.
+  * @retval None
+  */
+void HostTest_Run(const char* Name, void (*Test)(void))
+{
+    uint32_t failures = HostTest_Failures;
+
+    HostTest_Reset(Name);
+    Test();
+    printf("%s %s\n", (HostTest_Failures == failures) ? "PASS" : "FAIL", Name);
+}
+
+/**
+  * @brief  Runs one test as HostTest_Run() with its stack at the top of the
+  *         device SRAM, as the firmware stack on the target: drivers may give
+  *         their locals to the DMA.
+  * @note   The simulator signal handlers and the interrupt handlers also run
+  *         on this stack. The test must not restart at HOSTSIM_POWER_ON().
+  * @param  Name: name printed in the report.
+  * @param  Test: test function.
+  * @retval None
+  */
+void HostTest_RunOnSram(const char* Name, void (*Test)(void))
+{
+    uint32_t failures = HostTest_Failures;
+
+    HostTest_Reset(Name);
+    getcontext(&HostTest_SramContext);
+    HostTest_SramContext.uc_stack.ss_sp = (void*)(uintptr_t)(HOSTSIM_SRAM_BASE + HOSTSIM_SRAM_SIZE -
+                                                             HOSTTEST_SRAM_STACK_SIZE);
+    HostTest_SramContext.uc_stack.ss_size = HOSTTEST_SRAM_STACK_SIZE;
+    HostTest_SramContext.uc_link = &HostTest_HostContext;
+    makecontext(&HostTest_SramContext, Test, 0);
+    swapcontext(&HostTest_HostContext, &HostTest_SramContext);
+    printf("%s %s\n", (HostTest_Failures == failures) ? "PASS" : "FAIL", Name);
+}
+
+/**
+  * @brief  Prints the summary.
+  * @retval Exit status of the test program.
+  */
+int HostTest_End(void)
+{
+    printf("%u test(s), %u failed check(s)\n", HostTest_Count, HostTest_Failures);
+    return (HostTest_Failures == 0) ? 0 : 1;
+}
+
+uint8_t HostTest_Check(uint8_t Passed, const char* File, int Line, const char* Text)
+{
+    if (Passed == 0)
+    {
+        HostTest_Failures++;
+        printf("%s:%d: %s: CHECK(%s) failed\n", File, Line, HostTest_Name, Text);
+    }
+    return Passed;
+}
+
+uint8_t HostTest_CheckEqual(long long Expected, long long Actual, const char* File, int Line, const char* Text)
+{
+    if (Expected != Actual)
+    {
+        HostTest_Failures++;
+        printf("%s:%d: %s: %s is %lld (0x%llx), expected %lld (0x%llx)\n", File, Line, HostTest_Name, Text,
+               Actual, (unsigned long long)Actual, Expected, (unsigned long long)Expected);
+        return 0;
+    }
+    return 1;
+}
+
+uint8_t HostTest_CheckMemory(const void* Expected, const void* Actual, uint32_t Size, const char* File, int Line, const char* Text)
+{
+    const uint8_t* expected = (const uint8_t*)Expected;
+    const uint8_t* actual = (const uint8_t*)Actual;
+    uint32_t i;
+
+    for (i = 0; i < Size; i++)
+    {
+        if (expected[i] != actual[i])
+        {
+            HostTest_Failures++;
+            printf("%s:%d: %s: %s differs at byte %u: 0x%02x, expected 0x%02x\n", File, Line, HostTest_Name, Text,
+                   i, actual[i], expected[i]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+  * @brief  Erases the whole flash array without going through the FLASH model.
+  */
+void HostTest_EraseFlash(void)
+{
+    memset(HostSim_Backdoor(HOSTSIM_FLASH_BASE), 0xFF, HOSTSIM_FLASH_SIZE);
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
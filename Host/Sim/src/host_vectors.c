@@ -0,0 +1,125 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  host_vectors.c
+* @brief:     Vector table of the host build. Handlers have the names of the
+*             KEIL startup file and are weak: a test defines the ones it uses.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "host_sim.h"
+
+/** @addtogroup HostSim
+  * @{
+  */
+
+/* Private function prototypes -----------------------------------------------*/
+void Default_Handler(void);
+void NMI_Handler(void) __attribute__((weak, alias("Default_Handler")));
+void HardFault_Handler(void) __attribute__((weak, alias("Default_Handler")));
+void SVC_Handler(void) __attribute__((weak, alias("Default_Handler")));
+void PendSV_Handler(void) __attribute__((weak, alias("Default_Handler")));
+void SysTick_Handler(void) __attribute__((weak, alias("Default_Handler")));
+void WWDG_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void PVD_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void RTC_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void FLASH_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void RCC_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void EXTI0_1_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void EXTI2_3_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void EXTI4_15_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void LPUART_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DMA_CH1_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DMA_CH2_3_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DMA_CH4_7_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void ADC_COMP_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM1_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void UART3_4_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM2_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM3_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void DAC_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM14_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM15_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM16_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void TIM17_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void I2C1_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void I2C2_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void SPI1_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void SPI2_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void USART1_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void USART2_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void AES_TRNG_EMACC_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void LCD_CAN_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+void USB_DVSQ_IRQHandler(void) __attribute__((weak, alias("Default_Handler")));
+
+/* Exported variables --------------------------------------------------------*/
+void (* const HostSim_Vectors[48])(void) =
+{
+    Default_Handler,
+    Default_Handler,
+    NMI_Handler,
+    HardFault_Handler,
+    Default_Handler,
+    Default_Handler,
+    Default_Handler,
+    Default_Handler,
+    Default_Handler,
+    Default_Handler,
+    Default_Handler,
+    SVC_Handler,
+    Default_Handler,
+    Default_Handler,
+    PendSV_Handler,
+    SysTick_Handler,
+    WWDG_IRQHandler,
+    PVD_IRQHandler,
+    RTC_IRQHandler,
+    FLASH_IRQHandler,
+    RCC_IRQHandler,
+    EXTI0_1_IRQHandler,
+    EXTI2_3_IRQHandler,
+    EXTI4_15_IRQHandler,
+    LPUART_IRQHandler,
+    DMA_CH1_IRQHandler,
+    DMA_CH2_3_IRQHandler,
+    DMA_CH4_7_IRQHandler,
+    ADC_COMP_IRQHandler,
+    TIM1_IRQHandler,
+    UART3_4_IRQHandler,
+    TIM2_IRQHandler,
+    TIM3_IRQHandler,
+    DAC_IRQHandler,
+    Default_Handler,
+    TIM14_IRQHandler,
+    TIM15_IRQHandler,
+    TIM16_IRQHandler,
+    TIM17_IRQHandler,
+    I2C1_IRQHandler,
+    I2C2_IRQHandler,
+    SPI1_IRQHandler,
+    SPI2_IRQHandler,
+    USART1_IRQHandler,
+    USART2_IRQHandler,
+    AES_TRNG_EMACC_IRQHandler,
+    LCD_CAN_IRQHandler,
+    USB_DVSQ_IRQHandler
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Handler of an exception the test did not expect.
+  */
+void Default_Handler(void)
+{
+    HostSim_Fatal("unexpected exception %u", __get_IPSR());
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
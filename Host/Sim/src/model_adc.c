@@ -0,0 +1,359 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  model_adc.c
+* @brief:     ADC model: calibration, software and external trigger scans of
+*             the channels of CHSELR, oversampling, DMA requests and overrun.
+*             The inputs are levels set by the test.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "host_models.h"
+
+/** @addtogroup HostSim
+  * @{
+  */
+
+/* Private define ------------------------------------------------------------*/
+#define HOSTADC_ISR                 offsetof(ADC_TypeDef, ISR)
+#define HOSTADC_IER                 offsetof(ADC_TypeDef, IER)
+#define HOSTADC_CR                  offsetof(ADC_TypeDef, CR)
+#define HOSTADC_CFGR1               offsetof(ADC_TypeDef, CFGR1)
+#define HOSTADC_CFGR2               offsetof(ADC_TypeDef, CFGR2)
+#define HOSTADC_CHSELR              offsetof(ADC_TypeDef, CHSELR)
+#define HOSTADC_DR                  offsetof(ADC_TypeDef, DR)
+
+#define HOSTADC_ISR_FLAGS           (ADC_ISR_ADRDY | ADC_ISR_EOSMP | ADC_ISR_EOC | ADC_ISR_EOSEQ | \
+                                     ADC_ISR_OVR | ADC_ISR_AWD | ADC_ISR_EOCAL)
+
+/* Private variables ---------------------------------------------------------*/
+static uint16_t HostAdc_Inputs[HOSTADC_CHANNELS];
+static uint32_t HostAdc_CalibrationTimer;   /*!< Cycles left of the calibration */
+static uint32_t HostAdc_ConversionTimer;    /*!< Cycles left of the conversion of HostAdc_Channel */
+static uint32_t HostAdc_Channel;            /*!< Channel being converted */
+static uint8_t HostAdc_Scanning;
+static uint8_t HostAdc_DataFull;            /*!< DR holds a result not read yet */
+static uint32_t HostAdc_ConversionCount;
+static uint32_t HostAdc_CalibrationCount;
+
+/* Private function prototypes -----------------------------------------------*/
+static void HostAdc_Reset(HostSim_ModelTypeDef* Model);
+static void HostAdc_Read(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width);
+static void HostAdc_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous);
+static uint8_t HostAdc_DMARequest(HostSim_ModelTypeDef* Model, uint32_t Offset, uint8_t Write);
+static void HostAdc_Tick(HostSim_ModelTypeDef* Model);
+
+HostSim_ModelTypeDef HostAdc_Model =
+{
+    "ADC", ADC_BASE, 0x400, HostAdc_Reset, HostAdc_Read, HostAdc_Write, HostAdc_DMARequest, HostAdc_Tick,
+    NULL, 0, NULL
+};
+
+/* Private functions ---------------------------------------------------------*/
+static void HostAdc_UpdateIrq(HostSim_ModelTypeDef* Model)
+{
+    uint32_t isr = HOSTSIM_REG(Model, HOSTADC_ISR);
+    uint32_t ier = HOSTSIM_REG(Model, HOSTADC_IER);
+
+    HostSim_SetIrqLine(Model, ADC_COMP1_2_IRQn, (uint8_t)((isr & ier & HOSTADC_ISR_FLAGS) != 0));
+}
+
+/**
+  * @brief  Conversions of one channel: 1, or the oversampling ratio.
+  */
+static uint32_t HostAdc_Ratio(HostSim_ModelTypeDef* Model)
+{
+    uint32_t cfgr2 = HOSTSIM_REG(Model, HOSTADC_CFGR2);
+
+    if ((cfgr2 & ADC_CFGR2_OVSE) == 0)
+    {
+        return 1;
+    }
+    return 2UL << ((cfgr2 & ADC_CFGR2_OVSR) >> ADC_CFGR2_OVSR_Pos);
+}
+
+/**
+  * @brief  Next channel of the scan after Channel, in the CHSELR order, or
+  *         HOSTADC_CHANNELS at the end of the scan.
+  */
+static uint32_t HostAdc_NextChannel(HostSim_ModelTypeDef* Model, uint32_t Channel, uint8_t First)
+{
+    uint32_t chselr = HOSTSIM_REG(Model, HOSTADC_CHSELR);
+    uint8_t down = (uint8_t)((HOSTSIM_REG(Model, HOSTADC_CFGR1) & ADC_CFGR1_SCANDIR) != 0);
+    int32_t n = (int32_t)Channel;
+
+    if (First != 0)
+    {
+        n = (down != 0) ? HOSTADC_CHANNELS : -1;
+    }
+
+    for (;;)
+    {
+        n += (down != 0) ? -1 : 1;
+        if ((n < 0) || (n >= (int32_t)HOSTADC_CHANNELS))
+        {
+            return HOSTADC_CHANNELS;
+        }
+        if ((chselr & (1UL << n)) != 0)
+        {
+            return (uint32_t)n;
+        }
+    }
+}
+
+static void HostAdc_StartScan(HostSim_ModelTypeDef* Model)
+{
+    HostAdc_Channel = HostAdc_NextChannel(Model, 0, 1);
+    if (HostAdc_Channel < HOSTADC_CHANNELS)
+    {
+        HostAdc_Scanning = 1;
+        HostAdc_ConversionTimer = HOSTADC_CONVERSION_CYCLES * HostAdc_Ratio(Model);
+    }
+}
+
+static void HostAdc_StopScan(HostSim_ModelTypeDef* Model)
+{
+    HostAdc_Scanning = 0;
+    HOSTSIM_REG(Model, HOSTADC_CR) &= ~(ADC_CR_ADSTART | ADC_CR_ADSTP);
+}
+
+/**
+  * @brief  End of the conversion of HostAdc_Channel. An overrun with the DMA
+  *         enabled and OVRMOD cleared stops the conversions and the DMA
+  *         requests until OVR is cleared and ADSTART set again.
+  */
+static void HostAdc_EndOfConversion(HostSim_ModelTypeDef* Model)
+{
+    uint32_t cfgr1 = HOSTSIM_REG(Model, HOSTADC_CFGR1);
+    uint32_t cfgr2 = HOSTSIM_REG(Model, HOSTADC_CFGR2);
+    uint32_t value = HostAdc_Inputs[HostAdc_Channel];
+    uint32_t isr = HOSTSIM_REG(Model, HOSTADC_ISR) | ADC_ISR_EOSMP | ADC_ISR_EOC;
+
+    if ((cfgr2 & ADC_CFGR2_OVSE) != 0)
+    {
+        value = (value * HostAdc_Ratio(Model)) >> ((cfgr2 & ADC_CFGR2_OVSS) >> ADC_CFGR2_OVSS_Pos);
+    }
+    HostAdc_ConversionCount++;
+
+    if ((HostAdc_DataFull != 0) && ((cfgr1 & ADC_CFGR1_OVRMOD) == 0))
+    {
+        isr |= ADC_ISR_OVR;
+        if ((cfgr1 & ADC_CFGR1_DMAEN) != 0)
+        {
+            HOSTSIM_REG(Model, HOSTADC_ISR) = isr;
+            HostAdc_StopScan(Model);
+            return;
+        }
+    }
+    else
+    {
+        isr |= (HostAdc_DataFull != 0) ? ADC_ISR_OVR : 0U;
+        HOSTSIM_REG(Model, HOSTADC_DR) = value;
+        HostAdc_DataFull = 1;
+    }
+
+    HostAdc_Channel = HostAdc_NextChannel(Model, HostAdc_Channel, 0);
+    if (HostAdc_Channel < HOSTADC_CHANNELS)
+    {
+        HostAdc_ConversionTimer = HOSTADC_CONVERSION_CYCLES * HostAdc_Ratio(Model);
+    }
+    else
+    {
+        isr |= ADC_ISR_EOSEQ;
+        HostAdc_Scanning = 0;
+        if ((cfgr1 & ADC_CFGR1_EXTEN) == 0)
+        {
+            if ((cfgr1 & ADC_CFGR1_CONT) != 0)
+            {
+                HostAdc_StartScan(Model);
+            }
+            else
+            {
+                HOSTSIM_REG(Model, HOSTADC_CR) &= ~ADC_CR_ADSTART;
+            }
+        }
+    }
+    HOSTSIM_REG(Model, HOSTADC_ISR) = isr;
+}
+
+static void HostAdc_Reset(HostSim_ModelTypeDef* Model)
+{
+    uint32_t n;
+
+    (void)Model;
+
+    for (n = 0; n < HOSTADC_CHANNELS; n++)
+    {
+        HostAdc_Inputs[n] = 0;
+    }
+    HostAdc_CalibrationTimer = 0;
+    HostAdc_ConversionTimer = 0;
+    HostAdc_Scanning = 0;
+    HostAdc_DataFull = 0;
+}
+
+static void HostAdc_Read(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width)
+{
+    (void)Width;
+
+    if ((Offset & ~3U) == HOSTADC_DR)
+    {
+        HostAdc_DataFull = 0;
+        HOSTSIM_REG(Model, HOSTADC_ISR) &= ~ADC_ISR_EOC;
+        HostAdc_UpdateIrq(Model);
+    }
+}
+
+static void HostAdc_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous)
+{
+    uint32_t cr = HOSTSIM_REG(Model, HOSTADC_CR);
+
+    (void)Width;
+
+    switch (Offset & ~3U)
+    {
+        case HOSTADC_ISR:
+            HOSTSIM_REG(Model, HOSTADC_ISR) = Previous & ~(Value & HOSTADC_ISR_FLAGS);
+            break;
+
+        case HOSTADC_CR:
+            if (((cr & ADC_CR_ADCAL) != 0) && ((Previous & ADC_CR_ADCAL) == 0))
+            {
+                /* Calibration: the ADC must be disabled */
+                if ((Previous & ADC_CR_ADEN) == 0)
+                {
+                    HostAdc_CalibrationTimer = HOSTADC_CALIBRATION_CYCLES;
+                }
+                else
+                {
+                    cr &= ~ADC_CR_ADCAL;
+                }
+            }
+            if ((cr & ADC_CR_ADDIS) != 0)
+            {
+                HostAdc_StopScan(Model);
+                cr = HOSTSIM_REG(Model, HOSTADC_CR) & ~(ADC_CR_ADEN | ADC_CR_ADDIS);
+                HOSTSIM_REG(Model, HOSTADC_ISR) &= ~ADC_ISR_ADRDY;
+            }
+            else if (((cr & ADC_CR_ADEN) != 0) && ((Previous & ADC_CR_ADEN) == 0))
+            {
+                HOSTSIM_REG(Model, HOSTADC_ISR) |= ADC_ISR_ADRDY;
+            }
+            if ((cr & ADC_CR_ADSTP) != 0)
+            {
+                HOSTSIM_REG(Model, HOSTADC_CR) = cr;
+                HostAdc_StopScan(Model);
+                cr = HOSTSIM_REG(Model, HOSTADC_CR);
+            }
+            else if (((cr & ADC_CR_ADSTART) != 0) && ((Previous & ADC_CR_ADSTART) == 0))
+            {
+                if ((cr & ADC_CR_ADEN) == 0)
+                {
+                    cr &= ~ADC_CR_ADSTART;
+                }
+                else if ((HOSTSIM_REG(Model, HOSTADC_CFGR1) & ADC_CFGR1_EXTEN) == 0)
+                {
+                    HostAdc_StartScan(Model);
+                }
+            }
+            HOSTSIM_REG(Model, HOSTADC_CR) = cr;
+            break;
+
+        case HOSTADC_DR:
+            HOSTSIM_REG(Model, HOSTADC_DR) = Previous;
+            break;
+
+        default:
+            break;
+    }
+    HostAdc_UpdateIrq(Model);
+}
+
+static uint8_t HostAdc_DMARequest(HostSim_ModelTypeDef* Model, uint32_t Offset, uint8_t Write)
+{
+    uint32_t cfgr1 = HOSTSIM_REG(Model, HOSTADC_CFGR1);
+    uint32_t isr = HOSTSIM_REG(Model, HOSTADC_ISR);
+
+    (void)Write;
+
+    if (((Offset & ~3U) != HOSTADC_DR) || ((cfgr1 & ADC_CFGR1_DMAEN) == 0) || (HostAdc_DataFull == 0))
+    {
+        return 0;
+    }
+    return (uint8_t)(((isr & ADC_ISR_OVR) == 0) || ((cfgr1 & ADC_CFGR1_OVRMOD) != 0));
+}
+
+static void HostAdc_Tick(HostSim_ModelTypeDef* Model)
+{
+    uint32_t before = HOSTSIM_REG(Model, HOSTADC_ISR);
+
+    /* The calibration factor is left in DR, a DMA enabled reads it */
+    if ((HostAdc_CalibrationTimer != 0) && (--HostAdc_CalibrationTimer == 0))
+    {
+        HOSTSIM_REG(Model, HOSTADC_CR) &= ~ADC_CR_ADCAL;
+        HOSTSIM_REG(Model, HOSTADC_DR) = HOSTADC_CALIBRATION_FACTOR;
+        HOSTSIM_REG(Model, HOSTADC_ISR) |= ADC_ISR_EOCAL;
+        HostAdc_DataFull = 1;
+        HostAdc_CalibrationCount++;
+    }
+
+    if ((HostAdc_Scanning != 0) && (--HostAdc_ConversionTimer == 0))
+    {
+        HostAdc_EndOfConversion(Model);
+    }
+
+    if (HOSTSIM_REG(Model, HOSTADC_ISR) != before)
+    {
+        HostAdc_UpdateIrq(Model);
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Sets the level converted on a channel, 12 bits.
+  */
+void HostAdc_SetInput(uint32_t Channel, uint16_t Value)
+{
+    if (Channel >= HOSTADC_CHANNELS)
+    {
+        HostSim_Fatal("no ADC channel %lu", (unsigned long)Channel);
+    }
+    HostAdc_Inputs[Channel] = Value;
+}
+
+/**
+  * @brief  External trigger edge: starts a scan if ADSTART is set with an
+  *         external trigger and no scan is in progress.
+  */
+void HostAdc_Trigger(void)
+{
+    HostSim_ModelTypeDef* model = &HostAdc_Model;
+    uint32_t cr = HOSTSIM_REG(model, HOSTADC_CR);
+
+    if (((cr & ADC_CR_ADSTART) != 0) && ((cr & ADC_CR_ADEN) != 0) && (HostAdc_Scanning == 0) &&
+        ((HOSTSIM_REG(model, HOSTADC_CFGR1) & ADC_CFGR1_EXTEN) != 0))
+    {
+        HostAdc_StartScan(model);
+    }
+}
+
+uint32_t HostAdc_Conversions(void)
+{
+    return HostAdc_ConversionCount;
+}
+
+uint32_t HostAdc_Calibrations(void)
+{
+    return HostAdc_CalibrationCount;
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
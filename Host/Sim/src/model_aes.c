@@ -0,0 +1,494 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  model_aes.c
+* @brief:     AES model: ECB core with key derivation, CCF/RDERR/WRERR and
+*             the DMA requests of the input and output phases.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "host_models.h"
+
+/** @addtogroup HostSim
+  * @{
+  */
+
+/* Private define ------------------------------------------------------------*/
+#define HOSTAES_CR1                 offsetof(AES_TypeDef, CR1)
+#define HOSTAES_SR1                 offsetof(AES_TypeDef, SR1)
+#define HOSTAES_DINR                offsetof(AES_TypeDef, DINR)
+#define HOSTAES_DOUTR               offsetof(AES_TypeDef, DOUTR)
+#define HOSTAES_CR2                 offsetof(AES_TypeDef, CR2)
+#define HOSTAES_SR2                 offsetof(AES_TypeDef, SR2)
+
+#define HOSTAES_MODE_ENCRYPT        0U
+#define HOSTAES_MODE_DERIVE         1U
+#define HOSTAES_MODE_DECRYPT        2U
+#define HOSTAES_MODE_DERIVE_DECRYPT 3U
+
+/* Private variables ---------------------------------------------------------*/
+static const uint32_t HostAes_KeyOffsets[8] =
+{
+    offsetof(AES_TypeDef, KEYR0), offsetof(AES_TypeDef, KEYR1),
+    offsetof(AES_TypeDef, KEYR2), offsetof(AES_TypeDef, KEYR3),
+    offsetof(AES_TypeDef, KEYR4), offsetof(AES_TypeDef, KEYR5),
+    offsetof(AES_TypeDef, KEYR6), offsetof(AES_TypeDef, KEYR7)
+};
+
+static uint8_t HostAes_Sbox[256];
+static uint8_t HostAes_InvSbox[256];
+
+static uint32_t HostAes_Input[4];
+static uint32_t HostAes_Output[4];
+static uint32_t HostAes_InCount;       /*!< Words written to DINR for the next block */
+static uint32_t HostAes_OutCount;      /*!< Words of the last result still to read */
+static uint32_t HostAes_Remaining;     /*!< Cycles to the end of the computation */
+static uint8_t HostAes_Deriving;
+static uint32_t HostAes_BlockCount;
+
+/* Private function prototypes -----------------------------------------------*/
+static void HostAes_Reset(HostSim_ModelTypeDef* Model);
+static void HostAes_Read(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width);
+static void HostAes_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous);
+static uint8_t HostAes_DMARequest(HostSim_ModelTypeDef* Model, uint32_t Offset, uint8_t Write);
+static void HostAes_Tick(HostSim_ModelTypeDef* Model);
+
+HostSim_ModelTypeDef HostAes_Model =
+{
+    "AES", AES_BASE, 0x400, HostAes_Reset, HostAes_Read, HostAes_Write, HostAes_DMARequest, HostAes_Tick, NULL, 0, NULL
+};
+
+/* Private functions ---------------------------------------------------------*/
+static uint8_t HostAes_Xtime(uint8_t Value)
+{
+    return (uint8_t)((Value << 1) ^ (((Value & 0x80) != 0) ? 0x1B : 0x00));
+}
+
+static uint8_t HostAes_Multiply(uint8_t a, uint8_t b)
+{
+    uint8_t result = 0;
+
+    while (b != 0)
+    {
+        if ((b & 1) != 0)
+        {
+            result ^= a;
+        }
+        a = HostAes_Xtime(a);
+        b >>= 1;
+    }
+    return result;
+}
+
+/**
+  * @brief  Builds the S-boxes from the multiplicative inverse and the affine
+  *         transformation of FIPS-197 5.1.1.
+  */
+static void HostAes_BuildSbox(void)
+{
+    uint32_t x;
+    uint32_t y;
+
+    for (x = 0; x < 256U; x++)
+    {
+        uint8_t inverse = 0;
+        uint8_t s;
+
+        for (y = 1; (x != 0) && (y < 256U); y++)
+        {
+            if (HostAes_Multiply((uint8_t)x, (uint8_t)y) == 1)
+            {
+                inverse = (uint8_t)y;
+                break;
+            }
+        }
+        s = inverse;
+        s ^= (uint8_t)((inverse << 1) | (inverse >> 7));
+        s ^= (uint8_t)((inverse << 2) | (inverse >> 6));
+        s ^= (uint8_t)((inverse << 3) | (inverse >> 5));
+        s ^= (uint8_t)((inverse << 4) | (inverse >> 4));
+        s ^= 0x63;
+        HostAes_Sbox[x] = s;
+        HostAes_InvSbox[s] = (uint8_t)x;
+    }
+}
+
+static uint32_t HostAes_SubWord(uint32_t Word)
+{
+    return ((uint32_t)HostAes_Sbox[Word >> 24] << 24) | ((uint32_t)HostAes_Sbox[(Word >> 16) & 0xFF] << 16) |
+           ((uint32_t)HostAes_Sbox[(Word >> 8) & 0xFF] << 8) | HostAes_Sbox[Word & 0xFF];
+}
+
+/**
+  * @brief  Term XORed to w[i - Nk] to get w[i] in the key expansion.
+  */
+static uint32_t HostAes_ScheduleTerm(uint32_t Previous, uint32_t i, uint32_t Nk)
+{
+    static const uint8_t rcon[10] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36};
+
+    if ((i % Nk) == 0)
+    {
+        return HostAes_SubWord((Previous << 8) | (Previous >> 24)) ^ ((uint32_t)rcon[(i / Nk) - 1] << 24);
+    }
+    if ((Nk > 6U) && ((i % Nk) == 4U))
+    {
+        return HostAes_SubWord(Previous);
+    }
+    return Previous;
+}
+
+/**
+  * @brief  Key expansion, forward from the first Nk words of Schedule.
+  */
+static void HostAes_Expand(uint32_t* Schedule, uint32_t Nk)
+{
+    uint32_t i;
+
+    for (i = Nk; i < 4U * (Nk + 7U); i++)
+    {
+        Schedule[i] = Schedule[i - Nk] ^ HostAes_ScheduleTerm(Schedule[i - 1], i, Nk);
+    }
+}
+
+/**
+  * @brief  Key expansion, backward from the last Nk words of Schedule.
+  */
+static void HostAes_ExpandBack(uint32_t* Schedule, uint32_t Nk)
+{
+    uint32_t i;
+
+    for (i = 4U * (Nk + 7U) - 1U; i >= Nk; i--)
+    {
+        Schedule[i - Nk] = Schedule[i] ^ HostAes_ScheduleTerm(Schedule[i - 1], i, Nk);
+    }
+}
+
+static void HostAes_AddRoundKey(uint8_t* State, const uint32_t* Key)
+{
+    uint32_t c;
+
+    for (c = 0; c < 4U; c++)
+    {
+        State[4 * c] ^= (uint8_t)(Key[c] >> 24);
+        State[4 * c + 1] ^= (uint8_t)(Key[c] >> 16);
+        State[4 * c + 2] ^= (uint8_t)(Key[c] >> 8);
+        State[4 * c + 3] ^= (uint8_t)Key[c];
+    }
+}
+
+static void HostAes_MixColumn(uint8_t* Column, const uint8_t* Matrix)
+{
+    uint8_t in[4];
+    uint32_t r;
+
+    memcpy(in, Column, 4);
+    for (r = 0; r < 4U; r++)
+    {
+        Column[r] = HostAes_Multiply(in[0], Matrix[(4U - r) & 3U]) ^ HostAes_Multiply(in[1], Matrix[(5U - r) & 3U]) ^
+                    HostAes_Multiply(in[2], Matrix[(6U - r) & 3U]) ^ HostAes_Multiply(in[3], Matrix[(7U - r) & 3U]);
+    }
+}
+
+/**
+  * @brief  Encrypts or decrypts one block with a full key schedule.
+  */
+static void HostAes_Cipher(uint8_t* State, const uint32_t* Schedule, uint32_t Nk, uint8_t Decrypt)
+{
+    static const uint8_t mix[4] = {0x02, 0x03, 0x01, 0x01};
+    static const uint8_t invMix[4] = {0x0E, 0x0B, 0x0D, 0x09};
+    uint32_t rounds = Nk + 6U;
+    uint32_t round;
+    uint32_t i;
+    uint32_t c;
+    uint8_t shifted[16];
+
+    HostAes_AddRoundKey(State, &Schedule[(Decrypt != 0) ? (4U * rounds) : 0U]);
+
+    for (round = 1; round <= rounds; round++)
+    {
+        for (i = 0; i < 16U; i++)
+        {
+            uint32_t row = i & 3U;
+            uint32_t column = i >> 2;
+
+            if (Decrypt == 0)
+            {
+                shifted[i] = HostAes_Sbox[State[4U * ((column + row) & 3U) + row]];
+            }
+            else
+            {
+                shifted[4U * ((column + row) & 3U) + row] = HostAes_InvSbox[State[i]];
+            }
+        }
+        memcpy(State, shifted, 16);
+
+        if (Decrypt == 0)
+        {
+            if (round != rounds)
+            {
+                for (c = 0; c < 4U; c++)
+                {
+                    HostAes_MixColumn(&State[4 * c], mix);
+                }
+            }
+            HostAes_AddRoundKey(State, &Schedule[4U * round]);
+        }
+        else
+        {
+            HostAes_AddRoundKey(State, &Schedule[4U * (rounds - round)]);
+            if (round != rounds)
+            {
+                for (c = 0; c < 4U; c++)
+                {
+                    HostAes_MixColumn(&State[4 * c], invMix);
+                }
+            }
+        }
+    }
+}
+
+static uint32_t HostAes_KeyWords(HostSim_ModelTypeDef* Model)
+{
+    return 4U + (2U * (HOSTSIM_REG(Model, HOSTAES_CR2) & AES_CR2_KEY_SIZE));
+}
+
+static uint32_t HostAes_Mode(HostSim_ModelTypeDef* Model)
+{
+    return (HOSTSIM_REG(Model, HOSTAES_CR1) & AES_CR1_MODE) >> AES_CR1_MODE_Pos;
+}
+
+/**
+  * @brief  Runs the key derivation: KEYRx receive the last Nk words of the
+  *         key expansion, the first key of the decryption.
+  */
+static void HostAes_Derive(HostSim_ModelTypeDef* Model)
+{
+    uint32_t schedule[60];
+    uint32_t nk = HostAes_KeyWords(Model);
+    uint32_t total = 4U * (nk + 7U);
+    uint32_t j;
+
+    for (j = 0; j < nk; j++)
+    {
+        schedule[j] = HOSTSIM_REG(Model, HostAes_KeyOffsets[nk - 1U - j]);
+    }
+    HostAes_Expand(schedule, nk);
+    for (j = 0; j < nk; j++)
+    {
+        HOSTSIM_REG(Model, HostAes_KeyOffsets[nk - 1U - j]) = schedule[total - nk + j];
+    }
+}
+
+/**
+  * @brief  Computes the block held in HostAes_Input.
+  */
+static void HostAes_Compute(HostSim_ModelTypeDef* Model)
+{
+    uint32_t schedule[60];
+    uint32_t nk = HostAes_KeyWords(Model);
+    uint32_t total = 4U * (nk + 7U);
+    uint32_t mode = HostAes_Mode(Model);
+    uint8_t state[16];
+    uint32_t j;
+
+    if (mode == HOSTAES_MODE_DECRYPT)
+    {
+        for (j = 0; j < nk; j++)
+        {
+            schedule[total - nk + j] = HOSTSIM_REG(Model, HostAes_KeyOffsets[nk - 1U - j]);
+        }
+        HostAes_ExpandBack(schedule, nk);
+    }
+    else
+    {
+        for (j = 0; j < nk; j++)
+        {
+            schedule[j] = HOSTSIM_REG(Model, HostAes_KeyOffsets[nk - 1U - j]);
+        }
+        HostAes_Expand(schedule, nk);
+    }
+
+    /* The words of DINR and DOUTR hold the block bytes in memory order */
+    memcpy(state, HostAes_Input, 16);
+    HostAes_Cipher(state, schedule, nk, (uint8_t)(mode != HOSTAES_MODE_ENCRYPT));
+    memcpy(HostAes_Output, state, 16);
+}
+
+static void HostAes_UpdateIrq(HostSim_ModelTypeDef* Model)
+{
+    uint32_t cr1 = HOSTSIM_REG(Model, HOSTAES_CR1);
+    uint32_t sr1 = HOSTSIM_REG(Model, HOSTAES_SR1);
+    uint8_t level = (uint8_t)((((sr1 & AES_SR1_CCF) != 0) && ((cr1 & AES_CR1_CCFIE) != 0)) ||
+                              (((sr1 & (AES_SR1_RDERR | AES_SR1_WRERR)) != 0) && ((cr1 & AES_CR1_ERRIE) != 0)));
+
+    HOSTSIM_REG(Model, HOSTAES_SR2) = (HOSTSIM_REG(Model, HOSTAES_SR2) & ~AES_SR2_INPUT_CN) |
+                                      ((HostAes_InCount & 3U) << AES_SR2_INPUT_CN_Pos);
+    HostSim_SetIrqLine(Model, AES_TRNG_EMACC_IRQn, level);
+}
+
+static void HostAes_Reset(HostSim_ModelTypeDef* Model)
+{
+    (void)Model;
+
+    if (HostAes_Sbox[0] == 0)
+    {
+        HostAes_BuildSbox();
+    }
+    HostAes_InCount = 0;
+    HostAes_OutCount = 0;
+    HostAes_Remaining = 0;
+    HostAes_Deriving = 0;
+}
+
+static void HostAes_Read(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width)
+{
+    uint32_t cr1 = HOSTSIM_REG(Model, HOSTAES_CR1);
+
+    (void)Width;
+
+    if (((Offset & ~3U) != HOSTAES_DOUTR) || ((cr1 & AES_CR1_EN) == 0))
+    {
+        return;
+    }
+
+    if ((HostAes_Remaining != 0) || (HostAes_OutCount == 0))
+    {
+        HOSTSIM_REG(Model, HOSTAES_SR1) |= AES_SR1_RDERR;
+        HOSTSIM_REG(Model, HOSTAES_DOUTR) = 0;
+    }
+    else
+    {
+        HOSTSIM_REG(Model, HOSTAES_DOUTR) = HostAes_Output[4U - HostAes_OutCount];
+        HostAes_OutCount--;
+    }
+    HostAes_UpdateIrq(Model);
+}
+
+static void HostAes_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous)
+{
+    uint32_t cr1 = HOSTSIM_REG(Model, HOSTAES_CR1);
+
+    (void)Width;
+
+    switch (Offset & ~3U)
+    {
+        case HOSTAES_CR1:
+            if ((cr1 & AES_CR1_CCFC) != 0)
+            {
+                HOSTSIM_REG(Model, HOSTAES_SR1) &= ~AES_SR1_CCF;
+            }
+            if ((cr1 & AES_CR1_ERRC) != 0)
+            {
+                HOSTSIM_REG(Model, HOSTAES_SR1) &= ~(AES_SR1_RDERR | AES_SR1_WRERR);
+            }
+            cr1 &= ~(AES_CR1_CCFC | AES_CR1_ERRC);
+            HOSTSIM_REG(Model, HOSTAES_CR1) = cr1;
+
+            if ((cr1 & AES_CR1_EN) == 0)
+            {
+                HostAes_InCount = 0;
+                HostAes_OutCount = 0;
+                HostAes_Remaining = 0;
+                HostAes_Deriving = 0;
+            }
+            else if (((Previous & AES_CR1_EN) == 0) && (HostAes_Mode(Model) == HOSTAES_MODE_DERIVE))
+            {
+                HostAes_Deriving = 1;
+                HostAes_Remaining = HOSTAES_BLOCK_CYCLES;
+            }
+            break;
+
+        case HOSTAES_DINR:
+            if ((cr1 & AES_CR1_EN) == 0)
+            {
+                break;
+            }
+            if ((HostAes_Remaining != 0) || (HostAes_Mode(Model) == HOSTAES_MODE_DERIVE))
+            {
+                HOSTSIM_REG(Model, HOSTAES_SR1) |= AES_SR1_WRERR;
+                break;
+            }
+            HostAes_Input[HostAes_InCount++] = Value;
+            if (HostAes_InCount == 4U)
+            {
+                HostAes_InCount = 0;
+                HostAes_OutCount = 0;
+                HostAes_Remaining = HOSTAES_BLOCK_CYCLES;
+            }
+            break;
+
+        case HOSTAES_SR1:
+        case HOSTAES_SR2:
+        case HOSTAES_DOUTR:
+            HOSTSIM_REG(Model, Offset & ~3U) = Previous;
+            break;
+
+        default:
+            break;
+    }
+    HostAes_UpdateIrq(Model);
+}
+
+static uint8_t HostAes_DMARequest(HostSim_ModelTypeDef* Model, uint32_t Offset, uint8_t Write)
+{
+    uint32_t cr1 = HOSTSIM_REG(Model, HOSTAES_CR1);
+
+    (void)Write;
+
+    if (((cr1 & AES_CR1_EN) == 0) || (HostAes_Remaining != 0))
+    {
+        return 0;
+    }
+    if (Offset == HOSTAES_DINR)
+    {
+        return (uint8_t)(((cr1 & AES_CR1_DMAINEN) != 0) && (HostAes_OutCount == 0));
+    }
+    if (Offset == HOSTAES_DOUTR)
+    {
+        return (uint8_t)(((cr1 & AES_CR1_DMAOUTEN) != 0) && (HostAes_OutCount != 0));
+    }
+    return 0;
+}
+
+static void HostAes_Tick(HostSim_ModelTypeDef* Model)
+{
+    if ((HostAes_Remaining == 0) || (--HostAes_Remaining != 0))
+    {
+        return;
+    }
+
+    if (HostAes_Deriving != 0)
+    {
+        HostAes_Derive(Model);
+        HostAes_Deriving = 0;
+    }
+    else
+    {
+        HostAes_Compute(Model);
+        HostAes_OutCount = 4;
+        HostAes_BlockCount++;
+    }
+    HOSTSIM_REG(Model, HOSTAES_SR1) |= AES_SR1_CCF;
+    HostAes_UpdateIrq(Model);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Returns the number of blocks computed since the start of the program.
+  */
+uint32_t HostAes_Blocks(void)
+{
+    return HostAes_BlockCount;
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
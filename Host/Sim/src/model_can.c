@@ -0,0 +1,374 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  model_can.c
+* @brief:     CAN model: initialization and sleep handshakes, the three
+*             transmit mailboxes sent by identifier priority, the two receive
+*             FIFOs of three frames and the LCD_CAN interrupt line.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "host_models.h"
+
+/** @addtogroup HostSim
+  * @{
+  */
+
+/* Private define ------------------------------------------------------------*/
+#define HOSTCAN_LOG_SIZE            256U
+#define HOSTCAN_SCHEDULE_SIZE       8U
+#define HOSTCAN_FIFO_DEPTH          3U
+#define HOSTCAN_MAILBOXES           3U
+#define HOSTCAN_NONE                0xFFU
+
+#define HOSTCAN_MCR                 offsetof(CAN_TypeDef, MCR)
+#define HOSTCAN_MSR                 offsetof(CAN_TypeDef, MSR)
+#define HOSTCAN_TSR                 offsetof(CAN_TypeDef, TSR)
+#define HOSTCAN_RF0R                offsetof(CAN_TypeDef, RF0R)
+#define HOSTCAN_RF1R                offsetof(CAN_TypeDef, RF1R)
+#define HOSTCAN_IER                 offsetof(CAN_TypeDef, IER)
+#define HOSTCAN_TI0R                offsetof(CAN_TypeDef, TI0R)
+#define HOSTCAN_RI0R                offsetof(CAN_TypeDef, RI0R)
+#define HOSTCAN_RI1R                offsetof(CAN_TypeDef, RI1R)
+
+/* Mailbox Index: TIxR, TDTxR, TDLxR, TDHxR */
+#define HOSTCAN_TIR(Index)          (HOSTCAN_TI0R + 0x10U * (Index))
+#define HOSTCAN_RIR(Fifo)           ((Fifo == 0) ? HOSTCAN_RI0R : HOSTCAN_RI1R)
+#define HOSTCAN_RFR(Fifo)           ((Fifo == 0) ? HOSTCAN_RF0R : HOSTCAN_RF1R)
+
+/* TSR flags of mailbox 0 cleared by RQCP0, mailbox n is 8 x n bits higher */
+#define HOSTCAN_TSR_STATUS0         (CAN_TSR_RQCP0 | CAN_TSR_TXOK0 | CAN_TSR_ALST0 | CAN_TSR_TERR0)
+#define HOSTCAN_TSR_RQCP            (CAN_TSR_RQCP0 | CAN_TSR_RQCP1 | CAN_TSR_RQCP2)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+    CanMailbox Frame;
+    uint32_t Remaining;                 /*!< Cycles to the end of the frame, 0 when free */
+    uint8_t FIFONumber;
+} HostCan_ScheduledTypeDef;
+
+typedef struct
+{
+    CanMailbox Frames[HOSTCAN_FIFO_DEPTH];
+    uint32_t Count;
+} HostCan_FifoTypeDef;
+
+/* Private variables ---------------------------------------------------------*/
+static HostCan_ScheduledTypeDef HostCan_Schedule[HOSTCAN_SCHEDULE_SIZE];
+static HostCan_FifoTypeDef HostCan_Fifos[2];
+static uint8_t HostCan_TxMailbox;       /*!< Mailbox on the bus, HOSTCAN_NONE if idle */
+static uint32_t HostCan_TxRemaining;
+static CanMailbox HostCan_Log[HOSTCAN_LOG_SIZE];
+static uint32_t HostCan_LogHead;
+static uint32_t HostCan_LogTail;
+
+/* Private function prototypes -----------------------------------------------*/
+static void HostCan_Reset(HostSim_ModelTypeDef* Model);
+static void HostCan_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous);
+static void HostCan_Tick(HostSim_ModelTypeDef* Model);
+
+HostSim_ModelTypeDef HostCan_Model =
+{
+    "CAN", CAN_BASE, 0x400, HostCan_Reset, NULL, HostCan_Write, NULL, HostCan_Tick, NULL, 0, NULL
+};
+
+/* Private functions ---------------------------------------------------------*/
+static void HostCan_UpdateIrq(HostSim_ModelTypeDef* Model)
+{
+    uint32_t ier = HOSTSIM_REG(Model, HOSTCAN_IER);
+    uint32_t tsr = HOSTSIM_REG(Model, HOSTCAN_TSR);
+    uint32_t rf0r = HOSTSIM_REG(Model, HOSTCAN_RF0R);
+    uint32_t rf1r = HOSTSIM_REG(Model, HOSTCAN_RF1R);
+    uint8_t level;
+
+    level = (uint8_t)((((ier & CAN_IER_TMEIE) != 0) && ((tsr & HOSTCAN_TSR_RQCP) != 0)) ||
+                      (((ier & CAN_IER_FMPIE0) != 0) && ((rf0r & CAN_RF0R_FMP0) != 0)) ||
+                      (((ier & CAN_IER_FFIE0) != 0) && ((rf0r & CAN_RF0R_FULL0) != 0)) ||
+                      (((ier & CAN_IER_FOVIE0) != 0) && ((rf0r & CAN_RF0R_FOVR0) != 0)) ||
+                      (((ier & CAN_IER_FMPIE1) != 0) && ((rf1r & CAN_RF1R_FMP1) != 0)) ||
+                      (((ier & CAN_IER_FFIE1) != 0) && ((rf1r & CAN_RF1R_FULL1) != 0)) ||
+                      (((ier & CAN_IER_FOVIE1) != 0) && ((rf1r & CAN_RF1R_FOVR1) != 0)));
+
+    HostSim_SetIrqLine(Model, LCD_CAN_IRQn, level);
+}
+
+/**
+  * @brief  Shows the output mailbox of a FIFO and its FMP/FULL bits.
+  */
+static void HostCan_UpdateFifo(HostSim_ModelTypeDef* Model, uint8_t FIFONumber)
+{
+    HostCan_FifoTypeDef* fifo = &HostCan_Fifos[FIFONumber];
+    uint32_t rfr = HOSTSIM_REG(Model, HOSTCAN_RFR(FIFONumber)) & CAN_RF0R_FOVR0;
+
+    rfr |= fifo->Count | ((fifo->Count == HOSTCAN_FIFO_DEPTH) ? CAN_RF0R_FULL0 : 0);
+    HOSTSIM_REG(Model, HOSTCAN_RFR(FIFONumber)) = rfr;
+
+    if (fifo->Count != 0)
+    {
+        HOSTSIM_REG(Model, HOSTCAN_RIR(FIFONumber)) = fifo->Frames[0].IR;
+        HOSTSIM_REG(Model, HOSTCAN_RIR(FIFONumber) + 4U) = fifo->Frames[0].DTR;
+        HOSTSIM_REG(Model, HOSTCAN_RIR(FIFONumber) + 8U) = fifo->Frames[0].DLR;
+        HOSTSIM_REG(Model, HOSTCAN_RIR(FIFONumber) + 12U) = fifo->Frames[0].DHR;
+    }
+}
+
+static void HostCan_FifoPut(HostSim_ModelTypeDef* Model, uint8_t FIFONumber, const CanMailbox* Frame)
+{
+    HostCan_FifoTypeDef* fifo = &HostCan_Fifos[FIFONumber];
+
+    if (fifo->Count == HOSTCAN_FIFO_DEPTH)
+    {
+        /* FIFO locked mode off: the last frame is overwritten */
+        fifo->Frames[HOSTCAN_FIFO_DEPTH - 1U] = *Frame;
+        HOSTSIM_REG(Model, HOSTCAN_RFR(FIFONumber)) |= CAN_RF0R_FOVR0;
+    }
+    else
+    {
+        fifo->Frames[fifo->Count++] = *Frame;
+    }
+    HostCan_UpdateFifo(Model, FIFONumber);
+}
+
+static void HostCan_FifoRelease(HostSim_ModelTypeDef* Model, uint8_t FIFONumber)
+{
+    HostCan_FifoTypeDef* fifo = &HostCan_Fifos[FIFONumber];
+    uint32_t i;
+
+    if (fifo->Count != 0)
+    {
+        for (i = 1; i < fifo->Count; i++)
+        {
+            fifo->Frames[i - 1U] = fifo->Frames[i];
+        }
+        fifo->Count--;
+    }
+    HostCan_UpdateFifo(Model, FIFONumber);
+}
+
+/**
+  * @brief  Pending mailbox winning the arbitration: the lowest identifier,
+  *         then the lowest mailbox number.
+  */
+static uint8_t HostCan_Arbitrate(HostSim_ModelTypeDef* Model)
+{
+    uint8_t winner = HOSTCAN_NONE;
+    uint32_t ir;
+    uint32_t best = 0;
+    uint8_t i;
+
+    for (i = 0; i < HOSTCAN_MAILBOXES; i++)
+    {
+        ir = HOSTSIM_REG(Model, HOSTCAN_TIR(i));
+
+        if (((ir & CAN_TI0R_TXRQ) != 0) && ((winner == HOSTCAN_NONE) || ((ir & ~CAN_TI0R_TXRQ) < best)))
+        {
+            winner = i;
+            best = ir & ~CAN_TI0R_TXRQ;
+        }
+    }
+    return winner;
+}
+
+static void HostCan_Reset(HostSim_ModelTypeDef* Model)
+{
+    uint32_t i;
+
+    for (i = 0; i < HOSTCAN_SCHEDULE_SIZE; i++)
+    {
+        HostCan_Schedule[i].Remaining = 0;
+    }
+    HostCan_Fifos[0].Count = 0;
+    HostCan_Fifos[1].Count = 0;
+    HostCan_TxMailbox = HOSTCAN_NONE;
+    HostCan_TxRemaining = 0;
+    HostCan_LogHead = 0;
+    HostCan_LogTail = 0;
+
+    HOSTSIM_REG(Model, HOSTCAN_MCR) = CAN_MCR_DBF | CAN_MCR_SLEEP;
+    HOSTSIM_REG(Model, HOSTCAN_MSR) = CAN_MSR_SLAK;
+    HOSTSIM_REG(Model, HOSTCAN_TSR) = CAN_TSR_TME0 | CAN_TSR_TME1 | CAN_TSR_TME2;
+}
+
+static void HostCan_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous)
+{
+    uint32_t mcr = HOSTSIM_REG(Model, HOSTCAN_MCR);
+    uint32_t tsr;
+    uint32_t index;
+    uint8_t fifo;
+
+    (void)Width;
+    Offset &= ~3U;
+
+    /* Transmit mailboxes: written only while empty, TXRQ makes them pending */
+    if ((Offset >= HOSTCAN_TI0R) && (Offset < HOSTCAN_TIR(HOSTCAN_MAILBOXES)))
+    {
+        index = (Offset - HOSTCAN_TI0R) / 0x10U;
+        tsr = HOSTSIM_REG(Model, HOSTCAN_TSR);
+
+        if ((tsr & (CAN_TSR_TME0 << index)) == 0)
+        {
+            HOSTSIM_REG(Model, Offset) = Previous;
+        }
+        else if ((Offset == HOSTCAN_TIR(index)) && ((Value & CAN_TI0R_TXRQ) != 0))
+        {
+            HOSTSIM_REG(Model, HOSTCAN_TSR) = tsr & ~(CAN_TSR_TME0 << index);
+        }
+        HostCan_UpdateIrq(Model);
+        return;
+    }
+
+    switch (Offset)
+    {
+        case HOSTCAN_MCR:
+            /* The handshakes are immediate */
+            HOSTSIM_REG(Model, HOSTCAN_MSR) = (HOSTSIM_REG(Model, HOSTCAN_MSR) & ~(CAN_MSR_INAK | CAN_MSR_SLAK)) |
+                                              (((mcr & CAN_MCR_INRQ) != 0) ? CAN_MSR_INAK : 0) |
+                                              ((((mcr & CAN_MCR_SLEEP) != 0) && ((mcr & CAN_MCR_INRQ) == 0)) ?
+                                               CAN_MSR_SLAK : 0);
+            break;
+
+        case HOSTCAN_TSR:
+            tsr = Previous;
+            for (index = 0; index < HOSTCAN_MAILBOXES; index++)
+            {
+                if ((Value & (CAN_TSR_RQCP0 << (8U * index))) != 0)
+                {
+                    tsr &= ~(HOSTCAN_TSR_STATUS0 << (8U * index));
+                }
+            }
+            HOSTSIM_REG(Model, HOSTCAN_TSR) = tsr;
+            break;
+
+        case HOSTCAN_RF0R:
+        case HOSTCAN_RF1R:
+            fifo = (uint8_t)((Offset == HOSTCAN_RF0R) ? 0 : 1);
+            HOSTSIM_REG(Model, Offset) = Previous & ~(Value & CAN_RF0R_FOVR0);
+            if ((Value & CAN_RF0R_RFOM0) != 0)
+            {
+                HostCan_FifoRelease(Model, fifo);
+            }
+            else
+            {
+                HostCan_UpdateFifo(Model, fifo);
+            }
+            break;
+
+        case HOSTCAN_MSR:
+        case HOSTCAN_RI0R:
+        case HOSTCAN_RI0R + 4U:
+        case HOSTCAN_RI0R + 8U:
+        case HOSTCAN_RI0R + 12U:
+        case HOSTCAN_RI1R:
+        case HOSTCAN_RI1R + 4U:
+        case HOSTCAN_RI1R + 8U:
+        case HOSTCAN_RI1R + 12U:
+            HOSTSIM_REG(Model, Offset) = Previous;
+            break;
+
+        default:
+            break;
+    }
+    HostCan_UpdateIrq(Model);
+}
+
+static void HostCan_Tick(HostSim_ModelTypeDef* Model)
+{
+    HostCan_ScheduledTypeDef* scheduled;
+    uint32_t i;
+    uint32_t ir;
+    uint8_t changed = 0;
+
+    /* Frames of the other nodes */
+    for (i = 0; i < HOSTCAN_SCHEDULE_SIZE; i++)
+    {
+        scheduled = &HostCan_Schedule[i];
+
+        if ((scheduled->Remaining != 0) && (--scheduled->Remaining == 0))
+        {
+            HostCan_FifoPut(Model, scheduled->FIFONumber, &scheduled->Frame);
+            changed = 1;
+        }
+    }
+
+    /* The frame on the bus, then the next winner of the arbitration */
+    if ((HostCan_TxMailbox != HOSTCAN_NONE) && (--HostCan_TxRemaining == 0))
+    {
+        ir = HOSTSIM_REG(Model, HOSTCAN_TIR(HostCan_TxMailbox));
+
+        if ((HostCan_LogHead - HostCan_LogTail) == HOSTCAN_LOG_SIZE)
+        {
+            HostSim_Fatal("CAN transmit log full");
+        }
+        HostCan_Log[HostCan_LogHead % HOSTCAN_LOG_SIZE].IR = ir & ~CAN_TI0R_TXRQ;
+        HostCan_Log[HostCan_LogHead % HOSTCAN_LOG_SIZE].DTR = HOSTSIM_REG(Model, HOSTCAN_TIR(HostCan_TxMailbox) + 4U);
+        HostCan_Log[HostCan_LogHead % HOSTCAN_LOG_SIZE].DLR = HOSTSIM_REG(Model, HOSTCAN_TIR(HostCan_TxMailbox) + 8U);
+        HostCan_Log[HostCan_LogHead % HOSTCAN_LOG_SIZE].DHR = HOSTSIM_REG(Model, HOSTCAN_TIR(HostCan_TxMailbox) + 12U);
+        HostCan_LogHead++;
+
+        HOSTSIM_REG(Model, HOSTCAN_TIR(HostCan_TxMailbox)) = ir & ~CAN_TI0R_TXRQ;
+        HOSTSIM_REG(Model, HOSTCAN_TSR) |= ((CAN_TSR_RQCP0 | CAN_TSR_TXOK0) << (8U * HostCan_TxMailbox)) |
+                                           (CAN_TSR_TME0 << HostCan_TxMailbox);
+        HostCan_TxMailbox = HOSTCAN_NONE;
+        changed = 1;
+    }
+
+    if ((HostCan_TxMailbox == HOSTCAN_NONE) && ((HOSTSIM_REG(Model, HOSTCAN_MSR) & (CAN_MSR_INAK | CAN_MSR_SLAK)) == 0))
+    {
+        HostCan_TxMailbox = HostCan_Arbitrate(Model);
+        HostCan_TxRemaining = HOSTCAN_FRAME_CYCLES;
+    }
+
+    if (changed != 0)
+    {
+        HostCan_UpdateIrq(Model);
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Another node sends Frame: it is stored in the FIFO FIFONumber
+  *         Delay bus cycles later, at least 1. No filter is applied.
+  */
+void HostCan_Receive(uint8_t FIFONumber, const CanMailbox* Frame, uint32_t Delay)
+{
+    uint32_t i;
+
+    for (i = 0; i < HOSTCAN_SCHEDULE_SIZE; i++)
+    {
+        if (HostCan_Schedule[i].Remaining == 0)
+        {
+            HostCan_Schedule[i].Frame = *Frame;
+            HostCan_Schedule[i].FIFONumber = FIFONumber;
+            HostCan_Schedule[i].Remaining = (Delay != 0) ? Delay : 1U;
+            return;
+        }
+    }
+    HostSim_Fatal("CAN receive schedule full");
+}
+
+/**
+  * @brief  Takes the frames sent since the last call, in the order of the bus.
+  * @retval Number of frames copied to Frames, Size at most.
+  */
+uint32_t HostCan_Transmitted(CanMailbox* Frames, uint32_t Size)
+{
+    uint32_t count = 0;
+
+    while ((count < Size) && (HostCan_LogTail != HostCan_LogHead))
+    {
+        Frames[count++] = HostCan_Log[HostCan_LogTail++ % HOSTCAN_LOG_SIZE];
+    }
+    return count;
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
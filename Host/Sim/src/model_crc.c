@@ -0,0 +1,133 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  model_crc.c
+* @brief:     CRC model: CRC-32 polynomial 0x04C11DB7, most significant bit
+*             first, with the input and output bit reversal options.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "host_models.h"
+
+/** @addtogroup HostSim
+  * @{
+  */
+
+/* Private define ------------------------------------------------------------*/
+#define HOSTCRC_POLYNOMIAL          ((uint32_t)0x04C11DB7)
+#define HOSTCRC_DR                  offsetof(CRC_TypeDef, DR)
+#define HOSTCRC_CR                  offsetof(CRC_TypeDef, CR)
+#define HOSTCRC_INIT                offsetof(CRC_TypeDef, INIT)
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t HostCrc_State;
+static uint32_t HostCrc_WriteCount;
+
+/* Private function prototypes -----------------------------------------------*/
+static void HostCrc_Reset(HostSim_ModelTypeDef* Model);
+static void HostCrc_Read(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width);
+static void HostCrc_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous);
+
+HostSim_ModelTypeDef HostCrc_Model =
+{
+    "CRC", CRC_BASE, 0x400, HostCrc_Reset, HostCrc_Read, HostCrc_Write, NULL, NULL, NULL, 0, NULL
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Reverses the bits of each Size bits group of Value.
+  */
+static uint32_t HostCrc_Reverse(uint32_t Value, uint32_t Size)
+{
+    uint32_t result = 0;
+    uint32_t i;
+
+    for (i = 0; i < 32U; i++)
+    {
+        if ((Value & (1UL << i)) != 0)
+        {
+            result |= 1UL << ((i - (i % Size)) + (Size - 1U - (i % Size)));
+        }
+    }
+    return result;
+}
+
+static void HostCrc_Reset(HostSim_ModelTypeDef* Model)
+{
+    HOSTSIM_REG(Model, HOSTCRC_INIT) = 0xFFFFFFFF;
+    HostCrc_State = 0xFFFFFFFF;
+}
+
+static void HostCrc_Read(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width)
+{
+    (void)Width;
+
+    if ((Offset & ~3U) == HOSTCRC_DR)
+    {
+        HOSTSIM_REG(Model, HOSTCRC_DR) = ((HOSTSIM_REG(Model, HOSTCRC_CR) & CRC_CR_REV_OUT) != 0) ?
+                                         HostCrc_Reverse(HostCrc_State, 32) : HostCrc_State;
+    }
+}
+
+static void HostCrc_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous)
+{
+    uint32_t cr = HOSTSIM_REG(Model, HOSTCRC_CR);
+    uint32_t bits = Width * 8U;
+    uint32_t reverse;
+    uint32_t i;
+
+    (void)Previous;
+
+    switch (Offset & ~3U)
+    {
+        case HOSTCRC_DR:
+            /* REV_IN: 1 by byte, 2 by half word, 3 by word, within the written data */
+            reverse = (cr & CRC_CR_REV_IN) >> CRC_CR_REV_IN_Pos;
+            if (reverse != 0)
+            {
+                reverse = 4U << reverse;
+                Value = HostCrc_Reverse(Value, (reverse < bits) ? reverse : bits);
+            }
+
+            HostCrc_State ^= Value << (32U - bits);
+            for (i = 0; i < bits; i++)
+            {
+                HostCrc_State = ((HostCrc_State & 0x80000000UL) != 0) ?
+                                ((HostCrc_State << 1) ^ HOSTCRC_POLYNOMIAL) : (HostCrc_State << 1);
+            }
+            HostCrc_WriteCount++;
+            break;
+
+        case HOSTCRC_CR:
+            if ((cr & CRC_CR_RESET) != 0)
+            {
+                HostCrc_State = HOSTSIM_REG(Model, HOSTCRC_INIT);
+                HOSTSIM_REG(Model, HOSTCRC_CR) = cr & ~CRC_CR_RESET;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Returns the number of writes to DR since the start of the program.
+  */
+uint32_t HostCrc_Writes(void)
+{
+    return HostCrc_WriteCount;
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,208 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  model_dac.c
+* @brief:     DAC channel model: data holding and output registers, software
+*             and external triggers, DMA requests and DMA underrun.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "host_models.h"
+
+/** @addtogroup HostSim
+  * @{
+  */
+
+/* Private define ------------------------------------------------------------*/
+#define HOSTDAC_CR                  offsetof(DAC_TypeDef, CR)
+#define HOSTDAC_SWTRIGR             offsetof(DAC_TypeDef, SWTRIGR)
+#define HOSTDAC_DHR12R              offsetof(DAC_TypeDef, DHR12R)
+#define HOSTDAC_DHR12L              offsetof(DAC_TypeDef, DHR12L)
+#define HOSTDAC_DHR8R               offsetof(DAC_TypeDef, DHR8R)
+#define HOSTDAC_DOR                 offsetof(DAC_TypeDef, DOR)
+#define HOSTDAC_SR                  offsetof(DAC_TypeDef, SR)
+
+#define HOSTDAC_TSEL_SOFTWARE       (DAC_CR_TSEL_H | DAC_CR_TSEL_L)
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t HostDac_Request;             /*!< DMA request of the next sample not served yet */
+static uint8_t HostDac_Stalled;             /*!< No DMA request since DMAUDR, until DMAEN is set again */
+static uint32_t HostDac_ConversionCount;
+static uint32_t HostDac_UnderrunCount;
+
+/* Private function prototypes -----------------------------------------------*/
+static void HostDac_Reset(HostSim_ModelTypeDef* Model);
+static void HostDac_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous);
+static uint8_t HostDac_DMARequest(HostSim_ModelTypeDef* Model, uint32_t Offset, uint8_t Write);
+
+HostSim_ModelTypeDef HostDac_Model =
+{
+    "DAC", DAC_BASE, 0x400, HostDac_Reset, NULL, HostDac_Write, HostDac_DMARequest, NULL,
+    NULL, 0, NULL
+};
+
+/* Private functions ---------------------------------------------------------*/
+static void HostDac_UpdateIrq(HostSim_ModelTypeDef* Model)
+{
+    uint32_t cr = HOSTSIM_REG(Model, HOSTDAC_CR);
+    uint32_t sr = HOSTSIM_REG(Model, HOSTDAC_SR);
+
+    HostSim_SetIrqLine(Model, DAC_IRQn, (uint8_t)(((cr & DAC_CR_DMAUDRIE) != 0) && ((sr & DAC_SR_DMAUDR) != 0)));
+}
+
+/**
+  * @brief  Trigger: DHR12R is moved to DOR and, with DMAEN, the next sample
+  *         is requested. A trigger arriving before the DMA has served the
+  *         previous request sets DMAUDR, DOR keeps the old sample and
+  *         the DAC stops requesting: the next triggers output DHR12R again
+  *         until DMAUDR is cleared and DMAEN cleared and set again.
+  */
+static void HostDac_Convert(HostSim_ModelTypeDef* Model)
+{
+    uint32_t cr = HOSTSIM_REG(Model, HOSTDAC_CR);
+
+    if ((cr & DAC_CR_EN) == 0)
+    {
+        return;
+    }
+
+    if (((cr & DAC_CR_DMAEN) != 0) && (HostDac_Request != 0))
+    {
+        HOSTSIM_REG(Model, HOSTDAC_SR) |= DAC_SR_DMAUDR;
+        HostDac_UnderrunCount++;
+        HostDac_Request = 0;
+        HostDac_Stalled = 1;
+        HostDac_UpdateIrq(Model);
+        return;
+    }
+
+    HOSTSIM_REG(Model, HOSTDAC_DOR) = HOSTSIM_REG(Model, HOSTDAC_DHR12R) & DAC_DHR12R_DACDHR12R;
+    HostDac_ConversionCount++;
+    HostDac_Request = (uint8_t)(((cr & DAC_CR_DMAEN) != 0) && (HostDac_Stalled == 0));
+}
+
+static void HostDac_Reset(HostSim_ModelTypeDef* Model)
+{
+    (void)Model;
+
+    HostDac_Request = 0;
+    HostDac_Stalled = 0;
+}
+
+static void HostDac_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous)
+{
+    uint32_t cr = HOSTSIM_REG(Model, HOSTDAC_CR);
+    uint8_t load = 0;
+
+    (void)Width;
+
+    switch (Offset & ~3U)
+    {
+        case HOSTDAC_CR:
+            if ((cr & DAC_CR_DMAEN) == 0)
+            {
+                HostDac_Request = 0;
+            }
+            break;
+
+        case HOSTDAC_SWTRIGR:
+            HOSTSIM_REG(Model, HOSTDAC_SWTRIGR) = 0;
+            if (((Value & DAC_SWTRIGR_SWTRIG) != 0) && ((cr & DAC_CR_TEN) != 0) &&
+                ((cr & HOSTDAC_TSEL_SOFTWARE) == HOSTDAC_TSEL_SOFTWARE))
+            {
+                HostDac_Convert(Model);
+            }
+            break;
+
+        case HOSTDAC_DHR12R:
+            HOSTSIM_REG(Model, HOSTDAC_DHR12R) &= DAC_DHR12R_DACDHR12R;
+            load = 1;
+            break;
+
+        case HOSTDAC_DHR12L:
+            HOSTSIM_REG(Model, HOSTDAC_DHR12R) = (HOSTSIM_REG(Model, HOSTDAC_DHR12L) >> 4) & 0xFFFU;
+            load = 1;
+            break;
+
+        case HOSTDAC_DHR8R:
+            HOSTSIM_REG(Model, HOSTDAC_DHR12R) = (HOSTSIM_REG(Model, HOSTDAC_DHR8R) & 0xFFU) << 4;
+            load = 1;
+            break;
+
+        case HOSTDAC_DOR:
+            HOSTSIM_REG(Model, HOSTDAC_DOR) = Previous;
+            break;
+
+        case HOSTDAC_SR:
+            HOSTSIM_REG(Model, HOSTDAC_SR) = Previous & ~(Value & DAC_SR_DMAUDR);
+            break;
+
+        default:
+            break;
+    }
+
+    if (load != 0)
+    {
+        /* A write to the holding register serves the DMA request */
+        HostDac_Request = 0;
+        if (((cr & DAC_CR_EN) != 0) && ((cr & DAC_CR_TEN) == 0))
+        {
+            HOSTSIM_REG(Model, HOSTDAC_DOR) = HOSTSIM_REG(Model, HOSTDAC_DHR12R);
+            HostDac_ConversionCount++;
+        }
+    }
+
+    /* DMAUDR cleared with DMAEN clear: the next DMAEN requests again */
+    if (((HOSTSIM_REG(Model, HOSTDAC_CR) & DAC_CR_DMAEN) == 0) &&
+        ((HOSTSIM_REG(Model, HOSTDAC_SR) & DAC_SR_DMAUDR) == 0))
+    {
+        HostDac_Stalled = 0;
+    }
+    HostDac_UpdateIrq(Model);
+}
+
+static uint8_t HostDac_DMARequest(HostSim_ModelTypeDef* Model, uint32_t Offset, uint8_t Write)
+{
+    (void)Model;
+    (void)Offset;
+    (void)Write;
+
+    return HostDac_Request;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  External trigger edge of the timer selected by TSEL, converts if
+  *         TEN is set.
+  */
+void HostDac_Trigger(void)
+{
+    HostSim_ModelTypeDef* model = &HostDac_Model;
+    uint32_t cr = HOSTSIM_REG(model, HOSTDAC_CR);
+
+    if (((cr & DAC_CR_TEN) != 0) && ((cr & HOSTDAC_TSEL_SOFTWARE) != HOSTDAC_TSEL_SOFTWARE))
+    {
+        HostDac_Convert(model);
+    }
+}
+
+uint32_t HostDac_Conversions(void)
+{
+    return HostDac_ConversionCount;
+}
+
+uint32_t HostDac_Underruns(void)
+{
+    return HostDac_UnderrunCount;
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,297 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  model_dma.c
+* @brief:     DMA model: 7 channels sharing one bus port.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "host_models.h"
+
+/** @addtogroup HostSim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+    uint32_t Peripheral;           /*!< Current peripheral address */
+    uint32_t Memory;               /*!< Current memory address */
+    uint32_t Count;                /*!< Remaining data items */
+    uint32_t Reload;               /*!< Programmed number of data items */
+} HostDma_ChannelTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define HOSTDMA_CHANNELS            7U
+#define HOSTDMA_ISR                 0x00U
+#define HOSTDMA_IFCR                0x04U
+#define HOSTDMA_CHANNEL(n)          (0x08U + (0x14U * (n)))
+#define HOSTDMA_CHCR(n)             (HOSTDMA_CHANNEL(n) + offsetof(DMA_Channel_TypeDef, CHCR))
+#define HOSTDMA_CHDTR(n)            (HOSTDMA_CHANNEL(n) + offsetof(DMA_Channel_TypeDef, CHDTR))
+#define HOSTDMA_CHPAR(n)            (HOSTDMA_CHANNEL(n) + offsetof(DMA_Channel_TypeDef, CHPAR))
+#define HOSTDMA_CHMAR(n)            (HOSTDMA_CHANNEL(n) + offsetof(DMA_Channel_TypeDef, CHMAR))
+
+/* Flags of channel n (0 based) in ISR/IFCR */
+#define HOSTDMA_GIF(n)              ((uint32_t)1 << (4U * (n)))
+#define HOSTDMA_TCIF(n)             ((uint32_t)2 << (4U * (n)))
+#define HOSTDMA_HTIF(n)             ((uint32_t)4 << (4U * (n)))
+#define HOSTDMA_TEIF(n)             ((uint32_t)8 << (4U * (n)))
+#define HOSTDMA_FLAGS(n)            ((uint32_t)0xF << (4U * (n)))
+
+/* Private variables ---------------------------------------------------------*/
+static HostDma_ChannelTypeDef HostDma_Channels[HOSTDMA_CHANNELS];
+static uint32_t HostDma_Cycle;
+static uint32_t HostDma_BeatCount;
+
+/* Private function prototypes -----------------------------------------------*/
+static void HostDma_Reset(HostSim_ModelTypeDef* Model);
+static void HostDma_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous);
+static void HostDma_Tick(HostSim_ModelTypeDef* Model);
+
+HostSim_ModelTypeDef HostDma_Model =
+{
+    "DMA", DMA_BASE, 0x400, HostDma_Reset, NULL, HostDma_Write, NULL, HostDma_Tick, NULL, 0, NULL
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Drives the three interrupt lines from the flags and their enables.
+  */
+static void HostDma_UpdateIrq(HostSim_ModelTypeDef* Model)
+{
+    uint32_t isr = HOSTSIM_REG(Model, HOSTDMA_ISR);
+    uint8_t lines[3] = {0, 0, 0};
+    uint32_t n;
+
+    for (n = 0; n < HOSTDMA_CHANNELS; n++)
+    {
+        uint32_t chcr = HOSTSIM_REG(Model, HOSTDMA_CHCR(n));
+        uint32_t enabled = 0;
+
+        if ((chcr & DMA_Channel_CHCR_TCIE) != 0)
+        {
+            enabled |= HOSTDMA_TCIF(n);
+        }
+        if ((chcr & DMA_Channel_CHCR_HTIE) != 0)
+        {
+            enabled |= HOSTDMA_HTIF(n);
+        }
+        if ((chcr & DMA_Channel_CHCR_TEIE) != 0)
+        {
+            enabled |= HOSTDMA_TEIF(n);
+        }
+        if ((isr & enabled) != 0)
+        {
+            lines[(n == 0U) ? 0 : ((n < 3U) ? 1 : 2)] = 1;
+        }
+    }
+
+    HostSim_SetIrqLine(Model, DMA_CH1_IRQn, lines[0]);
+    HostSim_SetIrqLine(Model, DMA_CH2_3_IRQn, lines[1]);
+    HostSim_SetIrqLine(Model, DMA_CH4_7_IRQn, lines[2]);
+}
+
+static void HostDma_Reset(HostSim_ModelTypeDef* Model)
+{
+    (void)Model;
+
+    HostDma_Cycle = 0;
+    memset(HostDma_Channels, 0, sizeof(HostDma_Channels));
+}
+
+static void HostDma_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous)
+{
+    uint32_t reg = Offset & ~3U;
+    uint32_t n;
+    uint32_t chcr;
+
+    (void)Width;
+    (void)Value;
+
+    if (reg == HOSTDMA_ISR)
+    {
+        HOSTSIM_REG(Model, HOSTDMA_ISR) = Previous;
+        return;
+    }
+    if (reg == HOSTDMA_IFCR)
+    {
+        uint32_t clear = HOSTSIM_REG(Model, HOSTDMA_IFCR);
+
+        for (n = 0; n < HOSTDMA_CHANNELS; n++)
+        {
+            if ((clear & HOSTDMA_GIF(n)) != 0)
+            {
+                clear |= HOSTDMA_FLAGS(n);
+            }
+        }
+        HOSTSIM_REG(Model, HOSTDMA_ISR) &= ~clear;
+        HOSTSIM_REG(Model, HOSTDMA_IFCR) = 0;
+        HostDma_UpdateIrq(Model);
+        return;
+    }
+    if ((reg < HOSTDMA_CHANNEL(0)) || (reg >= HOSTDMA_CHANNEL(HOSTDMA_CHANNELS)))
+    {
+        return;
+    }
+
+    n = (reg - HOSTDMA_CHANNEL(0)) / 0x14U;
+    chcr = HOSTSIM_REG(Model, HOSTDMA_CHCR(n));
+
+    if (reg == HOSTDMA_CHCR(n))
+    {
+        if (((chcr & DMA_Channel_CHCR_EN) != 0) && ((Previous & DMA_Channel_CHCR_EN) == 0))
+        {
+            HostDma_Channels[n].Peripheral = HOSTSIM_REG(Model, HOSTDMA_CHPAR(n));
+            HostDma_Channels[n].Memory = HOSTSIM_REG(Model, HOSTDMA_CHMAR(n));
+            HostDma_Channels[n].Reload = HOSTSIM_REG(Model, HOSTDMA_CHDTR(n)) & 0xFFFFU;
+            HostDma_Channels[n].Count = HostDma_Channels[n].Reload;
+        }
+        HostDma_UpdateIrq(Model);
+    }
+    else if ((chcr & DMA_Channel_CHCR_EN) != 0)
+    {
+        /* CHDTR, CHPAR and CHMAR are read-only while the channel is enabled */
+        HOSTSIM_REG(Model, reg) = Previous;
+    }
+}
+
+/**
+  * @brief  Tells whether channel n wants the bus.
+  */
+static uint8_t HostDma_Requested(HostSim_ModelTypeDef* Model, uint32_t n)
+{
+    uint32_t chcr = HOSTSIM_REG(Model, HOSTDMA_CHCR(n));
+    uint32_t address = HOSTSIM_REG(Model, HOSTDMA_CHPAR(n));
+    HostSim_ModelTypeDef* owner;
+
+    if (((chcr & DMA_Channel_CHCR_EN) == 0) || (HostDma_Channels[n].Count == 0))
+    {
+        return 0;
+    }
+    if ((chcr & DMA_Channel_CHCR_MEM2MEM) != 0)
+    {
+        return 1;
+    }
+    owner = HostSim_FindModel(address);
+    return (uint8_t)((owner != NULL) && (owner->DMARequest != NULL) &&
+                     (owner->DMARequest(owner, address - owner->Base,
+                                       (uint8_t)((chcr & DMA_Channel_CHCR_DIR) != 0)) != 0));
+}
+
+/**
+  * @brief  Moves one data item of channel n.
+  */
+static void HostDma_Beat(HostSim_ModelTypeDef* Model, uint32_t n)
+{
+    HostDma_ChannelTypeDef* channel = &HostDma_Channels[n];
+    uint32_t chcr = HOSTSIM_REG(Model, HOSTDMA_CHCR(n));
+    uint32_t psize = 1U << ((chcr & DMA_Channel_CHCR_PSIZE) >> DMA_Channel_CHCR_PSIZE_Pos);
+    uint32_t msize = 1U << ((chcr & DMA_Channel_CHCR_MSIZE) >> DMA_Channel_CHCR_MSIZE_Pos);
+    uint8_t fault = 0;
+    uint32_t data;
+
+    if ((chcr & DMA_Channel_CHCR_DIR) != 0)
+    {
+        data = HostSim_BusRead(channel->Memory, msize, &fault);
+        if (fault == 0)
+        {
+            HostSim_BusWrite(channel->Peripheral, psize, data, &fault);
+        }
+    }
+    else
+    {
+        data = HostSim_BusRead(channel->Peripheral, psize, &fault);
+        if (fault == 0)
+        {
+            HostSim_BusWrite(channel->Memory, msize, data, &fault);
+        }
+    }
+
+    if (fault != 0)
+    {
+        HOSTSIM_REG(Model, HOSTDMA_CHCR(n)) &= ~DMA_Channel_CHCR_EN;
+        HOSTSIM_REG(Model, HOSTDMA_ISR) |= HOSTDMA_TEIF(n) | HOSTDMA_GIF(n);
+        HostDma_UpdateIrq(Model);
+        return;
+    }
+
+    HostDma_BeatCount++;
+    if ((chcr & DMA_Channel_CHCR_PINC) != 0)
+    {
+        channel->Peripheral += psize;
+    }
+    if ((chcr & DMA_Channel_CHCR_MINC) != 0)
+    {
+        channel->Memory += msize;
+    }
+    channel->Count--;
+
+    if ((channel->Reload >= 2U) && (channel->Count == channel->Reload - (channel->Reload / 2U)))
+    {
+        HOSTSIM_REG(Model, HOSTDMA_ISR) |= HOSTDMA_HTIF(n) | HOSTDMA_GIF(n);
+    }
+    if (channel->Count == 0)
+    {
+        HOSTSIM_REG(Model, HOSTDMA_ISR) |= HOSTDMA_TCIF(n) | HOSTDMA_GIF(n);
+        if ((chcr & DMA_Channel_CHCR_CIRC) != 0)
+        {
+            channel->Count = channel->Reload;
+            channel->Peripheral = HOSTSIM_REG(Model, HOSTDMA_CHPAR(n));
+            channel->Memory = HOSTSIM_REG(Model, HOSTDMA_CHMAR(n));
+        }
+    }
+    HOSTSIM_REG(Model, HOSTDMA_CHDTR(n)) = channel->Count;
+    HostDma_UpdateIrq(Model);
+}
+
+static void HostDma_Tick(HostSim_ModelTypeDef* Model)
+{
+    uint32_t best = HOSTDMA_CHANNELS;
+    uint32_t bestLevel = 0;
+    uint32_t n;
+
+    if (++HostDma_Cycle < HOSTDMA_BEAT_CYCLES)
+    {
+        return;
+    }
+
+    /* Highest PL first, then the lowest channel number */
+    for (n = 0; n < HOSTDMA_CHANNELS; n++)
+    {
+        uint32_t level = ((HOSTSIM_REG(Model, HOSTDMA_CHCR(n)) & DMA_Channel_CHCR_PL) >> DMA_Channel_CHCR_PL_Pos) + 1U;
+
+        if ((level > bestLevel) && (HostDma_Requested(Model, n) != 0))
+        {
+            best = n;
+            bestLevel = level;
+        }
+    }
+
+    if (best < HOSTDMA_CHANNELS)
+    {
+        HostDma_Cycle = 0;
+        HostDma_Beat(Model, best);
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Returns the number of data items moved since the start of the program.
+  */
+uint32_t HostDma_Beats(void)
+{
+    return HostDma_BeatCount;
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,208 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  model_dvsq.c
+* @brief:     DVSQ model: division and square root with their latency.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "host_models.h"
+
+/** @addtogroup HostSim
+  * @{
+  */
+
+/* Private define ------------------------------------------------------------*/
+#define HOSTDVSQ_DIVIDEND           offsetof(DVSQ_TypeDef, DIVIDEND)
+#define HOSTDVSQ_DIVISOR            offsetof(DVSQ_TypeDef, DIVISOR)
+#define HOSTDVSQ_CSR                offsetof(DVSQ_TypeDef, CSR)
+#define HOSTDVSQ_RADICAND           offsetof(DVSQ_TypeDef, RADICAND)
+#define HOSTDVSQ_RES                offsetof(DVSQ_TypeDef, RES)
+#define HOSTDVSQ_REMAINDER          offsetof(DVSQ_TypeDef, REMAINDER)
+
+/* CSR bits written by the software, the others are status */
+#define HOSTDVSQ_CSR_CONFIG         (DVSQ_CSR_HPRESQRT | DVSQ_CSR_OV_INT_EN | DVSQ_CSR_DZ_INT_EN | \
+                                     DVSQ_CSR_DFS | DVSQ_CSR_UNSIGN_DIV)
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t HostDvsq_Remaining;
+static uint32_t HostDvsq_Result;
+static uint32_t HostDvsq_Remainder;
+static uint32_t HostDvsq_Flags;
+static uint32_t HostDvsq_Count;
+
+/* Private function prototypes -----------------------------------------------*/
+static void HostDvsq_Reset(HostSim_ModelTypeDef* Model);
+static void HostDvsq_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous);
+static void HostDvsq_Tick(HostSim_ModelTypeDef* Model);
+
+HostSim_ModelTypeDef HostDvsq_Model =
+{
+    "DVSQ", DVSQ_BASE, 0x400, HostDvsq_Reset, NULL, HostDvsq_Write, NULL, HostDvsq_Tick, NULL, 0, NULL
+};
+
+/* Private functions ---------------------------------------------------------*/
+static uint64_t HostDvsq_Root(uint64_t Value)
+{
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while (bit > Value)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0)
+    {
+        if (Value >= root + bit)
+        {
+            Value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+static void HostDvsq_UpdateIrq(HostSim_ModelTypeDef* Model)
+{
+    uint32_t csr = HOSTSIM_REG(Model, HOSTDVSQ_CSR);
+    uint8_t level = (uint8_t)((((csr & DVSQ_CSR_DZ_FLAG) != 0) && ((csr & DVSQ_CSR_DZ_INT_EN) != 0)) ||
+                              (((csr & DVSQ_CSR_OV_FLAG) != 0) && ((csr & DVSQ_CSR_OV_INT_EN) != 0)));
+
+    HostSim_SetIrqLine(Model, USB_DVSQ_IRQn, level);
+}
+
+static void HostDvsq_Start(HostSim_ModelTypeDef* Model, uint32_t Operation)
+{
+    uint32_t csr = HOSTSIM_REG(Model, HOSTDVSQ_CSR) & HOSTDVSQ_CSR_CONFIG;
+    uint32_t dividend = HOSTSIM_REG(Model, HOSTDVSQ_DIVIDEND);
+    uint32_t divisor = HOSTSIM_REG(Model, HOSTDVSQ_DIVISOR);
+    uint32_t radicand = HOSTSIM_REG(Model, HOSTDVSQ_RADICAND);
+
+    HostDvsq_Flags = 0;
+    HostDvsq_Count++;
+
+    if (Operation == DVSQ_CSR_SQRT)
+    {
+        HostDvsq_Remaining = HOSTDVSQ_SQRT_CYCLES;
+        HostDvsq_Remainder = HOSTSIM_REG(Model, HOSTDVSQ_REMAINDER);
+        HostDvsq_Result = ((csr & DVSQ_CSR_HPRESQRT) != 0) ?
+                          (uint32_t)HostDvsq_Root((uint64_t)radicand << 32) :
+                          (uint32_t)HostDvsq_Root(radicand);
+    }
+    else
+    {
+        HostDvsq_Remaining = HOSTDVSQ_DIV_CYCLES;
+
+        if (divisor == 0)
+        {
+            HostDvsq_Flags = DVSQ_CSR_DZ_FLAG;
+            HostDvsq_Result = 0;
+            HostDvsq_Remainder = dividend;
+        }
+        else if ((csr & DVSQ_CSR_UNSIGN_DIV) != 0)
+        {
+            HostDvsq_Result = dividend / divisor;
+            HostDvsq_Remainder = dividend % divisor;
+        }
+        else if ((dividend == 0x80000000UL) && (divisor == 0xFFFFFFFFUL))
+        {
+            HostDvsq_Flags = DVSQ_CSR_OV_FLAG;
+            HostDvsq_Result = 0x80000000UL;
+            HostDvsq_Remainder = 0;
+        }
+        else
+        {
+            HostDvsq_Result = (uint32_t)((int32_t)dividend / (int32_t)divisor);
+            HostDvsq_Remainder = (uint32_t)((int32_t)dividend % (int32_t)divisor);
+        }
+    }
+
+    HOSTSIM_REG(Model, HOSTDVSQ_CSR) = csr | DVSQ_CSR_BUSY | Operation;
+    HostDvsq_UpdateIrq(Model);
+}
+
+static void HostDvsq_Reset(HostSim_ModelTypeDef* Model)
+{
+    (void)Model;
+
+    HostDvsq_Remaining = 0;
+    HostDvsq_Flags = 0;
+}
+
+static void HostDvsq_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous)
+{
+    uint32_t csr;
+
+    (void)Width;
+
+    switch (Offset & ~3U)
+    {
+        case HOSTDVSQ_CSR:
+            /* Status bits are read-only, DIV_SRT starts a division */
+            csr = (HOSTSIM_REG(Model, HOSTDVSQ_CSR) & HOSTDVSQ_CSR_CONFIG) | (Previous & ~HOSTDVSQ_CSR_CONFIG);
+            HOSTSIM_REG(Model, HOSTDVSQ_CSR) = csr & ~DVSQ_CSR_DIV_SRT;
+            if (((Value & DVSQ_CSR_DIV_SRT) != 0) && ((csr & DVSQ_CSR_BUSY) == 0))
+            {
+                HostDvsq_Start(Model, DVSQ_CSR_DIV);
+            }
+            HostDvsq_UpdateIrq(Model);
+            break;
+
+        case HOSTDVSQ_DIVISOR:
+            if ((HOSTSIM_REG(Model, HOSTDVSQ_CSR) & DVSQ_CSR_DFS) == 0)
+            {
+                HostDvsq_Start(Model, DVSQ_CSR_DIV);
+            }
+            break;
+
+        case HOSTDVSQ_RADICAND:
+            HostDvsq_Start(Model, DVSQ_CSR_SQRT);
+            break;
+
+        case HOSTDVSQ_RES:
+        case HOSTDVSQ_REMAINDER:
+            HOSTSIM_REG(Model, Offset & ~3U) = Previous;
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void HostDvsq_Tick(HostSim_ModelTypeDef* Model)
+{
+    if ((HostDvsq_Remaining == 0) || (--HostDvsq_Remaining != 0))
+    {
+        return;
+    }
+
+    HOSTSIM_REG(Model, HOSTDVSQ_RES) = HostDvsq_Result;
+    HOSTSIM_REG(Model, HOSTDVSQ_REMAINDER) = HostDvsq_Remainder;
+    HOSTSIM_REG(Model, HOSTDVSQ_CSR) = (HOSTSIM_REG(Model, HOSTDVSQ_CSR) & ~DVSQ_CSR_BUSY) | HostDvsq_Flags;
+    HostDvsq_UpdateIrq(Model);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Returns the number of operations started since the start of the program.
+  */
+uint32_t HostDvsq_Operations(void)
+{
+    return HostDvsq_Count;
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,243 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  model_emacc.c
+* @brief:     EMACC model: start of the chain by CLARKE_LDR, completion flags
+*             and latency, and the stage results: sine and cosine, Clarke
+*             and Park in double precision rounded to q15, the PI with its
+*             integral terms and the circle limitation on the table of the
+*             PID RAM, reverse Park.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <math.h>
+#include "host_models.h"
+
+/** @addtogroup HostSim
+  * @{
+  */
+
+/* Private define ------------------------------------------------------------*/
+#define HOSTEMACC_CORDIC_OUT        offsetof(EMACC_TypeDef, CORDIC_OUT)
+#define HOSTEMACC_CLARKE_OUT        offsetof(EMACC_TypeDef, CLARKE_OUT)
+#define HOSTEMACC_PARK_OUT          offsetof(EMACC_TypeDef, PARK_OUT)
+#define HOSTEMACC_PID_OUT           offsetof(EMACC_TypeDef, PID_OUT)
+#define HOSTEMACC_REVPARK_OUT       offsetof(EMACC_TypeDef, REVPARK_OUT)
+#define HOSTEMACC_CLRSR             offsetof(EMACC_TypeDef, CLRSR)
+#define HOSTEMACC_SR                offsetof(EMACC_TypeDef, SR)
+#define HOSTEMACC_ANG_LDR           offsetof(EMACC_TypeDef, ANG_LDR)
+#define HOSTEMACC_CLARKE_LDR        offsetof(EMACC_TypeDef, CLARKE_LDR)
+#define HOSTEMACC_CIRCLELMT_CFG     offsetof(EMACC_TypeDef, CIRCLELMT_CFG)
+#define HOSTEMACC_D_KPKI            offsetof(EMACC_TypeDef, D_KPKI)
+#define HOSTEMACC_ID_REF            offsetof(EMACC_TypeDef, ID_REF)
+#define HOSTEMACC_Q_KPKI            offsetof(EMACC_TypeDef, Q_KPKI)
+#define HOSTEMACC_IQ_REF            offsetof(EMACC_TypeDef, IQ_REF)
+#define HOSTEMACC_PID_RAM           offsetof(EMACC_TypeDef, PID_RAM_SPACE0)
+
+/* Offsets of the PI registers from D_KPKI or Q_KPKI */
+#define HOSTEMACC_PI_KPKI           0x00U
+#define HOSTEMACC_PI_INTUPPER       0x04U
+#define HOSTEMACC_PI_INTLOWER       0x08U
+#define HOSTEMACC_PI_INTOUT         0x0CU
+#define HOSTEMACC_PI_DIV            0x10U
+
+#define HOSTEMACC_SR_ALL            (EMACC_SR_CORDIC_CF | EMACC_SR_CLARKE_CF | EMACC_SR_PARK_CF | \
+                                     EMACC_SR_PID_CF | EMACC_SR_RPARK_CF)
+
+#define HOSTEMACC_PI                3.14159265358979323846
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t HostEmacc_Remaining;
+static uint32_t HostEmacc_Count;
+static int64_t HostEmacc_IntegralD;
+static int64_t HostEmacc_IntegralQ;
+
+/* Stage results published at the end of the chain */
+static uint32_t HostEmacc_Out[5];
+
+/* Private function prototypes -----------------------------------------------*/
+static void HostEmacc_Reset(HostSim_ModelTypeDef* Model);
+static void HostEmacc_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous);
+static void HostEmacc_Tick(HostSim_ModelTypeDef* Model);
+
+HostSim_ModelTypeDef HostEmacc_Model =
+{
+    "EMACC", EMACC_BASE, 0x400, HostEmacc_Reset, NULL, HostEmacc_Write, NULL, HostEmacc_Tick, NULL, 0, NULL
+};
+
+/* Private functions ---------------------------------------------------------*/
+static int32_t HostEmacc_Q15(double Value)
+{
+    Value = floor(Value + 0.5);
+
+    return (Value > 32767.0) ? 32767 : ((Value < -32767.0) ? -32767 : (int32_t)Value);
+}
+
+static uint32_t HostEmacc_Pack(int32_t High, int32_t Low)
+{
+    return ((uint32_t)(uint16_t)High << 16) | (uint16_t)Low;
+}
+
+/**
+  * @brief  PI of the D or Q axis, registers at Pi: the integral term sums
+  *         Ki x error within the integral limits, the output is the sum of
+  *         the Kp and integral terms shifted by their divisors, within the
+  *         output limits.
+  */
+static int32_t HostEmacc_PI(HostSim_ModelTypeDef* Model, uint32_t Pi, int64_t* Integral, int32_t Error)
+{
+    uint32_t kpki = HOSTSIM_REG(Model, Pi + HOSTEMACC_PI_KPKI);
+    uint32_t intout = HOSTSIM_REG(Model, Pi + HOSTEMACC_PI_INTOUT);
+    uint32_t div = HOSTSIM_REG(Model, Pi + HOSTEMACC_PI_DIV);
+    int32_t kp = (int16_t)(kpki >> 16);
+    int32_t ki = (int16_t)(kpki & 0xFFFFU);
+    int64_t upper = (int32_t)HOSTSIM_REG(Model, Pi + HOSTEMACC_PI_INTUPPER);
+    int64_t lower = (int32_t)HOSTSIM_REG(Model, Pi + HOSTEMACC_PI_INTLOWER);
+    int64_t output;
+
+    *Integral = (ki == 0) ? 0 : (*Integral + (int64_t)ki * Error);
+    *Integral = (*Integral > upper) ? upper : ((*Integral < lower) ? lower : *Integral);
+
+    output = (((int64_t)kp * Error) >> (div >> 16)) + (*Integral >> (div & 0xFFFFU));
+
+    if (output > (int16_t)(intout >> 16))
+    {
+        output = (int16_t)(intout >> 16);
+    }
+    else if (output < (int16_t)(intout & 0xFFFFU))
+    {
+        output = (int16_t)(intout & 0xFFFFU);
+    }
+
+    return (int32_t)output;
+}
+
+/**
+  * @brief  Runs the whole chain on ANG_LDR and CLARKE_LDR.
+  */
+static void HostEmacc_Chain(HostSim_ModelTypeDef* Model)
+{
+    uint32_t iab = HOSTSIM_REG(Model, HOSTEMACC_CLARKE_LDR);
+    uint32_t cfg = HOSTSIM_REG(Model, HOSTEMACC_CIRCLELMT_CFG);
+    double angle = (int16_t)HOSTSIM_REG(Model, HOSTEMACC_ANG_LDR) * HOSTEMACC_PI / 32768.0;
+    int32_t ia = (int16_t)(iab >> 16);
+    int32_t ib = (int16_t)(iab & 0xFFFFU);
+    int32_t cosx, sinx, ialpha, ibeta, iq, id, vq, vd;
+    uint32_t module;
+    uint32_t index;
+    uint32_t scale;
+    uint32_t max;
+
+    cosx = HostEmacc_Q15(32768.0 * cos(angle));
+    sinx = HostEmacc_Q15(32768.0 * sin(angle));
+
+    ialpha = ia;
+    ibeta = HostEmacc_Q15(-(ia + 2.0 * ib) / sqrt(3.0));
+
+    iq = HostEmacc_Q15(((double)ialpha * cosx - (double)ibeta * sinx) / 32768.0);
+    id = HostEmacc_Q15(((double)ialpha * sinx + (double)ibeta * cosx) / 32768.0);
+
+    vq = HostEmacc_PI(Model, HOSTEMACC_Q_KPKI, &HostEmacc_IntegralQ,
+                      (int16_t)(HOSTSIM_REG(Model, HOSTEMACC_IQ_REF) & 0xFFFFU) - iq);
+    vd = HostEmacc_PI(Model, HOSTEMACC_D_KPKI, &HostEmacc_IntegralD,
+                      (int16_t)(HOSTSIM_REG(Model, HOSTEMACC_ID_REF) >> 16) - id);
+
+    /* Circle limitation: the modulus scaled by the entry of the table loaded
+       in the PID RAM, from the index given by CIRCLELMT_CFG */
+    max = cfg & 0xFFFFU;
+    module = (uint32_t)(vq * vq) + (uint32_t)(vd * vd);
+
+    if (module > max * max)
+    {
+        index = (module >> 24) - (cfg >> 16);
+        index = (index > 64U) ? 64U : index;
+        scale = HOSTSIM_REG(Model, HOSTEMACC_PID_RAM + (index / 2U) * 4U);
+        scale = ((index & 1U) != 0) ? (scale >> 16) : (scale & 0xFFFFU);
+        vq = (vq * (int32_t)scale) / 32768;
+        vd = (vd * (int32_t)scale) / 32768;
+    }
+
+    HostEmacc_Out[0] = HostEmacc_Pack(cosx, sinx);
+    HostEmacc_Out[1] = HostEmacc_Pack(ialpha, ibeta);
+    HostEmacc_Out[2] = HostEmacc_Pack(id, iq);
+    HostEmacc_Out[3] = HostEmacc_Pack(vd, vq);
+    HostEmacc_Out[4] = HostEmacc_Pack(HostEmacc_Q15(((double)vq * cosx + (double)vd * sinx) / 32768.0),
+                                      HostEmacc_Q15(((double)vd * cosx - (double)vq * sinx) / 32768.0));
+}
+
+static void HostEmacc_Reset(HostSim_ModelTypeDef* Model)
+{
+    (void)Model;
+
+    HostEmacc_Remaining = 0;
+    HostEmacc_IntegralD = 0;
+    HostEmacc_IntegralQ = 0;
+}
+
+static void HostEmacc_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous)
+{
+    (void)Width;
+
+    switch (Offset & ~3U)
+    {
+        case HOSTEMACC_CLARKE_LDR:
+            HostEmacc_Chain(Model);
+            HostEmacc_Remaining = HOSTEMACC_CHAIN_CYCLES;
+            HostEmacc_Count++;
+            HOSTSIM_REG(Model, HOSTEMACC_SR) &= ~HOSTEMACC_SR_ALL;
+            break;
+
+        case HOSTEMACC_CLRSR:
+            HOSTSIM_REG(Model, HOSTEMACC_SR) &= ~(Value & HOSTEMACC_SR_ALL);
+            HOSTSIM_REG(Model, HOSTEMACC_CLRSR) = 0;
+            break;
+
+        case HOSTEMACC_SR:
+        case HOSTEMACC_CORDIC_OUT:
+        case HOSTEMACC_CLARKE_OUT:
+        case HOSTEMACC_PARK_OUT:
+        case HOSTEMACC_PID_OUT:
+        case HOSTEMACC_REVPARK_OUT:
+            HOSTSIM_REG(Model, Offset & ~3U) = Previous;
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void HostEmacc_Tick(HostSim_ModelTypeDef* Model)
+{
+    uint32_t i;
+
+    if ((HostEmacc_Remaining == 0) || (--HostEmacc_Remaining != 0))
+    {
+        return;
+    }
+
+    for (i = 0; i < 5U; i++)
+    {
+        HOSTSIM_REG(Model, HOSTEMACC_CORDIC_OUT + i * 4U) = HostEmacc_Out[i];
+    }
+    HOSTSIM_REG(Model, HOSTEMACC_SR) |= HOSTEMACC_SR_ALL;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Returns the number of chains started since the start of the program.
+  */
+uint32_t HostEmacc_Calculations(void)
+{
+    return HostEmacc_Count;
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,373 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  model_flash.c
+* @brief:     FLASH model: interface registers and the 64 KB array, with the
+*             operation times, the error flags and power loss injection.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "host_models.h"
+
+/** @addtogroup HostSim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+    HOSTFLASH_IDLE = 0,
+    HOSTFLASH_PROGRAM,
+    HOSTFLASH_ERASE
+} HostFlash_OperationTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define HOSTFLASH_KEYR              offsetof(FLASH_TypeDef, KEYR)
+#define HOSTFLASH_OPTKEYR           offsetof(FLASH_TypeDef, OPTKEYR)
+#define HOSTFLASH_SR                offsetof(FLASH_TypeDef, SR)
+#define HOSTFLASH_CR                offsetof(FLASH_TypeDef, CR)
+#define HOSTFLASH_AR                offsetof(FLASH_TypeDef, AR)
+#define HOSTFLASH_WRPR              offsetof(FLASH_TypeDef, WRPR)
+#define HOSTFLASH_ECR               offsetof(FLASH_TypeDef, ECR)
+
+#define HOSTFLASH_PAGE_SIZE         0x400U
+#define HOSTFLASH_HALF_PAGE_SIZE    0x200U
+#define HOSTFLASH_WRP_SECTOR_SIZE   0x1000U     /*!< 4 pages per write protection bit */
+#define HOSTFLASH_KEY1              0x45670123U
+#define HOSTFLASH_KEY2              0xCDEF89ABU
+
+#define HOSTFLASH_SR_ERRORS         (FLASH_SR_PGERR | FLASH_SR_WRPRTERR | FLASH_SR_SIZEERR)
+#define HOSTFLASH_SR_W1C            (HOSTFLASH_SR_ERRORS | FLASH_SR_EOP)
+
+/* Private variables ---------------------------------------------------------*/
+static HostFlash_OperationTypeDef HostFlash_Operation;
+static uint32_t HostFlash_Address;      /*!< Word to program or first byte to erase */
+static uint32_t HostFlash_Length;       /*!< Bytes to erase */
+static uint32_t HostFlash_Data;         /*!< Word to program */
+static uint32_t HostFlash_Remaining;
+static uint32_t HostFlash_Duration;
+static uint32_t HostFlash_KeyStep;
+static uint32_t HostFlash_OptKeyStep;
+static uint32_t HostFlash_WriteProtection;
+static uint32_t HostFlash_OperationCount;
+static uint32_t HostFlash_PowerLossOperation;
+
+/* Private function prototypes -----------------------------------------------*/
+static void HostFlash_Reset(HostSim_ModelTypeDef* Model);
+static void HostFlash_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous);
+static void HostFlash_Tick(HostSim_ModelTypeDef* Model);
+static void HostFlash_ArrayWrite(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous);
+
+HostSim_ModelTypeDef HostFlash_Model =
+{
+    "FLASH", FLASH_RBASE, 0x400, HostFlash_Reset, NULL, HostFlash_Write, NULL, HostFlash_Tick, NULL, 0, NULL
+};
+
+HostSim_ModelTypeDef HostFlash_ArrayModel =
+{
+    "FLASH array", HOSTSIM_FLASH_BASE, HOSTSIM_FLASH_SIZE, NULL, NULL, HostFlash_ArrayWrite, NULL, NULL, NULL, 0, NULL
+};
+
+/* Private functions ---------------------------------------------------------*/
+static void HostFlash_UpdateIrq(void)
+{
+    uint32_t cr = HOSTSIM_REG(&HostFlash_Model, HOSTFLASH_CR);
+    uint32_t sr = HOSTSIM_REG(&HostFlash_Model, HOSTFLASH_SR);
+    uint8_t level = (uint8_t)((((sr & FLASH_SR_EOP) != 0) && ((cr & FLASH_CR_EOPIE) != 0)) ||
+                              (((sr & HOSTFLASH_SR_ERRORS) != 0) && ((cr & FLASH_CR_ERRIE) != 0)));
+
+    HostSim_SetIrqLine(&HostFlash_Model, FLASH_IRQn, level);
+}
+
+static void HostFlash_SetError(uint32_t Flag)
+{
+    HOSTSIM_REG(&HostFlash_Model, HOSTFLASH_SR) |= Flag;
+    HostFlash_UpdateIrq();
+}
+
+static uint8_t HostFlash_Protected(uint32_t Offset, uint32_t Length)
+{
+    uint32_t first = Offset / HOSTFLASH_WRP_SECTOR_SIZE;
+    uint32_t last = (Offset + Length - 1U) / HOSTFLASH_WRP_SECTOR_SIZE;
+
+    return (uint8_t)((HostFlash_WriteProtection & (((2UL << last) - 1U) & ~((1UL << first) - 1U))) != 0);
+}
+
+/**
+  * @brief  Starts an operation: BSY is held for its duration.
+  */
+static void HostFlash_Start(HostFlash_OperationTypeDef Operation, uint32_t Duration)
+{
+    HostFlash_Operation = Operation;
+    HostFlash_Remaining = Duration;
+    HostFlash_Duration = Duration;
+    HostFlash_OperationCount++;
+    HOSTSIM_REG(&HostFlash_Model, HOSTFLASH_SR) |= FLASH_SR_BSY;
+}
+
+/**
+  * @brief  Leaves the operation in progress half done, as a power loss would.
+  *         A word keeps its low half word unprogrammed, an erase only reaches
+  *         the first half of its range.
+  */
+static void HostFlash_Tear(void)
+{
+    volatile uint32_t* word;
+
+    if (HostFlash_Operation == HOSTFLASH_PROGRAM)
+    {
+        word = (volatile uint32_t*)HostSim_Backdoor(HostFlash_Address);
+        *word &= HostFlash_Data | 0x0000FFFFU;
+    }
+    else if (HostFlash_Operation == HOSTFLASH_ERASE)
+    {
+        memset(HostSim_Backdoor(HostFlash_Address), 0xFF, HostFlash_Length / 2U);
+    }
+}
+
+static void HostFlash_Reset(HostSim_ModelTypeDef* Model)
+{
+    HostFlash_Operation = HOSTFLASH_IDLE;
+    HostFlash_Remaining = 0;
+    HostFlash_KeyStep = 0;
+    HostFlash_OptKeyStep = 0;
+    HOSTSIM_REG(Model, HOSTFLASH_CR) = FLASH_CR_LOCK;
+    HOSTSIM_REG(Model, HOSTFLASH_WRPR) = ~HostFlash_WriteProtection;
+}
+
+static void HostFlash_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous)
+{
+    uint32_t cr;
+    uint32_t address;
+
+    (void)Width;
+
+    switch (Offset & ~3U)
+    {
+        case HOSTFLASH_KEYR:
+            if ((HostFlash_KeyStep == 0) && (Value == HOSTFLASH_KEY1))
+            {
+                HostFlash_KeyStep = 1;
+            }
+            else if ((HostFlash_KeyStep == 1) && (Value == HOSTFLASH_KEY2))
+            {
+                HOSTSIM_REG(Model, HOSTFLASH_CR) &= ~FLASH_CR_LOCK;
+                HostFlash_KeyStep = 0;
+            }
+            else
+            {
+                HostFlash_KeyStep = 0;
+            }
+            HOSTSIM_REG(Model, HOSTFLASH_KEYR) = 0;
+            break;
+
+        case HOSTFLASH_OPTKEYR:
+            if ((HostFlash_OptKeyStep == 0) && (Value == HOSTFLASH_KEY1))
+            {
+                HostFlash_OptKeyStep = 1;
+            }
+            else if ((HostFlash_OptKeyStep == 1) && (Value == HOSTFLASH_KEY2) &&
+                     ((HOSTSIM_REG(Model, HOSTFLASH_CR) & FLASH_CR_LOCK) == 0))
+            {
+                HOSTSIM_REG(Model, HOSTFLASH_CR) |= FLASH_CR_OPTWRE;
+                HostFlash_OptKeyStep = 0;
+            }
+            else
+            {
+                HostFlash_OptKeyStep = 0;
+            }
+            HOSTSIM_REG(Model, HOSTFLASH_OPTKEYR) = 0;
+            break;
+
+        case HOSTFLASH_SR:
+            HOSTSIM_REG(Model, HOSTFLASH_SR) = (Previous & ~(Value & HOSTFLASH_SR_W1C));
+            HostFlash_UpdateIrq();
+            break;
+
+        case HOSTFLASH_CR:
+            cr = HOSTSIM_REG(Model, HOSTFLASH_CR);
+            if ((Previous & FLASH_CR_LOCK) != 0)
+            {
+                /* Locked: only LOCK can be written, and it stays set */
+                HOSTSIM_REG(Model, HOSTFLASH_CR) = Previous;
+                break;
+            }
+            /* OPTWRE is set by the OPTKEYR sequence only, LOCK clears it */
+            cr &= ~(FLASH_CR_OPTWRE & ~Previous);
+            if ((cr & FLASH_CR_LOCK) != 0)
+            {
+                cr &= ~FLASH_CR_OPTWRE;
+            }
+            HOSTSIM_REG(Model, HOSTFLASH_CR) = cr;
+
+            if (((cr & FLASH_CR_STRT) != 0) && ((Previous & FLASH_CR_STRT) == 0))
+            {
+                if (HostFlash_Operation != HOSTFLASH_IDLE)
+                {
+                    HostSim_Stall(HostFlash_Remaining);
+                }
+
+                address = HOSTSIM_REG(Model, HOSTFLASH_AR);
+                if ((cr & FLASH_CR_MER) != 0)
+                {
+                    HostFlash_Address = HOSTSIM_FLASH_BASE;
+                    HostFlash_Length = HOSTSIM_FLASH_SIZE;
+                }
+                else if ((HOSTSIM_REG(Model, HOSTFLASH_ECR) & FLASH_ECR_HPER) != 0)
+                {
+                    HostFlash_Address = address & ~(HOSTFLASH_HALF_PAGE_SIZE - 1U);
+                    HostFlash_Length = HOSTFLASH_HALF_PAGE_SIZE;
+                }
+                else if ((cr & FLASH_CR_PER) != 0)
+                {
+                    HostFlash_Address = address & ~(HOSTFLASH_PAGE_SIZE - 1U);
+                    HostFlash_Length = HOSTFLASH_PAGE_SIZE;
+                }
+                else
+                {
+                    HOSTSIM_REG(Model, HOSTFLASH_CR) = cr & ~FLASH_CR_STRT;
+                    break;
+                }
+
+                if ((HostFlash_Address < HOSTSIM_FLASH_BASE) ||
+                    (HostFlash_Address - HOSTSIM_FLASH_BASE >= HOSTSIM_FLASH_SIZE))
+                {
+                    HOSTSIM_REG(Model, HOSTFLASH_CR) = cr & ~FLASH_CR_STRT;
+                    HostFlash_SetError(FLASH_SR_PGERR);
+                }
+                else if (HostFlash_Protected(HostFlash_Address - HOSTSIM_FLASH_BASE, HostFlash_Length) != 0)
+                {
+                    HOSTSIM_REG(Model, HOSTFLASH_CR) = cr & ~FLASH_CR_STRT;
+                    HostFlash_SetError(FLASH_SR_WRPRTERR);
+                }
+                else
+                {
+                    HostFlash_Start(HOSTFLASH_ERASE,
+                                    (HostFlash_Length == HOSTSIM_FLASH_SIZE) ? HOSTFLASH_MASS_ERASE_CYCLES :
+                                    ((HostFlash_Length == HOSTFLASH_PAGE_SIZE) ? HOSTFLASH_ERASE_CYCLES :
+                                     HOSTFLASH_HALF_ERASE_CYCLES));
+                }
+            }
+            HostFlash_UpdateIrq();
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+  * @brief  Write of the CPU to the array: programs a word when WPG is set.
+  */
+static void HostFlash_ArrayWrite(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous)
+{
+    uint32_t cr = HOSTSIM_REG(&HostFlash_Model, HOSTFLASH_CR);
+
+    /* The array only changes when the operation completes */
+    HOSTSIM_REG(Model, Offset & ~3U) = Previous;
+
+    if (HostFlash_Operation != HOSTFLASH_IDLE)
+    {
+        /* The bus holds the CPU until the flash is ready */
+        HostSim_Stall(HostFlash_Remaining);
+    }
+
+    if (((cr & FLASH_CR_LOCK) != 0) || ((cr & FLASH_CR_WPG) == 0))
+    {
+        HostFlash_SetError(FLASH_SR_PGERR);
+    }
+    else if ((Width != 4U) || ((Offset & 3U) != 0))
+    {
+        HostFlash_SetError(FLASH_SR_SIZEERR);
+    }
+    else if (HostFlash_Protected(Offset, 4) != 0)
+    {
+        HostFlash_SetError(FLASH_SR_WRPRTERR);
+    }
+    else if ((Previous != 0xFFFFFFFFU) && (Value != 0))
+    {
+        HostFlash_SetError(FLASH_SR_PGERR);
+    }
+    else
+    {
+        HostFlash_Address = Model->Base + Offset;
+        HostFlash_Data = Value;
+        HostFlash_Start(HOSTFLASH_PROGRAM, HOSTFLASH_PROGRAM_CYCLES);
+    }
+}
+
+static void HostFlash_Tick(HostSim_ModelTypeDef* Model)
+{
+    if (HostFlash_Remaining == 0)
+    {
+        return;
+    }
+
+    if ((HostFlash_OperationCount == HostFlash_PowerLossOperation) &&
+        (HostFlash_Remaining == HostFlash_Duration / 2U))
+    {
+        HostFlash_PowerLossOperation = 0;
+        HostFlash_Tear();
+        HostSim_PowerLoss();
+    }
+
+    if (--HostFlash_Remaining != 0)
+    {
+        return;
+    }
+
+    if (HostFlash_Operation == HOSTFLASH_PROGRAM)
+    {
+        *(volatile uint32_t*)HostSim_Backdoor(HostFlash_Address) &= HostFlash_Data;
+    }
+    else
+    {
+        memset(HostSim_Backdoor(HostFlash_Address), 0xFF, HostFlash_Length);
+        HOSTSIM_REG(Model, HOSTFLASH_CR) &= ~FLASH_CR_STRT;
+    }
+    HostFlash_Operation = HOSTFLASH_IDLE;
+    HOSTSIM_REG(Model, HOSTFLASH_SR) = (HOSTSIM_REG(Model, HOSTFLASH_SR) & ~FLASH_SR_BSY) | FLASH_SR_EOP;
+    HostFlash_UpdateIrq();
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Returns the number of program and erase operations started since
+  *         the start of the program, power losses included.
+  */
+uint32_t HostFlash_Operations(void)
+{
+    return HostFlash_OperationCount;
+}
+
+/**
+  * @brief  Cuts the power in the middle of an operation.
+  * @param  Operation: value of HostFlash_Operations() once the operation is
+  *         started, 0 to cancel.
+  */
+void HostFlash_PowerLossAt(uint32_t Operation)
+{
+    HostFlash_PowerLossOperation = Operation;
+}
+
+/**
+  * @brief  Sets the write protection, bit n protecting pages 4n to 4n + 3.
+  *         WRPR reads the complement, as the option byte it is loaded from.
+  */
+void HostFlash_SetWriteProtection(uint32_t Mask)
+{
+    HostFlash_WriteProtection = Mask;
+    HOSTSIM_REG(&HostFlash_Model, HOSTFLASH_WRPR) = ~Mask;
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
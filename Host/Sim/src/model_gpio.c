@@ -0,0 +1,169 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  model_gpio.c
+* @brief:     GPIO model: output data register, set/reset registers and the
+*             input levels driven by the test.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "host_models.h"
+
+/** @addtogroup HostSim
+  * @{
+  */
+
+/* Private define ------------------------------------------------------------*/
+#define HOSTGPIO_PORTS              6U
+#define HOSTGPIO_PORT_SIZE          0x400U
+#define HOSTGPIO_LISTENERS          4U
+
+#define GPIO_MODER                  offsetof(GPIO_TypeDef, MODER)
+#define GPIO_IDR                    offsetof(GPIO_TypeDef, IDR)
+#define GPIO_ODR                    offsetof(GPIO_TypeDef, ODR)
+#define GPIO_BSRR                   offsetof(GPIO_TypeDef, BSRR)
+#define GPIO_BRR                    offsetof(GPIO_TypeDef, BRR)
+
+/* Private variables ---------------------------------------------------------*/
+static uint16_t HostGpio_Inputs[HOSTGPIO_PORTS];
+static HostGpio_ListenerTypeDef HostGpio_Listeners[HOSTGPIO_LISTENERS];
+
+/* Private function prototypes -----------------------------------------------*/
+static void HostGpio_Reset(HostSim_ModelTypeDef* Model);
+static void HostGpio_Read(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width);
+static void HostGpio_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous);
+
+HostSim_ModelTypeDef HostGpio_Model =
+{
+    "GPIO", GPIOA_BASE, HOSTGPIO_PORTS * HOSTGPIO_PORT_SIZE,
+    HostGpio_Reset, HostGpio_Read, HostGpio_Write, NULL, NULL, NULL, 0, NULL
+};
+
+/* Private functions ---------------------------------------------------------*/
+static uint16_t HostGpio_OutputMask(uint32_t Port)
+{
+    uint32_t moder = HOSTSIM_REG(&HostGpio_Model, Port * HOSTGPIO_PORT_SIZE + GPIO_MODER);
+    uint16_t mask = 0;
+    uint32_t pin;
+
+    for (pin = 0; pin < 16U; pin++)
+    {
+        if (((moder >> (pin * 2U)) & 3U) == 1U)
+        {
+            mask |= (uint16_t)(1U << pin);
+        }
+    }
+    return mask;
+}
+
+static void HostGpio_Reset(HostSim_ModelTypeDef* Model)
+{
+    (void)Model;
+}
+
+static void HostGpio_Read(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width)
+{
+    uint32_t port = Offset / HOSTGPIO_PORT_SIZE;
+    uint16_t outputs = HostGpio_OutputMask(port);
+    uint16_t odr = (uint16_t)HOSTSIM_REG(Model, port * HOSTGPIO_PORT_SIZE + GPIO_ODR);
+
+    (void)Width;
+
+    HOSTSIM_REG(Model, port * HOSTGPIO_PORT_SIZE + GPIO_IDR) = (odr & outputs) | (HostGpio_Inputs[port] & ~outputs);
+}
+
+static void HostGpio_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous)
+{
+    uint32_t port = Offset / HOSTGPIO_PORT_SIZE;
+    uint32_t reg = (Offset % HOSTGPIO_PORT_SIZE) & ~3U;
+    uint32_t base = port * HOSTGPIO_PORT_SIZE;
+    uint16_t before = (uint16_t)HOSTSIM_REG(Model, base + GPIO_ODR);
+    uint16_t after = before;
+    uint32_t i;
+
+    if ((reg == GPIO_ODR) && (Width == 4U))
+    {
+        before = (uint16_t)Previous;
+        after = (uint16_t)Value;
+    }
+    else if (reg == GPIO_BSRR)
+    {
+        Value <<= ((Offset & 3U) * 8U);
+        after = (uint16_t)((before | (Value & 0xFFFFU)) & ~(Value >> 16));
+        HOSTSIM_REG(Model, base + GPIO_BSRR) = 0;
+    }
+    else if (reg == GPIO_BRR)
+    {
+        after = (uint16_t)(before & ~Value);
+        HOSTSIM_REG(Model, base + GPIO_BRR) = 0;
+    }
+    else if (reg == GPIO_IDR)
+    {
+        HOSTSIM_REG(Model, base + GPIO_IDR) = Previous;
+    }
+
+    HOSTSIM_REG(Model, base + GPIO_ODR) = after;
+
+    if (after != before)
+    {
+        for (i = 0; (i < HOSTGPIO_LISTENERS) && (HostGpio_Listeners[i] != NULL); i++)
+        {
+            HostGpio_Listeners[i]((GPIO_TypeDef*)(uintptr_t)(GPIOA_BASE + base), after, after ^ before);
+        }
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Drives input pins of a port.
+  */
+void HostGpio_SetInput(GPIO_TypeDef* GPIOx, uint16_t Pins, uint8_t Level)
+{
+    uint32_t port = ((uint32_t)(uintptr_t)GPIOx - GPIOA_BASE) / HOSTGPIO_PORT_SIZE;
+
+    if (Level != 0)
+    {
+        HostGpio_Inputs[port] |= Pins;
+    }
+    else
+    {
+        HostGpio_Inputs[port] &= (uint16_t)~Pins;
+    }
+}
+
+/**
+  * @brief  Returns the output data register of a port.
+  */
+uint16_t HostGpio_GetOutput(GPIO_TypeDef* GPIOx)
+{
+    return (uint16_t)HOSTSIM_REG(&HostGpio_Model, ((uint32_t)(uintptr_t)GPIOx - GPIOA_BASE) + GPIO_ODR);
+}
+
+/**
+  * @brief  Registers a function called on each change of an output data register.
+  */
+void HostGpio_Listen(HostGpio_ListenerTypeDef Listener)
+{
+    uint32_t i;
+
+    for (i = 0; i < HOSTGPIO_LISTENERS; i++)
+    {
+        if ((HostGpio_Listeners[i] == NULL) || (HostGpio_Listeners[i] == Listener))
+        {
+            HostGpio_Listeners[i] = Listener;
+            return;
+        }
+    }
+    HostSim_Fatal("too many GPIO listeners");
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
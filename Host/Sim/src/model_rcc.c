@@ -0,0 +1,98 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  model_rcc.c
+* @brief:     RCC model: clocks are ready as soon as they are enabled.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "host_models.h"
+
+/** @addtogroup HostSim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+    uint32_t Offset;
+    uint32_t Enable;
+    uint32_t Ready;
+} HostRcc_ReadyTypeDef;
+
+/* Private variables ---------------------------------------------------------*/
+static const HostRcc_ReadyTypeDef HostRcc_ReadyFlags[] =
+{
+    {offsetof(RCC_TypeDef, CR),   RCC_CR_HSION,      RCC_CR_HSIRDY},
+    {offsetof(RCC_TypeDef, CR),   RCC_CR_HSEON,      RCC_CR_HSERDY},
+    {offsetof(RCC_TypeDef, CR),   RCC_CR_PLLON,      RCC_CR_PLLRDY},
+    {offsetof(RCC_TypeDef, CR2),  RCC_CR2_HSI16ON,   RCC_CR2_HSI16RDY},
+    {offsetof(RCC_TypeDef, CR2),  RCC_CR2_HSI48ON,   RCC_CR2_HSI48RDY},
+    {offsetof(RCC_TypeDef, CSR),  RCC_CSR_LSION,     RCC_CSR_LSIRDY},
+    {offsetof(RCC_TypeDef, BDCR), RCC_BDCR_LSEON,    RCC_BDCR_LSERDY},
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static void HostRcc_Reset(HostSim_ModelTypeDef* Model);
+static void HostRcc_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous);
+
+HostSim_ModelTypeDef HostRcc_Model =
+{
+    "RCC", RCC_BASE, 0x400, HostRcc_Reset, NULL, HostRcc_Write, NULL, NULL, NULL, 0, NULL
+};
+
+/* Private functions ---------------------------------------------------------*/
+static void HostRcc_Update(HostSim_ModelTypeDef* Model)
+{
+    uint32_t i;
+    uint32_t cfgr;
+
+    for (i = 0; i < sizeof(HostRcc_ReadyFlags) / sizeof(HostRcc_ReadyFlags[0]); i++)
+    {
+        const HostRcc_ReadyTypeDef* flag = &HostRcc_ReadyFlags[i];
+
+        if ((HOSTSIM_REG(Model, flag->Offset) & flag->Enable) != 0)
+        {
+            HOSTSIM_REG(Model, flag->Offset) |= flag->Ready;
+        }
+        else
+        {
+            HOSTSIM_REG(Model, flag->Offset) &= ~flag->Ready;
+        }
+    }
+
+    cfgr = HOSTSIM_REG(Model, offsetof(RCC_TypeDef, CFGR));
+    HOSTSIM_REG(Model, offsetof(RCC_TypeDef, CFGR)) = (cfgr & ~RCC_CFGR_SWS) |
+            ((cfgr & RCC_CFGR_SW) << RCC_CFGR_SWS_Pos);
+
+    cfgr = HOSTSIM_REG(Model, offsetof(RCC_TypeDef, CFGR4));
+    HOSTSIM_REG(Model, offsetof(RCC_TypeDef, CFGR4)) = (cfgr & ~RCC_CFGR4_ESWS) |
+            ((cfgr & RCC_CFGR4_ESW) << RCC_CFGR4_ESWS_Pos);
+}
+
+static void HostRcc_Reset(HostSim_ModelTypeDef* Model)
+{
+    HOSTSIM_REG(Model, offsetof(RCC_TypeDef, CR)) = RCC_CR_HSION;
+    HOSTSIM_REG(Model, offsetof(RCC_TypeDef, CR2)) = RCC_CR2_MSIRDY;
+    HostRcc_Update(Model);
+}
+
+static void HostRcc_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous)
+{
+    (void)Offset;
+    (void)Width;
+    (void)Value;
+    (void)Previous;
+
+    HostRcc_Update(Model);
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
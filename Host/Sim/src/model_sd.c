@@ -0,0 +1,508 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  model_sd.c
+* @brief:     SD card model: a standard capacity card in SPI mode, connected
+*             to a SPI bus model with its chip select on a GPIO pin.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "host_models.h"
+
+/** @addtogroup HostSim
+  * @{
+  */
+
+/* Private define ------------------------------------------------------------*/
+#define HOSTSD_BLOCK_SIZE           512U
+#define HOSTSD_QUEUE_SIZE           1024U
+#define HOSTSD_INIT_POLLS           2U          /*!< CMD1 answered "idle" this many times */
+
+#define HOSTSD_R1_IDLE              0x01U
+#define HOSTSD_R1_ILLEGAL           0x04U
+#define HOSTSD_R1_ADDRESS           0x20U
+#define HOSTSD_TOKEN_READ           0xFEU
+#define HOSTSD_TOKEN_WRITE          0xFEU
+#define HOSTSD_TOKEN_MULTI_WRITE    0xFCU
+#define HOSTSD_TOKEN_STOP           0xFDU
+#define HOSTSD_TOKEN_RANGE          0x08U       /*!< Data error token: out of range */
+#define HOSTSD_DATA_ACCEPTED        0x05U
+#define HOSTSD_DATA_WRITE_ERROR     0x0DU
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+    HOSTSD_SD_MODE,                     /*!< Power up: only CMD0 is decoded */
+    HOSTSD_COMMAND,
+    HOSTSD_READ,
+    HOSTSD_WRITE_TOKEN,
+    HOSTSD_WRITE_DATA
+} HostSd_StateTypeDef;
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t HostSd_Array[HOSTSD_MAX_BLOCKS * HOSTSD_BLOCK_SIZE];
+static uint32_t HostSd_Blocks;
+static HostSd_StateTypeDef HostSd_State;
+static uint8_t HostSd_Ready;
+static uint8_t HostSd_AppCmd;
+static uint32_t HostSd_InitPolls;
+
+static uint8_t HostSd_Frame[6];
+static uint32_t HostSd_FrameLength;
+
+static uint8_t HostSd_Queue[HOSTSD_QUEUE_SIZE];
+static uint32_t HostSd_QueueHead;
+static uint32_t HostSd_QueueTail;
+static uint64_t HostSd_BusyUntil;
+
+static uint32_t HostSd_Address;         /*!< Byte address of the current data block */
+static uint8_t HostSd_Multiple;
+static uint64_t HostSd_TokenAt;         /*!< Read: cycle of the next start token */
+static uint8_t HostSd_Buffer[HOSTSD_BLOCK_SIZE + 2U];
+static uint32_t HostSd_Received;
+static uint32_t HostSd_PreErased;
+static uint32_t HostSd_ErrorBlock = 0xFFFFFFFFUL;
+
+static uint32_t HostSd_CommandCount[128];
+static uint32_t HostSd_BlockReads;
+static uint32_t HostSd_BlockWrites;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t HostSd_Exchange(HostSpi_DeviceTypeDef* Device, uint8_t Mosi, uint8_t Selected);
+
+static HostSpi_DeviceTypeDef HostSd_Device = {HostSd_Exchange, NULL, 0, NULL, NULL};
+
+/* Private functions ---------------------------------------------------------*/
+static void HostSd_Put(uint8_t Data)
+{
+    if ((HostSd_QueueHead - HostSd_QueueTail) == HOSTSD_QUEUE_SIZE)
+    {
+        HostSim_Fatal("SD card output queue full");
+    }
+    HostSd_Queue[HostSd_QueueHead++ % HOSTSD_QUEUE_SIZE] = Data;
+}
+
+static void HostSd_Flush(void)
+{
+    HostSd_QueueTail = HostSd_QueueHead;
+}
+
+/**
+  * @brief  Queues a response after one byte of command response time (NCR).
+  */
+static void HostSd_Respond(uint8_t R1)
+{
+    HostSd_Put(0xFF);
+    HostSd_Put(R1);
+}
+
+/**
+  * @brief  Queues a data block: start token, data and a dummy CRC.
+  */
+static void HostSd_PutBlock(const uint8_t* Data, uint32_t Length)
+{
+    uint32_t i;
+
+    HostSd_Put(HOSTSD_TOKEN_READ);
+    for (i = 0; i < Length; i++)
+    {
+        HostSd_Put(Data[i]);
+    }
+    HostSd_Put(0xFF);
+    HostSd_Put(0xFF);
+}
+
+/**
+  * @brief  CSD version 1.0: READ_BL_LEN 9, C_SIZE and C_SIZE_MULT from the size.
+  */
+static void HostSd_PutCsd(void)
+{
+    uint8_t csd[16];
+    uint32_t mult = 0;
+    uint32_t size;
+
+    while ((HostSd_Blocks >> (mult + 2U)) > 4096U)
+    {
+        mult++;
+    }
+    size = (HostSd_Blocks >> (mult + 2U)) - 1U;
+
+    memset(csd, 0, sizeof(csd));
+    csd[1] = 0x26;                                  /* TAAC */
+    csd[3] = 0x32;                                  /* TRAN_SPEED 25 MHz */
+    csd[4] = 0x5F;                                  /* CCC */
+    csd[5] = 0x59;                                  /* CCC, READ_BL_LEN 9 */
+    csd[6] = (uint8_t)(0x80 | ((size >> 10) & 0x03));
+    csd[7] = (uint8_t)(size >> 2);
+    csd[8] = (uint8_t)(((size & 0x03) << 6) | 0x2D);
+    csd[9] = (uint8_t)(0xB4 | ((mult >> 1) & 0x03));
+    csd[10] = (uint8_t)(((mult & 0x01) << 7) | 0x7F);
+    csd[11] = 0x80;
+    csd[12] = 0x0A;                                 /* R2W_FACTOR, WRITE_BL_LEN 9 */
+    csd[13] = 0x40;
+    csd[15] = 0x01;
+    HostSd_PutBlock(csd, sizeof(csd));
+}
+
+static void HostSd_PutCid(void)
+{
+    static const uint8_t cid[16] =
+    {
+        0x1D, 'H', 'K', 'S', 'I', 'M', 'S', 'D', 0x10, 0x12, 0x34, 0x56, 0x78, 0x01, 0x8A, 0x01
+    };
+
+    HostSd_PutBlock(cid, sizeof(cid));
+}
+
+static uint8_t HostSd_InRange(uint32_t Address)
+{
+    return (uint8_t)(((Address % HOSTSD_BLOCK_SIZE) == 0) &&
+                     ((Address / HOSTSD_BLOCK_SIZE) < HostSd_Blocks));
+}
+
+static void HostSd_Execute(void)
+{
+    uint8_t cmd = HostSd_Frame[0] & 0x3F;
+    uint32_t arg = ((uint32_t)HostSd_Frame[1] << 24) | ((uint32_t)HostSd_Frame[2] << 16) |
+                   ((uint32_t)HostSd_Frame[3] << 8) | HostSd_Frame[4];
+    uint8_t app = HostSd_AppCmd;
+    uint8_t r1 = (HostSd_Ready != 0) ? 0x00 : HOSTSD_R1_IDLE;
+
+    HostSd_AppCmd = 0;
+    HostSd_CommandCount[cmd | ((app != 0) ? 0x40U : 0U)]++;
+
+    if (cmd == 0)
+    {
+        HostSd_Flush();
+        HostSd_State = HOSTSD_COMMAND;
+        HostSd_Ready = 0;
+        HostSd_InitPolls = 0;
+        HostSd_PreErased = 0;
+        HostSd_Respond(HOSTSD_R1_IDLE);
+        return;
+    }
+    if (HostSd_State == HOSTSD_SD_MODE)
+    {
+        return;
+    }
+    if ((HostSd_Ready == 0) && (cmd != 1) && (cmd != 55))
+    {
+        HostSd_Respond(HOSTSD_R1_IDLE | HOSTSD_R1_ILLEGAL);
+        return;
+    }
+
+    if (app != 0)
+    {
+        if (cmd == 23)
+        {
+            /* ACMD23 SET_WR_BLK_ERASE_COUNT: pre-erase for the next CMD25 */
+            HostSd_PreErased = arg & 0x007FFFFFUL;
+            HostSd_Respond(r1);
+        }
+        else
+        {
+            HostSd_Respond(r1 | HOSTSD_R1_ILLEGAL);
+        }
+        return;
+    }
+
+    switch (cmd)
+    {
+        case 1:
+            if (++HostSd_InitPolls >= HOSTSD_INIT_POLLS)
+            {
+                HostSd_Ready = 1;
+            }
+            HostSd_Respond((HostSd_Ready != 0) ? 0x00 : HOSTSD_R1_IDLE);
+            break;
+
+        case 9:
+            HostSd_Respond(r1);
+            HostSd_Put(0xFF);
+            HostSd_PutCsd();
+            break;
+
+        case 10:
+            HostSd_Respond(r1);
+            HostSd_Put(0xFF);
+            HostSd_PutCid();
+            break;
+
+        case 12:
+            /* The byte after the command is a stuff byte, then R1 and busy */
+            if ((HostSd_State == HOSTSD_READ) && (HostSd_Multiple != 0))
+            {
+                uint8_t stuff = (HostSd_QueueHead != HostSd_QueueTail) ?
+                                HostSd_Queue[HostSd_QueueTail % HOSTSD_QUEUE_SIZE] : 0xFF;
+
+                HostSd_Flush();
+                HostSd_State = HOSTSD_COMMAND;
+                HostSd_Put(stuff);
+                HostSd_Put(r1);
+                HostSd_BusyUntil = HostSim_Cycles() + HOSTSD_STOP_CYCLES;
+            }
+            else
+            {
+                HostSd_Respond(r1 | HOSTSD_R1_ILLEGAL);
+            }
+            break;
+
+        case 13:
+            HostSd_Respond(r1);
+            HostSd_Put(0x00);
+            break;
+
+        case 16:
+            HostSd_Respond((arg == HOSTSD_BLOCK_SIZE) ? r1 : (r1 | HOSTSD_R1_ILLEGAL));
+            break;
+
+        case 17:
+        case 18:
+            if (HostSd_InRange(arg) == 0)
+            {
+                HostSd_Respond(r1 | HOSTSD_R1_ADDRESS);
+                break;
+            }
+            HostSd_Respond(r1);
+            HostSd_State = HOSTSD_READ;
+            HostSd_Multiple = (uint8_t)(cmd == 18);
+            HostSd_Address = arg;
+            HostSd_TokenAt = HostSim_Cycles() + HOSTSD_ACCESS_CYCLES;
+            break;
+
+        case 24:
+        case 25:
+            if (HostSd_InRange(arg) == 0)
+            {
+                HostSd_Respond(r1 | HOSTSD_R1_ADDRESS);
+                break;
+            }
+            HostSd_Respond(r1);
+            HostSd_State = HOSTSD_WRITE_TOKEN;
+            HostSd_Multiple = (uint8_t)(cmd == 25);
+            HostSd_Address = arg;
+            if (cmd == 24)
+            {
+                HostSd_PreErased = 0;
+            }
+            break;
+
+        case 55:
+            HostSd_AppCmd = 1;
+            HostSd_Respond(r1);
+            break;
+
+        default:
+            HostSd_Respond(r1 | HOSTSD_R1_ILLEGAL);
+            break;
+    }
+}
+
+/**
+  * @brief  End of a received data block: programs it and queues the data response.
+  */
+static void HostSd_Program(void)
+{
+    uint32_t block = HostSd_Address / HOSTSD_BLOCK_SIZE;
+    uint64_t busy = HOSTSD_PROGRAM_CYCLES;
+
+    if ((HostSd_InRange(HostSd_Address) == 0) || (block == HostSd_ErrorBlock))
+    {
+        HostSd_Put(HOSTSD_DATA_WRITE_ERROR);
+    }
+    else
+    {
+        memcpy(&HostSd_Array[HostSd_Address], HostSd_Buffer, HOSTSD_BLOCK_SIZE);
+        HostSd_BlockWrites++;
+        HostSd_Put(HOSTSD_DATA_ACCEPTED);
+    }
+
+    /* Blocks announced by ACMD23 were erased ahead of the data */
+    if (HostSd_PreErased != 0)
+    {
+        HostSd_PreErased--;
+    }
+    else
+    {
+        busy += HOSTSD_ERASE_CYCLES;
+    }
+    HostSd_BusyUntil = HostSim_Cycles() + busy;
+    HostSd_Address += HOSTSD_BLOCK_SIZE;
+    HostSd_State = (HostSd_Multiple != 0) ? HOSTSD_WRITE_TOKEN : HOSTSD_COMMAND;
+}
+
+/**
+  * @brief  Byte on MISO when the output queue is empty.
+  */
+static uint8_t HostSd_Idle(void)
+{
+    if (HostSim_Cycles() < HostSd_BusyUntil)
+    {
+        return 0x00;
+    }
+    if ((HostSd_State == HOSTSD_READ) && (HostSim_Cycles() >= HostSd_TokenAt))
+    {
+        if (HostSd_InRange(HostSd_Address) == 0)
+        {
+            HostSd_State = HOSTSD_COMMAND;
+            return HOSTSD_TOKEN_RANGE;
+        }
+        HostSd_PutBlock(&HostSd_Array[HostSd_Address], HOSTSD_BLOCK_SIZE);
+        HostSd_BlockReads++;
+        HostSd_Address += HOSTSD_BLOCK_SIZE;
+        if (HostSd_Multiple != 0)
+        {
+            HostSd_TokenAt = HostSim_Cycles() + HOSTSD_ACCESS_CYCLES;
+        }
+        else
+        {
+            HostSd_State = HOSTSD_COMMAND;
+        }
+        return 0xFF;
+    }
+    return 0xFF;
+}
+
+static uint8_t HostSd_Exchange(HostSpi_DeviceTypeDef* Device, uint8_t Mosi, uint8_t Selected)
+{
+    uint8_t miso;
+
+    (void)Device;
+
+    if ((Selected == 0) || (HostSd_Blocks == 0))
+    {
+        HostSd_FrameLength = 0;
+        return 0xFF;
+    }
+
+    if (HostSd_QueueHead != HostSd_QueueTail)
+    {
+        miso = HostSd_Queue[HostSd_QueueTail++ % HOSTSD_QUEUE_SIZE];
+    }
+    else
+    {
+        miso = HostSd_Idle();
+    }
+
+    if (HostSd_FrameLength != 0)
+    {
+        HostSd_Frame[HostSd_FrameLength++] = Mosi;
+        if (HostSd_FrameLength == sizeof(HostSd_Frame))
+        {
+            HostSd_FrameLength = 0;
+            HostSd_Execute();
+        }
+    }
+    else if (HostSd_State == HOSTSD_WRITE_DATA)
+    {
+        HostSd_Buffer[HostSd_Received++] = Mosi;
+        if (HostSd_Received == sizeof(HostSd_Buffer))
+        {
+            HostSd_Program();
+        }
+    }
+    else if ((HostSd_State == HOSTSD_WRITE_TOKEN) && (HostSim_Cycles() >= HostSd_BusyUntil) &&
+             (Mosi != 0xFF))
+    {
+        if (Mosi == ((HostSd_Multiple != 0) ? HOSTSD_TOKEN_MULTI_WRITE : HOSTSD_TOKEN_WRITE))
+        {
+            HostSd_State = HOSTSD_WRITE_DATA;
+            HostSd_Received = 0;
+        }
+        else if ((Mosi == HOSTSD_TOKEN_STOP) && (HostSd_Multiple != 0))
+        {
+            HostSd_State = HOSTSD_COMMAND;
+            HostSd_PreErased = 0;
+            HostSd_Put(0xFF);
+            HostSd_BusyUntil = HostSim_Cycles() + HOSTSD_STOP_CYCLES;
+        }
+    }
+    else if ((Mosi & 0xC0) == 0x40)
+    {
+        HostSd_Frame[0] = Mosi;
+        HostSd_FrameLength = 1;
+    }
+
+    return miso;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Inserts an erased card of Blocks blocks of 512 bytes (multiple of
+  *         4, HOSTSD_MAX_BLOCKS at most). The card is in SD mode until it
+  *         receives CMD0 with its chip select low.
+  */
+void HostSd_Insert(SPI_TypeDef* SPIx, GPIO_TypeDef* CsPort, uint16_t CsPin, uint32_t Blocks)
+{
+    if ((Blocks == 0) || (Blocks > HOSTSD_MAX_BLOCKS) || ((Blocks % 4U) != 0))
+    {
+        HostSim_Fatal("bad SD card size %lu", (unsigned long)Blocks);
+    }
+
+    memset(HostSd_Array, 0, sizeof(HostSd_Array));
+    HostSd_Blocks = Blocks;
+    HostSd_State = HOSTSD_SD_MODE;
+    HostSd_Ready = 0;
+    HostSd_AppCmd = 0;
+    HostSd_FrameLength = 0;
+    HostSd_BusyUntil = 0;
+    HostSd_PreErased = 0;
+    HostSd_ErrorBlock = 0xFFFFFFFFUL;
+    HostSd_Flush();
+
+    HostSd_Device.CsPort = CsPort;
+    HostSd_Device.CsPin = CsPin;
+    HostSpi_Connect(SPIx, &HostSd_Device);
+}
+
+/**
+  * @brief  Returns the content of the card.
+  */
+uint8_t* HostSd_Memory(void)
+{
+    return HostSd_Array;
+}
+
+/**
+  * @brief  Makes the writes of a block fail with a write error data
+  *         response, 0xFFFFFFFF for none.
+  */
+void HostSd_WriteErrorAt(uint32_t Block)
+{
+    HostSd_ErrorBlock = Block;
+}
+
+/**
+  * @brief  Returns the number of commands CMDn (or ACMDn with HOSTSD_ACMD)
+  *         received since the start of the program.
+  */
+uint32_t HostSd_Commands(uint32_t Command)
+{
+    return HostSd_CommandCount[Command & 0x7FU];
+}
+
+/**
+  * @brief  Returns the number of blocks read and written since the start
+  *         of the program.
+  */
+uint32_t HostSd_BlocksRead(void)
+{
+    return HostSd_BlockReads;
+}
+
+uint32_t HostSd_BlocksWritten(void)
+{
+    return HostSd_BlockWrites;
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
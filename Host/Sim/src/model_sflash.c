@@ -0,0 +1,263 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  model_sflash.c
+* @brief:     SPI FLASH model: a M25P80 serial FLASH connected to a SPI bus
+*             model with its chip select on a GPIO pin.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "host_models.h"
+
+/** @addtogroup HostSim
+  * @{
+  */
+
+/* Private define ------------------------------------------------------------*/
+#define HOSTSFLASH_PAGE_SIZE        256U
+#define HOSTSFLASH_SECTOR_SIZE      0x10000U
+#define HOSTSFLASH_ID               0x202014UL  /*!< Manufacturer, memory type, capacity */
+
+#define HOSTSFLASH_CMD_WRSR         0x01U
+#define HOSTSFLASH_CMD_WRITE        0x02U
+#define HOSTSFLASH_CMD_READ         0x03U
+#define HOSTSFLASH_CMD_WRDI         0x04U
+#define HOSTSFLASH_CMD_RDSR         0x05U
+#define HOSTSFLASH_CMD_WREN         0x06U
+#define HOSTSFLASH_CMD_RDID         0x9FU
+#define HOSTSFLASH_CMD_BE           0xC7U
+#define HOSTSFLASH_CMD_SE           0xD8U
+
+#define HOSTSFLASH_SR_WIP           0x01U
+#define HOSTSFLASH_SR_WEL           0x02U
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t HostSFlash_Array[HOSTSFLASH_SIZE];
+static uint8_t HostSFlash_Selected;
+static uint8_t HostSFlash_Wel;
+static uint64_t HostSFlash_BusyUntil;
+
+static uint8_t HostSFlash_Command;
+static uint32_t HostSFlash_Count;       /*!< Bytes received since the chip select fell */
+static uint32_t HostSFlash_Address;
+static uint8_t HostSFlash_Page[HOSTSFLASH_PAGE_SIZE];
+static uint32_t HostSFlash_PageLength;
+
+static uint32_t HostSFlash_ProgramCount;
+static uint32_t HostSFlash_EraseCount;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t HostSFlash_Exchange(HostSpi_DeviceTypeDef* Device, uint8_t Mosi, uint8_t Selected);
+
+static HostSpi_DeviceTypeDef HostSFlash_Device = {HostSFlash_Exchange, NULL, 0, NULL, NULL};
+
+/* Private functions ---------------------------------------------------------*/
+static uint8_t HostSFlash_Busy(void)
+{
+    return (uint8_t)(HostSim_Cycles() < HostSFlash_BusyUntil);
+}
+
+/**
+  * @brief  Rising edge of the chip select: the write and erase instructions
+  *         are executed when their last byte was received.
+  */
+static void HostSFlash_Execute(void)
+{
+    uint32_t i;
+
+    if ((HostSFlash_Wel == 0) || (HostSFlash_Busy() != 0))
+    {
+        return;
+    }
+
+    switch (HostSFlash_Command)
+    {
+        case HOSTSFLASH_CMD_WRITE:
+            if (HostSFlash_Count < 5U)
+            {
+                return;
+            }
+            /* The address wraps at the end of the page, bits can only be cleared */
+            for (i = 0; i < HostSFlash_PageLength; i++)
+            {
+                HostSFlash_Array[(HostSFlash_Address & ~(HOSTSFLASH_PAGE_SIZE - 1U)) |
+                                 ((HostSFlash_Address + i) & (HOSTSFLASH_PAGE_SIZE - 1U))] &= HostSFlash_Page[i];
+            }
+            HostSFlash_BusyUntil = HostSim_Cycles() + HOSTSFLASH_PAGE_CYCLES;
+            HostSFlash_ProgramCount++;
+            break;
+
+        case HOSTSFLASH_CMD_SE:
+            if (HostSFlash_Count != 4U)
+            {
+                return;
+            }
+            memset(&HostSFlash_Array[HostSFlash_Address & ~(HOSTSFLASH_SECTOR_SIZE - 1U)], 0xFF, HOSTSFLASH_SECTOR_SIZE);
+            HostSFlash_BusyUntil = HostSim_Cycles() + HOSTSFLASH_SECTOR_CYCLES;
+            HostSFlash_EraseCount++;
+            break;
+
+        case HOSTSFLASH_CMD_BE:
+            if (HostSFlash_Count != 1U)
+            {
+                return;
+            }
+            memset(HostSFlash_Array, 0xFF, sizeof(HostSFlash_Array));
+            HostSFlash_BusyUntil = HostSim_Cycles() + HOSTSFLASH_BULK_CYCLES;
+            HostSFlash_EraseCount++;
+            break;
+
+        default:
+            return;
+    }
+    HostSFlash_Wel = 0;
+}
+
+static void HostSFlash_Listener(GPIO_TypeDef* GPIOx, uint16_t Output, uint16_t Changed)
+{
+    if ((GPIOx != HostSFlash_Device.CsPort) || ((Changed & HostSFlash_Device.CsPin) == 0))
+    {
+        return;
+    }
+
+    if ((Output & HostSFlash_Device.CsPin) == 0)
+    {
+        HostSFlash_Selected = 1;
+        HostSFlash_Count = 0;
+        HostSFlash_PageLength = 0;
+    }
+    else
+    {
+        HostSFlash_Selected = 0;
+        if (HostSFlash_Count != 0)
+        {
+            HostSFlash_Execute();
+        }
+    }
+}
+
+static uint8_t HostSFlash_Exchange(HostSpi_DeviceTypeDef* Device, uint8_t Mosi, uint8_t Selected)
+{
+    uint32_t count = HostSFlash_Count;
+
+    (void)Device;
+
+    if ((Selected == 0) || (HostSFlash_Selected == 0))
+    {
+        return 0xFF;
+    }
+    HostSFlash_Count++;
+
+    if (count == 0)
+    {
+        HostSFlash_Command = Mosi;
+        HostSFlash_Address = 0;
+        if (HostSFlash_Busy() != 0)
+        {
+            /* Only the status register can be read during a write cycle */
+            if (Mosi != HOSTSFLASH_CMD_RDSR)
+            {
+                HostSFlash_Command = 0;
+            }
+        }
+        else if (Mosi == HOSTSFLASH_CMD_WREN)
+        {
+            HostSFlash_Wel = 1;
+        }
+        else if (Mosi == HOSTSFLASH_CMD_WRDI)
+        {
+            HostSFlash_Wel = 0;
+        }
+        return 0xFF;
+    }
+
+    switch (HostSFlash_Command)
+    {
+        case HOSTSFLASH_CMD_RDSR:
+            return (uint8_t)((HostSFlash_Busy() ? HOSTSFLASH_SR_WIP : 0U) | (HostSFlash_Wel ? HOSTSFLASH_SR_WEL : 0U));
+
+        case HOSTSFLASH_CMD_RDID:
+            return (count <= 3U) ? (uint8_t)(HOSTSFLASH_ID >> (8U * (3U - count))) : 0xFF;
+
+        case HOSTSFLASH_CMD_READ:
+        case HOSTSFLASH_CMD_WRITE:
+        case HOSTSFLASH_CMD_SE:
+            if (count <= 3U)
+            {
+                HostSFlash_Address = ((HostSFlash_Address << 8) | Mosi) & (HOSTSFLASH_SIZE - 1U);
+                return 0xFF;
+            }
+            if (HostSFlash_Command == HOSTSFLASH_CMD_READ)
+            {
+                /* The read continues across the whole array and wraps */
+                return HostSFlash_Array[(HostSFlash_Address + count - 4U) & (HOSTSFLASH_SIZE - 1U)];
+            }
+            if (HostSFlash_Command == HOSTSFLASH_CMD_WRITE)
+            {
+                /* More than a page of data: only the last 256 bytes are kept */
+                if (HostSFlash_PageLength == HOSTSFLASH_PAGE_SIZE)
+                {
+                    memmove(HostSFlash_Page, HostSFlash_Page + 1, HOSTSFLASH_PAGE_SIZE - 1U);
+                    HostSFlash_PageLength--;
+                }
+                HostSFlash_Page[HostSFlash_PageLength++] = Mosi;
+            }
+            return 0xFF;
+
+        default:
+            return 0xFF;
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Connects an erased FLASH to a SPI bus, selected by a low level
+  *         on CsPin.
+  */
+void HostSFlash_Insert(SPI_TypeDef* SPIx, GPIO_TypeDef* CsPort, uint16_t CsPin)
+{
+    memset(HostSFlash_Array, 0xFF, sizeof(HostSFlash_Array));
+    HostSFlash_Selected = (uint8_t)((HostGpio_GetOutput(CsPort) & CsPin) == 0);
+    HostSFlash_Wel = 0;
+    HostSFlash_BusyUntil = 0;
+    HostSFlash_Count = 0;
+
+    HostSFlash_Device.CsPort = CsPort;
+    HostSFlash_Device.CsPin = CsPin;
+    HostSpi_Connect(SPIx, &HostSFlash_Device);
+    HostGpio_Listen(HostSFlash_Listener);
+}
+
+/**
+  * @brief  Returns the content of the FLASH.
+  */
+uint8_t* HostSFlash_Memory(void)
+{
+    return HostSFlash_Array;
+}
+
+/**
+  * @brief  Returns the number of page programs and of sector or bulk erases
+  *         since the start of the program.
+  */
+uint32_t HostSFlash_Programs(void)
+{
+    return HostSFlash_ProgramCount;
+}
+
+uint32_t HostSFlash_Erases(void)
+{
+    return HostSFlash_EraseCount;
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
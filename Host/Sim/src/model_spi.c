@@ -0,0 +1,304 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  model_spi.c
+* @brief:     SPI model: SPI1 and SPI2 in master mode with 4 bytes transmit and
+*             receive FIFOs, exchanging bytes with the devices on the bus.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "host_models.h"
+
+/** @addtogroup HostSim
+  * @{
+  */
+
+/* Private define ------------------------------------------------------------*/
+#define HOSTSPI_FIFO_SIZE           4U
+
+#define HOSTSPI_CR1                 offsetof(SPI_TypeDef, CR1)
+#define HOSTSPI_CR2                 offsetof(SPI_TypeDef, CR2)
+#define HOSTSPI_SR                  offsetof(SPI_TypeDef, SR)
+#define HOSTSPI_DR                  offsetof(SPI_TypeDef, DR)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+    IRQn_Type IRQn;
+    uint8_t Tx[HOSTSPI_FIFO_SIZE];
+    uint32_t TxLevel;
+    uint8_t Rx[HOSTSPI_FIFO_SIZE];
+    uint32_t RxLevel;
+    uint32_t Shift;                     /*!< Cycles left for the byte in the shift register */
+    uint8_t ShiftData;
+    uint8_t Overrun;
+    HostSpi_DeviceTypeDef* Devices;
+} HostSpi_StateTypeDef;
+
+/* Private variables ---------------------------------------------------------*/
+static HostSpi_StateTypeDef HostSpi_States[2];
+static uint32_t HostSpi_ByteCount;
+
+/* Private function prototypes -----------------------------------------------*/
+static void HostSpi_Reset(HostSim_ModelTypeDef* Model);
+static void HostSpi_Read(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width);
+static void HostSpi_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous);
+static uint8_t HostSpi_DMARequest(HostSim_ModelTypeDef* Model, uint32_t Offset, uint8_t Write);
+static void HostSpi_Tick(HostSim_ModelTypeDef* Model);
+
+#define HOSTSPI_MODEL(Name, Base, State) \
+    { Name, Base, 0x400, HostSpi_Reset, HostSpi_Read, HostSpi_Write, HostSpi_DMARequest, \
+      HostSpi_Tick, State, 0, NULL }
+
+HostSim_ModelTypeDef HostSpi_Models[2] =
+{
+    HOSTSPI_MODEL("SPI1", SPI1_BASE, &HostSpi_States[0]),
+    HOSTSPI_MODEL("SPI2", SPI2_BASE, &HostSpi_States[1]),
+};
+
+/* Private functions ---------------------------------------------------------*/
+static HostSim_ModelTypeDef* HostSpi_Find(SPI_TypeDef* SPIx)
+{
+    uint32_t i;
+
+    for (i = 0; i < 2U; i++)
+    {
+        if (HostSpi_Models[i].Base == (uint32_t)(uintptr_t)SPIx)
+        {
+            return &HostSpi_Models[i];
+        }
+    }
+    HostSim_Fatal("no SPI at 0x%08lx", (unsigned long)(uintptr_t)SPIx);
+}
+
+/**
+  * @brief  Recomputes SR from the FIFO levels and drives the interrupt line.
+  */
+static void HostSpi_Update(HostSim_ModelTypeDef* Model)
+{
+    HostSpi_StateTypeDef* state = (HostSpi_StateTypeDef*)Model->Context;
+    uint32_t cr2 = HOSTSIM_REG(Model, HOSTSPI_CR2);
+    uint32_t threshold = ((cr2 & SPI_CR2_FRXTH) != 0) ? 1U : 2U;
+    uint32_t sr = 0;
+
+    if (state->TxLevel <= (HOSTSPI_FIFO_SIZE / 2U))
+    {
+        sr |= SPI_SR_TXE;
+    }
+    if (state->RxLevel >= threshold)
+    {
+        sr |= SPI_SR_RXNE;
+    }
+    if ((state->Shift != 0) || (state->TxLevel != 0))
+    {
+        sr |= SPI_SR_BSY;
+    }
+    if (state->Overrun != 0)
+    {
+        sr |= SPI_SR_OVR;
+    }
+    sr |= ((state->RxLevel < 3U) ? state->RxLevel : 3U) << SPI_SR_FRLVL_Pos;
+    sr |= ((state->TxLevel < 3U) ? state->TxLevel : 3U) << SPI_SR_FTLVL_Pos;
+    HOSTSIM_REG(Model, HOSTSPI_SR) = sr;
+
+    HostSim_SetIrqLine(Model, state->IRQn,
+                       (uint8_t)((((sr & SPI_SR_TXE) != 0) && ((cr2 & SPI_CR2_TXEIE) != 0)) ||
+                                 (((sr & SPI_SR_RXNE) != 0) && ((cr2 & SPI_CR2_RXNEIE) != 0)) ||
+                                 (((sr & SPI_SR_OVR) != 0) && ((cr2 & SPI_CR2_ERRIE) != 0))));
+}
+
+/**
+  * @brief  Clocks one byte on the bus: every device sees MOSI, MISO is the
+  *         wired AND of the selected devices (a released line reads 0xFF).
+  */
+static uint8_t HostSpi_Exchange(HostSpi_StateTypeDef* State, uint8_t Mosi)
+{
+    HostSpi_DeviceTypeDef* device;
+    uint8_t miso = 0xFF;
+
+    for (device = State->Devices; device != NULL; device = device->Next)
+    {
+        uint8_t selected = (uint8_t)((HostGpio_GetOutput(device->CsPort) & device->CsPin) == 0);
+
+        miso &= device->Exchange(device, Mosi, selected);
+    }
+    HostSpi_ByteCount++;
+
+    return miso;
+}
+
+static void HostSpi_Reset(HostSim_ModelTypeDef* Model)
+{
+    HostSpi_StateTypeDef* state = (HostSpi_StateTypeDef*)Model->Context;
+
+    /* The devices stay connected across a reset of the microcontroller */
+    state->IRQn = (Model->Base == SPI1_BASE) ? SPI1_IRQn : SPI2_IRQn;
+    state->TxLevel = 0;
+    state->RxLevel = 0;
+    state->Shift = 0;
+    state->Overrun = 0;
+    HostSpi_Update(Model);
+}
+
+static void HostSpi_Read(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width)
+{
+    HostSpi_StateTypeDef* state = (HostSpi_StateTypeDef*)Model->Context;
+    uint32_t count = (Width == 1U) ? 1U : 2U;
+    uint32_t data = 0;
+    uint32_t i;
+
+    if ((Offset & ~3U) == HOSTSPI_SR)
+    {
+        /* OVR is cleared by a DR read followed by a SR read */
+        return;
+    }
+    if ((Offset & ~3U) != HOSTSPI_DR)
+    {
+        return;
+    }
+
+    for (i = 0; (i < count) && (state->RxLevel != 0); i++)
+    {
+        data |= (uint32_t)state->Rx[0] << (8U * i);
+        state->RxLevel--;
+        state->Rx[0] = state->Rx[1];
+        state->Rx[1] = state->Rx[2];
+        state->Rx[2] = state->Rx[3];
+    }
+    state->Overrun = 0;
+    HOSTSIM_REG(Model, HOSTSPI_DR) = data;
+    HostSpi_Update(Model);
+}
+
+static void HostSpi_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous)
+{
+    HostSpi_StateTypeDef* state = (HostSpi_StateTypeDef*)Model->Context;
+    uint32_t count = (Width == 1U) ? 1U : 2U;
+    uint32_t i;
+
+    switch (Offset & ~3U)
+    {
+        case HOSTSPI_DR:
+            /* Data packing: a 16 bits write queues two bytes, low byte first */
+            for (i = 0; (i < count) && (state->TxLevel < HOSTSPI_FIFO_SIZE); i++)
+            {
+                state->Tx[state->TxLevel++] = (uint8_t)(Value >> (8U * i));
+            }
+            break;
+
+        case HOSTSPI_SR:
+            HOSTSIM_REG(Model, HOSTSPI_SR) = Previous;
+            break;
+
+        case HOSTSPI_CR1:
+            if ((HOSTSIM_REG(Model, HOSTSPI_CR1) & SPI_CR1_SPE) == 0)
+            {
+                /* Disabling the SPI empties the transmit FIFO */
+                state->TxLevel = 0;
+            }
+            break;
+
+        default:
+            break;
+    }
+    HostSpi_Update(Model);
+}
+
+static uint8_t HostSpi_DMARequest(HostSim_ModelTypeDef* Model, uint32_t Offset, uint8_t Write)
+{
+    uint32_t cr2 = HOSTSIM_REG(Model, HOSTSPI_CR2);
+    uint32_t sr = HOSTSIM_REG(Model, HOSTSPI_SR);
+
+    if (Offset != HOSTSPI_DR)
+    {
+        return 0;
+    }
+    if (Write != 0)
+    {
+        return (uint8_t)(((cr2 & SPI_CR2_TXDMAEN) != 0) && ((sr & SPI_SR_TXE) != 0));
+    }
+    return (uint8_t)(((cr2 & SPI_CR2_RXDMAEN) != 0) && ((sr & SPI_SR_RXNE) != 0));
+}
+
+static void HostSpi_Tick(HostSim_ModelTypeDef* Model)
+{
+    HostSpi_StateTypeDef* state = (HostSpi_StateTypeDef*)Model->Context;
+    uint32_t cr1 = HOSTSIM_REG(Model, HOSTSPI_CR1);
+    uint8_t changed = 0;
+
+    if (((cr1 & SPI_CR1_SPE) == 0) || ((cr1 & SPI_CR1_MSTR) == 0))
+    {
+        return;
+    }
+
+    if ((state->Shift != 0) && (--state->Shift == 0))
+    {
+        uint8_t miso = HostSpi_Exchange(state, state->ShiftData);
+
+        if (state->RxLevel < HOSTSPI_FIFO_SIZE)
+        {
+            state->Rx[state->RxLevel++] = miso;
+        }
+        else
+        {
+            state->Overrun = 1;
+        }
+        changed = 1;
+    }
+    if ((state->Shift == 0) && (state->TxLevel != 0))
+    {
+        /* 8 SCK periods of fPCLK / 2^(BR + 1) */
+        state->ShiftData = state->Tx[0];
+        state->TxLevel--;
+        state->Tx[0] = state->Tx[1];
+        state->Tx[1] = state->Tx[2];
+        state->Tx[2] = state->Tx[3];
+        state->Shift = 8U << (((cr1 & SPI_CR1_BR) >> SPI_CR1_BR_Pos) + 1U);
+        changed = 1;
+    }
+
+    if (changed != 0)
+    {
+        HostSpi_Update(Model);
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Connects a device to a SPI bus. Connecting it again has no effect.
+  */
+void HostSpi_Connect(SPI_TypeDef* SPIx, HostSpi_DeviceTypeDef* Device)
+{
+    HostSpi_StateTypeDef* state = (HostSpi_StateTypeDef*)HostSpi_Find(SPIx)->Context;
+    HostSpi_DeviceTypeDef* device;
+
+    for (device = state->Devices; device != NULL; device = device->Next)
+    {
+        if (device == Device)
+        {
+            return;
+        }
+    }
+    Device->Next = state->Devices;
+    state->Devices = Device;
+}
+
+/**
+  * @brief  Returns the number of bytes clocked on the SPI buses since the
+  *         start of the program.
+  */
+uint32_t HostSpi_Bytes(void)
+{
+    return HostSpi_ByteCount;
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
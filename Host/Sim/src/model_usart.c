@@ -0,0 +1,355 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  model_usart.c
+* @brief:     USART model: USART1, USART2, UART3 and UART4 with a transmit log
+*             and a receive queue filled by the test.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "host_models.h"
+
+/** @addtogroup HostSim
+  * @{
+  */
+
+/* Private define ------------------------------------------------------------*/
+#define HOSTUSART_QUEUE_SIZE        8192U
+
+#define HOSTUSART_CR1               offsetof(USART_TypeDef, CR1)
+#define HOSTUSART_CR3               offsetof(USART_TypeDef, CR3)
+#define HOSTUSART_BRR               offsetof(USART_TypeDef, BRR)
+#define HOSTUSART_RQR               offsetof(USART_TypeDef, RQR)
+#define HOSTUSART_ISR               offsetof(USART_TypeDef, ISR)
+#define HOSTUSART_ICR               offsetof(USART_TypeDef, ICR)
+#define HOSTUSART_RDR               offsetof(USART_TypeDef, RDR)
+#define HOSTUSART_TDR               offsetof(USART_TypeDef, TDR)
+
+#define HOSTUSART_ICR_FLAGS         (USART_ISR_PE | USART_ISR_FE | USART_ISR_NF | USART_ISR_ORE | \
+                                     USART_ISR_IDLE | USART_ISR_TC)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+    uint8_t Data[HOSTUSART_QUEUE_SIZE];
+    uint32_t Head;
+    uint32_t Tail;
+} HostUsart_QueueTypeDef;
+
+typedef struct
+{
+    IRQn_Type IRQn;
+    HostUsart_QueueTypeDef Rx;          /*!< Characters still to receive */
+    HostUsart_QueueTypeDef Tx;          /*!< Characters sent, not read by the test */
+    uint32_t TxShift;                   /*!< Cycles left for the character in the shift register */
+    uint8_t TxPending;                  /*!< TDR holds a character for the shift register */
+    uint8_t TxData;
+    uint32_t RxTimer;                   /*!< Cycles to the next character on the line */
+    uint32_t IdleTimer;                 /*!< Cycles to the idle line detection */
+} HostUsart_StateTypeDef;
+
+/* Private variables ---------------------------------------------------------*/
+static HostUsart_StateTypeDef HostUsart_States[4];
+
+/* Private function prototypes -----------------------------------------------*/
+static void HostUsart_Reset(HostSim_ModelTypeDef* Model);
+static void HostUsart_Read(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width);
+static void HostUsart_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous);
+static uint8_t HostUsart_DMARequest(HostSim_ModelTypeDef* Model, uint32_t Offset, uint8_t Write);
+static void HostUsart_Tick(HostSim_ModelTypeDef* Model);
+
+#define HOSTUSART_MODEL(Name, Base, State) \
+    { Name, Base, 0x400, HostUsart_Reset, HostUsart_Read, HostUsart_Write, HostUsart_DMARequest, \
+      HostUsart_Tick, State, 0, NULL }
+
+HostSim_ModelTypeDef HostUsart_Models[4] =
+{
+    HOSTUSART_MODEL("USART1", USART1_BASE, &HostUsart_States[0]),
+    HOSTUSART_MODEL("USART2", USART2_BASE, &HostUsart_States[1]),
+    HOSTUSART_MODEL("UART3",  UART3_BASE,  &HostUsart_States[2]),
+    HOSTUSART_MODEL("UART4",  UART4_BASE,  &HostUsart_States[3]),
+};
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t HostUsart_QueueCount(const HostUsart_QueueTypeDef* Queue)
+{
+    return Queue->Head - Queue->Tail;
+}
+
+static void HostUsart_QueuePut(HostUsart_QueueTypeDef* Queue, uint8_t Data)
+{
+    if (HostUsart_QueueCount(Queue) == HOSTUSART_QUEUE_SIZE)
+    {
+        HostSim_Fatal("USART queue full");
+    }
+    Queue->Data[Queue->Head++ % HOSTUSART_QUEUE_SIZE] = Data;
+}
+
+static uint8_t HostUsart_QueueGet(HostUsart_QueueTypeDef* Queue)
+{
+    return Queue->Data[Queue->Tail++ % HOSTUSART_QUEUE_SIZE];
+}
+
+static HostSim_ModelTypeDef* HostUsart_Find(USART_TypeDef* USARTx)
+{
+    uint32_t i;
+
+    for (i = 0; i < 4U; i++)
+    {
+        if (HostUsart_Models[i].Base == (uint32_t)(uintptr_t)USARTx)
+        {
+            return &HostUsart_Models[i];
+        }
+    }
+    HostSim_Fatal("no USART at 0x%08lx", (unsigned long)(uintptr_t)USARTx);
+}
+
+/**
+  * @brief  Bus cycles of one character: start bit, 8 data bits and stop bit.
+  */
+static uint32_t HostUsart_CharTime(HostSim_ModelTypeDef* Model)
+{
+    uint32_t brr = HOSTSIM_REG(Model, HOSTUSART_BRR) & 0xFFFFU;
+
+    return ((brr != 0) ? brr : 1U) * 10U;
+}
+
+static void HostUsart_UpdateIrq(HostSim_ModelTypeDef* Model)
+{
+    HostUsart_StateTypeDef* state = (HostUsart_StateTypeDef*)Model->Context;
+    uint32_t cr1 = HOSTSIM_REG(Model, HOSTUSART_CR1);
+    uint32_t isr = HOSTSIM_REG(Model, HOSTUSART_ISR);
+    uint8_t level;
+
+    level = (uint8_t)((((isr & USART_ISR_TXE) != 0) && ((cr1 & USART_CR1_TXEIE) != 0)) ||
+                      (((isr & USART_ISR_TC) != 0) && ((cr1 & USART_CR1_TCIE) != 0)) ||
+                      (((isr & (USART_ISR_RXNE | USART_ISR_ORE)) != 0) && ((cr1 & USART_CR1_RXNEIE) != 0)) ||
+                      (((isr & USART_ISR_IDLE) != 0) && ((cr1 & USART_CR1_IDLEIE) != 0)));
+
+    HostSim_SetIrqLine(Model, state->IRQn, level);
+}
+
+static void HostUsart_Reset(HostSim_ModelTypeDef* Model)
+{
+    HostUsart_StateTypeDef* state = (HostUsart_StateTypeDef*)Model->Context;
+
+    state->IRQn = (Model->Base == USART1_BASE) ? USART1_IRQn :
+                  ((Model->Base == USART2_BASE) ? USART2_IRQn : UART3_4_IRQn);
+    state->Rx.Head = 0;
+    state->Rx.Tail = 0;
+    state->TxShift = 0;
+    state->TxPending = 0;
+    state->RxTimer = 0;
+    state->IdleTimer = 0;
+    HOSTSIM_REG(Model, HOSTUSART_ISR) = USART_ISR_TXE | USART_ISR_TC;
+}
+
+static void HostUsart_Read(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width)
+{
+    (void)Width;
+
+    if ((Offset & ~3U) == HOSTUSART_RDR)
+    {
+        HOSTSIM_REG(Model, HOSTUSART_ISR) &= ~USART_ISR_RXNE;
+        HostUsart_UpdateIrq(Model);
+    }
+}
+
+static void HostUsart_Write(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous)
+{
+    HostUsart_StateTypeDef* state = (HostUsart_StateTypeDef*)Model->Context;
+    uint32_t cr1 = HOSTSIM_REG(Model, HOSTUSART_CR1);
+
+    (void)Width;
+
+    switch (Offset & ~3U)
+    {
+        case HOSTUSART_CR1:
+            if ((cr1 & USART_CR1_TE) != 0)
+            {
+                HOSTSIM_REG(Model, HOSTUSART_ISR) |= USART_ISR_TEACK;
+            }
+            else
+            {
+                HOSTSIM_REG(Model, HOSTUSART_ISR) &= ~USART_ISR_TEACK;
+            }
+            if ((cr1 & USART_CR1_RE) != 0)
+            {
+                HOSTSIM_REG(Model, HOSTUSART_ISR) |= USART_ISR_REACK;
+            }
+            else
+            {
+                HOSTSIM_REG(Model, HOSTUSART_ISR) &= ~USART_ISR_REACK;
+            }
+            break;
+
+        case HOSTUSART_TDR:
+            if (((cr1 & USART_CR1_UE) != 0) && ((cr1 & USART_CR1_TE) != 0))
+            {
+                state->TxData = (uint8_t)Value;
+                state->TxPending = 1;
+                HOSTSIM_REG(Model, HOSTUSART_ISR) &= ~(USART_ISR_TXE | USART_ISR_TC);
+            }
+            break;
+
+        case HOSTUSART_RQR:
+            if ((Value & USART_RQR_RXFRQ) != 0)
+            {
+                HOSTSIM_REG(Model, HOSTUSART_ISR) &= ~USART_ISR_RXNE;
+            }
+            if ((Value & USART_RQR_TXFRQ) != 0)
+            {
+                state->TxPending = 0;
+                HOSTSIM_REG(Model, HOSTUSART_ISR) |= USART_ISR_TXE;
+            }
+            HOSTSIM_REG(Model, HOSTUSART_RQR) = 0;
+            break;
+
+        case HOSTUSART_ICR:
+            HOSTSIM_REG(Model, HOSTUSART_ISR) &= ~(Value & HOSTUSART_ICR_FLAGS);
+            HOSTSIM_REG(Model, HOSTUSART_ICR) = 0;
+            break;
+
+        case HOSTUSART_ISR:
+        case HOSTUSART_RDR:
+            HOSTSIM_REG(Model, Offset & ~3U) = Previous;
+            break;
+
+        default:
+            break;
+    }
+    HostUsart_UpdateIrq(Model);
+}
+
+static uint8_t HostUsart_DMARequest(HostSim_ModelTypeDef* Model, uint32_t Offset, uint8_t Write)
+{
+    uint32_t cr3 = HOSTSIM_REG(Model, HOSTUSART_CR3);
+    uint32_t isr = HOSTSIM_REG(Model, HOSTUSART_ISR);
+
+    (void)Write;
+
+    if (Offset == HOSTUSART_TDR)
+    {
+        return (uint8_t)(((cr3 & USART_CR3_DMAT) != 0) && ((isr & USART_ISR_TXE) != 0));
+    }
+    if (Offset == HOSTUSART_RDR)
+    {
+        return (uint8_t)(((cr3 & USART_CR3_DMAR) != 0) && ((isr & USART_ISR_RXNE) != 0));
+    }
+    return 0;
+}
+
+static void HostUsart_Tick(HostSim_ModelTypeDef* Model)
+{
+    HostUsart_StateTypeDef* state = (HostUsart_StateTypeDef*)Model->Context;
+    uint32_t cr1 = HOSTSIM_REG(Model, HOSTUSART_CR1);
+    uint32_t before = HOSTSIM_REG(Model, HOSTUSART_ISR);
+    uint32_t isr = before;
+
+    if ((cr1 & USART_CR1_UE) == 0)
+    {
+        return;
+    }
+
+    /* Transmitter: TDR, then the shift register */
+    if ((state->TxShift != 0) && (--state->TxShift == 0) && (state->TxPending == 0))
+    {
+        isr |= USART_ISR_TC;
+    }
+    if ((state->TxShift == 0) && (state->TxPending != 0))
+    {
+        HostUsart_QueuePut(&state->Tx, state->TxData);
+        state->TxPending = 0;
+        state->TxShift = HostUsart_CharTime(Model);
+        isr |= USART_ISR_TXE;
+    }
+
+    /* Receiver: one character per character time, then the idle line */
+    if ((cr1 & USART_CR1_RE) != 0)
+    {
+        if (HostUsart_QueueCount(&state->Rx) != 0)
+        {
+            if (state->RxTimer == 0)
+            {
+                state->RxTimer = HostUsart_CharTime(Model);
+            }
+            else if (--state->RxTimer == 0)
+            {
+                uint8_t data = HostUsart_QueueGet(&state->Rx);
+
+                if ((isr & USART_ISR_RXNE) != 0)
+                {
+                    if ((HOSTSIM_REG(Model, HOSTUSART_CR3) & USART_CR3_OVRDIS) == 0)
+                    {
+                        isr |= USART_ISR_ORE;
+                    }
+                }
+                else
+                {
+                    HOSTSIM_REG(Model, HOSTUSART_RDR) = data;
+                    isr |= USART_ISR_RXNE;
+                }
+                state->IdleTimer = HostUsart_CharTime(Model);
+            }
+        }
+        else if ((state->IdleTimer != 0) && (--state->IdleTimer == 0))
+        {
+            isr |= USART_ISR_IDLE;
+        }
+    }
+
+    if (isr != before)
+    {
+        HOSTSIM_REG(Model, HOSTUSART_ISR) = isr;
+        HostUsart_UpdateIrq(Model);
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Puts characters on the receive line of a USART.
+  */
+void HostUsart_Receive(USART_TypeDef* USARTx, const uint8_t* Data, uint32_t Length)
+{
+    HostUsart_StateTypeDef* state = (HostUsart_StateTypeDef*)HostUsart_Find(USARTx)->Context;
+
+    while (Length-- != 0)
+    {
+        HostUsart_QueuePut(&state->Rx, *Data++);
+    }
+}
+
+/**
+  * @brief  Takes the characters sent by a USART since the last call.
+  * @retval Number of characters copied to Data, Size at most.
+  */
+uint32_t HostUsart_Transmitted(USART_TypeDef* USARTx, uint8_t* Data, uint32_t Size)
+{
+    HostUsart_StateTypeDef* state = (HostUsart_StateTypeDef*)HostUsart_Find(USARTx)->Context;
+    uint32_t count = 0;
+
+    while ((count < Size) && (HostUsart_QueueCount(&state->Tx) != 0))
+    {
+        Data[count++] = HostUsart_QueueGet(&state->Tx);
+    }
+    return count;
+}
+
+/**
+  * @brief  Returns the number of characters still to be received.
+  */
+uint32_t HostUsart_RxPending(USART_TypeDef* USARTx)
+{
+    return HostUsart_QueueCount(&((HostUsart_StateTypeDef*)HostUsart_Find(USARTx)->Context)->Rx);
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,51 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  model_usb.c
+* @brief:     USB packet memory area model: 256 half-words, each one in the
+*             low half of a 32 bits slot as the CPU sees the PMA.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "host_models.h"
+
+/** @addtogroup HostSim
+  * @{
+  */
+
+/* Private define ------------------------------------------------------------*/
+#define HOSTUSB_PMA_BASE            0x40006000UL
+#define HOSTUSB_PMA_SIZE            0x400U
+
+/* Private function prototypes -----------------------------------------------*/
+static void HostUsb_PmaWrite(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous);
+
+HostSim_ModelTypeDef HostUsb_PmaModel =
+{
+    "USB PMA", HOSTUSB_PMA_BASE, HOSTUSB_PMA_SIZE, NULL, NULL, HostUsb_PmaWrite, NULL, NULL,
+    NULL, 0, NULL
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  The upper half of a slot is not memory: it reads as 0 and the
+  *         bytes written to it are lost.
+  */
+static void HostUsb_PmaWrite(HostSim_ModelTypeDef* Model, uint32_t Offset, uint32_t Width, uint32_t Value, uint32_t Previous)
+{
+    (void)Width;
+    (void)Value;
+    (void)Previous;
+
+    HOSTSIM_REG(Model, Offset & ~3U) &= 0xFFFFU;
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
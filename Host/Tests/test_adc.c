@@ -0,0 +1,403 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_adc.c
+* @brief:     ADC continuous acquisition on the ADC and DMA models: blocks
+*             de-interleaved and aligned on the scans, late delivery, restart
+*             after an overrun, buffers beyond the DMA counter. Calibration context against the floating
+*             point formulas of ADC_GETVDDA() and ADC_GetTemperature().
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hk32l0xx.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_BLOCK_LENGTH           4U
+#define TEST_NB_CHANNELS            3U
+#define TEST_MAX_BLOCKS             8U
+#define TEST_SCAN_CYCLES            (TEST_NB_CHANNELS * 4U * HOSTADC_CONVERSION_CYCLES + 100U)
+#define TEST_CALIB_SETS             2000U
+#define TEST_MV_TOLERANCE           0.6         /*!< Rounding of MvScale and of the result */
+#define TEST_CENTIDEGREE_TOLERANCE  3.0         /*!< For calibration deltas of 100 LSB or more */
+
+/* Private variables ---------------------------------------------------------*/
+static uint16_t Buffer[2 * TEST_BLOCK_LENGTH * TEST_NB_CHANNELS];
+static uint16_t Output[TEST_BLOCK_LENGTH * TEST_NB_CHANNELS];
+static uint16_t Delivered[TEST_MAX_BLOCKS][TEST_BLOCK_LENGTH * TEST_NB_CHANNELS];
+static ADC_StreamTypeDef Stream;
+static uint32_t Seed;
+static uint16_t Raw[256];
+static uint16_t Millivolts[256];
+static int16_t CentiDegrees[256];
+
+/* Private functions ---------------------------------------------------------*/
+static void StoreBlock(ADC_StreamTypeDef* Acquisition, const uint16_t* Block)
+{
+    if (Acquisition->Blocks <= TEST_MAX_BLOCKS)
+    {
+        memcpy(Delivered[Acquisition->Blocks - 1], Block, sizeof(Delivered[0]));
+    }
+}
+
+void DMA_CH1_IRQHandler(void)
+{
+    ADC_StreamIRQHandler(ADC, &Stream);
+}
+
+void ADC_COMP_IRQHandler(void)
+{
+    ADC_StreamIRQHandler(ADC, &Stream);
+}
+
+static void InitStream(void)
+{
+    NVIC_InitTypeDef nvic;
+    uint32_t calibrations = HostAdc_Calibrations();
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA, ENABLE);
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_ADC, ENABLE);
+    memset(Delivered, 0, sizeof(Delivered));
+
+    /* Channel 0, Vrefint and temperature sensor, oversampled 4 times */
+    memset(&Stream, 0, sizeof(Stream));
+    Stream.ADC_Channels = ADC_Channel_0 | ADC_Channel_Vrefint | ADC_Channel_TempSensor;
+    Stream.ADC_SampleTime = ADC_SampleTime_1_5Cycles;
+    Stream.ADC_ExternalTrigConv = ADC_ExternalTrigConv_T1_TRGO;
+    Stream.ADC_ExternalTrigConvEdge = ADC_ExternalTrigConvEdge_Rising;
+    Stream.ADC_OverSamplingRatio = ADC_OVS_RATIO_4;
+    Stream.ADC_OverSamplingShift = ADC_OVS_SHIFT_RIGHT_2;
+    Stream.DMA_Channel = DMA_Channel1;
+    Stream.Buffer = Buffer;
+    Stream.BlockLength = TEST_BLOCK_LENGTH;
+    Stream.Output = Output;
+    Stream.BlockCallback = StoreBlock;
+    CHECK_EQUAL(SUCCESS, ADC_StreamInit(ADC, &Stream));
+    CHECK_EQUAL(calibrations + 1, HostAdc_Calibrations());
+    CHECK((ADC->CFGR1 & ADC_CFGR1_DMAEN) != 0);
+
+    nvic.NVIC_IRQChannel = DMA_CH1_IRQn;
+    nvic.NVIC_IRQChannelPriority = 0;
+    nvic.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&nvic);
+    nvic.NVIC_IRQChannel = ADC_COMP1_2_IRQn;
+    NVIC_Init(&nvic);
+
+    ADC_StreamStart(ADC, &Stream);
+}
+
+/**
+  * @brief  One trigger: the inputs of the channels carry the scan number.
+  */
+static void Scan(uint32_t Number)
+{
+    HostAdc_SetInput(0, (uint16_t)(0x100 + Number));
+    HostAdc_SetInput(17, (uint16_t)(0x500 + Number));
+    HostAdc_SetInput(18, (uint16_t)(0x900 + Number));
+    HostAdc_Trigger();
+    HostSim_Run(TEST_SCAN_CYCLES);
+}
+
+static uint32_t Random(void)
+{
+    Seed = Seed * 1103515245UL + 12345UL;
+    return Seed >> 16;
+}
+
+/**
+  * @brief  Writes the factory calibration words in the system memory.
+  */
+static void SetCalibration(uint16_t Temp25, uint16_t Temp85, uint16_t VrefintCal, uint16_t FTRaw, uint16_t FTData)
+{
+    *(uint16_t*)HostSim_Backdoor((uint32_t)TEMP25_CAL_ADDR) = Temp25;
+    *(uint16_t*)HostSim_Backdoor((uint32_t)TEMP85_CAL_ADDR) = Temp85;
+    *(uint16_t*)HostSim_Backdoor((uint32_t)VREFINT_CAL_ADDR) = VrefintCal;
+    *(uint32_t*)HostSim_Backdoor(TEMPS_CAL_ADDR) = FTRaw | ((uint32_t)FTData << 16);
+}
+
+/**
+  * @brief  FT test temperature of the calibration words, 0.01 degrees Celsius.
+  */
+static double FTTemperature(uint16_t FTData)
+{
+    return (FTData <= 0x7FF) ? (6.25 * FTData) : (-6.25 * (0x1FFF - FTData));
+}
+
+/**
+  * @brief  Checks a delivered block of the scans First to First + BlockLength - 1.
+  */
+static void CheckBlock(uint32_t Block, uint32_t First)
+{
+    uint32_t i;
+
+    for (i = 0; i < TEST_BLOCK_LENGTH; i++)
+    {
+        CHECK_EQUAL(0x100 + First + i, Delivered[Block][i]);
+        CHECK_EQUAL(0x500 + First + i, Delivered[Block][TEST_BLOCK_LENGTH + i]);
+        CHECK_EQUAL(0x900 + First + i, Delivered[Block][2 * TEST_BLOCK_LENGTH + i]);
+    }
+}
+
+static void Test_Stream(void)
+{
+    uint32_t conversions;
+    uint32_t n;
+
+    InitStream();
+    conversions = HostAdc_Conversions();
+    CHECK_EQUAL(1, ADC_StreamGetIndex(&Stream, ADC_Channel_Vrefint));
+
+    /* No conversion before the trigger */
+    HostSim_Run(TEST_SCAN_CYCLES);
+    CHECK_EQUAL(conversions, HostAdc_Conversions());
+
+    for (n = 0; n < 3 * TEST_BLOCK_LENGTH; n++)
+    {
+        Scan(n);
+    }
+    CHECK_EQUAL(conversions + 3 * TEST_BLOCK_LENGTH * TEST_NB_CHANNELS, HostAdc_Conversions());
+    CHECK_EQUAL(3, Stream.Blocks);
+    CHECK_EQUAL(0, Stream.Lost);
+    CHECK_EQUAL(0, Stream.Overruns);
+    CheckBlock(0, 0);
+    CheckBlock(1, TEST_BLOCK_LENGTH);
+    CheckBlock(2, 2 * TEST_BLOCK_LENGTH);
+
+    /* Stopped: the triggers are ignored, a start begins a new buffer */
+    ADC_StreamStop(ADC, &Stream);
+    Scan(0x80);
+    CHECK_EQUAL(3, Stream.Blocks);
+    ADC_StreamStart(ADC, &Stream);
+    for (n = 0; n < TEST_BLOCK_LENGTH; n++)
+    {
+        Scan(0x40 + n);
+    }
+    CHECK_EQUAL(4, Stream.Blocks);
+    CheckBlock(3, 0x40);
+}
+
+static void Test_Late(void)
+{
+    uint32_t n;
+
+    InitStream();
+
+    /* Both halves complete before the interrupt: the first one is lost */
+    NVIC_DisableIRQ(DMA_CH1_IRQn);
+    for (n = 0; n < 2 * TEST_BLOCK_LENGTH; n++)
+    {
+        Scan(n);
+    }
+    CHECK_EQUAL(0, Stream.Blocks);
+    NVIC_EnableIRQ(DMA_CH1_IRQn);
+    HostSim_Run(10);
+    CHECK_EQUAL(1, Stream.Blocks);
+    CHECK_EQUAL(1, Stream.Lost);
+    CheckBlock(0, TEST_BLOCK_LENGTH);
+
+    for (n = 2 * TEST_BLOCK_LENGTH; n < 3 * TEST_BLOCK_LENGTH; n++)
+    {
+        Scan(n);
+    }
+    CHECK_EQUAL(2, Stream.Blocks);
+    CheckBlock(1, 2 * TEST_BLOCK_LENGTH);
+}
+
+static void Test_Overrun(void)
+{
+    volatile uint32_t* chcr;
+    uint32_t n;
+
+    InitStream();
+    chcr = (volatile uint32_t*)HostSim_Backdoor((uint32_t)&DMA_Channel1->CHCR);
+
+    Scan(0);
+    Scan(1);
+
+    /* The DMA misses a conversion: OVR stops the ADC and its DMA requests */
+    *chcr &= ~DMA_Channel_CHCR_EN;
+    Scan(2);
+    *chcr |= DMA_Channel_CHCR_EN;
+    HostSim_Run(TEST_SCAN_CYCLES);
+    CHECK_EQUAL(1, Stream.Overruns);
+    CHECK(ADC_GetFlagStatus(ADC, ADC_FLAG_OVR) == RESET);
+    CHECK((ADC->CR & ADC_CR_ADSTART) != 0);
+    CHECK_EQUAL(0, Stream.Blocks);
+
+    /* Started again at the beginning of the buffer, aligned on the scans */
+    for (n = 3; n < 3 + 2 * TEST_BLOCK_LENGTH; n++)
+    {
+        Scan(n);
+    }
+    CHECK_EQUAL(2, Stream.Blocks);
+    CHECK_EQUAL(0, Stream.Lost);
+    CHECK_EQUAL(1, Stream.Overruns);
+    CheckBlock(0, 3);
+    CheckBlock(1, 3 + TEST_BLOCK_LENGTH);
+}
+
+/**
+  * @brief  Two blocks of all the channels beyond the 16 bits DMA counter,
+  *         or nothing to acquire: ERROR, the ADC and the DMA untouched.
+  */
+static void Test_StreamLength(void)
+{
+    uint32_t calibrations = HostAdc_Calibrations();
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA, ENABLE);
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_ADC, ENABLE);
+
+    memset(&Stream, 0, sizeof(Stream));
+    Stream.ADC_Channels = ADC_Channel_0 | ADC_Channel_Vrefint | ADC_Channel_TempSensor;
+    Stream.ADC_SampleTime = ADC_SampleTime_1_5Cycles;
+    Stream.ADC_ExternalTrigConv = ADC_ExternalTrigConv_T1_TRGO;
+    Stream.ADC_ExternalTrigConvEdge = ADC_ExternalTrigConvEdge_Rising;
+    Stream.DMA_Channel = DMA_Channel1;
+    Stream.Buffer = Buffer;
+    Stream.Output = Output;
+
+    /* 2 x 10923 x 3 = 65538 half words */
+    Stream.BlockLength = 10923;
+    CHECK_EQUAL(ERROR, ADC_StreamInit(ADC, &Stream));
+
+    /* One channel: 2 x 0x8000 */
+    Stream.ADC_Channels = ADC_Channel_0;
+    Stream.BlockLength = 0x8000;
+    CHECK_EQUAL(ERROR, ADC_StreamInit(ADC, &Stream));
+
+    Stream.BlockLength = 0;
+    CHECK_EQUAL(ERROR, ADC_StreamInit(ADC, &Stream));
+
+    Stream.ADC_Channels = 0;
+    Stream.BlockLength = TEST_BLOCK_LENGTH;
+    CHECK_EQUAL(ERROR, ADC_StreamInit(ADC, &Stream));
+
+    CHECK_EQUAL(calibrations, HostAdc_Calibrations());
+    CHECK_EQUAL(0, ADC->CFGR1);
+    CHECK_EQUAL(0, DMA_Channel1->CHCR);
+}
+
+static void Test_CalibConversions(void)
+{
+    ADC_CalibTypeDef calib;
+    uint32_t set;
+    uint32_t i;
+    int32_t delta;
+    uint16_t temp25;
+    uint16_t vrefintCal;
+    uint16_t ftRaw;
+    uint16_t ftData;
+    uint32_t vrefint;
+    double vdda;
+    double expected;
+    double error;
+    double maxMv = 0;
+    double maxCentiDegrees = 0;
+
+    Seed = 1;
+
+    for (set = 0; set < TEST_CALIB_SETS; set++)
+    {
+        temp25 = (uint16_t)(1000 + Random() % 1500);
+        delta = (int32_t)(100 + Random() % 400);
+        delta = ((Random() & 1) != 0) ? delta : -delta;
+        vrefintCal = (uint16_t)(1300 + Random() % 500);
+        ftRaw = (uint16_t)(500 + Random() % 3000);
+        ftData = (uint16_t)(((set % 4) == 0) ? (0x190 + Random() % 32) : (Random() % 0x2000));
+        SetCalibration(temp25, (uint16_t)(temp25 + delta), vrefintCal, ftRaw, ftData);
+
+        /* VDDA from 1.8 V to 3.6 V */
+        vrefint = (vrefintCal * 3300UL) / (1800 + Random() % 1800);
+        CHECK_EQUAL(SUCCESS, ADC_CalibInit(&calib, vrefint));
+
+        vdda = 3300.0 * vrefintCal / vrefint;
+        CHECK(fabs(vdda - calib.Vdda) <= 0.5);
+        CHECK(abs((int)ADC_GETVDDA(vrefint) - (int)calib.Vdda) <= 1);
+
+        for (i = 0; i < 64; i++)
+        {
+            Raw[i] = (uint16_t)(Random() & 0xFFF);
+        }
+        ADC_CalibBufferToMillivolts(&calib, Raw, Millivolts, 64);
+        ADC_CalibBufferToCentiDegrees(&calib, Raw, CentiDegrees, 64);
+
+        for (i = 0; i < 64; i++)
+        {
+            error = fabs((Raw[i] * (double)calib.Vdda / 4095.0) - Millivolts[i]);
+            maxMv = (error > maxMv) ? error : maxMv;
+            CHECK_EQUAL(Millivolts[i], ADC_CalibToMillivolts(&calib, Raw[i]));
+
+            /* ADC_GetTemperature() in 0.01 degrees, without its truncations */
+            expected = (6000.0 / delta) * ((Raw[i] * (double)calib.Vdda / 3300.0) - ftRaw) + FTTemperature(ftData);
+            if (fabs(expected) < 30000.0)
+            {
+                error = fabs(expected - CentiDegrees[i]);
+                maxCentiDegrees = (error > maxCentiDegrees) ? error : maxCentiDegrees;
+                CHECK_EQUAL(CentiDegrees[i], ADC_CalibToCentiDegrees(&calib, Raw[i]));
+            }
+        }
+    }
+
+    CHECK(maxMv <= TEST_MV_TOLERANCE);
+    CHECK(maxCentiDegrees <= TEST_CENTIDEGREE_TOLERANCE);
+}
+
+static void Test_CalibUpdateVdda(void)
+{
+    ADC_CalibTypeDef calib;
+    uint16_t vrefint[64];
+    uint32_t sum = 0;
+    uint32_t vdda;
+    uint32_t i;
+
+    Seed = 2;
+    SetCalibration(1700, 1400, 1650, 1750, 0x190);
+    CHECK_EQUAL(SUCCESS, ADC_CalibInit(&calib, 1650));
+    CHECK_EQUAL(3300, calib.Vdda);
+    CHECK_EQUAL(ADC_GETVDDA(1650), calib.Vdda);
+
+    /* VDDA down to 2.5 V, noisy conversions: the mean gives VDDA */
+    for (i = 0; i < 64; i++)
+    {
+        vrefint[i] = (uint16_t)(2178 - 8 + Random() % 17);
+        sum += vrefint[i];
+    }
+    CHECK_EQUAL(SUCCESS, ADC_CalibUpdateVdda(&calib, vrefint, 64));
+    CHECK(fabs((3300.0 * 1650 * 64 / sum) - calib.Vdda) <= 0.5);
+    CHECK(fabs((2048.0 * calib.Vdda / 4095.0) - ADC_CalibToMillivolts(&calib, 2048)) <= 0.5);
+
+    /* Below half of VREFINT_CAL, VDDA would be above 6.6 V: unchanged */
+    vdda = calib.Vdda;
+    vrefint[0] = 800;
+    CHECK_EQUAL(ERROR, ADC_CalibUpdateVdda(&calib, vrefint, 1));
+    CHECK_EQUAL(vdda, calib.Vdda);
+
+    /* Erased calibration words */
+    SetCalibration(0xFFFF, 1400, 1650, 1750, 0x190);
+    CHECK_EQUAL(ERROR, ADC_CalibInit(&calib, 1650));
+    SetCalibration(1700, 1400, 0xFFFF, 1750, 0x190);
+    CHECK_EQUAL(ERROR, ADC_CalibInit(&calib, 1650));
+    SetCalibration(1700, 1700, 1650, 1750, 0x190);
+    CHECK_EQUAL(ERROR, ADC_CalibInit(&calib, 1650));
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    HOSTTEST_RUN(Test_Stream);
+    HOSTTEST_RUN(Test_Late);
+    HOSTTEST_RUN(Test_Overrun);
+    HOSTTEST_RUN(Test_StreamLength);
+    HOSTTEST_RUN(Test_CalibConversions);
+    HOSTTEST_RUN(Test_CalibUpdateVdda);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
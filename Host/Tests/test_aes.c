@@ -0,0 +1,520 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_aes.c
+* @brief:     AES driver on the AES and DMA models: FIPS-197 and NIST
+*             SP 800-38A/B/C known answers of the chaining modes, AES core
+*             and chaining modes against the AES_Model functions, CPU and DMA
+*             feeds, cycle count per block and per kilobyte of each mode.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "hk32l0xx.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_BLOCKS                 64U
+#define RANDOM_CASES                300U
+#define BENCH_SIZE                  1024U
+
+/* Ways the blocks are computed */
+#define ENGINE_CPU                  0U
+#define ENGINE_DMA                  1U
+#define ENGINE_MODEL                2U
+#define ENGINE_COUNT                3U
+
+/* Private variables ---------------------------------------------------------*/
+/* FIPS-197 appendix C */
+static const uint8_t Key256[32] =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+static const uint8_t Plain[16] __attribute__((aligned(4))) =
+{
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+};
+static const uint8_t Cipher128[16] =
+{
+    0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+};
+static const uint8_t Cipher192[16] =
+{
+    0xdd, 0xa9, 0x7c, 0xa4, 0x86, 0x4c, 0xdf, 0xe0, 0x6e, 0xaf, 0x70, 0xa0, 0xec, 0x0d, 0x71, 0x91
+};
+static const uint8_t Cipher256[16] =
+{
+    0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf, 0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89
+};
+
+/* NIST SP 800-38A F.2 and F.5, message of the SP 800-38B examples */
+static const uint8_t ModeKey128[16] =
+{
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+static const uint8_t ModeKey256[32] =
+{
+    0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+    0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4
+};
+static const uint8_t ModePlain[64] __attribute__((aligned(4))) =
+{
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+    0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+    0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+    0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10
+};
+static const uint8_t CbcIv[16] =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+static const uint8_t CtrCounter[16] =
+{
+    0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
+};
+static const uint8_t CbcCipher[2][64] =
+{
+    {
+        0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e, 0x9b, 0x12, 0xe9, 0x19, 0x7d,
+        0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2,
+        0x73, 0xbe, 0xd6, 0xb8, 0xe3, 0xc1, 0x74, 0x3b, 0x71, 0x16, 0xe6, 0x9e, 0x22, 0x22, 0x95, 0x16,
+        0x3f, 0xf1, 0xca, 0xa1, 0x68, 0x1f, 0xac, 0x09, 0x12, 0x0e, 0xca, 0x30, 0x75, 0x86, 0xe1, 0xa7
+    },
+    {
+        0xf5, 0x8c, 0x4c, 0x04, 0xd6, 0xe5, 0xf1, 0xba, 0x77, 0x9e, 0xab, 0xfb, 0x5f, 0x7b, 0xfb, 0xd6,
+        0x9c, 0xfc, 0x4e, 0x96, 0x7e, 0xdb, 0x80, 0x8d, 0x67, 0x9f, 0x77, 0x7b, 0xc6, 0x70, 0x2c, 0x7d,
+        0x39, 0xf2, 0x33, 0x69, 0xa9, 0xd9, 0xba, 0xcf, 0xa5, 0x30, 0xe2, 0x63, 0x04, 0x23, 0x14, 0x61,
+        0xb2, 0xeb, 0x05, 0xe2, 0xc3, 0x9b, 0xe9, 0xfc, 0xda, 0x6c, 0x19, 0x07, 0x8c, 0x6a, 0x9d, 0x1b
+    }
+};
+static const uint8_t CtrCipher[2][64] =
+{
+    {
+        0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26, 0x1b, 0xef, 0x68, 0x64, 0x99, 0x0d, 0xb6, 0xce,
+        0x98, 0x06, 0xf6, 0x6b, 0x79, 0x70, 0xfd, 0xff, 0x86, 0x17, 0x18, 0x7b, 0xb9, 0xff, 0xfd, 0xff,
+        0x5a, 0xe4, 0xdf, 0x3e, 0xdb, 0xd5, 0xd3, 0x5e, 0x5b, 0x4f, 0x09, 0x02, 0x0d, 0xb0, 0x3e, 0xab,
+        0x1e, 0x03, 0x1d, 0xda, 0x2f, 0xbe, 0x03, 0xd1, 0x79, 0x21, 0x70, 0xa0, 0xf3, 0x00, 0x9c, 0xee
+    },
+    {
+        0x60, 0x1e, 0xc3, 0x13, 0x77, 0x57, 0x89, 0xa5, 0xb7, 0xa7, 0xf5, 0x04, 0xbb, 0xf3, 0xd2, 0x28,
+        0xf4, 0x43, 0xe3, 0xca, 0x4d, 0x62, 0xb5, 0x9a, 0xca, 0x84, 0xe9, 0x90, 0xca, 0xca, 0xf5, 0xc5,
+        0x2b, 0x09, 0x30, 0xda, 0xa2, 0x3d, 0xe9, 0x4c, 0xe8, 0x70, 0x17, 0xba, 0x2d, 0x84, 0x98, 0x8d,
+        0xdf, 0xc9, 0xc5, 0x8d, 0xb6, 0x7a, 0xad, 0xa6, 0x13, 0xc2, 0xdd, 0x08, 0x45, 0x79, 0x41, 0xa6
+    }
+};
+
+/* SP 800-38B D.1 and D.3: messages of 0, 16, 40 and 64 bytes */
+static const uint32_t CmacLength[4] = {0, 16, 40, 64};
+static const uint8_t Cmac[2][4][16] =
+{
+    {
+        {0xbb, 0x1d, 0x69, 0x29, 0xe9, 0x59, 0x37, 0x28, 0x7f, 0xa3, 0x7d, 0x12, 0x9b, 0x75, 0x67, 0x46},
+        {0x07, 0x0a, 0x16, 0xb4, 0x6b, 0x4d, 0x41, 0x44, 0xf7, 0x9b, 0xdd, 0x9d, 0xd0, 0x4a, 0x28, 0x7c},
+        {0xdf, 0xa6, 0x67, 0x47, 0xde, 0x9a, 0xe6, 0x30, 0x30, 0xca, 0x32, 0x61, 0x14, 0x97, 0xc8, 0x27},
+        {0x51, 0xf0, 0xbe, 0xbf, 0x7e, 0x3b, 0x9d, 0x92, 0xfc, 0x49, 0x74, 0x17, 0x79, 0x36, 0x3c, 0xfe}
+    },
+    {
+        {0x02, 0x89, 0x62, 0xf6, 0x1b, 0x7b, 0xf8, 0x9e, 0xfc, 0x6b, 0x55, 0x1f, 0x46, 0x67, 0xd9, 0x83},
+        {0x28, 0xa7, 0x02, 0x3f, 0x45, 0x2e, 0x8f, 0x82, 0xbd, 0x4b, 0xf2, 0x8d, 0x8c, 0x37, 0xc3, 0x5c},
+        {0xaa, 0xf3, 0xd8, 0xf1, 0xde, 0x56, 0x40, 0xc2, 0x32, 0xf5, 0xb1, 0x69, 0xb9, 0xc9, 0x11, 0xe6},
+        {0xe1, 0x99, 0x21, 0x90, 0x54, 0x9f, 0x6e, 0xd5, 0x69, 0x6a, 0x2c, 0x05, 0x6c, 0x31, 0x54, 0x10}
+    }
+};
+
+/* SP 800-38C C.1 to C.3: the nonce, associated data and payload are the first
+   bytes of 10 11 12..., 00 01 02... and 20 21 22... */
+static const uint8_t CcmKey[16] =
+{
+    0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f
+};
+static const struct
+{
+    uint32_t NonceSize;
+    uint32_t ADataLength;
+    uint32_t Length;
+    uint32_t TagSize;
+    uint8_t Cipher[24];
+    uint8_t Tag[8];
+} CcmVectors[3] =
+{
+    {7, 8, 4, 4, {0x71, 0x62, 0x01, 0x5b}, {0x4d, 0xac, 0x25, 0x5d}},
+    {
+        8, 16, 16, 6,
+        {0xd2, 0xa1, 0xf0, 0xe0, 0x51, 0xea, 0x5f, 0x62, 0x08, 0x1a, 0x77, 0x92, 0x07, 0x3d, 0x59, 0x3d},
+        {0x1f, 0xc6, 0x4f, 0xbf, 0xac, 0xcd}
+    },
+    {
+        12, 20, 24, 8,
+        {0xe3, 0xb2, 0x01, 0xa9, 0xf5, 0xb7, 0x1a, 0x7a, 0x9b, 0x1c, 0xea, 0xec, 0xcd, 0x97, 0xe7, 0x0b,
+         0x61, 0x76, 0xaa, 0xd9, 0xa4, 0x42, 0x8a, 0xa5},
+        {0x48, 0x43, 0x92, 0xfb, 0xc1, 0xb0, 0x99, 0x51}
+    }
+};
+
+static uint32_t Input[TEST_BLOCKS * 4];
+static uint32_t Output[TEST_BLOCKS * 4];
+static uint32_t Expected[TEST_BLOCKS * 4];
+
+/* AES_KeyInit() and the DMA take 32-bit addresses: no locals */
+static AES_ContextTypeDef Context;
+static AES_ModelTypeDef Model;
+static AES_ContextTypeDef Reference;
+static AES_ModelTypeDef ReferenceModel;
+static uint8_t Block[16] __attribute__((aligned(4)));
+static uint8_t Key[32];
+static uint8_t Iv[16];
+static uint8_t ReferenceIv[16];
+static uint8_t FirstIv[16];
+static uint8_t Nonce[16];
+static uint8_t AData[64];
+static uint8_t Tag[2][16];
+static uint32_t Seed;
+
+/* Private functions ---------------------------------------------------------*/
+static void InitContext(const uint8_t* Key, uint32_t KeySize, uint8_t Dma, AES_ModelTypeDef* SoftModel)
+{
+    memset(&Context, 0, sizeof(Context));
+    Context.Model = SoftModel;
+    if (Dma != 0)
+    {
+        RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA, ENABLE);
+        DMA_RemapConfig(DMA, DMA_CSELR_CH1_AES_IN);
+        DMA_RemapConfig(DMA, DMA_CSELR_CH2_AES_OUT);
+        Context.DMAIn_Channelx = DMA_Channel1;
+        Context.DMAOut_Channelx = DMA_Channel2;
+    }
+    AES_ModeInit(&Context, Key, KeySize);
+}
+
+static void InitEngine(const uint8_t* Key, uint32_t KeySize, uint32_t Engine)
+{
+    InitContext(Key, KeySize, (uint8_t)(Engine == ENGINE_DMA), (Engine == ENGINE_MODEL) ? &Model : NULL);
+}
+
+static uint32_t Random(void)
+{
+    Seed = Seed * 1103515245UL + 12345UL;
+    return Seed >> 16;
+}
+
+static void FillRandom(uint8_t* Data, uint32_t Length)
+{
+    while (Length-- != 0)
+    {
+        *Data++ = (uint8_t)Random();
+    }
+}
+
+static void Test_KnownAnswers(void)
+{
+    static const uint8_t* const ciphers[3] = {Cipher128, Cipher192, Cipher256};
+    uint32_t size;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRYPT, ENABLE);
+
+    for (size = AES_KEYSIZE_128B; size <= AES_KEYSIZE_256B; size++)
+    {
+        InitContext(Key256, size, 0, NULL);
+        CHECK_EQUAL(SUCCESS, AES_ECBCrypt(&Context, AES_Operation_Encryp, Plain, 16, Block));
+        CHECK_MEMORY(ciphers[size], Block, 16);
+        CHECK_EQUAL(SUCCESS, AES_ECBCrypt(&Context, AES_Operation_Decryp, Block, 16, Block));
+        CHECK_MEMORY(Plain, Block, 16);
+
+        AES_ModelKeyInit(&Model, Key256, size);
+        AES_ModelEncrypt(&Model, Plain, Block);
+        CHECK_MEMORY(ciphers[size], Block, 16);
+        AES_ModelDecrypt(&Model, Block, Block);
+        CHECK_MEMORY(Plain, Block, 16);
+    }
+}
+
+static void Test_CoreMatchesModel(void)
+{
+    uint32_t size;
+    uint8_t dma;
+    uint32_t i;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRYPT, ENABLE);
+    for (i = 0; i < TEST_BLOCKS * 4U; i++)
+    {
+        Input[i] = i * 0x01000193UL + 0x811C9DC5UL;
+    }
+
+    for (size = AES_KEYSIZE_128B; size <= AES_KEYSIZE_256B; size++)
+    {
+        InitContext(Key256, size, 0, &Model);
+        AES_ECBCrypt(&Context, AES_Operation_Encryp, (const uint8_t*)Input, sizeof(Input), (uint8_t*)Expected);
+
+        for (dma = 0; dma < 2; dma++)
+        {
+            InitContext(Key256, size, dma, NULL);
+            memset(Output, 0, sizeof(Output));
+            CHECK_EQUAL(SUCCESS, AES_ECBCrypt(&Context, AES_Operation_Encryp, (const uint8_t*)Input, sizeof(Input),
+                                              (uint8_t*)Output));
+            CHECK_MEMORY(Expected, Output, sizeof(Output));
+
+            CHECK_EQUAL(SUCCESS, AES_ECBCrypt(&Context, AES_Operation_Decryp, (const uint8_t*)Output, sizeof(Output),
+                                              (uint8_t*)Output));
+            CHECK_MEMORY(Input, Output, sizeof(Output));
+        }
+    }
+}
+
+/**
+  * @brief  NIST examples of CBC, CTR and CMAC with 128 and 256 bits keys, and
+  *         of CCM, with each engine. The IV and the counter are carried
+  *         across two calls.
+  */
+static void Test_ModeKnownAnswers(void)
+{
+    static const uint8_t* const keys[2] = {ModeKey128, ModeKey256};
+    static const uint32_t sizes[2] = {AES_KEYSIZE_128B, AES_KEYSIZE_256B};
+    uint8_t* buffer = (uint8_t*)Output;
+    uint8_t* plain = (uint8_t*)Input;
+    uint32_t engine;
+    uint32_t k;
+    uint32_t i;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRYPT, ENABLE);
+
+    for (engine = 0; engine < ENGINE_COUNT; engine++)
+    {
+        for (k = 0; k < 2U; k++)
+        {
+            InitEngine(keys[k], sizes[k], engine);
+
+            /* CBC, in place */
+            memcpy(buffer, ModePlain, sizeof(ModePlain));
+            memcpy(Iv, CbcIv, sizeof(Iv));
+            CHECK_EQUAL(SUCCESS, AES_CBCEncrypt(&Context, Iv, buffer, 32, buffer));
+            CHECK_EQUAL(SUCCESS, AES_CBCEncrypt(&Context, Iv, buffer + 32, 32, buffer + 32));
+            CHECK_MEMORY(CbcCipher[k], buffer, 64);
+            CHECK_MEMORY(CbcCipher[k] + 48, Iv, 16);
+
+            memcpy(Iv, CbcIv, sizeof(Iv));
+            CHECK_EQUAL(SUCCESS, AES_CBCDecrypt(&Context, Iv, buffer, 64, buffer));
+            CHECK_MEMORY(ModePlain, buffer, 64);
+
+            /* CTR, unaligned output */
+            memcpy(Iv, CtrCounter, sizeof(Iv));
+            CHECK_EQUAL(SUCCESS, AES_CTRCrypt(&Context, Iv, ModePlain, 16, buffer + 1));
+            CHECK_EQUAL(SUCCESS, AES_CTRCrypt(&Context, Iv, ModePlain + 16, 48, buffer + 17));
+            CHECK_MEMORY(CtrCipher[k], buffer + 1, 64);
+
+            /* CMAC, empty, one block, partial last block, whole blocks */
+            for (i = 0; i < 4U; i++)
+            {
+                memset(Tag[0], 0, sizeof(Tag[0]));
+                CHECK_EQUAL(SUCCESS, AES_CMACCompute(&Context, ModePlain, CmacLength[i], Tag[0]));
+                CHECK_MEMORY(Cmac[k][i], Tag[0], 16);
+            }
+        }
+
+        /* CCM, then a forged tag is rejected and the output cleared */
+        InitEngine(CcmKey, AES_KEYSIZE_128B, engine);
+        for (i = 0; i < 24U; i++)
+        {
+            Nonce[i % 16U] = (uint8_t)(0x10U + i % 16U);
+            AData[i] = (uint8_t)i;
+            plain[i] = (uint8_t)(0x20U + i);
+        }
+
+        for (i = 0; i < 3U; i++)
+        {
+            CHECK_EQUAL(SUCCESS, AES_CCMEncrypt(&Context, Nonce, CcmVectors[i].NonceSize, AData,
+                                                CcmVectors[i].ADataLength, plain, CcmVectors[i].Length,
+                                                buffer, Tag[0], CcmVectors[i].TagSize));
+            CHECK_MEMORY(CcmVectors[i].Cipher, buffer, CcmVectors[i].Length);
+            CHECK_MEMORY(CcmVectors[i].Tag, Tag[0], CcmVectors[i].TagSize);
+
+            CHECK_EQUAL(SUCCESS, AES_CCMDecrypt(&Context, Nonce, CcmVectors[i].NonceSize, AData,
+                                                CcmVectors[i].ADataLength, buffer, CcmVectors[i].Length,
+                                                buffer, Tag[0], CcmVectors[i].TagSize));
+            CHECK_MEMORY(plain, buffer, CcmVectors[i].Length);
+
+            Tag[0][CcmVectors[i].TagSize - 1U] ^= 0x80U;
+            CHECK_EQUAL(ERROR, AES_CCMDecrypt(&Context, Nonce, CcmVectors[i].NonceSize, AData,
+                                              CcmVectors[i].ADataLength, CcmVectors[i].Cipher,
+                                              CcmVectors[i].Length, buffer, Tag[0], CcmVectors[i].TagSize));
+            memset(Tag[1], 0, sizeof(Tag[1]));
+            CHECK_MEMORY(Tag[1], buffer, CcmVectors[i].Length < 16U ? CcmVectors[i].Length : 16U);
+        }
+    }
+}
+
+/**
+  * @brief  Random keys, lengths, alignments and CCM sizes: the CPU and DMA
+  *         engines against the software model.
+  */
+static void Test_ModesMatchModel(void)
+{
+    const uint8_t* input;
+    uint8_t* output;
+    uint8_t* expected;
+    uint32_t test;
+    uint32_t size;
+    uint32_t length;
+    uint32_t nonce;
+    uint32_t adata;
+    uint32_t tag;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRYPT, ENABLE);
+    Seed = 1;
+    FillRandom((uint8_t*)Input, sizeof(Input));
+
+    for (test = 0; test < RANDOM_CASES; test++)
+    {
+        size = Random() % 3U;
+        FillRandom(Key, sizeof(Key));
+        InitEngine(Key, size, (test & 1U) ? ENGINE_DMA : ENGINE_CPU);
+        memset(&Reference, 0, sizeof(Reference));
+        Reference.Model = &ReferenceModel;
+        AES_ModeInit(&Reference, Key, size);
+
+        /* CBC: aligned whole blocks, in place one time in four */
+        length = AES_BLOCK_SIZE * (Random() % 12U);
+        output = ((Random() & 3U) == 0) ? (uint8_t*)Expected : (uint8_t*)Output;
+        memcpy(output, Input, length);
+        FillRandom(FirstIv, sizeof(FirstIv));
+        memcpy(Iv, FirstIv, sizeof(Iv));
+        memcpy(ReferenceIv, FirstIv, sizeof(Iv));
+        CHECK_EQUAL(SUCCESS, AES_CBCEncrypt(&Reference, ReferenceIv, (const uint8_t*)Input, length,
+                                            (uint8_t*)Expected + 512));
+        CHECK_EQUAL(SUCCESS, AES_CBCEncrypt(&Context, Iv, output, length, output));
+        CHECK_MEMORY((uint8_t*)Expected + 512, output, length);
+        CHECK_MEMORY(ReferenceIv, Iv, sizeof(Iv));
+
+        memcpy(Iv, FirstIv, sizeof(Iv));
+        CHECK_EQUAL(SUCCESS, AES_CBCDecrypt(&Context, Iv, output, length, output));
+        CHECK_MEMORY(Input, output, length);
+        CHECK_MEMORY(ReferenceIv, Iv, sizeof(Iv));
+
+        /* CTR: any length and alignment, the counter carry crosses words */
+        length = Random() % 200U;
+        input = (const uint8_t*)Input + Random() % 4U;
+        output = (uint8_t*)Output + Random() % 4U;
+        expected = (uint8_t*)Expected + Random() % 4U;
+        FillRandom(Iv, sizeof(Iv));
+        memset(Iv + 16 - 1 - Random() % 6U, 0xFF, Random() % 2U);
+        Iv[15] |= (uint8_t)((Random() & 1U) ? 0xF8U : 0U);
+        memcpy(ReferenceIv, Iv, sizeof(Iv));
+        CHECK_EQUAL(SUCCESS, AES_CTRCrypt(&Reference, ReferenceIv, input, length, expected));
+        CHECK_EQUAL(SUCCESS, AES_CTRCrypt(&Context, Iv, input, length, output));
+        CHECK_MEMORY(expected, output, length);
+        CHECK_MEMORY(ReferenceIv, Iv, sizeof(Iv));
+
+        /* CMAC */
+        length = Random() % 200U;
+        input = (const uint8_t*)Input + Random() % 4U;
+        CHECK_EQUAL(SUCCESS, AES_CMACCompute(&Reference, input, length, Tag[0]));
+        CHECK_EQUAL(SUCCESS, AES_CMACCompute(&Context, input, length, Tag[1]));
+        CHECK_MEMORY(Tag[0], Tag[1], AES_BLOCK_SIZE);
+
+        /* CCM: every nonce and tag size, decrypted in place */
+        nonce = 7U + Random() % 7U;
+        tag = 4U + 2U * (Random() % 7U);
+        adata = Random() % sizeof(AData);
+        length = Random() % 200U;
+        input = (const uint8_t*)Input + Random() % 4U;
+        output = (uint8_t*)Output + Random() % 4U;
+        FillRandom(Nonce, nonce);
+        FillRandom(AData, adata);
+        CHECK_EQUAL(SUCCESS, AES_CCMEncrypt(&Reference, Nonce, nonce, AData, adata, input, length,
+                                            (uint8_t*)Expected, Tag[0], tag));
+        CHECK_EQUAL(SUCCESS, AES_CCMEncrypt(&Context, Nonce, nonce, AData, adata, input, length, output,
+                                            Tag[1], tag));
+        CHECK_MEMORY(Expected, output, length);
+        CHECK_MEMORY(Tag[0], Tag[1], tag);
+        CHECK_EQUAL(SUCCESS, AES_CCMDecrypt(&Context, Nonce, nonce, AData, adata, output, length, output,
+                                            Tag[1], tag));
+        CHECK_MEMORY(input, output, length);
+    }
+}
+
+static void Test_Cycles(void)
+{
+    uint64_t start;
+    uint64_t cpu;
+    uint64_t dma;
+    uint32_t blocks;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRYPT, ENABLE);
+
+    InitContext(Key256, AES_KEYSIZE_128B, 0, NULL);
+    blocks = HostAes_Blocks();
+    start = HostSim_Cycles();
+    AES_ECBCrypt(&Context, AES_Operation_Encryp, (const uint8_t*)Input, sizeof(Input), (uint8_t*)Output);
+    cpu = HostSim_Cycles() - start;
+    CHECK_EQUAL(TEST_BLOCKS, HostAes_Blocks() - blocks);
+
+    InitContext(Key256, AES_KEYSIZE_128B, 1, NULL);
+    start = HostSim_Cycles();
+    AES_ECBCrypt(&Context, AES_Operation_Encryp, (const uint8_t*)Input, sizeof(Input), (uint8_t*)Output);
+    dma = HostSim_Cycles() - start;
+
+    printf("AES-128 ECB %u blocks: CPU %llu bus cycles, DMA %llu bus cycles\n", TEST_BLOCKS,
+           (unsigned long long)cpu, (unsigned long long)dma);
+    CHECK(cpu >= (uint64_t)TEST_BLOCKS * HOSTAES_BLOCK_CYCLES);
+    CHECK(dma >= (uint64_t)TEST_BLOCKS * HOSTAES_BLOCK_CYCLES);
+}
+
+/**
+  * @brief  Cycles of BENCH_SIZE bytes of CTR, CBC decryption and CMAC with a
+  *         128 bits key, as the AES_ChainingModes example measures them.
+  */
+static void Test_ModeCycles(void)
+{
+    uint64_t cycles[2][3];
+    uint64_t start;
+    uint32_t engine;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRYPT, ENABLE);
+
+    for (engine = ENGINE_CPU; engine <= ENGINE_DMA; engine++)
+    {
+        InitEngine(ModeKey128, AES_KEYSIZE_128B, engine);
+        memset(Iv, 0, sizeof(Iv));
+
+        start = HostSim_Cycles();
+        CHECK_EQUAL(SUCCESS, AES_CTRCrypt(&Context, Iv, (const uint8_t*)Input, BENCH_SIZE, (uint8_t*)Output));
+        cycles[engine][0] = HostSim_Cycles() - start;
+
+        start = HostSim_Cycles();
+        CHECK_EQUAL(SUCCESS, AES_CBCDecrypt(&Context, Iv, (const uint8_t*)Output, BENCH_SIZE, (uint8_t*)Output));
+        cycles[engine][1] = HostSim_Cycles() - start;
+
+        start = HostSim_Cycles();
+        CHECK_EQUAL(SUCCESS, AES_CMACCompute(&Context, (const uint8_t*)Output, BENCH_SIZE, Tag[0]));
+        cycles[engine][2] = HostSim_Cycles() - start;
+
+        printf("%s %u bytes: CTR %llu, CBC decryption %llu, CMAC %llu bus cycles\n",
+               (engine == ENGINE_DMA) ? "DMA" : "CPU", BENCH_SIZE, (unsigned long long)cycles[engine][0],
+               (unsigned long long)cycles[engine][1], (unsigned long long)cycles[engine][2]);
+    }
+
+    for (engine = ENGINE_CPU; engine <= ENGINE_DMA; engine++)
+    {
+        CHECK(cycles[engine][0] >= (uint64_t)(BENCH_SIZE / AES_BLOCK_SIZE) * HOSTAES_BLOCK_CYCLES);
+        CHECK(cycles[engine][2] >= (uint64_t)(BENCH_SIZE / AES_BLOCK_SIZE) * HOSTAES_BLOCK_CYCLES);
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    HOSTTEST_RUN(Test_KnownAnswers);
+    HOSTTEST_RUN(Test_CoreMatchesModel);
+    HOSTTEST_RUN(Test_Cycles);
+    /* The chaining modes give DMA buffers on their stack */
+    HOSTTEST_RUN_ON_SRAM(Test_ModeKnownAnswers);
+    HOSTTEST_RUN_ON_SRAM(Test_ModesMatchModel);
+    HOSTTEST_RUN_ON_SRAM(Test_ModeCycles);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,411 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_aes_record.c
+* @brief:     Record layer of the AES_RecordLink example, two ends on the AES
+*             software model: salt exchange, streams split in records,
+*             replays from this and an older session, and resynchronisation
+*             after lost, corrupted or forged bytes.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "aes_record.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define END_A                       0U
+#define END_B                       1U
+
+#define WIRE_SIZE                   4096U
+#define LOG_RECORDS                 64U
+#define STREAM_SIZE                 3000U
+#define PUMP_ROUNDS                 100U
+
+/* Private variables ---------------------------------------------------------*/
+static void TransmitA(const uint8_t* pData, uint32_t Length);
+static void TransmitB(const uint8_t* pData, uint32_t Length);
+static uint8_t TxBusy(void);
+static void Random(uint8_t* pData, uint32_t Length);
+static void DeliverA(const uint8_t* pData, uint32_t Length);
+static void DeliverB(const uint8_t* pData, uint32_t Length);
+
+static const Record_PortTypeDef Port[2] =
+{
+    {TransmitA, TxBusy, Random, DeliverA},
+    {TransmitB, TxBusy, Random, DeliverB}
+};
+
+static const uint8_t Key[16] =
+{
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+
+static AES_ModelTypeDef Model[2];
+static AES_ContextTypeDef Aes[2];
+static Record_LinkTypeDef Link[2];
+
+/* Bytes on the way to each end */
+static uint8_t Wire[2][WIRE_SIZE];
+static uint32_t WireLength[2];
+static uint8_t Pending[WIRE_SIZE];
+
+/* Records sent by each end, for the replays */
+static uint8_t Log[2][LOG_RECORDS][RECORD_SIZE_MAX];
+static uint32_t LogLength[2][LOG_RECORDS];
+static uint32_t LogCount[2];
+
+/* Plain text delivered to each end */
+static uint8_t Delivered[2][WIRE_SIZE];
+static uint32_t DeliveredLength[2];
+
+static uint8_t Stream[STREAM_SIZE];
+static uint32_t Seed;
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t NextRandom(void)
+{
+    Seed = Seed * 1103515245UL + 12345UL;
+    return Seed >> 16;
+}
+
+static void Transmit(uint32_t To, const uint8_t* pData, uint32_t Length)
+{
+    uint32_t from = To ^ 1U;
+
+    if (LogCount[from] < LOG_RECORDS)
+    {
+        memcpy(Log[from][LogCount[from]], pData, Length);
+        LogLength[from][LogCount[from]++] = Length;
+    }
+
+    if (CHECK(WireLength[To] + Length <= WIRE_SIZE))
+    {
+        memcpy(&Wire[To][WireLength[To]], pData, Length);
+        WireLength[To] += Length;
+    }
+}
+
+static void TransmitA(const uint8_t* pData, uint32_t Length)
+{
+    Transmit(END_B, pData, Length);
+}
+
+static void TransmitB(const uint8_t* pData, uint32_t Length)
+{
+    Transmit(END_A, pData, Length);
+}
+
+/**
+  * @brief  The wire takes each record at once.
+  */
+static uint8_t TxBusy(void)
+{
+    return 0;
+}
+
+static void Random(uint8_t* pData, uint32_t Length)
+{
+    while (Length-- != 0)
+    {
+        *pData++ = (uint8_t)NextRandom();
+    }
+}
+
+static void Deliver(uint32_t End, const uint8_t* pData, uint32_t Length)
+{
+    if (CHECK(DeliveredLength[End] + Length <= WIRE_SIZE))
+    {
+        memcpy(&Delivered[End][DeliveredLength[End]], pData, Length);
+        DeliveredLength[End] += Length;
+    }
+}
+
+static void DeliverA(const uint8_t* pData, uint32_t Length)
+{
+    Deliver(END_A, pData, Length);
+}
+
+static void DeliverB(const uint8_t* pData, uint32_t Length)
+{
+    Deliver(END_B, pData, Length);
+}
+
+static void InitEnd(uint32_t End)
+{
+    memset(&Aes[End], 0, sizeof(Aes[End]));
+    Aes[End].Model = &Model[End];
+    AES_ModeInit(&Aes[End], Key, AES_KEYSIZE_128B);
+    Record_Init(&Link[End], &Port[End], &Aes[End]);
+    LogCount[End] = 0;
+    DeliveredLength[End] = 0;
+}
+
+/**
+  * @brief  Moves the bytes on the wire to both ends until the link is idle.
+  */
+static void Pump(void)
+{
+    uint32_t round;
+    uint32_t end;
+    uint32_t length;
+
+    for (round = 0; round < PUMP_ROUNDS; round++)
+    {
+        Record_Poll(&Link[END_A]);
+        Record_Poll(&Link[END_B]);
+
+        if ((WireLength[END_A] == 0) && (WireLength[END_B] == 0))
+        {
+            return;
+        }
+
+        for (end = END_A; end <= END_B; end++)
+        {
+            length = WireLength[end];
+            memcpy(Pending, Wire[end], length);
+            WireLength[end] = 0;
+            Record_Receive(&Link[end], Pending, length);
+        }
+    }
+
+    CHECK(0);
+}
+
+static void Handshake(void)
+{
+    Pump();
+    CHECK_EQUAL(1, Record_IsReady(&Link[END_A]));
+    CHECK_EQUAL(1, Record_IsReady(&Link[END_B]));
+}
+
+/**
+  * @brief  Sends Length bytes of Stream from End in writes of random sizes.
+  */
+static void SendStream(uint32_t End, uint32_t Length)
+{
+    uint32_t sent = 0;
+    uint32_t size;
+
+    while (sent < Length)
+    {
+        size = 1U + NextRandom() % 600U;
+        size = (size > Length - sent) ? (Length - sent) : size;
+        sent += Record_Write(&Link[End], &Stream[sent], size);
+        Pump();
+    }
+}
+
+static void Start(uint32_t Test)
+{
+    uint32_t i;
+
+    Seed = Test;
+    for (i = 0; i < STREAM_SIZE; i++)
+    {
+        Stream[i] = (uint8_t)NextRandom();
+    }
+    WireLength[END_A] = 0;
+    WireLength[END_B] = 0;
+}
+
+static void Replay(uint32_t To, uint32_t Record)
+{
+    Record_Receive(&Link[To], Log[To ^ 1U][Record], LogLength[To ^ 1U][Record]);
+}
+
+static void Test_Stream(void)
+{
+    Start(1);
+    InitEnd(END_A);
+    InitEnd(END_B);
+    CHECK_EQUAL(0, Record_IsReady(&Link[END_A]));
+
+    /* Each end sends its HELLO, the answer with the challenge, the answer
+       once the peer salt is adopted */
+    Handshake();
+    CHECK(LogCount[END_A] <= 3U);
+    CHECK(LogCount[END_B] <= 3U);
+    CHECK_MEMORY(Link[END_B].Salt, Link[END_A].PeerSalt, RECORD_SALT_SIZE);
+    CHECK_MEMORY(Link[END_A].Salt, Link[END_B].PeerSalt, RECORD_SALT_SIZE);
+
+    SendStream(END_A, STREAM_SIZE);
+    CHECK_EQUAL(STREAM_SIZE, DeliveredLength[END_B]);
+    CHECK_MEMORY(Stream, Delivered[END_B], STREAM_SIZE);
+    SendStream(END_B, 100);
+    CHECK_EQUAL(100, DeliveredLength[END_A]);
+    CHECK_MEMORY(Stream, Delivered[END_A], 100);
+
+    CHECK_EQUAL(0, Link[END_B].RxAuthErrors + Link[END_B].RxReplays + Link[END_B].RxDiscarded);
+}
+
+/**
+  * @brief  Records replayed from this session: dropped whole, the sequence
+  *         numbers of the receiver session only grow.
+  */
+static void Test_Replay(void)
+{
+    uint32_t hellos;
+    uint32_t i;
+
+    Start(2);
+    InitEnd(END_A);
+    InitEnd(END_B);
+    Handshake();
+    hellos = LogCount[END_A];
+
+    SendStream(END_A, 1000);
+    CHECK(LogCount[END_A] > hellos + 2U);
+
+    /* The HELLO records and the DATA records already accepted */
+    DeliveredLength[END_B] = 0;
+    for (i = 0; i < LogCount[END_A]; i++)
+    {
+        Replay(END_B, i);
+    }
+    Pump();
+    CHECK_EQUAL(0, DeliveredLength[END_B]);
+    CHECK_EQUAL(LogCount[END_A], Link[END_B].RxReplays);
+    CHECK_EQUAL(0, Link[END_B].RxAuthErrors);
+    CHECK_EQUAL(1, Record_IsReady(&Link[END_B]));
+
+    /* The link still runs */
+    SendStream(END_A, 200);
+    CHECK_EQUAL(200, DeliveredLength[END_B]);
+    CHECK_MEMORY(Stream, Delivered[END_B], 200);
+}
+
+/**
+  * @brief  A restarts: B starts a new receiver session. The records of the
+  *         old session, HELLO first, are neither adopted nor delivered, and
+  *         a HELLO of the new session replayed after them does not lower the
+  *         sequence number of the DATA records.
+  */
+static void Test_OldSession(void)
+{
+    static uint8_t old[LOG_RECORDS][RECORD_SIZE_MAX];
+    static uint32_t oldlength[LOG_RECORDS];
+    uint32_t oldcount;
+    uint32_t hellos;
+    uint32_t i;
+
+    Start(3);
+    InitEnd(END_A);
+    InitEnd(END_B);
+    Handshake();
+    SendStream(END_A, 600);
+    oldcount = LogCount[END_A];
+    memcpy(old, Log[END_A], sizeof(old));
+    memcpy(oldlength, LogLength[END_A], sizeof(oldlength));
+
+    /* New session of A, B keeps running */
+    InitEnd(END_A);
+    Handshake();
+    hellos = LogCount[END_A];
+    CHECK_MEMORY(Link[END_A].Salt, Link[END_B].PeerSalt, RECORD_SALT_SIZE);
+    DeliveredLength[END_B] = 0;
+    SendStream(END_A, 1200);
+    CHECK_EQUAL(1200, DeliveredLength[END_B]);
+
+    /* Old session: answered but neither adopted nor delivered */
+    DeliveredLength[END_B] = 0;
+    for (i = 0; i < oldcount; i++)
+    {
+        Record_Receive(&Link[END_B], old[i], oldlength[i]);
+        Pump();
+        CHECK_EQUAL(1, Record_IsReady(&Link[END_B]));
+        CHECK_MEMORY(Link[END_A].Salt, Link[END_B].PeerSalt, RECORD_SALT_SIZE);
+    }
+
+    /* HELLO records of the new session, then its first DATA records */
+    for (i = 0; i < hellos + 2U; i++)
+    {
+        Replay(END_B, i);
+    }
+    Pump();
+    CHECK_EQUAL(0, DeliveredLength[END_B]);
+    CHECK_EQUAL(1, Record_IsReady(&Link[END_A]));
+    CHECK_EQUAL(1, Record_IsReady(&Link[END_B]));
+
+    SendStream(END_A, 300);
+    CHECK_EQUAL(300, DeliveredLength[END_B]);
+    CHECK_MEMORY(Stream, Delivered[END_B], 300);
+}
+
+/**
+  * @brief  A forged header whose payload covers the next record: the tag
+  *         fails and the record is found in the bytes kept.
+  */
+static void Test_Resync(void)
+{
+    uint8_t forged[8] = {0xA5, 0x01, 0, 0, 0x00, 0xFF, 0xFF, 0xFF};
+    uint32_t record;
+    uint32_t i;
+    uint32_t lost;
+
+    Start(4);
+    InitEnd(END_A);
+    InitEnd(END_B);
+    Handshake();
+
+    /* One record on the wire, announced by a forged header */
+    DeliveredLength[END_B] = 0;
+    record = LogCount[END_A];
+    CHECK_EQUAL(16, Record_Write(&Link[END_A], Stream, 16));
+    Record_Poll(&Link[END_A]);
+    CHECK_EQUAL(record + 1U, LogCount[END_A]);
+    forged[2] = (uint8_t)(LogLength[END_A][record] - RECORD_TAG_SIZE);
+    WireLength[END_B] = 0;
+    Record_Receive(&Link[END_B], forged, sizeof(forged));
+    Replay(END_B, record);
+    CHECK_EQUAL(16, DeliveredLength[END_B]);
+    CHECK_MEMORY(Stream, Delivered[END_B], 16);
+    CHECK_EQUAL(1, Link[END_B].RxAuthErrors);
+
+    /* Lost and corrupted bytes: only whole genuine records are delivered */
+    DeliveredLength[END_B] = 0;
+    lost = 0;
+    for (i = 0; i < 40U; i++)
+    {
+        record = LogCount[END_A];
+        CHECK_EQUAL(40, Record_Write(&Link[END_A], &Stream[40U * i], 40));
+        Record_Poll(&Link[END_A]);
+        if ((i % 4U) == 1U)
+        {
+            Wire[END_B][WireLength[END_B] - LogLength[END_A][record] + NextRandom() % LogLength[END_A][record]] ^=
+                (uint8_t)(1U + NextRandom() % 255U);
+            lost++;
+        }
+        else if ((i % 4U) == 3U)
+        {
+            WireLength[END_B]--;
+            lost++;
+        }
+        else
+        {
+            CHECK_EQUAL(record + 1U, LogCount[END_A]);
+        }
+    }
+    Pump();
+    CHECK_EQUAL(40U * (40U - lost), DeliveredLength[END_B]);
+    for (i = 0; i < DeliveredLength[END_B] / 40U; i++)
+    {
+        CHECK_MEMORY(&Stream[80U * i], &Delivered[END_B][40U * i], 40);
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    HOSTTEST_RUN(Test_Stream);
+    HOSTTEST_RUN(Test_Replay);
+    HOSTTEST_RUN(Test_OldSession);
+    HOSTTEST_RUN(Test_Resync);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
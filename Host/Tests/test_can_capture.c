@@ -0,0 +1,336 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_can_capture.c
+* @brief:     Capture log of the CAN_Capture example: record encoding, time
+*             stamp extension, record-wise reads across the end of the ring,
+*             frame length against a bit level model of the frame and replay
+*             timing.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "can_capture.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define LOG_SIZE                    256U
+#define RECORDS                     200U
+
+/* Private variables ---------------------------------------------------------*/
+static CANCapture_TypeDef Capture;
+static uint8_t LogBuffer[LOG_SIZE];
+static uint8_t Stream[RECORDS * CAN_CAPTURE_RECORD_MAX];
+static CANCapture_RecordTypeDef Records[RECORDS];
+static uint32_t Seed = 0x2468ACE1;
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t Random(void)
+{
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 17;
+    Seed ^= Seed << 5;
+    return Seed;
+}
+
+static void RandomRecord(CANCapture_RecordTypeDef* Record, uint32_t Time)
+{
+    uint32_t i;
+
+    Record->Time = Time;
+    Record->Flags = (uint8_t)(Random() & (CAN_CAPTURE_TX | CAN_CAPTURE_IDE | CAN_CAPTURE_RTR));
+    Record->Id = ((Record->Flags & CAN_CAPTURE_IDE) != 0) ? (Random() & 0x1FFFFFFFU) : (Random() & 0x7FFU);
+    Record->DLC = (uint8_t)(Random() % 9U);
+    memset(Record->Data, 0, sizeof(Record->Data));
+
+    if ((Record->Flags & CAN_CAPTURE_RTR) == 0)
+    {
+        for (i = 0; i < Record->DLC; i++)
+        {
+            Record->Data[i] = (uint8_t)Random();
+        }
+    }
+}
+
+static uint8_t SameRecord(const CANCapture_RecordTypeDef* A, const CANCapture_RecordTypeDef* B)
+{
+    return (uint8_t)((A->Time == B->Time) && (A->Id == B->Id) && (A->Flags == B->Flags) &&
+                     (A->DLC == B->DLC) &&
+                     (((A->Flags & CAN_CAPTURE_RTR) != 0) || (memcmp(A->Data, B->Data, A->DLC) == 0)));
+}
+
+static void PutBits(uint8_t* Bits, uint32_t* Length, uint32_t Value, uint32_t Count)
+{
+    while (Count != 0)
+    {
+        Count--;
+        Bits[(*Length)++] = (uint8_t)((Value >> Count) & 1U);
+    }
+}
+
+/**
+  * @brief  Bit level model of a frame: the bits from the start of frame to
+  *         the end of the CRC, the CRC-15 computed bit by bit as in ISO
+  *         11898-1, then the stuff bits counted on the whole sequence.
+  */
+static uint32_t ModelFrameBits(const CANCapture_RecordTypeDef* Record)
+{
+    uint8_t bits[160];
+    uint32_t length = 0;
+    uint32_t crc = 0;
+    uint32_t stuffed = 0;
+    uint32_t run = 0;
+    uint8_t last = 2;
+    uint32_t count;
+    uint32_t i;
+    uint8_t rtr = (uint8_t)((Record->Flags & CAN_CAPTURE_RTR) != 0);
+
+    PutBits(bits, &length, 0, 1);
+    if ((Record->Flags & CAN_CAPTURE_IDE) == 0)
+    {
+        /* Identifier, RTR, IDE, r0 */
+        PutBits(bits, &length, Record->Id, 11);
+        PutBits(bits, &length, rtr, 1);
+        PutBits(bits, &length, 0, 2);
+    }
+    else
+    {
+        /* Base identifier, SRR, IDE, extension, RTR, r1, r0 */
+        PutBits(bits, &length, Record->Id >> 18, 11);
+        PutBits(bits, &length, 3, 2);
+        PutBits(bits, &length, Record->Id & 0x3FFFFU, 18);
+        PutBits(bits, &length, rtr, 1);
+        PutBits(bits, &length, 0, 2);
+    }
+    PutBits(bits, &length, Record->DLC, 4);
+
+    count = (rtr != 0) ? 0 : Record->DLC;
+    for (i = 0; i < count; i++)
+    {
+        PutBits(bits, &length, Record->Data[i], 8);
+    }
+
+    for (i = 0; i < length; i++)
+    {
+        count = bits[i] ^ ((crc >> 14) & 1U);
+        crc = (crc << 1) & 0x7FFFU;
+        if (count != 0)
+        {
+            crc ^= 0x4599U;
+        }
+    }
+    PutBits(bits, &length, crc, 15);
+
+    /* A stuff bit after five equal bits, the stuff bit starts a new run */
+    for (i = 0; i < length; i++)
+    {
+        if (bits[i] == last)
+        {
+            run++;
+        }
+        else
+        {
+            last = bits[i];
+            run = 1;
+        }
+        if (run == 5U)
+        {
+            stuffed++;
+            last ^= 1U;
+            run = 1;
+        }
+    }
+
+    /* CRC delimiter, ACK slot and delimiter, end of frame, intermission */
+    return length + stuffed + 1U + 2U + 7U + 3U;
+}
+
+static void Test_EncodeDecode(void)
+{
+    uint32_t time = 0x1000;
+    uint32_t prev = 0;
+    uint32_t offset = 0;
+    uint32_t length;
+    uint32_t i;
+    CANCapture_RecordTypeDef decoded;
+
+    for (i = 0; i < RECORDS; i++)
+    {
+        /* Mostly short gaps, some over the 16-bit delta */
+        time += ((i % 17U) == 5U) ? 0x12345U : (Random() & 0x3FFU);
+        RandomRecord(&Records[i], time);
+        length = CANCapture_Encode(&Records[i], prev, Stream + offset);
+        CHECK(length <= CAN_CAPTURE_RECORD_MAX);
+        CHECK_EQUAL((i % 17U) == 5U, (Stream[offset] & CAN_CAPTURE_TIME32) != 0);
+        prev = time;
+        offset += length;
+    }
+
+    prev = 0;
+    length = 0;
+    for (i = 0; i < RECORDS; i++)
+    {
+        /* A cut record is not decoded */
+        CHECK_EQUAL(0, CANCapture_Decode(Stream + length, 2, &prev, &decoded));
+        length += CANCapture_Decode(Stream + length, offset - length, &prev, &decoded);
+        CHECK(SameRecord(&Records[i], &decoded));
+    }
+    CHECK_EQUAL(offset, length);
+}
+
+static void Test_ExtendTime(void)
+{
+    CANCapture_Init(&Capture, LogBuffer, LOG_SIZE);
+
+    CHECK_EQUAL(0xFFF0, CANCapture_ExtendTime(&Capture, 0xFFF0));
+
+    /* The 16-bit stamp wraps, the extended time goes on */
+    CHECK_EQUAL(0x10010, CANCapture_ExtendTime(&Capture, 0x0010));
+
+    /* A transmitted frame stamped before the last received one */
+    CHECK_EQUAL(0x10000, CANCapture_ExtendTime(&Capture, 0x0000));
+
+    /* Idle bus: the time base runs for several periods of the CAN timer */
+    CANCapture_Tick(&Capture, 0x30000);
+    CHECK_EQUAL(0x40005, CANCapture_ExtendTime(&Capture, 0x0005));
+}
+
+/**
+  * @brief  The producer writes whole records, the consumer reads them one by
+  *         one across the end of the storage. A full log drops the record.
+  */
+static void Test_ReadRecord(void)
+{
+    CANCapture_RecordTypeDef decoded;
+    uint8_t record[CAN_CAPTURE_RECORD_MAX];
+    uint32_t written = 0;
+    uint32_t read = 0;
+    uint32_t prev = 0;
+    uint32_t length;
+    uint32_t i;
+
+    CANCapture_Init(&Capture, LogBuffer, LOG_SIZE);
+    CHECK_EQUAL(0, CANCapture_ReadRecord(&Capture, record));
+
+    for (i = 0; i < RECORDS; i++)
+    {
+        RandomRecord(&Records[i], 100U * i);
+        CHECK_EQUAL(1, CANCapture_Write(&Capture, &Records[i]));
+        written++;
+
+        /* The consumer lags by a few records */
+        if ((i % 3U) != 0)
+        {
+            length = CANCapture_ReadRecord(&Capture, record);
+            CHECK(length != 0);
+            CHECK_EQUAL(length, CANCapture_Decode(record, length, &prev, &decoded));
+            CHECK(SameRecord(&Records[read], &decoded));
+            read++;
+        }
+
+        if ((Capture.Head - Capture.Tail) > (LOG_SIZE / 2U))
+        {
+            while ((length = CANCapture_ReadRecord(&Capture, record)) != 0)
+            {
+                CHECK_EQUAL(length, CANCapture_Decode(record, length, &prev, &decoded));
+                CHECK(SameRecord(&Records[read], &decoded));
+                read++;
+            }
+        }
+    }
+    CHECK(Capture.Head > LOG_SIZE);
+
+    while ((length = CANCapture_ReadRecord(&Capture, record)) != 0)
+    {
+        CANCapture_Decode(record, length, &prev, &decoded);
+        CHECK(SameRecord(&Records[read], &decoded));
+        read++;
+    }
+    CHECK_EQUAL(written, read);
+
+    /* Fill the log: the record which does not fit is dropped */
+    for (i = 0; CANCapture_Write(&Capture, &Records[0]) != 0; i++)
+    {
+    }
+    CHECK_EQUAL(1, Capture.Dropped);
+    CHECK(i != 0);
+}
+
+static void Test_FrameBits(void)
+{
+    CANCapture_RecordTypeDef record;
+    uint32_t i;
+
+    /* Standard data frame, identifier 0, no data: long dominant runs */
+    memset(&record, 0, sizeof(record));
+    CHECK_EQUAL(ModelFrameBits(&record), CANCapture_FrameBits(&record));
+
+    for (i = 0; i < 2000U; i++)
+    {
+        RandomRecord(&record, 0);
+        if ((i & 7U) == 0)
+        {
+            memset(record.Data, (i & 8U) ? 0xFF : 0x00, sizeof(record.Data));
+        }
+        CHECK_EQUAL(ModelFrameBits(&record), CANCapture_FrameBits(&record));
+    }
+
+    /* Bounds of a standard frame with 8 data bytes: 111 bits unstuffed */
+    record.Flags = 0;
+    record.DLC = 8;
+    record.Id = 0x555;
+    memset(record.Data, 0x55, sizeof(record.Data));
+    CHECK(CANCapture_FrameBits(&record) >= 111U);
+    CHECK(CANCapture_FrameBits(&record) <= 135U);
+}
+
+/**
+  * @brief  The replay keeps the gaps of the capture from its start time.
+  */
+static void Test_Replay(void)
+{
+    CANCapture_ReplayTypeDef replay;
+    CANCapture_RecordTypeDef record;
+    uint32_t offset = 0;
+    uint32_t prev = 0;
+    uint32_t i;
+
+    for (i = 0; i < 4U; i++)
+    {
+        RandomRecord(&Records[i], 50000U + 300U * i);
+        offset += CANCapture_Encode(&Records[i], prev, Stream + offset);
+        prev = Records[i].Time;
+    }
+
+    CANCapture_ReplayInit(&replay, Stream, offset, 7000);
+    CHECK_EQUAL(1, CANCapture_ReplayPoll(&replay, 7000, &record));
+    CHECK(SameRecord(&Records[0], &record));
+    CHECK_EQUAL(0, CANCapture_ReplayPoll(&replay, 7299, &record));
+    CHECK_EQUAL(1, CANCapture_ReplayPoll(&replay, 7300, &record));
+    CHECK(SameRecord(&Records[1], &record));
+
+    /* Late: the frames due are returned back to back */
+    CHECK_EQUAL(1, CANCapture_ReplayPoll(&replay, 8000, &record));
+    CHECK(SameRecord(&Records[2], &record));
+    CHECK_EQUAL(1, CANCapture_ReplayPoll(&replay, 8000, &record));
+    CHECK(SameRecord(&Records[3], &record));
+    CHECK_EQUAL(0, CANCapture_ReplayPoll(&replay, 9000, &record));
+    CHECK_EQUAL(0, replay.Pending);
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    HOSTTEST_RUN(Test_EncodeDecode);
+    HOSTTEST_RUN(Test_ExtendTime);
+    HOSTTEST_RUN(Test_ReadRecord);
+    HOSTTEST_RUN(Test_FrameBits);
+    HOSTTEST_RUN(Test_Replay);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
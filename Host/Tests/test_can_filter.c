@@ -0,0 +1,300 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_can_filter.c
+* @brief:     CAN_FilterCompile() against a reference matcher of the filter
+*             banks written as CAN_FilterInit() does: every requested frame
+*             is accepted, and the accepted count reported by the compiler
+*             is the one of an exhaustive scan of the standard identifiers.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "hk32l0xx.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define FILTER_BANKS                14U
+#define MAX_RANGES                  32U
+#define STD_IDS                     0x800U
+#define EXT_BASE                    0x12340000UL
+#define EXT_WINDOW                  0x1000U
+
+/* Private variables ---------------------------------------------------------*/
+static CAN_FilterRangeTypeDef Ranges[MAX_RANGES];
+static CAN_FilterInitTypeDef Filters[FILTER_BANKS];
+static CAN_FilterResultTypeDef Result;
+static uint32_t Seed = 0x13579BDF;
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t Random(void)
+{
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 17;
+    Seed ^= Seed << 5;
+    return Seed;
+}
+
+/**
+  * @brief  Identifier register of a received frame, as the filters see it:
+  *         STID[10:0] EXID[17:0] IDE RTR 0.
+  */
+static uint32_t FrameWord(uint32_t Id, uint32_t IDE, uint32_t RTR)
+{
+    return (IDE == CAN_Id_Standard) ? ((Id << 21) | RTR) : ((Id << 3) | IDE | RTR);
+}
+
+/**
+  * @brief  16-bit view of the same frame: STID[10:0] RTR IDE EXID[17:15].
+  */
+static uint32_t FrameHalf(uint32_t Word)
+{
+    return ((Word >> 16) & 0xFFE0U) | ((Word & 0x02U) << 3) | ((Word & 0x04U) << 1) | ((Word >> 18) & 0x07U);
+}
+
+/**
+  * @brief  Reference matcher of one filter bank, from the reference manual:
+  *         the register images are built as CAN_FilterInit() writes them.
+  */
+static uint8_t BankAccepts(const CAN_FilterInitTypeDef* Filter, uint32_t Word)
+{
+    uint32_t fr1;
+    uint32_t fr2;
+    uint32_t half = FrameHalf(Word);
+
+    if (Filter->CAN_FilterScale == CAN_FilterScale_32bit)
+    {
+        fr1 = ((uint32_t)Filter->CAN_FilterIdHigh << 16) | Filter->CAN_FilterIdLow;
+        fr2 = ((uint32_t)Filter->CAN_FilterMaskIdHigh << 16) | Filter->CAN_FilterMaskIdLow;
+
+        if (Filter->CAN_FilterMode == CAN_FilterMode_IdMask)
+        {
+            return (uint8_t)((((Word ^ fr1) & fr2) & ~1U) == 0);
+        }
+        return (uint8_t)((((Word ^ fr1) & ~1U) == 0) || (((Word ^ fr2) & ~1U) == 0));
+    }
+
+    fr1 = ((uint32_t)Filter->CAN_FilterMaskIdLow << 16) | Filter->CAN_FilterIdLow;
+    fr2 = ((uint32_t)Filter->CAN_FilterMaskIdHigh << 16) | Filter->CAN_FilterIdHigh;
+
+    if (Filter->CAN_FilterMode == CAN_FilterMode_IdMask)
+    {
+        return (uint8_t)((((half ^ fr1) & (fr1 >> 16) & 0xFFFFU) == 0) ||
+                         (((half ^ fr2) & (fr2 >> 16) & 0xFFFFU) == 0));
+    }
+    return (uint8_t)((half == (fr1 & 0xFFFFU)) || (half == (fr1 >> 16)) ||
+                     (half == (fr2 & 0xFFFFU)) || (half == (fr2 >> 16)));
+}
+
+static uint8_t Accepts(uint32_t Id, uint32_t IDE, uint32_t RTR)
+{
+    uint32_t word = FrameWord(Id, IDE, RTR);
+    uint32_t i;
+
+    for (i = 0; i < Result.NbBanks; i++)
+    {
+        if ((Filters[i].CAN_FilterActivation == ENABLE) && (BankAccepts(&Filters[i], word) != 0))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static uint8_t Requested(uint32_t NbRanges, uint32_t Id, uint32_t IDE, uint32_t RTR)
+{
+    uint32_t i;
+
+    for (i = 0; i < NbRanges; i++)
+    {
+        if ((Ranges[i].IDE == IDE) && (Ranges[i].RTR == RTR) &&
+                (Id >= Ranges[i].IdFirst) && (Id <= Ranges[i].IdLast))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void AddRange(uint32_t* NbRanges, uint32_t First, uint32_t Last, uint32_t IDE, uint32_t RTR)
+{
+    Ranges[*NbRanges].IdFirst = First;
+    Ranges[*NbRanges].IdLast = Last;
+    Ranges[*NbRanges].IDE = (uint8_t)IDE;
+    Ranges[*NbRanges].RTR = (uint8_t)RTR;
+    (*NbRanges)++;
+}
+
+/**
+  * @brief  Compiles the ranges and checks the banks against the matcher.
+  *         Standard frames are scanned exhaustively, extended frames in a
+  *         window around EXT_BASE, where the extended ranges are.
+  * @retval Number of accepted frames not requested.
+  */
+static uint32_t CompileAndCheck(uint32_t NbRanges, uint8_t FirstBank, uint8_t MaxBanks)
+{
+    uint32_t id;
+    uint32_t rtr;
+    uint32_t missed = 0;
+    uint32_t accepted = 0;
+    uint32_t extra = 0;
+    uint32_t i;
+
+    CAN_FilterCompile(Ranges, NbRanges, FirstBank, MaxBanks, CAN_Filter_FIFO1, Filters, &Result);
+
+    CHECK((Result.NbBanks != 0) && (Result.NbBanks <= MaxBanks));
+    for (i = 0; i < Result.NbBanks; i++)
+    {
+        CHECK_EQUAL(FirstBank + i, Filters[i].CAN_FilterNumber);
+        CHECK_EQUAL(CAN_Filter_FIFO1, Filters[i].CAN_FilterFIFOAssignment);
+    }
+
+    for (rtr = 0; rtr <= CAN_RTR_Remote; rtr += CAN_RTR_Remote)
+    {
+        for (id = 0; id < STD_IDS; id++)
+        {
+            if (Accepts(id, CAN_Id_Standard, rtr) != 0)
+            {
+                accepted++;
+                extra += (Requested(NbRanges, id, CAN_Id_Standard, rtr) == 0);
+            }
+            else if (Requested(NbRanges, id, CAN_Id_Standard, rtr) != 0)
+            {
+                missed++;
+            }
+        }
+
+        for (id = EXT_BASE - EXT_WINDOW; id < EXT_BASE + 2U * EXT_WINDOW; id++)
+        {
+            if (Accepts(id, CAN_Id_Extended, rtr) != 0)
+            {
+                extra += (Requested(NbRanges, id, CAN_Id_Extended, rtr) == 0);
+            }
+            else if (Requested(NbRanges, id, CAN_Id_Extended, rtr) != 0)
+            {
+                missed++;
+            }
+        }
+    }
+
+    CHECK_EQUAL(0, missed);
+    CHECK(Result.Accepted >= Result.Requested);
+
+    /* Without extended ranges the scan covers every frame the banks accept */
+    for (i = 0; (i < NbRanges) && (Ranges[i].IDE == CAN_Id_Standard); i++)
+    {
+    }
+    if (i == NbRanges)
+    {
+        CHECK_EQUAL(Result.Accepted, accepted);
+    }
+
+    return extra;
+}
+
+static void Test_ExactFit(void)
+{
+    uint32_t nb = 0;
+
+    /* Four single identifiers: one 16-bit list bank */
+    AddRange(&nb, 0x100, 0x100, CAN_Id_Standard, CAN_RTR_Data);
+    AddRange(&nb, 0x123, 0x123, CAN_Id_Standard, CAN_RTR_Data);
+    AddRange(&nb, 0x7FF, 0x7FF, CAN_Id_Standard, CAN_RTR_Data);
+    AddRange(&nb, 0x000, 0x000, CAN_Id_Standard, CAN_RTR_Remote);
+    CHECK_EQUAL(0, CompileAndCheck(nb, 0, FILTER_BANKS));
+    CHECK_EQUAL(1, Result.NbBanks);
+    CHECK_EQUAL(4, Result.Requested);
+    CHECK_EQUAL(4, Result.Accepted);
+    CHECK_EQUAL(CAN_FilterMode_IdList, Filters[0].CAN_FilterMode);
+    CHECK_EQUAL(CAN_FilterScale_16bit, Filters[0].CAN_FilterScale);
+
+    /* Unaligned ranges and extended identifiers */
+    nb = 0;
+    AddRange(&nb, 0x201, 0x23E, CAN_Id_Standard, CAN_RTR_Data);
+    AddRange(&nb, 0x5A0, 0x5BF, CAN_Id_Standard, CAN_RTR_Remote);
+    AddRange(&nb, EXT_BASE + 3U, EXT_BASE + 0x42U, CAN_Id_Extended, CAN_RTR_Data);
+    AddRange(&nb, EXT_BASE + 0x800U, EXT_BASE + 0x800U, CAN_Id_Extended, CAN_RTR_Remote);
+    CHECK_EQUAL(0, CompileAndCheck(nb, 0, FILTER_BANKS));
+    CHECK_EQUAL(Result.Requested, Result.Accepted);
+    CHECK_EQUAL(62 + 32 + 64 + 1, Result.Requested);
+}
+
+/**
+  * @brief  Fewer banks than needed: the set is widened, the requested frames
+  *         are still all accepted and the false accepts are reported.
+  */
+static void Test_Merge(void)
+{
+    uint32_t nb = 0;
+    uint32_t extra;
+    uint32_t i;
+
+    for (i = 0; i < 24U; i++)
+    {
+        AddRange(&nb, 0x40U * i + 5U, 0x40U * i + 5U + (i % 3U), CAN_Id_Standard, CAN_RTR_Data);
+    }
+
+    extra = CompileAndCheck(nb, 2, 3);
+    CHECK(Result.NbBanks <= 3);
+    CHECK(extra != 0);
+    CHECK_EQUAL(Result.Accepted - Result.Requested, extra);
+
+    /* A single bank for standard and extended frames accepts everything */
+    nb = 0;
+    AddRange(&nb, 0x10, 0x10, CAN_Id_Standard, CAN_RTR_Data);
+    AddRange(&nb, 0x700, 0x7FE, CAN_Id_Standard, CAN_RTR_Data);
+    AddRange(&nb, EXT_BASE, EXT_BASE + 0x10U, CAN_Id_Extended, CAN_RTR_Data);
+    AddRange(&nb, EXT_BASE + 0x777U, EXT_BASE + 0x777U, CAN_Id_Extended, CAN_RTR_Remote);
+    CompileAndCheck(nb, 13, 1);
+    CHECK_EQUAL(1, Result.NbBanks);
+    CHECK(Accepts(0x1FFFFFFF, CAN_Id_Extended, CAN_RTR_Remote) != 0);
+}
+
+/**
+  * @brief  Random standard sets, with all the banks and with a few banks.
+  */
+static void Test_Random(void)
+{
+    uint32_t nb;
+    uint32_t next;
+    uint32_t length;
+    uint32_t round;
+    uint32_t extra;
+
+    for (round = 0; round < 40U; round++)
+    {
+        nb = 0;
+        next = Random() % 64U;
+
+        while ((nb < 12U) && (next < STD_IDS))
+        {
+            length = ((Random() & 3U) == 0) ? (Random() % 100U) : 0;
+            if (next + length >= STD_IDS)
+            {
+                length = STD_IDS - 1U - next;
+            }
+            AddRange(&nb, next, next + length, CAN_Id_Standard, (Random() & 1U) ? CAN_RTR_Remote : CAN_RTR_Data);
+            next += length + 1U + Random() % 200U;
+        }
+
+        extra = CompileAndCheck(nb, 0, FILTER_BANKS);
+        CHECK_EQUAL(Result.Accepted - Result.Requested, extra);
+
+        extra = CompileAndCheck(nb, 0, (uint8_t)(1U + round % 4U));
+        CHECK_EQUAL(Result.Accepted - Result.Requested, extra);
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    HOSTTEST_RUN(Test_ExactFit);
+    HOSTTEST_RUN(Test_Merge);
+    HOSTTEST_RUN(Test_Random);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
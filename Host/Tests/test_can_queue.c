@@ -0,0 +1,230 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_can_queue.c
+* @brief:     CAN software queues on the CAN model: frames sent once each
+*             and received, and a FIFO 0 frame arriving at every point of a
+*             CAN_QueueTransmit() while a transmission completes: the FIFO
+*             interrupts share the vector and must leave the TX queue alone.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "hk32l0xx.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_RX_SIZE                8U
+#define TEST_TX_SIZE                8U
+#define TEST_MAX_FRAMES             16U
+#define TEST_WINDOW                 64U     /* bus cycles swept over a CAN_QueueTransmit() */
+#define TEST_RX_ID                  0x7F0U
+
+/* Private variables ---------------------------------------------------------*/
+static CAN_QueueTypeDef Queue;
+static CanMailbox RxBuffer[TEST_RX_SIZE];
+static CanMailbox TxBuffer[TEST_TX_SIZE];
+static CanMailbox Sent[TEST_MAX_FRAMES];
+
+/* Interrupts taken with the transmit interrupt masked and a request completed */
+static uint32_t Interleaved;
+
+/* Private functions ---------------------------------------------------------*/
+void LCD_CAN_IRQHandler(void)
+{
+    if (((CAN->IER & CAN_IT_TME) == 0) &&
+        ((CAN->TSR & (CAN_TSR_RQCP0 | CAN_TSR_RQCP1 | CAN_TSR_RQCP2)) != 0))
+    {
+        Interleaved++;
+    }
+
+    CAN_QueueIRQHandler();
+}
+
+static uint8_t Transmit(uint32_t Id)
+{
+    CanTxMsg message;
+    uint32_t i;
+
+    message.StdId = Id;
+    message.ExtId = 0;
+    message.IDE = CAN_Id_Standard;
+    message.RTR = CAN_RTR_Data;
+    message.DLC = 8;
+
+    for (i = 0; i < 8U; i++)
+    {
+        message.Data[i] = (uint8_t)(Id + i);
+    }
+
+    return CAN_QueueTransmit(&message);
+}
+
+static void Frame(CanMailbox* Mailbox, uint32_t Id)
+{
+    Mailbox->IR = Id << 21;
+    Mailbox->DTR = 8;
+    Mailbox->DLR = Id;
+    Mailbox->DHR = ~Id;
+}
+
+/**
+  * @brief  Lets Cycles bus cycles pass, taking the interrupts as they come:
+  *         HostSim_Run() takes them at its end only.
+  */
+static void Run(uint32_t Cycles)
+{
+    while (Cycles-- != 0)
+    {
+        HostSim_Run(1);
+    }
+}
+
+static void Init(void)
+{
+    CAN_InitTypeDef init;
+
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_CAN, ENABLE);
+    CAN_StructInit(&init);
+    CHECK_EQUAL(CAN_InitStatus_Success, CAN_Init(&init));
+    NVIC_EnableIRQ(LCD_CAN_IRQn);
+}
+
+/**
+  * @brief  The frames sent are the identifiers Ids, each one once, with
+  *         their data.
+  */
+static uint8_t CheckSent(const uint32_t* Ids, uint32_t Count)
+{
+    uint32_t sent = HostCan_Transmitted(Sent, TEST_MAX_FRAMES);
+    uint32_t found;
+    uint32_t i;
+    uint32_t j;
+
+    if (!CHECK_EQUAL(Count, sent))
+    {
+        return 0;
+    }
+
+    for (i = 0; i < Count; i++)
+    {
+        for (j = 0, found = 0; j < sent; j++)
+        {
+            if ((Sent[j].IR >> 21) == Ids[i])
+            {
+                found++;
+                CHECK_EQUAL((uint8_t)Ids[i], Sent[j].DLR & 0xFFU);
+            }
+        }
+
+        if (!CHECK_EQUAL(1, found))
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+static void Test_Transfer(void)
+{
+    static const uint32_t ids[] = {0x300, 0x100, 0x200, 0x050, 0x400};
+    CanMailbox frame;
+    CanRxMsg message;
+    uint32_t i;
+
+    Init();
+    CAN_QueueInit(&Queue, RxBuffer, TEST_RX_SIZE, TxBuffer, TEST_TX_SIZE);
+
+    for (i = 0; i < 5U; i++)
+    {
+        CHECK_EQUAL(CAN_TxStatus_Pending, Transmit(ids[i]));
+    }
+    /* Three in the mailboxes, the others queued */
+    CHECK_EQUAL(2, CAN_QueueTxPending());
+
+    Frame(&frame, 0x123);
+    HostCan_Receive(CAN_FIFO0, &frame, 10);
+    Frame(&frame, 0x124);
+    HostCan_Receive(CAN_FIFO0, &frame, 20);
+    Frame(&frame, 0x125);
+    HostCan_Receive(CAN_FIFO1, &frame, 30);
+
+    Run(6U * HOSTCAN_FRAME_CYCLES);
+
+    CheckSent(ids, 5);
+    CHECK_EQUAL(0, CAN_QueueTxPending());
+    CHECK_EQUAL(5, Queue.TxFrames);
+
+    CHECK_EQUAL(3, CAN_QueueRxPending());
+    for (i = 0; i < 3U; i++)
+    {
+        CHECK_EQUAL(1, CAN_QueueReceive(&message));
+        CHECK_EQUAL(0x123U + i, message.StdId);
+    }
+    CHECK_EQUAL(0, CAN_QueueReceive(&message));
+}
+
+/**
+  * @brief  A frame of higher priority queued while the mailboxes are full:
+  *         the first mailbox empties Offset cycles into CAN_QueueTransmit()
+  *         and a FIFO 0 frame arrives Delay cycles later. Whatever the
+  *         interleaving each frame is sent once and the frame received.
+  */
+static void Test_ReceiveDuringInsert(void)
+{
+    static const uint32_t ids[] = {0x200, 0x201, 0x202, 0x100};
+    CanMailbox frame;
+    CanRxMsg message;
+    uint64_t start;
+    uint32_t offset;
+    uint32_t delay;
+
+    Init();
+    Frame(&frame, TEST_RX_ID);
+
+    for (offset = 0; offset < TEST_WINDOW; offset++)
+    {
+        for (delay = 1; delay < TEST_WINDOW; delay++)
+        {
+            CAN_QueueInit(&Queue, RxBuffer, TEST_RX_SIZE, TxBuffer, TEST_TX_SIZE);
+
+            Transmit(ids[0]);
+            start = HostSim_Cycles();
+            Transmit(ids[1]);
+            Transmit(ids[2]);
+            Run((uint32_t)(start + HOSTCAN_FRAME_CYCLES - offset - HostSim_Cycles()));
+
+            HostCan_Receive(CAN_FIFO0, &frame, offset + delay);
+            Transmit(ids[3]);
+            Run(5U * HOSTCAN_FRAME_CYCLES);
+
+            if (!CheckSent(ids, 4) ||
+                !CHECK_EQUAL(0, CAN_QueueTxPending()) ||
+                !CHECK_EQUAL(4, Queue.TxFrames) ||
+                !CHECK_EQUAL(1, CAN_QueueReceive(&message)) ||
+                !CHECK_EQUAL(TEST_RX_ID, message.StdId))
+            {
+                printf("first mailbox empty at %u, frame received at %u cycles\n",
+                       (unsigned)offset, (unsigned)(offset + delay));
+                return;
+            }
+        }
+    }
+
+    /* The sweep did hit the FIFO interrupt in the masked window */
+    CHECK(Interleaved != 0);
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    HOSTTEST_RUN(Test_Transfer);
+    HOSTTEST_RUN(Test_ReceiveDuringInsert);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
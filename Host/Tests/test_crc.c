@@ -0,0 +1,176 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_crc.c
+* @brief:     CRC driver on the CRC and DMA models: CRC_CalcCRC and the
+*             stream API against the standard check values and the software
+*             path, CPU and DMA feeds, cycle count of the hot path.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "hk32l0xx.h"
+#include "host_test.h"
+
+/* Private variables ---------------------------------------------------------*/
+static const uint8_t Check[] = "123456789";
+static uint8_t Buffer[4096 + 3];
+
+/* Private functions ---------------------------------------------------------*/
+static void FillBuffer(void)
+{
+    uint32_t i;
+    uint32_t seed = 0x12345678;
+
+    for (i = 0; i < sizeof(Buffer); i++)
+    {
+        seed = seed * 1103515245U + 12345U;
+        Buffer[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+static void InitContext(CRC_ContextTypeDef* Context, FunctionalState Reflect, DMA_Channel_TypeDef* Channel)
+{
+    Context->Init = 0xFFFFFFFF;
+    Context->XorOut = (Reflect != DISABLE) ? 0xFFFFFFFF : 0;
+    Context->ReflectInput = Reflect;
+    Context->ReflectOutput = Reflect;
+    Context->DMAy_Channelx = Channel;
+    CRC_StreamInit(Context);
+}
+
+static void Test_CalcCRC(void)
+{
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC, ENABLE);
+
+    /* CRC-32/MPEG-2 of the word 0x12345678 */
+    CRC_ResetDR();
+    CHECK_EQUAL(0xDF8A8A2B, CRC_CalcCRC(0x12345678));
+
+    /* 8 and 16 bits writes go through the same polynomial */
+    CRC_ResetDR();
+    CRC_CalcCRC16bits(0x1234);
+    CHECK_EQUAL(0xDF8A8A2B, CRC_CalcCRC16bits(0x5678));
+    CRC_ResetDR();
+    CRC_CalcCRC8bits(0x12);
+    CRC_CalcCRC8bits(0x34);
+    CRC_CalcCRC8bits(0x56);
+    CHECK_EQUAL(0xDF8A8A2B, CRC_CalcCRC8bits(0x78));
+}
+
+static void Test_StreamCheckValues(void)
+{
+    CRC_ContextTypeDef context;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC, ENABLE);
+
+    /* CRC-32 (IEEE 802.3) */
+    InitContext(&context, ENABLE, NULL);
+    CHECK_EQUAL(SUCCESS, CRC_StreamUpdate(&context, Check, 9));
+    CHECK_EQUAL(0xCBF43926, CRC_StreamFinal(&context));
+
+    /* CRC-32/MPEG-2 */
+    InitContext(&context, DISABLE, NULL);
+    CHECK_EQUAL(SUCCESS, CRC_StreamUpdate(&context, Check, 9));
+    CHECK_EQUAL(0x0376E6E7, CRC_StreamFinal(&context));
+
+    /* Split updates, the unit used in between */
+    InitContext(&context, ENABLE, NULL);
+    CRC_StreamUpdate(&context, Check, 4);
+    CRC_ResetDR();
+    CRC_CalcCRC(0xAAAAAAAA);
+    CRC_StreamUpdate(&context, Check + 4, 5);
+    CHECK_EQUAL(0xCBF43926, CRC_StreamFinal(&context));
+}
+
+static void Test_StreamMatchesSoft(void)
+{
+    static const uint32_t lengths[] = {0, 1, 3, 4, 63, 64, 65, 1000, 4096};
+    DMA_Channel_TypeDef* channels[] = {NULL, DMA_Channel1};
+    CRC_ContextTypeDef hard;
+    CRC_ContextTypeDef soft;
+    uint32_t reflect;
+    uint32_t channel;
+    uint32_t offset;
+    uint32_t i;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC | RCC_AHBPeriph_DMA, ENABLE);
+    FillBuffer();
+
+    for (reflect = 0; reflect < 2; reflect++)
+    {
+        for (channel = 0; channel < 2; channel++)
+        {
+            for (offset = 0; offset < 4; offset++)
+            {
+                for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+                {
+                    InitContext(&hard, (FunctionalState)reflect, channels[channel]);
+                    InitContext(&soft, (FunctionalState)reflect, NULL);
+                    CHECK_EQUAL(SUCCESS, CRC_StreamUpdate(&hard, Buffer + offset, lengths[i] - (lengths[i] == 4096 ? offset : 0)));
+                    CRC_StreamUpdateSoft(&soft, Buffer + offset, lengths[i] - (lengths[i] == 4096 ? offset : 0));
+                    CHECK_EQUAL(CRC_StreamFinal(&soft), CRC_StreamFinal(&hard));
+                }
+            }
+        }
+    }
+}
+
+static void Test_StreamDmaFault(void)
+{
+    CRC_ContextTypeDef context;
+    uint32_t state;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC | RCC_AHBPeriph_DMA, ENABLE);
+
+    /* An address no bus master can reach ends the DMA with a transfer error */
+    InitContext(&context, ENABLE, DMA_Channel1);
+    state = context.State;
+    CHECK_EQUAL(ERROR, CRC_StreamUpdate(&context, (const uint8_t*)0x30000000, 256));
+    CHECK_EQUAL(state, context.State);
+}
+
+static void Test_StreamCycles(void)
+{
+    CRC_ContextTypeDef context;
+    uint64_t start;
+    uint64_t cpu;
+    uint64_t dma;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC | RCC_AHBPeriph_DMA, ENABLE);
+    FillBuffer();
+
+    InitContext(&context, ENABLE, NULL);
+    start = HostSim_Cycles();
+    CRC_StreamUpdate(&context, Buffer, 4096);
+    cpu = HostSim_Cycles() - start;
+
+    InitContext(&context, ENABLE, DMA_Channel1);
+    start = HostSim_Cycles();
+    CRC_StreamUpdate(&context, Buffer, 4096);
+    dma = HostSim_Cycles() - start;
+
+    printf("CRC 4 KB: CPU feed %llu bus cycles, DMA feed %llu bus cycles\n",
+           (unsigned long long)cpu, (unsigned long long)dma);
+
+    /* One word write per 4 bytes on both paths */
+    CHECK(cpu < 4096U);
+    CHECK(dma < 4096U);
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    HOSTTEST_RUN(Test_CalcCRC);
+    HOSTTEST_RUN(Test_StreamCheckValues);
+    HOSTTEST_RUN(Test_StreamMatchesSoft);
+    HOSTTEST_RUN(Test_StreamDmaFault);
+    HOSTTEST_RUN(Test_StreamCycles);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,389 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_dac.c
+* @brief:     DAC waveform generator: sine and resampled tables against
+*             floating point references, phase accumulator and sweeps of
+*             DAC_WaveFill(), and playback on the DAC and DMA models with
+*             the reuse of the periodic half buffers, the stall of a DMA
+*             underrun and the restart by the DAC interrupt.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hk32l0xx.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_SAMPLE_RATE            64000U
+#define TEST_BLOCK_LENGTH           32U
+#define TEST_SAMPLE_CYCLES          20U         /*!< Trigger period, leaves time for the DMA beat */
+#define TEST_AMPLITUDE              2047.0
+#define TEST_OFFSET                 2048.0
+#define TEST_SYNTH_TOLERANCE        0.51        /*!< Rounding of the table, polynomial error below 0.01 */
+#define TEST_FILL_TOLERANCE         1.51        /*!< Table rounding and interpolation rounded down */
+#define TEST_RESAMPLE_TOLERANCE     1.0         /*!< Interpolation rounded down */
+
+/* Private variables ---------------------------------------------------------*/
+static uint16_t Table[1024];
+static uint16_t SmallTable[64];
+static uint16_t Samples[4096];
+static uint16_t Buffer[2 * TEST_BLOCK_LENGTH];
+static uint16_t Played[40 * TEST_BLOCK_LENGTH];
+static DAC_WaveTypeDef Wave;
+
+/* Private functions ---------------------------------------------------------*/
+void DMA_CH2_3_IRQHandler(void)
+{
+    DAC_WaveIRQHandler(&Wave);
+}
+
+void DAC_IRQHandler(void)
+{
+    DAC_WaveIRQHandler(&Wave);
+}
+
+/**
+  * @brief  Sine of the generator at a phase of the accumulator.
+  */
+static double Sine(uint32_t Phase)
+{
+    return TEST_OFFSET + (TEST_AMPLITUDE * sin(2.0 * M_PI * (double)Phase / 4294967296.0));
+}
+
+/**
+  * @brief  Largest difference between two consecutive samples.
+  */
+static uint32_t MaxStep(const uint16_t* Data, uint32_t Length)
+{
+    uint32_t step = 0;
+    uint32_t i;
+
+    for (i = 1; i < Length; i++)
+    {
+        uint32_t d = (uint32_t)abs((int32_t)Data[i] - (int32_t)Data[i - 1]);
+        step = (d > step) ? d : step;
+    }
+    return step;
+}
+
+static void InitWave(uint16_t BlockLength)
+{
+    memset(&Wave, 0, sizeof(Wave));
+    Wave.DAC_Trigger = DAC_Trigger_T2_TRGO;
+    Wave.SampleRate = TEST_SAMPLE_RATE;
+    Wave.Buffer = Buffer;
+    Wave.BlockLength = BlockLength;
+    Wave.Table = Table;
+    Wave.TableBits = 10;
+    DAC_WaveSynthSine(Table, 10, 2047, 2048);
+    CHECK_EQUAL(SUCCESS, DAC_WaveInit(&Wave));
+}
+
+/**
+  * @brief  Timer triggers of the DAC, with the output after each one.
+  */
+static void Play(uint16_t* Output, uint32_t Length)
+{
+    uint32_t i;
+
+    for (i = 0; i < Length; i++)
+    {
+        HostDac_Trigger();
+        HostSim_Run(TEST_SAMPLE_CYCLES);
+        Output[i] = DAC_GetDataOutputValue();
+    }
+}
+
+static void Test_SynthSine(void)
+{
+    uint32_t i;
+    double error = 0;
+
+    DAC_WaveSynthSine(Table, 10, 2047, 2048);
+    for (i = 0; i < 1024; i++)
+    {
+        error = fmax(error, fabs(Table[i] - Sine(i << 22)));
+    }
+    CHECK(error <= TEST_SYNTH_TOLERANCE);
+    CHECK_EQUAL(2048, Table[0]);
+    CHECK_EQUAL(4095, Table[256]);
+    CHECK_EQUAL(1, Table[768]);
+
+    /* Two samples per period, then clipping at both ends */
+    DAC_WaveSynthSine(SmallTable, 1, 2047, 2048);
+    CHECK_EQUAL(2048, SmallTable[0]);
+    CHECK_EQUAL(2048, SmallTable[1]);
+    DAC_WaveSynthSine(SmallTable, 4, 2047, 3000);
+    CHECK_EQUAL(4095, SmallTable[4]);
+    CHECK_EQUAL(953, SmallTable[12]);
+    DAC_WaveSynthSine(SmallTable, 4, 2047, 1000);
+    CHECK_EQUAL(3047, SmallTable[4]);
+    CHECK_EQUAL(0, SmallTable[12]);
+}
+
+static void Test_SynthResample(void)
+{
+    static const uint16_t triangle[3] = {0, 3000, 600};
+    static uint16_t points[1000];
+    uint32_t lengths[3] = {3, 100, 1000};
+    uint32_t bits[3] = {6, 10, 6};
+    uint32_t t;
+    uint32_t i;
+    uint32_t k;
+    double x;
+    double expected;
+    double error = 0;
+
+    for (i = 0; i < 1000; i++)
+    {
+        points[i] = (uint16_t)((i * 2654435761UL) >> 20);
+    }
+
+    for (t = 0; t < 3; t++)
+    {
+        const uint16_t* source = (t == 0) ? triangle : points;
+
+        DAC_WaveSynthResample(Table, (uint8_t)bits[t], source, lengths[t]);
+        for (i = 0; i < (1UL << bits[t]); i++)
+        {
+            /* The last point is joined to the first one */
+            x = (double)i * lengths[t] / (1UL << bits[t]);
+            k = (uint32_t)x;
+            expected = source[k] + ((source[(k + 1) % lengths[t]] - (double)source[k]) * (x - k));
+            error = fmax(error, fabs(Table[i] - expected));
+        }
+    }
+    CHECK(error <= TEST_RESAMPLE_TOLERANCE);
+
+    /* Points on the table entries are copied */
+    DAC_WaveSynthResample(SmallTable, 6, triangle, 1);
+    for (i = 0; i < 64; i++)
+    {
+        CHECK_EQUAL(0, SmallTable[i]);
+    }
+    DAC_WaveSynthResample(Table, 10, points, 256);
+    for (i = 0; i < 256; i++)
+    {
+        CHECK_EQUAL(points[i], Table[4 * i]);
+    }
+}
+
+static void Test_Fill(void)
+{
+    uint32_t i;
+    uint32_t phase;
+    double error = 0;
+
+    InitWave(TEST_BLOCK_LENGTH);
+    Wave.Increment = DAC_WaveFrequencyToIncrement(TEST_SAMPLE_RATE, 1234);
+    Wave.Phase = 0x12345678;
+    phase = Wave.Phase;
+    DAC_WaveFill(&Wave, Samples, 4096);
+    for (i = 0; i < 4096; i++)
+    {
+        error = fmax(error, fabs(Samples[i] - Sine(phase)));
+        phase += Wave.Increment;
+    }
+    CHECK(error <= TEST_FILL_TOLERANCE);
+    CHECK_EQUAL(phase, Wave.Phase);
+
+    CHECK_EQUAL(0x40000000, DAC_WaveFrequencyToIncrement(48000, 12000));
+    CHECK_EQUAL(0xFFFFFFFF, DAC_WaveFrequencyToIncrement(48000, 48000));
+
+    /* Wrap-around of the phase: the last entry interpolates to the first */
+    SmallTable[0] = 100;
+    SmallTable[63] = 1100;
+    Wave.Table = SmallTable;
+    Wave.TableBits = 6;
+    Wave.Increment = 0x01000000;
+    Wave.Phase = 0xFE000000;
+    DAC_WaveFill(&Wave, Samples, 3);
+    CHECK_EQUAL(600, Samples[0]);
+    CHECK_EQUAL(350, Samples[1]);
+    CHECK_EQUAL(100, Samples[2]);
+}
+
+static void Test_Chirp(void)
+{
+    uint32_t start = DAC_WaveFrequencyToIncrement(TEST_SAMPLE_RATE, 1000);
+    uint32_t stop = DAC_WaveFrequencyToIncrement(TEST_SAMPLE_RATE, 4000);
+    uint32_t step = (stop - start) / 1000;
+    uint32_t period = (stop - start + step - 1) / step;
+    uint32_t restarts = 0;
+    uint32_t previous;
+    uint32_t phase;
+    uint32_t n;
+    uint32_t i;
+
+    /* DAC_WaveStart() applies the sweep and synthesizes two half buffers */
+    InitWave(TEST_BLOCK_LENGTH);
+    DAC_WaveSetChirp(&Wave, 1000, 4000, 1000, ENABLE);
+    DAC_WaveStart(&Wave);
+    DAC_WaveStop(&Wave);
+    n = 2 * TEST_BLOCK_LENGTH;
+    CHECK_EQUAL(start + (n * step), Wave.Increment);
+    CHECK_EQUAL((start * n) + (step * n * (n - 1) / 2), Wave.Phase);
+
+    /* Repeated: the increment ramps, then restarts at the start frequency */
+    previous = Wave.Increment;
+    phase = Wave.Phase;
+    for (i = n; i < 3500; i++)
+    {
+        DAC_WaveFill(&Wave, &Samples[i % 4096], 1);
+        phase += previous;
+        if (Wave.Increment < previous)
+        {
+            restarts++;
+            CHECK_EQUAL(start, Wave.Increment);
+            CHECK(previous + step >= stop);
+        }
+        else
+        {
+            CHECK_EQUAL(previous + step, Wave.Increment);
+        }
+        CHECK(Wave.Increment < stop);
+        previous = Wave.Increment;
+    }
+    CHECK_EQUAL(3500 / period, restarts);
+    CHECK_EQUAL(phase, Wave.Phase);
+    CHECK(MaxStep(&Samples[n], 3500 - n) <= (uint32_t)(2 * M_PI * TEST_AMPLITUDE * 4000 / TEST_SAMPLE_RATE) + 2);
+
+    /* Single downward sweep: ends on the stop frequency and holds it */
+    DAC_WaveSetChirp(&Wave, 4000, 1000, 500, DISABLE);
+    DAC_WaveStart(&Wave);
+    DAC_WaveStop(&Wave);
+    DAC_WaveFill(&Wave, Samples, 500);
+    CHECK_EQUAL(0, Wave.ChirpStep);
+    CHECK_EQUAL(start, Wave.Increment);
+    phase = Wave.Phase;
+    DAC_WaveFill(&Wave, Samples, 100);
+    CHECK_EQUAL(phase + (100 * start), Wave.Phase);
+    CHECK_EQUAL(start, Wave.Increment);
+
+    /* Too short for a step: the stop frequency at once */
+    DAC_WaveSetChirp(&Wave, 1000, 1001, 1000000, ENABLE);
+    DAC_WaveStart(&Wave);
+    DAC_WaveStop(&Wave);
+    CHECK_EQUAL(0, Wave.ChirpStep);
+    CHECK_EQUAL(DAC_WaveFrequencyToIncrement(TEST_SAMPLE_RATE, 1001), Wave.Increment);
+}
+
+static void Test_Playback(void)
+{
+    uint32_t conversions = HostDac_Conversions();
+    uint32_t underruns = HostDac_Underruns();
+    uint32_t played = 20 * TEST_BLOCK_LENGTH;
+    uint32_t reused;
+    uint32_t blocks;
+    uint32_t counter;
+    uint32_t phase;
+    uint32_t i;
+    double error = 0;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA, ENABLE);
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_DAC, ENABLE);
+    NVIC_EnableIRQ(DMA_CH2_3_IRQn);
+
+    /* 2000 Hz: two periods per half buffer, both halves are synthesized once */
+    InitWave(TEST_BLOCK_LENGTH);
+    DAC_WaveSetFrequency(&Wave, 2000);
+    DAC_WaveStart(&Wave);
+    Play(Played, played);
+    CHECK_EQUAL(played, HostDac_Conversions() - conversions);
+
+    /* Each trigger outputs the sample the DMA loaded at the previous one */
+    for (i = 1; i < played; i++)
+    {
+        error = fmax(error, fabs(Played[i] - Sine((i - 1) * Wave.Increment)));
+    }
+    CHECK(error <= TEST_FILL_TOLERANCE);
+    CHECK_EQUAL(2, Wave.Blocks);
+    CHECK_EQUAL(played / TEST_BLOCK_LENGTH, Wave.Reused);
+    CHECK_EQUAL(0, Wave.Lost);
+
+    /* 1100 Hz is not periodic over the buffer: every half is synthesized */
+    reused = Wave.Reused;
+    blocks = Wave.Blocks;
+    DAC_WaveSetFrequency(&Wave, 1100);
+    Play(Played, played);
+    CHECK_EQUAL(reused, Wave.Reused);
+    CHECK_EQUAL(blocks + (played / TEST_BLOCK_LENGTH), Wave.Blocks);
+
+    /* 1000 Hz: one period in the buffer, reused after two syntheses */
+    blocks = Wave.Blocks;
+    DAC_WaveSetFrequency(&Wave, 1000);
+    Play(&Played[played], played);
+    CHECK_EQUAL(blocks + 2, Wave.Blocks);
+    CHECK_EQUAL(reused + (played / TEST_BLOCK_LENGTH) - 2, Wave.Reused);
+    /* Continuous across the changes, the two buffered halves still at 2000 Hz */
+    CHECK(MaxStep(Played, 2 * played) <= (uint32_t)(2 * M_PI * TEST_AMPLITUDE * 2000 / TEST_SAMPLE_RATE) + 2);
+
+    /* A new table breaks the reuse once, the phase goes on */
+    reused = Wave.Reused;
+    DAC_WaveSynthSine(SmallTable, 6, 1000, 2048);
+    DAC_WaveSetTable(&Wave, SmallTable, 6);
+    phase = Wave.Phase;
+    Play(Played, 4 * TEST_BLOCK_LENGTH);
+    CHECK(Wave.Table == SmallTable);
+    CHECK_EQUAL(reused + 2, Wave.Reused);
+    CHECK_EQUAL(phase + (4 * TEST_BLOCK_LENGTH * Wave.Increment), Wave.Phase);
+
+    /* Two triggers before the DMA beat: DMAUDR, the DAC interrupt still
+       masked in the NVIC. The DMA requests stop, the output holds and no
+       half transfer interrupt comes */
+    HostDac_Trigger();
+    HostDac_Trigger();
+    CHECK_EQUAL(underruns + 1, HostDac_Underruns());
+    reused = Wave.Reused;
+    blocks = Wave.Blocks;
+    counter = DMA_Channel2->CHDTR;
+    Play(Played, 4 * TEST_BLOCK_LENGTH);
+    CHECK_EQUAL(counter, DMA_Channel2->CHDTR);
+    CHECK_EQUAL(0, MaxStep(Played, 4 * TEST_BLOCK_LENGTH));
+    CHECK_EQUAL(reused, Wave.Reused);
+    CHECK_EQUAL(blocks, Wave.Blocks);
+    CHECK_EQUAL(0, Wave.Underruns);
+    CHECK(DAC->SR & DAC_SR_DMAUDR);
+
+    /* The DAC interrupt counts the underrun and restarts the DMA: both
+       halves synthesized again by DAC_WaveStart() from the current phase,
+       then reused by every half transfer interrupt */
+    conversions = HostDac_Conversions();
+    NVIC_EnableIRQ(DAC_IRQn);
+    Play(Played, played);
+    CHECK_EQUAL(1, Wave.Underruns);
+    CHECK_EQUAL(underruns + 1, HostDac_Underruns());
+    CHECK_EQUAL(0, DAC->SR & DAC_SR_DMAUDR);
+    CHECK_EQUAL(played, HostDac_Conversions() - conversions);
+    CHECK_EQUAL(blocks + 2, Wave.Blocks);
+    CHECK_EQUAL(reused + (played / TEST_BLOCK_LENGTH), Wave.Reused);
+    /* Continuous once the first sample of the restarted buffer is out */
+    CHECK(MaxStep(&Played[2], played - 2) <= (uint32_t)(2 * M_PI * 1000 * 1000 / TEST_SAMPLE_RATE) + 2);
+    CHECK(MaxStep(&Played[2], played - 2) != 0);
+
+    DAC_WaveStop(&Wave);
+    conversions = HostDac_Conversions();
+    Play(Played, 4);
+    CHECK_EQUAL(4, HostDac_Conversions() - conversions);
+    CHECK_EQUAL(Played[0], Played[3]);
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    HOSTTEST_RUN(Test_SynthSine);
+    HOSTTEST_RUN(Test_SynthResample);
+    HOSTTEST_RUN(Test_Fill);
+    HOSTTEST_RUN(Test_Chirp);
+    HOSTTEST_RUN(Test_Playback);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
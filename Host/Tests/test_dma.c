@@ -0,0 +1,215 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_dma.c
+* @brief:     DMA driver on the DMA model: memory to memory transfers, data
+*             width conversion, flags and interrupts, priorities.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "hk32l0xx.h"
+#include "host_test.h"
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t Source[64];
+static uint32_t Destination[64];
+static uint32_t Destination2[64];
+static volatile uint32_t HalfTransfers;
+static volatile uint32_t Transfers;
+
+/* Private functions ---------------------------------------------------------*/
+static void ConfigureCopy(DMA_Channel_TypeDef* Channel, const void* From, void* To, uint32_t Count,
+                          uint32_t PeripheralSize, uint32_t MemorySize, uint32_t Priority)
+{
+    DMA_InitTypeDef init;
+
+    init.DMA_PeripheralBaseAddr = (uint32_t)From;
+    init.DMA_MemoryBaseAddr = (uint32_t)To;
+    init.DMA_DIR = DMA_DIR_PeripheralSRC;
+    init.DMA_BufferSize = Count;
+    init.DMA_PeripheralInc = DMA_PeripheralInc_Enable;
+    init.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    init.DMA_PeripheralDataSize = PeripheralSize;
+    init.DMA_MemoryDataSize = MemorySize;
+    init.DMA_Mode = DMA_Mode_Normal;
+    init.DMA_Priority = Priority;
+    init.DMA_M2M = DMA_M2M_Enable;
+
+    DMA_DeInit(Channel);
+    DMA_Init(Channel, &init);
+}
+
+static void StartCopy(DMA_Channel_TypeDef* Channel, const void* From, void* To, uint32_t Count,
+                      uint32_t PeripheralSize, uint32_t MemorySize, uint32_t Priority)
+{
+    ConfigureCopy(Channel, From, To, Count, PeripheralSize, MemorySize, Priority);
+    DMA_Cmd(Channel, ENABLE);
+}
+
+static void FillSource(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < 64U; i++)
+    {
+        Source[i] = 0x01010101UL * i + 0x80402010UL;
+    }
+    memset(Destination, 0, sizeof(Destination));
+    memset(Destination2, 0, sizeof(Destination2));
+}
+
+static void Test_MemoryCopy(void)
+{
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA, ENABLE);
+    FillSource();
+
+    StartCopy(DMA_Channel1, Source, Destination, 64, DMA_PeripheralDataSize_Word, DMA_MemoryDataSize_Word,
+              DMA_Priority_Low);
+    while (DMA_GetFlagStatus(DMA1_FLAG_TC1) == RESET)
+    {
+    }
+    CHECK_MEMORY(Source, Destination, sizeof(Source));
+    CHECK_EQUAL(0, DMA_GetCurrDataCounter(DMA_Channel1));
+    CHECK(DMA_GetFlagStatus(DMA1_FLAG_HT1) != RESET);
+    CHECK(DMA_GetFlagStatus(DMA1_FLAG_TE1) == RESET);
+
+    DMA_ClearFlag(DMA1_FLAG_GL1);
+    CHECK(DMA_GetFlagStatus(DMA1_FLAG_TC1) == RESET);
+
+    /* Bytes and half words */
+    StartCopy(DMA_Channel2, Source, Destination2, 37, DMA_PeripheralDataSize_Byte, DMA_MemoryDataSize_Byte,
+              DMA_Priority_Low);
+    while (DMA_GetFlagStatus(DMA1_FLAG_TC2) == RESET)
+    {
+    }
+    CHECK_MEMORY(Source, Destination2, 37);
+    CHECK_EQUAL(0, ((uint8_t*)Destination2)[37]);
+}
+
+static void Test_WidthConversion(void)
+{
+    uint32_t i;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA, ENABLE);
+    FillSource();
+
+    /* Words read, half words written: the upper half is dropped */
+    StartCopy(DMA_Channel3, Source, Destination, 8, DMA_PeripheralDataSize_Word, DMA_MemoryDataSize_HalfWord,
+              DMA_Priority_Low);
+    while (DMA_GetFlagStatus(DMA1_FLAG_TC3) == RESET)
+    {
+    }
+    for (i = 0; i < 8U; i++)
+    {
+        CHECK_EQUAL(Source[i] & 0xFFFFU, ((uint16_t*)Destination)[i]);
+    }
+
+    /* Bytes read, words written: zero extended */
+    StartCopy(DMA_Channel3, Source, Destination2, 8, DMA_PeripheralDataSize_Byte, DMA_MemoryDataSize_Word,
+              DMA_Priority_Low);
+    while (DMA_GetFlagStatus(DMA1_FLAG_TC3) == RESET)
+    {
+    }
+    for (i = 0; i < 8U; i++)
+    {
+        CHECK_EQUAL(((uint8_t*)Source)[i], Destination2[i]);
+    }
+}
+
+void DMA_CH4_7_IRQHandler(void)
+{
+    if (DMA_GetITStatus(DMA1_IT_HT5) != RESET)
+    {
+        DMA_ClearITPendingBit(DMA1_IT_HT5);
+        HalfTransfers++;
+    }
+    if (DMA_GetITStatus(DMA1_IT_TC5) != RESET)
+    {
+        DMA_ClearITPendingBit(DMA1_IT_GL5);
+        Transfers++;
+    }
+}
+
+static void Test_Interrupts(void)
+{
+    NVIC_InitTypeDef nvic;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA, ENABLE);
+    FillSource();
+    HalfTransfers = 0;
+    Transfers = 0;
+
+    nvic.NVIC_IRQChannel = DMA_CH4_7_IRQn;
+    nvic.NVIC_IRQChannelPriority = 1;
+    nvic.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&nvic);
+
+    ConfigureCopy(DMA_Channel5, Source, Destination, 64, DMA_PeripheralDataSize_Word, DMA_MemoryDataSize_Word,
+                  DMA_Priority_Low);
+    DMA_ITConfig(DMA_Channel5, DMA_IT_HT | DMA_IT_TC, ENABLE);
+    DMA_Cmd(DMA_Channel5, ENABLE);
+
+    while (Transfers == 0)
+    {
+        __WFI();
+    }
+    CHECK_EQUAL(1, HalfTransfers);
+    CHECK_EQUAL(1, Transfers);
+    CHECK_MEMORY(Source, Destination, sizeof(Source));
+}
+
+static void Test_Priority(void)
+{
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA, ENABLE);
+    FillSource();
+
+    /* Channel 7 at very high priority overtakes channel 1 at low priority */
+    __disable_irq();
+    StartCopy(DMA_Channel1, Source, Destination, 64, DMA_PeripheralDataSize_Word, DMA_MemoryDataSize_Word,
+              DMA_Priority_Low);
+    StartCopy(DMA_Channel7, Source, Destination2, 64, DMA_PeripheralDataSize_Word, DMA_MemoryDataSize_Word,
+              DMA_Priority_VeryHigh);
+    while (DMA_GetFlagStatus(DMA1_FLAG_TC7) == RESET)
+    {
+    }
+    CHECK(DMA_GetCurrDataCounter(DMA_Channel1) > 32U);
+    while (DMA_GetFlagStatus(DMA1_FLAG_TC1) == RESET)
+    {
+    }
+    CHECK_MEMORY(Source, Destination, sizeof(Source));
+    CHECK_MEMORY(Source, Destination2, sizeof(Source));
+    __enable_irq();
+}
+
+static void Test_TransferError(void)
+{
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA, ENABLE);
+
+    /* Flash is not writable by the DMA */
+    StartCopy(DMA_Channel4, Source, (void*)HOSTSIM_FLASH_BASE, 4, DMA_PeripheralDataSize_Word, DMA_MemoryDataSize_Word,
+              DMA_Priority_Low);
+    while (DMA_GetFlagStatus(DMA1_FLAG_TE4) == RESET)
+    {
+    }
+    CHECK((DMA_Channel4->CHCR & DMA_Channel_CHCR_EN) == 0);
+    CHECK_EQUAL(4, DMA_GetCurrDataCounter(DMA_Channel4));
+    CHECK_EQUAL(0xFFFFFFFF, *(volatile uint32_t*)HOSTSIM_FLASH_BASE);
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    HOSTTEST_RUN(Test_MemoryCopy);
+    HOSTTEST_RUN(Test_WidthConversion);
+    HOSTTEST_RUN(Test_Interrupts);
+    HOSTTEST_RUN(Test_Priority);
+    HOSTTEST_RUN(Test_TransferError);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,589 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_dsp.c
+* @brief:     CMSIS DSP subset of DSP_Lib against floating point references:
+*             complex and real FFTs, FIR, biquad cascade, moving average,
+*             statistics and square roots, in q15 and q31. Built once with
+*             the divisions and square roots in C and once on the DVSQ model.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include "hk32l0xx.h"
+#include "arm_math_ext.h"
+#include "arm_const_structs.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define Q15_ONE                     32768.0
+#define Q31_ONE                     2147483648.0
+#define FFT_MAX_LENGTH              256U
+#define FIR_TAPS                    29U
+#define FIR_BLOCK                   64U
+#define FILTER_LENGTH               256U
+#define BIQUAD_STAGES               2U
+
+/* Largest errors, in LSB of the output format */
+#define CFFT_Q15_TOLERANCE          3.0
+#define CFFT_Q31_TOLERANCE          4.0
+#define RFFT_Q15_TOLERANCE          4.0
+#define RFFT_Q31_TOLERANCE          5.0
+#define FIR_TOLERANCE               1.0
+#define BIQUAD_Q15_TOLERANCE        5.0
+#define BIQUAD_Q31_TOLERANCE        5.0
+#define AVERAGE_Q15_TOLERANCE       1.0
+#define AVERAGE_Q31_TOLERANCE       2.0
+#define STATISTICS_TOLERANCE        2.0
+#define SQRT_TOLERANCE              1.0
+
+/* Private variables ---------------------------------------------------------*/
+static const arm_cfft_instance_q15* const CfftQ15[] =
+{
+    &arm_cfft_sR_q15_len16, &arm_cfft_sR_q15_len32, &arm_cfft_sR_q15_len64,
+    &arm_cfft_sR_q15_len128, &arm_cfft_sR_q15_len256
+};
+static const arm_cfft_instance_q31* const CfftQ31[] =
+{
+    &arm_cfft_sR_q31_len16, &arm_cfft_sR_q31_len32, &arm_cfft_sR_q31_len64,
+    &arm_cfft_sR_q31_len128, &arm_cfft_sR_q31_len256
+};
+
+/* Biquad stages b0, b1, b2, a1, a2, halved for a postShift of 1 */
+static const double BiquadStages[BIQUAD_STAGES][5] =
+{
+    {0.0675 / 2, 0.135 / 2, 0.0675 / 2, 1.143 / 2, -0.4128 / 2},
+    {0.2 / 2, 0.4 / 2, 0.2 / 2, 0.3695 / 2, -0.1958 / 2},
+};
+
+static uint32_t Seed = 0x13579BDF;
+static q15_t Q15In[2 * FFT_MAX_LENGTH];
+static q15_t Q15Out[2 * FFT_MAX_LENGTH];
+static q15_t Q15Back[2 * FFT_MAX_LENGTH];
+static q31_t Q31In[2 * FFT_MAX_LENGTH];
+static q31_t Q31Out[2 * FFT_MAX_LENGTH];
+static q31_t Q31Back[2 * FFT_MAX_LENGTH];
+static double Reference[2 * FFT_MAX_LENGTH];
+static double Samples[2 * FFT_MAX_LENGTH];
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t Random(void)
+{
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 17;
+    Seed ^= Seed << 5;
+    return Seed;
+}
+
+/**
+  * @brief  Random value in [-Scale, Scale[ on 16 bits.
+  */
+static q15_t RandomQ15(double Scale)
+{
+    return (q15_t)((int32_t)(int16_t)Random() * Scale);
+}
+
+static q31_t RandomQ31(double Scale)
+{
+    return (q31_t)((int32_t)Random() * Scale);
+}
+
+static void InitDsp(void)
+{
+#if defined(ARM_MATH_DVSQ)
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DVSQ, ENABLE);
+    DVSQ_Init();
+#endif
+}
+
+/**
+  * @brief  DFT of Length complex samples, divided by Length as the CMSIS FFTs.
+  */
+static void Dft(const double* Input, double* Output, uint32_t Length, uint8_t Inverse)
+{
+    uint32_t k;
+    uint32_t n;
+    double angle;
+    double re;
+    double im;
+
+    for (k = 0; k < Length; k++)
+    {
+        re = 0;
+        im = 0;
+        for (n = 0; n < Length; n++)
+        {
+            angle = ((Inverse != 0) ? 2.0 : -2.0) * M_PI * (double)((k * n) % Length) / Length;
+            re += (Input[2 * n] * cos(angle)) - (Input[2 * n + 1] * sin(angle));
+            im += (Input[2 * n] * sin(angle)) + (Input[2 * n + 1] * cos(angle));
+        }
+        Output[2 * k] = re / Length;
+        Output[2 * k + 1] = im / Length;
+    }
+}
+
+static double MaxError(double Error, double Expected, double Actual)
+{
+    return (fabs(Expected - Actual) > Error) ? fabs(Expected - Actual) : Error;
+}
+
+static void Test_MultQ63(void)
+{
+    uint32_t i;
+    q31_t a;
+    q31_t b;
+    uint32_t exact = 0;
+
+    CHECK(arm_mult_q31_q63(INT32_MIN, INT32_MIN) == (q63_t)INT32_MIN * INT32_MIN);
+    CHECK(arm_mult_q31_q63(INT32_MIN, INT32_MAX) == (q63_t)INT32_MIN * INT32_MAX);
+    CHECK(arm_mult_q31_q63(-1, -1) == 1);
+
+    for (i = 0; i < 200000; i++)
+    {
+        a = (q31_t)Random();
+        b = (q31_t)Random();
+        exact += (arm_mult_q31_q63(a, b) == (q63_t)a * b) ? 1 : 0;
+    }
+    CHECK_EQUAL(200000, exact);
+}
+
+static void Test_Cfft(void)
+{
+    uint32_t t;
+    uint32_t n;
+    uint32_t length;
+    uint8_t inverse;
+    double q15Error = 0;
+    double q31Error = 0;
+
+    InitDsp();
+
+    for (t = 0; t < sizeof(CfftQ15) / sizeof(CfftQ15[0]); t++)
+    {
+        length = CfftQ15[t]->fftLen;
+        CHECK_EQUAL(length, CfftQ31[t]->fftLen);
+
+        for (inverse = 0; inverse < 2; inverse++)
+        {
+            for (n = 0; n < 2 * length; n++)
+            {
+                Q15Out[n] = RandomQ15(0.5);
+                Samples[n] = Q15Out[n] / Q15_ONE;
+            }
+            Dft(Samples, Reference, length, inverse);
+            arm_cfft_q15(CfftQ15[t], Q15Out, inverse, 1);
+
+            for (n = 0; n < 2 * length; n++)
+            {
+                q15Error = MaxError(q15Error, Reference[n] * Q15_ONE, Q15Out[n]);
+            }
+
+            for (n = 0; n < 2 * length; n++)
+            {
+                Q31Out[n] = RandomQ31(0.5);
+                Samples[n] = Q31Out[n] / Q31_ONE;
+            }
+            Dft(Samples, Reference, length, inverse);
+            arm_cfft_q31(CfftQ31[t], Q31Out, inverse, 1);
+
+            for (n = 0; n < 2 * length; n++)
+            {
+                q31Error = MaxError(q31Error, Reference[n] * Q31_ONE, Q31Out[n]);
+            }
+        }
+    }
+
+    CHECK(q15Error <= CFFT_Q15_TOLERANCE);
+    CHECK(q31Error <= CFFT_Q31_TOLERANCE);
+
+    /* Full scale DC: the rounded stage inputs must not wrap the sums */
+    for (n = 0; n < 2 * FFT_MAX_LENGTH; n++)
+    {
+        Q31Out[n] = ((n & 1) == 0) ? INT32_MAX : 0;
+    }
+    arm_cfft_q31(&arm_cfft_sR_q31_len256, Q31Out, 0, 1);
+    CHECK(Q31Out[0] > INT32_MAX - 4);
+    CHECK(Q31Out[2] == 0);
+}
+
+static void Test_Rfft(void)
+{
+    arm_rfft_instance_q15 forward15;
+    arm_rfft_instance_q15 inverse15;
+    arm_rfft_instance_q31 forward31;
+    arm_rfft_instance_q31 inverse31;
+    uint32_t length;
+    uint32_t n;
+    double q15Error = 0;
+    double q31Error = 0;
+    double q15Back = 0;
+    double q31Back = 0;
+
+    InitDsp();
+
+    for (length = 32; length <= FFT_MAX_LENGTH; length <<= 1)
+    {
+        CHECK_EQUAL(ARM_MATH_SUCCESS, arm_rfft_init_q15(&forward15, length, 0, 1));
+        CHECK_EQUAL(ARM_MATH_SUCCESS, arm_rfft_init_q15(&inverse15, length, 1, 1));
+        CHECK_EQUAL(ARM_MATH_SUCCESS, arm_rfft_init_q31(&forward31, length, 0, 1));
+        CHECK_EQUAL(ARM_MATH_SUCCESS, arm_rfft_init_q31(&inverse31, length, 1, 1));
+
+        for (n = 0; n < length; n++)
+        {
+            Q15In[n] = RandomQ15(0.99);
+            Samples[2 * n] = Q15In[n] / Q15_ONE;
+            Samples[2 * n + 1] = 0;
+        }
+        Dft(Samples, Reference, length, 0);
+        arm_rfft_q15(&forward15, Q15In, Q15Out);
+
+        /* The full spectrum, the upper half conjugate of the lower one */
+        for (n = 0; n < 2 * length; n++)
+        {
+            q15Error = MaxError(q15Error, Reference[n] * Q15_ONE, Q15Out[n]);
+        }
+
+        /* Back to the samples, divided by the length once more */
+        arm_rfft_q15(&inverse15, Q15Out, Q15Back);
+        for (n = 0; n < length; n++)
+        {
+            q15Back = MaxError(q15Back, Samples[2 * n] * Q15_ONE / length, Q15Back[n]);
+        }
+
+        for (n = 0; n < length; n++)
+        {
+            Q31In[n] = RandomQ31(0.99);
+            Samples[2 * n] = Q31In[n] / Q31_ONE;
+        }
+        Dft(Samples, Reference, length, 0);
+        arm_rfft_q31(&forward31, Q31In, Q31Out);
+
+        for (n = 0; n < 2 * length; n++)
+        {
+            q31Error = MaxError(q31Error, Reference[n] * Q31_ONE, Q31Out[n]);
+        }
+
+        arm_rfft_q31(&inverse31, Q31Out, Q31Back);
+        for (n = 0; n < length; n++)
+        {
+            q31Back = MaxError(q31Back, Samples[2 * n] * Q31_ONE / length, Q31Back[n]);
+        }
+    }
+
+    CHECK(q15Error <= RFFT_Q15_TOLERANCE);
+    CHECK(q31Error <= RFFT_Q31_TOLERANCE);
+    CHECK(q15Back <= RFFT_Q15_TOLERANCE);
+    CHECK(q31Back <= RFFT_Q31_TOLERANCE);
+    CHECK_EQUAL(ARM_MATH_ARGUMENT_ERROR, arm_rfft_init_q15(&forward15, 512, 0, 1));
+    CHECK_EQUAL(ARM_MATH_ARGUMENT_ERROR, arm_rfft_init_q31(&forward31, 16, 0, 1));
+}
+
+static void Test_Fir(void)
+{
+    static q15_t coeffs15[FIR_TAPS];
+    static q31_t coeffs31[FIR_TAPS];
+    static q15_t state15[FIR_TAPS + FIR_BLOCK - 1];
+    static q31_t state31[FIR_TAPS + FIR_BLOCK - 1];
+    arm_fir_instance_q15 fir15;
+    arm_fir_instance_q31 fir31;
+    uint32_t n;
+    uint32_t k;
+    double sum15;
+    double sum31;
+    double q15Error = 0;
+    double q31Error = 0;
+
+    InitDsp();
+
+    for (k = 0; k < FIR_TAPS; k++)
+    {
+        coeffs15[k] = RandomQ15(0.06);
+        coeffs31[k] = RandomQ31(0.06);
+    }
+    for (n = 0; n < FILTER_LENGTH; n++)
+    {
+        Q15In[n] = RandomQ15(0.9);
+        Q31In[n] = RandomQ31(0.9);
+    }
+    CHECK_EQUAL(ARM_MATH_SUCCESS, arm_fir_init_q15(&fir15, FIR_TAPS, coeffs15, state15, FIR_BLOCK));
+    arm_fir_init_q31(&fir31, FIR_TAPS, coeffs31, state31, FIR_BLOCK);
+
+    /* Blocks: the state carries the samples over */
+    for (n = 0; n < FILTER_LENGTH; n += FIR_BLOCK)
+    {
+        arm_fir_q15(&fir15, &Q15In[n], &Q15Out[n], FIR_BLOCK);
+        arm_fir_q31(&fir31, &Q31In[n], &Q31Out[n], FIR_BLOCK);
+    }
+
+    /* Coefficients in time reversed order, as CMSIS */
+    for (n = 0; n < FILTER_LENGTH; n++)
+    {
+        sum15 = 0;
+        sum31 = 0;
+        for (k = 0; (k < FIR_TAPS) && (k <= n); k++)
+        {
+            sum15 += (coeffs15[FIR_TAPS - 1 - k] / Q15_ONE) * Q15In[n - k];
+            sum31 += (coeffs31[FIR_TAPS - 1 - k] / Q31_ONE) * Q31In[n - k];
+        }
+        q15Error = MaxError(q15Error, sum15, Q15Out[n]);
+        q31Error = MaxError(q31Error, sum31, Q31Out[n]);
+    }
+
+    CHECK(q15Error <= FIR_TOLERANCE);
+    CHECK(q31Error <= FIR_TOLERANCE);
+}
+
+static void Test_Biquad(void)
+{
+    static q15_t coeffs15[6 * BIQUAD_STAGES];
+    static q31_t coeffs31[5 * BIQUAD_STAGES];
+    static q15_t state15[4 * BIQUAD_STAGES];
+    static q31_t state31[4 * BIQUAD_STAGES];
+    arm_biquad_casd_df1_inst_q15 biquad15;
+    arm_biquad_casd_df1_inst_q31 biquad31;
+    double c15[5];
+    double c31[5];
+    double x15[3];
+    double x31[3];
+    double y15[3];
+    double y31[3];
+    uint32_t stage;
+    uint32_t n;
+    uint32_t i;
+    double q15Error = 0;
+    double q31Error = 0;
+
+    InitDsp();
+
+    /* q15 stages are b0, 0, b1, b2, a1, a2 */
+    for (stage = 0; stage < BIQUAD_STAGES; stage++)
+    {
+        coeffs15[6 * stage] = (q15_t)lrint(BiquadStages[stage][0] * Q15_ONE);
+        coeffs15[6 * stage + 1] = 0;
+        for (i = 1; i < 5; i++)
+        {
+            coeffs15[6 * stage + 1 + i] = (q15_t)lrint(BiquadStages[stage][i] * Q15_ONE);
+        }
+        for (i = 0; i < 5; i++)
+        {
+            coeffs31[5 * stage + i] = (q31_t)llrint(BiquadStages[stage][i] * Q31_ONE);
+        }
+    }
+    arm_biquad_cascade_df1_init_q15(&biquad15, BIQUAD_STAGES, coeffs15, state15, 1);
+    arm_biquad_cascade_df1_init_q31(&biquad31, BIQUAD_STAGES, coeffs31, state31, 1);
+
+    for (n = 0; n < FILTER_LENGTH; n++)
+    {
+        Q15In[n] = RandomQ15(0.5);
+        Q31In[n] = RandomQ31(0.5);
+        Samples[n] = Q15In[n];
+        Reference[n] = Q31In[n];
+    }
+    arm_biquad_cascade_df1_q15(&biquad15, Q15In, Q15Out, FILTER_LENGTH / 2);
+    arm_biquad_cascade_df1_q15(&biquad15, &Q15In[FILTER_LENGTH / 2], &Q15Out[FILTER_LENGTH / 2], FILTER_LENGTH / 2);
+    arm_biquad_cascade_df1_q31(&biquad31, Q31In, Q31Out, FILTER_LENGTH);
+
+    /* Each stage in double precision with the quantized coefficients,
+       times 2 for the postShift */
+    for (stage = 0; stage < BIQUAD_STAGES; stage++)
+    {
+        c15[0] = coeffs15[6 * stage] / Q15_ONE;
+        for (i = 1; i < 5; i++)
+        {
+            c15[i] = coeffs15[6 * stage + 1 + i] / Q15_ONE;
+        }
+        for (i = 0; i < 5; i++)
+        {
+            c31[i] = coeffs31[5 * stage + i] / Q31_ONE;
+        }
+
+        x15[1] = x15[2] = y15[1] = y15[2] = 0;
+        x31[1] = x31[2] = y31[1] = y31[2] = 0;
+        for (n = 0; n < FILTER_LENGTH; n++)
+        {
+            x15[0] = Samples[n];
+            x31[0] = Reference[n];
+            y15[0] = 2 * ((c15[0] * x15[0]) + (c15[1] * x15[1]) + (c15[2] * x15[2]) + (c15[3] * y15[1]) + (c15[4] * y15[2]));
+            y31[0] = 2 * ((c31[0] * x31[0]) + (c31[1] * x31[1]) + (c31[2] * x31[2]) + (c31[3] * y31[1]) + (c31[4] * y31[2]));
+            x15[2] = x15[1];
+            x15[1] = x15[0];
+            y15[2] = y15[1];
+            y15[1] = y15[0];
+            x31[2] = x31[1];
+            x31[1] = x31[0];
+            y31[2] = y31[1];
+            y31[1] = y31[0];
+            Samples[n] = y15[0];
+            Reference[n] = y31[0];
+        }
+    }
+
+    for (n = 0; n < FILTER_LENGTH; n++)
+    {
+        q15Error = MaxError(q15Error, Samples[n], Q15Out[n]);
+        q31Error = MaxError(q31Error, Reference[n], Q31Out[n]);
+    }
+
+    CHECK(q15Error <= BIQUAD_Q15_TOLERANCE);
+    CHECK(q31Error <= BIQUAD_Q31_TOLERANCE);
+}
+
+static void Test_MovingAverage(void)
+{
+    static const uint16_t windows[] = {8, 10, 25};
+    static q15_t state15[32];
+    static q31_t state31[32];
+    arm_moving_average_instance_q15 average15;
+    arm_moving_average_instance_q31 average31;
+    uint32_t w;
+    uint32_t n;
+    uint32_t k;
+    double sum15;
+    double sum31;
+    double q15Error = 0;
+    double q31Error = 0;
+
+    InitDsp();
+
+    for (w = 0; w < sizeof(windows) / sizeof(windows[0]); w++)
+    {
+        CHECK_EQUAL(ARM_MATH_SUCCESS, arm_moving_average_init_q15(&average15, windows[w], state15));
+        CHECK_EQUAL(ARM_MATH_SUCCESS, arm_moving_average_init_q31(&average31, windows[w], state31));
+
+        /* Full scale samples, with the most negative ones */
+        for (n = 0; n < FILTER_LENGTH; n++)
+        {
+            Q15In[n] = (n == 5) ? INT16_MIN : (q15_t)Random();
+            Q31In[n] = (n == 7) ? INT32_MIN : (q31_t)Random();
+        }
+        arm_moving_average_q15(&average15, Q15In, Q15Out, 100);
+        arm_moving_average_q15(&average15, &Q15In[100], &Q15Out[100], FILTER_LENGTH - 100);
+        arm_moving_average_q31(&average31, Q31In, Q31Out, FILTER_LENGTH);
+
+        /* The window starts filled with zeros */
+        for (n = 0; n < FILTER_LENGTH; n++)
+        {
+            sum15 = 0;
+            sum31 = 0;
+            for (k = 0; (k < windows[w]) && (k <= n); k++)
+            {
+                sum15 += Q15In[n - k];
+                sum31 += Q31In[n - k];
+            }
+            q15Error = MaxError(q15Error, sum15 / windows[w], Q15Out[n]);
+            q31Error = MaxError(q31Error, sum31 / windows[w], Q31Out[n]);
+        }
+    }
+
+    CHECK(q15Error <= AVERAGE_Q15_TOLERANCE);
+    CHECK(q31Error <= AVERAGE_Q31_TOLERANCE);
+    CHECK(arm_moving_average_init_q15(&average15, 0, state15) != ARM_MATH_SUCCESS);
+}
+
+static void Test_Statistics(void)
+{
+    uint32_t length = 77;
+    uint32_t index;
+    uint32_t n;
+    q15_t value15;
+    q31_t value31;
+    double sum15 = 0;
+    double sum31 = 0;
+    double power15 = 0;
+    double power31 = 0;
+
+    InitDsp();
+
+    for (n = 0; n < length; n++)
+    {
+        Q15In[n] = (q15_t)Random();
+        Q31In[n] = (q31_t)Random();
+    }
+
+    /* The first of equal extremes */
+    Q15In[10] = INT16_MIN;
+    Q15In[40] = INT16_MAX;
+    Q15In[60] = INT16_MAX;
+    Q31In[3] = INT32_MIN;
+    Q31In[50] = INT32_MAX;
+    Q31In[70] = INT32_MAX;
+    arm_max_q15(Q15In, length, &value15, &index);
+    CHECK_EQUAL(INT16_MAX, value15);
+    CHECK_EQUAL(40, index);
+    arm_min_q15(Q15In, length, &value15, &index);
+    CHECK_EQUAL(INT16_MIN, value15);
+    CHECK_EQUAL(10, index);
+    arm_max_q31(Q31In, length, &value31, &index);
+    CHECK_EQUAL(INT32_MAX, value31);
+    CHECK_EQUAL(50, index);
+    arm_min_q31(Q31In, length, &value31, &index);
+    CHECK_EQUAL(INT32_MIN, value31);
+    CHECK_EQUAL(3, index);
+
+    for (n = 0; n < length; n++)
+    {
+        sum15 += Q15In[n];
+        sum31 += Q31In[n];
+        power15 += (double)Q15In[n] * Q15In[n];
+        power31 += (double)Q31In[n] * Q31In[n];
+    }
+    arm_mean_q15(Q15In, length, &value15);
+    CHECK(fabs((sum15 / length) - value15) <= STATISTICS_TOLERANCE);
+    arm_mean_q31(Q31In, length, &value31);
+    CHECK(fabs((sum31 / length) - value31) <= STATISTICS_TOLERANCE);
+    arm_rms_q15(Q15In, length, &value15);
+    CHECK(fabs(sqrt(power15 / length) - value15) <= STATISTICS_TOLERANCE);
+    arm_rms_q31(Q31In, length, &value31);
+    CHECK(fabs(sqrt(power31 / length) - value31) <= STATISTICS_TOLERANCE);
+}
+
+static void Test_Sqrt(void)
+{
+    uint32_t i;
+    q15_t result15;
+    q31_t input31;
+    q31_t result31;
+    double q15Error = 0;
+    double q31Error = 0;
+
+    InitDsp();
+
+    for (i = 0; i < 32768; i++)
+    {
+        CHECK_EQUAL(ARM_MATH_SUCCESS, arm_sqrt_q15((q15_t)i, &result15));
+        q15Error = MaxError(q15Error, sqrt(i / Q15_ONE) * Q15_ONE, result15);
+    }
+    CHECK_EQUAL(ARM_MATH_ARGUMENT_ERROR, arm_sqrt_q15(-1, &result15));
+    CHECK_EQUAL(0, result15);
+
+    for (i = 0; i < 20000; i++)
+    {
+        input31 = (i == 0) ? INT32_MAX : ((i == 1) ? 1 : ((i == 2) ? 0 : (q31_t)(Random() >> (1 + (i % 24)))));
+        CHECK_EQUAL(ARM_MATH_SUCCESS, arm_sqrt_q31(input31, &result31));
+        q31Error = MaxError(q31Error, sqrt(input31 / Q31_ONE) * Q31_ONE, result31);
+    }
+    CHECK_EQUAL(ARM_MATH_ARGUMENT_ERROR, arm_sqrt_q31(-5, &result31));
+
+    CHECK(q15Error <= SQRT_TOLERANCE);
+    CHECK(q31Error <= SQRT_TOLERANCE);
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    HOSTTEST_RUN(Test_MultQ63);
+    HOSTTEST_RUN(Test_Cfft);
+    HOSTTEST_RUN(Test_Rfft);
+    HOSTTEST_RUN(Test_Fir);
+    HOSTTEST_RUN(Test_Biquad);
+    HOSTTEST_RUN(Test_MovingAverage);
+    HOSTTEST_RUN(Test_Statistics);
+    HOSTTEST_RUN(Test_Sqrt);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,186 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_dvsq.c
+* @brief:     DVSQ driver on the DVSQ model: scalar and vector divisions and
+*             square roots against the C operators, cycle count of the
+*             pipelined vector functions.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include "hk32l0xx.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define VECTOR_SIZE                 64U
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t Dividends[VECTOR_SIZE];
+static uint32_t Divisors[VECTOR_SIZE];
+static uint32_t Quotients[VECTOR_SIZE];
+static uint32_t Remainders[VECTOR_SIZE];
+static uint32_t Seed = 0x2468ACE1;
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t Random(void)
+{
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 17;
+    Seed ^= Seed << 5;
+    return Seed;
+}
+
+static void FillOperands(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < VECTOR_SIZE; i++)
+    {
+        Dividends[i] = Random();
+        Divisors[i] = Random() >> (Random() % 31U);
+        if (Divisors[i] == 0)
+        {
+            Divisors[i] = 7;
+        }
+    }
+    Dividends[0] = 0x80000000UL;
+    Divisors[0] = 0xFFFFFFFFUL;
+    Dividends[1] = 0xFFFFFFFFUL;
+    Divisors[1] = 1;
+}
+
+static void Test_Division(void)
+{
+    uint32_t uremainder;
+    int32_t remainder;
+    uint32_t i;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DVSQ, ENABLE);
+    DVSQ_Init();
+    FillOperands();
+
+    for (i = 1; i < VECTOR_SIZE; i++)
+    {
+        CHECK_EQUAL(Dividends[i] / Divisors[i], DVSQ_UDivsion(Dividends[i], Divisors[i], &uremainder));
+        CHECK_EQUAL(Dividends[i] % Divisors[i], uremainder);
+        CHECK_EQUAL((int32_t)Dividends[i] / (int32_t)Divisors[i],
+                    DVSQ_Divsion((int32_t)Dividends[i], (int32_t)Divisors[i], &remainder));
+        CHECK_EQUAL((int32_t)Dividends[i] % (int32_t)Divisors[i], remainder);
+    }
+
+    /* Overflow and division by zero set their flags */
+    DVSQ_Divsion(INT32_MIN, -1, &remainder);
+    CHECK((DVSQ->CSR & DVSQ_CSR_OV_FLAG) != 0);
+    DVSQ_UDivsion(1234, 0, &uremainder);
+    CHECK((DVSQ->CSR & DVSQ_CSR_DZ_FLAG) != 0);
+    CHECK_EQUAL(1234, uremainder);
+}
+
+static void Test_DivisionVector(void)
+{
+    int32_t squotients[VECTOR_SIZE];
+    int32_t sremainders[VECTOR_SIZE];
+    uint32_t i;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DVSQ, ENABLE);
+    DVSQ_Init();
+    FillOperands();
+
+    DVSQ_UDivsionVector(Dividends + 1, Divisors + 1, Quotients, Remainders, VECTOR_SIZE - 1);
+    DVSQ_DivsionVector((const int32_t*)Dividends + 1, (const int32_t*)Divisors + 1,
+                       squotients, sremainders, VECTOR_SIZE - 1);
+
+    for (i = 1; i < VECTOR_SIZE; i++)
+    {
+        CHECK_EQUAL(Dividends[i] / Divisors[i], Quotients[i - 1]);
+        CHECK_EQUAL(Dividends[i] % Divisors[i], Remainders[i - 1]);
+        CHECK_EQUAL((int32_t)Dividends[i] / (int32_t)Divisors[i], squotients[i - 1]);
+        CHECK_EQUAL((int32_t)Dividends[i] % (int32_t)Divisors[i], sremainders[i - 1]);
+    }
+
+    /* The remainders are optional */
+    DVSQ_UDivsionVector(Dividends + 1, Divisors + 1, Quotients, NULL, VECTOR_SIZE - 1);
+    CHECK_EQUAL(Dividends[2] / Divisors[2], Quotients[1]);
+}
+
+static void Test_SquareRoot(void)
+{
+    uint16_t fraction;
+    uint16_t root;
+    uint64_t hroot;
+    uint32_t radicand;
+    uint32_t i;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DVSQ, ENABLE);
+    DVSQ_Init();
+
+    for (i = 0; i < 200; i++)
+    {
+        radicand = (i < 4) ? (uint32_t)(0xFFFFFFFFUL - i) : Random();
+
+        CHECK_EQUAL((uint32_t)floor(sqrt((double)radicand)), DVSQ_Sqrt(radicand));
+        CHECK_EQUAL(DVSQ_ModelSqrt(radicand), DVSQ_Sqrt(radicand));
+
+        /* High precision: the 16.16 result is floor(sqrt(radicand << 32)) */
+        root = DVSQ_SqrtH(radicand, &fraction);
+        hroot = ((uint64_t)root << 16) | fraction;
+        CHECK(((unsigned __int128)hroot * hroot <= ((uint64_t)radicand << 32)) &&
+              ((unsigned __int128)(hroot + 1) * (hroot + 1) > ((uint64_t)radicand << 32)));
+        CHECK_EQUAL(root, DVSQ_ModelSqrtH(radicand, &fraction));
+    }
+
+    FillOperands();
+    DVSQ_SqrtVector(Dividends, Quotients, VECTOR_SIZE);
+    for (i = 0; i < VECTOR_SIZE; i++)
+    {
+        CHECK_EQUAL(DVSQ_ModelSqrt(Dividends[i]), Quotients[i]);
+    }
+}
+
+static void Test_VectorCycles(void)
+{
+    uint32_t remainder;
+    uint64_t start;
+    uint64_t scalar;
+    uint64_t vector;
+    uint32_t operations;
+    uint32_t i;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DVSQ, ENABLE);
+    DVSQ_Init();
+    FillOperands();
+    operations = HostDvsq_Operations();
+
+    start = HostSim_Cycles();
+    for (i = 1; i < VECTOR_SIZE; i++)
+    {
+        Quotients[i] = DVSQ_UDivsion(Dividends[i], Divisors[i], &remainder);
+    }
+    scalar = HostSim_Cycles() - start;
+
+    start = HostSim_Cycles();
+    DVSQ_UDivsionVector(Dividends + 1, Divisors + 1, Quotients, Remainders, VECTOR_SIZE - 1);
+    vector = HostSim_Cycles() - start;
+
+    printf("DVSQ %u divisions: scalar %llu bus cycles, vector %llu bus cycles\n",
+           VECTOR_SIZE - 1, (unsigned long long)scalar, (unsigned long long)vector);
+    CHECK(vector <= scalar);
+    CHECK_EQUAL(2U * (VECTOR_SIZE - 1), HostDvsq_Operations() - operations);
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    HOSTTEST_RUN(Test_Division);
+    HOSTTEST_RUN(Test_DivisionVector);
+    HOSTTEST_RUN(Test_SquareRoot);
+    HOSTTEST_RUN(Test_VectorCycles);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,410 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_emacc.c
+* @brief:     EMACC driver on the EMACC model: the batch of samples advanced
+*             by EMACC_CalPoll() returns at once, keeps the order of the
+*             samples and calls the callback once at its end. EMACC_ModelCal()
+*             against a double precision reference of the chain and, stage by
+*             stage, against the results of the EMACC model.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include "hk32l0xx.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define BATCH_SIZE                  16U
+#define SWEEP_SIZE                  512U
+#define TEST_PI                     3.14159265358979323846
+
+/* PI of the tests: Kp = 1, Ki = 1/256 per sample */
+#define TEST_KP                     1024
+#define TEST_KP_DIV                 10U
+#define TEST_KI                     64
+#define TEST_KI_DIV                 14U
+#define TEST_INTEGRAL_LIMIT         (32767L << TEST_KI_DIV)
+
+/* Private typedef -----------------------------------------------------------*/
+/**
+  * @brief  Double precision reference of the chain with its PI state.
+  */
+typedef struct
+{
+    double IntegralD;
+    double IntegralQ;
+    double Cos;
+    double Sin;
+    double Ialpha;
+    double Ibeta;
+    double Iq;
+    double Id;
+    double Vq;
+    double Vd;
+    double Valpha;
+    double Vbeta;
+} Reference_TypeDef;
+
+/**
+  * @brief  Largest differences found by a sweep, in q15 LSB.
+  */
+typedef struct
+{
+    double Trig;
+    double Clarke;
+    double Park;
+    double PI;
+    double Output;
+    uint32_t Limited;
+} Error_TypeDef;
+
+/* Private variables ---------------------------------------------------------*/
+static EMACC_PI_InitTypeDef PIConfig =
+{
+    ((uint32_t)TEST_KP << 16) | TEST_KI,
+    (uint32_t)TEST_INTEGRAL_LIMIT,
+    (uint32_t)-TEST_INTEGRAL_LIMIT,
+    32767,
+    -32767,
+    TEST_KP_DIV,
+    TEST_KI_DIV
+};
+
+static EMACC_Sample Samples[BATCH_SIZE];
+static Volt_Components Results[BATCH_SIZE];
+static Volt_Components LastResult;
+static uint32_t CallbackCount;
+
+/* Private functions ---------------------------------------------------------*/
+static void Callback(Volt_Components Valphabeta)
+{
+    LastResult = Valphabeta;
+    CallbackCount++;
+}
+
+static void FillSamples(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < BATCH_SIZE; i++)
+    {
+        Samples[i].hElAngle = (int16_t)(i * 4096U);
+        Samples[i].Iab.qI_Component1 = (int16_t)(1000 + (int32_t)i);
+        Samples[i].Iab.qI_Component2 = (int16_t)(-2000 - (int32_t)i);
+        Results[i].qV_Component1 = 0;
+        Results[i].qV_Component2 = 0;
+    }
+}
+
+static void Init(EMACC_ModelTypeDef* Model)
+{
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_EMACC, ENABLE);
+    EMACC_Init(&PIConfig, &PIConfig);
+    EMACC_ModelInit(Model, &PIConfig, &PIConfig);
+}
+
+/**
+  * @brief  Sample Index of a sweep: the electrical angle turns twice, the
+  *         phase currents of amplitude Amplitude lag it by Lag.
+  */
+static void SweepSample(uint32_t Index, double Amplitude, double Lag, int16_t* Angle, Curr_Components* Iab)
+{
+    double theta = 4.0 * TEST_PI * Index / SWEEP_SIZE;
+
+    *Angle = (int16_t)(uint16_t)(Index * 2U * 65536U / SWEEP_SIZE);
+    Iab->qI_Component1 = (int16_t)lround(Amplitude * cos(theta - Lag));
+    Iab->qI_Component2 = (int16_t)lround(Amplitude * cos(theta - Lag - 2.0 * TEST_PI / 3.0));
+}
+
+static double Clamp(double Value, double Lower, double Upper)
+{
+    return (Value > Upper) ? Upper : ((Value < Lower) ? Lower : Value);
+}
+
+static double ReferencePI(double* Integral, double Error)
+{
+    *Integral = Clamp(*Integral + TEST_KI * Error, -TEST_INTEGRAL_LIMIT, TEST_INTEGRAL_LIMIT);
+
+    return Clamp(TEST_KP * Error / (1 << TEST_KP_DIV) + *Integral / (1 << TEST_KI_DIV), -32767.0, 32767.0);
+}
+
+/**
+  * @brief  The chain in double precision: exact sine and cosine, no
+  *         rounding between the stages, the circle limitation scales the
+  *         voltage back to the circle exactly.
+  */
+static void ReferenceCal(Reference_TypeDef* Ref, int16_t Angle, Curr_Components Iab, Curr_Components Iqdref)
+{
+    double theta = Angle * TEST_PI / 32768.0;
+    double module;
+
+    Ref->Cos = 32768.0 * cos(theta);
+    Ref->Sin = 32768.0 * sin(theta);
+    Ref->Ialpha = Iab.qI_Component1;
+    Ref->Ibeta = -(Iab.qI_Component1 + 2.0 * Iab.qI_Component2) / sqrt(3.0);
+    Ref->Iq = (Ref->Ialpha * Ref->Cos - Ref->Ibeta * Ref->Sin) / 32768.0;
+    Ref->Id = (Ref->Ialpha * Ref->Sin + Ref->Ibeta * Ref->Cos) / 32768.0;
+    Ref->Vq = ReferencePI(&Ref->IntegralQ, Iqdref.qI_Component1 - Ref->Iq);
+    Ref->Vd = ReferencePI(&Ref->IntegralD, Iqdref.qI_Component2 - Ref->Id);
+
+    module = sqrt(Ref->Vq * Ref->Vq + Ref->Vd * Ref->Vd);
+    if (module > CIRCLELIM_MAXMODULE)
+    {
+        Ref->Vq *= CIRCLELIM_MAXMODULE / module;
+        Ref->Vd *= CIRCLELIM_MAXMODULE / module;
+    }
+
+    Ref->Valpha = (Ref->Vq * Ref->Cos + Ref->Vd * Ref->Sin) / 32768.0;
+    Ref->Vbeta = (Ref->Vd * Ref->Cos - Ref->Vq * Ref->Sin) / 32768.0;
+}
+
+static void Worst(double* Error, double Value)
+{
+    Value = fabs(Value);
+    *Error = (Value > *Error) ? Value : *Error;
+}
+
+/**
+  * @brief  EMACC_ModelCal() and the double precision reference on a sweep.
+  */
+static void SweepReference(double Amplitude, Curr_Components Iqdref, Error_TypeDef* Error)
+{
+    EMACC_ModelTypeDef model;
+    Reference_TypeDef ref = {0};
+    Volt_Components result;
+    Curr_Components iab;
+    int16_t angle;
+    uint32_t i;
+
+    EMACC_ModelInit(&model, &PIConfig, &PIConfig);
+
+    for (i = 0; i < SWEEP_SIZE; i++)
+    {
+        SweepSample(i, Amplitude, 0.3, &angle, &iab);
+        result = EMACC_ModelCal(&model, angle, iab, Iqdref);
+        ReferenceCal(&ref, angle, iab, Iqdref);
+
+        Worst(&Error->Trig, model.hCos - Clamp(ref.Cos, -32767.0, 32767.0));
+        Worst(&Error->Trig, model.hSin - Clamp(ref.Sin, -32767.0, 32767.0));
+        Worst(&Error->Clarke, model.Ialphabeta.qI_Component1 - ref.Ialpha);
+        Worst(&Error->Clarke, model.Ialphabeta.qI_Component2 - ref.Ibeta);
+        Worst(&Error->Park, model.Iqd.qI_Component1 - ref.Iq);
+        Worst(&Error->Park, model.Iqd.qI_Component2 - ref.Id);
+        Worst(&Error->PI, model.Vqd.qV_Component1 - ref.Vq);
+        Worst(&Error->PI, model.Vqd.qV_Component2 - ref.Vd);
+        Worst(&Error->Output, result.qV_Component1 - ref.Valpha);
+        Worst(&Error->Output, result.qV_Component2 - ref.Vbeta);
+
+        if (ref.Vq * ref.Vq + ref.Vd * ref.Vd > (CIRCLELIM_MAXMODULE - 1.0) * (CIRCLELIM_MAXMODULE - 1.0))
+        {
+            Error->Limited++;
+        }
+    }
+}
+
+/**
+  * @brief  EMACC_ModelCal() and the EMACC model on a sweep, stage by stage.
+  */
+static void SweepRegisters(double Amplitude, Curr_Components Iqdref, Error_TypeDef* Error)
+{
+    EMACC_ModelTypeDef model;
+    Volt_Components result;
+    Volt_Components expected;
+    Curr_Components iab;
+    int16_t angle;
+    uint32_t i;
+
+    Init(&model);
+
+    for (i = 0; i < SWEEP_SIZE; i++)
+    {
+        SweepSample(i, Amplitude, 0.3, &angle, &iab);
+        expected = EMACC_ModelCal(&model, angle, iab, Iqdref);
+        result = EMACC_Cal(angle, iab, Iqdref);
+
+        Worst(&Error->Trig, model.hCos - (int16_t)EMACC_GetCordicOutCosx());
+        Worst(&Error->Trig, model.hSin - (int16_t)EMACC_GetCordicOutSinx());
+        Worst(&Error->Clarke, model.Ialphabeta.qI_Component1 - (int16_t)EMACC_GetClarkeOutIalpha());
+        Worst(&Error->Clarke, model.Ialphabeta.qI_Component2 - (int16_t)EMACC_GetClarkeOutIbeta());
+        Worst(&Error->Park, model.Iqd.qI_Component1 - (int16_t)EMACC_GetParkOutIq());
+        Worst(&Error->Park, model.Iqd.qI_Component2 - (int16_t)EMACC_GetParkOutId());
+        Worst(&Error->PI, model.Vqd.qV_Component1 - (int16_t)EMACC_GetPIDOutVq());
+        Worst(&Error->PI, model.Vqd.qV_Component2 - (int16_t)EMACC_GetPIDOutVd());
+        Worst(&Error->Output, expected.qV_Component1 - result.qV_Component1);
+        Worst(&Error->Output, expected.qV_Component2 - result.qV_Component2);
+
+        if (((int32_t)model.Vqd.qV_Component1 * model.Vqd.qV_Component1 +
+             (int32_t)model.Vqd.qV_Component2 * model.Vqd.qV_Component2) >
+            (int32_t)(CIRCLELIM_MAXMODULE - 600) * (CIRCLELIM_MAXMODULE - 600))
+        {
+            Error->Limited++;
+        }
+    }
+}
+
+static void Test_Single(void)
+{
+    EMACC_ModelTypeDef model;
+    Curr_Components iqdref = {100, -100};
+    Curr_Components iab = {1234, -4321};
+    Volt_Components expected;
+    Volt_Components result;
+
+    Init(&model);
+    expected = EMACC_ModelCal(&model, 0, iab, iqdref);
+    result = EMACC_Cal(0, iab, iqdref);
+    CHECK(abs(expected.qV_Component1 - result.qV_Component1) <= 2);
+    CHECK(abs(expected.qV_Component2 - result.qV_Component2) <= 2);
+    CHECK_EQUAL(0, EMACC->SR & EMACC_SR_RPARK_CF);
+}
+
+/**
+  * @brief  EMACC_CalBatch() only starts the first sample, each poll that
+  *         finds a result stores it and starts the next sample.
+  */
+static void Test_Batch(void)
+{
+    EMACC_ModelTypeDef model;
+    Curr_Components iqdref = {100, -100};
+    Volt_Components expected;
+    uint32_t calculations = HostEmacc_Calculations();
+    uint32_t callbacks = CallbackCount;
+    uint64_t start;
+    uint32_t i;
+
+    Init(&model);
+    EMACC_SetCalCallback(Callback);
+    FillSamples();
+
+    start = HostSim_Cycles();
+    EMACC_CalBatch(Samples, iqdref, Results, BATCH_SIZE);
+    CHECK(HostSim_Cycles() - start < HOSTEMACC_CHAIN_CYCLES);
+    CHECK_EQUAL(BATCH_SIZE, EMACC_GetCalBatchCount());
+    CHECK_EQUAL(calculations + 1U, HostEmacc_Calculations());
+
+    /* Polled while the chain is running: nothing is done */
+    EMACC_CalPoll();
+    CHECK_EQUAL(BATCH_SIZE, EMACC_GetCalBatchCount());
+
+    while (EMACC_GetCalBatchCount() != 0)
+    {
+        EMACC_CalPoll();
+    }
+
+    /* In order, the PI integral terms carried from one sample to the next */
+    CHECK_EQUAL(calculations + BATCH_SIZE, HostEmacc_Calculations());
+    for (i = 0; i < BATCH_SIZE; i++)
+    {
+        expected = EMACC_ModelCal(&model, Samples[i].hElAngle, Samples[i].Iab, iqdref);
+        CHECK(abs(expected.qV_Component1 - Results[i].qV_Component1) <= 2);
+        CHECK(abs(expected.qV_Component2 - Results[i].qV_Component2) <= 2);
+    }
+
+    /* One callback, with the last result */
+    CHECK_EQUAL(callbacks + 1U, CallbackCount);
+    CHECK_EQUAL(Results[BATCH_SIZE - 1U].qV_Component1, LastResult.qV_Component1);
+    CHECK_EQUAL(Results[BATCH_SIZE - 1U].qV_Component2, LastResult.qV_Component2);
+
+    /* Nothing left: the poll does not start another chain */
+    EMACC_CalPoll();
+    CHECK_EQUAL(calculations + BATCH_SIZE, HostEmacc_Calculations());
+    CHECK_EQUAL(callbacks + 1U, CallbackCount);
+
+    EMACC_SetCalCallback(0);
+}
+
+static void Test_EmptyBatch(void)
+{
+    Curr_Components iqdref = {0, 0};
+    uint32_t calculations = HostEmacc_Calculations();
+
+    EMACC_CalBatch(Samples, iqdref, Results, 0);
+    CHECK_EQUAL(0, EMACC_GetCalBatchCount());
+    CHECK_EQUAL(calculations, HostEmacc_Calculations());
+}
+
+/**
+  * @brief  EMACC_ModelCal() against the double precision reference, within
+  *         and beyond the circle limitation.
+  */
+static void Test_ModelReference(void)
+{
+    Curr_Components small = {2000, -500};
+    Curr_Components large = {30000, 20000};
+    Error_TypeDef linear = {0};
+    Error_TypeDef limited = {0};
+
+    SweepReference(8000.0, small, &linear);
+    SweepReference(20000.0, large, &limited);
+
+    printf("EMACC_ModelCal - reference: sin/cos %.2f, Clarke %.2f, Park %.2f, PI %.2f, "
+           "output %.2f LSB, limited %.2f LSB\n",
+           linear.Trig, linear.Clarke, linear.Park, linear.PI, linear.Output, limited.Output);
+
+    CHECK_EQUAL(0, linear.Limited);
+    CHECK(linear.Trig <= 2.0);
+    CHECK(linear.Clarke <= 2.0);
+    CHECK(linear.Park <= 3.0);
+    CHECK(linear.PI <= 4.0);
+    CHECK(linear.Output <= 6.0);
+
+    /* The circle limitation table scales by steps of up to 1.5 % */
+    CHECK(limited.Limited > SWEEP_SIZE / 2U);
+    CHECK(limited.Output <= 0.015 * CIRCLELIM_MAXMODULE);
+}
+
+/**
+  * @brief  EMACC_ModelCal() against the stage registers of the EMACC model.
+  */
+static void Test_ModelRegisters(void)
+{
+    Curr_Components small = {2000, -500};
+    Error_TypeDef error = {0};
+
+    SweepRegisters(8000.0, small, &error);
+
+    printf("EMACC_ModelCal - EMACC: sin/cos %.0f, Clarke %.0f, Park %.0f, PI %.0f, output %.0f LSB\n",
+           error.Trig, error.Clarke, error.Park, error.PI, error.Output);
+
+    CHECK(error.Trig <= 2.0);
+    CHECK(error.Clarke <= 1.0);
+    CHECK(error.Park <= 3.0);
+    CHECK(error.PI <= 4.0);
+    CHECK(error.Output <= 6.0);
+}
+
+/**
+  * @brief  Beyond the circle limitation both use the table of the PID RAM:
+  *         the few LSB between their PI outputs may select the next entry.
+  */
+static void Test_ModelRegistersLimited(void)
+{
+    Curr_Components large = {30000, 20000};
+    Error_TypeDef error = {0};
+
+    SweepRegisters(20000.0, large, &error);
+
+    CHECK(error.Limited > SWEEP_SIZE / 2U);
+    CHECK(error.Park <= 4.0);
+    CHECK(error.PI <= 0.015 * CIRCLELIM_MAXMODULE);
+    CHECK(error.Output <= 0.015 * CIRCLELIM_MAXMODULE);
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    HOSTTEST_RUN(Test_Single);
+    HOSTTEST_RUN(Test_Batch);
+    HOSTTEST_RUN(Test_EmptyBatch);
+    HOSTTEST_RUN(Test_ModelReference);
+    HOSTTEST_RUN(Test_ModelRegisters);
+    HOSTTEST_RUN(Test_ModelRegistersLimited);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
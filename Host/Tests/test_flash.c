@@ -0,0 +1,253 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_flash.c
+* @brief:     FLASH driver on the FLASH model: lock, erase, word and buffer
+*             programming, interrupt driven buffer programming, errors, power
+*             loss in the middle of an operation.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "hk32l0xx.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_PAGE                   ((uint32_t)0x0800E000)
+#define TEST_WORDS                  256U
+
+/* Private macro -------------------------------------------------------------*/
+#define FLASH_WORD(Address)         (*(volatile const uint32_t*)(Address))
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t Data[TEST_WORDS];
+
+/* Private functions ---------------------------------------------------------*/
+static void FillData(uint32_t Seed)
+{
+    uint32_t i;
+
+    for (i = 0; i < TEST_WORDS; i++)
+    {
+        Data[i] = (i * 0x9E3779B9UL) ^ Seed;
+    }
+}
+
+static uint8_t IsErased(uint32_t Address, uint32_t Size)
+{
+    uint32_t i;
+
+    for (i = 0; i < Size; i += 4)
+    {
+        if (FLASH_WORD(Address + i) != 0xFFFFFFFFUL)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void Test_Lock(void)
+{
+    /* Locked: the CR write and the program are refused */
+    CHECK_EQUAL(FLASH_ERROR_PROGRAM, FLASH_ProgramWord(TEST_PAGE, 0x12345678));
+    CHECK_EQUAL(0xFFFFFFFF, FLASH_WORD(TEST_PAGE));
+    FLASH_ClearFlag(FLASH_FLAG_PGERR);
+
+    FLASH_Unlock();
+    CHECK((FLASH->CR & FLASH_CR_LOCK) == 0);
+    CHECK_EQUAL(FLASH_COMPLETE, FLASH_ProgramWord(TEST_PAGE, 0x12345678));
+    CHECK_EQUAL(0x12345678, FLASH_WORD(TEST_PAGE));
+
+    FLASH_Lock();
+    CHECK((FLASH->CR & FLASH_CR_LOCK) != 0);
+}
+
+static void Test_EraseProgram(void)
+{
+    uint32_t i;
+
+    FLASH_Unlock();
+    for (i = 0; i < 1024U; i += 4)
+    {
+        CHECK_EQUAL(FLASH_COMPLETE, FLASH_ProgramWord(TEST_PAGE + i, i));
+    }
+    CHECK_EQUAL(FLASH_COMPLETE, FLASH_ProgramWord(TEST_PAGE + 1024, 0xA5A5A5A5));
+
+    /* A programmed word cannot be programmed again, but to zero */
+    CHECK_EQUAL(FLASH_ERROR_PROGRAM, FLASH_ProgramWord(TEST_PAGE + 4, 0xFFFF0000));
+    CHECK_EQUAL(4, FLASH_WORD(TEST_PAGE + 4));
+    FLASH_ClearFlag(FLASH_FLAG_PGERR);
+    CHECK_EQUAL(FLASH_COMPLETE, FLASH_ProgramWord(TEST_PAGE + 4, 0));
+
+    /* Half page, then page: the next page is kept */
+    CHECK_EQUAL(FLASH_COMPLETE, FLASH_HalfErasePage(TEST_PAGE + 512));
+    CHECK(IsErased(TEST_PAGE + 512, 512));
+    CHECK_EQUAL(0x1FC, FLASH_WORD(TEST_PAGE + 0x1FC));
+
+    CHECK_EQUAL(FLASH_COMPLETE, FLASH_ErasePage(TEST_PAGE));
+    CHECK(IsErased(TEST_PAGE, 1024));
+    CHECK_EQUAL(0xA5A5A5A5, FLASH_WORD(TEST_PAGE + 1024));
+
+    CHECK_EQUAL(FLASH_COMPLETE, FLASH_EraseAllPages());
+    CHECK(IsErased(HOSTSIM_FLASH_BASE, HOSTSIM_FLASH_SIZE));
+    FLASH_Lock();
+}
+
+static void Test_ProgramBuffer(void)
+{
+    uint64_t start;
+    uint64_t single;
+    uint64_t buffer;
+    uint32_t i;
+
+    FillData(0x5A5A0000);
+    FLASH_Unlock();
+
+    start = HostSim_Cycles();
+    for (i = 0; i < TEST_WORDS; i++)
+    {
+        FLASH_ProgramWord(TEST_PAGE + i * 4U, Data[i]);
+    }
+    single = HostSim_Cycles() - start;
+    CHECK_MEMORY(Data, (const void*)TEST_PAGE, sizeof(Data));
+
+    FLASH_ErasePage(TEST_PAGE);
+    start = HostSim_Cycles();
+    CHECK_EQUAL(FLASH_COMPLETE, FLASH_ProgramBuffer(TEST_PAGE, Data, TEST_WORDS));
+    buffer = HostSim_Cycles() - start;
+    CHECK_MEMORY(Data, (const void*)TEST_PAGE, sizeof(Data));
+
+    printf("FLASH 1 KB: FLASH_ProgramWord %llu bus cycles, FLASH_ProgramBuffer %llu bus cycles\n",
+           (unsigned long long)single, (unsigned long long)buffer);
+    CHECK(buffer < single);
+    CHECK(buffer >= (uint64_t)TEST_WORDS * HOSTFLASH_PROGRAM_CYCLES);
+
+    /* An error stops the buffer on the failing word */
+    FillData(0);
+    CHECK_EQUAL(FLASH_ERROR_PROGRAM, FLASH_ProgramBuffer(TEST_PAGE, Data, TEST_WORDS));
+    CHECK((FLASH->CR & FLASH_CR_WPG) == 0);
+    FLASH_ClearFlag(FLASH_FLAG_PGERR);
+    FLASH_Lock();
+}
+
+void FLASH_IRQHandler(void)
+{
+    FLASH_ProgramBufferIRQHandler();
+}
+
+static void Test_ProgramBufferIT(void)
+{
+    NVIC_InitTypeDef nvic;
+    uint32_t idle = 0;
+
+    FillData(0x0F0F0F0F);
+    nvic.NVIC_IRQChannel = FLASH_IRQn;
+    nvic.NVIC_IRQChannelPriority = 0;
+    nvic.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&nvic);
+
+    FLASH_Unlock();
+    CHECK_EQUAL(FLASH_COMPLETE, FLASH_ProgramBufferIT(TEST_PAGE, Data, TEST_WORDS));
+    CHECK_EQUAL(FLASH_BUSY, FLASH_ProgramBufferIT(TEST_PAGE, Data, TEST_WORDS));
+
+    /* The CPU sleeps between the words */
+    while (FLASH_GetProgramBufferStatus() == FLASH_BUSY)
+    {
+        __WFI();
+        idle++;
+    }
+    CHECK_EQUAL(FLASH_COMPLETE, FLASH_GetProgramBufferStatus());
+    CHECK_MEMORY(Data, (const void*)TEST_PAGE, sizeof(Data));
+    CHECK_EQUAL(TEST_WORDS, idle);
+    CHECK((FLASH->CR & (FLASH_CR_WPG | FLASH_IT_EOP | FLASH_IT_ERR)) == 0);
+
+    /* Error in the middle of a buffer */
+    FLASH_ErasePage(TEST_PAGE);
+    FLASH_ProgramWord(TEST_PAGE + 16, 0);
+    CHECK_EQUAL(FLASH_COMPLETE, FLASH_ProgramBufferIT(TEST_PAGE, Data, TEST_WORDS));
+    while (FLASH_GetProgramBufferStatus() == FLASH_BUSY)
+    {
+        __WFI();
+    }
+    CHECK_EQUAL(FLASH_ERROR_PROGRAM, FLASH_GetProgramBufferStatus());
+    CHECK_EQUAL(Data[3], FLASH_WORD(TEST_PAGE + 12));
+    CHECK(IsErased(TEST_PAGE + 20, 1024 - 20));
+    FLASH_ClearFlag(FLASH_FLAG_PGERR);
+    FLASH_Lock();
+}
+
+static void Test_WriteProtection(void)
+{
+    /* Sector 14 holds the test page */
+    HostFlash_SetWriteProtection(1UL << ((TEST_PAGE - HOSTSIM_FLASH_BASE) / 4096U));
+
+    FLASH_Unlock();
+    CHECK_EQUAL(FLASH_ERROR_WRP, FLASH_ProgramWord(TEST_PAGE, 0));
+    FLASH_ClearFlag(FLASH_FLAG_WRPERR);
+    CHECK_EQUAL(FLASH_ERROR_WRP, FLASH_ErasePage(TEST_PAGE));
+    FLASH_ClearFlag(FLASH_FLAG_WRPERR);
+    CHECK_EQUAL(FLASH_COMPLETE, FLASH_ProgramWord(TEST_PAGE - 4, 0));
+    CHECK(IsErased(TEST_PAGE, 4096));
+    FLASH_Lock();
+}
+
+static void Test_PowerLoss(void)
+{
+    static uint8_t resets;
+    int reason;
+
+    FillData(0x33CC33CC);
+    resets = 0;
+
+    reason = HOSTSIM_POWER_ON();
+    if (reason == 0)
+    {
+        FLASH_Unlock();
+        HostFlash_PowerLossAt(HostFlash_Operations() + 3U);
+        FLASH_ProgramBuffer(TEST_PAGE, Data, TEST_WORDS);
+        CHECK(0);
+    }
+    resets++;
+
+    /* Two words programmed, the third one torn, the rest erased */
+    CHECK_EQUAL(HOSTSIM_RESET_POWER_LOSS, reason);
+    CHECK_EQUAL(1, resets);
+    CHECK((FLASH->CR & FLASH_CR_LOCK) != 0);
+    CHECK_MEMORY(Data, (const void*)TEST_PAGE, 8);
+    CHECK(FLASH_WORD(TEST_PAGE + 8) != Data[2]);
+    CHECK(FLASH_WORD(TEST_PAGE + 8) != 0xFFFFFFFFUL);
+    CHECK(IsErased(TEST_PAGE + 12, 1024 - 12));
+
+    /* An erase cut in the middle leaves the end of the page programmed */
+    reason = HOSTSIM_POWER_ON();
+    if (reason == 0)
+    {
+        FLASH_Unlock();
+        FLASH_ErasePage(TEST_PAGE);
+        FLASH_ProgramBuffer(TEST_PAGE, Data, TEST_WORDS);
+        HostFlash_PowerLossAt(HostFlash_Operations() + 1U);
+        FLASH_ErasePage(TEST_PAGE);
+        CHECK(0);
+    }
+    CHECK_EQUAL(HOSTSIM_RESET_POWER_LOSS, reason);
+    CHECK(IsErased(TEST_PAGE, 512));
+    CHECK_MEMORY(&Data[128], (const void*)(TEST_PAGE + 512), 512);
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    HOSTTEST_RUN(Test_Lock);
+    HOSTTEST_RUN(Test_EraseProgram);
+    HOSTTEST_RUN(Test_ProgramBuffer);
+    HOSTTEST_RUN(Test_ProgramBufferIT);
+    HOSTTEST_RUN(Test_WriteProtection);
+    HOSTTEST_RUN(Test_PowerLoss);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,430 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_iap.c
+* @brief:     Firmware update library on the FLASH and CRC models, with the
+*             port callbacks of the FLASH_IAP examples: an update over a link
+*             that loses and corrupts frames, rejected images, and power
+*             losses at random flash operations of the update and of the
+*             bootloader copy.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "iap_core.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+/* Layout of the 64 Kbytes of the FLASH model */
+#define APP_OFFSET                  ((uint32_t)0x00004000)
+#define STAGING_OFFSET              ((uint32_t)0x00009000)
+#define IMAGE_SIZE                  ((uint32_t)0x00005000)
+#define RECORD_OFFSET               ((uint32_t)0x0000E000)
+#define HALF_PAGE_SIZE              ((uint32_t)0x00000200)
+
+#define TEST_IMAGE_SIZE             0x4321U     /* Last chunk ends inside a word */
+#define POWER_LOSSES                60U
+
+#define IMAGE(n)                    ((uint8_t*)ImageWords[n])
+
+/* Private variables ---------------------------------------------------------*/
+static IAP_Status FlashErase(uint32_t Offset);
+static IAP_Status FlashProgram(uint32_t Offset, const uint32_t* pData, uint32_t NbWords);
+static void CrcInit(void);
+static void CrcUpdate(const uint8_t* pData, uint32_t Length);
+static uint32_t CrcFinal(void);
+static void Send(const uint8_t* pData, uint32_t Length);
+
+static const IAP_PortTypeDef Port =
+{
+    (const uint8_t*)IAP_FLASH_BASE,
+    APP_OFFSET,
+    STAGING_OFFSET,
+    IMAGE_SIZE,
+    RECORD_OFFSET,
+    HALF_PAGE_SIZE,
+    FlashErase,
+    FlashProgram,
+    CrcInit,
+    CrcUpdate,
+    CrcFinal,
+    NULL,
+    Send
+};
+
+static CRC_ContextTypeDef CrcContext = {0xFFFFFFFF, 0xFFFFFFFF, ENABLE, ENABLE, NULL, 0};
+
+static IAP_UpdateTypeDef Update;
+/* Word aligned for FlashProgram() */
+static uint32_t ImageWords[2][(TEST_IMAGE_SIZE + 3U) / 4U];
+static uint8_t Frame[IAP_FRAME_SIZE_MAX];
+static uint8_t Payload[IAP_FRAME_PAYLOAD_SIZE];
+static uint8_t Response[IAP_RESPONSE_SIZE];
+static const uint8_t Idle[IAP_FRAME_SIZE_MAX];
+static uint32_t ResponseLength;
+static uint16_t Sequence;
+static uint32_t Seed;
+
+/* Link faults, one frame in LinkFaults is lost or corrupted */
+static uint32_t LinkFaults;
+static uint32_t Retries;
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Port callbacks of the examples.
+  */
+static IAP_Status FlashErase(uint32_t Offset)
+{
+    FLASH_Status status;
+
+    FLASH_Unlock();
+    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPERR | FLASH_FLAG_SIZE_ERR);
+    status = FLASH_HalfErasePage(IAP_FLASH_BASE + Offset);
+    FLASH_Lock();
+
+    return (status == FLASH_COMPLETE) ? IAP_OK : IAP_FLASH_ERROR;
+}
+
+static IAP_Status FlashProgram(uint32_t Offset, const uint32_t* pData, uint32_t NbWords)
+{
+    FLASH_Status status;
+
+    FLASH_Unlock();
+    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPERR | FLASH_FLAG_SIZE_ERR);
+    status = FLASH_ProgramBuffer(IAP_FLASH_BASE + Offset, pData, NbWords);
+    FLASH_Lock();
+
+    return (status == FLASH_COMPLETE) ? IAP_OK : IAP_FLASH_ERROR;
+}
+
+static void CrcInit(void)
+{
+    CRC_StreamInit(&CrcContext);
+}
+
+static void CrcUpdate(const uint8_t* pData, uint32_t Length)
+{
+    CRC_StreamUpdate(&CrcContext, pData, Length);
+}
+
+static uint32_t CrcFinal(void)
+{
+    return CRC_StreamFinal(&CrcContext);
+}
+
+static void Send(const uint8_t* pData, uint32_t Length)
+{
+    CHECK(Length <= sizeof(Response));
+    memcpy(Response, pData, Length);
+    ResponseLength = Length;
+}
+
+static uint32_t Random(void)
+{
+    Seed = Seed * 1103515245UL + 12345UL;
+    return Seed >> 16;
+}
+
+static void FillImage(uint8_t* Data, uint32_t Seed0)
+{
+    uint32_t i;
+
+    for (i = 0; i < TEST_IMAGE_SIZE; i++)
+    {
+        Seed0 = Seed0 * 1103515245UL + 12345UL;
+        Data[i] = (uint8_t)(Seed0 >> 16);
+    }
+}
+
+static uint32_t ImageCrc(const uint8_t* Data)
+{
+    CRC_ContextTypeDef context = {0xFFFFFFFF, 0xFFFFFFFF, ENABLE, ENABLE, NULL, 0};
+
+    CRC_StreamInit(&context);
+    CRC_StreamUpdateSoft(&context, Data, TEST_IMAGE_SIZE);
+    return CRC_StreamFinal(&context);
+}
+
+static void PutWord(uint8_t* Data, uint32_t Value)
+{
+    Data[0] = (uint8_t)Value;
+    Data[1] = (uint8_t)(Value >> 8);
+    Data[2] = (uint8_t)(Value >> 16);
+    Data[3] = (uint8_t)(Value >> 24);
+}
+
+/**
+  * @brief  Host side of the link: sends a frame until its response comes.
+  * @param  pStaged: receives the staged bytes of the response.
+  * @retval Status of the response.
+  */
+static IAP_Status Exchange(uint8_t Type, uint16_t Length, uint32_t* pStaged)
+{
+    uint16_t size;
+    uint16_t crc;
+    uint32_t trial;
+
+    size = IAP_FrameBuild(Frame, Type, ++Sequence, Payload, Length);
+
+    for (trial = 0; trial < 20U; trial++)
+    {
+        ResponseLength = 0;
+
+        if ((LinkFaults != 0) && ((Random() % LinkFaults) == 0))
+        {
+            /* Corrupted byte, or frame lost */
+            if ((Random() & 1U) != 0)
+            {
+                Frame[Random() % size] ^= (uint8_t)(1U + Random() % 255U);
+                IAP_UpdateReceive(&Update, Frame, size);
+                IAP_FrameBuild(Frame, Type, Sequence, Payload, Length);
+            }
+        }
+        else
+        {
+            IAP_UpdateReceive(&Update, Frame, size);
+        }
+
+        IAP_UpdateProcess(&Update);
+
+        if ((ResponseLength == IAP_RESPONSE_SIZE) && (Response[1] == (Type | IAP_FRAME_RESPONSE)) &&
+            (Response[2] == (uint8_t)Sequence) && (Response[3] == (uint8_t)(Sequence >> 8)))
+        {
+            crc = IAP_Crc16(0xFFFF, &Response[1], IAP_RESPONSE_SIZE - 3U);
+            CHECK_EQUAL(crc, Response[IAP_RESPONSE_SIZE - 2] | (Response[IAP_RESPONSE_SIZE - 1] << 8));
+            *pStaged = Response[7] | ((uint32_t)Response[8] << 8) | ((uint32_t)Response[9] << 16) |
+                       ((uint32_t)Response[10] << 24);
+            return (IAP_Status)Response[6];
+        }
+
+        /* Timeout: a garbled length may hold the receiver in a payload,
+           idle bytes flush it */
+        Retries++;
+        IAP_UpdateReceive(&Update, Idle, sizeof(Idle));
+        IAP_UpdateProcess(&Update);
+    }
+
+    CHECK(0);
+    return IAP_INVALID;
+}
+
+/**
+  * @brief  Sends an image: START, DATA from the staged bytes, END.
+  * @retval Status of the END frame.
+  */
+static IAP_Status SendImage(const uint8_t* Data, uint32_t Crc)
+{
+    uint32_t staged = 0;
+    uint32_t offset = 0;
+    uint32_t length;
+    IAP_Status status;
+
+    PutWord(Payload, TEST_IMAGE_SIZE);
+    PutWord(Payload + 4, Crc);
+    PutWord(Payload + 8, 2);
+    if (!CHECK_EQUAL(IAP_OK, Exchange(IAP_FRAME_START, 12, &staged)))
+    {
+        return IAP_INVALID;
+    }
+
+    while (offset < TEST_IMAGE_SIZE)
+    {
+        length = TEST_IMAGE_SIZE - offset;
+        length = (length > IAP_CHUNK_SIZE) ? IAP_CHUNK_SIZE : length;
+        PutWord(Payload, offset);
+        memcpy(Payload + 4, Data + offset, length);
+
+        status = Exchange(IAP_FRAME_DATA, (uint16_t)(length + 4U), &staged);
+        if ((status != IAP_OK) && (status != IAP_SEQUENCE))
+        {
+            return status;
+        }
+        offset = staged;
+    }
+
+    return Exchange(IAP_FRAME_END, 0, &staged);
+}
+
+/**
+  * @brief  Programs an image in the application region, as a debugger would.
+  */
+static void LoadApplication(const uint8_t* Data)
+{
+    uint32_t offset;
+
+    for (offset = 0; offset < IMAGE_SIZE; offset += HALF_PAGE_SIZE)
+    {
+        FlashErase(APP_OFFSET + offset);
+    }
+    FlashProgram(APP_OFFSET, (const uint32_t*)Data, (TEST_IMAGE_SIZE + 3U) / 4U);
+}
+
+static uint8_t ApplicationIs(const uint8_t* Data)
+{
+    return (uint8_t)(memcmp((const void*)(IAP_FLASH_BASE + APP_OFFSET), Data, TEST_IMAGE_SIZE) == 0);
+}
+
+static void Test_Update(void)
+{
+    const uint32_t* record = (const uint32_t*)(IAP_FLASH_BASE + RECORD_OFFSET);
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC, ENABLE);
+    FillImage(IMAGE(0), 1);
+    FillImage(IMAGE(1), 2);
+    LoadApplication(IMAGE(0));
+    CHECK_EQUAL(0, IAP_BootPending(&Port));
+    CHECK_EQUAL(IAP_NO_UPDATE, IAP_BootUpdate(&Port));
+
+    IAP_UpdateInit(&Update, &Port);
+    LinkFaults = 0;
+    CHECK_EQUAL(IAP_OK, SendImage(IMAGE(1), ImageCrc(IMAGE(1))));
+    CHECK_EQUAL(IAP_STATE_COMMITTED, Update.State);
+    CHECK_EQUAL(0, Update.RxErrors);
+    CHECK_MEMORY(IMAGE(1), (const void*)(IAP_FLASH_BASE + STAGING_OFFSET), TEST_IMAGE_SIZE);
+
+    /* The END response was lost: the retransmission is acknowledged */
+    CHECK_EQUAL(IAP_OK, Exchange(IAP_FRAME_END, 0, &Update.Staged));
+
+    CHECK_EQUAL(1, IAP_BootPending(&Port));
+    CHECK(ApplicationIs(IMAGE(0)));
+    CHECK_EQUAL(IAP_OK, IAP_BootUpdate(&Port));
+    CHECK(ApplicationIs(IMAGE(1)));
+    CHECK_EQUAL(IAP_DONE, record[IAP_RECORD_DONE]);
+    CHECK_EQUAL(2, record[IAP_RECORD_VERSION]);
+    CHECK_EQUAL(0, IAP_BootPending(&Port));
+}
+
+/**
+  * @brief  One frame in 4 lost or corrupted: the sender retransmits and
+  *         resumes from the staged bytes.
+  */
+static void Test_LinkErrors(void)
+{
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC, ENABLE);
+    FillImage(IMAGE(0), 3);
+    FillImage(IMAGE(1), 4);
+    LoadApplication(IMAGE(0));
+
+    IAP_UpdateInit(&Update, &Port);
+    Seed = 7;
+    Retries = 0;
+    LinkFaults = 4;
+    CHECK_EQUAL(IAP_OK, SendImage(IMAGE(1), ImageCrc(IMAGE(1))));
+    LinkFaults = 0;
+    printf("%u frames received, %u with errors, %u retransmissions\n",
+           Update.RxFrames, Update.RxErrors, Retries);
+    CHECK(Update.RxErrors != 0);
+    CHECK(Retries != 0);
+
+    CHECK_EQUAL(IAP_OK, IAP_BootUpdate(&Port));
+    CHECK(ApplicationIs(IMAGE(1)));
+}
+
+/**
+  * @brief  Images with a wrong CRC are not committed, a staged image
+  *         damaged after the commit is rejected by the bootloader.
+  */
+static void Test_Rejected(void)
+{
+    const uint32_t* record = (const uint32_t*)(IAP_FLASH_BASE + RECORD_OFFSET);
+    uint32_t zero = 0;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC, ENABLE);
+    FillImage(IMAGE(0), 5);
+    FillImage(IMAGE(1), 6);
+    LoadApplication(IMAGE(0));
+
+    IAP_UpdateInit(&Update, &Port);
+    CHECK_EQUAL(IAP_CRC_ERROR, SendImage(IMAGE(1), ImageCrc(IMAGE(1)) ^ 1U));
+    CHECK_EQUAL(IAP_STATE_ERROR, Update.State);
+    CHECK_EQUAL(0, IAP_BootPending(&Port));
+
+    CHECK_EQUAL(IAP_OK, SendImage(IMAGE(1), ImageCrc(IMAGE(1))));
+    CHECK_EQUAL(IAP_OK, FlashProgram(STAGING_OFFSET + 0x100U, &zero, 1));
+    CHECK_EQUAL(IAP_CRC_ERROR, IAP_BootUpdate(&Port));
+    CHECK_EQUAL(IAP_REJECTED, record[IAP_RECORD_DONE]);
+    CHECK_EQUAL(0, IAP_BootPending(&Port));
+    CHECK(ApplicationIs(IMAGE(0)));
+}
+
+/**
+  * @brief  Power cut at a random flash operation of an update and of the
+  *         bootloader copy that follows. After each restart the bootloader
+  *         runs: the application must be the old image or, once the copy is
+  *         done, the new one.
+  */
+static void Test_PowerLoss(void)
+{
+    static uint32_t losses;
+    static uint32_t copies;
+    static uint8_t current;
+    IAP_Status status;
+
+    losses = 0;
+    copies = 0;
+    current = 0;
+    Seed = 11;
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC, ENABLE);
+    FillImage(IMAGE(0), 100);
+    LoadApplication(IMAGE(0));
+    FillImage(IMAGE(1), 101);
+
+    if (HOSTSIM_POWER_ON() == HOSTSIM_RESET_POWER_LOSS)
+    {
+        losses++;
+    }
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC, ENABLE);
+
+    /* Bootloader */
+    if (IAP_BootPending(&Port) != 0)
+    {
+        copies++;
+        status = IAP_BootUpdate(&Port);
+        CHECK_EQUAL(IAP_OK, status);
+        CHECK(ApplicationIs(IMAGE(current ^ 1U)));
+    }
+
+    if (ApplicationIs(IMAGE(current ^ 1U)))
+    {
+        /* Update done: next image */
+        current ^= 1U;
+        FillImage(IMAGE(current ^ 1U), 102U + losses);
+    }
+    else if (!CHECK(ApplicationIs(IMAGE(current))))
+    {
+        return;
+    }
+
+    if (losses == POWER_LOSSES)
+    {
+        printf("%u power losses, %u bootloader copies\n", POWER_LOSSES, copies);
+        CHECK(copies > POWER_LOSSES / 4U);
+        return;
+    }
+
+    /* Application: update, then reset to the bootloader. About half of the
+       power losses occur during the update, the others during the copy */
+    HostFlash_PowerLossAt(HostFlash_Operations() + 1U + Random() % (2U * (TEST_IMAGE_SIZE / 4U + 80U)));
+    IAP_UpdateInit(&Update, &Port);
+    CHECK_EQUAL(IAP_OK, SendImage(IMAGE(current ^ 1U), ImageCrc(IMAGE(current ^ 1U))));
+    CHECK_EQUAL(IAP_OK, IAP_BootUpdate(&Port));
+    HostFlash_PowerLossAt(0);
+    HostSim_SystemReset();
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    HOSTTEST_RUN(Test_Update);
+    HOSTTEST_RUN(Test_LinkErrors);
+    HOSTTEST_RUN(Test_Rejected);
+    HOSTTEST_RUN(Test_PowerLoss);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
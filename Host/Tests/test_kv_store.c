@@ -0,0 +1,382 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_kv_store.c
+* @brief:     Key/value store of the FLASH_KVStore example on the FLASH model,
+*             reached through the same callbacks as the example: writes,
+*             deletes and compactions, wear levelling, flash errors, and
+*             power losses in the middle of every kind of operation.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "kv_store.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define KV_AREA_ADDR                ((uint32_t)0x0800C000)
+#define KV_SET_SIZE                 ((uint32_t)0x00000800)  /* 2 pages */
+#define KV_HALF_PAGE_SIZE           ((uint32_t)0x00000200)
+#define KV_NB_SETS                  4
+#define KV_INDEX_SIZE               32U
+#define KV_AREA_WRP                 (3UL << 12)             /* Sectors of the store area */
+
+#define NB_KEYS                     24U
+#define POWER_LOSSES                400U
+
+/* Private variables ---------------------------------------------------------*/
+static KVStore_Status FlashProgram(uint32_t Offset, uint32_t Data);
+static KVStore_Status FlashEraseHalfPage(uint32_t Offset);
+
+static const KVStore_FlashTypeDef Flash =
+{
+    (const uint32_t*)KV_AREA_ADDR,
+    KV_SET_SIZE,
+    KV_HALF_PAGE_SIZE,
+    KV_NB_SETS,
+    FlashProgram,
+    FlashEraseHalfPage
+};
+
+static KVStore_TypeDef Store;
+static uint32_t Index[KV_INDEX_SIZE];
+static uint8_t Value[KVSTORE_MAX_LENGTH];
+static uint8_t Buffer[KVSTORE_MAX_LENGTH];
+
+/* Committed version of each key, 0 if deleted. Static: kept across power losses */
+static uint32_t Version[NB_KEYS];
+static uint32_t NextVersion;
+static uint32_t Seed;
+
+/* Operation in progress when the power was cut */
+static uint16_t PendingKey;
+static uint32_t PendingVersion;
+static uint8_t Pending;
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Flash callbacks of the example.
+  */
+static KVStore_Status FlashProgram(uint32_t Offset, uint32_t Data)
+{
+    FLASH_Status status;
+
+    FLASH_Unlock();
+    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPERR | FLASH_FLAG_SIZE_ERR);
+    status = FLASH_ProgramWord(KV_AREA_ADDR + Offset, Data);
+    FLASH_Lock();
+
+    return (status == FLASH_COMPLETE) ? KVSTORE_OK : KVSTORE_FLASH_ERROR;
+}
+
+static KVStore_Status FlashEraseHalfPage(uint32_t Offset)
+{
+    FLASH_Status status;
+
+    FLASH_Unlock();
+    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPERR | FLASH_FLAG_SIZE_ERR);
+    status = FLASH_HalfErasePage(KV_AREA_ADDR + Offset);
+    FLASH_Lock();
+
+    return (status == FLASH_COMPLETE) ? KVSTORE_OK : KVSTORE_FLASH_ERROR;
+}
+
+static uint32_t Random(void)
+{
+    Seed = Seed * 1103515245UL + 12345UL;
+    return Seed >> 16;
+}
+
+/**
+  * @brief  Value of a key version: 4 to 40 bytes.
+  */
+static uint32_t MakeValue(uint16_t Key, uint32_t Ver)
+{
+    uint32_t length = 4U + (Ver * 7U + Key) % 37U;
+    uint32_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        Value[i] = (uint8_t)(Ver * 31U + Key * 5U + i);
+    }
+    return length;
+}
+
+/**
+  * @brief  Checks that the store holds the version of a key.
+  */
+static uint8_t HoldsVersion(uint16_t Key, uint32_t Ver)
+{
+    uint32_t length = 0;
+    KVStore_Status status = KVStore_Read(&Store, Key, Buffer, sizeof(Buffer), &length);
+
+    if (Ver == 0)
+    {
+        return (uint8_t)(status == KVSTORE_NOT_FOUND);
+    }
+    return (uint8_t)((status == KVSTORE_OK) && (length == MakeValue(Key, Ver)) &&
+                     (memcmp(Buffer, Value, length) == 0));
+}
+
+static KVStore_Status WriteVersion(uint16_t Key, uint32_t Ver)
+{
+    uint32_t length = MakeValue(Key, Ver);
+
+    return KVStore_Write(&Store, Key, Value, length);
+}
+
+/**
+  * @brief  Writes records of a key until less than a deletion record is left.
+  * @retval First byte of the last value.
+  */
+static uint8_t FillLog(uint16_t Key)
+{
+    uint8_t i;
+
+    for (i = 0; KVStore_GetFree(&Store) >= 12U; i++)
+    {
+        Value[0] = i;
+        /* 3 words, or 4 if 3 would leave room for a deletion record */
+        CHECK_EQUAL(KVSTORE_OK, KVStore_Write(&Store, Key, Value, (KVStore_GetFree(&Store) == 20U) ? 8U : 4U));
+    }
+    CHECK(KVStore_GetFree(&Store) < 8U);
+
+    return Value[0];
+}
+
+static void Mount(void)
+{
+    CHECK_EQUAL(KVSTORE_OK, KVStore_Mount(&Store, &Flash, Index, KV_INDEX_SIZE));
+}
+
+static void Test_WriteRead(void)
+{
+    uint32_t i;
+    uint32_t pending;
+    uint32_t low;
+    uint32_t high;
+    uint16_t key;
+
+    memset(Version, 0, sizeof(Version));
+    Mount();
+    CHECK_EQUAL(KVSTORE_NOT_FOUND, KVStore_Read(&Store, 1, Buffer, sizeof(Buffer), 0));
+    CHECK_EQUAL(KVSTORE_INVALID, KVStore_Write(&Store, KVSTORE_KEY_INVALID, Value, 4));
+
+    /* Enough writes for several laps of the page sets */
+    for (i = 1; i <= 2000U; i++)
+    {
+        key = (uint16_t)(i % NB_KEYS);
+        CHECK_EQUAL(KVSTORE_OK, WriteVersion(key, i));
+        Version[key] = i;
+        CHECK_EQUAL(KVSTORE_OK, KVStore_Maintain(&Store, 0));
+    }
+    CHECK(Store.Compactions >= 4U * KV_NB_SETS);
+
+    /* An unchanged value is not written again */
+    i = Store.ProgramWords;
+    CHECK_EQUAL(KVSTORE_OK, WriteVersion(3, Version[3]));
+    CHECK_EQUAL(i, Store.ProgramWords);
+
+    CHECK_EQUAL(KVSTORE_OK, KVStore_Delete(&Store, 5));
+    CHECK_EQUAL(KVSTORE_NOT_FOUND, KVStore_Delete(&Store, 5));
+    Version[5] = 0;
+
+    do
+    {
+        CHECK_EQUAL(KVSTORE_OK, KVStore_Maintain(&Store, &pending));
+    }
+    while (pending != 0);
+
+    /* Same content after a remount */
+    Mount();
+    for (key = 0; key < NB_KEYS; key++)
+    {
+        CHECK(HoldsVersion(key, Version[key]));
+    }
+    CHECK_EQUAL(NB_KEYS - 1U, Store.NbKeys);
+
+    /* Erase counts within one of each other */
+    low = Store.Wear[0];
+    high = Store.Wear[0];
+    for (i = 1; i < KV_NB_SETS; i++)
+    {
+        low = (Store.Wear[i] < low) ? Store.Wear[i] : low;
+        high = (Store.Wear[i] > high) ? Store.Wear[i] : high;
+    }
+    CHECK(high - low <= 1U);
+}
+
+/**
+  * @brief  A delete on a full log compacts without the key.
+  */
+static void Test_DeleteFull(void)
+{
+    uint8_t last;
+    uint32_t compactions;
+
+    Mount();
+    CHECK_EQUAL(KVSTORE_OK, WriteVersion(1, 1));
+    last = FillLog(2);
+    compactions = Store.Compactions;
+
+    CHECK_EQUAL(KVSTORE_OK, KVStore_Delete(&Store, 1));
+    CHECK_EQUAL(compactions + 1U, Store.Compactions);
+    CHECK(HoldsVersion(1, 0));
+
+    Mount();
+    CHECK(HoldsVersion(1, 0));
+    CHECK_EQUAL(KVSTORE_OK, KVStore_Read(&Store, 2, Buffer, sizeof(Buffer), 0));
+    CHECK_EQUAL(last, Buffer[0]);
+}
+
+/**
+  * @brief  Flash errors are returned and leave the key readable.
+  */
+static void Test_FlashErrors(void)
+{
+    uint8_t last;
+    uint32_t compactions;
+    uint32_t pending;
+    uint32_t before;
+
+    Mount();
+    CHECK_EQUAL(KVSTORE_OK, WriteVersion(1, 1));
+    CHECK_EQUAL(KVSTORE_OK, WriteVersion(2, 2));
+
+    /* Deletion record refused */
+    HostFlash_SetWriteProtection(KV_AREA_WRP);
+    CHECK_EQUAL(KVSTORE_FLASH_ERROR, KVStore_Delete(&Store, 1));
+    CHECK(HoldsVersion(1, 1));
+    CHECK_EQUAL(2, Store.NbKeys);
+    HostFlash_SetWriteProtection(0);
+
+    /* Full log: the compaction dropping the key is refused */
+    last = FillLog(2);
+    compactions = Store.Compactions;
+    HostFlash_SetWriteProtection(KV_AREA_WRP);
+    CHECK_EQUAL(KVSTORE_FLASH_ERROR, KVStore_Delete(&Store, 1));
+    CHECK(HoldsVersion(1, 1));
+    CHECK_EQUAL(2, Store.NbKeys);
+    CHECK_EQUAL(compactions, Store.Compactions);
+    HostFlash_SetWriteProtection(0);
+
+    /* The failed copy is erased before the set is used again */
+    do
+    {
+        CHECK_EQUAL(KVSTORE_OK, KVStore_Maintain(&Store, &pending));
+    }
+    while (pending != 0);
+
+    CHECK_EQUAL(KVSTORE_OK, KVStore_Delete(&Store, 1));
+    CHECK(HoldsVersion(1, 0));
+
+    /* Erase of the released set refused, then retried */
+    CHECK_EQUAL(KVSTORE_OK, KVStore_Maintain(&Store, &before));
+    CHECK(before != 0);
+    HostFlash_SetWriteProtection(KV_AREA_WRP);
+    CHECK_EQUAL(KVSTORE_FLASH_ERROR, KVStore_Maintain(&Store, &pending));
+    CHECK_EQUAL(before, pending);
+    HostFlash_SetWriteProtection(0);
+    CHECK_EQUAL(KVSTORE_OK, KVStore_Maintain(&Store, &pending));
+    CHECK_EQUAL(before - 1U, pending);
+
+    Mount();
+    CHECK(HoldsVersion(1, 0));
+    CHECK_EQUAL(KVSTORE_OK, KVStore_Read(&Store, 2, Buffer, sizeof(Buffer), 0));
+    CHECK_EQUAL(last, Buffer[0]);
+}
+
+/**
+  * @brief  Random writes, deletes and erase steps, the power cut in the
+  *         middle of a random flash operation. After each restart the mount
+  *         must succeed and every committed value be there; the operation
+  *         cut may be done or not.
+  */
+static void Test_PowerLoss(void)
+{
+    static uint32_t losses;
+    static uint32_t worst;
+    uint32_t i;
+    uint16_t key;
+
+    losses = 0;
+    worst = 0;
+    Pending = 0;
+    NextVersion = 1;
+    Seed = 12345;
+    memset(Version, 0, sizeof(Version));
+
+    if (HOSTSIM_POWER_ON() != 0)
+    {
+        losses++;
+    }
+
+    Mount();
+    worst = (Store.MountWords > worst) ? Store.MountWords : worst;
+
+    for (key = 0; key < NB_KEYS; key++)
+    {
+        if ((Pending != 0) && (key == PendingKey) && HoldsVersion(key, PendingVersion))
+        {
+            Version[key] = PendingVersion;
+        }
+        if (!CHECK(HoldsVersion(key, Version[key])))
+        {
+            return;
+        }
+    }
+    Pending = 0;
+
+    if (losses == POWER_LOSSES)
+    {
+        printf("%u power losses, %u words read by a mount at most\n", POWER_LOSSES, worst);
+        return;
+    }
+
+    HostFlash_PowerLossAt(HostFlash_Operations() + 1U + Random() % 200U);
+
+    while (1)
+    {
+        key = (uint16_t)(Random() % NB_KEYS);
+        PendingKey = key;
+        Pending = 1;
+
+        if ((Random() % 8U) == 0)
+        {
+            PendingVersion = 0;
+            if (KVStore_Delete(&Store, key) != KVSTORE_NOT_FOUND)
+            {
+                Version[key] = 0;
+            }
+        }
+        else
+        {
+            PendingVersion = NextVersion++;
+            CHECK_EQUAL(KVSTORE_OK, WriteVersion(key, PendingVersion));
+            Version[key] = PendingVersion;
+        }
+        Pending = 0;
+
+        for (i = Random() % 3U; i != 0; i--)
+        {
+            CHECK_EQUAL(KVSTORE_OK, KVStore_Maintain(&Store, 0));
+        }
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    HOSTTEST_RUN(Test_WriteRead);
+    HOSTTEST_RUN(Test_DeleteFull);
+    HOSTTEST_RUN(Test_FlashErrors);
+    HOSTTEST_RUN(Test_PowerLoss);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,299 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_msc_read.c
+* @brief:     Read_Memory of the Mass_Storage example (MSC_COMPOSITE: of the
+*             MSC_CustomHIDComposite example) on a timed model of the bulk IN
+*             endpoint and of the FLASH reads: data sent, read-ahead of the
+*             next block while the current one is on the bus.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "usb_lib.h"
+#include "usb_bot.h"
+#include "usb_scsi.h"
+#include "memory.h"
+#include "mass_mal.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#if defined(MSC_COMPOSITE)
+#define TEST_BLOCK_SIZE             4096U   /* FLASH_SectorSize */
+#define TEST_EP_BUFFERS             1U      /* single buffered EP2 IN */
+#else
+#define TEST_BLOCK_SIZE             MAL_BLOCK_SIZE
+#define TEST_EP_BUFFERS             2U      /* double buffered EP1 IN */
+#endif
+#define TEST_BLOCKS                 6U
+#define TEST_MEDIUM_BLOCKS          (TEST_BLOCKS + 2U)
+#define TEST_PACKETS                (TEST_BLOCKS * TEST_BLOCK_SIZE / BULK_MAX_PACKET_SIZE)
+
+/* Time units: one byte on the SPI bus of the FLASH, a read command costs 4
+   bytes plus the chip select, a full speed 64 byte packet about 60 */
+#define READ_COMMAND_TIME           5U
+#define READ_BYTE_TIME              1U
+#define PACKET_TIME                 60U
+
+#define READ_TIME(Length)           (READ_COMMAND_TIME + (Length) * READ_BYTE_TIME)
+
+/* Private variables ---------------------------------------------------------*/
+/* Globals of the example used by memory.c */
+uint8_t Bulk_Data_Buff[BULK_MAX_PACKET_SIZE];
+uint16_t Data_Len;
+uint8_t Bot_State;
+uint8_t Bot_Tx_Pending;
+Bulk_Only_CSW CSW;
+uint32_t Mass_Block_Size[2];
+
+static uint8_t Medium[TEST_MEDIUM_BLOCKS * TEST_BLOCK_SIZE];
+static uint8_t Received[TEST_PACKETS * BULK_MAX_PACKET_SIZE];
+static uint32_t ReceivedLength;
+
+/* Endpoint model: packets handed to the USB, the first one is on the bus */
+static uint32_t Now;
+static uint32_t BusEnd;
+static uint32_t Queued;
+static uint8_t Packet[BULK_MAX_PACKET_SIZE];    /* application side of a single buffer */
+
+static uint32_t Reads;
+static uint32_t ReadTime;
+static uint32_t ReadsOnBusyBus;
+
+/* Private functions ---------------------------------------------------------*/
+static void BusStart(void)
+{
+    if (Queued == 1)
+    {
+        BusEnd = Now + PACKET_TIME;
+    }
+}
+
+static void Queue(const uint8_t* Data, uint16_t Length)
+{
+    memcpy(Received + ReceivedLength, Data, Length);
+    ReceivedLength += Length;
+    Queued++;
+    BusStart();
+}
+
+/**
+  * @brief  FLASH read: blocking, the bus goes on meanwhile. Reads issued
+  *         while a packet is on the bus are counted.
+  */
+uint16_t MAL_Read(uint8_t lun, uint32_t Memory_Offset, uint32_t* Readbuff, uint16_t Transfer_Length)
+{
+    (void)lun;
+
+    CHECK(Memory_Offset + Transfer_Length <= sizeof(Medium));
+    memcpy(Readbuff, Medium + Memory_Offset, Transfer_Length);
+
+    if ((Queued != 0) && (BusEnd > Now))
+    {
+        ReadsOnBusyBus++;
+    }
+
+    Reads++;
+    ReadTime += READ_TIME(Transfer_Length);
+    Now += READ_TIME(Transfer_Length);
+    return MAL_OK;
+}
+
+uint16_t MAL_Write(uint8_t lun, uint32_t Memory_Offset, uint32_t* Writebuff, uint16_t Transfer_Length)
+{
+    (void)lun;
+
+    memcpy(Medium + Memory_Offset, Writebuff, Transfer_Length);
+    return MAL_OK;
+}
+
+/* Double buffered EP1 IN of the Mass_Storage BOT layer: a packet prepared
+   while another one is on the bus stays pending in the PMA */
+void Bot_Send_EP1(uint8_t* Data_Pointer, uint16_t Data_Len)
+{
+    CHECK(Queued < TEST_EP_BUFFERS);
+    Queue(Data_Pointer, Data_Len);
+
+    if (Queued == 2)
+    {
+        Bot_Tx_Pending = 1;
+    }
+}
+
+/* Single buffered EP2 IN of the composite example */
+uint32_t USB_SIL_Write(uint8_t bEpAddr, uint8_t* pBufferPointer, uint32_t wBufferSize)
+{
+    (void)bEpAddr;
+
+    CHECK_EQUAL(0, Queued);
+    memcpy(Packet, pBufferPointer, wBufferSize);
+    return 0;
+}
+
+void SetEPTxCount(uint8_t bEpNum, uint16_t wCount)
+{
+    (void)bEpNum;
+    (void)wCount;
+}
+
+void SetEPTxStatus(uint8_t bEpNum, uint16_t wState)
+{
+    (void)bEpNum;
+
+    if (wState == EP_TX_VALID)
+    {
+        Queue(Packet, BULK_MAX_PACKET_SIZE);
+    }
+}
+
+void SetEPRxStatus(uint8_t bEpNum, uint16_t wState)
+{
+    (void)bEpNum;
+    (void)wState;
+}
+
+void Set_Scsi_Sense_Data(uint8_t lun, uint8_t Sens_Key, uint8_t Asc)
+{
+    (void)lun;
+    (void)Sens_Key;
+    (void)Asc;
+}
+
+void Set_CSW(uint8_t CSW_Status, uint8_t Send_Permission)
+{
+    (void)CSW_Status;
+    (void)Send_Permission;
+}
+
+/**
+  * @brief  READ(10) of Blocks blocks from Lba, the IN transfer complete
+  *         interrupts as Mass_Storage_In() serves them.
+  */
+static void Read10(uint32_t Lba, uint32_t Blocks)
+{
+    Bot_State = BOT_DATA_IN;
+    CSW.dDataResidue = Blocks * TEST_BLOCK_SIZE;
+    Read_Memory(0, Lba, Blocks);
+
+    while (Queued != 0)
+    {
+        /* Transfer complete of the packet on the bus, served once the
+           interrupt of the previous one has returned */
+        if (BusEnd > Now)
+        {
+            Now = BusEnd;
+        }
+
+        Queued--;
+        BusStart();
+
+        if (Bot_Tx_Pending)
+        {
+            Bot_Tx_Pending = 0;
+
+            if (Bot_State != BOT_DATA_IN)
+            {
+                continue;
+            }
+        }
+
+        if (Bot_State == BOT_DATA_IN)
+        {
+            Read_Memory(0, Lba, Blocks);
+        }
+    }
+}
+
+static void Reset(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < sizeof(Medium); i++)
+    {
+        Medium[i] = (uint8_t)((i * 7U) ^ (i >> 8));
+    }
+
+    memset(Received, 0, sizeof(Received));
+    ReceivedLength = 0;
+    Mass_Block_Size[0] = TEST_BLOCK_SIZE;
+    Bot_Tx_Pending = 0;
+    Now = 0;
+    BusEnd = 0;
+    Queued = 0;
+    Reads = 0;
+    ReadTime = 0;
+    ReadsOnBusyBus = 0;
+}
+
+/**
+  * @brief  The data sent are the blocks read, for one block and for several,
+  *         with the residue of the CSW and the end of the data stage.
+  */
+static void Test_Data(void)
+{
+    Reset();
+    Read10(1, 1);
+    CHECK_EQUAL(TEST_BLOCK_SIZE, ReceivedLength);
+    CHECK_MEMORY(Medium + TEST_BLOCK_SIZE, Received, TEST_BLOCK_SIZE);
+    CHECK_EQUAL(BOT_DATA_IN_LAST, Bot_State);
+    CHECK_EQUAL(0, CSW.dDataResidue);
+    /* A single block has nothing to read ahead */
+    CHECK_EQUAL(1, Reads);
+
+    Reset();
+    Read10(2, TEST_BLOCKS);
+    CHECK_EQUAL(TEST_BLOCKS * TEST_BLOCK_SIZE, ReceivedLength);
+    CHECK_MEMORY(Medium + 2U * TEST_BLOCK_SIZE, Received, TEST_BLOCKS * TEST_BLOCK_SIZE);
+    CHECK_EQUAL(BOT_DATA_IN_LAST, Bot_State);
+    CHECK_EQUAL(0, CSW.dDataResidue);
+
+    /* The next transfer starts from a clean state */
+    Reset();
+    Read10(0, 2);
+    CHECK_MEMORY(Medium, Received, 2U * TEST_BLOCK_SIZE);
+}
+
+/**
+  * @brief  Every block after the first is read while the previous block is
+  *         sent: each slice of it is read with a packet on the bus, so the
+  *         transfer takes the longer of the FLASH and USB times plus the
+  *         first block, not their sum.
+  */
+static void Test_ReadAhead(void)
+{
+    uint32_t slice = READ_TIME(BULK_MAX_PACKET_SIZE);
+    uint32_t step = (slice > PACKET_TIME) ? slice : PACKET_TIME;
+    uint32_t serial;
+
+    Reset();
+    Read10(0, TEST_BLOCKS);
+    CHECK_MEMORY(Medium, Received, TEST_BLOCKS * TEST_BLOCK_SIZE);
+
+    /* First block up front, then one slice per packet of blocks 0 to N-2 */
+    CHECK_EQUAL(1U + (TEST_PACKETS - TEST_BLOCK_SIZE / BULK_MAX_PACKET_SIZE), Reads);
+    /* Not overlapped: the first block and, on the double buffered EP1, the
+       slice read by the first call after its pending packet, when the bus
+       has already sent the packet ahead of it */
+    CHECK_EQUAL(Reads - TEST_EP_BUFFERS, ReadsOnBusyBus);
+
+    serial = ReadTime + TEST_PACKETS * PACKET_TIME;
+    CHECK(Now <= READ_TIME(TEST_BLOCK_SIZE) + TEST_PACKETS * step);
+    CHECK(Now < serial);
+
+    printf("%u blocks of %u bytes: %u time units, %u without overlap\n",
+           TEST_BLOCKS, (unsigned)TEST_BLOCK_SIZE, (unsigned)Now, (unsigned)serial);
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    HOSTTEST_RUN(Test_Data);
+    HOSTTEST_RUN(Test_ReadAhead);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,167 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_ring_buffer.c
+* @brief:     Ring buffer of the Virtual_COMPort example: copies across the
+*             end of the storage, and the write position published by a
+*             circular DMA, including a full lap and an overrun between two
+*             publications.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "ring_buffer.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define RING_SIZE                   64U
+
+/* Private variables ---------------------------------------------------------*/
+static RingBuffer_TypeDef Ring;
+static uint8_t Storage[RING_SIZE];
+static uint8_t Data[4U * RING_SIZE];
+static uint8_t Output[4U * RING_SIZE];
+
+/* Private functions ---------------------------------------------------------*/
+static void FillData(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < sizeof(Data); i++)
+    {
+        Data[i] = (uint8_t)(i * 7U + 1U);
+    }
+}
+
+/**
+  * @brief  Stands for the circular DMA: stores the bytes From to
+  *         From + Length - 1 of the received stream.
+  */
+static void DmaWrite(uint32_t From, uint32_t Length)
+{
+    uint32_t i;
+
+    for (i = From; i < From + Length; i++)
+    {
+        Storage[i % RING_SIZE] = Data[i];
+    }
+}
+
+static void Test_WriteRead(void)
+{
+    uint32_t i;
+
+    FillData();
+    RingBuffer_Init(&Ring, Storage, RING_SIZE);
+    CHECK_EQUAL(RING_SIZE, RingBuffer_GetFree(&Ring));
+
+    /* Move the indices close to the end of the storage, then wrap */
+    CHECK_EQUAL(50, RingBuffer_Write(&Ring, Data, 50));
+    CHECK_EQUAL(50, RingBuffer_Read(&Ring, Output, sizeof(Output)));
+
+    for (i = 0; i < 3U; i++)
+    {
+        CHECK_EQUAL(40, RingBuffer_Write(&Ring, Data + i * 40U, 40));
+        CHECK_EQUAL(40, RingBuffer_GetCount(&Ring));
+        CHECK_EQUAL(40, RingBuffer_Read(&Ring, Output + i * 40U, 40));
+    }
+    CHECK_MEMORY(Data, Output, 120);
+
+    /* A write larger than the free space is cut and counted */
+    CHECK_EQUAL(RING_SIZE, RingBuffer_Write(&Ring, Data, RING_SIZE + 5U));
+    CHECK_EQUAL(5, Ring.Overrun);
+    CHECK_EQUAL(0, RingBuffer_GetFree(&Ring));
+    CHECK_EQUAL(RING_SIZE, RingBuffer_Read(&Ring, Output, sizeof(Output)));
+    CHECK_MEMORY(Data, Output, RING_SIZE);
+}
+
+static void Test_WritePosition(void)
+{
+    FillData();
+    RingBuffer_Init(&Ring, Storage, RING_SIZE);
+
+    /* 20 bytes, no boundary crossed yet */
+    DmaWrite(0, 20);
+    RingBuffer_SetWritePosition(&Ring, 20, 0);
+    CHECK_EQUAL(20, RingBuffer_Read(&Ring, Output, sizeof(Output)));
+
+    /* 40 more bytes: the half transfer interrupt ran, the read is in order */
+    DmaWrite(20, 40);
+    RingBuffer_SetWritePosition(&Ring, 60, 1);
+    CHECK_EQUAL(40, RingBuffer_GetCount(&Ring));
+
+    /* The idle line publishes the position while the complete transfer
+       interrupt is still pending: the boundary count lags by one */
+    DmaWrite(60, 10);
+    RingBuffer_SetWritePosition(&Ring, 70 % RING_SIZE, 1);
+    CHECK_EQUAL(50, RingBuffer_Read(&Ring, Output + 20, sizeof(Output) - 20U));
+    CHECK_MEMORY(Data, Output, 70);
+    CHECK_EQUAL(0, Ring.Overrun);
+
+    /* Exactly a full lap: the position is back where it was. Without the
+       boundary count this looked like an empty buffer */
+    DmaWrite(70, RING_SIZE);
+    RingBuffer_SetWritePosition(&Ring, (70 + RING_SIZE) % RING_SIZE, 4);
+    CHECK_EQUAL(RING_SIZE, RingBuffer_GetCount(&Ring));
+    CHECK_EQUAL(RING_SIZE, RingBuffer_Read(&Ring, Output, sizeof(Output)));
+    CHECK_MEMORY(Data + 70, Output, RING_SIZE);
+    CHECK_EQUAL(0, Ring.Overrun);
+}
+
+static void Test_Overrun(void)
+{
+    uint8_t* span;
+    uint32_t length;
+
+    FillData();
+    RingBuffer_Init(&Ring, Storage, RING_SIZE);
+
+    /* A lap and 10 bytes without reading: the 10 oldest bytes are lost */
+    DmaWrite(0, RING_SIZE + 10U);
+    RingBuffer_SetWritePosition(&Ring, 10, 2);
+    CHECK_EQUAL(10, Ring.Overrun);
+
+    /* The reader restarts from the oldest byte still in the storage */
+    length = RingBuffer_GetReadSpan(&Ring, &span);
+    CHECK_EQUAL(RING_SIZE - 10U, length);
+    CHECK(span == &Storage[10]);
+    CHECK_EQUAL(RING_SIZE, RingBuffer_Read(&Ring, Output, sizeof(Output)));
+    CHECK_MEMORY(Data + 10, Output, RING_SIZE);
+    CHECK_EQUAL(0, RingBuffer_GetCount(&Ring));
+
+    /* The reader stays lapped over several publications: each one counts
+       only the bytes it overwrote, not the whole lapped distance again */
+    DmaWrite(RING_SIZE + 10U, RING_SIZE + 6U);
+    RingBuffer_SetWritePosition(&Ring, 16, 4);
+    CHECK_EQUAL(10 + 6, Ring.Overrun);
+    DmaWrite(2U * RING_SIZE + 16U, 20);
+    RingBuffer_SetWritePosition(&Ring, 36, 5);
+    CHECK_EQUAL(10 + 6 + 20, Ring.Overrun);
+    DmaWrite(2U * RING_SIZE + 36U, 30);
+    RingBuffer_SetWritePosition(&Ring, 2, 6);
+    CHECK_EQUAL(10 + 6 + 20 + 30, Ring.Overrun);
+
+    /* A partial read while lapped does not change the count either */
+    CHECK_EQUAL(8, RingBuffer_Read(&Ring, Output, 8));
+    CHECK_MEMORY(Data + 2U * RING_SIZE + 2U, Output, 8);
+    DmaWrite(3U * RING_SIZE + 2U, 12);
+    RingBuffer_SetWritePosition(&Ring, 14, 6);
+    CHECK_EQUAL(10 + 6 + 20 + 30 + 4, Ring.Overrun);
+    CHECK_EQUAL(RING_SIZE, RingBuffer_Read(&Ring, Output, sizeof(Output)));
+    CHECK_MEMORY(Data + 2U * RING_SIZE + 14U, Output, RING_SIZE);
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    HOSTTEST_RUN(Test_WriteRead);
+    HOSTTEST_RUN(Test_WritePosition);
+    HOSTTEST_RUN(Test_Overrun);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,220 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_sd.c
+* @brief:     SPI SD card driver of the EVAL board on the SPI and SD card
+*             models: initialization, CMD18/CMD25 multiple block streams,
+*             write errors and the cost of a stream against single blocks.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "hk32l0xx_eval.h"
+#include "hk32l0xx_eval_spi_sd.h"
+#include "hk32l0xx_eval_spi_dma.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define CARD_BLOCKS                 256U
+#define BLOCK_SIZE                  512U
+#define TEST_BLOCKS                 8U
+
+/* Private variables ---------------------------------------------------------*/
+/* Given to the DMA: 32-bit addresses */
+static uint8_t Buffer[TEST_BLOCKS * BLOCK_SIZE];
+static uint8_t Pattern[TEST_BLOCKS * BLOCK_SIZE];
+
+/* Private functions ---------------------------------------------------------*/
+static void FillPattern(uint8_t* Data, uint32_t Length, uint32_t Seed)
+{
+    uint32_t i;
+
+    for (i = 0; i < Length; i++)
+    {
+        Seed = Seed * 1103515245UL + 12345UL;
+        Data[i] = (uint8_t)(Seed >> 16);
+    }
+}
+
+static uint8_t CardSelected(void)
+{
+    return (uint8_t)((HostGpio_GetOutput(SD_CS_GPIO_PORT) & SD_CS_PIN) == 0);
+}
+
+static void InsertAndInit(void)
+{
+    HostSd_Insert(SD_SPI, SD_CS_GPIO_PORT, SD_CS_PIN, CARD_BLOCKS);
+    CHECK_EQUAL(SD_RESPONSE_NO_ERROR, SD_Init());
+    HK_SPI_DMA_ITConfig(ENABLE);
+}
+
+static void Test_Init(void)
+{
+    SD_CardInfo info;
+
+    InsertAndInit();
+    CHECK_EQUAL(0, CardSelected());
+
+    memset(&info, 0, sizeof(info));
+    CHECK_EQUAL(SD_RESPONSE_NO_ERROR, SD_GetCardInfo(&info));
+    CHECK_EQUAL(BLOCK_SIZE, info.CardBlockSize);
+    CHECK_EQUAL(CARD_BLOCKS * BLOCK_SIZE, info.CardCapacity);
+    CHECK_EQUAL(0, CardSelected());
+}
+
+static void Test_MultiBlockRead(void)
+{
+    uint32_t cmd17;
+    uint32_t cmd18;
+    uint32_t cmd12;
+    uint32_t reads;
+
+    InsertAndInit();
+    FillPattern(HostSd_Memory(), CARD_BLOCKS * BLOCK_SIZE, 1);
+
+    cmd17 = HostSd_Commands(SD_CMD_READ_SINGLE_BLOCK);
+    cmd18 = HostSd_Commands(SD_CMD_READ_MULT_BLOCK);
+    cmd12 = HostSd_Commands(SD_CMD_STOP_TRANSMISSION);
+    reads = HostSd_BlocksRead();
+
+    CHECK_EQUAL(SD_RESPONSE_NO_ERROR, SD_ReadMultiBlocks(Buffer, 40 * BLOCK_SIZE, BLOCK_SIZE, TEST_BLOCKS));
+    CHECK_MEMORY(HostSd_Memory() + 40 * BLOCK_SIZE, Buffer, TEST_BLOCKS * BLOCK_SIZE);
+
+    /* One command for the whole range, closed by CMD12 */
+    CHECK_EQUAL(0, HostSd_Commands(SD_CMD_READ_SINGLE_BLOCK) - cmd17);
+    CHECK_EQUAL(1, HostSd_Commands(SD_CMD_READ_MULT_BLOCK) - cmd18);
+    CHECK_EQUAL(1, HostSd_Commands(SD_CMD_STOP_TRANSMISSION) - cmd12);
+    /* The card may have started the block after the last one before CMD12 */
+    CHECK(HostSd_BlocksRead() - reads >= TEST_BLOCKS);
+    CHECK(HostSd_BlocksRead() - reads <= TEST_BLOCKS + 1U);
+    CHECK_EQUAL(0, CardSelected());
+
+    /* The card is back in the command state */
+    CHECK_EQUAL(SD_RESPONSE_NO_ERROR, SD_ReadBlock(Buffer, 3 * BLOCK_SIZE, BLOCK_SIZE));
+    CHECK_MEMORY(HostSd_Memory() + 3 * BLOCK_SIZE, Buffer, BLOCK_SIZE);
+
+    /* Out of the card: R1 address error, chip select released */
+    CHECK_EQUAL(SD_RESPONSE_FAILURE, SD_ReadMultiBlocks(Buffer, CARD_BLOCKS * BLOCK_SIZE, BLOCK_SIZE, 2));
+    CHECK_EQUAL(0, CardSelected());
+    CHECK_EQUAL(SD_RESPONSE_FAILURE, SD_ReadMultiBlocks(Buffer, 0, BLOCK_SIZE, 0));
+}
+
+static void Test_MultiBlockWrite(void)
+{
+    uint32_t cmd24;
+    uint32_t cmd25;
+    uint32_t acmd23;
+    uint32_t writes;
+
+    InsertAndInit();
+    FillPattern(Pattern, sizeof(Pattern), 2);
+
+    cmd24 = HostSd_Commands(SD_CMD_WRITE_SINGLE_BLOCK);
+    cmd25 = HostSd_Commands(SD_CMD_WRITE_MULT_BLOCK);
+    acmd23 = HostSd_Commands(SD_ACMD_SET_WR_BLK_ERASE_COUNT | HOSTSD_ACMD);
+    writes = HostSd_BlocksWritten();
+
+    CHECK_EQUAL(SD_RESPONSE_NO_ERROR, SD_WriteMultiBlocks(Pattern, 16 * BLOCK_SIZE, BLOCK_SIZE, TEST_BLOCKS));
+    CHECK_MEMORY(Pattern, HostSd_Memory() + 16 * BLOCK_SIZE, TEST_BLOCKS * BLOCK_SIZE);
+
+    CHECK_EQUAL(0, HostSd_Commands(SD_CMD_WRITE_SINGLE_BLOCK) - cmd24);
+    CHECK_EQUAL(1, HostSd_Commands(SD_CMD_WRITE_MULT_BLOCK) - cmd25);
+    CHECK_EQUAL(1, HostSd_Commands(SD_ACMD_SET_WR_BLK_ERASE_COUNT | HOSTSD_ACMD) - acmd23);
+    CHECK_EQUAL(TEST_BLOCKS, HostSd_BlocksWritten() - writes);
+    CHECK_EQUAL(0, CardSelected());
+
+    /* Neighbours untouched */
+    CHECK_EQUAL(0, HostSd_Memory()[16 * BLOCK_SIZE - 1]);
+    CHECK_EQUAL(0, HostSd_Memory()[(16 + TEST_BLOCKS) * BLOCK_SIZE]);
+
+    /* Read back through the stream */
+    memset(Buffer, 0, sizeof(Buffer));
+    CHECK_EQUAL(SD_RESPONSE_NO_ERROR, SD_ReadMultiBlocks(Buffer, 16 * BLOCK_SIZE, BLOCK_SIZE, TEST_BLOCKS));
+    CHECK_MEMORY(Pattern, Buffer, sizeof(Buffer));
+
+    /* Single block write */
+    CHECK_EQUAL(SD_RESPONSE_NO_ERROR, SD_WriteBlock(Pattern, 100 * BLOCK_SIZE, BLOCK_SIZE));
+    CHECK_MEMORY(Pattern, HostSd_Memory() + 100 * BLOCK_SIZE, BLOCK_SIZE);
+}
+
+static void Test_WriteError(void)
+{
+    InsertAndInit();
+    FillPattern(Pattern, sizeof(Pattern), 3);
+
+    /* The 4th block is rejected: the stream stops there */
+    HostSd_WriteErrorAt(8 + 3);
+    CHECK_EQUAL(SD_RESPONSE_FAILURE, SD_WriteMultiBlocks(Pattern, 8 * BLOCK_SIZE, BLOCK_SIZE, TEST_BLOCKS));
+    CHECK_EQUAL(0, CardSelected());
+    CHECK_MEMORY(Pattern, HostSd_Memory() + 8 * BLOCK_SIZE, 3 * BLOCK_SIZE);
+    CHECK_EQUAL(0, HostSd_Memory()[(8 + 4) * BLOCK_SIZE]);
+
+    /* The card still answers */
+    HostSd_WriteErrorAt(0xFFFFFFFFUL);
+    CHECK_EQUAL(SD_RESPONSE_NO_ERROR, SD_WriteMultiBlocks(Pattern, 8 * BLOCK_SIZE, BLOCK_SIZE, TEST_BLOCKS));
+    CHECK_MEMORY(Pattern, HostSd_Memory() + 8 * BLOCK_SIZE, TEST_BLOCKS * BLOCK_SIZE);
+}
+
+static void Test_Cycles(void)
+{
+    uint64_t start;
+    uint64_t single;
+    uint64_t stream;
+    uint32_t i;
+
+    InsertAndInit();
+    FillPattern(Pattern, sizeof(Pattern), 4);
+
+    start = HostSim_Cycles();
+    for (i = 0; i < TEST_BLOCKS; i++)
+    {
+        SD_WriteBlock(Pattern + i * BLOCK_SIZE, (32 + i) * BLOCK_SIZE, BLOCK_SIZE);
+    }
+    single = HostSim_Cycles() - start;
+    start = HostSim_Cycles();
+    SD_WriteMultiBlocks(Pattern, 32 * BLOCK_SIZE, BLOCK_SIZE, TEST_BLOCKS);
+    stream = HostSim_Cycles() - start;
+    printf("write %u blocks: CMD24 %llu bus cycles, CMD25 %llu bus cycles\n", TEST_BLOCKS,
+           (unsigned long long)single, (unsigned long long)stream);
+    CHECK(stream < single);
+
+    start = HostSim_Cycles();
+    for (i = 0; i < TEST_BLOCKS; i++)
+    {
+        SD_ReadBlock(Buffer + i * BLOCK_SIZE, (32 + i) * BLOCK_SIZE, BLOCK_SIZE);
+    }
+    single = HostSim_Cycles() - start;
+    start = HostSim_Cycles();
+    SD_ReadMultiBlocks(Buffer, 32 * BLOCK_SIZE, BLOCK_SIZE, TEST_BLOCKS);
+    stream = HostSim_Cycles() - start;
+    printf("read %u blocks: CMD17 %llu bus cycles, CMD18 %llu bus cycles\n", TEST_BLOCKS,
+           (unsigned long long)single, (unsigned long long)stream);
+    CHECK(stream < single);
+    CHECK_MEMORY(Pattern, Buffer, sizeof(Buffer));
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  The SD data blocks are moved by the SPI DMA engine.
+  */
+void DMA_CH2_3_IRQHandler(void)
+{
+    HK_SPI_DMA_IRQHandler();
+}
+
+int main(void)
+{
+    HOSTTEST_RUN(Test_Init);
+    HOSTTEST_RUN(Test_MultiBlockRead);
+    HOSTTEST_RUN(Test_MultiBlockWrite);
+    HOSTTEST_RUN(Test_WriteError);
+    HOSTTEST_RUN(Test_Cycles);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,251 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_sflash.c
+* @brief:     SPI FLASH driver of the EVAL board on the SPI and SPI FLASH
+*             models: the DMA engine in polling and interrupt modes, queued
+*             transfers, and the throughput of the DMA data phases against
+*             the byte by byte exchange.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "hk32l0xx_eval.h"
+#include "hk32l0xx_eval_spi_flash.h"
+#include "hk32l0xx_eval_spi_dma.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define FLASH_ID                    0x202014UL
+#define SECTOR_ADDRESS              0x10000UL
+#define TEST_SIZE                   1024U
+#define BENCH_SIZE                  4096U
+
+/* Private variables ---------------------------------------------------------*/
+/* Given to the DMA: 32-bit addresses */
+static uint8_t Buffer[BENCH_SIZE];
+static uint8_t Pattern[BENCH_SIZE];
+static uint8_t IdCommand[4] = {sFLASH_CMD_RDID, sFLASH_DUMMY_BYTE, sFLASH_DUMMY_BYTE, sFLASH_DUMMY_BYTE};
+static uint8_t IdAnswer[2][4];
+static SPI_DMA_TransferTypeDef Transfer[2];
+
+static uint32_t InterruptCount;
+static uint32_t CallbackCount;
+
+/* Private functions ---------------------------------------------------------*/
+static void FillPattern(uint8_t* Data, uint32_t Length, uint32_t Seed)
+{
+    uint32_t i;
+
+    for (i = 0; i < Length; i++)
+    {
+        Seed = Seed * 1103515245UL + 12345UL;
+        Data[i] = (uint8_t)(Seed >> 16);
+    }
+}
+
+static void InsertAndInit(FunctionalState Interrupt)
+{
+    HostSFlash_Insert(sFLASH_SPI, sFLASH_CS_GPIO_PORT, sFLASH_CS_PIN);
+    sFLASH_Init();
+    HK_SPI_DMA_ITConfig(Interrupt);
+}
+
+static void Callback(SPI_DMA_TransferTypeDef* Done)
+{
+    (void)Done;
+    CallbackCount++;
+}
+
+/**
+  * @brief  Erase, unaligned multi-page write and read back of a sector.
+  */
+static void WriteAndCheck(uint32_t Seed)
+{
+    FillPattern(Pattern, TEST_SIZE, Seed);
+
+    sFLASH_EraseSector(SECTOR_ADDRESS);
+    sFLASH_WriteBuffer(Pattern, SECTOR_ADDRESS + 0x80U, TEST_SIZE);
+    CHECK_MEMORY(Pattern, HostSFlash_Memory() + SECTOR_ADDRESS + 0x80U, TEST_SIZE);
+    CHECK_EQUAL(0xFF, HostSFlash_Memory()[SECTOR_ADDRESS + 0x7FU]);
+    CHECK_EQUAL(0xFF, HostSFlash_Memory()[SECTOR_ADDRESS + 0x80U + TEST_SIZE]);
+
+    memset(Buffer, 0, sizeof(Buffer));
+    sFLASH_ReadBuffer(Buffer, SECTOR_ADDRESS + 0x80U, TEST_SIZE);
+    CHECK_MEMORY(Pattern, Buffer, TEST_SIZE);
+}
+
+static void Test_ReadID(void)
+{
+    InsertAndInit(DISABLE);
+    CHECK_EQUAL(FLASH_ID, sFLASH_ReadID());
+}
+
+/**
+  * @brief  Without HK_SPI_DMA_ITConfig() the DMA interrupt stays disabled:
+  *         a firmware without the DMA_CH2_3 hook does not hang.
+  */
+static void Test_PollingMode(void)
+{
+    uint32_t interrupts = InterruptCount;
+
+    InsertAndInit(DISABLE);
+    WriteAndCheck(1);
+    CHECK_EQUAL(interrupts, InterruptCount);
+    CHECK_EQUAL(0, HK_SPI_DMA_IsBusy());
+}
+
+static void Test_InterruptMode(void)
+{
+    uint32_t interrupts = InterruptCount;
+
+    InsertAndInit(ENABLE);
+    WriteAndCheck(2);
+    CHECK(InterruptCount > interrupts);
+    HK_SPI_DMA_ITConfig(DISABLE);
+}
+
+/**
+  * @brief  In polling mode a queue is chained by HK_SPI_DMA_IsBusy(), the
+  *         engine drives the chip select of each transfer.
+  */
+static void Test_QueuePolling(void)
+{
+    uint32_t i;
+    uint32_t callbacks = CallbackCount;
+
+    InsertAndInit(DISABLE);
+    memset(IdAnswer, 0, sizeof(IdAnswer));
+
+    for (i = 0; i < 2U; i++)
+    {
+        memset(&Transfer[i], 0, sizeof(Transfer[i]));
+        Transfer[i].pTxBuffer = IdCommand;
+        Transfer[i].pRxBuffer = IdAnswer[i];
+        Transfer[i].Length = sizeof(IdCommand);
+        Transfer[i].CsPort = sFLASH_CS_GPIO_PORT;
+        Transfer[i].CsPin = sFLASH_CS_PIN;
+        Transfer[i].Callback = Callback;
+    }
+    CHECK_EQUAL(SPI_DMA_ACTIVE, HK_SPI_DMA_Submit(&Transfer[0]));
+    CHECK_EQUAL(SPI_DMA_QUEUED, HK_SPI_DMA_Submit(&Transfer[1]));
+
+    while (HK_SPI_DMA_IsBusy() != 0)
+    {
+    }
+
+    CHECK_EQUAL(callbacks + 2U, CallbackCount);
+    for (i = 0; i < 2U; i++)
+    {
+        CHECK_EQUAL(SPI_DMA_DONE, Transfer[i].Status);
+        CHECK_EQUAL(FLASH_ID, ((uint32_t)IdAnswer[i][1] << 16) | ((uint32_t)IdAnswer[i][2] << 8) | IdAnswer[i][3]);
+    }
+    CHECK_EQUAL(Bit_SET, GPIO_ReadOutputDataBit(sFLASH_CS_GPIO_PORT, sFLASH_CS_PIN));
+}
+
+/**
+  * @brief  Cycles of a 4 KB read and of a page program: bytes exchanged one
+  *         at a time as before the DMA engine, then through the engine.
+  */
+static void Test_Benchmark(void)
+{
+    uint64_t start;
+    uint64_t polled;
+    uint64_t dma;
+    uint64_t interrupt;
+    uint32_t i;
+
+    InsertAndInit(DISABLE);
+    FillPattern(Pattern, BENCH_SIZE, 3);
+    memcpy(HostSFlash_Memory() + SECTOR_ADDRESS, Pattern, BENCH_SIZE);
+
+    start = HostSim_Cycles();
+    sFLASH_StartReadSequence(SECTOR_ADDRESS);
+    for (i = 0; i < BENCH_SIZE; i++)
+    {
+        Buffer[i] = sFLASH_ReadByte();
+    }
+    sFLASH_CS_HIGH();
+    polled = HostSim_Cycles() - start;
+    CHECK_MEMORY(Pattern, Buffer, BENCH_SIZE);
+
+    memset(Buffer, 0, sizeof(Buffer));
+    start = HostSim_Cycles();
+    sFLASH_ReadBuffer(Buffer, SECTOR_ADDRESS, BENCH_SIZE);
+    dma = HostSim_Cycles() - start;
+    CHECK_MEMORY(Pattern, Buffer, BENCH_SIZE);
+
+    HK_SPI_DMA_ITConfig(ENABLE);
+    memset(Buffer, 0, sizeof(Buffer));
+    start = HostSim_Cycles();
+    sFLASH_ReadBuffer(Buffer, SECTOR_ADDRESS, BENCH_SIZE);
+    interrupt = HostSim_Cycles() - start;
+    CHECK_MEMORY(Pattern, Buffer, BENCH_SIZE);
+
+    printf("read %u bytes: byte loop %llu cycles, DMA polling %llu cycles, DMA interrupt %llu cycles\n",
+           BENCH_SIZE, (unsigned long long)polled, (unsigned long long)dma, (unsigned long long)interrupt);
+    CHECK(dma < polled);
+    CHECK(interrupt < polled);
+
+    /* Page program: the data phase only, the programming time is the same */
+    HK_SPI_DMA_ITConfig(DISABLE);
+    sFLASH_EraseSector(SECTOR_ADDRESS);
+    start = HostSim_Cycles();
+    sFLASH_WriteEnable();
+    sFLASH_CS_LOW();
+    sFLASH_SendByte(sFLASH_CMD_WRITE);
+    sFLASH_SendByte((uint8_t)(SECTOR_ADDRESS >> 16));
+    sFLASH_SendByte((uint8_t)(SECTOR_ADDRESS >> 8));
+    sFLASH_SendByte((uint8_t)SECTOR_ADDRESS);
+    for (i = 0; i < sFLASH_SPI_PAGESIZE; i++)
+    {
+        sFLASH_SendByte(Pattern[i]);
+    }
+    sFLASH_CS_HIGH();
+    polled = HostSim_Cycles() - start;
+    sFLASH_WaitForWriteEnd();
+
+    start = HostSim_Cycles();
+    sFLASH_WriteEnable();
+    sFLASH_CS_LOW();
+    sFLASH_SendByte(sFLASH_CMD_WRITE);
+    sFLASH_SendByte((uint8_t)((SECTOR_ADDRESS + sFLASH_SPI_PAGESIZE) >> 16));
+    sFLASH_SendByte((uint8_t)((SECTOR_ADDRESS + sFLASH_SPI_PAGESIZE) >> 8));
+    sFLASH_SendByte((uint8_t)(SECTOR_ADDRESS + sFLASH_SPI_PAGESIZE));
+    HK_SPI_DMA_TransferBlocking(Pattern + sFLASH_SPI_PAGESIZE, 0, sFLASH_SPI_PAGESIZE, sFLASH_DUMMY_BYTE);
+    sFLASH_CS_HIGH();
+    dma = HostSim_Cycles() - start;
+    sFLASH_WaitForWriteEnd();
+
+    printf("program %u bytes: byte loop %llu cycles, DMA %llu cycles\n",
+           sFLASH_SPI_PAGESIZE, (unsigned long long)polled, (unsigned long long)dma);
+    CHECK(dma < polled);
+    CHECK_MEMORY(Pattern, HostSFlash_Memory() + SECTOR_ADDRESS, 2U * sFLASH_SPI_PAGESIZE);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Only reached in interrupt mode.
+  */
+void DMA_CH2_3_IRQHandler(void)
+{
+    InterruptCount++;
+    HK_SPI_DMA_IRQHandler();
+}
+
+int main(void)
+{
+    HOSTTEST_RUN(Test_ReadID);
+    HOSTTEST_RUN(Test_PollingMode);
+    HOSTTEST_RUN(Test_InterruptMode);
+    HOSTTEST_RUN(Test_QueuePolling);
+    HOSTTEST_RUN(Test_Benchmark);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,367 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_trng.c
+* @brief:     Entropy pool of the TRNG driver fed by a simulated source: the
+*             SP 800-90B repetition count and adaptive proportion tests on
+*             good, stuck and biased sources, startup and flush; the AES
+*             CTR_DRBG on the AES and DMA models: SP 800-90A known answers
+*             and the reseeds drawn from the pool.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "hk32l0xx.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define GOOD_WORDS                  200000U
+#define BIASED_WORDS                10000U
+#define DRBG_REQUESTS               10U
+
+/* Ways the blocks are computed */
+#define ENGINE_CPU                  0U
+#define ENGINE_DMA                  1U
+#define ENGINE_MODEL                2U
+#define ENGINE_COUNT                3U
+
+/* Private variables ---------------------------------------------------------*/
+/* CAVP drbgvectors_no_reseed, CTR_DRBG AES-128 use df, COUNT = 0: instantiate,
+   generate 64 bytes twice, the second output is returned */
+static const uint8_t CavpEntropy[16] =
+{
+    0x89, 0x0e, 0xb0, 0x67, 0xac, 0xf7, 0x38, 0x2e, 0xff, 0x80, 0xb0, 0xc7, 0x3b, 0xc8, 0x72, 0xc6
+};
+static const uint8_t CavpNonce[8] =
+{
+    0xaa, 0xd4, 0x71, 0xef, 0x3e, 0xf1, 0xd2, 0x03
+};
+static const uint8_t CavpReturned[64] =
+{
+    0xa5, 0x51, 0x4e, 0xd7, 0x09, 0x5f, 0x64, 0xf3, 0xd0, 0xd3, 0xa5, 0x76, 0x03, 0x94, 0xab, 0x42,
+    0x06, 0x2f, 0x37, 0x3a, 0x25, 0x07, 0x2a, 0x6e, 0xa6, 0xbc, 0xfd, 0x84, 0x89, 0xe9, 0x4a, 0xf6,
+    0xcf, 0x18, 0x65, 0x9f, 0xea, 0x22, 0xed, 0x1c, 0xa0, 0xa9, 0xe3, 0x3f, 0x71, 0x8b, 0x11, 0x5e,
+    0xe5, 0x36, 0xb1, 0x28, 0x09, 0xc3, 0x1b, 0x72, 0xb0, 0x8d, 0xdd, 0x8b, 0xe1, 0x91, 0x0f, 0xa3
+};
+
+/* Same sequence with a personalization string, a reseed with additional input
+   and additional input on both requests, from the OpenSSL CTR-DRBG */
+static const uint8_t Entropy[16] =
+{
+    0x0f, 0x65, 0xda, 0x13, 0xdc, 0xa4, 0x07, 0x99, 0x9d, 0x47, 0x73, 0xc2, 0xb4, 0xa1, 0x1d, 0x85
+};
+static const uint8_t Nonce[8] =
+{
+    0x52, 0x09, 0xe5, 0xb4, 0xed, 0x82, 0xa2, 0x34
+};
+static const uint8_t Personal[16] =
+{
+    0x1d, 0xea, 0x0a, 0x12, 0xc5, 0x2b, 0xf6, 0x43, 0x39, 0xdd, 0x29, 0x1c, 0x80, 0xd8, 0xca, 0x89
+};
+static const uint8_t AData[2][16] =
+{
+    {0x9a, 0xc6, 0xc9, 0xb5, 0xba, 0x1a, 0x8a, 0x70, 0x30, 0x6d, 0x6b, 0xa4, 0xa4, 0xa1, 0xe4, 0xe1},
+    {0x45, 0xfb, 0x69, 0xcd, 0x12, 0xa9, 0xb1, 0xac, 0x85, 0xb1, 0x3f, 0x37, 0xa2, 0xe5, 0xfa, 0x3e}
+};
+static const uint8_t ReseedEntropy[16] =
+{
+    0x7b, 0xc4, 0xad, 0xf1, 0xc7, 0xc1, 0xa2, 0xdd, 0xad, 0x8e, 0x1a, 0x6b, 0xd5, 0xb4, 0xe1, 0x6e
+};
+static const uint8_t ReseedAData[16] =
+{
+    0x3c, 0xf8, 0xf3, 0xf8, 0xe2, 0xb7, 0xb3, 0xe2, 0x9c, 0x6e, 0x3f, 0x4c, 0x7c, 0x0d, 0x5a, 0x1b
+};
+static const uint8_t Returned[64] =
+{
+    0xb5, 0xe2, 0xb2, 0x6a, 0x84, 0xbd, 0x09, 0xb9, 0xb9, 0xfc, 0xf7, 0xba, 0x0f, 0xf6, 0xc8, 0xf3,
+    0x36, 0x31, 0x09, 0x15, 0x8e, 0x68, 0x5c, 0xe8, 0x4d, 0xbd, 0xd2, 0xea, 0xf9, 0xdb, 0x0a, 0xa7,
+    0xff, 0xa9, 0x48, 0x19, 0x9f, 0x6d, 0xcd, 0xbd, 0x0c, 0x98, 0x71, 0xca, 0xc4, 0xba, 0xdb, 0x6b,
+    0xfb, 0xd7, 0xc3, 0x10, 0x89, 0x00, 0xe9, 0xc2, 0xec, 0xc5, 0x2d, 0x1b, 0xc9, 0x18, 0x3f, 0xb5
+};
+
+static TRNG_PoolTypeDef Pool;
+static AES_ContextTypeDef Context[2];
+static AES_ModelTypeDef Model;
+static AES_DRBGTypeDef Drbg[2];
+static uint8_t Output[2][64];
+static uint8_t Bytes[4U * TRNG_POOL_SIZE];
+static uint32_t Seed;
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t Random(void)
+{
+    Seed = Seed * 1103515245UL + 12345UL;
+    return Seed >> 16;
+}
+
+/**
+  * @brief  Simulated entropy source: 32 bits from two draws.
+  */
+static uint32_t RandomWord(void)
+{
+    uint32_t word = Random() << 16;
+
+    return word | Random();
+}
+
+static void FillPool(uint32_t Words)
+{
+    while (Words-- != 0)
+    {
+        CHECK_EQUAL(SUCCESS, TRNG_PoolAdd(&Pool, RandomWord()));
+    }
+}
+
+static void InitContext(AES_ContextTypeDef* pContext, uint32_t Engine)
+{
+    memset(pContext, 0, sizeof(*pContext));
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRYPT, ENABLE);
+    if (Engine == ENGINE_DMA)
+    {
+        RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA, ENABLE);
+        DMA_RemapConfig(DMA, DMA_CSELR_CH1_AES_IN);
+        DMA_RemapConfig(DMA, DMA_CSELR_CH2_AES_OUT);
+        pContext->DMAIn_Channelx = DMA_Channel1;
+        pContext->DMAOut_Channelx = DMA_Channel2;
+    }
+    else if (Engine == ENGINE_MODEL)
+    {
+        pContext->Model = &Model;
+    }
+}
+
+static void InitDrbg(AES_DRBGTypeDef* pDrbg, AES_ContextTypeDef* pContext, uint32_t Engine)
+{
+    memset(pDrbg, 0, sizeof(*pDrbg));
+    InitContext(pContext, Engine);
+    pDrbg->AES_Context = pContext;
+    pDrbg->ReseedInterval = AES_DRBG_RESEED_LIMIT;
+}
+
+static ErrorStatus GetEntropy(uint8_t* pData, uint32_t Length)
+{
+    return TRNG_PoolRead(&Pool, pData, Length);
+}
+
+/**
+  * @brief  The first TRNG_POOL_STARTUP_WORDS words are tested, not kept; the
+  *         pool then fills up and a read takes all the bytes or none.
+  */
+static void Test_PoolStartup(void)
+{
+    Seed = 1;
+    TRNG_PoolInit(&Pool);
+    FillPool(TRNG_POOL_STARTUP_WORDS - 1U);
+    CHECK_EQUAL(0, TRNG_PoolGetCount(&Pool));
+    CHECK_EQUAL(ERROR, TRNG_PoolRead(&Pool, Bytes, 1));
+
+    FillPool(1U + TRNG_POOL_SIZE + 10U);
+    CHECK_EQUAL(4U * TRNG_POOL_SIZE, TRNG_PoolGetCount(&Pool));
+    CHECK_EQUAL(TRNG_POOL_SIZE, Pool.Words);
+
+    CHECK_EQUAL(ERROR, TRNG_PoolRead(&Pool, Bytes, 4U * TRNG_POOL_SIZE + 1U));
+    CHECK_EQUAL(4U * TRNG_POOL_SIZE, TRNG_PoolGetCount(&Pool));
+    CHECK_EQUAL(SUCCESS, TRNG_PoolRead(&Pool, Bytes, 10));
+    CHECK_EQUAL(4U * (TRNG_POOL_SIZE - 3U), TRNG_PoolGetCount(&Pool));
+    CHECK_EQUAL(0, Pool.HealthFailures);
+}
+
+/**
+  * @brief  No false positive on a good source: the cutoffs are set for a
+  *         rate of 2^-20 per sample at 4 bits of entropy per byte, a random
+  *         source has 8.
+  */
+static void Test_PoolGoodSource(void)
+{
+    uint32_t i;
+    uint32_t failures = 0;
+
+    Seed = 2;
+    TRNG_PoolInit(&Pool);
+    for (i = 0; i < GOOD_WORDS; i++)
+    {
+        failures += (TRNG_PoolAdd(&Pool, RandomWord()) != SUCCESS) ? 1U : 0U;
+        (void)TRNG_PoolRead(&Pool, Bytes, 4);
+    }
+    CHECK_EQUAL(0, failures);
+    CHECK_EQUAL(0, Pool.HealthFailures);
+    CHECK_EQUAL(GOOD_WORDS - TRNG_POOL_STARTUP_WORDS, Pool.Words);
+}
+
+/**
+  * @brief  A stuck source fails the repetition count test: the words kept
+  *         are flushed, and TRNG_POOL_MAX_FAILURES failures in a row stop
+  *         the pool for good.
+  */
+static void Test_PoolStuck(void)
+{
+    uint32_t i;
+
+    Seed = 3;
+    TRNG_PoolInit(&Pool);
+    FillPool(TRNG_POOL_STARTUP_WORDS + 20U);
+    CHECK_EQUAL(80, TRNG_PoolGetCount(&Pool));
+
+    /* 5 equal bytes in a row pass, the 6th one fails */
+    CHECK_EQUAL(SUCCESS, TRNG_PoolAdd(&Pool, 0x55555555UL));
+    CHECK_EQUAL(ERROR, TRNG_PoolAdd(&Pool, 0x55AA5555UL));
+    CHECK_EQUAL(1, Pool.HealthFailures);
+    CHECK_EQUAL(0, TRNG_PoolGetCount(&Pool));
+    CHECK_EQUAL(ERROR, TRNG_PoolRead(&Pool, Bytes, 4));
+
+    /* The startup test runs again before a word is kept, failures before
+       its end add up */
+    FillPool(TRNG_POOL_STARTUP_WORDS - 10U);
+    CHECK_EQUAL(0, TRNG_PoolGetCount(&Pool));
+
+    for (i = 0; i < 2U; i++)
+    {
+        CHECK_EQUAL(0, Pool.Error);
+        CHECK_EQUAL(SUCCESS, TRNG_PoolAdd(&Pool, 0x12121212UL));
+        CHECK_EQUAL(ERROR, TRNG_PoolAdd(&Pool, 0x12121212UL));
+    }
+    CHECK_EQUAL(1, Pool.Error);
+    CHECK_EQUAL(ERROR, TRNG_PoolAdd(&Pool, RandomWord()));
+    CHECK_EQUAL(0, TRNG_PoolGetCount(&Pool));
+}
+
+/**
+  * @brief  A biased source without runs fails the adaptive proportion test
+  *         only; a complete startup test then clears the failure count.
+  */
+static void Test_PoolBiased(void)
+{
+    uint32_t i;
+    uint32_t first = BIASED_WORDS;
+    uint32_t word;
+
+    Seed = 4;
+    TRNG_PoolInit(&Pool);
+    FillPool(TRNG_POOL_STARTUP_WORDS + 8U);
+
+    /* One byte of each word is 0 and starts the windows: 128 zeros in 512
+       samples, never 2 in a row */
+    for (i = 0; (i < BIASED_WORDS) && (first == BIASED_WORDS); i++)
+    {
+        word = RandomWord() | 0x01010100UL;
+        if (TRNG_PoolAdd(&Pool, word & 0xFFFFFF00UL) != SUCCESS)
+        {
+            first = i;
+        }
+    }
+    CHECK(first < 2U * TRNG_POOL_APT_WINDOW / 4U);
+    CHECK_EQUAL(1, Pool.HealthFailures);
+    CHECK_EQUAL(1, Pool.Failures);
+    CHECK_EQUAL(0, TRNG_PoolGetCount(&Pool));
+
+    /* The flushed words hold the storage until a read drops them */
+    CHECK_EQUAL(ERROR, TRNG_PoolRead(&Pool, Bytes, 4));
+    FillPool(TRNG_POOL_STARTUP_WORDS + 1U);
+    CHECK_EQUAL(0, Pool.Failures);
+    CHECK_EQUAL(4, TRNG_PoolGetCount(&Pool));
+}
+
+/**
+  * @brief  SP 800-90A known answers on each engine.
+  */
+static void Test_DrbgKnownAnswers(void)
+{
+    uint32_t engine;
+
+    for (engine = ENGINE_CPU; engine < ENGINE_COUNT; engine++)
+    {
+        InitDrbg(&Drbg[0], &Context[0], engine);
+        CHECK_EQUAL(SUCCESS, AES_DRBGInstantiate(&Drbg[0], CavpEntropy, sizeof(CavpEntropy),
+                                                 CavpNonce, sizeof(CavpNonce), NULL, 0));
+        CHECK_EQUAL(SUCCESS, AES_DRBGGenerate(&Drbg[0], Output[0], 64, NULL, 0));
+        CHECK_EQUAL(SUCCESS, AES_DRBGGenerate(&Drbg[0], Output[0], 64, NULL, 0));
+        CHECK_MEMORY(CavpReturned, Output[0], 64);
+
+        InitDrbg(&Drbg[0], &Context[0], engine);
+        CHECK_EQUAL(SUCCESS, AES_DRBGInstantiate(&Drbg[0], Entropy, sizeof(Entropy), Nonce, sizeof(Nonce),
+                                                 Personal, sizeof(Personal)));
+        CHECK_EQUAL(SUCCESS, AES_DRBGReseed(&Drbg[0], ReseedEntropy, sizeof(ReseedEntropy),
+                                            ReseedAData, sizeof(ReseedAData)));
+        CHECK_EQUAL(SUCCESS, AES_DRBGGenerate(&Drbg[0], Output[0], 64, AData[0], sizeof(AData[0])));
+        CHECK_EQUAL(SUCCESS, AES_DRBGGenerate(&Drbg[0], Output[0], 64, AData[1], sizeof(AData[1])));
+        CHECK_MEMORY(Returned, Output[0], 64);
+
+        AES_DRBGUninstantiate(&Drbg[0]);
+        CHECK_EQUAL(ERROR, AES_DRBGGenerate(&Drbg[0], Output[0], 16, NULL, 0));
+    }
+}
+
+/**
+  * @brief  Reseeds through GetEntropy once ReseedInterval requests were
+  *         served, with the same output as explicit reseeds; without
+  *         entropy the requests go on up to AES_DRBG_RESEED_LIMIT.
+  */
+static void Test_DrbgReseed(void)
+{
+    uint8_t entropy[AES_DRBG_ENTROPY_SIZE];
+    uint32_t i;
+
+    Seed = 5;
+    TRNG_PoolInit(&Pool);
+    FillPool(TRNG_POOL_STARTUP_WORDS + TRNG_POOL_SIZE);
+
+    InitDrbg(&Drbg[0], &Context[0], ENGINE_CPU);
+    InitDrbg(&Drbg[1], &Context[1], ENGINE_MODEL);
+    Drbg[0].ReseedInterval = 3;
+    Drbg[0].GetEntropy = GetEntropy;
+    CHECK_EQUAL(SUCCESS, AES_DRBGInstantiate(&Drbg[0], Entropy, sizeof(Entropy), Nonce, sizeof(Nonce), NULL, 0));
+    CHECK_EQUAL(SUCCESS, AES_DRBGInstantiate(&Drbg[1], Entropy, sizeof(Entropy), Nonce, sizeof(Nonce), NULL, 0));
+
+    /* Drbg[1] is reseeded by hand with the bytes the pool gives Drbg[0] */
+    for (i = 0; i < DRBG_REQUESTS; i++)
+    {
+        if ((i % 3U) == 0U && (i != 0U))
+        {
+            memcpy(entropy, &Pool.Buffer[Pool.Tail & (TRNG_POOL_SIZE - 1U)], sizeof(entropy));
+            CHECK_EQUAL(SUCCESS, AES_DRBGReseed(&Drbg[1], entropy, sizeof(entropy), AData[0], sizeof(AData[0])));
+            CHECK_EQUAL(SUCCESS, AES_DRBGGenerate(&Drbg[1], Output[1], 40, NULL, 0));
+        }
+        else
+        {
+            CHECK_EQUAL(SUCCESS, AES_DRBGGenerate(&Drbg[1], Output[1], 40, AData[0], sizeof(AData[0])));
+        }
+        CHECK_EQUAL(SUCCESS, AES_DRBGGenerate(&Drbg[0], Output[0], 40, AData[0], sizeof(AData[0])));
+        CHECK_MEMORY(Output[1], Output[0], 40);
+    }
+    CHECK_EQUAL(3, Drbg[0].Reseeds);
+    CHECK_EQUAL(4U * TRNG_POOL_SIZE - 3U * AES_DRBG_ENTROPY_SIZE, TRNG_PoolGetCount(&Pool));
+
+    /* Pool empty: served without reseed until the limit */
+    CHECK_EQUAL(SUCCESS, TRNG_PoolRead(&Pool, Bytes, TRNG_PoolGetCount(&Pool)));
+    CHECK_EQUAL(SUCCESS, AES_DRBGGenerate(&Drbg[0], Output[0], 16, NULL, 0));
+    CHECK_EQUAL(3, Drbg[0].Reseeds);
+    Drbg[0].ReseedCounter = AES_DRBG_RESEED_LIMIT + 1U;
+    memset(Output[0], 0xFF, 16);
+    CHECK_EQUAL(ERROR, AES_DRBGGenerate(&Drbg[0], Output[0], 16, NULL, 0));
+    memset(Output[1], 0, 16);
+    CHECK_MEMORY(Output[1], Output[0], 16);
+
+    FillPool(AES_DRBG_ENTROPY_SIZE / 4U);
+    CHECK_EQUAL(SUCCESS, AES_DRBGGenerate(&Drbg[0], Output[0], 16, NULL, 0));
+    CHECK_EQUAL(4, Drbg[0].Reseeds);
+    CHECK_EQUAL(2, Drbg[0].ReseedCounter);
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    HOSTTEST_RUN(Test_PoolStartup);
+    HOSTTEST_RUN(Test_PoolGoodSource);
+    HOSTTEST_RUN(Test_PoolStuck);
+    HOSTTEST_RUN(Test_PoolBiased);
+    /* The DRBG gives stack buffers to the DMA */
+    HOSTTEST_RUN_ON_SRAM(Test_DrbgKnownAnswers);
+    HOSTTEST_RUN_ON_SRAM(Test_DrbgReseed);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
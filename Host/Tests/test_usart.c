@@ -0,0 +1,197 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_usart.c
+* @brief:     USART driver on the USART and DMA models: polled transfers,
+*             overrun and idle line, receive interrupt, DMA in both
+*             directions.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "hk32l0xx.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_BAUDRATE               1000000U
+
+/* Private variables ---------------------------------------------------------*/
+static const uint8_t Message[] = "The quick brown fox jumps over the lazy dog";
+static uint8_t Received[128];
+static volatile uint32_t ReceivedCount;
+
+/* Private functions ---------------------------------------------------------*/
+static void InitUsart(USART_TypeDef* USARTx)
+{
+    USART_InitTypeDef init;
+
+    if (USARTx == USART1)
+    {
+        RCC_APB2PeriphClockCmd(RCC_APB2Periph_USART1, ENABLE);
+    }
+    else
+    {
+        RCC_APB1PeriphClockCmd(RCC_APB1Periph_USART2, ENABLE);
+    }
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA, ENABLE);
+
+    USART_StructInit(&init);
+    init.USART_BaudRate = TEST_BAUDRATE;
+    USART_Init(USARTx, &init);
+    USART_Cmd(USARTx, ENABLE);
+}
+
+static void Test_Polled(void)
+{
+    uint8_t sent[sizeof(Message)];
+    uint32_t i;
+
+    InitUsart(USART1);
+    CHECK(USART1->BRR != 0);
+
+    for (i = 0; i < sizeof(Message); i++)
+    {
+        while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET)
+        {
+        }
+        USART_SendData(USART1, Message[i]);
+    }
+    while (USART_GetFlagStatus(USART1, USART_FLAG_TC) == RESET)
+    {
+    }
+    CHECK_EQUAL(sizeof(Message), HostUsart_Transmitted(USART1, sent, sizeof(sent)));
+    CHECK_MEMORY(Message, sent, sizeof(Message));
+    CHECK_EQUAL(0, HostUsart_Transmitted(USART1, sent, sizeof(sent)));
+
+    HostUsart_Receive(USART1, Message, sizeof(Message));
+    for (i = 0; i < sizeof(Message); i++)
+    {
+        while (USART_GetFlagStatus(USART1, USART_FLAG_RXNE) == RESET)
+        {
+        }
+        Received[i] = (uint8_t)USART_ReceiveData(USART1);
+    }
+    CHECK_MEMORY(Message, Received, sizeof(Message));
+    CHECK_EQUAL(0, HostUsart_RxPending(USART1));
+    CHECK(USART_GetFlagStatus(USART1, USART_FLAG_ORE) == RESET);
+}
+
+static void Test_OverrunIdle(void)
+{
+    InitUsart(USART2);
+
+    /* Three characters, none read: the first one stays in RDR */
+    HostUsart_Receive(USART2, Message, 3);
+    while (HostUsart_RxPending(USART2) != 0)
+    {
+        (void)USART_GetFlagStatus(USART2, USART_FLAG_RXNE);
+    }
+    CHECK(USART_GetFlagStatus(USART2, USART_FLAG_ORE) != RESET);
+    CHECK_EQUAL(Message[0], USART_ReceiveData(USART2));
+    USART_ClearFlag(USART2, USART_FLAG_ORE);
+    CHECK(USART_GetFlagStatus(USART2, USART_FLAG_ORE) == RESET);
+
+    /* The line goes idle one character after the last one */
+    while (USART_GetFlagStatus(USART2, USART_FLAG_IDLE) == RESET)
+    {
+    }
+    USART_ClearFlag(USART2, USART_FLAG_IDLE);
+    CHECK(USART_GetFlagStatus(USART2, USART_FLAG_IDLE) == RESET);
+}
+
+void USART1_IRQHandler(void)
+{
+    if (USART_GetITStatus(USART1, USART_IT_RXNE) != RESET)
+    {
+        Received[ReceivedCount++] = (uint8_t)USART_ReceiveData(USART1);
+    }
+}
+
+static void Test_Interrupt(void)
+{
+    NVIC_InitTypeDef nvic;
+
+    InitUsart(USART1);
+    ReceivedCount = 0;
+
+    nvic.NVIC_IRQChannel = USART1_IRQn;
+    nvic.NVIC_IRQChannelPriority = 0;
+    nvic.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&nvic);
+    USART_ITConfig(USART1, USART_IT_RXNE, ENABLE);
+
+    HostUsart_Receive(USART1, Message, sizeof(Message));
+    while (ReceivedCount < sizeof(Message))
+    {
+        __WFI();
+    }
+    CHECK_MEMORY(Message, Received, sizeof(Message));
+    CHECK(USART_GetFlagStatus(USART1, USART_FLAG_ORE) == RESET);
+}
+
+static void Test_Dma(void)
+{
+    DMA_InitTypeDef init;
+    uint8_t sent[sizeof(Message)];
+
+    InitUsart(USART1);
+    memset(Received, 0, sizeof(Received));
+
+    /* Reception in circular mode */
+    DMA_StructInit(&init);
+    init.DMA_PeripheralBaseAddr = (uint32_t)&USART1->RDR;
+    init.DMA_MemoryBaseAddr = (uint32_t)Received;
+    init.DMA_DIR = DMA_DIR_PeripheralSRC;
+    init.DMA_BufferSize = 16;
+    init.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    init.DMA_Mode = DMA_Mode_Circular;
+    DMA_Init(DMA_Channel3, &init);
+    DMA_Cmd(DMA_Channel3, ENABLE);
+    USART_DMACmd(USART1, USART_DMAReq_Rx, ENABLE);
+
+    /* Transmission */
+    init.DMA_PeripheralBaseAddr = (uint32_t)&USART1->TDR;
+    init.DMA_MemoryBaseAddr = (uint32_t)Message;
+    init.DMA_DIR = DMA_DIR_PeripheralDST;
+    init.DMA_BufferSize = sizeof(Message);
+    init.DMA_Mode = DMA_Mode_Normal;
+    DMA_Init(DMA_Channel2, &init);
+    DMA_Cmd(DMA_Channel2, ENABLE);
+    USART_DMACmd(USART1, USART_DMAReq_Tx, ENABLE);
+
+    HostUsart_Receive(USART1, Message, 20);
+
+    while ((DMA_GetFlagStatus(DMA1_FLAG_TC2) == RESET) || (HostUsart_RxPending(USART1) != 0))
+    {
+    }
+    while (USART_GetFlagStatus(USART1, USART_FLAG_TC) == RESET)
+    {
+    }
+    CHECK_EQUAL(sizeof(Message), HostUsart_Transmitted(USART1, sent, sizeof(sent)));
+    CHECK_MEMORY(Message, sent, sizeof(Message));
+
+    /* 20 characters in a 16 bytes ring: the first 4 are overwritten */
+    while (USART_GetFlagStatus(USART1, USART_FLAG_RXNE) != RESET)
+    {
+    }
+    CHECK_EQUAL(12, DMA_GetCurrDataCounter(DMA_Channel3));
+    CHECK_MEMORY(Message + 16, Received, 4);
+    CHECK_MEMORY(Message + 4, Received + 4, 12);
+    CHECK(USART_GetFlagStatus(USART1, USART_FLAG_ORE) == RESET);
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    HOSTTEST_RUN(Test_Polled);
+    HOSTTEST_RUN(Test_OverrunIdle);
+    HOSTTEST_RUN(Test_Interrupt);
+    HOSTTEST_RUN(Test_Dma);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,288 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  test_usb_mem.c
+* @brief:     PMA copies of the USB-FS device driver on the packet memory
+*             model: every user buffer alignment and length, gather and
+*             scatter across even and odd segment boundaries, and the bus
+*             cycles per byte of each copy.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "usb_lib.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_PMA_ADDR               0x40U   /* PMA buffer, in bytes of the USB side */
+#define TEST_PMA_SIZE               0x100U
+#define TEST_MAX_LENGTH             67U
+#define TEST_SEGMENTS               4U
+#define TEST_SPLITS                 2000U
+#define TEST_PACKET                 64U
+#define TEST_HEADER                 13U     /* odd sized class header */
+#define TEST_SENTINEL               0xA5A5U
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t Source[TEST_MAX_LENGTH + 4];
+static uint8_t Target[TEST_MAX_LENGTH + 4];
+static uint8_t Pieces[TEST_SEGMENTS][TEST_MAX_LENGTH + 4];
+static uint32_t Seed = 0x13579BDF;
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t Random(void)
+{
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 17;
+    Seed ^= Seed << 5;
+    return Seed;
+}
+
+static void Fill(uint8_t* Buffer, uint32_t Length)
+{
+    uint32_t i;
+
+    for (i = 0; i < Length; i++)
+    {
+        Buffer[i] = (uint8_t)Random();
+    }
+}
+
+/**
+  * @brief  Half-word Index of the PMA buffer, read as the USB side sees it.
+  */
+static uint16_t PmaHalfWord(uint32_t Index)
+{
+    return (uint16_t)*(__IO uint32_t*)(PMAAddr + (TEST_PMA_ADDR + Index * 2U) * 2U);
+}
+
+/**
+  * @brief  Sets the PMA buffer to the sentinel to see the half-words written.
+  */
+static void PmaClear(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < TEST_PMA_SIZE / 2U; i++)
+    {
+        *(__IO uint16_t*)(PMAAddr + (TEST_PMA_ADDR + i * 2U) * 2U) = TEST_SENTINEL;
+    }
+}
+
+/**
+  * @brief  The PMA buffer holds Data in little endian half-words, the upper
+  *         byte of an odd length is 0 and nothing is written past it.
+  */
+static void CheckPma(const uint8_t* Data, uint32_t Length)
+{
+    uint32_t i;
+    uint16_t expected;
+
+    for (i = 0; i < (Length + 1U) / 2U; i++)
+    {
+        expected = (uint16_t)(Data[2U * i] | (((2U * i + 1U) < Length) ? (Data[2U * i + 1U] << 8) : 0));
+
+        if (!CHECK_EQUAL(expected, PmaHalfWord(i)))
+        {
+            return;
+        }
+    }
+
+    CHECK_EQUAL(TEST_SENTINEL, PmaHalfWord(i));
+}
+
+/**
+  * @brief  Splits Length bytes into Count segments of random lengths, empty
+  *         and odd ones included, at random alignments.
+  */
+static void Split(PMA_SEGMENT* Segment, uint32_t Count, uint32_t Length)
+{
+    uint32_t i;
+    uint32_t n;
+
+    for (i = 0; i < Count; i++)
+    {
+        n = (i == Count - 1U) ? Length : (Random() % (Length + 1U));
+        Segment[i].pbBuf = Pieces[i] + (Random() & 3U);
+        Segment[i].wNBytes = (uint16_t)n;
+        Length -= n;
+    }
+}
+
+/**
+  * @brief  UserToPMABufferCopy() and PMAToUserBufferCopy() for every length
+  *         up to TEST_MAX_LENGTH and every alignment of the user buffer.
+  */
+static void Test_Copy(void)
+{
+    uint32_t length;
+    uint32_t align;
+
+    for (length = 0; length <= TEST_MAX_LENGTH; length++)
+    {
+        for (align = 0; align < 4U; align++)
+        {
+            Fill(Source + align, length);
+            PmaClear();
+            UserToPMABufferCopy(Source + align, TEST_PMA_ADDR, (uint16_t)length);
+            CheckPma(Source + align, length);
+
+            memset(Target, 0x5A, sizeof(Target));
+            PMAToUserBufferCopy(Target + align, TEST_PMA_ADDR, (uint16_t)length);
+            CHECK_MEMORY(Source + align, Target + align, length);
+            /* The bytes around the user buffer are not touched */
+            CHECK_EQUAL(0x5A, Target[align + length]);
+            CHECK((align == 0) || (Target[align - 1U] == 0x5A));
+        }
+    }
+}
+
+/**
+  * @brief  UserToPMABufferCopyGather() of random splits into 1 to
+  *         TEST_SEGMENTS segments gives the PMA buffer of the whole data.
+  */
+static void Test_Gather(void)
+{
+    PMA_SEGMENT segment[TEST_SEGMENTS];
+    uint32_t count;
+    uint32_t length;
+    uint32_t offset;
+    uint32_t i;
+    uint32_t n;
+
+    for (n = 0; n < TEST_SPLITS; n++)
+    {
+        length = Random() % (TEST_MAX_LENGTH + 1U);
+        count = 1U + (Random() % TEST_SEGMENTS);
+        Split(segment, count, length);
+
+        for (i = 0, offset = 0; i < count; i++)
+        {
+            Fill(segment[i].pbBuf, segment[i].wNBytes);
+            memcpy(Source + offset, segment[i].pbBuf, segment[i].wNBytes);
+            offset += segment[i].wNBytes;
+        }
+
+        PmaClear();
+        CHECK_EQUAL(length, UserToPMABufferCopyGather(segment, (uint8_t)count, TEST_PMA_ADDR));
+        CheckPma(Source, length);
+    }
+
+    /* A header and a payload both odd sized, the payload unaligned */
+    Fill(Pieces[0], TEST_HEADER);
+    Fill(Pieces[1] + 1, TEST_PACKET - TEST_HEADER);
+    segment[0].pbBuf = Pieces[0];
+    segment[0].wNBytes = TEST_HEADER;
+    segment[1].pbBuf = Pieces[1] + 1;
+    segment[1].wNBytes = TEST_PACKET - TEST_HEADER;
+    memcpy(Source, Pieces[0], TEST_HEADER);
+    memcpy(Source + TEST_HEADER, Pieces[1] + 1, TEST_PACKET - TEST_HEADER);
+    PmaClear();
+    CHECK_EQUAL(TEST_PACKET, UserToPMABufferCopyGather(segment, 2, TEST_PMA_ADDR));
+    CheckPma(Source, TEST_PACKET);
+}
+
+/**
+  * @brief  PMAToUserBufferCopyScatter() of the PMA buffer into random splits
+  *         gives back the data, without writing past any segment.
+  */
+static void Test_Scatter(void)
+{
+    PMA_SEGMENT segment[TEST_SEGMENTS];
+    uint32_t count;
+    uint32_t length;
+    uint32_t offset;
+    uint32_t i;
+    uint32_t n;
+
+    for (n = 0; n < TEST_SPLITS; n++)
+    {
+        length = Random() % (TEST_MAX_LENGTH + 1U);
+        count = 1U + (Random() % TEST_SEGMENTS);
+        Split(segment, count, length);
+
+        Fill(Source, length);
+        UserToPMABufferCopy(Source, TEST_PMA_ADDR, (uint16_t)length);
+        memset(Pieces, 0x5A, sizeof(Pieces));
+        CHECK_EQUAL(length, PMAToUserBufferCopyScatter(segment, (uint8_t)count, TEST_PMA_ADDR));
+
+        for (i = 0, offset = 0; i < count; i++)
+        {
+            CHECK_MEMORY(Source + offset, segment[i].pbBuf, segment[i].wNBytes);
+            CHECK_EQUAL(0x5A, segment[i].pbBuf[segment[i].wNBytes]);
+            CHECK((segment[i].pbBuf == Pieces[i]) || (segment[i].pbBuf[-1] == 0x5A));
+            offset += segment[i].wNBytes;
+        }
+    }
+}
+
+/**
+  * @brief  Bus cycles of a 64 bytes packet copied in one piece, gathered or
+  *         scattered as two even halves and as an odd header with an
+  *         unaligned payload. The PMA accesses are the same: one per
+  *         half-word, the odd boundary costs nothing more. The simulator
+  *         times the PMA accesses only, not the user buffer side.
+  */
+static void Test_Cycles(void)
+{
+    PMA_SEGMENT halves[2] = {{Pieces[0], TEST_PACKET / 2U}, {Pieces[1], TEST_PACKET / 2U}};
+    PMA_SEGMENT header[2] = {{Pieces[0], TEST_HEADER}, {Pieces[1] + 1, TEST_PACKET - TEST_HEADER}};
+    uint64_t copy[2];
+    uint64_t even[2];
+    uint64_t odd[2];
+    uint64_t start;
+
+    Fill(Source, TEST_PACKET);
+
+    start = HostSim_Cycles();
+    UserToPMABufferCopy(Source, TEST_PMA_ADDR, TEST_PACKET);
+    copy[0] = HostSim_Cycles() - start;
+
+    start = HostSim_Cycles();
+    UserToPMABufferCopyGather(halves, 2, TEST_PMA_ADDR);
+    even[0] = HostSim_Cycles() - start;
+
+    start = HostSim_Cycles();
+    UserToPMABufferCopyGather(header, 2, TEST_PMA_ADDR);
+    odd[0] = HostSim_Cycles() - start;
+
+    start = HostSim_Cycles();
+    PMAToUserBufferCopy(Target, TEST_PMA_ADDR, TEST_PACKET);
+    copy[1] = HostSim_Cycles() - start;
+
+    start = HostSim_Cycles();
+    PMAToUserBufferCopyScatter(halves, 2, TEST_PMA_ADDR);
+    even[1] = HostSim_Cycles() - start;
+
+    start = HostSim_Cycles();
+    PMAToUserBufferCopyScatter(header, 2, TEST_PMA_ADDR);
+    odd[1] = HostSim_Cycles() - start;
+
+    CHECK_EQUAL(TEST_PACKET / 2U * HOSTSIM_ACCESS_CYCLES, copy[0]);
+    CHECK_EQUAL(TEST_PACKET / 2U * HOSTSIM_ACCESS_CYCLES, copy[1]);
+    CHECK_EQUAL(copy[0], even[0]);
+    CHECK_EQUAL(copy[0], odd[0]);
+    CHECK_EQUAL(copy[1], even[1]);
+    CHECK_EQUAL(copy[1], odd[1]);
+
+    printf("USB PMA %u bytes, bus cycles per byte: write %.2f, gather %.2f (even) %.2f (odd), "
+           "read %.2f, scatter %.2f (even) %.2f (odd)\n", TEST_PACKET,
+           (double)copy[0] / TEST_PACKET, (double)even[0] / TEST_PACKET, (double)odd[0] / TEST_PACKET,
+           (double)copy[1] / TEST_PACKET, (double)even[1] / TEST_PACKET, (double)odd[1] / TEST_PACKET);
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    HOSTTEST_RUN(Test_Copy);
+    HOSTTEST_RUN(Test_Gather);
+    HOSTTEST_RUN(Test_Scatter);
+    HOSTTEST_RUN(Test_Cycles);
+
+    return HostTest_End();
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,154 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_math_ext.h
+* @brief:     Cortex-M0 helpers and moving average of the fixed-point DSP library
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __ARM_MATH_EXT_H
+#define __ARM_MATH_EXT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The DSP_Lib sources implement the q15/q31 subset of arm_math.h listed
+ * below for the Cortex-M0 (ARM_MATH_CM0), with the CMSIS prototypes, data
+ * formats and instance structures:
+ *   - FIR:            arm_fir_init_q15/q31, arm_fir_q15/q31
+ *   - biquad IIR:     arm_biquad_cascade_df1_init_q15/q31, arm_biquad_cascade_df1_q15/q31
+ *   - statistics:     arm_mean_q15/q31, arm_rms_q15/q31, arm_min_q15/q31, arm_max_q15/q31
+ *   - square root:    arm_sqrt_q15/q31
+ *   - transforms:     arm_cfft_q15/q31 (16 to 256 points, arm_cfft_sR_xxx_lenN instances),
+ *                     arm_rfft_init_q15/q31, arm_rfft_q15/q31 (32 to 256 points)
+ * and the moving average declared in this file.
+ *
+ * The Cortex-M0 multiplier gives the low 32 bits of a 32 x 32 product: a
+ * q15 product is a single MULS, accumulated in 64 bits with ADDS/ADCS, and
+ * a q31 product is built from four 16 x 16 products by arm_mult_q31_q63()
+ * instead of the 64 x 64 multiply routine of the C library.
+ *
+ * Define ARM_MATH_DVSQ when building the library to compute the square
+ * roots and the divisions of arm_mean, arm_rms and arm_sqrt with the DVSQ
+ * unit. The application then calls DVSQ_Init() before the first call, and
+ * no interrupt may use DVSQ while a kernel runs.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math.h"
+
+#if defined(ARM_MATH_DVSQ)
+#include "hk32l0xx_divsqrt.h"
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+/**
+  * @brief  Instance structure of the Q15 moving average.
+  */
+typedef struct
+{
+    uint16_t windowLen;               /*!< Number of samples averaged */
+    uint16_t index;                   /*!< Position of the oldest sample in pState */
+    q15_t* pState;                    /*!< Last windowLen samples, windowLen values */
+    q31_t sum;                        /*!< Sum of the samples of pState */
+    q31_t recip;                      /*!< 2^(31 + shift) / windowLen, 0 when windowLen is a power of 2 */
+    uint8_t shift;                    /*!< log2(windowLen) rounded down */
+} arm_moving_average_instance_q15;
+
+/**
+  * @brief  Instance structure of the Q31 moving average.
+  */
+typedef struct
+{
+    uint16_t windowLen;               /*!< Number of samples averaged */
+    uint16_t index;                   /*!< Position of the oldest sample in pState */
+    q31_t* pState;                    /*!< Last windowLen samples, windowLen values */
+    q63_t sum;                        /*!< Sum of the samples of pState */
+    q31_t recip;                      /*!< 2^(31 + shift) / windowLen, 0 when windowLen is a power of 2 */
+    uint8_t shift;                    /*!< log2(windowLen) rounded down */
+} arm_moving_average_instance_q31;
+
+/* Exported inline functions ------------------------------------------------ */
+/**
+  * @brief  Exact 32 x 32 -> 64 bits signed product from four 16 x 16 products.
+  * @param  a: first factor.
+  * @param  b: second factor.
+  * @retval a x b
+  */
+static __INLINE q63_t arm_mult_q31_q63(q31_t a, q31_t b)
+{
+    int32_t ah = a >> 16;
+    int32_t bh = b >> 16;
+    uint32_t al = (uint32_t)a & 0xFFFF;
+    uint32_t bl = (uint32_t)b & 0xFFFF;
+    uint32_t low = al * bl;
+    int32_t mid1 = ah * (int32_t)bl;
+    int32_t mid2 = (int32_t)al * bh;
+    uint32_t carry = (low >> 16) + ((uint32_t)mid1 & 0xFFFF) + ((uint32_t)mid2 & 0xFFFF);
+    int32_t high = (ah * bh) + (mid1 >> 16) + (mid2 >> 16) + (int32_t)(carry >> 16);
+
+    return (q63_t)(((uint64_t)(uint32_t)high << 32) | ((carry << 16) | (low & 0xFFFF)));
+}
+
+/**
+  * @brief  Right shift rounded to nearest. The largest results stay at
+  *         INT32_MAX >> shift, so that sums of 2^shift of them cannot overflow.
+  * @param  x: value to scale down.
+  * @param  shift: 1 to 31.
+  * @retval x / 2^shift
+  */
+static __INLINE q31_t arm_shift_round_q31(q31_t x, uint32_t shift)
+{
+    q31_t y = x >> shift;
+
+    return (y < (INT32_MAX >> shift)) ? (y + ((x >> (shift - 1u)) & 1)) : y;
+}
+
+/**
+  * @brief  Unsigned 32 bits division, on DVSQ with ARM_MATH_DVSQ.
+  * @param  n: dividend.
+  * @param  d: divisor, not 0.
+  * @retval n / d
+  */
+static __INLINE uint32_t arm_div_u32(uint32_t n, uint32_t d)
+{
+#if defined(ARM_MATH_DVSQ)
+    return DVSQ_UDivsion(n, d, NULL);
+#else
+    return n / d;
+#endif
+}
+
+/**
+  * @brief  Signed 32 bits division rounded toward zero, on DVSQ with ARM_MATH_DVSQ.
+  * @param  n: dividend.
+  * @param  d: divisor, not 0.
+  * @retval n / d
+  */
+static __INLINE int32_t arm_div_s32(int32_t n, int32_t d)
+{
+#if defined(ARM_MATH_DVSQ)
+    return DVSQ_Divsion(n, d, NULL);
+#else
+    return n / d;
+#endif
+}
+
+/* Exported functions ------------------------------------------------------- */
+arm_status arm_moving_average_init_q15(arm_moving_average_instance_q15* S, uint16_t windowLen, q15_t* pState);
+void arm_moving_average_q15(arm_moving_average_instance_q15* S, q15_t* pSrc, q15_t* pDst, uint32_t blockSize);
+arm_status arm_moving_average_init_q31(arm_moving_average_instance_q31* S, uint16_t windowLen, q31_t* pState);
+void arm_moving_average_q31(arm_moving_average_instance_q31* S, q31_t* pSrc, q31_t* pDst, uint32_t blockSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ARM_MATH_EXT_H */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
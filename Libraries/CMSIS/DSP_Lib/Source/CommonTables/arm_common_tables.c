@@ -0,0 +1,146 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_common_tables.c
+* @brief:     Twiddle factor tables of the fixed-point transforms
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+#include "arm_common_tables.h"
+
+/*
+ * The transforms of DSP_Lib use a single table per format, the one of the
+ * 256 points complex FFT: the smaller transforms read it with a stride.
+ * Entry k holds cos(2 x pi x k / 256) then sin(2 x pi x k / 256), for k
+ * from 0 to 191, W^k being cos - j sin for the forward transform.
+ */
+
+/**
+  * @brief  Q15 twiddle factors of the 256 points complex FFT.
+  */
+const q15_t twiddleCoef_256_q15[384] =
+{
+    (q15_t)0x7FFF, (q15_t)0x0000, (q15_t)0x7FF6, (q15_t)0x0324, (q15_t)0x7FD9, (q15_t)0x0648, (q15_t)0x7FA7, (q15_t)0x096B,
+    (q15_t)0x7F62, (q15_t)0x0C8C, (q15_t)0x7F0A, (q15_t)0x0FAB, (q15_t)0x7E9D, (q15_t)0x12C8, (q15_t)0x7E1E, (q15_t)0x15E2,
+    (q15_t)0x7D8A, (q15_t)0x18F9, (q15_t)0x7CE4, (q15_t)0x1C0C, (q15_t)0x7C2A, (q15_t)0x1F1A, (q15_t)0x7B5D, (q15_t)0x2224,
+    (q15_t)0x7A7D, (q15_t)0x2528, (q15_t)0x798A, (q15_t)0x2827, (q15_t)0x7885, (q15_t)0x2B1F, (q15_t)0x776C, (q15_t)0x2E11,
+    (q15_t)0x7642, (q15_t)0x30FC, (q15_t)0x7505, (q15_t)0x33DF, (q15_t)0x73B6, (q15_t)0x36BA, (q15_t)0x7255, (q15_t)0x398D,
+    (q15_t)0x70E3, (q15_t)0x3C57, (q15_t)0x6F5F, (q15_t)0x3F17, (q15_t)0x6DCA, (q15_t)0x41CE, (q15_t)0x6C24, (q15_t)0x447B,
+    (q15_t)0x6A6E, (q15_t)0x471D, (q15_t)0x68A7, (q15_t)0x49B4, (q15_t)0x66D0, (q15_t)0x4C40, (q15_t)0x64E9, (q15_t)0x4EC0,
+    (q15_t)0x62F2, (q15_t)0x5134, (q15_t)0x60EC, (q15_t)0x539B, (q15_t)0x5ED7, (q15_t)0x55F6, (q15_t)0x5CB4, (q15_t)0x5843,
+    (q15_t)0x5A82, (q15_t)0x5A82, (q15_t)0x5843, (q15_t)0x5CB4, (q15_t)0x55F6, (q15_t)0x5ED7, (q15_t)0x539B, (q15_t)0x60EC,
+    (q15_t)0x5134, (q15_t)0x62F2, (q15_t)0x4EC0, (q15_t)0x64E9, (q15_t)0x4C40, (q15_t)0x66D0, (q15_t)0x49B4, (q15_t)0x68A7,
+    (q15_t)0x471D, (q15_t)0x6A6E, (q15_t)0x447B, (q15_t)0x6C24, (q15_t)0x41CE, (q15_t)0x6DCA, (q15_t)0x3F17, (q15_t)0x6F5F,
+    (q15_t)0x3C57, (q15_t)0x70E3, (q15_t)0x398D, (q15_t)0x7255, (q15_t)0x36BA, (q15_t)0x73B6, (q15_t)0x33DF, (q15_t)0x7505,
+    (q15_t)0x30FC, (q15_t)0x7642, (q15_t)0x2E11, (q15_t)0x776C, (q15_t)0x2B1F, (q15_t)0x7885, (q15_t)0x2827, (q15_t)0x798A,
+    (q15_t)0x2528, (q15_t)0x7A7D, (q15_t)0x2224, (q15_t)0x7B5D, (q15_t)0x1F1A, (q15_t)0x7C2A, (q15_t)0x1C0C, (q15_t)0x7CE4,
+    (q15_t)0x18F9, (q15_t)0x7D8A, (q15_t)0x15E2, (q15_t)0x7E1E, (q15_t)0x12C8, (q15_t)0x7E9D, (q15_t)0x0FAB, (q15_t)0x7F0A,
+    (q15_t)0x0C8C, (q15_t)0x7F62, (q15_t)0x096B, (q15_t)0x7FA7, (q15_t)0x0648, (q15_t)0x7FD9, (q15_t)0x0324, (q15_t)0x7FF6,
+    (q15_t)0x0000, (q15_t)0x7FFF, (q15_t)0xFCDC, (q15_t)0x7FF6, (q15_t)0xF9B8, (q15_t)0x7FD9, (q15_t)0xF695, (q15_t)0x7FA7,
+    (q15_t)0xF374, (q15_t)0x7F62, (q15_t)0xF055, (q15_t)0x7F0A, (q15_t)0xED38, (q15_t)0x7E9D, (q15_t)0xEA1E, (q15_t)0x7E1E,
+    (q15_t)0xE707, (q15_t)0x7D8A, (q15_t)0xE3F4, (q15_t)0x7CE4, (q15_t)0xE0E6, (q15_t)0x7C2A, (q15_t)0xDDDC, (q15_t)0x7B5D,
+    (q15_t)0xDAD8, (q15_t)0x7A7D, (q15_t)0xD7D9, (q15_t)0x798A, (q15_t)0xD4E1, (q15_t)0x7885, (q15_t)0xD1EF, (q15_t)0x776C,
+    (q15_t)0xCF04, (q15_t)0x7642, (q15_t)0xCC21, (q15_t)0x7505, (q15_t)0xC946, (q15_t)0x73B6, (q15_t)0xC673, (q15_t)0x7255,
+    (q15_t)0xC3A9, (q15_t)0x70E3, (q15_t)0xC0E9, (q15_t)0x6F5F, (q15_t)0xBE32, (q15_t)0x6DCA, (q15_t)0xBB85, (q15_t)0x6C24,
+    (q15_t)0xB8E3, (q15_t)0x6A6E, (q15_t)0xB64C, (q15_t)0x68A7, (q15_t)0xB3C0, (q15_t)0x66D0, (q15_t)0xB140, (q15_t)0x64E9,
+    (q15_t)0xAECC, (q15_t)0x62F2, (q15_t)0xAC65, (q15_t)0x60EC, (q15_t)0xAA0A, (q15_t)0x5ED7, (q15_t)0xA7BD, (q15_t)0x5CB4,
+    (q15_t)0xA57E, (q15_t)0x5A82, (q15_t)0xA34C, (q15_t)0x5843, (q15_t)0xA129, (q15_t)0x55F6, (q15_t)0x9F14, (q15_t)0x539B,
+    (q15_t)0x9D0E, (q15_t)0x5134, (q15_t)0x9B17, (q15_t)0x4EC0, (q15_t)0x9930, (q15_t)0x4C40, (q15_t)0x9759, (q15_t)0x49B4,
+    (q15_t)0x9592, (q15_t)0x471D, (q15_t)0x93DC, (q15_t)0x447B, (q15_t)0x9236, (q15_t)0x41CE, (q15_t)0x90A1, (q15_t)0x3F17,
+    (q15_t)0x8F1D, (q15_t)0x3C57, (q15_t)0x8DAB, (q15_t)0x398D, (q15_t)0x8C4A, (q15_t)0x36BA, (q15_t)0x8AFB, (q15_t)0x33DF,
+    (q15_t)0x89BE, (q15_t)0x30FC, (q15_t)0x8894, (q15_t)0x2E11, (q15_t)0x877B, (q15_t)0x2B1F, (q15_t)0x8676, (q15_t)0x2827,
+    (q15_t)0x8583, (q15_t)0x2528, (q15_t)0x84A3, (q15_t)0x2224, (q15_t)0x83D6, (q15_t)0x1F1A, (q15_t)0x831C, (q15_t)0x1C0C,
+    (q15_t)0x8276, (q15_t)0x18F9, (q15_t)0x81E2, (q15_t)0x15E2, (q15_t)0x8163, (q15_t)0x12C8, (q15_t)0x80F6, (q15_t)0x0FAB,
+    (q15_t)0x809E, (q15_t)0x0C8C, (q15_t)0x8059, (q15_t)0x096B, (q15_t)0x8027, (q15_t)0x0648, (q15_t)0x800A, (q15_t)0x0324,
+    (q15_t)0x8000, (q15_t)0x0000, (q15_t)0x800A, (q15_t)0xFCDC, (q15_t)0x8027, (q15_t)0xF9B8, (q15_t)0x8059, (q15_t)0xF695,
+    (q15_t)0x809E, (q15_t)0xF374, (q15_t)0x80F6, (q15_t)0xF055, (q15_t)0x8163, (q15_t)0xED38, (q15_t)0x81E2, (q15_t)0xEA1E,
+    (q15_t)0x8276, (q15_t)0xE707, (q15_t)0x831C, (q15_t)0xE3F4, (q15_t)0x83D6, (q15_t)0xE0E6, (q15_t)0x84A3, (q15_t)0xDDDC,
+    (q15_t)0x8583, (q15_t)0xDAD8, (q15_t)0x8676, (q15_t)0xD7D9, (q15_t)0x877B, (q15_t)0xD4E1, (q15_t)0x8894, (q15_t)0xD1EF,
+    (q15_t)0x89BE, (q15_t)0xCF04, (q15_t)0x8AFB, (q15_t)0xCC21, (q15_t)0x8C4A, (q15_t)0xC946, (q15_t)0x8DAB, (q15_t)0xC673,
+    (q15_t)0x8F1D, (q15_t)0xC3A9, (q15_t)0x90A1, (q15_t)0xC0E9, (q15_t)0x9236, (q15_t)0xBE32, (q15_t)0x93DC, (q15_t)0xBB85,
+    (q15_t)0x9592, (q15_t)0xB8E3, (q15_t)0x9759, (q15_t)0xB64C, (q15_t)0x9930, (q15_t)0xB3C0, (q15_t)0x9B17, (q15_t)0xB140,
+    (q15_t)0x9D0E, (q15_t)0xAECC, (q15_t)0x9F14, (q15_t)0xAC65, (q15_t)0xA129, (q15_t)0xAA0A, (q15_t)0xA34C, (q15_t)0xA7BD,
+    (q15_t)0xA57E, (q15_t)0xA57E, (q15_t)0xA7BD, (q15_t)0xA34C, (q15_t)0xAA0A, (q15_t)0xA129, (q15_t)0xAC65, (q15_t)0x9F14,
+    (q15_t)0xAECC, (q15_t)0x9D0E, (q15_t)0xB140, (q15_t)0x9B17, (q15_t)0xB3C0, (q15_t)0x9930, (q15_t)0xB64C, (q15_t)0x9759,
+    (q15_t)0xB8E3, (q15_t)0x9592, (q15_t)0xBB85, (q15_t)0x93DC, (q15_t)0xBE32, (q15_t)0x9236, (q15_t)0xC0E9, (q15_t)0x90A1,
+    (q15_t)0xC3A9, (q15_t)0x8F1D, (q15_t)0xC673, (q15_t)0x8DAB, (q15_t)0xC946, (q15_t)0x8C4A, (q15_t)0xCC21, (q15_t)0x8AFB,
+    (q15_t)0xCF04, (q15_t)0x89BE, (q15_t)0xD1EF, (q15_t)0x8894, (q15_t)0xD4E1, (q15_t)0x877B, (q15_t)0xD7D9, (q15_t)0x8676,
+    (q15_t)0xDAD8, (q15_t)0x8583, (q15_t)0xDDDC, (q15_t)0x84A3, (q15_t)0xE0E6, (q15_t)0x83D6, (q15_t)0xE3F4, (q15_t)0x831C,
+    (q15_t)0xE707, (q15_t)0x8276, (q15_t)0xEA1E, (q15_t)0x81E2, (q15_t)0xED38, (q15_t)0x8163, (q15_t)0xF055, (q15_t)0x80F6,
+    (q15_t)0xF374, (q15_t)0x809E, (q15_t)0xF695, (q15_t)0x8059, (q15_t)0xF9B8, (q15_t)0x8027, (q15_t)0xFCDC, (q15_t)0x800A
+};
+
+/**
+  * @brief  Q31 twiddle factors of the 256 points complex FFT.
+  */
+const q31_t twiddleCoef_256_q31[384] =
+{
+    0x7FFFFFFF, 0x00000000, 0x7FF62182, 0x03242ABF, 0x7FD8878E, 0x0647D97C,
+    0x7FA736B4, 0x096A9049, 0x7F62368F, 0x0C8BD35E, 0x7F0991C4, 0x0FAB272B,
+    0x7E9D55FC, 0x12C8106F, 0x7E1D93EA, 0x15E21445, 0x7D8A5F40, 0x18F8B83C,
+    0x7CE3CEB2, 0x1C0B826A, 0x7C29FBEE, 0x1F19F97B, 0x7B5D039E, 0x2223A4C5,
+    0x7A7D055B, 0x25280C5E, 0x798A23B1, 0x2826B928, 0x78848414, 0x2B1F34EB,
+    0x776C4EDB, 0x2E110A62, 0x7641AF3D, 0x30FBC54D, 0x7504D345, 0x33DEF287,
+    0x73B5EBD1, 0x36BA2014, 0x72552C85, 0x398CDD32, 0x70E2CBC6, 0x3C56BA70,
+    0x6F5F02B2, 0x3F1749B8, 0x6DCA0D14, 0x41CE1E65, 0x6C242960, 0x447ACD50,
+    0x6A6D98A4, 0x471CECE7, 0x68A69E81, 0x49B41533, 0x66CF8120, 0x4C3FDFF4,
+    0x64E88926, 0x4EBFE8A5, 0x62F201AC, 0x5133CC94, 0x60EC3830, 0x539B2AF0,
+    0x5ED77C8A, 0x55F5A4D2, 0x5CB420E0, 0x5842DD54, 0x5A82799A, 0x5A82799A,
+    0x5842DD54, 0x5CB420E0, 0x55F5A4D2, 0x5ED77C8A, 0x539B2AF0, 0x60EC3830,
+    0x5133CC94, 0x62F201AC, 0x4EBFE8A5, 0x64E88926, 0x4C3FDFF4, 0x66CF8120,
+    0x49B41533, 0x68A69E81, 0x471CECE7, 0x6A6D98A4, 0x447ACD50, 0x6C242960,
+    0x41CE1E65, 0x6DCA0D14, 0x3F1749B8, 0x6F5F02B2, 0x3C56BA70, 0x70E2CBC6,
+    0x398CDD32, 0x72552C85, 0x36BA2014, 0x73B5EBD1, 0x33DEF287, 0x7504D345,
+    0x30FBC54D, 0x7641AF3D, 0x2E110A62, 0x776C4EDB, 0x2B1F34EB, 0x78848414,
+    0x2826B928, 0x798A23B1, 0x25280C5E, 0x7A7D055B, 0x2223A4C5, 0x7B5D039E,
+    0x1F19F97B, 0x7C29FBEE, 0x1C0B826A, 0x7CE3CEB2, 0x18F8B83C, 0x7D8A5F40,
+    0x15E21445, 0x7E1D93EA, 0x12C8106F, 0x7E9D55FC, 0x0FAB272B, 0x7F0991C4,
+    0x0C8BD35E, 0x7F62368F, 0x096A9049, 0x7FA736B4, 0x0647D97C, 0x7FD8878E,
+    0x03242ABF, 0x7FF62182, 0x00000000, 0x7FFFFFFF, 0xFCDBD541, 0x7FF62182,
+    0xF9B82684, 0x7FD8878E, 0xF6956FB7, 0x7FA736B4, 0xF3742CA2, 0x7F62368F,
+    0xF054D8D5, 0x7F0991C4, 0xED37EF91, 0x7E9D55FC, 0xEA1DEBBB, 0x7E1D93EA,
+    0xE70747C4, 0x7D8A5F40, 0xE3F47D96, 0x7CE3CEB2, 0xE0E60685, 0x7C29FBEE,
+    0xDDDC5B3B, 0x7B5D039E, 0xDAD7F3A2, 0x7A7D055B, 0xD7D946D8, 0x798A23B1,
+    0xD4E0CB15, 0x78848414, 0xD1EEF59E, 0x776C4EDB, 0xCF043AB3, 0x7641AF3D,
+    0xCC210D79, 0x7504D345, 0xC945DFEC, 0x73B5EBD1, 0xC67322CE, 0x72552C85,
+    0xC3A94590, 0x70E2CBC6, 0xC0E8B648, 0x6F5F02B2, 0xBE31E19B, 0x6DCA0D14,
+    0xBB8532B0, 0x6C242960, 0xB8E31319, 0x6A6D98A4, 0xB64BEACD, 0x68A69E81,
+    0xB3C0200C, 0x66CF8120, 0xB140175B, 0x64E88926, 0xAECC336C, 0x62F201AC,
+    0xAC64D510, 0x60EC3830, 0xAA0A5B2E, 0x5ED77C8A, 0xA7BD22AC, 0x5CB420E0,
+    0xA57D8666, 0x5A82799A, 0xA34BDF20, 0x5842DD54, 0xA1288376, 0x55F5A4D2,
+    0x9F13C7D0, 0x539B2AF0, 0x9D0DFE54, 0x5133CC94, 0x9B1776DA, 0x4EBFE8A5,
+    0x99307EE0, 0x4C3FDFF4, 0x9759617F, 0x49B41533, 0x9592675C, 0x471CECE7,
+    0x93DBD6A0, 0x447ACD50, 0x9235F2EC, 0x41CE1E65, 0x90A0FD4E, 0x3F1749B8,
+    0x8F1D343A, 0x3C56BA70, 0x8DAAD37B, 0x398CDD32, 0x8C4A142F, 0x36BA2014,
+    0x8AFB2CBB, 0x33DEF287, 0x89BE50C3, 0x30FBC54D, 0x8893B125, 0x2E110A62,
+    0x877B7BEC, 0x2B1F34EB, 0x8675DC4F, 0x2826B928, 0x8582FAA5, 0x25280C5E,
+    0x84A2FC62, 0x2223A4C5, 0x83D60412, 0x1F19F97B, 0x831C314E, 0x1C0B826A,
+    0x8275A0C0, 0x18F8B83C, 0x81E26C16, 0x15E21445, 0x8162AA04, 0x12C8106F,
+    0x80F66E3C, 0x0FAB272B, 0x809DC971, 0x0C8BD35E, 0x8058C94C, 0x096A9049,
+    0x80277872, 0x0647D97C, 0x8009DE7E, 0x03242ABF, 0x80000000, 0x00000000,
+    0x8009DE7E, 0xFCDBD541, 0x80277872, 0xF9B82684, 0x8058C94C, 0xF6956FB7,
+    0x809DC971, 0xF3742CA2, 0x80F66E3C, 0xF054D8D5, 0x8162AA04, 0xED37EF91,
+    0x81E26C16, 0xEA1DEBBB, 0x8275A0C0, 0xE70747C4, 0x831C314E, 0xE3F47D96,
+    0x83D60412, 0xE0E60685, 0x84A2FC62, 0xDDDC5B3B, 0x8582FAA5, 0xDAD7F3A2,
+    0x8675DC4F, 0xD7D946D8, 0x877B7BEC, 0xD4E0CB15, 0x8893B125, 0xD1EEF59E,
+    0x89BE50C3, 0xCF043AB3, 0x8AFB2CBB, 0xCC210D79, 0x8C4A142F, 0xC945DFEC,
+    0x8DAAD37B, 0xC67322CE, 0x8F1D343A, 0xC3A94590, 0x90A0FD4E, 0xC0E8B648,
+    0x9235F2EC, 0xBE31E19B, 0x93DBD6A0, 0xBB8532B0, 0x9592675C, 0xB8E31319,
+    0x9759617F, 0xB64BEACD, 0x99307EE0, 0xB3C0200C, 0x9B1776DA, 0xB140175B,
+    0x9D0DFE54, 0xAECC336C, 0x9F13C7D0, 0xAC64D510, 0xA1288376, 0xAA0A5B2E,
+    0xA34BDF20, 0xA7BD22AC, 0xA57D8666, 0xA57D8666, 0xA7BD22AC, 0xA34BDF20,
+    0xAA0A5B2E, 0xA1288376, 0xAC64D510, 0x9F13C7D0, 0xAECC336C, 0x9D0DFE54,
+    0xB140175B, 0x9B1776DA, 0xB3C0200C, 0x99307EE0, 0xB64BEACD, 0x9759617F,
+    0xB8E31319, 0x9592675C, 0xBB8532B0, 0x93DBD6A0, 0xBE31E19B, 0x9235F2EC,
+    0xC0E8B648, 0x90A0FD4E, 0xC3A94590, 0x8F1D343A, 0xC67322CE, 0x8DAAD37B,
+    0xC945DFEC, 0x8C4A142F, 0xCC210D79, 0x8AFB2CBB, 0xCF043AB3, 0x89BE50C3,
+    0xD1EEF59E, 0x8893B125, 0xD4E0CB15, 0x877B7BEC, 0xD7D946D8, 0x8675DC4F,
+    0xDAD7F3A2, 0x8582FAA5, 0xDDDC5B3B, 0x84A2FC62, 0xE0E60685, 0x83D60412,
+    0xE3F47D96, 0x831C314E, 0xE70747C4, 0x8275A0C0, 0xEA1DEBBB, 0x81E26C16,
+    0xED37EF91, 0x8162AA04, 0xF054D8D5, 0x80F66E3C, 0xF3742CA2, 0x809DC971,
+    0xF6956FB7, 0x8058C94C, 0xF9B82684, 0x80277872, 0xFCDBD541, 0x8009DE7E
+};
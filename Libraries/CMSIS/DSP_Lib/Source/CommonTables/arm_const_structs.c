@@ -0,0 +1,69 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_const_structs.c
+* @brief:     Constant instances of the fixed-point complex FFT
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+#include "arm_const_structs.h"
+
+/*
+ * Complex FFT instances of 16 to 256 points. All of them use the 256 points
+ * twiddle table, arm_cfft_q15() and arm_cfft_q31() compute the bit reversal
+ * without a table.
+ */
+
+const arm_cfft_instance_q15 arm_cfft_sR_q15_len16 =
+{
+    16, twiddleCoef_256_q15, NULL, 0
+};
+
+const arm_cfft_instance_q15 arm_cfft_sR_q15_len32 =
+{
+    32, twiddleCoef_256_q15, NULL, 0
+};
+
+const arm_cfft_instance_q15 arm_cfft_sR_q15_len64 =
+{
+    64, twiddleCoef_256_q15, NULL, 0
+};
+
+const arm_cfft_instance_q15 arm_cfft_sR_q15_len128 =
+{
+    128, twiddleCoef_256_q15, NULL, 0
+};
+
+const arm_cfft_instance_q15 arm_cfft_sR_q15_len256 =
+{
+    256, twiddleCoef_256_q15, NULL, 0
+};
+
+const arm_cfft_instance_q31 arm_cfft_sR_q31_len16 =
+{
+    16, twiddleCoef_256_q31, NULL, 0
+};
+
+const arm_cfft_instance_q31 arm_cfft_sR_q31_len32 =
+{
+    32, twiddleCoef_256_q31, NULL, 0
+};
+
+const arm_cfft_instance_q31 arm_cfft_sR_q31_len64 =
+{
+    64, twiddleCoef_256_q31, NULL, 0
+};
+
+const arm_cfft_instance_q31 arm_cfft_sR_q31_len128 =
+{
+    128, twiddleCoef_256_q31, NULL, 0
+};
+
+const arm_cfft_instance_q31 arm_cfft_sR_q31_len256 =
+{
+    256, twiddleCoef_256_q31, NULL, 0
+};
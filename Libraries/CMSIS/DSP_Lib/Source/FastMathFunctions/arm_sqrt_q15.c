@@ -0,0 +1,66 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_sqrt_q15.c
+* @brief:     Q15 square root
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+
+/**
+  * @brief  Q15 square root.
+  * @note   The result is sqrt(in x 2^15) rounded down: the integer square
+  *         root of a 30 bits value, computed by DVSQ with ARM_MATH_DVSQ, or
+  *         bit by bit.
+  * @param  in: input value, 0 to 0x7FFF.
+  * @param  pOut: receives the square root, 0 for a negative input.
+  * @retval ARM_MATH_SUCCESS, or ARM_MATH_ARGUMENT_ERROR for a negative input.
+  */
+arm_status arm_sqrt_q15(q15_t in, q15_t* pOut)
+{
+    uint32_t radicand;
+#if !defined(ARM_MATH_DVSQ)
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 28;
+#endif
+
+    if (in < 0)
+    {
+        *pOut = 0;
+        return ARM_MATH_ARGUMENT_ERROR;
+    }
+
+    radicand = (uint32_t)in << 15;
+
+#if defined(ARM_MATH_DVSQ)
+    *pOut = (q15_t)DVSQ_Sqrt(radicand);
+#else
+    while (bit > radicand)
+    {
+        bit >>= 2;
+    }
+
+    while (bit != 0u)
+    {
+        if (radicand >= (root + bit))
+        {
+            radicand -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+
+        bit >>= 2;
+    }
+
+    *pOut = (q15_t)root;
+#endif
+
+    return ARM_MATH_SUCCESS;
+}
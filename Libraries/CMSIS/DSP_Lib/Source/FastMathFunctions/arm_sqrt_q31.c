@@ -0,0 +1,71 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_sqrt_q31.c
+* @brief:     Q31 square root
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+
+/**
+  * @brief  Q31 square root.
+  * @note   The result is sqrt(in x 2^31) rounded down, that is the high
+  *         precision square root sqrt((2 x in) x 2^32) halved: one DVSQ
+  *         operation with ARM_MATH_DVSQ, or a bit by bit square root of the
+  *         62 bits radicand.
+  * @param  in: input value, 0 to 0x7FFFFFFF.
+  * @param  pOut: receives the square root, 0 for a negative input.
+  * @retval ARM_MATH_SUCCESS, or ARM_MATH_ARGUMENT_ERROR for a negative input.
+  */
+arm_status arm_sqrt_q31(q31_t in, q31_t* pOut)
+{
+#if defined(ARM_MATH_DVSQ)
+    uint16_t fraction;
+    uint32_t root;
+#else
+    uint64_t radicand;
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 60;
+#endif
+
+    if (in < 0)
+    {
+        *pOut = 0;
+        return ARM_MATH_ARGUMENT_ERROR;
+    }
+
+#if defined(ARM_MATH_DVSQ)
+    root = (uint32_t)DVSQ_SqrtH((uint32_t)in << 1, &fraction) << 16;
+    *pOut = (q31_t)((root | fraction) >> 1);
+#else
+    radicand = (uint64_t)(uint32_t)in << 31;
+
+    while (bit > radicand)
+    {
+        bit >>= 2;
+    }
+
+    while (bit != 0u)
+    {
+        if (radicand >= (root + bit))
+        {
+            radicand -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+
+        bit >>= 2;
+    }
+
+    *pOut = (q31_t)root;
+#endif
+
+    return ARM_MATH_SUCCESS;
+}
@@ -0,0 +1,38 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_biquad_cascade_df1_init_q15.c
+* @brief:     Q15 biquad cascade filter initialization
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+
+/**
+  * @brief  Initializes a Q15 biquad cascade filter, direct form I.
+  * @note   Each stage has 6 coefficients, the second one being 0:
+  *         {b10, 0, b11, b12, a11, a12, b20, 0, b21, b22, a21, a22, ...}.
+  *         The feedback coefficients are those of
+  *         y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] + a1 y[n-1] + a2 y[n-2],
+  *         the opposite of the MATLAB convention. Coefficients above 1 in
+  *         magnitude are scaled down by 2^postShift.
+  * @param  S: points to the instance of the filter.
+  * @param  numStages: number of second order stages.
+  * @param  pCoeffs: points to the 6 * numStages coefficients.
+  * @param  pState: points to the 4 * numStages state values.
+  * @param  postShift: shift applied to the accumulator, 0 to 15.
+  * @retval None
+  */
+void arm_biquad_cascade_df1_init_q15(arm_biquad_casd_df1_inst_q15* S, uint8_t numStages, q15_t* pCoeffs, q15_t* pState, int8_t postShift)
+{
+    S->numStages = (int8_t)numStages;
+    S->postShift = postShift;
+    S->pCoeffs = pCoeffs;
+    S->pState = pState;
+
+    /* x[n-1], x[n-2], y[n-1], y[n-2] of each stage */
+    memset(pState, 0, (4u * (uint32_t)numStages) * sizeof(q15_t));
+}
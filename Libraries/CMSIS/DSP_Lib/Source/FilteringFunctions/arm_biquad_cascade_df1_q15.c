@@ -0,0 +1,82 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_biquad_cascade_df1_q15.c
+* @brief:     Q15 biquad cascade filter
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+
+/**
+  * @brief  Processes a block of samples with a Q15 biquad cascade filter.
+  * @note   The five 1.15 x 1.15 products of a stage are summed in a 64 bits
+  *         accumulator, shifted by 15 - postShift and saturated to 1.15.
+  *         On the Cortex-M0 each product is one MULS and the state of a
+  *         stage stays in registers for the whole block.
+  * @param  S: points to the instance of the filter.
+  * @param  pSrc: points to the blockSize input samples.
+  * @param  pDst: points to the blockSize output samples, can be pSrc.
+  * @param  blockSize: number of samples to process.
+  * @retval None
+  */
+void arm_biquad_cascade_df1_q15(const arm_biquad_casd_df1_inst_q15* S, q15_t* pSrc, q15_t* pDst, uint32_t blockSize)
+{
+    q15_t* pIn = pSrc;
+    q15_t* pOut;
+    q15_t* pState = S->pState;
+    q15_t* pCoeffs = S->pCoeffs;
+    q31_t b0, b1, b2, a1, a2;
+    q31_t Xn, Xn1, Xn2, Yn1, Yn2;
+    q63_t acc;
+    uint32_t shift = 15u - (uint32_t)S->postShift;
+    uint32_t stage = (uint32_t)S->numStages;
+    uint32_t sample;
+
+    do
+    {
+        b0 = pCoeffs[0];
+        b1 = pCoeffs[2];
+        b2 = pCoeffs[3];
+        a1 = pCoeffs[4];
+        a2 = pCoeffs[5];
+        pCoeffs += 6;
+
+        Xn1 = pState[0];
+        Xn2 = pState[1];
+        Yn1 = pState[2];
+        Yn2 = pState[3];
+
+        pOut = pDst;
+
+        for (sample = blockSize; sample > 0u; sample--)
+        {
+            Xn = *pIn++;
+
+            acc = (q31_t)(b0 * Xn);
+            acc += (q31_t)(b1 * Xn1);
+            acc += (q31_t)(b2 * Xn2);
+            acc += (q31_t)(a1 * Yn1);
+            acc += (q31_t)(a2 * Yn2);
+
+            Xn2 = Xn1;
+            Xn1 = Xn;
+            Yn2 = Yn1;
+            Yn1 = clip_q31_to_q15((q31_t)(acc >> shift));
+
+            *pOut++ = (q15_t)Yn1;
+        }
+
+        *pState++ = (q15_t)Xn1;
+        *pState++ = (q15_t)Xn2;
+        *pState++ = (q15_t)Yn1;
+        *pState++ = (q15_t)Yn2;
+
+        /* The next stage filters the output of this one */
+        pIn = pDst;
+    }
+    while (--stage > 0u);
+}
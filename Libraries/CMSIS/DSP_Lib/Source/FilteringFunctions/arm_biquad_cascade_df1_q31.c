@@ -0,0 +1,81 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_biquad_cascade_df1_q31.c
+* @brief:     Q31 biquad cascade filter
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+
+/**
+  * @brief  Processes a block of samples with a Q31 biquad cascade filter.
+  * @note   The five 1.31 x 1.31 products of a stage are 2.62 values summed
+  *         in a 64 bits accumulator without saturation and shifted by
+  *         31 - postShift. The products are built by arm_mult_q31_q63().
+  * @param  S: points to the instance of the filter.
+  * @param  pSrc: points to the blockSize input samples.
+  * @param  pDst: points to the blockSize output samples, can be pSrc.
+  * @param  blockSize: number of samples to process.
+  * @retval None
+  */
+void arm_biquad_cascade_df1_q31(const arm_biquad_casd_df1_inst_q31* S, q31_t* pSrc, q31_t* pDst, uint32_t blockSize)
+{
+    q31_t* pIn = pSrc;
+    q31_t* pOut;
+    q31_t* pState = S->pState;
+    q31_t* pCoeffs = S->pCoeffs;
+    q31_t b0, b1, b2, a1, a2;
+    q31_t Xn, Xn1, Xn2, Yn1, Yn2;
+    q63_t acc;
+    uint32_t shift = 31u - (uint32_t)S->postShift;
+    uint32_t stage = S->numStages;
+    uint32_t sample;
+
+    do
+    {
+        b0 = pCoeffs[0];
+        b1 = pCoeffs[1];
+        b2 = pCoeffs[2];
+        a1 = pCoeffs[3];
+        a2 = pCoeffs[4];
+        pCoeffs += 5;
+
+        Xn1 = pState[0];
+        Xn2 = pState[1];
+        Yn1 = pState[2];
+        Yn2 = pState[3];
+
+        pOut = pDst;
+
+        for (sample = blockSize; sample > 0u; sample--)
+        {
+            Xn = *pIn++;
+
+            acc = arm_mult_q31_q63(b0, Xn);
+            acc += arm_mult_q31_q63(b1, Xn1);
+            acc += arm_mult_q31_q63(b2, Xn2);
+            acc += arm_mult_q31_q63(a1, Yn1);
+            acc += arm_mult_q31_q63(a2, Yn2);
+
+            Xn2 = Xn1;
+            Xn1 = Xn;
+            Yn2 = Yn1;
+            Yn1 = (q31_t)(acc >> shift);
+
+            *pOut++ = Yn1;
+        }
+
+        *pState++ = Xn1;
+        *pState++ = Xn2;
+        *pState++ = Yn1;
+        *pState++ = Yn2;
+
+        /* The next stage filters the output of this one */
+        pIn = pDst;
+    }
+    while (--stage > 0u);
+}
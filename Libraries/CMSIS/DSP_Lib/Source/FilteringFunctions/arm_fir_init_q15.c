@@ -0,0 +1,41 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_fir_init_q15.c
+* @brief:     Q15 FIR filter initialization
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+
+/**
+  * @brief  Initializes a Q15 FIR filter.
+  * @note   The coefficients are stored in time reversed order:
+  *         {b[numTaps-1], b[numTaps-2], ..., b[0]}.
+  *         The Cortex-M0 processing function accepts any number of taps.
+  * @param  S: points to the instance of the filter.
+  * @param  numTaps: number of filter coefficients, 1 or more.
+  * @param  pCoeffs: points to the numTaps coefficients.
+  * @param  pState: points to the state buffer of numTaps + blockSize - 1 samples.
+  * @param  blockSize: largest number of samples processed per call.
+  * @retval ARM_MATH_SUCCESS, or ARM_MATH_ARGUMENT_ERROR if numTaps is 0.
+  */
+arm_status arm_fir_init_q15(arm_fir_instance_q15* S, uint16_t numTaps, q15_t* pCoeffs, q15_t* pState, uint32_t blockSize)
+{
+    if (numTaps == 0u)
+    {
+        return ARM_MATH_ARGUMENT_ERROR;
+    }
+
+    S->numTaps = numTaps;
+    S->pCoeffs = pCoeffs;
+    S->pState = pState;
+
+    /* Clear the state: numTaps - 1 past samples and blockSize new ones */
+    memset(pState, 0, (numTaps + (blockSize - 1u)) * sizeof(q15_t));
+
+    return ARM_MATH_SUCCESS;
+}
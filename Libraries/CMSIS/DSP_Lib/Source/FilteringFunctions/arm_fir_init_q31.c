@@ -0,0 +1,33 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_fir_init_q31.c
+* @brief:     Q31 FIR filter initialization
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+
+/**
+  * @brief  Initializes a Q31 FIR filter.
+  * @note   The coefficients are stored in time reversed order:
+  *         {b[numTaps-1], b[numTaps-2], ..., b[0]}.
+  * @param  S: points to the instance of the filter.
+  * @param  numTaps: number of filter coefficients.
+  * @param  pCoeffs: points to the numTaps coefficients.
+  * @param  pState: points to the state buffer of numTaps + blockSize - 1 samples.
+  * @param  blockSize: largest number of samples processed per call.
+  * @retval None
+  */
+void arm_fir_init_q31(arm_fir_instance_q31* S, uint16_t numTaps, q31_t* pCoeffs, q31_t* pState, uint32_t blockSize)
+{
+    S->numTaps = numTaps;
+    S->pCoeffs = pCoeffs;
+    S->pState = pState;
+
+    /* Clear the state: numTaps - 1 past samples and blockSize new ones */
+    memset(pState, 0, (numTaps + (blockSize - 1u)) * sizeof(q31_t));
+}
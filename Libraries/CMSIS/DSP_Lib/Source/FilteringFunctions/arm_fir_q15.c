@@ -0,0 +1,76 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_fir_q15.c
+* @brief:     Q15 FIR filter
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+
+/**
+  * @brief  Processes a block of samples with a Q15 FIR filter.
+  * @note   The 1.15 x 1.15 products are 2.30 values summed in a 64 bits
+  *         accumulator, so the sum cannot overflow. The result is shifted to
+  *         1.15 and saturated.
+  *         On the Cortex-M0 each product is one MULS, the accumulation is a
+  *         64 bits addition, four taps are handled per loop.
+  * @param  S: points to the instance of the filter.
+  * @param  pSrc: points to the blockSize input samples.
+  * @param  pDst: points to the blockSize output samples.
+  * @param  blockSize: number of samples to process.
+  * @retval None
+  */
+void arm_fir_q15(const arm_fir_instance_q15* S, q15_t* pSrc, q15_t* pDst, uint32_t blockSize)
+{
+    q15_t* pState = S->pState;
+    q15_t* pCoeffs = S->pCoeffs;
+    q15_t* pStateCurnt = &S->pState[S->numTaps - 1u];
+    q15_t* px;
+    q15_t* pb;
+    q63_t acc;
+    uint32_t numTaps = S->numTaps;
+    uint32_t tapCnt;
+    uint32_t blkCnt;
+
+    for (blkCnt = blockSize; blkCnt > 0u; blkCnt--)
+    {
+        /* New sample after the numTaps - 1 previous ones */
+        *pStateCurnt++ = *pSrc++;
+
+        acc = 0;
+        px = pState;
+        pb = pCoeffs;
+
+        for (tapCnt = numTaps >> 2u; tapCnt > 0u; tapCnt--)
+        {
+            acc += (q31_t)px[0] * pb[0];
+            acc += (q31_t)px[1] * pb[1];
+            acc += (q31_t)px[2] * pb[2];
+            acc += (q31_t)px[3] * pb[3];
+            px += 4;
+            pb += 4;
+        }
+
+        for (tapCnt = numTaps & 3u; tapCnt > 0u; tapCnt--)
+        {
+            acc += (q31_t)*px++ * *pb++;
+        }
+
+        /* 34.30 to 1.15, numTaps < 65536 keeps acc >> 15 in 32 bits */
+        *pDst++ = clip_q31_to_q15((q31_t)(acc >> 15));
+
+        pState++;
+    }
+
+    /* Keep the last numTaps - 1 samples at the start of the state */
+    pStateCurnt = S->pState;
+
+    for (tapCnt = numTaps - 1u; tapCnt > 0u; tapCnt--)
+    {
+        *pStateCurnt++ = *pState++;
+    }
+}
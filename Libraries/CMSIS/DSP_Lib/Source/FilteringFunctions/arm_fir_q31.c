@@ -0,0 +1,66 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_fir_q31.c
+* @brief:     Q31 FIR filter
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+
+/**
+  * @brief  Processes a block of samples with a Q31 FIR filter.
+  * @note   The 1.31 x 1.31 products are 2.62 values summed in a 64 bits
+  *         accumulator without saturation: the input must be scaled down by
+  *         log2(numTaps) bits when the sum of the absolute coefficients is
+  *         above 1. The result is the accumulator shifted to 1.31.
+  *         The products are built by arm_mult_q31_q63() from 16 x 16 MULS.
+  * @param  S: points to the instance of the filter.
+  * @param  pSrc: points to the blockSize input samples.
+  * @param  pDst: points to the blockSize output samples.
+  * @param  blockSize: number of samples to process.
+  * @retval None
+  */
+void arm_fir_q31(const arm_fir_instance_q31* S, q31_t* pSrc, q31_t* pDst, uint32_t blockSize)
+{
+    q31_t* pState = S->pState;
+    q31_t* pCoeffs = S->pCoeffs;
+    q31_t* pStateCurnt = &S->pState[S->numTaps - 1u];
+    q31_t* px;
+    q31_t* pb;
+    q63_t acc;
+    uint32_t numTaps = S->numTaps;
+    uint32_t tapCnt;
+    uint32_t blkCnt;
+
+    for (blkCnt = blockSize; blkCnt > 0u; blkCnt--)
+    {
+        /* New sample after the numTaps - 1 previous ones */
+        *pStateCurnt++ = *pSrc++;
+
+        acc = 0;
+        px = pState;
+        pb = pCoeffs;
+
+        for (tapCnt = numTaps; tapCnt > 0u; tapCnt--)
+        {
+            acc += arm_mult_q31_q63(*px++, *pb++);
+        }
+
+        /* 2.62 to 1.31 */
+        *pDst++ = (q31_t)(acc >> 31);
+
+        pState++;
+    }
+
+    /* Keep the last numTaps - 1 samples at the start of the state */
+    pStateCurnt = S->pState;
+
+    for (tapCnt = numTaps - 1u; tapCnt > 0u; tapCnt--)
+    {
+        *pStateCurnt++ = *pState++;
+    }
+}
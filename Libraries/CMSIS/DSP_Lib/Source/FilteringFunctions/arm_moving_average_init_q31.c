@@ -0,0 +1,63 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_moving_average_init_q31.c
+* @brief:     Q31 moving average initialization
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+
+/**
+  * @brief  Initializes a Q31 moving average.
+  * @note   The state starts at zero: the first windowLen - 1 outputs
+  *         average the first samples with zeros.
+  * @param  S: points to the instance of the moving average.
+  * @param  windowLen: number of samples averaged, 1 or more.
+  * @param  pState: points to a buffer of windowLen samples.
+  * @retval ARM_MATH_SUCCESS, or ARM_MATH_ARGUMENT_ERROR if windowLen is 0.
+  */
+arm_status arm_moving_average_init_q31(arm_moving_average_instance_q31* S, uint16_t windowLen, q31_t* pState)
+{
+    uint32_t quot;
+    uint32_t rem;
+    uint8_t shift = 0;
+
+    if (windowLen == 0u)
+    {
+        return ARM_MATH_ARGUMENT_ERROR;
+    }
+
+    S->windowLen = windowLen;
+    S->index = 0;
+    S->pState = pState;
+    S->sum = 0;
+
+    memset(pState, 0, windowLen * sizeof(q31_t));
+
+    while ((2u << shift) <= windowLen)
+    {
+        shift++;
+    }
+
+    if ((windowLen & (windowLen - 1u)) == 0u)
+    {
+        /* Power of 2: the division is a shift */
+        S->recip = 0;
+    }
+    else
+    {
+        /* Otherwise a multiply by 2^(31 + shift) / windowLen, below 2^31,
+           from two 32 bits divisions */
+        quot = arm_div_u32(0x80000000u, windowLen);
+        rem = 0x80000000u - (quot * windowLen);
+        S->recip = (q31_t)((quot << shift) + arm_div_u32(rem << shift, windowLen));
+    }
+
+    S->shift = shift;
+
+    return ARM_MATH_SUCCESS;
+}
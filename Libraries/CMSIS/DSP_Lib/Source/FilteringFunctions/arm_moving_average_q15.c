@@ -0,0 +1,61 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_moving_average_q15.c
+* @brief:     Q15 moving average
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+
+/**
+  * @brief  Processes a block of samples with a Q15 moving average.
+  * @note   The sum of the window is updated with the new sample minus the
+  *         oldest one: the cost per sample does not depend on windowLen.
+  *         The mean is rounded down, with a shift when windowLen is a power
+  *         of 2, else with a multiply by the reciprocal of windowLen.
+  * @param  S: points to the instance of the moving average.
+  * @param  pSrc: points to the blockSize input samples.
+  * @param  pDst: points to the blockSize output samples, can be pSrc.
+  * @param  blockSize: number of samples to process.
+  * @retval None
+  */
+void arm_moving_average_q15(arm_moving_average_instance_q15* S, q15_t* pSrc, q15_t* pDst, uint32_t blockSize)
+{
+    q15_t* pState = S->pState;
+    q31_t sum = S->sum;
+    q31_t recip = S->recip;
+    q31_t in;
+    uint32_t index = S->index;
+    uint32_t windowLen = S->windowLen;
+    uint32_t shift = S->shift;
+    uint32_t blkCnt;
+
+    for (blkCnt = blockSize; blkCnt > 0u; blkCnt--)
+    {
+        in = *pSrc++;
+
+        sum += in - pState[index];
+        pState[index] = (q15_t)in;
+
+        if (++index == windowLen)
+        {
+            index = 0;
+        }
+
+        if (recip == 0)
+        {
+            *pDst++ = (q15_t)(sum >> shift);
+        }
+        else
+        {
+            *pDst++ = (q15_t)(arm_mult_q31_q63(sum, recip) >> (31u + shift));
+        }
+    }
+
+    S->sum = sum;
+    S->index = (uint16_t)index;
+}
@@ -0,0 +1,67 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_moving_average_q31.c
+* @brief:     Q31 moving average
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+
+/**
+  * @brief  Processes a block of samples with a Q31 moving average.
+  * @note   The sum of the window is updated with the new sample minus the
+  *         oldest one: the cost per sample does not depend on windowLen.
+  *         The mean is rounded down, with a shift when windowLen is a power
+  *         of 2, else with a multiply by the reciprocal of windowLen split
+  *         in two 32 bits products, the sum using up to 47 bits. The error of
+  *         the reciprocal keeps the result within 2 LSB of the mean.
+  * @param  S: points to the instance of the moving average.
+  * @param  pSrc: points to the blockSize input samples.
+  * @param  pDst: points to the blockSize output samples, can be pSrc.
+  * @param  blockSize: number of samples to process.
+  * @retval None
+  */
+void arm_moving_average_q31(arm_moving_average_instance_q31* S, q31_t* pSrc, q31_t* pDst, uint32_t blockSize)
+{
+    q31_t* pState = S->pState;
+    q63_t sum = S->sum;
+    q63_t product;
+    q31_t recip = S->recip;
+    q31_t in;
+    uint32_t index = S->index;
+    uint32_t windowLen = S->windowLen;
+    uint32_t shift = S->shift;
+    uint32_t blkCnt;
+
+    for (blkCnt = blockSize; blkCnt > 0u; blkCnt--)
+    {
+        in = *pSrc++;
+
+        sum += (q63_t)in - pState[index];
+        pState[index] = in;
+
+        if (++index == windowLen)
+        {
+            index = 0;
+        }
+
+        if (recip == 0)
+        {
+            *pDst++ = (q31_t)(sum >> shift);
+        }
+        else
+        {
+            /* (high x 2^16 + low) x recip >> (31 + shift), high and low in 32 bits */
+            product = arm_mult_q31_q63((q31_t)(sum >> 16), recip) +
+                      (arm_mult_q31_q63((q31_t)(sum & 0xFFFF), recip) >> 16);
+            *pDst++ = (q31_t)(product >> (15u + shift));
+        }
+    }
+
+    S->sum = sum;
+    S->index = (uint16_t)index;
+}
@@ -0,0 +1,42 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_max_q31.c
+* @brief:     Maximum value of a Q31 vector
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+
+/**
+  * @brief  Maximum value of a Q31 vector.
+  * @param  pSrc: points to the input vector.
+  * @param  blockSize: number of samples, 1 or more.
+  * @param  pResult: receives the maximum value.
+  * @param  pIndex: receives the index of its first occurrence.
+  * @retval None
+  */
+void arm_max_q31(q31_t* pSrc, uint32_t blockSize, q31_t* pResult, uint32_t* pIndex)
+{
+    q31_t out = pSrc[0];
+    q31_t in;
+    uint32_t outIndex = 0;
+    uint32_t i;
+
+    for (i = 1u; i < blockSize; i++)
+    {
+        in = pSrc[i];
+
+        if (in > out)
+        {
+            out = in;
+            outIndex = i;
+        }
+    }
+
+    *pResult = out;
+    *pIndex = outIndex;
+}
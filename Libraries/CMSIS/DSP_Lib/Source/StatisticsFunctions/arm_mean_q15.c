@@ -0,0 +1,44 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_mean_q15.c
+* @brief:     Mean value of a Q15 vector
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+
+/**
+  * @brief  Mean value of a Q15 vector.
+  * @note   The samples are summed in 32 bits, which holds 65536 full scale
+  *         samples, the mean is rounded toward zero. The division is done
+  *         by DVSQ with ARM_MATH_DVSQ.
+  * @param  pSrc: points to the input vector.
+  * @param  blockSize: number of samples, 1 to 65536.
+  * @param  pResult: receives the mean value.
+  * @retval None
+  */
+void arm_mean_q15(q15_t* pSrc, uint32_t blockSize, q15_t* pResult)
+{
+    q31_t sum = 0;
+    uint32_t blkCnt;
+
+    for (blkCnt = blockSize >> 2u; blkCnt > 0u; blkCnt--)
+    {
+        sum += pSrc[0];
+        sum += pSrc[1];
+        sum += pSrc[2];
+        sum += pSrc[3];
+        pSrc += 4;
+    }
+
+    for (blkCnt = blockSize & 3u; blkCnt > 0u; blkCnt--)
+    {
+        sum += *pSrc++;
+    }
+
+    *pResult = (q15_t)arm_div_s32(sum, (int32_t)blockSize);
+}
@@ -0,0 +1,42 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_mean_q31.c
+* @brief:     Mean value of a Q31 vector
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+
+/**
+  * @brief  Mean value of a Q31 vector.
+  * @note   The samples are summed in 64 bits, the mean is rounded toward
+  *         zero. A sum that fits in 32 bits is divided by DVSQ with
+  *         ARM_MATH_DVSQ, or by the 32 bits division.
+  * @param  pSrc: points to the input vector.
+  * @param  blockSize: number of samples, 1 or more.
+  * @param  pResult: receives the mean value.
+  * @retval None
+  */
+void arm_mean_q31(q31_t* pSrc, uint32_t blockSize, q31_t* pResult)
+{
+    q63_t sum = 0;
+    uint32_t blkCnt;
+
+    for (blkCnt = blockSize; blkCnt > 0u; blkCnt--)
+    {
+        sum += *pSrc++;
+    }
+
+    if ((sum == (q31_t)sum) && (blockSize <= 0x7FFFFFFFu))
+    {
+        *pResult = arm_div_s32((q31_t)sum, (int32_t)blockSize);
+    }
+    else
+    {
+        *pResult = (q31_t)(sum / (q63_t)blockSize);
+    }
+}
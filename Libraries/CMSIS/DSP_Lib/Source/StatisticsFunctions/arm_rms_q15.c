@@ -0,0 +1,51 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_rms_q15.c
+* @brief:     Root mean square of a Q15 vector
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+
+/**
+  * @brief  Root mean square of a Q15 vector.
+  * @note   The 2.30 squares are summed in 64 bits, the mean square is
+  *         rounded down to 1.15 and saturated before arm_sqrt_q15().
+  *         Up to 131071 samples the division is a 32 bits one, done by DVSQ
+  *         with ARM_MATH_DVSQ.
+  * @param  pSrc: points to the input vector.
+  * @param  blockSize: number of samples, 1 or more.
+  * @param  pResult: receives the root mean square value.
+  * @retval None
+  */
+void arm_rms_q15(q15_t* pSrc, uint32_t blockSize, q15_t* pResult)
+{
+    uint64_t sum = 0;
+    uint32_t meanSquare;
+    q31_t in;
+    uint32_t blkCnt;
+
+    for (blkCnt = blockSize; blkCnt > 0u; blkCnt--)
+    {
+        in = *pSrc++;
+        sum += (uint32_t)(in * in);
+    }
+
+    /* (sum / blockSize) >> 15 == (sum >> 15) / blockSize */
+    sum >>= 15;
+
+    if ((sum >> 32) == 0u)
+    {
+        meanSquare = arm_div_u32((uint32_t)sum, blockSize);
+    }
+    else
+    {
+        meanSquare = (uint32_t)(sum / blockSize);
+    }
+
+    arm_sqrt_q15((q15_t)((meanSquare > 0x7FFFu) ? 0x7FFFu : meanSquare), pResult);
+}
@@ -0,0 +1,48 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_rms_q31.c
+* @brief:     Root mean square of a Q31 vector
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+
+/**
+  * @brief  Root mean square of a Q31 vector.
+  * @note   Each square is rounded down to 1.31 and summed in 64 bits, which
+  *         cannot overflow, then the mean square is saturated to 1.31
+  *         before arm_sqrt_q31(). A sum that fits in 32 bits is divided by
+  *         DVSQ with ARM_MATH_DVSQ, or by the 32 bits division.
+  * @param  pSrc: points to the input vector.
+  * @param  blockSize: number of samples, 1 or more.
+  * @param  pResult: receives the root mean square value.
+  * @retval None
+  */
+void arm_rms_q31(q31_t* pSrc, uint32_t blockSize, q31_t* pResult)
+{
+    uint64_t sum = 0;
+    uint64_t meanSquare;
+    q31_t in;
+    uint32_t blkCnt;
+
+    for (blkCnt = blockSize; blkCnt > 0u; blkCnt--)
+    {
+        in = *pSrc++;
+        sum += (uint64_t)(arm_mult_q31_q63(in, in) >> 31);
+    }
+
+    if ((sum >> 32) == 0u)
+    {
+        meanSquare = arm_div_u32((uint32_t)sum, blockSize);
+    }
+    else
+    {
+        meanSquare = sum / blockSize;
+    }
+
+    arm_sqrt_q31((q31_t)((meanSquare > 0x7FFFFFFFu) ? 0x7FFFFFFFu : meanSquare), pResult);
+}
@@ -0,0 +1,270 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_cfft_q15.c
+* @brief:     Q15 complex FFT, radix-4 with a radix-2 first stage
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Radix-2 decimation in frequency stage over the whole buffer,
+  *         scaled by 1/2.
+  * @param  pSrc: points to fftLen complex values.
+  * @param  fftLen: length of the transform, 32 or 128.
+  * @param  pTwiddle: points to the 256 points twiddle table.
+  * @param  ifftFlag: 1 for the inverse transform.
+  * @retval None
+  */
+static void arm_cfft_radix2_stage_q15(q15_t* pSrc, uint32_t fftLen, const q15_t* pTwiddle, uint8_t ifftFlag)
+{
+    uint32_t half = fftLen >> 1;
+    uint32_t step = 2u * (256u / fftLen);
+    uint32_t j;
+    q31_t c, s;
+    q31_t ar, ai, br, bi, yr, yi;
+    q15_t* pA = pSrc;
+    q15_t* pB = &pSrc[2u * half];
+
+    for (j = 0; j < half; j++)
+    {
+        c = pTwiddle[j * step];
+        s = pTwiddle[(j * step) + 1u];
+
+        if (ifftFlag != 0u)
+        {
+            s = -s;
+        }
+
+        ar = pA[0];
+        ai = pA[1];
+        br = pB[0];
+        bi = pB[1];
+
+        pA[0] = (q15_t)((ar + br) >> 1);
+        pA[1] = (q15_t)((ai + bi) >> 1);
+
+        yr = (ar - br) >> 1;
+        yi = (ai - bi) >> 1;
+
+        /* (yr + j yi) x (c - j s) */
+        pB[0] = (q15_t)(((yr * c) + (yi * s)) >> 15);
+        pB[1] = (q15_t)(((yi * c) - (yr * s)) >> 15);
+
+        pA += 2;
+        pB += 2;
+    }
+}
+
+/**
+  * @brief  Radix-4 decimation in frequency stages, each scaled by 1/4. The
+  *         outputs of a butterfly are stored in bit reversed order, so that
+  *         the transform ends in bit reversed order.
+  * @param  pSrc: points to fftLen complex values.
+  * @param  fftLen: length of the buffer.
+  * @param  subLen: length of the sub-transforms, a power of 4.
+  * @param  pTwiddle: points to the 256 points twiddle table.
+  * @param  ifftFlag: 1 for the inverse transform.
+  * @retval None
+  */
+static void arm_cfft_radix4_stages_q15(q15_t* pSrc, uint32_t fftLen, uint32_t subLen, const q15_t* pTwiddle, uint8_t ifftFlag)
+{
+    uint32_t L;
+    uint32_t quarter;
+    uint32_t step;
+    uint32_t j;
+    uint32_t g;
+    q31_t c1, s1, c2, s2, c3, s3;
+    q31_t ar, ai, br, bi, cr, ci, dr, di;
+    q31_t t0r, t0i, t1r, t1i, t2r, t2i, t3r, t3i;
+    q31_t yr, yi;
+    q15_t* p0;
+    q15_t* p1;
+    q15_t* p2;
+    q15_t* p3;
+
+    for (L = subLen; L >= 4u; L >>= 2)
+    {
+        quarter = L >> 2;
+        step = 2u * (256u / L);
+
+        for (j = 0; j < quarter; j++)
+        {
+            c1 = pTwiddle[j * step];
+            s1 = pTwiddle[(j * step) + 1u];
+            c2 = pTwiddle[2u * j * step];
+            s2 = pTwiddle[(2u * j * step) + 1u];
+            c3 = pTwiddle[3u * j * step];
+            s3 = pTwiddle[(3u * j * step) + 1u];
+
+            if (ifftFlag != 0u)
+            {
+                s1 = -s1;
+                s2 = -s2;
+                s3 = -s3;
+            }
+
+            for (g = j; g < fftLen; g += L)
+            {
+                p0 = &pSrc[2u * g];
+                p1 = p0 + (2u * quarter);
+                p2 = p1 + (2u * quarter);
+                p3 = p2 + (2u * quarter);
+
+                ar = p0[0];
+                ai = p0[1];
+                cr = p2[0];
+                ci = p2[1];
+
+                /* The inverse butterfly is the forward one with b and d swapped */
+                if (ifftFlag == 0u)
+                {
+                    br = p1[0];
+                    bi = p1[1];
+                    dr = p3[0];
+                    di = p3[1];
+                }
+                else
+                {
+                    br = p3[0];
+                    bi = p3[1];
+                    dr = p1[0];
+                    di = p1[1];
+                }
+
+                t0r = ar + cr;
+                t0i = ai + ci;
+                t1r = ar - cr;
+                t1i = ai - ci;
+                t2r = br + dr;
+                t2i = bi + di;
+                t3r = br - dr;
+                t3i = bi - di;
+
+                /* y0 = a + b + c + d */
+                p0[0] = (q15_t)((t0r + t2r) >> 2);
+                p0[1] = (q15_t)((t0i + t2i) >> 2);
+
+                if (j == 0u)
+                {
+                    /* W^0: no rotation */
+                    p1[0] = (q15_t)((t0r - t2r) >> 2);
+                    p1[1] = (q15_t)((t0i - t2i) >> 2);
+                    p2[0] = (q15_t)((t1r + t3i) >> 2);
+                    p2[1] = (q15_t)((t1i - t3r) >> 2);
+                    p3[0] = (q15_t)((t1r - t3i) >> 2);
+                    p3[1] = (q15_t)((t1i + t3r) >> 2);
+                }
+                else
+                {
+                    /* y2 = (a - b + c - d) W^2j, stored second */
+                    yr = (t0r - t2r) >> 2;
+                    yi = (t0i - t2i) >> 2;
+                    p1[0] = (q15_t)(((yr * c2) + (yi * s2)) >> 15);
+                    p1[1] = (q15_t)(((yi * c2) - (yr * s2)) >> 15);
+
+                    /* y1 = (a - jb - c + jd) W^j, stored third */
+                    yr = (t1r + t3i) >> 2;
+                    yi = (t1i - t3r) >> 2;
+                    p2[0] = (q15_t)(((yr * c1) + (yi * s1)) >> 15);
+                    p2[1] = (q15_t)(((yi * c1) - (yr * s1)) >> 15);
+
+                    /* y3 = (a + jb - c - jd) W^3j */
+                    yr = (t1r - t3i) >> 2;
+                    yi = (t1i + t3r) >> 2;
+                    p3[0] = (q15_t)(((yr * c3) + (yi * s3)) >> 15);
+                    p3[1] = (q15_t)(((yi * c3) - (yr * s3)) >> 15);
+                }
+            }
+        }
+    }
+}
+
+/**
+  * @brief  Reorders a bit reversed buffer of complex values, in place.
+  * @param  pSrc: points to fftLen complex values.
+  * @param  fftLen: length of the buffer, a power of 2.
+  * @retval None
+  */
+static void arm_cfft_bitreversal_q15(q15_t* pSrc, uint32_t fftLen)
+{
+    uint32_t i;
+    uint32_t j = 0;
+    uint32_t k;
+    q15_t tmp;
+
+    for (i = 0; i < (fftLen - 1u); i++)
+    {
+        if (i < j)
+        {
+            tmp = pSrc[2u * i];
+            pSrc[2u * i] = pSrc[2u * j];
+            pSrc[2u * j] = tmp;
+            tmp = pSrc[(2u * i) + 1u];
+            pSrc[(2u * i) + 1u] = pSrc[(2u * j) + 1u];
+            pSrc[(2u * j) + 1u] = tmp;
+        }
+
+        /* j = bit reverse of i + 1 */
+        k = fftLen >> 1;
+
+        while (k <= j)
+        {
+            j -= k;
+            k >>= 1;
+        }
+
+        j += k;
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Q15 complex FFT, in place.
+  * @note   The forward transform computes X[k] / fftLen, the inverse
+  *         transform (1 / fftLen) x sum of X[k] e^(+2 pi j k n / fftLen).
+  *         The scaling is 1/4 per radix-4 stage and 1/2 for the radix-2
+  *         first stage of the 32 and 128 points transforms, so that the
+  *         output format is (1 + log2(fftLen)).(15 - log2(fftLen)) relative
+  *         to the unscaled transform.
+  *         The complex samples must have a magnitude below 1.
+  * @param  S: points to an arm_cfft_sR_q15_lenN instance, N from 16 to 256.
+  * @param  p1: points to fftLen complex values {real, imag, real, imag, ...}.
+  * @param  ifftFlag: 0 for the forward transform, 1 for the inverse one.
+  * @param  bitReverseFlag: 1 for an output in natural order, 0 to leave it
+  *         in bit reversed order.
+  * @retval None
+  */
+void arm_cfft_q15(const arm_cfft_instance_q15* S, q15_t* p1, uint8_t ifftFlag, uint8_t bitReverseFlag)
+{
+    uint32_t fftLen = S->fftLen;
+
+    switch (fftLen)
+    {
+        case 16:
+        case 64:
+        case 256:
+            arm_cfft_radix4_stages_q15(p1, fftLen, fftLen, S->pTwiddle, ifftFlag);
+            break;
+
+        case 32:
+        case 128:
+            /* Two radix-4 transforms of half length */
+            arm_cfft_radix2_stage_q15(p1, fftLen, S->pTwiddle, ifftFlag);
+            arm_cfft_radix4_stages_q15(p1, fftLen, fftLen >> 1, S->pTwiddle, ifftFlag);
+            break;
+
+        default:
+            return;
+    }
+
+    if (bitReverseFlag != 0u)
+    {
+        arm_cfft_bitreversal_q15(p1, fftLen);
+    }
+}
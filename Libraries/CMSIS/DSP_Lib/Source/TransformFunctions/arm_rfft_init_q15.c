@@ -0,0 +1,63 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_rfft_init_q15.c
+* @brief:     Initialization of the Q15 real FFT
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+#include "arm_common_tables.h"
+#include "arm_const_structs.h"
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Initializes a Q15 real FFT instance.
+  * @param  S: points to the instance.
+  * @param  fftLenReal: number of real samples, 32, 64, 128 or 256.
+  * @param  ifftFlagR: 0 for the forward transform, 1 for the inverse one.
+  * @param  bitReverseFlag: 1 for an output in natural order. The real FFT
+  *         always reorders the complex FFT it is built on, this flag is only
+  *         recorded in the instance.
+  * @retval ARM_MATH_SUCCESS, or ARM_MATH_ARGUMENT_ERROR for an unsupported
+  *         length.
+  */
+arm_status arm_rfft_init_q15(arm_rfft_instance_q15* S, uint32_t fftLenReal, uint32_t ifftFlagR, uint32_t bitReverseFlag)
+{
+    /* A real transform of N points is a complex transform of N/2 points */
+    switch (fftLenReal)
+    {
+        case 32:
+            S->pCfft = &arm_cfft_sR_q15_len16;
+            break;
+
+        case 64:
+            S->pCfft = &arm_cfft_sR_q15_len32;
+            break;
+
+        case 128:
+            S->pCfft = &arm_cfft_sR_q15_len64;
+            break;
+
+        case 256:
+            S->pCfft = &arm_cfft_sR_q15_len128;
+            break;
+
+        default:
+            return ARM_MATH_ARGUMENT_ERROR;
+    }
+
+    S->fftLenReal = fftLenReal;
+    S->ifftFlagR = (uint8_t)ifftFlagR;
+    S->bitReverseFlagR = (uint8_t)bitReverseFlag;
+
+    /* W_N^k is entry k x 256 / N of the 256 points table */
+    S->twidCoefRModifier = 256u / fftLenReal;
+    S->pTwiddleAReal = (q15_t*)twiddleCoef_256_q15;
+    S->pTwiddleBReal = (q15_t*)twiddleCoef_256_q15;
+
+    return ARM_MATH_SUCCESS;
+}
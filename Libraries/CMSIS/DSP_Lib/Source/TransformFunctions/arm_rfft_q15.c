@@ -0,0 +1,147 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_rfft_q15.c
+* @brief:     Q15 real FFT built on the half length complex FFT
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Splits the complex FFT Z of the even and odd samples into the
+  *         spectrum X of the real sequence.
+  * @note   With G = Z[k], H = conj(Z[M - k]), E = G + H and O = G - H:
+  *         X[k] = (E - j W^k O) / 2. The full spectrum of fftLenReal complex
+  *         values is written, the upper half as the conjugate of the lower.
+  * @param  S: points to the instance.
+  * @param  pSrc: complex FFT of fftLenReal / 2 points, natural order.
+  * @param  pDst: fftLenReal complex values.
+  * @retval None
+  */
+static void arm_split_rfft_q15(const arm_rfft_instance_q15* S, const q15_t* pSrc, q15_t* pDst)
+{
+    uint32_t n = S->fftLenReal;
+    uint32_t m = n >> 1;
+    uint32_t step = 2u * S->twidCoefRModifier;
+    const q15_t* pTwiddle = S->pTwiddleAReal;
+    uint32_t k;
+    q31_t c, s;
+    q31_t gr, gi, hr, hi;
+    q31_t evr, evi, odr, odi;
+    q31_t xr, xi;
+
+    /* X[0] and X[M] are real */
+    gr = pSrc[0];
+    gi = pSrc[1];
+    pDst[0] = clip_q31_to_q15(gr + gi);
+    pDst[1] = 0;
+    pDst[n] = clip_q31_to_q15(gr - gi);
+    pDst[n + 1u] = 0;
+
+    for (k = 1; k < m; k++)
+    {
+        c = pTwiddle[k * step];
+        s = pTwiddle[(k * step) + 1u];
+
+        gr = pSrc[2u * k];
+        gi = pSrc[(2u * k) + 1u];
+        hr = pSrc[2u * (m - k)];
+        hi = -pSrc[(2u * (m - k)) + 1u];
+
+        /* Halved sums, the products stay on 32 bits */
+        evr = (gr + hr) >> 1;
+        evi = (gi + hi) >> 1;
+        odr = (gr - hr) >> 1;
+        odi = (gi - hi) >> 1;
+
+        /* -j W^k O = (oi c - or s) - j (or c + oi s) */
+        xr = evr + (((odi * c) - (odr * s)) >> 15);
+        xi = evi - (((odr * c) + (odi * s)) >> 15);
+
+        pDst[2u * k] = clip_q31_to_q15(xr);
+        pDst[(2u * k) + 1u] = clip_q31_to_q15(xi);
+        pDst[2u * (n - k)] = clip_q31_to_q15(xr);
+        pDst[(2u * (n - k)) + 1u] = clip_q31_to_q15(-xi);
+    }
+}
+
+/**
+  * @brief  Merges the spectrum X of a real sequence into the spectrum Z of
+  *         the complex sequence of its even and odd samples.
+  * @note   With A = X[k], B = conj(X[M - k]): Z[k] = (A + B) + j W^-k (A - B),
+  *         halved. Reads X[0] to X[M].
+  * @param  S: points to the instance.
+  * @param  pSrc: spectrum, fftLenReal / 2 + 1 complex values.
+  * @param  pDst: fftLenReal / 2 complex values.
+  * @retval None
+  */
+static void arm_split_rifft_q15(const arm_rfft_instance_q15* S, const q15_t* pSrc, q15_t* pDst)
+{
+    uint32_t m = S->fftLenReal >> 1;
+    uint32_t step = 2u * S->twidCoefRModifier;
+    const q15_t* pTwiddle = S->pTwiddleBReal;
+    uint32_t k;
+    q31_t c, s;
+    q31_t ar, ai, br, bi;
+    q31_t sr, si, dr, di;
+
+    for (k = 0; k < m; k++)
+    {
+        c = pTwiddle[k * step];
+        s = pTwiddle[(k * step) + 1u];
+
+        ar = pSrc[2u * k];
+        ai = pSrc[(2u * k) + 1u];
+        br = pSrc[2u * (m - k)];
+        bi = -pSrc[(2u * (m - k)) + 1u];
+
+        sr = (ar + br) >> 1;
+        si = (ai + bi) >> 1;
+        dr = (br - ar) >> 1;
+        di = (bi - ai) >> 1;
+
+        pDst[2u * k] = clip_q31_to_q15(sr + (((dr * s) + (di * c)) >> 15));
+        pDst[(2u * k) + 1u] = clip_q31_to_q15(si + (((di * s) - (dr * c)) >> 15));
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Q15 real FFT.
+  * @note   The forward transform reads fftLenReal real samples, overwrites
+  *         them, and writes fftLenReal complex values X[k] / fftLenReal to
+  *         pDst. The inverse transform reads the fftLenReal / 2 + 1 first
+  *         complex values of a spectrum and writes fftLenReal real samples
+  *         (1 / fftLenReal) x sum of X[k] e^(+2 pi j k n / fftLenReal) to
+  *         pDst, so a forward then inverse transform returns x / fftLenReal.
+  * @param  S: points to an instance initialized by arm_rfft_init_q15().
+  * @param  pSrc: points to the input, modified by the forward transform.
+  * @param  pDst: points to the output.
+  * @retval None
+  */
+void arm_rfft_q15(const arm_rfft_instance_q15* S, q15_t* pSrc, q15_t* pDst)
+{
+    uint32_t i;
+
+    if (S->ifftFlagR == 0u)
+    {
+        /* Half scale so that the split cannot overflow */
+        for (i = 0; i < S->fftLenReal; i++)
+        {
+            pSrc[i] = (q15_t)(pSrc[i] >> 1);
+        }
+
+        arm_cfft_q15(S->pCfft, pSrc, 0, 1);
+        arm_split_rfft_q15(S, pSrc, pDst);
+    }
+    else
+    {
+        arm_split_rifft_q15(S, pSrc, pDst);
+        arm_cfft_q15(S->pCfft, pDst, 1, 1);
+    }
+}
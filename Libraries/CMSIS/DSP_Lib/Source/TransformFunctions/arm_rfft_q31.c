@@ -0,0 +1,146 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  arm_rfft_q31.c
+* @brief:     Q31 real FFT built on the half length complex FFT
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "arm_math_ext.h"
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Splits the complex FFT Z of the even and odd samples into the
+  *         spectrum X of the real sequence.
+  * @note   With G = Z[k], H = conj(Z[M - k]), E = G + H and O = G - H:
+  *         X[k] = (E - j W^k O) / 2. The full spectrum of fftLenReal complex
+  *         values is written, the upper half as the conjugate of the lower.
+  * @param  S: points to the instance.
+  * @param  pSrc: complex FFT of fftLenReal / 2 points, natural order.
+  * @param  pDst: fftLenReal complex values.
+  * @retval None
+  */
+static void arm_split_rfft_q31(const arm_rfft_instance_q31* S, const q31_t* pSrc, q31_t* pDst)
+{
+    uint32_t n = S->fftLenReal;
+    uint32_t m = n >> 1;
+    uint32_t step = 2u * S->twidCoefRModifier;
+    const q31_t* pTwiddle = S->pTwiddleAReal;
+    uint32_t k;
+    q31_t c, s;
+    q31_t gr, gi, hr, hi;
+    q31_t evr, evi, odr, odi;
+    q31_t xr, xi;
+
+    /* X[0] and X[M] are real */
+    gr = pSrc[0];
+    gi = pSrc[1];
+    pDst[0] = clip_q63_to_q31((q63_t)gr + gi);
+    pDst[1] = 0;
+    pDst[n] = clip_q63_to_q31((q63_t)gr - gi);
+    pDst[n + 1u] = 0;
+
+    for (k = 1; k < m; k++)
+    {
+        c = pTwiddle[k * step];
+        s = pTwiddle[(k * step) + 1u];
+
+        gr = arm_shift_round_q31(pSrc[2u * k], 1);
+        gi = arm_shift_round_q31(pSrc[(2u * k) + 1u], 1);
+        hr = arm_shift_round_q31(pSrc[2u * (m - k)], 1);
+        hi = -arm_shift_round_q31(pSrc[(2u * (m - k)) + 1u], 1);
+
+        evr = gr + hr;
+        evi = gi + hi;
+        odr = gr - hr;
+        odi = gi - hi;
+
+        /* -j W^k O = (oi c - or s) - j (or c + oi s) */
+        xr = clip_q63_to_q31((q63_t)evr + ((arm_mult_q31_q63(odi, c) - arm_mult_q31_q63(odr, s) + 0x40000000) >> 31));
+        xi = clip_q63_to_q31((q63_t)evi - ((arm_mult_q31_q63(odr, c) + arm_mult_q31_q63(odi, s) + 0x40000000) >> 31));
+
+        pDst[2u * k] = xr;
+        pDst[(2u * k) + 1u] = xi;
+        pDst[2u * (n - k)] = xr;
+        pDst[(2u * (n - k)) + 1u] = clip_q63_to_q31(-(q63_t)xi);
+    }
+}
+
+/**
+  * @brief  Merges the spectrum X of a real sequence into the spectrum Z of
+  *         the complex sequence of its even and odd samples.
+  * @note   With A = X[k], B = conj(X[M - k]): Z[k] = (A + B) + j W^-k (A - B),
+  *         halved. Reads X[0] to X[M].
+  * @param  S: points to the instance.
+  * @param  pSrc: spectrum, fftLenReal / 2 + 1 complex values.
+  * @param  pDst: fftLenReal / 2 complex values.
+  * @retval None
+  */
+static void arm_split_rifft_q31(const arm_rfft_instance_q31* S, const q31_t* pSrc, q31_t* pDst)
+{
+    uint32_t m = S->fftLenReal >> 1;
+    uint32_t step = 2u * S->twidCoefRModifier;
+    const q31_t* pTwiddle = S->pTwiddleBReal;
+    uint32_t k;
+    q31_t c, s;
+    q31_t ar, ai, br, bi;
+    q31_t sr, si, dr, di;
+
+    for (k = 0; k < m; k++)
+    {
+        c = pTwiddle[k * step];
+        s = pTwiddle[(k * step) + 1u];
+
+        ar = arm_shift_round_q31(pSrc[2u * k], 1);
+        ai = arm_shift_round_q31(pSrc[(2u * k) + 1u], 1);
+        br = arm_shift_round_q31(pSrc[2u * (m - k)], 1);
+        bi = -arm_shift_round_q31(pSrc[(2u * (m - k)) + 1u], 1);
+
+        sr = ar + br;
+        si = ai + bi;
+        dr = br - ar;
+        di = bi - ai;
+
+        pDst[2u * k] = clip_q63_to_q31((q63_t)sr + ((arm_mult_q31_q63(dr, s) + arm_mult_q31_q63(di, c) + 0x40000000) >> 31));
+        pDst[(2u * k) + 1u] = clip_q63_to_q31((q63_t)si + ((arm_mult_q31_q63(di, s) - arm_mult_q31_q63(dr, c) + 0x40000000) >> 31));
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Q31 real FFT.
+  * @note   The forward transform reads fftLenReal real samples, overwrites
+  *         them, and writes fftLenReal complex values X[k] / fftLenReal to
+  *         pDst. The inverse transform reads the fftLenReal / 2 + 1 first
+  *         complex values of a spectrum and writes fftLenReal real samples
+  *         (1 / fftLenReal) x sum of X[k] e^(+2 pi j k n / fftLenReal) to
+  *         pDst, so a forward then inverse transform returns x / fftLenReal.
+  * @param  S: points to an instance initialized by arm_rfft_init_q31().
+  * @param  pSrc: points to the input, modified by the forward transform.
+  * @param  pDst: points to the output.
+  * @retval None
+  */
+void arm_rfft_q31(const arm_rfft_instance_q31* S, q31_t* pSrc, q31_t* pDst)
+{
+    uint32_t i;
+
+    if (S->ifftFlagR == 0u)
+    {
+        /* Half scale so that the split cannot overflow */
+        for (i = 0; i < S->fftLenReal; i++)
+        {
+            pSrc[i] = arm_shift_round_q31(pSrc[i], 1);
+        }
+
+        arm_cfft_q31(S->pCfft, pSrc, 0, 1);
+        arm_split_rfft_q31(S, pSrc, pDst);
+    }
+    else
+    {
+        arm_split_rifft_q31(S, pSrc, pDst);
+        arm_cfft_q31(S->pCfft, pDst, 1, 1);
+    }
+}
@@ -0,0 +1,256 @@
+/******************** (C) COPYRIGHT   HKMicroChip ********************
+ * File Name          : GCC_Startup_hk32l0xx.s
+ * Author             : HKApplication Team
+ * Description        : hk32l0xx devices vector table for GCC toolchain.
+ *                      This module performs:
+ *                      - Set the initial SP
+ *                      - Set the initial PC == Reset_Handler
+ *                      - Set the vector table entries with the exceptions ISR address
+ *                      - Copy the .data section, the ".RamFunc" functions of
+ *                        FLASH_RAMFUNC included, from FLASH to SRAM and clear
+ *                        the .bss section (symbols of hk32l0xx_flash.ld)
+ *                      - Branches to main in the C library (which eventually
+ *                        calls main()).
+ *                      After Reset the CortexM0 processor is in Thread mode,
+ *                      priority is Privileged, and the Stack is set to Main.
+ ******************************************************************************/
+
+    .syntax unified
+    .cpu cortex-m0
+    .fpu softvfp
+    .thumb
+
+    .global g_pfnVectors
+    .global Default_Handler
+
+/* Symbols of the linker script */
+    .word   _sidata                     /* Load address of .data in FLASH */
+    .word   _sdata                      /* Start of .data in SRAM */
+    .word   _edata                      /* End of .data in SRAM */
+    .word   _sbss                       /* Start of .bss */
+    .word   _ebss                       /* End of .bss */
+
+/* Reset handler routine */
+    .section .text.Reset_Handler
+    .weak   Reset_Handler
+    .type   Reset_Handler, %function
+Reset_Handler:
+    ldr     r0, =_estack
+    mov     sp, r0
+
+    /* Copy .data and the SRAM functions from FLASH to SRAM */
+    ldr     r0, =_sdata
+    ldr     r1, =_edata
+    ldr     r2, =_sidata
+    movs    r3, #0
+    b       LoopCopyData
+
+CopyData:
+    ldr     r4, [r2, r3]
+    str     r4, [r0, r3]
+    adds    r3, r3, #4
+
+LoopCopyData:
+    adds    r4, r0, r3
+    cmp     r4, r1
+    bcc     CopyData
+
+    /* Clear .bss */
+    ldr     r2, =_sbss
+    ldr     r4, =_ebss
+    movs    r3, #0
+    b       LoopFillZerobss
+
+FillZerobss:
+    str     r3, [r2]
+    adds    r2, r2, #4
+
+LoopFillZerobss:
+    cmp     r2, r4
+    bcc     FillZerobss
+
+    bl      SystemInit
+    bl      __libc_init_array
+    bl      main
+
+LoopForever:
+    b       LoopForever
+
+    .size   Reset_Handler, .-Reset_Handler
+
+/* Dummy Exception Handlers (infinite loops which can be modified) */
+    .section .text.Default_Handler, "ax", %progbits
+Default_Handler:
+Infinite_Loop:
+    b       Infinite_Loop
+    .size   Default_Handler, .-Default_Handler
+
+/* Vector Table Mapped to Address 0 at Reset */
+    .section .isr_vector, "a", %progbits
+    .type   g_pfnVectors, %object
+
+g_pfnVectors:
+    .word   _estack                        /* Top of Stack */
+    .word   Reset_Handler                  /* Reset Handler */
+    .word   NMI_Handler                    /* NMI Handler */
+    .word   HardFault_Handler              /* Hard Fault Handler */
+    .word   0                              /* Reserved */
+    .word   0                              /* Reserved */
+    .word   0                              /* Reserved */
+    .word   0                              /* Reserved */
+    .word   0                              /* Reserved */
+    .word   0                              /* Reserved */
+    .word   0                              /* Reserved */
+    .word   SVC_Handler                    /* SVCall Handler */
+    .word   0                              /* Reserved */
+    .word   0                              /* Reserved */
+    .word   PendSV_Handler                 /* PendSV Handler */
+    .word   SysTick_Handler                /* SysTick Handler */
+
+    /* External Interrupts */
+    .word   WWDG_IRQHandler                /* Window Watchdog */
+    .word   PVD_IRQHandler                 /* PVD and VDDIO2 supply comparator */
+    .word   RTC_IRQHandler                 /* RTC */
+    .word   FLASH_IRQHandler               /* FLASH */
+    .word   RCC_IRQHandler                 /* RCC */
+    .word   EXTI0_1_IRQHandler             /* EXTI Line 0 and Line 1 */
+    .word   EXTI2_3_IRQHandler             /* EXTI Line 2 and Line 3 */
+    .word   EXTI4_15_IRQHandler            /* EXTI Line 4 to Line 15 */
+    .word   LPUART_IRQHandler              /* LPUART */
+    .word   DMA_CH1_IRQHandler             /* DMA1 Channel1 */
+    .word   DMA_CH2_3_IRQHandler           /* DMA1 Channel2 and Channel3 */
+    .word   DMA_CH4_7_IRQHandler           /* DMA1 Channel4 to Channel7 */
+    .word   ADC_COMP_IRQHandler            /* ADC and comparator 1 and 2 */
+    .word   TIM1_IRQHandler                /* TIMER1 */
+    .word   UART3_4_IRQHandler             /* UART34 */
+    .word   TIM2_IRQHandler                /* TIM2 */
+    .word   TIM3_IRQHandler                /* TIM3 */
+    .word   DAC_IRQHandler                 /* DAC */
+    .word   0                              /* Reserved */
+    .word   TIM14_IRQHandler               /* TIMER14 */
+    .word   TIM15_IRQHandler               /* TIMER15 */
+    .word   TIM16_IRQHandler               /* TIMER16 */
+    .word   TIM17_IRQHandler               /* TIMER17 */
+    .word   I2C1_IRQHandler                /* I2C1 */
+    .word   I2C2_IRQHandler                /* I2C2 */
+    .word   SPI1_IRQHandler                /* SPI1 */
+    .word   SPI2_IRQHandler                /* SPI2 */
+    .word   USART1_IRQHandler              /* USART1 */
+    .word   USART2_IRQHandler              /* USART2 */
+    .word   AES_TRNG_EMACC_IRQHandler      /* AES and TRNG */
+    .word   LCD_CAN_IRQHandler             /* LCD */
+    .word   USB_DVSQ_IRQHandler            /* USB event interrupt */
+
+    .size   g_pfnVectors, .-g_pfnVectors
+
+/* Weak aliases of the handlers to Default_Handler, to be overridden by
+   handlers of the same name */
+    .weak   NMI_Handler
+    .thumb_set NMI_Handler, Default_Handler
+
+    .weak   HardFault_Handler
+    .thumb_set HardFault_Handler, Default_Handler
+
+    .weak   SVC_Handler
+    .thumb_set SVC_Handler, Default_Handler
+
+    .weak   PendSV_Handler
+    .thumb_set PendSV_Handler, Default_Handler
+
+    .weak   SysTick_Handler
+    .thumb_set SysTick_Handler, Default_Handler
+
+    .weak   WWDG_IRQHandler
+    .thumb_set WWDG_IRQHandler, Default_Handler
+
+    .weak   PVD_IRQHandler
+    .thumb_set PVD_IRQHandler, Default_Handler
+
+    .weak   RTC_IRQHandler
+    .thumb_set RTC_IRQHandler, Default_Handler
+
+    .weak   FLASH_IRQHandler
+    .thumb_set FLASH_IRQHandler, Default_Handler
+
+    .weak   RCC_IRQHandler
+    .thumb_set RCC_IRQHandler, Default_Handler
+
+    .weak   EXTI0_1_IRQHandler
+    .thumb_set EXTI0_1_IRQHandler, Default_Handler
+
+    .weak   EXTI2_3_IRQHandler
+    .thumb_set EXTI2_3_IRQHandler, Default_Handler
+
+    .weak   EXTI4_15_IRQHandler
+    .thumb_set EXTI4_15_IRQHandler, Default_Handler
+
+    .weak   LPUART_IRQHandler
+    .thumb_set LPUART_IRQHandler, Default_Handler
+
+    .weak   DMA_CH1_IRQHandler
+    .thumb_set DMA_CH1_IRQHandler, Default_Handler
+
+    .weak   DMA_CH2_3_IRQHandler
+    .thumb_set DMA_CH2_3_IRQHandler, Default_Handler
+
+    .weak   DMA_CH4_7_IRQHandler
+    .thumb_set DMA_CH4_7_IRQHandler, Default_Handler
+
+    .weak   ADC_COMP_IRQHandler
+    .thumb_set ADC_COMP_IRQHandler, Default_Handler
+
+    .weak   TIM1_IRQHandler
+    .thumb_set TIM1_IRQHandler, Default_Handler
+
+    .weak   UART3_4_IRQHandler
+    .thumb_set UART3_4_IRQHandler, Default_Handler
+
+    .weak   TIM2_IRQHandler
+    .thumb_set TIM2_IRQHandler, Default_Handler
+
+    .weak   TIM3_IRQHandler
+    .thumb_set TIM3_IRQHandler, Default_Handler
+
+    .weak   DAC_IRQHandler
+    .thumb_set DAC_IRQHandler, Default_Handler
+
+    .weak   TIM14_IRQHandler
+    .thumb_set TIM14_IRQHandler, Default_Handler
+
+    .weak   TIM15_IRQHandler
+    .thumb_set TIM15_IRQHandler, Default_Handler
+
+    .weak   TIM16_IRQHandler
+    .thumb_set TIM16_IRQHandler, Default_Handler
+
+    .weak   TIM17_IRQHandler
+    .thumb_set TIM17_IRQHandler, Default_Handler
+
+    .weak   I2C1_IRQHandler
+    .thumb_set I2C1_IRQHandler, Default_Handler
+
+    .weak   I2C2_IRQHandler
+    .thumb_set I2C2_IRQHandler, Default_Handler
+
+    .weak   SPI1_IRQHandler
+    .thumb_set SPI1_IRQHandler, Default_Handler
+
+    .weak   SPI2_IRQHandler
+    .thumb_set SPI2_IRQHandler, Default_Handler
+
+    .weak   USART1_IRQHandler
+    .thumb_set USART1_IRQHandler, Default_Handler
+
+    .weak   USART2_IRQHandler
+    .thumb_set USART2_IRQHandler, Default_Handler
+
+    .weak   AES_TRNG_EMACC_IRQHandler
+    .thumb_set AES_TRNG_EMACC_IRQHandler, Default_Handler
+
+    .weak   LCD_CAN_IRQHandler
+    .thumb_set LCD_CAN_IRQHandler, Default_Handler
+
+    .weak   USB_DVSQ_IRQHandler
+    .thumb_set USB_DVSQ_IRQHandler, Default_Handler
+
+/************************ (C) COPYRIGHT HKMicroChip *****END OF FILE*****/
@@ -21,6 +21,22 @@
   */
   
 /* Exported types ------------------------------------------------------------*/
+
+/** @defgroup usb_mem_Exported_Types usb_mem_Exported_Types
+  * @{
+  */
+
+/* User buffer of a gather/scatter PMA copy */
+typedef struct _PMA_SEGMENT
+{
+    uint8_t  *pbBuf;     /* pointer to user memory area */
+    uint16_t wNBytes;    /* number of bytes in this segment */
+} PMA_SEGMENT;
+
+/**
+  * @}
+  */
+
 /* Exported constants --------------------------------------------------------*/
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
@@ -31,6 +47,8 @@
   
 void UserToPMABufferCopy(uint8_t *pbUsrBuf, uint16_t wPMABufAddr, uint16_t wNBytes);
 void PMAToUserBufferCopy(uint8_t *pbUsrBuf, uint16_t wPMABufAddr, uint16_t wNBytes);
+uint16_t UserToPMABufferCopyGather(PMA_SEGMENT *pSegment, uint8_t bNSegments, uint16_t wPMABufAddr);
+uint16_t PMAToUserBufferCopyScatter(PMA_SEGMENT *pSegment, uint8_t bNSegments, uint16_t wPMABufAddr);
 /* External variables --------------------------------------------------------*/
 
 /**
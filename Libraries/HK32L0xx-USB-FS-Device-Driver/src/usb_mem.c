@@ -37,12 +37,134 @@
 /* Private variables ---------------------------------------------------------*/
 /* Extern variables ----------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
+static __IO uint16_t *UserToPMAHalfWords(uint8_t *pbUsrBuf, __IO uint16_t *pwPMA, uint32_t n);
+static __IO uint32_t *PMAToUserHalfWords(uint8_t *pbUsrBuf, __IO uint32_t *pdwPMA, uint32_t n);
+
 /* Private functions ---------------------------------------------------------*/
 
 /** @defgroup usb_mem_Private_Functions usb_mem_Private_Functions
   * @{
   */
 
+/**
+  * @brief  Copy half-words from user memory area to packet memory area (PMA).
+  * @note   Each PMA half-word sits in a 32-bit slot. A word aligned user
+  *         buffer is read one word at a time, 16 bytes per loop (a 64 bytes
+  *         packet takes 4 loops), a half-word aligned one half-word at a time
+  *         and an unaligned one byte by byte.
+  * @param  pbUsrBuf: pointer to user memory area.
+  * @param  pwPMA: pointer into PMA.
+  * @param  n: Number of half-words to be copied.
+  * @retval Pointer to the next PMA half-word.
+  **/
+static __IO uint16_t *UserToPMAHalfWords(uint8_t *pbUsrBuf, __IO uint16_t *pwPMA, uint32_t n)
+{
+    uint32_t *pdwUsr;
+    uint16_t *pwUsr;
+    uint32_t temp;
+
+    if (((uint32_t)pbUsrBuf & 3) == 0)
+    {
+        pdwUsr = (uint32_t *)pbUsrBuf;
+
+        for (; n >= 8; n -= 8)
+        {
+            temp = pdwUsr[0];
+            pwPMA[0] = (uint16_t)temp;
+            pwPMA[2] = (uint16_t)(temp >> 16);
+            temp = pdwUsr[1];
+            pwPMA[4] = (uint16_t)temp;
+            pwPMA[6] = (uint16_t)(temp >> 16);
+            temp = pdwUsr[2];
+            pwPMA[8] = (uint16_t)temp;
+            pwPMA[10] = (uint16_t)(temp >> 16);
+            temp = pdwUsr[3];
+            pwPMA[12] = (uint16_t)temp;
+            pwPMA[14] = (uint16_t)(temp >> 16);
+            pdwUsr += 4;
+            pwPMA += 16;
+        }
+
+        pbUsrBuf = (uint8_t *)pdwUsr;
+    }
+
+    if (((uint32_t)pbUsrBuf & 1) == 0)
+    {
+        pwUsr = (uint16_t *)pbUsrBuf;
+
+        for (; n != 0; n--)
+        {
+            *pwPMA = *pwUsr++;
+            pwPMA += 2;
+        }
+    }
+    else
+    {
+        for (; n != 0; n--)
+        {
+            *pwPMA = (uint16_t)(pbUsrBuf[0] | (pbUsrBuf[1] << 8));
+            pbUsrBuf += 2;
+            pwPMA += 2;
+        }
+    }
+
+    return pwPMA;
+}
+
+/**
+  * @brief  Copy half-words from packet memory area (PMA) to user memory area.
+  * @note   Same alignment specialized paths as UserToPMAHalfWords().
+  * @param  pbUsrBuf: pointer to user memory area.
+  * @param  pdwPMA: pointer into PMA.
+  * @param  n: Number of half-words to be copied.
+  * @retval Pointer to the next PMA half-word.
+  **/
+static __IO uint32_t *PMAToUserHalfWords(uint8_t *pbUsrBuf, __IO uint32_t *pdwPMA, uint32_t n)
+{
+    uint32_t *pdwUsr;
+    uint16_t *pwUsr;
+    uint32_t temp;
+
+    if (((uint32_t)pbUsrBuf & 3) == 0)
+    {
+        pdwUsr = (uint32_t *)pbUsrBuf;
+
+        for (; n >= 8; n -= 8)
+        {
+            pdwUsr[0] = (pdwPMA[0] & 0xFFFF) | (pdwPMA[1] << 16);
+            pdwUsr[1] = (pdwPMA[2] & 0xFFFF) | (pdwPMA[3] << 16);
+            pdwUsr[2] = (pdwPMA[4] & 0xFFFF) | (pdwPMA[5] << 16);
+            pdwUsr[3] = (pdwPMA[6] & 0xFFFF) | (pdwPMA[7] << 16);
+            pdwUsr += 4;
+            pdwPMA += 8;
+        }
+
+        pbUsrBuf = (uint8_t *)pdwUsr;
+    }
+
+    if (((uint32_t)pbUsrBuf & 1) == 0)
+    {
+        pwUsr = (uint16_t *)pbUsrBuf;
+
+        for (; n != 0; n--)
+        {
+            *pwUsr++ = (uint16_t)*pdwPMA++;
+        }
+    }
+    else
+    {
+        for (; n != 0; n--)
+        {
+            temp = *pdwPMA++;
+            pbUsrBuf[0] = (uint8_t)temp;
+            pbUsrBuf[1] = (uint8_t)(temp >> 8);
+            pbUsrBuf += 2;
+        }
+    }
+
+    return pdwPMA;
+}
+
 /**
   * @brief  Copy a buffer from user memory area to packet memory area (PMA)
   * @param  pbUsrBuf: pointer to user memory area.
@@ -52,24 +174,19 @@
   **/
 void UserToPMABufferCopy(uint8_t *pbUsrBuf, uint16_t wPMABufAddr, uint16_t wNBytes)
 {
-    uint32_t n = (wNBytes + 1) >> 1;   /* n = (wNBytes + 1) / 2 */
-    uint32_t i, temp1, temp2;
-    uint16_t *pdwVal;
-    pdwVal = (uint16_t *)(wPMABufAddr * 2 + PMAAddr);
+    __IO uint16_t *pwVal;
+    pwVal = (__IO uint16_t *)(wPMABufAddr * 2 + PMAAddr);
+
+    pwVal = UserToPMAHalfWords(pbUsrBuf, pwVal, wNBytes >> 1);
 
-    for (i = n; i != 0; i--)
+    if (wNBytes & 1)
     {
-        temp1 = (uint16_t) * pbUsrBuf;
-        pbUsrBuf++;
-        temp2 = temp1 | (uint16_t) * pbUsrBuf << 8;
-        *pdwVal++ = temp2;
-        pdwVal++;
-        pbUsrBuf++;
+        *pwVal = pbUsrBuf[wNBytes - 1];
     }
 }
 
 /**
-  * @brief  Copy a buffer from user memory area to packet memory area (PMA)
+  * @brief  Copy a buffer from packet memory area (PMA) to user memory area
   * @param  pbUsrBuf: pointer to user memory area.
   * @param  wPMABufAddr: address into PMA.
   * @param  wNBytes: Number of bytes to be copied.
@@ -77,16 +194,114 @@ void UserToPMABufferCopy(uint8_t *pbUsrBuf, uint16_t wPMABufAddr, uint16_t wNByt
   **/
 void PMAToUserBufferCopy(uint8_t *pbUsrBuf, uint16_t wPMABufAddr, uint16_t wNBytes)
 {
-    uint32_t n = (wNBytes + 1) >> 1;/* /2*/
-    uint32_t i;
-    uint32_t *pdwVal;
-    pdwVal = (uint32_t *)(wPMABufAddr * 2 + PMAAddr);
+    __IO uint32_t *pdwVal;
+    pdwVal = (__IO uint32_t *)(wPMABufAddr * 2 + PMAAddr);
+
+    pdwVal = PMAToUserHalfWords(pbUsrBuf, pdwVal, wNBytes >> 1);
+
+    if (wNBytes & 1)
+    {
+        pbUsrBuf[wNBytes - 1] = (uint8_t)*pdwVal;
+    }
+}
+
+/**
+  * @brief  Gather several user buffers into one packet memory area (PMA)
+  *         buffer, e.g. a class header followed by its payload.
+  * @param  pSegment: array of user buffers, copied in order.
+  * @param  bNSegments: Number of entries in pSegment.
+  * @param  wPMABufAddr: address into PMA.
+  * @retval Number of bytes copied.
+  **/
+uint16_t UserToPMABufferCopyGather(PMA_SEGMENT *pSegment, uint8_t bNSegments, uint16_t wPMABufAddr)
+{
+    __IO uint16_t *pwVal;
+    uint8_t *pbUsrBuf;
+    uint16_t wNBytes;
+    uint16_t wTotal = 0;
+    uint16_t wCarry = 0;
+    uint8_t bCarry = 0;
+
+    pwVal = (__IO uint16_t *)(wPMABufAddr * 2 + PMAAddr);
 
-    for (i = n; i != 0; i--)
+    for (; bNSegments != 0; bNSegments--, pSegment++)
     {
-        *(uint16_t*)pbUsrBuf++ = *pdwVal++;
-        pbUsrBuf++;
+        pbUsrBuf = pSegment->pbBuf;
+        wNBytes = pSegment->wNBytes;
+        wTotal += wNBytes;
+
+        /* Complete the half-word left open by an odd sized segment */
+        if (bCarry && wNBytes)
+        {
+            *pwVal = wCarry | ((uint16_t)*pbUsrBuf++ << 8);
+            pwVal += 2;
+            wNBytes--;
+            bCarry = 0;
+        }
+
+        pwVal = UserToPMAHalfWords(pbUsrBuf, pwVal, wNBytes >> 1);
+
+        if (wNBytes & 1)
+        {
+            wCarry = pbUsrBuf[wNBytes - 1];
+            bCarry = 1;
+        }
     }
+
+    if (bCarry)
+    {
+        *pwVal = wCarry;
+    }
+
+    return wTotal;
+}
+
+/**
+  * @brief  Scatter one packet memory area (PMA) buffer into several user
+  *         buffers, e.g. a class header and its payload.
+  * @param  pSegment: array of user buffers, filled in order.
+  * @param  bNSegments: Number of entries in pSegment.
+  * @param  wPMABufAddr: address into PMA.
+  * @retval Number of bytes copied.
+  **/
+uint16_t PMAToUserBufferCopyScatter(PMA_SEGMENT *pSegment, uint8_t bNSegments, uint16_t wPMABufAddr)
+{
+    __IO uint32_t *pdwVal;
+    uint8_t *pbUsrBuf;
+    uint16_t wNBytes;
+    uint16_t wTotal = 0;
+    uint32_t temp;
+    uint8_t bCarry = 0;
+    uint8_t bCarryByte = 0;
+
+    pdwVal = (__IO uint32_t *)(wPMABufAddr * 2 + PMAAddr);
+
+    for (; bNSegments != 0; bNSegments--, pSegment++)
+    {
+        pbUsrBuf = pSegment->pbBuf;
+        wNBytes = pSegment->wNBytes;
+        wTotal += wNBytes;
+
+        /* Hand out the upper byte of the half-word already read */
+        if (bCarry && wNBytes)
+        {
+            *pbUsrBuf++ = bCarryByte;
+            wNBytes--;
+            bCarry = 0;
+        }
+
+        pdwVal = PMAToUserHalfWords(pbUsrBuf, pdwVal, wNBytes >> 1);
+
+        if (wNBytes & 1)
+        {
+            temp = *pdwVal++;
+            pbUsrBuf[wNBytes - 1] = (uint8_t)temp;
+            bCarryByte = (uint8_t)(temp >> 8);
+            bCarry = 1;
+        }
+    }
+
+    return wTotal;
 }
 
 /**
@@ -0,0 +1,228 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  iap_core.h
+* @brief:     Firmware update: chunk protocol, staging and swap on reboot.
+* @author:    AE Team
+*******************************************************************************/
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __IAP_CORE_H
+#define __IAP_CORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "hk32l0xx.h"
+
+/** @addtogroup IAP
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup IAP_Exported_Constants IAP_Exported_Constants
+  * @{
+  */
+
+/* Default flash layout of the 128 Kbytes devices, offsets from IAP_FLASH_BASE:
+   bootloader 16 Kbytes, application and staging 48 Kbytes each, then the
+   update record half page */
+#ifndef IAP_FLASH_BASE
+#define IAP_FLASH_BASE              ((uint32_t)0x08000000)
+#endif
+#ifndef IAP_APP_OFFSET
+#define IAP_APP_OFFSET              ((uint32_t)0x00004000)
+#endif
+#ifndef IAP_IMAGE_SIZE
+#define IAP_IMAGE_SIZE              ((uint32_t)0x0000C000)
+#endif
+#ifndef IAP_STAGING_OFFSET
+#define IAP_STAGING_OFFSET          ((uint32_t)0x00010000)
+#endif
+#ifndef IAP_RECORD_OFFSET
+#define IAP_RECORD_OFFSET           ((uint32_t)0x0001C000)
+#endif
+
+/* Largest image bytes carried by a DATA frame, multiple of 4 */
+#ifndef IAP_CHUNK_SIZE
+#define IAP_CHUNK_SIZE              256
+#endif
+
+/* Frame: SOF, type, sequence (2 bytes), length (2 bytes), payload, CRC-16/CCITT
+   of type to payload (2 bytes). Multi-byte fields are little endian */
+#define IAP_FRAME_SOF               0x5A
+#define IAP_FRAME_HEADER_SIZE       6
+#define IAP_FRAME_PAYLOAD_SIZE      (IAP_CHUNK_SIZE + 4)
+#define IAP_FRAME_SIZE_MAX          (IAP_FRAME_HEADER_SIZE + IAP_FRAME_PAYLOAD_SIZE + 2)
+
+/* Frame types. START payload: image size, image CRC-32, version (4 bytes each)
+   and an optional 16 bytes tag. DATA payload: image offset (4 bytes) and data.
+   END and ABORT have no payload */
+#define IAP_FRAME_START             0x01
+#define IAP_FRAME_DATA              0x02
+#define IAP_FRAME_END               0x03
+#define IAP_FRAME_ABORT             0x04
+/* Response type: request type | IAP_FRAME_RESPONSE, same sequence, payload:
+   IAP_Status (1 byte) and image bytes staged (4 bytes) */
+#define IAP_FRAME_RESPONSE          0x80
+#define IAP_RESPONSE_SIZE           (IAP_FRAME_HEADER_SIZE + 5 + 2)
+
+/* Authentication tag size */
+#define IAP_TAG_SIZE                16
+
+/* Update record words. Word 0 to 7 then IAP_RECORD_COMMIT are programmed once
+   the staged image is verified, IAP_RECORD_DONE by the bootloader once the
+   image is copied, or rejected */
+#define IAP_RECORD_MAGIC            0
+#define IAP_RECORD_SIZE             1
+#define IAP_RECORD_CRC              2
+#define IAP_RECORD_VERSION          3
+#define IAP_RECORD_TAG              4
+#define IAP_RECORD_COMMIT           8
+#define IAP_RECORD_DONE             9
+#define IAP_RECORD_WORDS            10
+
+#define IAP_MAGIC                   ((uint32_t)0x31504149)  /* "IAP1" */
+#define IAP_COMMIT                  ((uint32_t)0x54494D43)  /* "CMIT" */
+#define IAP_DONE                    ((uint32_t)0x454E4F44)  /* "DONE" */
+#define IAP_REJECTED                ((uint32_t)0x00000000)
+#define IAP_ERASED                  ((uint32_t)0xFFFFFFFF)
+
+/**
+  * @}
+  */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup IAP_Exported_Types IAP_Exported_Types
+  * @{
+  */
+
+/**
+  * @brief  Update status, also sent in the responses
+  */
+typedef enum
+{
+    IAP_OK              = 0,    /*!< Operation done */
+    IAP_NO_UPDATE       = 1,    /*!< No update started or pending */
+    IAP_SEQUENCE        = 2,    /*!< Data out of order, resume from the staged bytes */
+    IAP_INVALID         = 3,    /*!< Invalid frame or image */
+    IAP_FLASH_ERROR     = 4,    /*!< Erase, program or read back failed */
+    IAP_CRC_ERROR       = 5,    /*!< Image CRC mismatch */
+    IAP_AUTH_ERROR      = 6     /*!< Image authentication failed */
+} IAP_Status;
+
+/**
+  * @brief  Update state
+  */
+typedef enum
+{
+    IAP_STATE_IDLE      = 0,    /*!< Waiting for a START frame */
+    IAP_STATE_RECEIVE   = 1,    /*!< Receiving DATA frames */
+    IAP_STATE_COMMITTED = 2,    /*!< Image staged, swapped on the next reset */
+    IAP_STATE_ERROR     = 3     /*!< Update failed, waiting for a START frame */
+} IAP_State;
+
+/**
+  * @brief  Flash, CRC and link access.
+  * @note   Offsets are in bytes from pBase. Erase sets EraseSize bytes to 0xFF,
+  *         Program must only clear bits of erased words. The CRC functions
+  *         compute the CRC-32 (zlib) of the bytes given between CrcInit and
+  *         CrcFinal. Authenticate is optional: when not NULL it must return 1
+  *         for a genuine image of Size bytes with the START tag pTag.
+  */
+typedef struct
+{
+    const uint8_t* pBase;           /*!< Memory mapped flash, word aligned */
+    uint32_t AppOffset;             /*!< Application image */
+    uint32_t StagingOffset;         /*!< Staging image, same size as the application */
+    uint32_t ImageSize;             /*!< Bytes of each image, multiple of EraseSize */
+    uint32_t RecordOffset;          /*!< Update record, EraseSize bytes */
+    uint32_t EraseSize;             /*!< Smallest erasable unit, in bytes */
+    IAP_Status (*Erase)(uint32_t Offset);
+    IAP_Status (*Program)(uint32_t Offset, const uint32_t* pData, uint32_t NbWords);
+    void (*CrcInit)(void);
+    void (*CrcUpdate)(const uint8_t* pData, uint32_t Length);
+    uint32_t (*CrcFinal)(void);
+    uint8_t (*Authenticate)(const uint8_t* pImage, uint32_t Size, const uint8_t* pTag);
+    void (*Send)(const uint8_t* pData, uint32_t Length);   /*!< Sends a response, update side only */
+} IAP_PortTypeDef;
+
+/**
+  * @brief  Received frame
+  */
+typedef struct
+{
+    __IO uint8_t Ready;                             /*!< Set by the receiver, cleared once processed */
+    uint8_t Type;                                   /*!< Frame type */
+    uint16_t Sequence;                              /*!< Frame sequence */
+    uint16_t Length;                                /*!< Payload bytes */
+    uint32_t Payload[IAP_FRAME_PAYLOAD_SIZE / 4];   /*!< Payload, word aligned */
+} IAP_FrameTypeDef;
+
+/**
+  * @brief  Update context
+  */
+typedef struct
+{
+    const IAP_PortTypeDef* pPort;   /*!< Flash, CRC and link access */
+    IAP_State State;                /*!< Update state */
+    uint32_t Size;                  /*!< Image bytes */
+    uint32_t Crc;                   /*!< Image CRC-32 */
+    uint32_t Version;               /*!< Image version */
+    uint32_t Staged;                /*!< Image bytes programmed and read back */
+    uint32_t Erased;                /*!< Staging bytes erased */
+    uint8_t Tag[IAP_TAG_SIZE];      /*!< Authentication tag of the START frame */
+    /* Receiver, run by IAP_UpdateReceive() */
+    uint8_t RxState;                /*!< Frame field being received */
+    uint8_t RxDrop;                 /*!< Frame dropped, no free buffer */
+    uint8_t RxType;                 /*!< Type of the frame being received */
+    uint16_t RxSequence;            /*!< Sequence of the frame being received */
+    uint16_t RxLength;              /*!< Payload bytes of the frame being received */
+    uint16_t RxIndex;               /*!< Bytes of the field received */
+    uint16_t RxCrc;                 /*!< Running frame CRC */
+    uint16_t RxValue;               /*!< Field being received */
+    uint8_t RxHead;                 /*!< Buffer being received */
+    uint8_t RxTail;                 /*!< Next buffer to process */
+    IAP_FrameTypeDef Frame[2];      /*!< Frame being processed and frame being received */
+    uint32_t RxFrames;              /*!< Frames received */
+    uint32_t RxErrors;              /*!< Frames with a bad CRC or length */
+    uint32_t RxDropped;             /*!< Frames dropped, both buffers in use */
+} IAP_UpdateTypeDef;
+
+/**
+  * @}
+  */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+/** @defgroup IAP_Exported_Functions IAP_Exported_Functions
+  * @{
+  */
+/* Application side */
+void IAP_UpdateInit(IAP_UpdateTypeDef* Update, const IAP_PortTypeDef* pPort);
+void IAP_UpdateReceive(IAP_UpdateTypeDef* Update, const uint8_t* pData, uint32_t Length);
+IAP_State IAP_UpdateProcess(IAP_UpdateTypeDef* Update);
+uint16_t IAP_FrameBuild(uint8_t* pFrame, uint8_t Type, uint16_t Sequence, const uint8_t* pPayload,
+                        uint16_t Length);
+uint16_t IAP_Crc16(uint16_t Crc, const uint8_t* pData, uint32_t Length);
+/* Bootloader side */
+IAP_Status IAP_BootUpdate(const IAP_PortTypeDef* pPort);
+uint8_t IAP_BootPending(const IAP_PortTypeDef* pPort);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*__IAP_CORE_H */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
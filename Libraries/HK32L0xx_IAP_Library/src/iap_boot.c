@@ -0,0 +1,170 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  iap_boot.c
+* @brief:     Firmware update, bootloader side: swaps a committed image.
+*             ===================================================================
+*             An update is pending when the record holds IAP_MAGIC and
+*             IAP_COMMIT and its IAP_RECORD_DONE word is erased. The staged
+*             image is checked again (CRC-32 and, if available, the
+*             authentication tag), then copied to the application region
+*             erase unit by erase unit. Units already equal to the staged
+*             ones are skipped, so a copy interrupted by a reset resumes
+*             where it stopped and does not wear the flash again. The
+*             IAP_RECORD_DONE word is programmed only once the application
+*             CRC-32 matches: until then every reset restarts the copy, the
+*             staged image is never modified.
+*             A staged image that fails its check is rejected and the
+*             application in place is kept.
+*             ===================================================================
+* @author:    AE Team
+* @version:   V1.0.0/2024-12-09
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "iap_core.h"
+
+/** @addtogroup IAP
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static const uint32_t* IAP_Record(const IAP_PortTypeDef* pPort);
+static uint32_t IAP_ImageCrc(const IAP_PortTypeDef* pPort, uint32_t Offset, uint32_t Size);
+static IAP_Status IAP_RecordDone(const IAP_PortTypeDef* pPort, uint32_t Value);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Returns the update record.
+  * @param  pPort: flash and CRC access.
+  * @retval Record words.
+  */
+static const uint32_t* IAP_Record(const IAP_PortTypeDef* pPort)
+{
+    return (const uint32_t*)(pPort->pBase + pPort->RecordOffset);
+}
+
+/**
+  * @brief  Computes the CRC-32 of an image in flash.
+  * @param  pPort: flash and CRC access.
+  * @param  Offset: image offset.
+  * @param  Size: image bytes.
+  * @retval CRC-32.
+  */
+static uint32_t IAP_ImageCrc(const IAP_PortTypeDef* pPort, uint32_t Offset, uint32_t Size)
+{
+    pPort->CrcInit();
+    pPort->CrcUpdate(pPort->pBase + Offset, Size);
+
+    return pPort->CrcFinal();
+}
+
+/**
+  * @brief  Programs the IAP_RECORD_DONE word of the record.
+  * @param  pPort: flash and CRC access.
+  * @param  Value: IAP_DONE or IAP_REJECTED.
+  * @retval IAP_OK or IAP_FLASH_ERROR.
+  */
+static IAP_Status IAP_RecordDone(const IAP_PortTypeDef* pPort, uint32_t Value)
+{
+    if ((pPort->Program(pPort->RecordOffset + IAP_RECORD_DONE * 4, &Value, 1) != IAP_OK)
+            || (IAP_Record(pPort)[IAP_RECORD_DONE] != Value))
+    {
+        return IAP_FLASH_ERROR;
+    }
+
+    return IAP_OK;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Checks whether an update is pending.
+  * @param  pPort: flash and CRC access.
+  * @retval 1 if a committed image waits to be copied, 0 otherwise.
+  */
+uint8_t IAP_BootPending(const IAP_PortTypeDef* pPort)
+{
+    const uint32_t* record = IAP_Record(pPort);
+
+    return (uint8_t)((record[IAP_RECORD_MAGIC] == IAP_MAGIC)
+                     && (record[IAP_RECORD_COMMIT] == IAP_COMMIT)
+                     && (record[IAP_RECORD_DONE] == IAP_ERASED)
+                     && (record[IAP_RECORD_SIZE] != 0)
+                     && (record[IAP_RECORD_SIZE] <= pPort->ImageSize));
+}
+
+/**
+  * @brief  Copies the pending image, if any, to the application region.
+  * @note   To be called by the bootloader before starting the application.
+  * @param  pPort: flash and CRC access.
+  * @retval IAP_OK if the image was copied, IAP_NO_UPDATE if none is pending,
+  *         IAP_CRC_ERROR or IAP_AUTH_ERROR if the staged image was rejected,
+  *         IAP_FLASH_ERROR if the copy failed: it restarts at the next call.
+  */
+IAP_Status IAP_BootUpdate(const IAP_PortTypeDef* pPort)
+{
+    const uint32_t* record = IAP_Record(pPort);
+    uint32_t size = 0;
+    uint32_t unit = 0;
+
+    if (IAP_BootPending(pPort) == 0)
+    {
+        return IAP_NO_UPDATE;
+    }
+
+    size = record[IAP_RECORD_SIZE];
+
+    /* Check the staged image */
+    if (IAP_ImageCrc(pPort, pPort->StagingOffset, size) != record[IAP_RECORD_CRC])
+    {
+        IAP_RecordDone(pPort, IAP_REJECTED);
+        return IAP_CRC_ERROR;
+    }
+
+    if ((pPort->Authenticate != NULL)
+            && (pPort->Authenticate(pPort->pBase + pPort->StagingOffset, size,
+                                    (const uint8_t*)&record[IAP_RECORD_TAG]) == 0))
+    {
+        IAP_RecordDone(pPort, IAP_REJECTED);
+        return IAP_AUTH_ERROR;
+    }
+
+    /* Copy the erase units that differ */
+    for (unit = 0; unit < size; unit += pPort->EraseSize)
+    {
+        const uint8_t* pstaged = pPort->pBase + pPort->StagingOffset + unit;
+
+        if (memcmp(pPort->pBase + pPort->AppOffset + unit, pstaged, pPort->EraseSize) == 0)
+        {
+            continue;
+        }
+
+        if ((pPort->Erase(pPort->AppOffset + unit) != IAP_OK)
+                || (pPort->Program(pPort->AppOffset + unit, (const uint32_t*)pstaged, pPort->EraseSize / 4) != IAP_OK))
+        {
+            return IAP_FLASH_ERROR;
+        }
+    }
+
+    if (IAP_ImageCrc(pPort, pPort->AppOffset, size) != record[IAP_RECORD_CRC])
+    {
+        return IAP_FLASH_ERROR;
+    }
+
+    return IAP_RecordDone(pPort, IAP_DONE);
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,561 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  iap_update.c
+* @brief:     Firmware update, application side: receives an image in chunks
+*             and stages it for the bootloader.
+*             ===================================================================
+*             The link delivers frames through IAP_UpdateReceive(), from a
+*             receive interrupt or from the main loop. A frame is received in
+*             one of two buffers while the other one is processed by
+*             IAP_UpdateProcess(): a chunk is programmed in the staging region
+*             while the next one is still arriving. A frame received while
+*             both buffers are in use, or with a bad CRC, is dropped: the
+*             sender retransmits it when its response does not come.
+*             The image is checked chunk by chunk: each chunk is read back
+*             after programming and its flash copy is added to the image
+*             CRC-32. The staging half pages are erased just before they are
+*             programmed. Once the END frame checks the CRC and, if
+*             available, the authentication tag, the update record is
+*             programmed, IAP_COMMIT last: the bootloader copies the image at
+*             the next reset.
+*             A DATA frame below the staged bytes is acknowledged without
+*             being programmed again, a DATA frame above is answered with
+*             IAP_SEQUENCE and the staged bytes, from where the sender resumes.
+*             The module does not access the peripherals, the flash, the CRC
+*             and the link are reached through an IAP_PortTypeDef.
+*             ===================================================================
+* @author:    AE Team
+* @version:   V1.0.0/2024-12-09
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "iap_core.h"
+
+/** @addtogroup IAP
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Receiver states */
+#define IAP_RX_SOF                  0
+#define IAP_RX_TYPE                 1
+#define IAP_RX_SEQUENCE             2
+#define IAP_RX_LENGTH               3
+#define IAP_RX_PAYLOAD              4
+#define IAP_RX_CRC                  5
+
+/* START payload */
+#define IAP_START_SIZE              12
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static uint16_t IAP_Crc16Byte(uint16_t Crc, uint8_t Data);
+static void IAP_RxByte(IAP_UpdateTypeDef* Update, uint8_t Data);
+static IAP_Status IAP_Start(IAP_UpdateTypeDef* Update, IAP_FrameTypeDef* Frame);
+static IAP_Status IAP_Data(IAP_UpdateTypeDef* Update, IAP_FrameTypeDef* Frame);
+static IAP_Status IAP_End(IAP_UpdateTypeDef* Update);
+static IAP_Status IAP_Commit(IAP_UpdateTypeDef* Update);
+static void IAP_Respond(IAP_UpdateTypeDef* Update, IAP_FrameTypeDef* Frame, IAP_Status Status);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Adds a byte to a CRC-16/CCITT.
+  * @param  Crc: running CRC.
+  * @param  Data: byte to add.
+  * @retval New CRC.
+  */
+static uint16_t IAP_Crc16Byte(uint16_t Crc, uint8_t Data)
+{
+    uint8_t i;
+
+    Crc ^= (uint16_t)Data << 8;
+
+    for (i = 0; i < 8; i++)
+    {
+        Crc = (Crc & 0x8000) ? (uint16_t)((Crc << 1) ^ 0x1021) : (uint16_t)(Crc << 1);
+    }
+
+    return Crc;
+}
+
+/**
+  * @brief  Receives a frame byte.
+  * @param  Update: update context.
+  * @param  Data: received byte.
+  * @retval None
+  */
+static void IAP_RxByte(IAP_UpdateTypeDef* Update, uint8_t Data)
+{
+    IAP_FrameTypeDef* frame = &Update->Frame[Update->RxHead];
+
+    if (Update->RxState != IAP_RX_CRC)
+    {
+        Update->RxCrc = IAP_Crc16Byte(Update->RxCrc, Data);
+    }
+
+    switch (Update->RxState)
+    {
+        case IAP_RX_SOF:
+            if (Data == IAP_FRAME_SOF)
+            {
+                Update->RxCrc = 0xFFFF;
+                Update->RxDrop = frame->Ready;
+                Update->RxIndex = 0;
+                Update->RxValue = 0;
+                Update->RxState = IAP_RX_TYPE;
+            }
+            break;
+
+        case IAP_RX_TYPE:
+            Update->RxType = Data;
+            Update->RxState = IAP_RX_SEQUENCE;
+            break;
+
+        case IAP_RX_SEQUENCE:
+        case IAP_RX_LENGTH:
+        case IAP_RX_CRC:
+            Update->RxValue |= (uint16_t)Data << (8 * Update->RxIndex);
+
+            if (++Update->RxIndex < 2)
+            {
+                break;
+            }
+
+            Update->RxIndex = 0;
+
+            if (Update->RxState == IAP_RX_SEQUENCE)
+            {
+                Update->RxSequence = Update->RxValue;
+                Update->RxState = IAP_RX_LENGTH;
+            }
+            else if (Update->RxState == IAP_RX_LENGTH)
+            {
+                Update->RxLength = Update->RxValue;
+
+                if (Update->RxLength > IAP_FRAME_PAYLOAD_SIZE)
+                {
+                    Update->RxErrors++;
+                    Update->RxState = IAP_RX_SOF;
+                }
+                else
+                {
+                    Update->RxState = (Update->RxLength != 0) ? IAP_RX_PAYLOAD : IAP_RX_CRC;
+                }
+            }
+            else
+            {
+                if (Update->RxValue != Update->RxCrc)
+                {
+                    Update->RxErrors++;
+                }
+                else if (Update->RxDrop != 0)
+                {
+                    Update->RxDropped++;
+                }
+                else
+                {
+                    frame->Type = Update->RxType;
+                    frame->Sequence = Update->RxSequence;
+                    frame->Length = Update->RxLength;
+
+                    /* Publish the frame once its content is written */
+                    __DMB();
+                    frame->Ready = 1;
+                    Update->RxHead ^= 1;
+                    Update->RxFrames++;
+                }
+
+                Update->RxState = IAP_RX_SOF;
+            }
+
+            Update->RxValue = 0;
+            break;
+
+        case IAP_RX_PAYLOAD:
+            if (Update->RxDrop == 0)
+            {
+                ((uint8_t*)frame->Payload)[Update->RxIndex] = Data;
+            }
+
+            if (++Update->RxIndex == Update->RxLength)
+            {
+                Update->RxIndex = 0;
+                Update->RxState = IAP_RX_CRC;
+            }
+            break;
+
+        default:
+            Update->RxState = IAP_RX_SOF;
+            break;
+    }
+}
+
+/**
+  * @brief  Starts an update: cancels any update pending in the record.
+  * @param  Update: update context.
+  * @param  Frame: START frame.
+  * @retval IAP_OK, IAP_INVALID or IAP_FLASH_ERROR.
+  */
+static IAP_Status IAP_Start(IAP_UpdateTypeDef* Update, IAP_FrameTypeDef* Frame)
+{
+    const IAP_PortTypeDef* port = Update->pPort;
+
+    if ((Frame->Length != IAP_START_SIZE) && (Frame->Length != IAP_START_SIZE + IAP_TAG_SIZE))
+    {
+        return IAP_INVALID;
+    }
+
+    if ((Frame->Payload[0] == 0) || (Frame->Payload[0] > port->ImageSize))
+    {
+        return IAP_INVALID;
+    }
+
+    Update->State = IAP_STATE_ERROR;
+
+    if (port->Erase(port->RecordOffset) != IAP_OK)
+    {
+        return IAP_FLASH_ERROR;
+    }
+
+    Update->Size = Frame->Payload[0];
+    Update->Crc = Frame->Payload[1];
+    Update->Version = Frame->Payload[2];
+    Update->Staged = 0;
+    Update->Erased = 0;
+    memset(Update->Tag, 0, IAP_TAG_SIZE);
+
+    if (Frame->Length > IAP_START_SIZE)
+    {
+        memcpy(Update->Tag, &Frame->Payload[3], IAP_TAG_SIZE);
+    }
+
+    port->CrcInit();
+    Update->State = IAP_STATE_RECEIVE;
+
+    return IAP_OK;
+}
+
+/**
+  * @brief  Programs a chunk in the staging region.
+  * @param  Update: update context.
+  * @param  Frame: DATA frame.
+  * @retval IAP_OK, IAP_NO_UPDATE, IAP_SEQUENCE, IAP_INVALID or IAP_FLASH_ERROR.
+  */
+static IAP_Status IAP_Data(IAP_UpdateTypeDef* Update, IAP_FrameTypeDef* Frame)
+{
+    const IAP_PortTypeDef* port = Update->pPort;
+    uint32_t offset = Frame->Payload[0];
+    uint32_t length = (uint32_t)Frame->Length - 4;
+    uint32_t i = 0;
+
+    if (Update->State != IAP_STATE_RECEIVE)
+    {
+        return IAP_NO_UPDATE;
+    }
+
+    if ((Frame->Length <= 4) || ((offset & 3) != 0))
+    {
+        return IAP_INVALID;
+    }
+
+    /* Chunk already staged, its response was lost */
+    if ((offset < Update->Staged) && (length <= Update->Staged - offset))
+    {
+        return IAP_OK;
+    }
+
+    if (offset != Update->Staged)
+    {
+        return IAP_SEQUENCE;
+    }
+
+    /* Only the last chunk may end inside a word */
+    if ((length > Update->Size - offset) || (((length & 3) != 0) && (offset + length != Update->Size)))
+    {
+        return IAP_INVALID;
+    }
+
+    /* Erase the staging half pages reached by the chunk */
+    while (Update->Erased < offset + length)
+    {
+        if (port->Erase(port->StagingOffset + Update->Erased) != IAP_OK)
+        {
+            Update->State = IAP_STATE_ERROR;
+            return IAP_FLASH_ERROR;
+        }
+
+        Update->Erased += port->EraseSize;
+    }
+
+    /* Pad the last word with erased bytes */
+    for (i = length; (i & 3) != 0; i++)
+    {
+        ((uint8_t*)&Frame->Payload[1])[i] = 0xFF;
+    }
+
+    if ((port->Program(port->StagingOffset + offset, &Frame->Payload[1], (length + 3) / 4) != IAP_OK)
+            || (memcmp(port->pBase + port->StagingOffset + offset, &Frame->Payload[1], length) != 0))
+    {
+        Update->State = IAP_STATE_ERROR;
+        return IAP_FLASH_ERROR;
+    }
+
+    /* The CRC covers the flash copy of the chunk */
+    port->CrcUpdate(port->pBase + port->StagingOffset + offset, length);
+    Update->Staged += length;
+
+    return IAP_OK;
+}
+
+/**
+  * @brief  Checks the staged image and commits it.
+  * @param  Update: update context.
+  * @retval IAP_OK, IAP_NO_UPDATE, IAP_SEQUENCE, IAP_CRC_ERROR, IAP_AUTH_ERROR
+  *         or IAP_FLASH_ERROR.
+  */
+static IAP_Status IAP_End(IAP_UpdateTypeDef* Update)
+{
+    const IAP_PortTypeDef* port = Update->pPort;
+    IAP_Status status = IAP_OK;
+
+    /* Image already committed, the response was lost */
+    if (Update->State == IAP_STATE_COMMITTED)
+    {
+        return IAP_OK;
+    }
+
+    if (Update->State != IAP_STATE_RECEIVE)
+    {
+        return IAP_NO_UPDATE;
+    }
+
+    if (Update->Staged != Update->Size)
+    {
+        return IAP_SEQUENCE;
+    }
+
+    Update->State = IAP_STATE_ERROR;
+
+    if (port->CrcFinal() != Update->Crc)
+    {
+        return IAP_CRC_ERROR;
+    }
+
+    if ((port->Authenticate != NULL)
+            && (port->Authenticate(port->pBase + port->StagingOffset, Update->Size, Update->Tag) == 0))
+    {
+        return IAP_AUTH_ERROR;
+    }
+
+    status = IAP_Commit(Update);
+
+    if (status == IAP_OK)
+    {
+        Update->State = IAP_STATE_COMMITTED;
+    }
+
+    return status;
+}
+
+/**
+  * @brief  Programs the update record, IAP_COMMIT last.
+  * @param  Update: update context.
+  * @retval IAP_OK or IAP_FLASH_ERROR.
+  */
+static IAP_Status IAP_Commit(IAP_UpdateTypeDef* Update)
+{
+    const IAP_PortTypeDef* port = Update->pPort;
+    uint32_t record[IAP_RECORD_COMMIT + 1];
+
+    record[IAP_RECORD_MAGIC] = IAP_MAGIC;
+    record[IAP_RECORD_SIZE] = Update->Size;
+    record[IAP_RECORD_CRC] = Update->Crc;
+    record[IAP_RECORD_VERSION] = Update->Version;
+    memcpy(&record[IAP_RECORD_TAG], Update->Tag, IAP_TAG_SIZE);
+    record[IAP_RECORD_COMMIT] = IAP_COMMIT;
+
+    if ((port->Program(port->RecordOffset, record, IAP_RECORD_COMMIT) != IAP_OK)
+            || (port->Program(port->RecordOffset + IAP_RECORD_COMMIT * 4, &record[IAP_RECORD_COMMIT], 1) != IAP_OK)
+            || (memcmp(port->pBase + port->RecordOffset, record, sizeof(record)) != 0))
+    {
+        return IAP_FLASH_ERROR;
+    }
+
+    return IAP_OK;
+}
+
+/**
+  * @brief  Sends the response of a frame.
+  * @param  Update: update context.
+  * @param  Frame: processed frame.
+  * @param  Status: processing status.
+  * @retval None
+  */
+static void IAP_Respond(IAP_UpdateTypeDef* Update, IAP_FrameTypeDef* Frame, IAP_Status Status)
+{
+    uint8_t payload[5];
+    uint8_t response[IAP_RESPONSE_SIZE];
+    uint16_t length = 0;
+
+    if (Update->pPort->Send == NULL)
+    {
+        return;
+    }
+
+    payload[0] = (uint8_t)Status;
+    payload[1] = (uint8_t)Update->Staged;
+    payload[2] = (uint8_t)(Update->Staged >> 8);
+    payload[3] = (uint8_t)(Update->Staged >> 16);
+    payload[4] = (uint8_t)(Update->Staged >> 24);
+
+    length = IAP_FrameBuild(response, Frame->Type | IAP_FRAME_RESPONSE, Frame->Sequence, payload, sizeof(payload));
+    Update->pPort->Send(response, length);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Initializes an update context.
+  * @param  Update: update context.
+  * @param  pPort: flash, CRC and link access.
+  * @retval None
+  */
+void IAP_UpdateInit(IAP_UpdateTypeDef* Update, const IAP_PortTypeDef* pPort)
+{
+    memset(Update, 0, sizeof(IAP_UpdateTypeDef));
+    Update->pPort = pPort;
+    Update->State = IAP_STATE_IDLE;
+    Update->RxState = IAP_RX_SOF;
+}
+
+/**
+  * @brief  Delivers received link bytes to the update.
+  * @note   May be called from an interrupt, IAP_UpdateProcess() from the main
+  *         loop. Only one context may call it.
+  * @param  Update: update context.
+  * @param  pData: received bytes.
+  * @param  Length: number of bytes.
+  * @retval None
+  */
+void IAP_UpdateReceive(IAP_UpdateTypeDef* Update, const uint8_t* pData, uint32_t Length)
+{
+    while (Length-- != 0)
+    {
+        IAP_RxByte(Update, *pData++);
+    }
+}
+
+/**
+  * @brief  Processes the next received frame, if any, and sends its response.
+  * @param  Update: update context.
+  * @retval Update state. Once IAP_STATE_COMMITTED is returned, a reset swaps
+  *         the image.
+  */
+IAP_State IAP_UpdateProcess(IAP_UpdateTypeDef* Update)
+{
+    IAP_FrameTypeDef* frame = &Update->Frame[Update->RxTail];
+    IAP_Status status = IAP_OK;
+
+    if (frame->Ready == 0)
+    {
+        return Update->State;
+    }
+
+    switch (frame->Type)
+    {
+        case IAP_FRAME_START:
+            status = IAP_Start(Update, frame);
+            break;
+
+        case IAP_FRAME_DATA:
+            status = IAP_Data(Update, frame);
+            break;
+
+        case IAP_FRAME_END:
+            status = IAP_End(Update);
+            break;
+
+        case IAP_FRAME_ABORT:
+            if (Update->State != IAP_STATE_COMMITTED)
+            {
+                Update->State = IAP_STATE_IDLE;
+            }
+            break;
+
+        default:
+            status = IAP_INVALID;
+            break;
+    }
+
+    IAP_Respond(Update, frame, status);
+
+    /* Give the buffer back to the receiver */
+    __DMB();
+    frame->Ready = 0;
+    Update->RxTail ^= 1;
+
+    return Update->State;
+}
+
+/**
+  * @brief  Builds a frame.
+  * @param  pFrame: frame buffer, Length + 8 bytes.
+  * @param  Type: frame type.
+  * @param  Sequence: frame sequence.
+  * @param  pPayload: payload, may be NULL if Length is 0.
+  * @param  Length: payload bytes, up to IAP_FRAME_PAYLOAD_SIZE.
+  * @retval Frame bytes.
+  */
+uint16_t IAP_FrameBuild(uint8_t* pFrame, uint8_t Type, uint16_t Sequence, const uint8_t* pPayload,
+                        uint16_t Length)
+{
+    uint16_t crc = 0;
+
+    pFrame[0] = IAP_FRAME_SOF;
+    pFrame[1] = Type;
+    pFrame[2] = (uint8_t)Sequence;
+    pFrame[3] = (uint8_t)(Sequence >> 8);
+    pFrame[4] = (uint8_t)Length;
+    pFrame[5] = (uint8_t)(Length >> 8);
+
+    if (Length != 0)
+    {
+        memcpy(&pFrame[IAP_FRAME_HEADER_SIZE], pPayload, Length);
+    }
+
+    crc = IAP_Crc16(0xFFFF, &pFrame[1], Length + IAP_FRAME_HEADER_SIZE - 1);
+    pFrame[IAP_FRAME_HEADER_SIZE + Length] = (uint8_t)crc;
+    pFrame[IAP_FRAME_HEADER_SIZE + Length + 1] = (uint8_t)(crc >> 8);
+
+    return Length + IAP_FRAME_HEADER_SIZE + 2;
+}
+
+/**
+  * @brief  Computes the CRC-16/CCITT of a buffer.
+  * @param  Crc: initial value, 0xFFFF for a frame.
+  * @param  pData: buffer.
+  * @param  Length: number of bytes.
+  * @retval CRC.
+  */
+uint16_t IAP_Crc16(uint16_t Crc, const uint8_t* pData, uint32_t Length)
+{
+    while (Length-- != 0)
+    {
+        Crc = IAP_Crc16Byte(Crc, *pData++);
+    }
+
+    return Crc;
+}
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
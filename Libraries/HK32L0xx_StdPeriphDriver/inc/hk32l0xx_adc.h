@@ -55,6 +55,58 @@ typedef struct
                                                  in the sequence.
                                                  This parameter can be a value of @ref ADC_Scan_Direction */
 } ADC_InitTypeDef;
+
+/**
+  * @brief  ADC continuous acquisition: timer triggered scans written by a
+  *         circular DMA into two half buffers.
+  */
+typedef struct ADC_StreamStruct
+{
+    uint32_t ADC_Channels;                    /*!< Channels scanned at each trigger, any combination of
+                                                 @ref ADC_channels, converted in increasing channel number */
+    uint32_t ADC_SampleTime;                  /*!< Sampling time of all the channels,
+                                                 a value of @ref ADC_sampling_times */
+    uint32_t ADC_ExternalTrigConv;            /*!< Timer trigger of the scans, a value of
+                                                 @ref ADC_external_trigger_sources_for_channels_conversion */
+    uint32_t ADC_ExternalTrigConvEdge;        /*!< Trigger edge, a value of @ref ADC_external_trigger_edge_conversion
+                                                 other than ADC_ExternalTrigConvEdge_None */
+    uint32_t ADC_OverSamplingRatio;           /*!< ADC_STREAM_OVS_NONE or a value of @ref ADC_Oversampler
+                                                 ratios, all the conversions of a channel follow one trigger */
+    uint32_t ADC_OverSamplingShift;           /*!< Right shift of the oversampled sum,
+                                                 a value of @ref ADC_Oversampler shifts */
+    DMA_Channel_TypeDef* DMA_Channel;         /*!< DMA_Channel1 or DMA_Channel2, remapped to the ADC */
+    uint16_t* Buffer;                         /*!< Circular buffer of 2 * BlockLength scans, interleaved */
+    uint16_t BlockLength;                     /*!< Scans per half buffer */
+    uint16_t* Output;                         /*!< BlockLength samples per channel, channel after channel,
+                                                 NULL to deliver the interleaved half buffer */
+    void (*BlockCallback)(struct ADC_StreamStruct* Stream, const uint16_t* Block); /*!< Called from
+                                                 ADC_StreamIRQHandler() with each half buffer, de-interleaved
+                                                 into Output when Output is not NULL */
+    uint8_t NbChannels;                       /*!< Channels in ADC_Channels, internal use */
+    __IO uint32_t Blocks;                     /*!< Half buffers delivered */
+    __IO uint32_t Lost;                       /*!< Half buffers overwritten before they were delivered */
+    __IO uint32_t Overruns;                   /*!< ADC overruns, each one restarts the acquisition */
+} ADC_StreamTypeDef;
+
+/**
+  * @brief  ADC calibration context: the factory calibration words read once
+  *         and the integer factors converting 12 bits samples at the current
+  *         VDDA into millivolts and 0.01 degrees Celsius.
+  */
+typedef struct
+{
+    uint16_t VrefintCal;                      /*!< Vrefint conversion at VDDA = 3.3 V (VREFINT_CAL_ADDR) */
+    uint16_t TempFTCal;                       /*!< Sensor conversion at the FT test temperature,
+                                                 low half word of TEMPS_CAL_ADDR */
+    int32_t TempFT;                           /*!< FT test temperature in 0.01 degrees Celsius */
+    int32_t TempSlope;                        /*!< 0.01 degrees Celsius per LSB at VDDA = 3.3 V,
+                                                 TempShift fraction bits */
+    uint32_t TempShift;                       /*!< Fraction bits of TempSlope, TempScale and TempOffset */
+    uint32_t Vdda;                            /*!< VDDA in mV, from the last Vrefint conversions */
+    uint32_t MvScale;                         /*!< mV per LSB at Vdda, ADC_CALIB_MV_SHIFT fraction bits */
+    int32_t TempScale;                        /*!< 0.01 degrees Celsius per LSB at Vdda, TempShift fraction bits */
+    int32_t TempOffset;                       /*!< 0.01 degrees Celsius at code 0, TempShift fraction bits */
+} ADC_CalibTypeDef;
 /**
   * @}
   */
@@ -157,6 +209,23 @@ typedef struct
   * @}
   */
 
+/** @defgroup ADC_Stream_Oversampling  ADC Stream Oversampling
+  * @{
+  */
+#define ADC_STREAM_OVS_NONE                        ((uint32_t)0xFFFFFFFF) /*!< ADC_OverSamplingRatio without oversampling */
+/**
+  * @}
+  */
+
+/** @defgroup ADC_Calibration_Context  ADC Calibration Context
+  * @{
+  */
+#define ADC_CALIB_MV_SHIFT                         16    /*!< Fraction bits of ADC_CalibTypeDef MvScale */
+#define ADC_CALIB_TEMP_SHIFT_MAX                   16    /*!< Largest TempShift, smaller for a steep sensor */
+/**
+  * @}
+  */
+
 /** @defgroup ADC_external_trigger_edge_conversion   ADC external trigger edge conversion
   * @{
   */
@@ -580,6 +649,21 @@ void ADC_SETResolution(ADC_TypeDef* ADCx, uint32_t ADC_Resolution);
 
 /*set the ADC GAIN_SEL configuration***************************************************/
 void ADC_ConfigADCGainSel(ADC_TypeDef *ADCx, uint32_t GAIN_SEL1, uint32_t GAIN_SEL2);
+
+/* Continuous acquisition functions *******************************************/
+ErrorStatus ADC_StreamInit(ADC_TypeDef* ADCx, ADC_StreamTypeDef* Stream);
+void ADC_StreamStart(ADC_TypeDef* ADCx, ADC_StreamTypeDef* Stream);
+void ADC_StreamStop(ADC_TypeDef* ADCx, ADC_StreamTypeDef* Stream);
+uint32_t ADC_StreamGetIndex(ADC_StreamTypeDef* Stream, uint32_t ADC_Channel);
+void ADC_StreamIRQHandler(ADC_TypeDef* ADCx, ADC_StreamTypeDef* Stream);
+
+/* Calibration context functions **********************************************/
+ErrorStatus ADC_CalibInit(ADC_CalibTypeDef* Calib, uint32_t VrefintRaw);
+ErrorStatus ADC_CalibUpdateVdda(ADC_CalibTypeDef* Calib, const uint16_t* pVrefint, uint32_t Length);
+uint32_t ADC_CalibToMillivolts(const ADC_CalibTypeDef* Calib, uint32_t Raw);
+int32_t ADC_CalibToCentiDegrees(const ADC_CalibTypeDef* Calib, uint32_t Raw);
+void ADC_CalibBufferToMillivolts(const ADC_CalibTypeDef* Calib, const uint16_t* pRaw, uint16_t* pMillivolts, uint32_t Length);
+void ADC_CalibBufferToCentiDegrees(const ADC_CalibTypeDef* Calib, const uint16_t* pRaw, int16_t* pCentiDegrees, uint32_t Length);
 /**
   * @}
   */
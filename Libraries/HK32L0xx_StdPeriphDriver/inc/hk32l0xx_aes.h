@@ -79,6 +79,50 @@ typedef struct
                                This parameter can be a value of @ref AES_keysize */
 } AES_KeyInitTypeDef;
 
+/**
+  * @brief   AES software model, expanded key
+  */
+typedef struct
+{
+    uint32_t Rounds;                      /*!< Number of rounds: 10, 12 or 14 */
+    uint8_t RoundKey[240];                /*!< Round keys, set by AES_ModelKeyInit() */
+} AES_ModelTypeDef;
+
+/**
+  * @brief   AES chaining modes context
+  * @note    DMAIn_Channelx and DMAOut_Channelx must be remapped to the AES IN
+  *          and AES OUT requests with DMA_RemapConfig() and their clock enabled.
+  *          When Model is not NULL the blocks are computed by the software
+  *          model and the AES core is not used.
+  */
+typedef struct
+{
+    uint32_t KeySize;                     /*!< Key size, set by AES_ModeInit() */
+    uint32_t Key[8];                      /*!< Key, set by AES_ModeInit() */
+    DMA_Channel_TypeDef* DMAIn_Channelx;  /*!< DMA channel writing DINR (1 or 5), NULL to
+                                               use the CPU only */
+    DMA_Channel_TypeDef* DMAOut_Channelx; /*!< DMA channel reading DOUTR (2 or 3), NULL to
+                                               use the CPU only */
+    AES_ModelTypeDef* Model;              /*!< Software model, NULL to use the AES core */
+    uint32_t Operation;                   /*!< Operation in progress, internal use */
+} AES_ContextTypeDef;
+
+/**
+  * @brief   AES CTR_DRBG state
+  * @note    The key of AES_Context is overwritten by each DRBG call.
+  */
+typedef struct
+{
+    AES_ContextTypeDef* AES_Context;      /*!< Context computing the blocks */
+    uint32_t ReseedInterval;              /*!< Requests served before a reseed through GetEntropy */
+    ErrorStatus (*GetEntropy)(uint8_t* pData, uint32_t Length); /*!< Returns SUCCESS with Length bytes of
+                                                                     entropy input, NULL if none */
+    uint8_t Key[16];                      /*!< Working state, internal use */
+    uint8_t V[16];                        /*!< Working state, internal use */
+    uint32_t ReseedCounter;               /*!< Requests since the last seed, 0 if not instantiated */
+    uint32_t Reseeds;                     /*!< Reseeds done through GetEntropy */
+} AES_DRBGTypeDef;
+
 /**
   * @}
   */
@@ -161,6 +205,34 @@ typedef struct
   * @}
   */
 
+/** @defgroup AES_Chaining_Modes AES_Chaining_Modes
+  * @{
+  */
+#define AES_BLOCK_SIZE                     ((uint32_t)16)     /*!< Bytes of a block */
+#define AES_MODE_DMA_BLOCKS                ((uint32_t)4)      /*!< Blocks per DMA transfer in CBC decryption and
+                                                                   CTR, two buffers of this size are on the stack */
+#define AES_MODE_DMA_MAX_BLOCKS            ((uint32_t)0x3FFF) /*!< Maximum number of blocks of one DMA transfer */
+
+#define IS_AES_MODE_OPERATION(OPERATION) (((OPERATION) == AES_Operation_Encryp) || \
+                                          ((OPERATION) == AES_Operation_Decryp))
+#define IS_AES_CCM_NONCE_SIZE(SIZE)        (((SIZE) >= 7) && ((SIZE) <= 13))
+#define IS_AES_CCM_TAG_SIZE(SIZE)          (((SIZE) >= 4) && ((SIZE) <= 16) && (((SIZE) & 1) == 0))
+/**
+  * @}
+  */
+
+/** @defgroup AES_Random_Bit_Generator AES_Random_Bit_Generator
+  * @{
+  */
+#define AES_DRBG_SEED_SIZE                 ((uint32_t)32)         /*!< Bytes of key and V (seedlen) */
+#define AES_DRBG_ENTROPY_SIZE              ((uint32_t)32)         /*!< Entropy input bytes of a reseed through
+                                                                       GetEntropy, 128 bits at 4 bits per byte */
+#define AES_DRBG_MAX_REQUEST               ((uint32_t)0x00010000) /*!< Maximum number of bytes per request */
+#define AES_DRBG_RESEED_LIMIT              ((uint32_t)0x7FFFFFFF) /*!< Requests after which a reseed is required */
+/**
+  * @}
+  */
+
 /**
   * @}
   */
@@ -197,6 +269,40 @@ ErrorStatus AES_EncryptDecryptIT(uint8_t *pu8CrypInBuffPtr, uint16_t u16CrypInCo
 void AES_SetPendingConfigIT(void);
 void AES_SetResumeConfigIT(void);
 
+/***  Chaining modes functions *********************************/
+void AES_ModeInit(AES_ContextTypeDef* AES_Context, const uint8_t* Key, uint32_t KeySize);
+ErrorStatus AES_ECBCrypt(AES_ContextTypeDef* AES_Context, uint32_t AES_Operation, const uint8_t* Input,
+                         uint32_t Length, uint8_t* Output);
+ErrorStatus AES_CBCEncrypt(AES_ContextTypeDef* AES_Context, uint8_t* IV, const uint8_t* Input,
+                           uint32_t Length, uint8_t* Output);
+ErrorStatus AES_CBCDecrypt(AES_ContextTypeDef* AES_Context, uint8_t* IV, const uint8_t* Input,
+                           uint32_t Length, uint8_t* Output);
+ErrorStatus AES_CTRCrypt(AES_ContextTypeDef* AES_Context, uint8_t* Counter, const uint8_t* Input,
+                         uint32_t Length, uint8_t* Output);
+ErrorStatus AES_CMACCompute(AES_ContextTypeDef* AES_Context, const uint8_t* Input, uint32_t Length,
+                            uint8_t* Mac);
+ErrorStatus AES_CCMEncrypt(AES_ContextTypeDef* AES_Context, const uint8_t* Nonce, uint32_t NonceSize,
+                           const uint8_t* AData, uint32_t ADataLength, const uint8_t* Input,
+                           uint32_t Length, uint8_t* Output, uint8_t* Tag, uint32_t TagSize);
+ErrorStatus AES_CCMDecrypt(AES_ContextTypeDef* AES_Context, const uint8_t* Nonce, uint32_t NonceSize,
+                           const uint8_t* AData, uint32_t ADataLength, const uint8_t* Input,
+                           uint32_t Length, uint8_t* Output, const uint8_t* Tag, uint32_t TagSize);
+
+/***  Software model functions *********************************/
+void AES_ModelKeyInit(AES_ModelTypeDef* AES_Model, const uint8_t* Key, uint32_t KeySize);
+void AES_ModelEncrypt(const AES_ModelTypeDef* AES_Model, const uint8_t* Input, uint8_t* Output);
+void AES_ModelDecrypt(const AES_ModelTypeDef* AES_Model, const uint8_t* Input, uint8_t* Output);
+
+/***  Random bit generator functions *********************************/
+ErrorStatus AES_DRBGInstantiate(AES_DRBGTypeDef* AES_DRBG, const uint8_t* Entropy, uint32_t EntropyLength,
+                                const uint8_t* Nonce, uint32_t NonceLength, const uint8_t* Personal,
+                                uint32_t PersonalLength);
+ErrorStatus AES_DRBGReseed(AES_DRBGTypeDef* AES_DRBG, const uint8_t* Entropy, uint32_t EntropyLength,
+                           const uint8_t* AData, uint32_t ADataLength);
+ErrorStatus AES_DRBGGenerate(AES_DRBGTypeDef* AES_DRBG, uint8_t* Output, uint32_t Length,
+                             const uint8_t* AData, uint32_t ADataLength);
+void AES_DRBGUninstantiate(AES_DRBGTypeDef* AES_DRBG);
+
 
 
 /**
@@ -116,6 +116,41 @@ typedef struct
                                               This parameter can be set either to ENABLE or DISABLE. */
 } CAN_FilterInitTypeDef;
 
+/**
+  * @brief  CAN filter identifier range, input of CAN_FilterCompile()
+  */
+
+typedef struct
+{
+    uint32_t IdFirst;  /*!< Specifies the first identifier of the range.
+                            This parameter can be a value between 0 to 0x7FF for a standard
+                            identifier, 0 to 0x1FFFFFFF for an extended identifier. */
+
+    uint32_t IdLast;   /*!< Specifies the last identifier of the range, IdFirst for a single
+                            identifier. It must not be lower than IdFirst. */
+
+    uint8_t IDE;       /*!< Specifies the type of identifier.
+                            This parameter can be a value of @ref CAN_identifier_type */
+
+    uint8_t RTR;       /*!< Specifies the type of frame accepted.
+                            This parameter can be a value of @ref CAN_remote_transmission_request */
+} CAN_FilterRangeTypeDef;
+
+/**
+  * @brief  CAN filter compilation result
+  */
+
+typedef struct
+{
+    uint8_t NbBanks;    /*!< Number of filter banks generated */
+
+    uint32_t Requested; /*!< Number of frame identifiers in the requested set */
+
+    uint32_t Accepted;  /*!< Number of frame identifiers accepted by the generated banks.
+                             Accepted - Requested identifiers are false accepts, which are
+                             left to the software to reject. */
+} CAN_FilterResultTypeDef;
+
 /**
   * @brief  CAN Tx message structure definition
   */
@@ -174,6 +209,56 @@ typedef struct
                         the mailbox passes through. This parameter can be a
                         value between 0 to 0xFF */
 } CanRxMsg;
+
+/**
+  * @brief  CAN mailbox image, in the layout of the mailbox registers
+  */
+
+typedef struct
+{
+    uint32_t IR;     /*!< TIxR or RIxR: identifier, IDE and RTR */
+    uint32_t DTR;    /*!< TDTxR or RDTxR: DLC, FMI and time stamp */
+    uint32_t DLR;    /*!< TDLxR or RDLxR: data bytes 0 to 3 */
+    uint32_t DHR;    /*!< TDHxR or RDHxR: data bytes 4 to 7 */
+} CanMailbox;
+
+/**
+  * @brief  CAN queue monitor, called from CAN_QueueIRQHandler() with each frame
+  *         received or sent. In time triggered communication mode the TIME
+  *         field of Frame->DTR holds the frame time stamp.
+  * @param  Frame: frame received or sent.
+  * @param  Direction: a value of @ref CAN_queue_monitor
+  */
+typedef void (*CAN_QueueMonitor)(const CanMailbox* Frame, uint8_t Direction);
+
+/**
+  * @brief  CAN software queues
+  * @note   The RX ring is filled from the FIFO 0 and FIFO 1 message pending
+  *         interrupts. The TX queue is kept sorted by identifier priority and
+  *         refills the mailboxes from the transmit mailbox empty interrupt.
+  *         The buffers are provided by the application.
+  */
+
+typedef struct
+{
+    CanMailbox* pRxBuffer;       /*!< RX ring, RxSize frames */
+    uint16_t RxSize;             /*!< RX ring size, power of two */
+    __IO uint16_t RxHead;        /*!< Write index, owned by the interrupt */
+    __IO uint16_t RxTail;        /*!< Read index, owned by CAN_QueueReceive() */
+
+    CanMailbox* pTxBuffer;       /*!< TX queue, TxSize frames, the next frame to send last */
+    uint16_t TxSize;             /*!< TX queue size */
+    __IO uint16_t TxCount;       /*!< Number of frames in the TX queue */
+
+    __IO uint32_t RxFrames;      /*!< Frames stored in the RX ring */
+    __IO uint32_t RxDropped;     /*!< Frames lost because the RX ring was full */
+    __IO uint32_t RxOverrun;     /*!< Frames lost by a hardware FIFO overrun */
+    __IO uint32_t TxFrames;      /*!< Frames sent */
+    __IO uint32_t TxFailed;      /*!< Frames aborted or not acknowledged */
+    __IO uint32_t TxDropped;     /*!< Frames refused because the TX queue was full */
+
+    CAN_QueueMonitor Monitor;    /*!< Frame monitor, NULL if none */
+} CAN_QueueTypeDef;
 /**
   * @}
   */
@@ -371,6 +456,15 @@ typedef struct
   * @}
   */
 
+/** @defgroup CAN_queue_monitor CAN_queue_monitor
+  * @{
+  */
+#define CAN_Monitor_Rx              ((uint8_t)0x00)  /*!< Frame received */
+#define CAN_Monitor_Tx              ((uint8_t)0x01)  /*!< Frame sent */
+/**
+  * @}
+  */
+
 /** @defgroup CAN_transmit_constants CAN_transmit_constants
   * @{
   */
@@ -574,6 +668,9 @@ void CAN_DeInit(void);
 /* Initialization and Configuration functions *********************************/
 uint8_t CAN_Init(CAN_InitTypeDef* CAN_InitStruct);
 void CAN_FilterInit(CAN_FilterInitTypeDef* CAN_FilterInitStruct);
+void CAN_FilterCompile(const CAN_FilterRangeTypeDef* pRanges, uint32_t NbRanges, uint8_t FirstBank,
+                       uint8_t MaxBanks, uint8_t FIFO, CAN_FilterInitTypeDef* pFilters,
+                       CAN_FilterResultTypeDef* pResult);
 void CAN_StructInit(CAN_InitTypeDef* CAN_InitStruct);
 void CAN_DBGFreeze(FunctionalState NewState);
 void CAN_TTComModeCmd(FunctionalState NewState);
@@ -583,12 +680,22 @@ uint8_t CAN_Transmit(CanTxMsg* TxMessage);
 uint8_t CAN_TransmitStatus(uint8_t TransmitMailbox);
 uint16_t CAN_GetTransmitTimeStamp(uint8_t Mailbox);
 void CAN_CancelTransmit(uint8_t Mailbox);
+uint8_t CAN_QueueTransmit(CanTxMsg* TxMessage);
+uint16_t CAN_QueueTxPending(void);
 
 /* Receive functions **********************************************************/
 void CAN_Receive(uint8_t FIFONumber, CanRxMsg* RxMessage);
 void CAN_FIFORelease(uint8_t FIFONumber);
 uint8_t CAN_MessagePending(uint8_t FIFONumber);
 uint16_t CAN_GetReceiveTimeStamp(uint8_t FIFONumber);
+uint8_t CAN_QueueReceive(CanRxMsg* RxMessage);
+uint16_t CAN_QueueRxPending(void);
+
+/* Software queues functions **************************************************/
+void CAN_QueueInit(CAN_QueueTypeDef* Queue, CanMailbox* pRxBuffer, uint16_t RxSize,
+                   CanMailbox* pTxBuffer, uint16_t TxSize);
+void CAN_QueueSetMonitor(CAN_QueueMonitor Monitor);
+void CAN_QueueIRQHandler(void);
 
 /* Operation modes functions **************************************************/
 uint8_t CAN_OperatingModeRequest(uint8_t CAN_OperatingMode);
@@ -22,6 +22,31 @@ extern "C" {
   */
 
 /* Exported types ------------------------------------------------------------*/
+/** @defgroup CRC_Exported_Types CRC_Exported_Types
+  * @{
+  */
+
+/**
+  * @brief  CRC streaming context
+  * @note   The CRC is computed over a byte stream with the polynomial
+  *         0x04C11DB7. State is the running value, so that several streams
+  *         can share the CRC unit between calls of CRC_StreamUpdate().
+  */
+typedef struct
+{
+    uint32_t Init;                        /*!< Initial CRC value */
+    uint32_t XorOut;                      /*!< Value XORed with the final CRC */
+    FunctionalState ReflectInput;         /*!< ENABLE to process each byte LSB first */
+    FunctionalState ReflectOutput;        /*!< ENABLE to reverse the final CRC on 32 bits */
+    DMA_Channel_TypeDef* DMAy_Channelx;   /*!< DMA channel used for long buffers, NULL to
+                                               use the CPU only. Its clock must be enabled */
+    uint32_t State;                       /*!< Running CRC, set by CRC_StreamInit() */
+} CRC_ContextTypeDef;
+
+/**
+  * @}
+  */
+
 /* Exported constants --------------------------------------------------------*/
 /** @defgroup CRC_Exported_Constants CRC_Exported_Constants
   * @{
@@ -43,6 +68,15 @@ extern "C" {
   * @}
   */
 
+/** @defgroup CRC_Stream CRC_Stream
+  * @{
+  */
+#define CRC_STREAM_DMA_MIN_LENGTH           ((uint32_t)64)         /*!< Buffers shorter than this are fed by the CPU */
+#define CRC_STREAM_DMA_MAX_LENGTH           ((uint32_t)0xFFFF)     /*!< Maximum number of data of one DMA transfer */
+/**
+  * @}
+  */
+
 /**
   * @}
   */
@@ -68,6 +102,12 @@ uint32_t CRC_CalcCRC8bits(uint8_t CRC_Data);
 uint32_t CRC_CalcBlockCRC(uint32_t pBuffer[], uint32_t BufferLength);
 uint32_t CRC_GetCRC(void);
 
+/* CRC streaming computation **************************************************/
+void CRC_StreamInit(CRC_ContextTypeDef* CRC_Context);
+ErrorStatus CRC_StreamUpdate(CRC_ContextTypeDef* CRC_Context, const uint8_t* pData, uint32_t Length);
+void CRC_StreamUpdateSoft(CRC_ContextTypeDef* CRC_Context, const uint8_t* pData, uint32_t Length);
+uint32_t CRC_StreamFinal(CRC_ContextTypeDef* CRC_Context);
+
 /* Independent register (IDR) access (write/read) *****************************/
 void CRC_SetIDRegister(uint8_t CRC_IDValue);
 uint8_t CRC_GetIDRegister(void);
@@ -48,6 +48,43 @@ typedef struct
                                                   This parameter can be a value of @ref DAC_output_buffer */
 } DAC_InitTypeDef;
 
+/**
+  * @brief  DAC waveform generator: samples synthesized from a table by a
+  *         phase accumulator into a circular buffer, written to the DAC by
+  *         DMA_Channel2 at each trigger.
+  */
+typedef struct
+{
+    uint32_t DAC_Trigger;                     /*!< Timer trigger of the samples, a value of @ref DAC_trigger_selection
+                                                 other than DAC_Trigger_None and DAC_Trigger_Software */
+    uint32_t SampleRate;                      /*!< Trigger frequency in Hz, converts the frequencies to phase increments */
+    uint16_t* Buffer;                         /*!< Circular buffer of 2 * BlockLength samples, 12 bits right aligned */
+    uint16_t BlockLength;                     /*!< Samples per half buffer */
+    const uint16_t* Table;                    /*!< One period of the waveform, 2^TableBits samples of 12 bits */
+    uint8_t TableBits;                        /*!< log2 of the table length, 1 to DAC_WAVE_TABLE_BITS_MAX */
+    uint32_t Phase;                           /*!< Phase accumulator, 2^32 is one period */
+    uint32_t Increment;                       /*!< Phase increment per sample */
+    int32_t ChirpStep;                        /*!< Increment change per sample, 0 at a fixed frequency */
+    uint32_t ChirpStart;                      /*!< Increment at the start of the sweep */
+    uint32_t ChirpStop;                       /*!< Increment at the end of the sweep */
+    uint8_t ChirpRepeat;                      /*!< Nonzero to restart the sweep at ChirpStart, 0 to hold ChirpStop */
+    const uint16_t* NextTable;                /*!< Table requested by DAC_WaveSetTable(), internal use */
+    uint8_t NextTableBits;                    /*!< Table length requested by DAC_WaveSetTable(), internal use */
+    __IO uint8_t TableUpdate;                 /*!< NextTable to apply at the next half buffer, internal use */
+    __IO uint8_t FrequencyUpdate;             /*!< Next frequency or sweep to apply at the next half buffer, internal use */
+    uint8_t NextChirpRepeat;                  /*!< Requested ChirpRepeat, internal use */
+    uint32_t NextIncrement;                   /*!< Requested Increment, internal use */
+    int32_t NextChirpStep;                    /*!< Requested ChirpStep, internal use */
+    uint32_t NextChirpStop;                   /*!< Requested ChirpStop, internal use */
+    uint32_t HalfPhase[2];                    /*!< Phase of the first sample of each half buffer, internal use */
+    uint32_t HalfIncrement[2];                /*!< Increment of each half buffer, internal use */
+    const uint16_t* HalfTable[2];             /*!< Table of each half buffer, NULL if not reusable, internal use */
+    __IO uint32_t Blocks;                     /*!< Half buffers synthesized */
+    __IO uint32_t Reused;                     /*!< Half buffers replayed without synthesis */
+    __IO uint32_t Lost;                       /*!< Half buffers played again before they were synthesized */
+    __IO uint32_t Underruns;                  /*!< DAC DMA underruns, triggers without a new sample */
+} DAC_WaveTypeDef;
+
 /**
   * @}
   */
@@ -213,6 +250,17 @@ typedef struct
   * @}
   */
 
+/** @defgroup DAC_Wave_Table  DAC waveform table
+  * @{
+  */
+
+#define DAC_WAVE_TABLE_BITS_MAX            16     /*!< Longest table of the waveform generator, 65536 samples */
+#define DAC_WAVE_SAMPLE_MAX                0x0FFF /*!< Largest 12 bits sample */
+#define IS_DAC_WAVE_TABLE_BITS(BITS) (((BITS) >= 1) && ((BITS) <= DAC_WAVE_TABLE_BITS_MAX))
+/**
+  * @}
+  */
+
 /** @defgroup DAC_interrupts_definition   DAC interrupts definition
   * @{
   */
@@ -259,6 +307,20 @@ void DAC_ClearFlag(uint32_t DAC_FLAG);
 ITStatus DAC_GetITStatus(uint32_t DAC_IT);
 void DAC_ClearITPendingBit( uint32_t DAC_IT);
 
+/* Waveform generator functions ***********************************************/
+ErrorStatus DAC_WaveInit(DAC_WaveTypeDef* Wave);
+void DAC_WaveStart(DAC_WaveTypeDef* Wave);
+void DAC_WaveStop(DAC_WaveTypeDef* Wave);
+uint32_t DAC_WaveFrequencyToIncrement(uint32_t SampleRate, uint32_t Frequency);
+void DAC_WaveSetFrequency(DAC_WaveTypeDef* Wave, uint32_t Frequency);
+void DAC_WaveSetChirp(DAC_WaveTypeDef* Wave, uint32_t StartFrequency, uint32_t StopFrequency,
+                      uint32_t Samples, FunctionalState Repeat);
+void DAC_WaveSetTable(DAC_WaveTypeDef* Wave, const uint16_t* Table, uint8_t TableBits);
+void DAC_WaveSynthSine(uint16_t* Table, uint8_t TableBits, uint16_t Amplitude, uint16_t Offset);
+void DAC_WaveSynthResample(uint16_t* Table, uint8_t TableBits, const uint16_t* Points, uint32_t NbPoints);
+void DAC_WaveFill(DAC_WaveTypeDef* Wave, uint16_t* Block, uint32_t Length);
+void DAC_WaveIRQHandler(DAC_WaveTypeDef* Wave);
+
 #ifdef __cplusplus
 }
 #endif
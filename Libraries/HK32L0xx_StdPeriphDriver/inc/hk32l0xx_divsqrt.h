@@ -39,24 +39,24 @@ extern "C" {
 #define DVSQ_BUSY_DIV                               ((uint32_t)0xC0000000)                /* The accelerator is busy and is doing division */
 
 /* Configure the startup mode of the DVSQ division operation */
-#define DVSQ_EnableDivFastStart()                   DIVSQRT->CSR &= ~DVSQ_CSR_DFS         /* Enable the quick division function */
-#define DVSQ_DisableDivFastStart()                  DIVSQRT->CSR |= DVSQ_CSR_DFS          /* Disable the quick division function */
+#define DVSQ_EnableDivFastStart()                   DVSQ->CSR &= ~DVSQ_CSR_DFS            /* Enable the quick division function */
+#define DVSQ_DisableDivFastStart()                  DVSQ->CSR |= DVSQ_CSR_DFS             /* Disable the quick division function */
 
 /* Configures whether the DVSQ division is signed */
-#define DVSQ_ConfigDivUnsigned()                    DIVSQRT->CSR |= DVSQ_CSR_UNSIGN_DIV   /* Configure the DVSQ to perform unsigned division mode */
-#define DVSQ_ConfigDivSigned()                      DIVSQRT->CSR &= ~DVSQ_CSR_UNSIGN_DIV  /* Configure the DVSQ to perform signed division mode */
+#define DVSQ_ConfigDivUnsigned()                    DVSQ->CSR |= DVSQ_CSR_UNSIGN_DIV      /* Configure the DVSQ to perform unsigned division mode */
+#define DVSQ_ConfigDivSigned()                      DVSQ->CSR &= ~DVSQ_CSR_UNSIGN_DIV     /* Configure the DVSQ to perform signed division mode */
 
 /* Configure the accuracy of DVSQ square operation */
-#define DVSQ_ConfigSqrtPresHigh()                   DIVSQRT->CSR |= DVSQ_CSR_HPRESQRT    /* Configure DVSQ as high precision square operation mode */
-#define DVSQ_ConfigSqrtPresNormal()                 DIVSQRT->CSR &= ~DVSQ_CSR_HPRESQRT    /* Set DVSQ to the common precision square operation mode */
+#define DVSQ_ConfigSqrtPresHigh()                   DVSQ->CSR |= DVSQ_CSR_HPRESQRT       /* Configure DVSQ as high precision square operation mode */
+#define DVSQ_ConfigSqrtPresNormal()                 DVSQ->CSR &= ~DVSQ_CSR_HPRESQRT       /* Set DVSQ to the common precision square operation mode */
 
 /* When DVSQ_CSR_DFS in THE CSR is 1, the software starts the division operation.
 When the bit is 0, the hardware automatically starts the division operation after
 the value is written into the divisor register */
-#define DVSQ_StartDivCalc()                         DIVSQRT->CSR |= DVSQ_CSR_DIV_SRT      /* Let's do division */
+#define DVSQ_StartDivCalc()                         DVSQ->CSR |= DVSQ_CSR_DIV_SRT         /* Let's do division */
 
 /* DVSQ busy status query */
-#define DVSQ_IsBusy()                               ((DIVSQRT->CSR & DVSQ_CSR_BUSY)? 1:0) /* Return '1' to indicate busy; Return '0' for idle */
+#define DVSQ_IsBusy()                               ((DVSQ->CSR & DVSQ_CSR_BUSY)? 1:0)    /* Return '1' to indicate busy; Return '0' for idle */
 
 /* DVSQ waits idle */
 #if (DVSQ_BUSY_WAIT_EN == 1)
@@ -64,6 +64,13 @@ the value is written into the divisor register */
 #else
 #define DVSQ_Wait()
 #endif
+
+/* Start an operation without waiting for the result. DVSQ must be idle, the
+division mode must be configured with DVSQ_ConfigDivUnsigned()/DVSQ_ConfigDivSigned()
+and the division fast start enabled */
+#define DVSQ_StartDiv(Dividend, Divisor)            do { DVSQ->DIVIDEND = (uint32_t)(Dividend); \
+                                                         DVSQ->DIVISOR = (uint32_t)(Divisor); } while (0)
+#define DVSQ_StartSqrt(Radicand)                    (DVSQ->RADICAND = (uint32_t)(Radicand))
 /**
   * @}
   */
@@ -71,6 +78,32 @@ the value is written into the divisor register */
   * @}
   */
 
+/* Exported inline functions ------------------------------------------------ */
+/**
+  * @brief  Wait for the operation started by DVSQ_StartDiv() or DVSQ_StartSqrt()
+  *         and return its result.
+  * @note   Work can be done between the start and the fetch to hide the DVSQ
+  *         latency. An interrupt which uses DVSQ this way must not preempt
+  *         other users of DVSQ, or must save and restore the operation.
+  * @retval The quotient, or the square root
+  */
+__STATIC_INLINE uint32_t DVSQ_FetchResult(void)
+{
+    DVSQ_Wait();
+    return DVSQ->RES;
+}
+
+/**
+  * @brief  Wait for the division started by DVSQ_StartDiv() and return its
+  *         remainder.
+  * @retval The remainder
+  */
+__STATIC_INLINE uint32_t DVSQ_FetchRemainder(void)
+{
+    DVSQ_Wait();
+    return DVSQ->REMAINDER;
+}
+
 /* Exported functions ------------------------------------------------------- */
 void DVSQ_Init(void);
 void DVSQ_DeInit(void);
@@ -78,6 +111,14 @@ uint32_t DVSQ_Sqrt(uint32_t u32Radicand);
 uint16_t DVSQ_SqrtH(uint32_t u32Radicand, uint16_t *fraction);
 int32_t DVSQ_Divsion(int32_t i32Dividend, int32_t i32Divisor, int32_t *i32pRemainder);
 uint32_t DVSQ_UDivsion(uint32_t u32Dividend, uint32_t u32Divisor, uint32_t *u32pRemainder);
+void DVSQ_UDivsionVector(const uint32_t *pDividend, const uint32_t *pDivisor,
+                         uint32_t *pQuotient, uint32_t *pRemainder, uint32_t Count);
+void DVSQ_DivsionVector(const int32_t *pDividend, const int32_t *pDivisor,
+                        int32_t *pQuotient, int32_t *pRemainder, uint32_t Count);
+void DVSQ_SqrtVector(const uint32_t *pRadicand, uint32_t *pResult, uint32_t Count);
+void DVSQ_SqrtHVector(const uint32_t *pRadicand, uint32_t *pResult, uint32_t Count);
+uint32_t DVSQ_ModelSqrt(uint32_t Radicand);
+uint16_t DVSQ_ModelSqrtH(uint32_t Radicand, uint16_t *fraction);
 
 #ifdef __cplusplus
 }
@@ -68,6 +68,42 @@ typedef struct
     int16_t qV_Component2;
 } Volt_Components;
 
+/**
+  * @brief  Input sample of the EMACC chain, used by the batch calculation
+  */
+typedef struct
+{
+    int16_t hElAngle;                /**< Electric angle, 0x8000 is -PI */
+    Curr_Components Iab;             /**< Current of the A and B phases */
+} EMACC_Sample;
+
+/**
+  * @brief  Callback called with the result of a calculation started by
+  *         EMACC_StartCal()
+  */
+typedef void (*EMACC_CalCallback)(Volt_Components Valphabeta);
+
+/**
+  * @brief  State of the EMACC software model
+  * @note   The stage results of the last EMACC_ModelCal() are kept so that
+  *         they can be compared with the EMACC_GetXxx() hardware results.
+  */
+typedef struct
+{
+    EMACC_PI_InitTypeDef PI_D;       /**< PI configuration of the D axis */
+    EMACC_PI_InitTypeDef PI_Q;       /**< PI configuration of the Q axis */
+    int32_t  wIntegralTermD;         /**< Integral term of the D axis PI */
+    int32_t  wIntegralTermQ;         /**< Integral term of the Q axis PI */
+    uint16_t hMaxModule;             /**< Circle limitation maximum module */
+    uint16_t hStartIndex;            /**< Circle limitation table start index */
+    int16_t  hCos;                   /**< CORDIC stage result */
+    int16_t  hSin;                   /**< CORDIC stage result */
+    Curr_Components Ialphabeta;      /**< Clarke stage result */
+    Curr_Components Iqd;             /**< Park stage result, Component1 is Iq */
+    Volt_Components Vqd;             /**< PI stage result after circle limitation,
+                                          Component1 is Vq */
+} EMACC_ModelTypeDef;
+
 /**
   * @}
   */
@@ -171,6 +207,22 @@ void EMACC_Cmd(uint32_t EMACC_Module, FunctionalState NewState);
 
 /*** EMACC Calculate functions*********************************/
 Volt_Components EMACC_Cal(int16_t hElAngle, Curr_Components Iab, Curr_Components Iqdref);
+void EMACC_SetIdRef(int16_t hIdref);
+void EMACC_SetIqRef(int16_t hIqref);
+void EMACC_SetIqdRef(Curr_Components Iqdref);
+void EMACC_StartCal(int16_t hElAngle, Curr_Components Iab);
+Volt_Components EMACC_GetCalResult(void);
+void EMACC_SetCalCallback(EMACC_CalCallback Callback);
+void EMACC_CalPoll(void);
+void EMACC_CalBatch(const EMACC_Sample* pSample, Curr_Components Iqdref,
+                    Volt_Components* pValphabeta, uint32_t Count);
+uint32_t EMACC_GetCalBatchCount(void);
+
+/*** EMACC Software model functions*********************************/
+void EMACC_ModelInit(EMACC_ModelTypeDef* Model, EMACC_PI_InitTypeDef* EMACC_ID_InitStruct,
+                     EMACC_PI_InitTypeDef* EMACC_IQ_InitStruct);
+Volt_Components EMACC_ModelCal(EMACC_ModelTypeDef* Model, int16_t hElAngle,
+                               Curr_Components Iab, Curr_Components Iqdref);
 
 /*** EMACC Results functions*********************************/
 void EMACC_SetClarke(uint16_t Ia, uint16_t Ib);
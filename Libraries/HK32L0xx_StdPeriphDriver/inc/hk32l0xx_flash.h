@@ -313,6 +313,34 @@ typedef struct
   */
 
 /* Exported macro ------------------------------------------------------------*/
+/** @defgroup FLASH_RAM_Function FLASH_RAM_Function
+  * @brief    Places a function in SRAM. The functions marked with it keep running
+  *           while the flash is busy: fetching from the flash stalls the CPU
+  *           until the ongoing erase or program operation ends.
+  * @note     MDK-ARM: the ".RamFunc" section must be placed in an SRAM execution
+  *           region of the scatter file, "*(.RamFunc)" in RW_IRAM1 as in the
+  *           FLASH_ProgramBufferIT example. Without it the functions run from
+  *           the flash and stall during each operation.
+  *           EWARM: handled by __ramfunc, no linker change needed.
+  *           GCC: the ".RamFunc" section is copied with .data by
+  *           hk32l0xx_flash.ld and GCC_Startup_hk32l0xx.s (CMSIS Source/GCC).
+  * @{
+  */
+#ifndef FLASH_RAMFUNC
+#if defined (__CC_ARM) || defined (__ARMCC_VERSION)
+#define FLASH_RAMFUNC       __attribute__((section(".RamFunc")))
+#elif defined (__ICCARM__)
+#define FLASH_RAMFUNC       __ramfunc
+#elif defined (__GNUC__)
+#define FLASH_RAMFUNC       __attribute__((section(".RamFunc"), long_call, noinline))
+#else
+#define FLASH_RAMFUNC
+#endif
+#endif /* FLASH_RAMFUNC */
+/**
+  * @}
+  */
+
 /* Exported functions ------------------------------------------------------- */
 /** @defgroup FLASH_Exported_Functions FLASH_Exported_Functions
   * @{
@@ -329,6 +357,10 @@ FLASH_Status FLASH_ErasePage(uint32_t Page_Address);
 FLASH_Status FLASH_HalfErasePage(uint32_t Page_Address);
 FLASH_Status FLASH_EraseAllPages(void);
 FLASH_Status FLASH_ProgramWord(uint32_t Address, uint32_t Data);
+FLASH_RAMFUNC FLASH_Status FLASH_ProgramBuffer(uint32_t Address, const uint32_t* pData, uint32_t NbWords);
+FLASH_Status FLASH_ProgramBufferIT(uint32_t Address, const uint32_t* pData, uint32_t NbWords);
+FLASH_RAMFUNC void FLASH_ProgramBufferIRQHandler(void);
+FLASH_RAMFUNC FLASH_Status FLASH_GetProgramBufferStatus(void);
 /* FLASH Option Bytes Programming functions *****************************************/
 void FLASH_OptionByteUnlock(void);
 void FLASH_OptionByteLock(void);
@@ -21,6 +21,16 @@ extern "C" {
   * @{
   */
 
+/** @defgroup MISC_Shared_Vector_Size MISC_Shared_Vector_Size
+  * @{
+  */
+#ifndef NVIC_SHARED_SOURCES_MAX
+#define NVIC_SHARED_SOURCES_MAX      4       /*!< Sources of a shared vector, DMA_CH4_7 has 4 */
+#endif
+/**
+  * @}
+  */
+
 /* Exported types ------------------------------------------------------------*/
 /** @defgroup MISC_Exported_Types MISC_Exported_Types
   * @{
@@ -39,6 +49,31 @@ typedef struct
                                             will be enabled or disabled.This parameter can be set either to
                                             ENABLE or DISABLE */
 } NVIC_InitTypeDef;
+
+/**
+  * @brief  Interrupt source of a shared vector
+  */
+typedef struct
+{
+    void (*Handler)(void);              /*!< Called when the source is pending */
+    __I uint32_t* Status;               /*!< Status register of the source, NULL to call Handler
+                                             on every interrupt of the vector */
+    uint32_t Mask;                      /*!< Bits of Status telling the source is pending */
+    uint32_t Count;                     /*!< Calls of Handler */
+    uint32_t MaxCycles;                 /*!< Longest call of Handler, in SysTick counts,
+                                             0 while SysTick is stopped */
+} NVIC_SharedSourceTypeDef;
+
+/**
+  * @brief  Handler table of a shared vector, in RAM
+  */
+typedef struct
+{
+    NVIC_SharedSourceTypeDef Source[NVIC_SHARED_SOURCES_MAX]; /*!< Sources, in the order they are served */
+    uint8_t NbSources;                  /*!< Sources registered */
+    uint32_t Count;                     /*!< Interrupts dispatched */
+    uint32_t Spurious;                  /*!< Interrupts without any source pending */
+} NVIC_SharedVectorTypeDef;
 /**
   * @}
   */
@@ -81,6 +116,19 @@ typedef struct
   * @}
   */
 
+/** @defgroup MISC_Shared_Vectors MISC_Shared_Vectors
+  * @{
+  */
+#define IS_NVIC_SHARED_IRQ(IRQ)      (((IRQ) == DMA_CH4_7_IRQn)      || \
+                                      ((IRQ) == ADC_COMP1_2_IRQn)    || \
+                                      ((IRQ) == UART3_4_IRQn)        || \
+                                      ((IRQ) == AES_TRNG_EMACC_IRQn) || \
+                                      ((IRQ) == LCD_CAN_IRQn)        || \
+                                      ((IRQ) == USB_DVSQ_IRQn))
+/**
+  * @}
+  */
+
 /**
   * @}
   */
@@ -93,6 +141,13 @@ typedef struct
 void NVIC_Init(NVIC_InitTypeDef* NVIC_InitStruct);
 void NVIC_SystemLPConfig(uint8_t LowPowerMode, FunctionalState NewState);
 void SysTick_CLKSourceConfig(uint32_t SysTick_CLKSource);
+
+/* Shared vector functions ****************************************************/
+void NVIC_SharedInit(NVIC_SharedVectorTypeDef* Vector, IRQn_Type IRQn);
+ErrorStatus NVIC_SharedRegister(NVIC_SharedVectorTypeDef* Vector, void (*Handler)(void),
+                                __I uint32_t* Status, uint32_t Mask);
+void NVIC_SharedDispatch(IRQn_Type IRQn);
+void NVIC_SharedResetStats(NVIC_SharedVectorTypeDef* Vector);
 /**
   * @}
   */
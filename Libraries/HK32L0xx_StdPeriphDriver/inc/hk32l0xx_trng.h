@@ -73,6 +73,22 @@ typedef struct
   * @}
   */
 
+/** @defgroup TRNG_Exported_Constants_Group3  Entropy pool definition
+  * @{
+  */
+#ifndef TRNG_POOL_SIZE
+#define TRNG_POOL_SIZE              64      /*!< Words of the pool, power of two */
+#endif
+
+#define TRNG_POOL_STARTUP_WORDS     256     /*!< Words tested before the first one is kept (1024 samples) */
+#define TRNG_POOL_RCT_CUTOFF        6       /*!< Repetition count test cutoff: 1 + 20 / H, H = 4 bits per byte */
+#define TRNG_POOL_APT_WINDOW        512     /*!< Adaptive proportion test window, in byte samples */
+#define TRNG_POOL_APT_CUTOFF        62      /*!< Adaptive proportion test cutoff for H = 4, alpha = 2^-20 */
+#define TRNG_POOL_MAX_FAILURES      3       /*!< Failures in a row before the pool stops for good */
+/**
+  * @}
+  */
+
 
 /**
   * @}
@@ -87,6 +103,37 @@ typedef struct
   * @}
   */
 
+/** @defgroup TRNG_Pool_Types  TRNG_Pool_Types
+  * @{
+  */
+
+/**
+  * @brief  Entropy pool: TRNG words that passed the health tests, written by
+  *         AES_TRNG_IRQHandler() and read by TRNG_PoolGet().
+  */
+typedef struct
+{
+    uint32_t Buffer[TRNG_POOL_SIZE];    /*!< Words kept, read once */
+    __IO uint32_t Head;                 /*!< Words written, by the interrupt */
+    __IO uint32_t Tail;                 /*!< Words read */
+    __IO uint32_t Flush;                /*!< Words written before a failure, never read */
+    __IO uint8_t Running;               /*!< Conversions running, stopped when the pool is full */
+    __IO uint8_t Error;                 /*!< TRNG_POOL_MAX_FAILURES failures in a row, pool stopped */
+    uint8_t Failures;                   /*!< Failures since the last complete startup test */
+    uint8_t RctSample;                  /*!< Repetition count test: last sample */
+    uint8_t RctCount;                   /*!< Repetition count test: occurrences in a row */
+    uint8_t AptSample;                  /*!< Adaptive proportion test: first sample of the window */
+    uint16_t AptCount;                  /*!< Adaptive proportion test: occurrences of AptSample */
+    uint16_t AptIndex;                  /*!< Adaptive proportion test: samples of the window */
+    uint32_t Startup;                   /*!< Words to test before the next one is kept */
+    uint32_t Words;                     /*!< Words kept */
+    uint32_t HealthFailures;            /*!< Repetition count and adaptive proportion test failures */
+    uint32_t SeedErrors;                /*!< Seed errors reported by the TRNG */
+} TRNG_PoolTypeDef;
+/**
+  * @}
+  */
+
 /* Initialization and Configuration functions *********************************/
 void TRNG_Init(TRNG_InitTypeDef *TRNG_InitStruct);
 void TRNG_DeInit(void);
@@ -98,6 +145,14 @@ FlagStatus TRNG_GetFlagStatus(uint32_t TRNG_FLAG);
 void TRNG_ClearFlag(uint32_t TRNG_FLAG);
 ITStatus TRNG_GetITStatus(uint32_t TRNG_IT);
 void TRNG_ClearITPendingBit(uint32_t TRNG_IT);
+
+/* Entropy pool functions *****************************************************/
+void TRNG_PoolInit(TRNG_PoolTypeDef* Pool);
+ErrorStatus TRNG_PoolAdd(TRNG_PoolTypeDef* Pool, uint32_t Sample);
+ErrorStatus TRNG_PoolRead(TRNG_PoolTypeDef* Pool, uint8_t* pData, uint32_t Length);
+uint32_t TRNG_PoolGetCount(TRNG_PoolTypeDef* Pool);
+void TRNG_PoolStart(TRNG_PoolTypeDef* Pool);
+ErrorStatus TRNG_PoolGet(TRNG_PoolTypeDef* Pool, uint8_t* pData, uint32_t Length);
 void AES_TRNG_IRQHandler(void);
 
 
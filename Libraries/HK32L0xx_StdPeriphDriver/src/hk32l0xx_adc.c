@@ -60,6 +60,14 @@
 
 /* Calibration time out */
 #define CALIBRATION_TIMEOUT        ((uint32_t)0x0000F000)
+
+/* ADC ready and stop time out of the continuous acquisition */
+#define STREAM_TIMEOUT             ((uint32_t)0x0000F000)
+
+/* Bounds of the calibration factors: a 12 bits sample times the scale plus
+   the offset stays below 2^30 */
+#define CALIB_SLOPE_MAX            ((uint32_t)0x0FFFFFFF / 0xFFF)
+#define CALIB_OFFSET_MAX           ((uint32_t)0x0FFFFFFF)
 /**
   * @}
   */
@@ -1285,7 +1293,7 @@ void ADC_OverSamplingCmd(ADC_TypeDef* ADCx, FunctionalState NewState)
     else
     {
         /* Reset the OVSE to Disable the ADC oversampling */
-        ADCx->CFGR2 |= (uint32_t)ADC_OVS_DISABLE;
+        ADCx->CFGR2 &= (uint32_t)(~ADC_OVS_ENABLE);
     }
 }
 
@@ -1313,8 +1321,8 @@ void ADC_OverSamplingDiscontCmd(ADC_TypeDef* ADCx, FunctionalState NewState)
     }
     else
     {
-        /* Reset the OVSE to Disable the ADC oversampling discontinuous mode */
-        ADCx->CFGR2 |= (uint32_t)ADC_OVS_CONT;
+        /* Reset the TOVS to Disable the ADC oversampling discontinuous mode */
+        ADCx->CFGR2 &= (uint32_t)(~ADC_OVS_DISCONT);
     }
 }
 
@@ -1355,6 +1363,8 @@ void ADC_ConfigOverSamplingRatioShift(ADC_TypeDef *ADCx, uint32_t Ratio, uint32_
     assert_param(IS_ADC_ALL_PERIPH(ADCx));
     assert_param(IS_ADC_OVS_RATIO(Ratio));
     assert_param(IS_ADC_OVS_SHIFT(Shift));
+    /* Clear the previous Ratio and Shift */
+    ADCx->CFGR2 &= (uint32_t)(~(ADC_CFGR2_OVSR | ADC_CFGR2_OVSS));
     /* Set oversampling Ratio */
     ADCx->CFGR2 |= (uint32_t)Ratio;
     /* Set oversampling Shift */
@@ -1565,6 +1575,485 @@ void ADC_ConfigADCGainSel(ADC_TypeDef *ADCx, uint32_t GAIN_SEL1, uint32_t GAIN_S
   * @}
   */
 
+/** @defgroup ADC_Group8 Continuous acquisition functions
+ *  @brief   Timer triggered multi-channel acquisition through a circular DMA
+ *
+@verbatim
+ ===============================================================================
+          ##### Continuous acquisition functions #####
+ ===============================================================================
+    [..] A timer trigger starts a scan of the channels of ADC_Channels, in
+         increasing channel number. The DMA writes the conversions into a
+         circular buffer of two halves of BlockLength scans each, so that the
+         ADC runs at its full rate without any CPU work per sample.
+    [..] ADC_StreamIRQHandler(), called from the IRQ handler of the DMA
+         channel, hands over each half as soon as it is complete, while the
+         DMA fills the other one:
+         (+) with Output set, the half is first de-interleaved into Output,
+             BlockLength samples of the first channel, then of the second...
+             ADC_StreamGetIndex() gives the position of a channel;
+         (+) with Output NULL, BlockCallback receives the interleaved half.
+         BlockCallback must return before the other half is complete, a half
+         overwritten before it was delivered is counted in Lost.
+    [..] An overrun stops the DMA requests of the ADC. ADC_StreamIRQHandler(),
+         also called from the ADC interrupt, counts it in Overruns and starts
+         the acquisition again at the beginning of the buffer: the half being
+         filled is dropped and the scans stay aligned.
+    [..] With ADC_OverSamplingRatio set, each trigger converts every channel
+         ratio times and the DMA receives the shifted sum: the rate of the
+         stream is the trigger rate, the hardware does the averaging.
+    [..] Use:
+         (#) Enable the ADC, DMA and timer clocks, configure the analog pins.
+         (#) Fill an ADC_StreamTypeDef and call ADC_StreamInit() with the
+             ADC disabled.
+         (#) Enable the DMA channel and ADC_COMP1_2 interrupts in the NVIC,
+             call ADC_StreamIRQHandler() from both IRQ handlers.
+         (#) Call ADC_StreamStart(), then start the timer with its TRGO
+             output on the update event.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Configures the ADC and the DMA channel of a continuous acquisition.
+  * @note   The ADC must be disabled; it is calibrated, enabled and waits for
+  *         ADC_StreamStart(). The ADC resolution is 12 bits, right aligned.
+  *         The overrun interrupt of the ADC is enabled.
+  * @param  ADCx: Select the ADC peripheral,This parameter can be ADC.
+  * @param  Stream: pointer to the acquisition, its Buffer holds
+  *         2 * BlockLength * (number of channels) half words, 0xFFFF at most.
+  * @retval SUCCESS, or ERROR if a parameter of Stream is not valid or the
+  *         ADC did not get ready.
+  */
+ErrorStatus ADC_StreamInit(ADC_TypeDef* ADCx, ADC_StreamTypeDef* Stream)
+{
+    DMA_InitTypeDef DMA_InitStructure;
+    uint32_t channels = Stream->ADC_Channels;
+    uint32_t timeout = 0;
+
+    /* Check the parameters */
+    assert_param(IS_ADC_ALL_PERIPH(ADCx));
+    assert_param(IS_ADC_CHANNEL(Stream->ADC_Channels));
+    assert_param(IS_ADC_SAMPLE_TIME(Stream->ADC_SampleTime));
+    assert_param(IS_ADC_EXTERNAL_TRIG_CONV(Stream->ADC_ExternalTrigConv));
+    assert_param(IS_ADC_EXT_TRIG_EDGE(Stream->ADC_ExternalTrigConvEdge));
+    assert_param((Stream->DMA_Channel == DMA_Channel1) || (Stream->DMA_Channel == DMA_Channel2));
+
+    Stream->NbChannels = 0;
+
+    while (channels != 0)
+    {
+        channels &= channels - 1;
+        Stream->NbChannels++;
+    }
+
+    Stream->Blocks = 0;
+    Stream->Lost = 0;
+    Stream->Overruns = 0;
+
+    /* The DMA counter holds the two blocks of all the channels */
+    if ((Stream->NbChannels == 0) || (Stream->BlockLength == 0) ||
+            ((2 * (uint32_t)Stream->BlockLength * Stream->NbChannels) > 0xFFFF))
+    {
+        return ERROR;
+    }
+
+    /* Triggered scans, upward, 12 bits right aligned, circular DMA requests once calibrated */
+    ADCx->CFGR1 = (uint32_t)(Stream->ADC_ExternalTrigConvEdge | Stream->ADC_ExternalTrigConv |
+                             ADC_ScanDirection_Upward | ADC_DMAMode_Circular);
+    ADCx->CHSELR = Stream->ADC_Channels;
+    ADCx->SMPR = Stream->ADC_SampleTime;
+
+    /* Oversampling of each channel, all the conversions from one trigger */
+    ADCx->CFGR2 &= (uint32_t)(~(ADC_CFGR2_OVSE | ADC_CFGR2_TOVS | ADC_CFGR2_OVSR | ADC_CFGR2_OVSS));
+
+    if (Stream->ADC_OverSamplingRatio != ADC_STREAM_OVS_NONE)
+    {
+        ADC_ConfigOverSamplingRatioShift(ADCx, Stream->ADC_OverSamplingRatio, Stream->ADC_OverSamplingShift);
+        ADC_OverSamplingCmd(ADCx, ENABLE);
+    }
+
+    /* DMA channel remapped to the ADC, half transfer and transfer complete interrupts */
+    DMA_RemapConfig(DMA, (Stream->DMA_Channel == DMA_Channel1) ? DMA_CSELR_CH1_ADC : DMA_CSELR_CH2_ADC);
+    DMA_DeInit(Stream->DMA_Channel);
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&ADCx->DR;
+    DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)Stream->Buffer;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
+    DMA_InitStructure.DMA_BufferSize = 2 * (uint32_t)Stream->BlockLength * Stream->NbChannels;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_HalfWord;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Circular;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_VeryHigh;
+    DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init(Stream->DMA_Channel, &DMA_InitStructure);
+    DMA_ITConfig(Stream->DMA_Channel, DMA_IT_HT | DMA_IT_TC, ENABLE);
+
+    /* Calibration with the ADC and its DMA requests disabled, then enable */
+    ADC_GetCalibrationFactor(ADCx);
+    ADC_DMACmd(ADCx, ENABLE);
+    ADC_ClearFlag(ADCx, ADC_FLAG_ADRDY | ADC_FLAG_OVR);
+    ADC_ITConfig(ADCx, ADC_IT_OVR, ENABLE);
+    ADC_Cmd(ADCx, ENABLE);
+
+    while ((ADC_GetFlagStatus(ADCx, ADC_FLAG_ADRDY) == RESET) && (timeout != STREAM_TIMEOUT))
+    {
+        timeout++;
+    }
+
+    return (timeout != STREAM_TIMEOUT) ? SUCCESS : ERROR;
+}
+
+/**
+  * @brief  Starts a continuous acquisition: the ADC waits for the triggers.
+  * @param  ADCx: Select the ADC peripheral,This parameter can be ADC.
+  * @param  Stream: pointer to the acquisition initialized by ADC_StreamInit().
+  * @retval None
+  */
+void ADC_StreamStart(ADC_TypeDef* ADCx, ADC_StreamTypeDef* Stream)
+{
+    /* Check the parameters */
+    assert_param(IS_ADC_ALL_PERIPH(ADCx));
+
+    /* The DMA starts at the beginning of the buffer */
+    DMA_Cmd(Stream->DMA_Channel, DISABLE);
+    DMA_SetCurrDataCounter(Stream->DMA_Channel, 2 * Stream->BlockLength * Stream->NbChannels);
+    DMA_ClearITPendingBit(DMA1_IT_GL1 << ((Stream->DMA_Channel == DMA_Channel1) ? 0 : 4));
+
+    /* A conversion left in DR by an overrun would shift the scans */
+    (void)ADC_GetConversionValue(ADCx);
+    ADC_ClearFlag(ADCx, ADC_FLAG_OVR | ADC_FLAG_EOC | ADC_FLAG_EOSEQ);
+
+    DMA_Cmd(Stream->DMA_Channel, ENABLE);
+    ADC_StartOfConversion(ADCx);
+}
+
+/**
+  * @brief  Stops a continuous acquisition, the scan in progress is aborted.
+  * @note   The ADC stays enabled, ADC_StreamStart() starts again with an
+  *         empty buffer.
+  * @param  ADCx: Select the ADC peripheral,This parameter can be ADC.
+  * @param  Stream: pointer to the acquisition.
+  * @retval None
+  */
+void ADC_StreamStop(ADC_TypeDef* ADCx, ADC_StreamTypeDef* Stream)
+{
+    uint32_t timeout = 0;
+
+    /* Check the parameters */
+    assert_param(IS_ADC_ALL_PERIPH(ADCx));
+
+    if ((ADCx->CR & ADC_CR_ADSTART) != 0)
+    {
+        ADC_StopOfConversion(ADCx);
+
+        while (((ADCx->CR & ADC_CR_ADSTP) != 0) && (timeout != STREAM_TIMEOUT))
+        {
+            timeout++;
+        }
+    }
+
+    DMA_Cmd(Stream->DMA_Channel, DISABLE);
+}
+
+/**
+  * @brief  Position of a channel in the scans of an acquisition.
+  * @param  Stream: pointer to the acquisition.
+  * @param  ADC_Channel: one of the channels of ADC_Channels.
+  * @retval Index of the channel, its samples start at
+  *         Output + index * BlockLength.
+  */
+uint32_t ADC_StreamGetIndex(ADC_StreamTypeDef* Stream, uint32_t ADC_Channel)
+{
+    uint32_t lower = Stream->ADC_Channels & (ADC_Channel - 1);
+    uint32_t index = 0;
+
+    while (lower != 0)
+    {
+        lower &= lower - 1;
+        index++;
+    }
+
+    return index;
+}
+
+/**
+  * @brief  Delivers the half buffer of the DMA flags HTIF/TCIF of a stream.
+  * @param  Stream: pointer to the acquisition.
+  * @param  Flags: DMA_ISR_HTIF1 and/or DMA_ISR_TCIF1.
+  * @retval None
+  */
+static void ADC_StreamDeliver(ADC_StreamTypeDef* Stream, uint32_t Flags)
+{
+    uint32_t length = (uint32_t)Stream->BlockLength * Stream->NbChannels;
+    uint32_t flags = Flags;
+    const uint16_t* block;
+    uint16_t* output;
+    uint32_t channel;
+    uint32_t i;
+
+    if (flags == (DMA_ISR_HTIF1 | DMA_ISR_TCIF1))
+    {
+        /* Late: deliver the half the DMA is not writing, the other is lost */
+        Stream->Lost++;
+        flags = (Stream->DMA_Channel->CHDTR > length) ? DMA_ISR_TCIF1 : DMA_ISR_HTIF1;
+    }
+
+    block = (flags == DMA_ISR_HTIF1) ? Stream->Buffer : &Stream->Buffer[length];
+
+    if (Stream->Output != NULL)
+    {
+        /* One channel after the other */
+        for (channel = 0; channel < Stream->NbChannels; channel++)
+        {
+            output = &Stream->Output[channel * Stream->BlockLength];
+
+            for (i = channel; i < length; i += Stream->NbChannels)
+            {
+                *output++ = block[i];
+            }
+        }
+
+        block = Stream->Output;
+    }
+
+    Stream->Blocks++;
+
+    if (Stream->BlockCallback != NULL)
+    {
+        Stream->BlockCallback(Stream, block);
+    }
+}
+
+/**
+  * @brief  Hands over the completed half buffer of a continuous acquisition,
+  *         restarts it after an overrun.
+  * @note   To be called from the IRQ handler of the DMA channel: DMA_CH1 for
+  *         DMA_Channel1, DMA_CH2_3 for DMA_Channel2, and from the ADC_COMP
+  *         IRQ handler.
+  * @param  ADCx: Select the ADC peripheral,This parameter can be ADC.
+  * @param  Stream: pointer to the acquisition.
+  * @retval None
+  */
+void ADC_StreamIRQHandler(ADC_TypeDef* ADCx, ADC_StreamTypeDef* Stream)
+{
+    uint32_t shift = (Stream->DMA_Channel == DMA_Channel1) ? 0 : 4;
+    uint32_t flags = (DMA->ISR >> shift) & (DMA_ISR_HTIF1 | DMA_ISR_TCIF1);
+
+    if (flags != 0)
+    {
+        DMA_ClearITPendingBit((DMA1_IT_GL1 | DMA1_IT_HT1 | DMA1_IT_TC1) << shift);
+        ADC_StreamDeliver(Stream, flags);
+    }
+
+    /* The overrun has stopped the DMA requests: start again, aligned on a scan */
+    if ((ADCx->ISR & ADC_ISR_OVR) != 0)
+    {
+        Stream->Overruns++;
+        ADC_StreamStop(ADCx, Stream);
+        ADC_StreamStart(ADCx, Stream);
+    }
+}
+/**
+  * @}
+  */
+
+/** @defgroup ADC_Group9 Calibration context functions
+ *  @brief   Integer conversions of samples into millivolts and temperature
+ *
+@verbatim
+ ===============================================================================
+          ##### Calibration context functions #####
+ ===============================================================================
+    [..] ADC_GETVDDA() and ADC_GetTemperature() read the calibration words
+         from the flash and divide at each call. An ADC_CalibTypeDef holds
+         them, read once by ADC_CalibInit(), and the factors of the current
+         VDDA, so that a sample is converted with one multiply and one shift:
+         (+) millivolts: Raw x MvScale, MvScale being VDDA / 0xFFF with
+             ADC_CALIB_MV_SHIFT fraction bits;
+         (+) 0.01 degrees Celsius: Raw x TempScale + TempOffset, with the
+             formula of ADC_GetTemperature() and TempShift fraction bits.
+    [..] ADC_CalibUpdateVdda() follows the supply: it takes the mean of a
+         buffer of Vrefint conversions, with a single divide for the buffer
+         instead of one per sample, and recomputes the factors.
+    [..] ADC_CalibBufferToMillivolts() and ADC_CalibBufferToCentiDegrees()
+         convert whole DMA buffers, in place if the output is the input.
+         The samples are 12 bits, right aligned.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Reads the calibration words and computes the conversion factors.
+  * @param  Calib: pointer to the calibration context to initialize.
+  * @param  VrefintRaw: a Vrefint conversion, giving the current VDDA.
+  * @retval SUCCESS, or ERROR if the calibration words are erased or
+  *         inconsistent, or if VrefintRaw is not a Vrefint conversion.
+  */
+ErrorStatus ADC_CalibInit(ADC_CalibTypeDef* Calib, uint32_t VrefintRaw)
+{
+    uint32_t temps = *(uint32_t*)TEMPS_CAL_ADDR;
+    int32_t ftData = (int32_t)(temps >> 16);
+    int32_t delta = (int32_t)*TEMP85_CAL_ADDR - (int32_t)*TEMP25_CAL_ADDR;
+    uint32_t absDelta = (delta > 0) ? (uint32_t)delta : (uint32_t)(-delta);
+    uint32_t absFT;
+    uint32_t slope;
+    uint32_t shift = ADC_CALIB_TEMP_SHIFT_MAX;
+    uint16_t vrefint = (uint16_t)VrefintRaw;
+
+    Calib->VrefintCal = *VREFINT_CAL_ADDR;
+    Calib->TempFTCal = (uint16_t)temps;
+
+    if ((Calib->VrefintCal == 0) || (Calib->VrefintCal == 0xFFFF) || (delta == 0) ||
+        (*TEMP85_CAL_ADDR == 0xFFFF) || (*TEMP25_CAL_ADDR == 0xFFFF))
+    {
+        return ERROR;
+    }
+
+    /* FT test temperature, in 0.0625 degrees, as ADC_GetTemperatureATFT() */
+    if (ftData <= 0x7FF)
+    {
+        Calib->TempFT = (ftData * 625) / 100;
+    }
+    else
+    {
+        Calib->TempFT = -(((0x1FFF - ftData) * 625) / 100);
+    }
+
+    absFT = (Calib->TempFT > 0) ? (uint32_t)Calib->TempFT : (uint32_t)(-Calib->TempFT);
+
+    /* (85 - 25) degrees over the calibration delta, with as many fraction
+       bits as the bounds of the products allow */
+    slope = ((6000UL << shift) + (absDelta >> 1)) / absDelta;
+
+    while ((slope > CALIB_SLOPE_MAX) || (absFT > (CALIB_OFFSET_MAX >> shift)))
+    {
+        shift--;
+        slope = ((6000UL << shift) + (absDelta >> 1)) / absDelta;
+    }
+
+    Calib->TempShift = shift;
+    Calib->TempSlope = (delta > 0) ? (int32_t)slope : -(int32_t)slope;
+
+    /* The offset does not depend on VDDA: FT temperature minus the slope
+       times the FT conversion */
+    Calib->TempOffset = (Calib->TempFT * (int32_t)(1UL << shift)) -
+                        (Calib->TempSlope * (int32_t)Calib->TempFTCal);
+
+    return ADC_CalibUpdateVdda(Calib, &vrefint, 1);
+}
+
+/**
+  * @brief  Measures VDDA from Vrefint conversions and updates the factors.
+  * @param  Calib: pointer to the calibration context.
+  * @param  pVrefint: buffer of Vrefint conversions, averaged.
+  * @param  Length: number of conversions, from 1 to 65535.
+  * @retval SUCCESS, or ERROR if the mean is not a Vrefint conversion
+  *         (VDDA above 6.6 V), the factors are then unchanged.
+  */
+ErrorStatus ADC_CalibUpdateVdda(ADC_CalibTypeDef* Calib, const uint16_t* pVrefint, uint32_t Length)
+{
+    uint32_t sum = 0;
+    uint32_t mean;
+    uint32_t i;
+    int32_t scale;
+
+    assert_param((Length != 0) && (Length <= 0xFFFF));
+
+    for (i = 0; i < Length; i++)
+    {
+        sum += pVrefint[i];
+    }
+
+    /* Mean with 4 fraction bits */
+    mean = ((sum << 4) + (Length >> 1)) / Length;
+
+    if ((mean << 1) < ((uint32_t)Calib->VrefintCal << 4))
+    {
+        return ERROR;
+    }
+
+    /* VDDA = 3.3 V x VREFINT_CAL / VREFINT_DATA, as ADC_GETVDDA() */
+    Calib->Vdda = ((3300UL * 16 * Calib->VrefintCal) + (mean >> 1)) / mean;
+
+    Calib->MvScale = ((Calib->Vdda << ADC_CALIB_MV_SHIFT) + (0xFFF >> 1)) / 0xFFF;
+
+    /* Sensor conversion at 3.3 V: Raw x VDDA / 3300 */
+    scale = Calib->TempSlope * (int32_t)Calib->Vdda;
+    Calib->TempScale = (scale >= 0) ? ((scale + 1650) / 3300) : ((scale - 1650) / 3300);
+
+    return SUCCESS;
+}
+
+/**
+  * @brief  Converts a sample into millivolts.
+  * @param  Calib: pointer to the calibration context.
+  * @param  Raw: 12 bits conversion.
+  * @retval Voltage in mV.
+  */
+uint32_t ADC_CalibToMillivolts(const ADC_CalibTypeDef* Calib, uint32_t Raw)
+{
+    return ((Raw * Calib->MvScale) + (1UL << (ADC_CALIB_MV_SHIFT - 1))) >> ADC_CALIB_MV_SHIFT;
+}
+
+/**
+  * @brief  Converts a temperature sensor sample into 0.01 degrees Celsius.
+  * @param  Calib: pointer to the calibration context.
+  * @param  Raw: 12 bits conversion of ADC_Channel_TempSensor.
+  * @retval Temperature in 0.01 degrees Celsius.
+  */
+int32_t ADC_CalibToCentiDegrees(const ADC_CalibTypeDef* Calib, uint32_t Raw)
+{
+    return ((Calib->TempScale * (int32_t)Raw) + Calib->TempOffset +
+            (int32_t)(1UL << (Calib->TempShift - 1))) >> Calib->TempShift;
+}
+
+/**
+  * @brief  Converts a buffer of samples into millivolts.
+  * @param  Calib: pointer to the calibration context.
+  * @param  pRaw: 12 bits conversions.
+  * @param  pMillivolts: voltages in mV, can be pRaw.
+  * @param  Length: number of samples.
+  * @retval None
+  */
+void ADC_CalibBufferToMillivolts(const ADC_CalibTypeDef* Calib, const uint16_t* pRaw, uint16_t* pMillivolts, uint32_t Length)
+{
+    uint32_t scale = Calib->MvScale;
+    uint32_t i;
+
+    for (i = 0; i < Length; i++)
+    {
+        pMillivolts[i] = (uint16_t)(((pRaw[i] * scale) + (1UL << (ADC_CALIB_MV_SHIFT - 1))) >> ADC_CALIB_MV_SHIFT);
+    }
+}
+
+/**
+  * @brief  Converts a buffer of temperature sensor samples into 0.01 degrees Celsius.
+  * @param  Calib: pointer to the calibration context.
+  * @param  pRaw: 12 bits conversions of ADC_Channel_TempSensor.
+  * @param  pCentiDegrees: temperatures in 0.01 degrees Celsius, can be pRaw.
+  * @param  Length: number of samples.
+  * @retval None
+  */
+void ADC_CalibBufferToCentiDegrees(const ADC_CalibTypeDef* Calib, const uint16_t* pRaw, int16_t* pCentiDegrees, uint32_t Length)
+{
+    int32_t scale = Calib->TempScale;
+    int32_t offset = Calib->TempOffset + (int32_t)(1UL << (Calib->TempShift - 1));
+    uint32_t shift = Calib->TempShift;
+    uint32_t i;
+
+    for (i = 0; i < Length; i++)
+    {
+        pCentiDegrees[i] = (int16_t)(((scale * (int32_t)pRaw[i]) + offset) >> shift);
+    }
+}
+/**
+  * @}
+  */
+
 /**
   * @}
   */
@@ -15,7 +15,9 @@
 
 
 /* Includes ------------------------------------------------------------------*/
+#include <string.h>
 #include "hk32l0xx_aes.h"
+#include "hk32l0xx_dma.h"
 
 /** @addtogroup HK32L0xx_StdPeriph_Driver
   * @{
@@ -69,6 +71,8 @@
 #define CR_MODE_CLEAR_MASK          ((uint32_t)0xFFFFFF81)
 #define CR2_KEYSIZE_CLEAR_MASK      ((uint32_t)0xFFFFFFFC)
 #define IS_BIT_CLR(REG,BIT)         (((REG) & (BIT)) == RESET)
+#define AES_DMA_TIMEOUT_VALUE       ((uint32_t) 0x00100000)
+#define AES_DMA_CHANNEL_SIZE        ((uint32_t)(DMA_Channel2_BASE - DMA_Channel1_BASE))
 /**
   * @}
   */
@@ -84,6 +88,47 @@ AES_PAR sAesPar = { 0 };
 
 /*PendingTimeout :Pending  in interrupt mode,The aes operation will be suspended when a higher priority interrupt occurs in aes operations,so we need a timeout counter*/
 uint32_t PendingTimeout = 0xFFFFFFFE;
+
+/* Software model S-box and inverse S-box */
+static const uint8_t AesSbox[256] =
+{
+    0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+    0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+    0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+    0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+    0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+    0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+    0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+    0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+    0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+    0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+    0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+    0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+    0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+    0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+    0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+    0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16
+};
+
+static const uint8_t AesInvSbox[256] =
+{
+    0x52, 0x09, 0x6A, 0xD5, 0x30, 0x36, 0xA5, 0x38, 0xBF, 0x40, 0xA3, 0x9E, 0x81, 0xF3, 0xD7, 0xFB,
+    0x7C, 0xE3, 0x39, 0x82, 0x9B, 0x2F, 0xFF, 0x87, 0x34, 0x8E, 0x43, 0x44, 0xC4, 0xDE, 0xE9, 0xCB,
+    0x54, 0x7B, 0x94, 0x32, 0xA6, 0xC2, 0x23, 0x3D, 0xEE, 0x4C, 0x95, 0x0B, 0x42, 0xFA, 0xC3, 0x4E,
+    0x08, 0x2E, 0xA1, 0x66, 0x28, 0xD9, 0x24, 0xB2, 0x76, 0x5B, 0xA2, 0x49, 0x6D, 0x8B, 0xD1, 0x25,
+    0x72, 0xF8, 0xF6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xD4, 0xA4, 0x5C, 0xCC, 0x5D, 0x65, 0xB6, 0x92,
+    0x6C, 0x70, 0x48, 0x50, 0xFD, 0xED, 0xB9, 0xDA, 0x5E, 0x15, 0x46, 0x57, 0xA7, 0x8D, 0x9D, 0x84,
+    0x90, 0xD8, 0xAB, 0x00, 0x8C, 0xBC, 0xD3, 0x0A, 0xF7, 0xE4, 0x58, 0x05, 0xB8, 0xB3, 0x45, 0x06,
+    0xD0, 0x2C, 0x1E, 0x8F, 0xCA, 0x3F, 0x0F, 0x02, 0xC1, 0xAF, 0xBD, 0x03, 0x01, 0x13, 0x8A, 0x6B,
+    0x3A, 0x91, 0x11, 0x41, 0x4F, 0x67, 0xDC, 0xEA, 0x97, 0xF2, 0xCF, 0xCE, 0xF0, 0xB4, 0xE6, 0x73,
+    0x96, 0xAC, 0x74, 0x22, 0xE7, 0xAD, 0x35, 0x85, 0xE2, 0xF9, 0x37, 0xE8, 0x1C, 0x75, 0xDF, 0x6E,
+    0x47, 0xF1, 0x1A, 0x71, 0x1D, 0x29, 0xC5, 0x89, 0x6F, 0xB7, 0x62, 0x0E, 0xAA, 0x18, 0xBE, 0x1B,
+    0xFC, 0x56, 0x3E, 0x4B, 0xC6, 0xD2, 0x79, 0x20, 0x9A, 0xDB, 0xC0, 0xFE, 0x78, 0xCD, 0x5A, 0xF4,
+    0x1F, 0xDD, 0xA8, 0x33, 0x88, 0x07, 0xC7, 0x31, 0xB1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xEC, 0x5F,
+    0x60, 0x51, 0x7F, 0xA9, 0x19, 0xB5, 0x4A, 0x0D, 0x2D, 0xE5, 0x7A, 0x9F, 0x93, 0xC9, 0x9C, 0xEF,
+    0xA0, 0xE0, 0x3B, 0x4D, 0xAE, 0x2A, 0xF5, 0xB0, 0xC8, 0xEB, 0xBB, 0x3C, 0x83, 0x53, 0x99, 0x61,
+    0x17, 0x2B, 0x04, 0x7E, 0xBA, 0x77, 0xD6, 0x26, 0xE1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0C, 0x7D
+};
 /**
   * @}
   */
@@ -719,6 +764,1512 @@ void AES_SetResumeConfigIT(void)
 
 }
 
+/**
+  * @}
+  */
+
+/** @defgroup AES_Group5 Chaining modes functions
+ *  @brief   CBC, CTR, CMAC and CCM on the ECB core.
+ *
+@verbatim
+ ===============================================================================
+                    ##### Chaining modes functions #####
+ ===============================================================================
+    [..] An AES_ContextTypeDef holds a key and the way the blocks are
+         computed:
+         (+) By the CPU, writing DINR and reading DOUTR for each block.
+         (+) By two DMA channels, AES_DMATransfer_InOut, for the modes whose
+             blocks are independent: ECB, CBC decryption and CTR. While a
+             DMA transfer runs, the CPU prepares the counters of the next one
+             and XORs the result of the previous one.
+         (+) By the software model (AES_Model functions), to check the results
+             of the core or to run the same code on a host.
+    [..] Decryption keys are derived once per call (AES_Operation_KeyDeriv),
+         then the blocks are decrypted with AES_Operation_Decryp.
+    [..] Each function configures the core on entry and disables it on
+         return: the core may be used by other code between two calls, but
+         not by an interrupt during a call.
+    [..] ECB and CBC buffers must be 32 bits aligned, with a length multiple
+         of AES_BLOCK_SIZE. CTR, CMAC and CCM accept any alignment and
+         length. IV and Counter are updated for the next call.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Waits for the end of the computation of a block and clears CCF.
+  * @retval SUCCESS, or ERROR on timeout
+  */
+static ErrorStatus AES_WaitComputation(void)
+{
+    uint32_t counter = 0;
+
+    while ((AES->SR1 & AES_SR1_CCF) == 0)
+    {
+        if (++counter == AES_TIMEOUT_VALUE)
+        {
+            return ERROR;
+        }
+    }
+
+    AES->CR1 |= AES_CR1_CCFC;
+
+    return SUCCESS;
+}
+
+/**
+  * @brief  Loads the key and sets the operation of the core.
+  * @param  AES_Context: chaining modes context
+  * @param  Operation: AES_Operation_Encryp or AES_Operation_Decryp
+  * @retval SUCCESS, or ERROR if the key derivation timed out
+  */
+static ErrorStatus AES_CoreStart(AES_ContextTypeDef* AES_Context, uint32_t Operation)
+{
+    AES_InitTypeDef AES_InitStructure;
+    AES_KeyInitTypeDef AES_KeyInitStructure;
+    ErrorStatus status = SUCCESS;
+
+    AES_Context->Operation = Operation;
+
+    if (AES_Context->Model != NULL)
+    {
+        return SUCCESS;
+    }
+
+    AES->CR1 &= ~(AES_CR1_EN | AES_CR1_DMAINEN | AES_CR1_DMAOUTEN);
+    AES->CR1 |= AES_CR1_CCFC | AES_CR1_ERRC;
+
+    AES_KeyInitStructure.AES_KeySize = AES_Context->KeySize;
+    AES_KeyInit(&AES_KeyInitStructure, (uint8_t*)AES_Context->Key);
+
+    if (Operation == AES_Operation_Decryp)
+    {
+        /* The derived key replaces the key in KEYRx */
+        AES_InitStructure.AES_Operation = AES_Operation_KeyDeriv;
+        AES_Init(&AES_InitStructure);
+        AES_Cmd(ENABLE);
+        status = AES_WaitComputation();
+        AES_Cmd(DISABLE);
+    }
+
+    AES_InitStructure.AES_Operation = Operation;
+    AES_Init(&AES_InitStructure);
+    AES_Cmd(ENABLE);
+
+    return status;
+}
+
+/**
+  * @brief  Computes one block with the CPU or the software model.
+  * @param  AES_Context: chaining modes context, started
+  * @param  Input: input block, 32 bits aligned
+  * @param  Output: output block, 32 bits aligned, may be Input
+  * @retval SUCCESS, or ERROR on timeout
+  */
+static ErrorStatus AES_CoreBlock(AES_ContextTypeDef* AES_Context, const uint32_t* Input, uint32_t* Output)
+{
+    if (AES_Context->Model != NULL)
+    {
+        if (AES_Context->Operation == AES_Operation_Encryp)
+        {
+            AES_ModelEncrypt(AES_Context->Model, (const uint8_t*)Input, (uint8_t*)Output);
+        }
+        else
+        {
+            AES_ModelDecrypt(AES_Context->Model, (const uint8_t*)Input, (uint8_t*)Output);
+        }
+
+        return SUCCESS;
+    }
+
+    AES->DINR = Input[0];
+    AES->DINR = Input[1];
+    AES->DINR = Input[2];
+    AES->DINR = Input[3];
+
+    if (AES_WaitComputation() != SUCCESS)
+    {
+        return ERROR;
+    }
+
+    Output[0] = AES->DOUTR;
+    Output[1] = AES->DOUTR;
+    Output[2] = AES->DOUTR;
+    Output[3] = AES->DOUTR;
+
+    return SUCCESS;
+}
+
+/**
+  * @brief  Starts the computation of consecutive blocks. With the DMA the
+  *         function returns at once, AES_CoreWait() waits for the end.
+  * @param  AES_Context: chaining modes context, started
+  * @param  Input: input blocks, 32 bits aligned
+  * @param  Output: output blocks, 32 bits aligned, may be Input
+  * @param  NbBlocks: number of blocks, AES_MODE_DMA_MAX_BLOCKS at most
+  * @retval SUCCESS, or ERROR on timeout
+  */
+static ErrorStatus AES_CoreRun(AES_ContextTypeDef* AES_Context, const uint32_t* Input, uint32_t* Output,
+                               uint32_t NbBlocks)
+{
+    DMA_InitTypeDef DMA_InitStructure;
+    ErrorStatus status = SUCCESS;
+    uint32_t shift;
+
+    if ((AES_Context->Model != NULL) || (AES_Context->DMAIn_Channelx == NULL)
+            || (AES_Context->DMAOut_Channelx == NULL) || (NbBlocks < 2))
+    {
+        while ((NbBlocks-- != 0) && (status == SUCCESS))
+        {
+            status = AES_CoreBlock(AES_Context, Input, Output);
+            Input += 4;
+            Output += 4;
+        }
+
+        return status;
+    }
+
+    /* The output channel has the higher priority, so DOUTR is read before
+       the next block is written */
+    DMA_InitStructure.DMA_BufferSize = NbBlocks * 4;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Word;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Word;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&AES->DINR;
+    DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)Input;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralDST;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_Medium;
+    DMA_Cmd(AES_Context->DMAIn_Channelx, DISABLE);
+    DMA_Init(AES_Context->DMAIn_Channelx, &DMA_InitStructure);
+
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&AES->DOUTR;
+    DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)Output;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+    DMA_Cmd(AES_Context->DMAOut_Channelx, DISABLE);
+    DMA_Init(AES_Context->DMAOut_Channelx, &DMA_InitStructure);
+
+    shift = (((uint32_t)AES_Context->DMAIn_Channelx - DMA_Channel1_BASE) / AES_DMA_CHANNEL_SIZE) * 4;
+    DMA->IFCR = DMA_IFCR_CGIF1 << shift;
+    shift = (((uint32_t)AES_Context->DMAOut_Channelx - DMA_Channel1_BASE) / AES_DMA_CHANNEL_SIZE) * 4;
+    DMA->IFCR = DMA_IFCR_CGIF1 << shift;
+
+    DMA_Cmd(AES_Context->DMAOut_Channelx, ENABLE);
+    DMA_Cmd(AES_Context->DMAIn_Channelx, ENABLE);
+
+    /* DMAINEN and DMAOUTEN are written while the core is disabled */
+    AES_Cmd(DISABLE);
+    AES_DMAConfig(AES_DMATransfer_InOut, ENABLE);
+    AES_Cmd(ENABLE);
+
+    return SUCCESS;
+}
+
+/**
+  * @brief  Waits for the end of the blocks started by AES_CoreRun().
+  * @param  AES_Context: chaining modes context, started
+  * @retval SUCCESS, or ERROR on a DMA transfer error or timeout
+  */
+static ErrorStatus AES_CoreWait(AES_ContextTypeDef* AES_Context)
+{
+    uint32_t shift;
+    uint32_t flags;
+    uint32_t counter = 0;
+
+    if ((AES_Context->Model != NULL) || (AES_Context->DMAOut_Channelx == NULL)
+            || ((AES_Context->DMAOut_Channelx->CHCR & DMA_Channel_CHCR_EN) == 0))
+    {
+        return SUCCESS;
+    }
+
+    shift = (((uint32_t)AES_Context->DMAOut_Channelx - DMA_Channel1_BASE) / AES_DMA_CHANNEL_SIZE) * 4;
+
+    /* Wait for the transfer complete or transfer error flag */
+    do
+    {
+        flags = (DMA->ISR >> shift) & (DMA_ISR_TCIF1 | DMA_ISR_TEIF1);
+    } while ((flags == 0) && (++counter != AES_DMA_TIMEOUT_VALUE));
+
+    AES_Cmd(DISABLE);
+    AES_DMAConfig(AES_DMATransfer_InOut, DISABLE);
+    AES->CR1 |= AES_CR1_CCFC;
+    AES_Cmd(ENABLE);
+
+    DMA_Cmd(AES_Context->DMAIn_Channelx, DISABLE);
+    DMA_Cmd(AES_Context->DMAOut_Channelx, DISABLE);
+    DMA->IFCR = DMA_IFCR_CGIF1 << shift;
+    shift = (((uint32_t)AES_Context->DMAIn_Channelx - DMA_Channel1_BASE) / AES_DMA_CHANNEL_SIZE) * 4;
+    DMA->IFCR = DMA_IFCR_CGIF1 << shift;
+
+    return (flags == DMA_ISR_TCIF1) ? SUCCESS : ERROR;
+}
+
+/**
+  * @brief  Disables the core and the DMA channels.
+  * @param  AES_Context: chaining modes context
+  * @retval None
+  */
+static void AES_CoreStop(AES_ContextTypeDef* AES_Context)
+{
+    if (AES_Context->Model != NULL)
+    {
+        return;
+    }
+
+    AES->CR1 &= ~(AES_CR1_EN | AES_CR1_DMAINEN | AES_CR1_DMAOUTEN);
+
+    if ((AES_Context->DMAIn_Channelx != NULL) && (AES_Context->DMAOut_Channelx != NULL))
+    {
+        DMA_Cmd(AES_Context->DMAIn_Channelx, DISABLE);
+        DMA_Cmd(AES_Context->DMAOut_Channelx, DISABLE);
+    }
+}
+
+/**
+  * @brief  XORs a buffer with a key stream.
+  * @param  Input: input bytes, no alignment required
+  * @param  Stream: key stream, 32 bits aligned
+  * @param  Output: output bytes, no alignment required, may be Input
+  * @param  Length: number of bytes
+  * @retval None
+  */
+static void AES_XorStream(const uint8_t* Input, const uint32_t* Stream, uint8_t* Output, uint32_t Length)
+{
+    const uint8_t* pstream = (const uint8_t*)Stream;
+    uint32_t i = 0;
+
+    if ((((uint32_t)Input | (uint32_t)Output) & 3) == 0)
+    {
+        for (; i + 4 <= Length; i += 4)
+        {
+            *(uint32_t*)(Output + i) = *(const uint32_t*)(Input + i) ^ Stream[i / 4];
+        }
+    }
+
+    for (; i < Length; i++)
+    {
+        Output[i] = Input[i] ^ pstream[i];
+    }
+}
+
+/**
+  * @brief  Adds one to a 128 bits big endian counter.
+  * @param  Counter: counter block
+  * @retval None
+  */
+static void AES_CounterIncrement(uint8_t* Counter)
+{
+    uint32_t i;
+
+    for (i = AES_BLOCK_SIZE; i != 0; i--)
+    {
+        if (++Counter[i - 1] != 0)
+        {
+            break;
+        }
+    }
+}
+
+/**
+  * @brief  Runs CTR on a started context.
+  * @param  AES_Context: chaining modes context, started for encryption
+  * @param  Counter: counter block, updated
+  * @param  Input: input bytes
+  * @param  Length: number of bytes
+  * @param  Output: output bytes, may be Input
+  * @retval SUCCESS, or ERROR on timeout or DMA transfer error
+  */
+static ErrorStatus AES_CTRRun(AES_ContextTypeDef* AES_Context, uint8_t* Counter, const uint8_t* Input,
+                              uint32_t Length, uint8_t* Output)
+{
+    uint32_t stream[2][AES_MODE_DMA_BLOCKS * 4];
+    ErrorStatus status = SUCCESS;
+    uint32_t current = 0;
+    uint32_t count = 0;
+    uint32_t next;
+    uint32_t i;
+
+    while ((Length != 0) && (status == SUCCESS))
+    {
+        /* Counter blocks of the next transfer, while the current one runs */
+        next = (Length - count + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE;
+
+        if (next > AES_MODE_DMA_BLOCKS)
+        {
+            next = AES_MODE_DMA_BLOCKS;
+        }
+
+        for (i = 0; i < next; i++)
+        {
+            memcpy(&stream[current ^ 1][i * 4], Counter, AES_BLOCK_SIZE);
+            AES_CounterIncrement(Counter);
+        }
+
+        status = AES_CoreWait(AES_Context);
+
+        if ((status == SUCCESS) && (next != 0))
+        {
+            status = AES_CoreRun(AES_Context, stream[current ^ 1], stream[current ^ 1], next);
+        }
+
+        /* XOR the current key stream, while the next one is computed */
+        if ((status == SUCCESS) && (count != 0))
+        {
+            AES_XorStream(Input, stream[current], Output, count);
+            Input += count;
+            Output += count;
+            Length -= count;
+        }
+
+        current ^= 1;
+        count = next * AES_BLOCK_SIZE;
+
+        if (count > Length)
+        {
+            count = Length;
+        }
+    }
+
+    return status;
+}
+
+/**
+  * @brief  Adds bytes to a CBC-MAC.
+  * @param  AES_Context: chaining modes context, started for encryption
+  * @param  Mac: running MAC block
+  * @param  Fill: number of bytes of the current block, updated
+  * @param  pData: bytes to add
+  * @param  Length: number of bytes
+  * @retval SUCCESS, or ERROR on timeout
+  */
+static ErrorStatus AES_MACUpdate(AES_ContextTypeDef* AES_Context, uint32_t* Mac, uint32_t* Fill,
+                                 const uint8_t* pData, uint32_t Length)
+{
+    uint8_t* pmac = (uint8_t*)Mac;
+    ErrorStatus status = SUCCESS;
+
+    while ((Length-- != 0) && (status == SUCCESS))
+    {
+        pmac[(*Fill)++] ^= *pData++;
+
+        if (*Fill == AES_BLOCK_SIZE)
+        {
+            status = AES_CoreBlock(AES_Context, Mac, Mac);
+            *Fill = 0;
+        }
+    }
+
+    return status;
+}
+
+/**
+  * @brief  Computes the CCM CBC-MAC of a nonce, associated data and payload.
+  * @param  AES_Context: chaining modes context, started for encryption
+  * @param  Nonce, NonceSize, AData, ADataLength, TagSize: see AES_CCMEncrypt()
+  * @param  Payload: plain text
+  * @param  Length: number of bytes of Payload
+  * @param  Mac: CBC-MAC, 32 bits aligned
+  * @retval SUCCESS, or ERROR on timeout
+  */
+static ErrorStatus AES_CCMMac(AES_ContextTypeDef* AES_Context, const uint8_t* Nonce, uint32_t NonceSize,
+                              const uint8_t* AData, uint32_t ADataLength, const uint8_t* Payload,
+                              uint32_t Length, uint32_t TagSize, uint32_t* Mac)
+{
+    uint8_t* pmac = (uint8_t*)Mac;
+    uint8_t header[6];
+    ErrorStatus status;
+    uint32_t fill = 0;
+    uint32_t size = 0;
+    uint32_t i;
+
+    /* B0: flags, nonce and payload length on 15 - NonceSize bytes */
+    pmac[0] = (uint8_t)((((TagSize - 2) / 2) << 3) | (14 - NonceSize));
+
+    if (ADataLength != 0)
+    {
+        pmac[0] |= 0x40;
+    }
+
+    memcpy(&pmac[1], Nonce, NonceSize);
+
+    for (i = AES_BLOCK_SIZE - 1; i > NonceSize; i--)
+    {
+        pmac[i] = (i >= AES_BLOCK_SIZE - 4) ? (uint8_t)(Length >> (8 * (AES_BLOCK_SIZE - 1 - i))) : 0;
+    }
+
+    status = AES_CoreBlock(AES_Context, Mac, Mac);
+
+    /* Associated data, preceded by its length */
+    if ((status == SUCCESS) && (ADataLength != 0))
+    {
+        if (ADataLength < 0xFF00)
+        {
+            header[size++] = (uint8_t)(ADataLength >> 8);
+        }
+        else
+        {
+            header[size++] = 0xFF;
+            header[size++] = 0xFE;
+            header[size++] = (uint8_t)(ADataLength >> 24);
+            header[size++] = (uint8_t)(ADataLength >> 16);
+            header[size++] = (uint8_t)(ADataLength >> 8);
+        }
+
+        header[size++] = (uint8_t)ADataLength;
+
+        status = AES_MACUpdate(AES_Context, Mac, &fill, header, size);
+
+        if (status == SUCCESS)
+        {
+            status = AES_MACUpdate(AES_Context, Mac, &fill, AData, ADataLength);
+        }
+
+        if ((status == SUCCESS) && (fill != 0))
+        {
+            status = AES_CoreBlock(AES_Context, Mac, Mac);
+            fill = 0;
+        }
+    }
+
+    /* Payload */
+    if (status == SUCCESS)
+    {
+        status = AES_MACUpdate(AES_Context, Mac, &fill, Payload, Length);
+    }
+
+    if ((status == SUCCESS) && (fill != 0))
+    {
+        status = AES_CoreBlock(AES_Context, Mac, Mac);
+    }
+
+    return status;
+}
+
+/**
+  * @brief  Sets the key of a chaining modes context.
+  * @note   The DMAIn_Channelx, DMAOut_Channelx and Model fields must be set
+  *         before. With a model, its round keys are computed here.
+  * @param  AES_Context: chaining modes context
+  * @param  Key: key, no alignment required
+  * @param  KeySize: AES_KEYSIZE_128B, AES_KEYSIZE_192B or AES_KEYSIZE_256B
+  * @retval None
+  */
+void AES_ModeInit(AES_ContextTypeDef* AES_Context, const uint8_t* Key, uint32_t KeySize)
+{
+    /* Check the parameters */
+    assert_param(IS_AES_KEYSIZE(KeySize));
+
+    AES_Context->KeySize = KeySize;
+    AES_Context->Operation = AES_Operation_Encryp;
+    memcpy(AES_Context->Key, Key, 16 + 8 * KeySize);
+
+    if (AES_Context->Model != NULL)
+    {
+        AES_ModelKeyInit(AES_Context->Model, Key, KeySize);
+    }
+}
+
+/**
+  * @brief  Encrypts or decrypts in ECB mode.
+  * @param  AES_Context: chaining modes context
+  * @param  AES_Operation: AES_Operation_Encryp or AES_Operation_Decryp
+  * @param  Input: input blocks, 32 bits aligned
+  * @param  Length: number of bytes, multiple of AES_BLOCK_SIZE
+  * @param  Output: output blocks, 32 bits aligned, may be Input
+  * @retval SUCCESS, or ERROR on timeout or DMA transfer error
+  */
+ErrorStatus AES_ECBCrypt(AES_ContextTypeDef* AES_Context, uint32_t AES_Operation, const uint8_t* Input,
+                         uint32_t Length, uint8_t* Output)
+{
+    ErrorStatus status;
+    uint32_t count;
+
+    /* Check the parameters */
+    assert_param(IS_AES_MODE_OPERATION(AES_Operation));
+
+    status = AES_CoreStart(AES_Context, AES_Operation);
+    Length /= AES_BLOCK_SIZE;
+
+    while ((Length != 0) && (status == SUCCESS))
+    {
+        count = (Length > AES_MODE_DMA_MAX_BLOCKS) ? AES_MODE_DMA_MAX_BLOCKS : Length;
+        status = AES_CoreRun(AES_Context, (const uint32_t*)Input, (uint32_t*)Output, count);
+
+        if (status == SUCCESS)
+        {
+            status = AES_CoreWait(AES_Context);
+        }
+
+        Input += count * AES_BLOCK_SIZE;
+        Output += count * AES_BLOCK_SIZE;
+        Length -= count;
+    }
+
+    AES_CoreStop(AES_Context);
+
+    return status;
+}
+
+/**
+  * @brief  Encrypts in CBC mode. Each block depends on the previous one, so
+  *         the DMA is not used.
+  * @param  AES_Context: chaining modes context
+  * @param  IV: initialization vector, replaced by the last cipher block
+  * @param  Input: plain text, 32 bits aligned
+  * @param  Length: number of bytes, multiple of AES_BLOCK_SIZE
+  * @param  Output: cipher text, 32 bits aligned, may be Input
+  * @retval SUCCESS, or ERROR on timeout
+  */
+ErrorStatus AES_CBCEncrypt(AES_ContextTypeDef* AES_Context, uint8_t* IV, const uint8_t* Input,
+                           uint32_t Length, uint8_t* Output)
+{
+    const uint32_t* pin = (const uint32_t*)Input;
+    uint32_t* pout = (uint32_t*)Output;
+    uint32_t chain[4];
+    ErrorStatus status;
+
+    status = AES_CoreStart(AES_Context, AES_Operation_Encryp);
+    memcpy(chain, IV, AES_BLOCK_SIZE);
+
+    for (; (Length >= AES_BLOCK_SIZE) && (status == SUCCESS); Length -= AES_BLOCK_SIZE)
+    {
+        chain[0] ^= pin[0];
+        chain[1] ^= pin[1];
+        chain[2] ^= pin[2];
+        chain[3] ^= pin[3];
+        status = AES_CoreBlock(AES_Context, chain, pout);
+        memcpy(chain, pout, AES_BLOCK_SIZE);
+        pin += 4;
+        pout += 4;
+    }
+
+    AES_CoreStop(AES_Context);
+    memcpy(IV, chain, AES_BLOCK_SIZE);
+
+    return status;
+}
+
+/**
+  * @brief  Decrypts in CBC mode. With the DMA, the blocks of a transfer are
+  *         decrypted while the CPU XORs those of the previous transfer.
+  * @param  AES_Context: chaining modes context
+  * @param  IV: initialization vector, replaced by the last cipher block
+  * @param  Input: cipher text, 32 bits aligned
+  * @param  Length: number of bytes, multiple of AES_BLOCK_SIZE
+  * @param  Output: plain text, 32 bits aligned, may be Input
+  * @retval SUCCESS, or ERROR on timeout or DMA transfer error
+  */
+ErrorStatus AES_CBCDecrypt(AES_ContextTypeDef* AES_Context, uint8_t* IV, const uint8_t* Input,
+                           uint32_t Length, uint8_t* Output)
+{
+    uint32_t block[2][AES_MODE_DMA_BLOCKS * 4];
+    const uint32_t* pin = (const uint32_t*)Input;
+    const uint32_t* pnext = pin;
+    uint32_t* pout = (uint32_t*)Output;
+    uint32_t chain[4];
+    uint32_t cipher[4];
+    ErrorStatus status;
+    uint32_t current = 0;
+    uint32_t count = 0;
+    uint32_t next;
+    uint32_t i;
+
+    status = AES_CoreStart(AES_Context, AES_Operation_Decryp);
+    memcpy(chain, IV, AES_BLOCK_SIZE);
+    Length /= AES_BLOCK_SIZE;
+
+    while ((Length != 0) && (status == SUCCESS))
+    {
+        status = AES_CoreWait(AES_Context);
+        next = Length - count;
+
+        if (next > AES_MODE_DMA_BLOCKS)
+        {
+            next = AES_MODE_DMA_BLOCKS;
+        }
+
+        /* The next transfer only reads blocks not yet written to Output */
+        if ((status == SUCCESS) && (next != 0))
+        {
+            status = AES_CoreRun(AES_Context, pnext, block[current ^ 1], next);
+            pnext += next * 4;
+        }
+
+        for (i = 0; (i < count) && (status == SUCCESS); i++)
+        {
+            memcpy(cipher, pin, AES_BLOCK_SIZE);
+            pout[0] = block[current][i * 4] ^ chain[0];
+            pout[1] = block[current][i * 4 + 1] ^ chain[1];
+            pout[2] = block[current][i * 4 + 2] ^ chain[2];
+            pout[3] = block[current][i * 4 + 3] ^ chain[3];
+            memcpy(chain, cipher, AES_BLOCK_SIZE);
+            pin += 4;
+            pout += 4;
+        }
+
+        Length -= (status == SUCCESS) ? count : 0;
+        current ^= 1;
+        count = next;
+    }
+
+    AES_CoreStop(AES_Context);
+    memcpy(IV, chain, AES_BLOCK_SIZE);
+
+    return status;
+}
+
+/**
+  * @brief  Encrypts or decrypts in CTR mode.
+  * @note   A last partial block uses a whole counter value: a stream split
+  *         over several calls must be given in multiples of AES_BLOCK_SIZE.
+  * @param  AES_Context: chaining modes context
+  * @param  Counter: counter block, incremented as a 128 bits big endian
+  *         number for each block
+  * @param  Input: input bytes, no alignment required
+  * @param  Length: number of bytes
+  * @param  Output: output bytes, no alignment required, may be Input
+  * @retval SUCCESS, or ERROR on timeout or DMA transfer error
+  */
+ErrorStatus AES_CTRCrypt(AES_ContextTypeDef* AES_Context, uint8_t* Counter, const uint8_t* Input,
+                         uint32_t Length, uint8_t* Output)
+{
+    ErrorStatus status;
+
+    status = AES_CoreStart(AES_Context, AES_Operation_Encryp);
+
+    if (status == SUCCESS)
+    {
+        status = AES_CTRRun(AES_Context, Counter, Input, Length, Output);
+    }
+
+    AES_CoreStop(AES_Context);
+
+    return status;
+}
+
+/**
+  * @brief  Computes a CMAC (NIST SP 800-38B).
+  * @param  AES_Context: chaining modes context
+  * @param  Input: message, no alignment required
+  * @param  Length: number of bytes, may be 0
+  * @param  Mac: AES_BLOCK_SIZE bytes MAC
+  * @retval SUCCESS, or ERROR on timeout
+  */
+ErrorStatus AES_CMACCompute(AES_ContextTypeDef* AES_Context, const uint8_t* Input, uint32_t Length,
+                            uint8_t* Mac)
+{
+    uint32_t subkey[4] = {0};
+    uint32_t chain[4] = {0};
+    uint8_t* psubkey = (uint8_t*)subkey;
+    uint8_t* pchain = (uint8_t*)chain;
+    ErrorStatus status;
+    uint32_t last;
+    uint32_t i;
+    uint32_t n;
+    uint8_t msb;
+
+    status = AES_CoreStart(AES_Context, AES_Operation_Encryp);
+
+    /* K1 = L.x and K2 = L.x^2 in GF(2^128), L = E(0) */
+    if (status == SUCCESS)
+    {
+        status = AES_CoreBlock(AES_Context, subkey, subkey);
+    }
+
+    last = (Length == 0) ? 0 : ((Length - 1) % AES_BLOCK_SIZE) + 1;
+
+    for (n = (last == AES_BLOCK_SIZE) ? 1 : 2; n != 0; n--)
+    {
+        msb = psubkey[0] & 0x80;
+
+        for (i = 0; i < AES_BLOCK_SIZE - 1; i++)
+        {
+            psubkey[i] = (uint8_t)((psubkey[i] << 1) | (psubkey[i + 1] >> 7));
+        }
+
+        psubkey[AES_BLOCK_SIZE - 1] = (uint8_t)((psubkey[AES_BLOCK_SIZE - 1] << 1) ^ ((msb != 0) ? 0x87 : 0));
+    }
+
+    /* All blocks but the last one */
+    for (; (Length > AES_BLOCK_SIZE) && (status == SUCCESS); Length -= AES_BLOCK_SIZE)
+    {
+        for (i = 0; i < AES_BLOCK_SIZE; i++)
+        {
+            pchain[i] ^= *Input++;
+        }
+
+        status = AES_CoreBlock(AES_Context, chain, chain);
+    }
+
+    /* Last block, padded if incomplete, XORed with the subkey */
+    for (i = 0; i < last; i++)
+    {
+        pchain[i] ^= Input[i];
+    }
+
+    if (last != AES_BLOCK_SIZE)
+    {
+        pchain[last] ^= 0x80;
+    }
+
+    chain[0] ^= subkey[0];
+    chain[1] ^= subkey[1];
+    chain[2] ^= subkey[2];
+    chain[3] ^= subkey[3];
+
+    if (status == SUCCESS)
+    {
+        status = AES_CoreBlock(AES_Context, chain, chain);
+    }
+
+    AES_CoreStop(AES_Context);
+    memcpy(Mac, chain, AES_BLOCK_SIZE);
+
+    return status;
+}
+
+/**
+  * @brief  Encrypts and authenticates in CCM mode (NIST SP 800-38C).
+  * @param  AES_Context: chaining modes context
+  * @param  Nonce: nonce, unique for each message with the same key
+  * @param  NonceSize: 7 to 13 bytes. The payload length must be lower than
+  *         2^(8 * (15 - NonceSize))
+  * @param  AData: associated data, authenticated but not encrypted
+  * @param  ADataLength: number of bytes of AData, may be 0
+  * @param  Input: plain text, no alignment required
+  * @param  Length: number of bytes, may be 0
+  * @param  Output: cipher text, no alignment required, may be Input
+  * @param  Tag: authentication tag
+  * @param  TagSize: 4, 6, 8, 10, 12, 14 or 16 bytes
+  * @retval SUCCESS, or ERROR on timeout, DMA transfer error or too long payload
+  */
+ErrorStatus AES_CCMEncrypt(AES_ContextTypeDef* AES_Context, const uint8_t* Nonce, uint32_t NonceSize,
+                           const uint8_t* AData, uint32_t ADataLength, const uint8_t* Input,
+                           uint32_t Length, uint8_t* Output, uint8_t* Tag, uint32_t TagSize)
+{
+    uint32_t mac[4];
+    uint32_t counter[4] = {0};
+    ErrorStatus status;
+
+    /* Check the parameters */
+    assert_param(IS_AES_CCM_NONCE_SIZE(NonceSize));
+    assert_param(IS_AES_CCM_TAG_SIZE(TagSize));
+
+    if ((NonceSize > 11) && ((Length >> (8 * (15 - NonceSize))) != 0))
+    {
+        return ERROR;
+    }
+
+    status = AES_CoreStart(AES_Context, AES_Operation_Encryp);
+
+    /* MAC of the plain text first, Output may be Input */
+    if (status == SUCCESS)
+    {
+        status = AES_CCMMac(AES_Context, Nonce, NonceSize, AData, ADataLength, Input, Length, TagSize, mac);
+    }
+
+    /* Counter block 0 encrypts the MAC, the payload starts at block 1 */
+    ((uint8_t*)counter)[0] = (uint8_t)(14 - NonceSize);
+    memcpy(&((uint8_t*)counter)[1], Nonce, NonceSize);
+
+    if (status == SUCCESS)
+    {
+        status = AES_CTRRun(AES_Context, (uint8_t*)counter, (const uint8_t*)mac, TagSize, Tag);
+    }
+
+    if (status == SUCCESS)
+    {
+        status = AES_CTRRun(AES_Context, (uint8_t*)counter, Input, Length, Output);
+    }
+
+    AES_CoreStop(AES_Context);
+
+    return status;
+}
+
+/**
+  * @brief  Decrypts and verifies in CCM mode (NIST SP 800-38C).
+  * @param  AES_Context: chaining modes context
+  * @param  Nonce, NonceSize, AData, ADataLength: see AES_CCMEncrypt()
+  * @param  Input: cipher text, no alignment required
+  * @param  Length: number of bytes, may be 0
+  * @param  Output: plain text, no alignment required, may be Input. It is
+  *         cleared if the tag does not match
+  * @param  Tag: received authentication tag
+  * @param  TagSize: 4, 6, 8, 10, 12, 14 or 16 bytes
+  * @retval SUCCESS if the tag matches, ERROR otherwise or on timeout, DMA
+  *         transfer error or too long payload
+  */
+ErrorStatus AES_CCMDecrypt(AES_ContextTypeDef* AES_Context, const uint8_t* Nonce, uint32_t NonceSize,
+                           const uint8_t* AData, uint32_t ADataLength, const uint8_t* Input,
+                           uint32_t Length, uint8_t* Output, const uint8_t* Tag, uint32_t TagSize)
+{
+    uint32_t mac[4];
+    uint32_t counter[4] = {0};
+    uint32_t stream[4] = {0};
+    ErrorStatus status;
+    uint8_t diff = 0;
+    uint32_t i;
+
+    /* Check the parameters */
+    assert_param(IS_AES_CCM_NONCE_SIZE(NonceSize));
+    assert_param(IS_AES_CCM_TAG_SIZE(TagSize));
+
+    if ((NonceSize > 11) && ((Length >> (8 * (15 - NonceSize))) != 0))
+    {
+        return ERROR;
+    }
+
+    status = AES_CoreStart(AES_Context, AES_Operation_Encryp);
+
+    ((uint8_t*)counter)[0] = (uint8_t)(14 - NonceSize);
+    memcpy(&((uint8_t*)counter)[1], Nonce, NonceSize);
+
+    /* Key stream block 0 encrypts the MAC */
+    if (status == SUCCESS)
+    {
+        status = AES_CTRRun(AES_Context, (uint8_t*)counter, (const uint8_t*)stream, AES_BLOCK_SIZE,
+                            (uint8_t*)stream);
+    }
+
+    if (status == SUCCESS)
+    {
+        status = AES_CTRRun(AES_Context, (uint8_t*)counter, Input, Length, Output);
+    }
+
+    if (status == SUCCESS)
+    {
+        status = AES_CCMMac(AES_Context, Nonce, NonceSize, AData, ADataLength, Output, Length, TagSize, mac);
+    }
+
+    AES_CoreStop(AES_Context);
+
+    /* Compare all bytes, whatever the first difference */
+    for (i = 0; i < TagSize; i++)
+    {
+        diff |= (uint8_t)(((uint8_t*)mac)[i] ^ ((uint8_t*)stream)[i] ^ Tag[i]);
+    }
+
+    if ((status != SUCCESS) || (diff != 0))
+    {
+        memset(Output, 0, Length);
+        status = ERROR;
+    }
+
+    return status;
+}
+
+/**
+  * @}
+  */
+
+/** @defgroup AES_Group6 Software model functions
+ *  @brief   AES computed by the CPU.
+ *
+@verbatim
+ ===============================================================================
+                    ##### Software model functions #####
+ ===============================================================================
+    [..] A byte oriented AES (FIPS 197) giving the same results as the core
+         for all key sizes. It is used by the chaining modes when the
+         context has a model, to check the results of the core on the
+         target, or to check the chaining modes and measure their cost on a
+         host. It does not resist timing attacks: the core must be used for
+         secret keys on the target.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Multiplies by x in GF(2^8).
+  * @param  Value: byte
+  * @retval Value.x
+  */
+static uint8_t AES_ModelXtime(uint8_t Value)
+{
+    return (uint8_t)((Value << 1) ^ (((Value & 0x80) != 0) ? 0x1B : 0x00));
+}
+
+/**
+  * @brief  Multiplies two elements of GF(2^8).
+  * @param  Value1, Value2: bytes
+  * @retval Value1.Value2
+  */
+static uint8_t AES_ModelMultiply(uint8_t Value1, uint8_t Value2)
+{
+    uint8_t result = 0;
+
+    while (Value2 != 0)
+    {
+        if ((Value2 & 1) != 0)
+        {
+            result ^= Value1;
+        }
+
+        Value1 = AES_ModelXtime(Value1);
+        Value2 >>= 1;
+    }
+
+    return result;
+}
+
+/**
+  * @brief  Computes the round keys of the software model.
+  * @param  AES_Model: software model
+  * @param  Key: key, no alignment required
+  * @param  KeySize: AES_KEYSIZE_128B, AES_KEYSIZE_192B or AES_KEYSIZE_256B
+  * @retval None
+  */
+void AES_ModelKeyInit(AES_ModelTypeDef* AES_Model, const uint8_t* Key, uint32_t KeySize)
+{
+    uint32_t nk = 4 + 2 * KeySize;
+    uint32_t i;
+    uint8_t rcon = 0x01;
+    uint8_t temp[4];
+    uint8_t t;
+
+    /* Check the parameters */
+    assert_param(IS_AES_KEYSIZE(KeySize));
+
+    AES_Model->Rounds = nk + 6;
+    memcpy(AES_Model->RoundKey, Key, nk * 4);
+
+    for (i = nk; i < 4 * (AES_Model->Rounds + 1); i++)
+    {
+        memcpy(temp, &AES_Model->RoundKey[(i - 1) * 4], 4);
+
+        if ((i % nk) == 0)
+        {
+            t = temp[0];
+            temp[0] = (uint8_t)(AesSbox[temp[1]] ^ rcon);
+            temp[1] = AesSbox[temp[2]];
+            temp[2] = AesSbox[temp[3]];
+            temp[3] = AesSbox[t];
+            rcon = AES_ModelXtime(rcon);
+        }
+        else if ((nk > 6) && ((i % nk) == 4))
+        {
+            temp[0] = AesSbox[temp[0]];
+            temp[1] = AesSbox[temp[1]];
+            temp[2] = AesSbox[temp[2]];
+            temp[3] = AesSbox[temp[3]];
+        }
+
+        AES_Model->RoundKey[i * 4] = AES_Model->RoundKey[(i - nk) * 4] ^ temp[0];
+        AES_Model->RoundKey[i * 4 + 1] = AES_Model->RoundKey[(i - nk) * 4 + 1] ^ temp[1];
+        AES_Model->RoundKey[i * 4 + 2] = AES_Model->RoundKey[(i - nk) * 4 + 2] ^ temp[2];
+        AES_Model->RoundKey[i * 4 + 3] = AES_Model->RoundKey[(i - nk) * 4 + 3] ^ temp[3];
+    }
+}
+
+/**
+  * @brief  Encrypts one block with the software model.
+  * @param  AES_Model: software model
+  * @param  Input: plain text block, no alignment required
+  * @param  Output: cipher text block, no alignment required, may be Input
+  * @retval None
+  */
+void AES_ModelEncrypt(const AES_ModelTypeDef* AES_Model, const uint8_t* Input, uint8_t* Output)
+{
+    const uint8_t* pkey = AES_Model->RoundKey;
+    uint8_t state[AES_BLOCK_SIZE];
+    uint8_t temp[AES_BLOCK_SIZE];
+    uint32_t round;
+    uint32_t i;
+    uint8_t a0, a1, a2, a3, all;
+
+    for (i = 0; i < AES_BLOCK_SIZE; i++)
+    {
+        state[i] = Input[i] ^ *pkey++;
+    }
+
+    for (round = 1; round <= AES_Model->Rounds; round++)
+    {
+        /* SubBytes and ShiftRows: byte r of column c comes from column c + r */
+        for (i = 0; i < AES_BLOCK_SIZE; i++)
+        {
+            temp[i] = AesSbox[state[(i + 4 * (i & 3)) & 15]];
+        }
+
+        /* MixColumns, except in the last round */
+        for (i = 0; i < AES_BLOCK_SIZE; i += 4)
+        {
+            a0 = temp[i];
+            a1 = temp[i + 1];
+            a2 = temp[i + 2];
+            a3 = temp[i + 3];
+
+            if (round != AES_Model->Rounds)
+            {
+                all = a0 ^ a1 ^ a2 ^ a3;
+                temp[i] ^= all ^ AES_ModelXtime(a0 ^ a1);
+                temp[i + 1] ^= all ^ AES_ModelXtime(a1 ^ a2);
+                temp[i + 2] ^= all ^ AES_ModelXtime(a2 ^ a3);
+                temp[i + 3] ^= all ^ AES_ModelXtime(a3 ^ a0);
+            }
+
+            state[i] = temp[i] ^ *pkey++;
+            state[i + 1] = temp[i + 1] ^ *pkey++;
+            state[i + 2] = temp[i + 2] ^ *pkey++;
+            state[i + 3] = temp[i + 3] ^ *pkey++;
+        }
+    }
+
+    memcpy(Output, state, AES_BLOCK_SIZE);
+}
+
+/**
+  * @brief  Decrypts one block with the software model.
+  * @param  AES_Model: software model
+  * @param  Input: cipher text block, no alignment required
+  * @param  Output: plain text block, no alignment required, may be Input
+  * @retval None
+  */
+void AES_ModelDecrypt(const AES_ModelTypeDef* AES_Model, const uint8_t* Input, uint8_t* Output)
+{
+    const uint8_t* pkey = &AES_Model->RoundKey[AES_Model->Rounds * AES_BLOCK_SIZE];
+    uint8_t state[AES_BLOCK_SIZE];
+    uint8_t temp[AES_BLOCK_SIZE];
+    uint32_t round;
+    uint32_t i;
+    uint8_t a0, a1, a2, a3;
+
+    for (i = 0; i < AES_BLOCK_SIZE; i++)
+    {
+        state[i] = Input[i] ^ pkey[i];
+    }
+
+    for (round = AES_Model->Rounds; round != 0; round--)
+    {
+        /* InvShiftRows and InvSubBytes: byte r of column c comes from column c - r */
+        for (i = 0; i < AES_BLOCK_SIZE; i++)
+        {
+            temp[i] = AesInvSbox[state[(i + 12 * (i & 3)) & 15]];
+        }
+
+        /* AddRoundKey, then InvMixColumns except in the last round */
+        pkey -= AES_BLOCK_SIZE;
+
+        for (i = 0; i < AES_BLOCK_SIZE; i += 4)
+        {
+            a0 = temp[i] ^ pkey[i];
+            a1 = temp[i + 1] ^ pkey[i + 1];
+            a2 = temp[i + 2] ^ pkey[i + 2];
+            a3 = temp[i + 3] ^ pkey[i + 3];
+
+            if (round != 1)
+            {
+                state[i] = AES_ModelMultiply(a0, 14) ^ AES_ModelMultiply(a1, 11)
+                           ^ AES_ModelMultiply(a2, 13) ^ AES_ModelMultiply(a3, 9);
+                state[i + 1] = AES_ModelMultiply(a0, 9) ^ AES_ModelMultiply(a1, 14)
+                               ^ AES_ModelMultiply(a2, 11) ^ AES_ModelMultiply(a3, 13);
+                state[i + 2] = AES_ModelMultiply(a0, 13) ^ AES_ModelMultiply(a1, 9)
+                               ^ AES_ModelMultiply(a2, 14) ^ AES_ModelMultiply(a3, 11);
+                state[i + 3] = AES_ModelMultiply(a0, 11) ^ AES_ModelMultiply(a1, 13)
+                               ^ AES_ModelMultiply(a2, 9) ^ AES_ModelMultiply(a3, 14);
+            }
+            else
+            {
+                state[i] = a0;
+                state[i + 1] = a1;
+                state[i + 2] = a2;
+                state[i + 3] = a3;
+            }
+        }
+    }
+
+    memcpy(Output, state, AES_BLOCK_SIZE);
+}
+
+/**
+  * @}
+  */
+
+/** @defgroup AES_Group7 Random bit generator functions
+ *  @brief   CTR_DRBG on the AES core.
+ *
+@verbatim
+ ===============================================================================
+                    ##### Random bit generator functions #####
+ ===============================================================================
+    [..] CTR_DRBG of NIST SP 800-90A with AES-128 and the derivation function:
+         security strength 128 bits, seedlen AES_DRBG_SEED_SIZE bytes. The
+         entropy input does not need full entropy, it is compressed by the
+         derivation function: the caller gives enough bytes for 128 bits of
+         entropy, and a nonce of at least 64 bits at instantiation.
+    [..] The output is the CTR key stream of the DRBG key: with DMA channels
+         in the context, bulk requests are served at the speed of the core
+         and the entropy source is only read for the reseeds.
+    [..] AES_DRBGGenerate() reseeds through the GetEntropy callback once
+         ReseedInterval requests were served since the last seed. When no
+         entropy is available it keeps generating, up to
+         AES_DRBG_RESEED_LIMIT requests, then returns ERROR until
+         AES_DRBGReseed() is called.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Derivation function Block_Cipher_df, returns AES_DRBG_SEED_SIZE
+  *         bytes from the concatenation of the input strings.
+  * @param  AES_Context: chaining modes context, its key is overwritten
+  * @param  Input: input strings, an entry may be NULL if its length is 0
+  * @param  Length: number of bytes of each input string
+  * @param  Count: number of input strings
+  * @param  Seed: AES_DRBG_SEED_SIZE bytes, 32 bits aligned
+  * @retval SUCCESS, or ERROR on timeout
+  */
+static ErrorStatus AES_DRBGDerive(AES_ContextTypeDef* AES_Context, const uint8_t* const* Input,
+                                  const uint32_t* Length, uint32_t Count, uint32_t* Seed)
+{
+    static const uint8_t dfkey[16] =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+    };
+    static const uint8_t padding[AES_BLOCK_SIZE] = {0x80};
+    uint32_t chain[4];
+    uint8_t iv[AES_BLOCK_SIZE] = {0};
+    uint8_t header[8];
+    ErrorStatus status;
+    uint32_t total = 0;
+    uint32_t fill;
+    uint32_t i;
+    uint32_t j;
+
+    for (j = 0; j < Count; j++)
+    {
+        total += Length[j];
+    }
+
+    /* L and N, big endian */
+    header[0] = (uint8_t)(total >> 24);
+    header[1] = (uint8_t)(total >> 16);
+    header[2] = (uint8_t)(total >> 8);
+    header[3] = (uint8_t)total;
+    header[4] = 0;
+    header[5] = 0;
+    header[6] = 0;
+    header[7] = (uint8_t)AES_DRBG_SEED_SIZE;
+
+    /* BCC(K, IV || L || N || input || 0x80 || 0 padding) for IV = 0 and 1 */
+    AES_ModeInit(AES_Context, dfkey, AES_KEYSIZE_128B);
+    status = AES_CoreStart(AES_Context, AES_Operation_Encryp);
+
+    for (i = 0; (i < 2) && (status == SUCCESS); i++)
+    {
+        memset(chain, 0, sizeof(chain));
+        fill = 0;
+        iv[3] = (uint8_t)i;
+
+        status = AES_MACUpdate(AES_Context, chain, &fill, iv, AES_BLOCK_SIZE);
+
+        if (status == SUCCESS)
+        {
+            status = AES_MACUpdate(AES_Context, chain, &fill, header, sizeof(header));
+        }
+
+        for (j = 0; (j < Count) && (status == SUCCESS); j++)
+        {
+            status = AES_MACUpdate(AES_Context, chain, &fill, Input[j], Length[j]);
+        }
+
+        if (status == SUCCESS)
+        {
+            status = AES_MACUpdate(AES_Context, chain, &fill, padding, AES_BLOCK_SIZE - fill);
+        }
+
+        memcpy(&Seed[i * 4], chain, AES_BLOCK_SIZE);
+    }
+
+    AES_CoreStop(AES_Context);
+
+    /* K is the first block, X the second one, the result is E(K, X) then
+       E(K, E(K, X)) */
+    if (status == SUCCESS)
+    {
+        AES_ModeInit(AES_Context, (const uint8_t*)Seed, AES_KEYSIZE_128B);
+        status = AES_CoreStart(AES_Context, AES_Operation_Encryp);
+
+        if (status == SUCCESS)
+        {
+            status = AES_CoreBlock(AES_Context, &Seed[4], &Seed[0]);
+        }
+
+        if (status == SUCCESS)
+        {
+            status = AES_CoreBlock(AES_Context, &Seed[0], &Seed[4]);
+        }
+
+        AES_CoreStop(AES_Context);
+    }
+
+    memset(chain, 0, sizeof(chain));
+
+    return status;
+}
+
+/**
+  * @brief  Sets the working state from the CTR_DRBG_Update key stream.
+  * @param  AES_DRBG: DRBG state
+  * @param  Stream: AES_DRBG_SEED_SIZE bytes of key stream, cleared on return
+  * @param  Provided: AES_DRBG_SEED_SIZE bytes XORed with Stream, NULL for zeros
+  * @retval None
+  */
+static void AES_DRBGSetState(AES_DRBGTypeDef* AES_DRBG, uint32_t* Stream, const uint32_t* Provided)
+{
+    uint32_t i;
+
+    if (Provided != NULL)
+    {
+        for (i = 0; i < AES_DRBG_SEED_SIZE / 4; i++)
+        {
+            Stream[i] ^= Provided[i];
+        }
+    }
+
+    memcpy(AES_DRBG->Key, Stream, 16);
+    memcpy(AES_DRBG->V, &Stream[4], 16);
+    memset(Stream, 0, AES_DRBG_SEED_SIZE);
+}
+
+/**
+  * @brief  CTR_DRBG_Update: new key and V from the current ones.
+  * @param  AES_DRBG: DRBG state
+  * @param  Provided: AES_DRBG_SEED_SIZE bytes, 32 bits aligned
+  * @retval SUCCESS, or ERROR on timeout
+  */
+static ErrorStatus AES_DRBGUpdate(AES_DRBGTypeDef* AES_DRBG, const uint32_t* Provided)
+{
+    uint32_t stream[AES_DRBG_SEED_SIZE / 4] = {0};
+    uint8_t counter[AES_BLOCK_SIZE];
+    ErrorStatus status;
+
+    memcpy(counter, AES_DRBG->V, AES_BLOCK_SIZE);
+    AES_CounterIncrement(counter);
+
+    AES_ModeInit(AES_DRBG->AES_Context, AES_DRBG->Key, AES_KEYSIZE_128B);
+    status = AES_CTRCrypt(AES_DRBG->AES_Context, counter, (const uint8_t*)stream, AES_DRBG_SEED_SIZE,
+                          (uint8_t*)stream);
+
+    AES_DRBGSetState(AES_DRBG, stream, Provided);
+
+    return status;
+}
+
+/**
+  * @brief  Instantiates a DRBG.
+  * @note   AES_Context, ReseedInterval and GetEntropy must be set before.
+  * @param  AES_DRBG: DRBG state
+  * @param  Entropy: entropy input, 128 bits of entropy at least
+  * @param  EntropyLength: number of bytes of Entropy
+  * @param  Nonce: nonce, 64 bits of entropy at least or a value never
+  *         repeated, may be NULL if NonceLength is 0
+  * @param  NonceLength: number of bytes of Nonce
+  * @param  Personal: personalization string, may be NULL if PersonalLength
+  *         is 0
+  * @param  PersonalLength: number of bytes of Personal
+  * @retval SUCCESS, or ERROR on timeout
+  */
+ErrorStatus AES_DRBGInstantiate(AES_DRBGTypeDef* AES_DRBG, const uint8_t* Entropy, uint32_t EntropyLength,
+                                const uint8_t* Nonce, uint32_t NonceLength, const uint8_t* Personal,
+                                uint32_t PersonalLength)
+{
+    const uint8_t* input[3];
+    uint32_t length[3];
+    uint32_t seed[AES_DRBG_SEED_SIZE / 4];
+    ErrorStatus status;
+
+    input[0] = Entropy;
+    input[1] = Nonce;
+    input[2] = Personal;
+    length[0] = EntropyLength;
+    length[1] = NonceLength;
+    length[2] = PersonalLength;
+
+    memset(AES_DRBG->Key, 0, sizeof(AES_DRBG->Key));
+    memset(AES_DRBG->V, 0, sizeof(AES_DRBG->V));
+    AES_DRBG->ReseedCounter = 0;
+    AES_DRBG->Reseeds = 0;
+
+    status = AES_DRBGDerive(AES_DRBG->AES_Context, input, length, 3, seed);
+
+    if (status == SUCCESS)
+    {
+        status = AES_DRBGUpdate(AES_DRBG, seed);
+    }
+
+    if (status == SUCCESS)
+    {
+        AES_DRBG->ReseedCounter = 1;
+    }
+
+    memset(seed, 0, sizeof(seed));
+
+    return status;
+}
+
+/**
+  * @brief  Reseeds a DRBG.
+  * @param  AES_DRBG: DRBG state, instantiated
+  * @param  Entropy: entropy input, 128 bits of entropy at least
+  * @param  EntropyLength: number of bytes of Entropy
+  * @param  AData: additional input, may be NULL if ADataLength is 0
+  * @param  ADataLength: number of bytes of AData
+  * @retval SUCCESS, or ERROR if not instantiated or on timeout
+  */
+ErrorStatus AES_DRBGReseed(AES_DRBGTypeDef* AES_DRBG, const uint8_t* Entropy, uint32_t EntropyLength,
+                           const uint8_t* AData, uint32_t ADataLength)
+{
+    const uint8_t* input[2];
+    uint32_t length[2];
+    uint32_t seed[AES_DRBG_SEED_SIZE / 4];
+    ErrorStatus status;
+
+    if (AES_DRBG->ReseedCounter == 0)
+    {
+        return ERROR;
+    }
+
+    input[0] = Entropy;
+    input[1] = AData;
+    length[0] = EntropyLength;
+    length[1] = ADataLength;
+
+    status = AES_DRBGDerive(AES_DRBG->AES_Context, input, length, 2, seed);
+
+    if (status == SUCCESS)
+    {
+        status = AES_DRBGUpdate(AES_DRBG, seed);
+    }
+
+    if (status == SUCCESS)
+    {
+        AES_DRBG->ReseedCounter = 1;
+    }
+
+    memset(seed, 0, sizeof(seed));
+
+    return status;
+}
+
+/**
+  * @brief  Generates random bytes.
+  * @note   The GetEntropy callback is called when a reseed is due, from the
+  *         context of the caller.
+  * @param  AES_DRBG: DRBG state, instantiated
+  * @param  Output: random bytes, no alignment required
+  * @param  Length: number of bytes, at most AES_DRBG_MAX_REQUEST
+  * @param  AData: additional input, may be NULL if ADataLength is 0
+  * @param  ADataLength: number of bytes of AData
+  * @retval SUCCESS, or ERROR if not instantiated, if a reseed is required,
+  *         if Length is too large or on timeout. Output is cleared on error.
+  */
+ErrorStatus AES_DRBGGenerate(AES_DRBGTypeDef* AES_DRBG, uint8_t* Output, uint32_t Length,
+                             const uint8_t* AData, uint32_t ADataLength)
+{
+    uint8_t entropy[AES_DRBG_ENTROPY_SIZE];
+    uint32_t additional[AES_DRBG_SEED_SIZE / 4];
+    uint32_t stream[AES_DRBG_SEED_SIZE / 4] = {0};
+    uint8_t counter[AES_BLOCK_SIZE];
+    const uint32_t* provided = NULL;
+    ErrorStatus status = SUCCESS;
+
+    memset(Output, 0, Length);
+
+    if ((AES_DRBG->ReseedCounter == 0) || (Length > AES_DRBG_MAX_REQUEST))
+    {
+        return ERROR;
+    }
+
+    /* The additional input is used by the reseed if there is one */
+    if ((AES_DRBG->ReseedCounter > AES_DRBG->ReseedInterval) && (AES_DRBG->GetEntropy != NULL))
+    {
+        if (AES_DRBG->GetEntropy(entropy, AES_DRBG_ENTROPY_SIZE) == SUCCESS)
+        {
+            status = AES_DRBGReseed(AES_DRBG, entropy, AES_DRBG_ENTROPY_SIZE, AData, ADataLength);
+            AES_DRBG->Reseeds += (status == SUCCESS) ? 1 : 0;
+            ADataLength = 0;
+        }
+
+        memset(entropy, 0, sizeof(entropy));
+    }
+
+    if (AES_DRBG->ReseedCounter > AES_DRBG_RESEED_LIMIT)
+    {
+        return ERROR;
+    }
+
+    if ((status == SUCCESS) && (ADataLength != 0))
+    {
+        status = AES_DRBGDerive(AES_DRBG->AES_Context, &AData, &ADataLength, 1, additional);
+
+        if (status == SUCCESS)
+        {
+            status = AES_DRBGUpdate(AES_DRBG, additional);
+            provided = additional;
+        }
+    }
+
+    /* Key stream of V + 1 onwards, the update continues from the last
+       counter value */
+    if (status == SUCCESS)
+    {
+        memcpy(counter, AES_DRBG->V, AES_BLOCK_SIZE);
+        AES_CounterIncrement(counter);
+
+        AES_ModeInit(AES_DRBG->AES_Context, AES_DRBG->Key, AES_KEYSIZE_128B);
+        status = AES_CoreStart(AES_DRBG->AES_Context, AES_Operation_Encryp);
+
+        if (status == SUCCESS)
+        {
+            status = AES_CTRRun(AES_DRBG->AES_Context, counter, Output, Length, Output);
+        }
+
+        if (status == SUCCESS)
+        {
+            status = AES_CTRRun(AES_DRBG->AES_Context, counter, (const uint8_t*)stream, AES_DRBG_SEED_SIZE,
+                                (uint8_t*)stream);
+        }
+
+        AES_CoreStop(AES_DRBG->AES_Context);
+    }
+
+    if (status == SUCCESS)
+    {
+        AES_DRBGSetState(AES_DRBG, stream, provided);
+        AES_DRBG->ReseedCounter++;
+    }
+    else
+    {
+        memset(Output, 0, Length);
+    }
+
+    memset(additional, 0, sizeof(additional));
+
+    return status;
+}
+
+/**
+  * @brief  Clears the state of a DRBG and the key of its context.
+  * @param  AES_DRBG: DRBG state
+  * @retval None
+  */
+void AES_DRBGUninstantiate(AES_DRBGTypeDef* AES_DRBG)
+{
+    memset(AES_DRBG->Key, 0, sizeof(AES_DRBG->Key));
+    memset(AES_DRBG->V, 0, sizeof(AES_DRBG->V));
+    memset(AES_DRBG->AES_Context->Key, 0, sizeof(AES_DRBG->AES_Context->Key));
+    AES_DRBG->ReseedCounter = 0;
+}
+
 /**
   * @}
   */
@@ -23,6 +23,13 @@
   */
 
 /* Private typedef -----------------------------------------------------------*/
+/* Filter pattern: identifier register image and mask of the compared bits */
+typedef struct
+{
+    uint32_t Value;
+    uint32_t Mask;
+} CAN_FilterPattern;
+
 /* Private define ------------------------------------------------------------*/
 /** @defgroup CAN_Private_Defines CAN_Private_Defines
   * @{
@@ -53,13 +60,37 @@
 #define CAN_FLAGS_ESR              ((uint32_t)0x00F00000)
 
 #define CAN_MODE_MASK              ((uint32_t) 0x00000003)
+
+/* Working patterns of CAN_FilterCompile(), four identifiers per filter bank */
+#define CAN_FILTER_MAX_PATTERNS    ((uint32_t)56)
+/* Number of filter banks */
+#define CAN_FILTER_BANKS           ((uint32_t)14)
 /**
   * @}
   */
 
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+/* Software queues, NULL until CAN_QueueInit() */
+static CAN_QueueTypeDef* CanQueue = 0;
+
 /* Private function prototypes -----------------------------------------------*/
+static void CAN_ReadFIFO(uint8_t FIFONumber, CanMailbox* Mailbox);
+static void CAN_DecodeMailbox(const CanMailbox* Mailbox, CanRxMsg* RxMessage);
+static void CAN_QueueDrainFIFO(uint8_t FIFONumber);
+static void CAN_QueueLoadMailboxes(void);
+static uint32_t CAN_FilterSize(const CAN_FilterPattern* Pattern);
+static uint32_t CAN_FilterUnits(const CAN_FilterPattern* Pattern);
+static uint32_t CAN_FilterBanks(const CAN_FilterPattern* pPatterns, uint32_t Count);
+static void CAN_FilterCover(const CAN_FilterPattern* pPatterns, uint32_t Count,
+                            CAN_FilterPattern* Pattern);
+static uint32_t CAN_FilterMerge(CAN_FilterPattern* pPatterns, uint32_t Count);
+static uint32_t CAN_FilterAdd(CAN_FilterPattern* pPatterns, uint32_t Count, uint32_t Value,
+                              uint32_t Mask);
+static uint16_t CAN_Filter16(uint32_t Word);
+static void CAN_FilterSetBank(CAN_FilterInitTypeDef* Filter, uint8_t Number, uint8_t FIFO,
+                              uint8_t Mode, uint8_t Scale, uint32_t FR1, uint32_t FR2);
+
 /* Private functions ---------------------------------------------------------*/
 
 /** @defgroup CAN_Exported_Functions CAN Exported Functions
@@ -314,6 +345,515 @@ void CAN_FilterInit(CAN_FilterInitTypeDef* CAN_FilterInitStruct)
     CAN->FMR &= ~FMR_FINIT;
 }
 
+/**
+  * @brief  Builds the filter banks accepting a set of identifiers.
+  * @note   Single identifiers are packed in list mode, four standard or two
+  *         extended per bank, and ranges are split in identifier/mask
+  *         filters. If the set does not fit in MaxBanks, the closest
+  *         patterns are merged until it fits, widening the accepted set:
+  *         pResult reports how many identifiers are then accepted by
+  *         mistake. The banks are to be written with CAN_FilterInit().
+  * @note   The merge search grows with the cube of the number of patterns:
+  *         call it once at initialization.
+  * @param  pRanges: identifier ranges to accept, not overlapping.
+  * @param  NbRanges: number of ranges.
+  * @param  FirstBank: first filter bank to use, 0 to 13.
+  * @param  MaxBanks: number of filter banks available from FirstBank, at least 1.
+  * @param  FIFO: FIFO assigned to the filters, CAN_Filter_FIFO0 or CAN_Filter_FIFO1.
+  * @param  pFilters: receives the filter banks, MaxBanks entries.
+  * @param  pResult: receives the number of banks and of accepted identifiers.
+  * @retval None.
+  */
+void CAN_FilterCompile(const CAN_FilterRangeTypeDef* pRanges, uint32_t NbRanges, uint8_t FirstBank,
+                       uint8_t MaxBanks, uint8_t FIFO, CAN_FilterInitTypeDef* pFilters,
+                       CAN_FilterResultTypeDef* pResult)
+{
+    CAN_FilterPattern patterns[CAN_FILTER_MAX_PATTERNS];
+    uint32_t count = 0;
+    uint32_t index;
+    uint32_t first;
+    uint32_t last;
+    uint32_t bits;
+    uint32_t block;
+    uint32_t exact;
+    uint32_t slots;
+    uint32_t fr[4];
+    uint32_t nb;
+    uint8_t bank = FirstBank;
+
+    /* Check the parameters */
+    assert_param(IS_CAN_FILTER_NUMBER(FirstBank));
+    assert_param((MaxBanks != 0) && ((FirstBank + MaxBanks) <= CAN_FILTER_BANKS));
+    assert_param(IS_CAN_FILTER_FIFO(FIFO));
+
+    pResult->Requested = 0;
+
+    /* Split the ranges in aligned power of two blocks */
+    for (index = 0; index < NbRanges; index++)
+    {
+        assert_param(IS_CAN_IDTYPE(pRanges[index].IDE));
+        assert_param(IS_CAN_RTR(pRanges[index].RTR));
+        assert_param(pRanges[index].IdFirst <= pRanges[index].IdLast);
+
+        first = pRanges[index].IdFirst;
+        last = pRanges[index].IdLast;
+        bits = (pRanges[index].IDE == CAN_Id_Standard) ? 11 : 29;
+
+        assert_param(last < ((uint32_t)1 << bits));
+
+        pResult->Requested += last - first + 1;
+
+        for (;;)
+        {
+            block = 0;
+
+            while ((block < bits) && ((first & ((2U << block) - 1)) == 0) &&
+                    ((first + ((2U << block) - 1)) <= last))
+            {
+                block++;
+            }
+
+            if (bits == 11)
+            {
+                count = CAN_FilterAdd(patterns, count, (first << 21) | pRanges[index].RTR,
+                                      (((uint32_t)0x7FF << block) & 0x7FF) << 21 | 0x001FFFFF);
+            }
+            else
+            {
+                count = CAN_FilterAdd(patterns, count,
+                                      (first << 3) | CAN_Id_Extended | pRanges[index].RTR,
+                                      (((uint32_t)0x1FFFFFFF << block) & 0x1FFFFFFF) << 3 | 0x7);
+            }
+
+            if ((last - first) < ((uint32_t)1 << block))
+            {
+                break;
+            }
+
+            first += (uint32_t)1 << block;
+        }
+    }
+
+    /* Widen the set until it fits */
+    while (CAN_FilterBanks(patterns, count) > MaxBanks)
+    {
+        nb = count;
+        count = CAN_FilterMerge(patterns, count);
+
+        if (count == nb)
+        {
+            /* Standard and extended identifiers in one bank: accept all */
+            CAN_FilterSetBank(&pFilters[0], bank, FIFO, CAN_FilterMode_IdMask,
+                              CAN_FilterScale_32bit, 0, 0);
+            pResult->NbBanks = 1;
+            pResult->Accepted = 2 * ((uint32_t)0x800 + (uint32_t)0x20000000);
+            return;
+        }
+    }
+
+    pResult->Accepted = 0;
+    exact = 0;
+    slots = 0;
+
+    for (index = 0; index < count; index++)
+    {
+        pResult->Accepted += CAN_FilterSize(&patterns[index]);
+
+        if ((patterns[index].Value & CAN_Id_Extended) == 0)
+        {
+            if (patterns[index].Mask == 0xFFFFFFFF)
+            {
+                exact++;
+            }
+            else
+            {
+                slots++;
+            }
+        }
+    }
+
+    /* Leftover standard identifiers go to the identifier/mask slots when it
+       saves a bank, as counted by CAN_FilterBanks() */
+    nb = exact & 3;
+
+    if (((slots + nb + 1) / 2) < (1 + (slots + 1) / 2))
+    {
+        exact -= nb;
+    }
+
+    /* 32-bit banks for the extended identifiers */
+    nb = 0;
+
+    for (index = 0; index < count; index++)
+    {
+        if ((patterns[index].Value & CAN_Id_Extended) == 0)
+        {
+            continue;
+        }
+
+        if (patterns[index].Mask != 0xFFFFFFFF)
+        {
+            CAN_FilterSetBank(pFilters++, bank++, FIFO, CAN_FilterMode_IdMask,
+                              CAN_FilterScale_32bit, patterns[index].Value, patterns[index].Mask);
+        }
+        else if (nb == 0)
+        {
+            fr[0] = patterns[index].Value;
+            nb = 1;
+        }
+        else
+        {
+            CAN_FilterSetBank(pFilters++, bank++, FIFO, CAN_FilterMode_IdList,
+                              CAN_FilterScale_32bit, fr[0], patterns[index].Value);
+            nb = 0;
+        }
+    }
+
+    if (nb != 0)
+    {
+        CAN_FilterSetBank(pFilters++, bank++, FIFO, CAN_FilterMode_IdList,
+                          CAN_FilterScale_32bit, fr[0], fr[0]);
+    }
+
+    /* 16-bit list banks for the standard identifiers */
+    nb = 0;
+
+    for (index = 0; (index < count) && (exact != 0); index++)
+    {
+        if (((patterns[index].Value & CAN_Id_Extended) != 0) || (patterns[index].Mask != 0xFFFFFFFF))
+        {
+            continue;
+        }
+
+        fr[nb++] = CAN_Filter16(patterns[index].Value);
+        exact--;
+        /* Taken out of the identifier/mask slots below */
+        patterns[index].Mask = 0;
+
+        if ((nb == 4) || (exact == 0))
+        {
+            while (nb < 4)
+            {
+                fr[nb] = fr[nb - 1];
+                nb++;
+            }
+
+            CAN_FilterSetBank(pFilters++, bank++, FIFO, CAN_FilterMode_IdList,
+                              CAN_FilterScale_16bit, (fr[1] << 16) | fr[0], (fr[3] << 16) | fr[2]);
+            nb = 0;
+        }
+    }
+
+    /* 16-bit identifier/mask banks for the standard blocks and leftovers */
+    for (index = 0; index < count; index++)
+    {
+        if (((patterns[index].Value & CAN_Id_Extended) != 0) || (patterns[index].Mask == 0))
+        {
+            continue;
+        }
+
+        fr[nb++] = ((uint32_t)CAN_Filter16(patterns[index].Mask) << 16) |
+                   CAN_Filter16(patterns[index].Value);
+
+        if (nb == 2)
+        {
+            CAN_FilterSetBank(pFilters++, bank++, FIFO, CAN_FilterMode_IdMask,
+                              CAN_FilterScale_16bit, fr[0], fr[1]);
+            nb = 0;
+        }
+    }
+
+    if (nb != 0)
+    {
+        CAN_FilterSetBank(pFilters++, bank++, FIFO, CAN_FilterMode_IdMask,
+                          CAN_FilterScale_16bit, fr[0], fr[0]);
+    }
+
+    pResult->NbBanks = bank - FirstBank;
+}
+
+/**
+  * @brief  Returns the number of frame identifiers matched by a pattern.
+  * @param  Pattern: filter pattern.
+  * @retval Number of identifiers.
+  */
+static uint32_t CAN_FilterSize(const CAN_FilterPattern* Pattern)
+{
+    uint32_t free = ~Pattern->Mask;
+    uint32_t size = 1;
+
+    while (free != 0)
+    {
+        free &= free - 1;
+        size <<= 1;
+    }
+
+    return size;
+}
+
+/**
+  * @brief  Returns the filter bank space used by a pattern, in quarters of a bank.
+  * @param  Pattern: filter pattern.
+  * @retval Number of quarters.
+  */
+static uint32_t CAN_FilterUnits(const CAN_FilterPattern* Pattern)
+{
+    uint32_t units = (Pattern->Mask == 0xFFFFFFFF) ? 1 : 2;
+
+    /* Extended identifiers take a 32-bit filter */
+    if ((Pattern->Value & CAN_Id_Extended) != 0)
+    {
+        units <<= 1;
+    }
+
+    return units;
+}
+
+/**
+  * @brief  Returns the number of filter banks needed by a set of patterns.
+  * @param  pPatterns: filter patterns.
+  * @param  Count: number of patterns.
+  * @retval Number of filter banks.
+  */
+static uint32_t CAN_FilterBanks(const CAN_FilterPattern* pPatterns, uint32_t Count)
+{
+    uint32_t exact[2] = {0, 0};
+    uint32_t masked[2] = {0, 0};
+    uint32_t index;
+    uint32_t type;
+    uint32_t left;
+    uint32_t banks;
+
+    for (index = 0; index < Count; index++)
+    {
+        type = (pPatterns[index].Value & CAN_Id_Extended) >> 2;
+
+        if (pPatterns[index].Mask == 0xFFFFFFFF)
+        {
+            exact[type]++;
+        }
+        else
+        {
+            masked[type]++;
+        }
+    }
+
+    /* Extended identifiers: 2 per list bank, 1 per identifier/mask bank */
+    banks = masked[1] + (exact[1] + 1) / 2;
+
+    /* Standard identifiers: 4 per list bank, 2 per identifier/mask bank */
+    banks += exact[0] / 4;
+    left = exact[0] & 3;
+
+    if ((left != 0) && (((masked[0] + left + 1) / 2) >= (1 + (masked[0] + 1) / 2)))
+    {
+        /* Leftover identifiers in a list bank */
+        banks += 1 + (masked[0] + 1) / 2;
+    }
+    else
+    {
+        /* Leftover identifiers in the free identifier/mask slots */
+        banks += (masked[0] + left + 1) / 2;
+    }
+
+    return banks;
+}
+
+/**
+  * @brief  Widens a pattern over the patterns it partly overlaps.
+  * @param  pPatterns: filter patterns, not overlapping.
+  * @param  Count: number of patterns.
+  * @param  Pattern: pattern to widen.
+  * @retval None.
+  */
+static void CAN_FilterCover(const CAN_FilterPattern* pPatterns, uint32_t Count,
+                            CAN_FilterPattern* Pattern)
+{
+    uint32_t index = 0;
+
+    while (index < Count)
+    {
+        if ((((Pattern->Value ^ pPatterns[index].Value) & Pattern->Mask & pPatterns[index].Mask) == 0) &&
+                ((pPatterns[index].Mask & Pattern->Mask) != Pattern->Mask))
+        {
+            Pattern->Mask &= pPatterns[index].Mask & ~(Pattern->Value ^ pPatterns[index].Value);
+            Pattern->Value &= Pattern->Mask;
+            index = 0;
+        }
+        else
+        {
+            index++;
+        }
+    }
+}
+
+/**
+  * @brief  Merges the two patterns which cost the fewest false accepts per
+  *         bank space saved, with the patterns the result covers.
+  * @param  pPatterns: filter patterns, not overlapping.
+  * @param  Count: number of patterns.
+  * @retval New number of patterns, Count if no patterns can be merged.
+  */
+static uint32_t CAN_FilterMerge(CAN_FilterPattern* pPatterns, uint32_t Count)
+{
+    CAN_FilterPattern merged;
+    CAN_FilterPattern best;
+    uint32_t bestcost = 0xFFFFFFFF;
+    uint32_t bestsaved = 0;
+    uint32_t found = 0;
+    uint32_t saved;
+    uint32_t cost;
+    uint32_t i;
+    uint32_t j;
+    uint32_t k;
+
+    for (i = 0; i < Count; i++)
+    {
+        for (j = i + 1; j < Count; j++)
+        {
+            /* Standard and extended identifiers use different filters */
+            if (((pPatterns[i].Value ^ pPatterns[j].Value) & CAN_Id_Extended) != 0)
+            {
+                continue;
+            }
+
+            merged.Mask = pPatterns[i].Mask & pPatterns[j].Mask &
+                          ~(pPatterns[i].Value ^ pPatterns[j].Value);
+            merged.Value = pPatterns[i].Value & merged.Mask;
+            CAN_FilterCover(pPatterns, Count, &merged);
+
+            /* Identifiers and bank space of the covered patterns */
+            cost = CAN_FilterSize(&merged);
+            saved = 0;
+
+            for (k = 0; k < Count; k++)
+            {
+                if ((pPatterns[k].Value & merged.Mask) == merged.Value)
+                {
+                    cost -= CAN_FilterSize(&pPatterns[k]);
+                    saved += CAN_FilterUnits(&pPatterns[k]);
+                }
+            }
+
+            saved -= CAN_FilterUnits(&merged);
+
+            if (saved != 0)
+            {
+                cost /= saved;
+            }
+
+            /* Prefer the merges which save bank space */
+            if (((saved != 0) && (bestsaved == 0)) ||
+                    (((saved != 0) == (bestsaved != 0)) && (cost < bestcost)))
+            {
+                bestcost = cost;
+                bestsaved = saved;
+                best = merged;
+                found = 1;
+            }
+        }
+    }
+
+    if (found == 0)
+    {
+        return Count;
+    }
+
+    return CAN_FilterAdd(pPatterns, Count, best.Value, best.Mask);
+}
+
+/**
+  * @brief  Adds a pattern to a set, widened over the patterns it partly
+  *         overlaps and replacing the patterns it covers.
+  * @note   When the set is full, patterns are merged to make room.
+  * @param  pPatterns: filter patterns, not overlapping.
+  * @param  Count: number of patterns.
+  * @param  Value: identifier register image of the pattern.
+  * @param  Mask: compared bits of the pattern.
+  * @retval New number of patterns.
+  */
+static uint32_t CAN_FilterAdd(CAN_FilterPattern* pPatterns, uint32_t Count, uint32_t Value,
+                              uint32_t Mask)
+{
+    CAN_FilterPattern pattern;
+    uint32_t index = 0;
+
+    pattern.Value = Value;
+    pattern.Mask = Mask;
+    CAN_FilterCover(pPatterns, Count, &pattern);
+
+    while (index < Count)
+    {
+        if ((pPatterns[index].Value & pattern.Mask) == pattern.Value)
+        {
+            pPatterns[index] = pPatterns[--Count];
+        }
+        else
+        {
+            index++;
+        }
+    }
+
+    if (Count == CAN_FILTER_MAX_PATTERNS)
+    {
+        Count = CAN_FilterMerge(pPatterns, Count);
+
+        return CAN_FilterAdd(pPatterns, Count, pattern.Value, pattern.Mask);
+    }
+
+    pPatterns[Count] = pattern;
+
+    return Count + 1;
+}
+
+/**
+  * @brief  Converts an identifier register image to the 16-bit filter layout.
+  * @param  Word: identifier register image or mask.
+  * @retval 16-bit filter value: STID[10:0], RTR, IDE, EXID[17:15].
+  */
+static uint16_t CAN_Filter16(uint32_t Word)
+{
+    return (uint16_t)(((Word >> 16) & 0xFFE0) | ((Word & 0x02) << 3) | ((Word & 0x04) << 1) |
+                      ((Word >> 18) & 0x07));
+}
+
+/**
+  * @brief  Fills a filter bank structure from the filter register images.
+  * @param  Filter: filter bank structure.
+  * @param  Number: filter bank number.
+  * @param  FIFO: FIFO assigned to the filter.
+  * @param  Mode: filter mode.
+  * @param  Scale: filter scale.
+  * @param  FR1: first filter register image.
+  * @param  FR2: second filter register image.
+  * @retval None.
+  */
+static void CAN_FilterSetBank(CAN_FilterInitTypeDef* Filter, uint8_t Number, uint8_t FIFO,
+                              uint8_t Mode, uint8_t Scale, uint32_t FR1, uint32_t FR2)
+{
+    Filter->CAN_FilterNumber = Number;
+    Filter->CAN_FilterMode = Mode;
+    Filter->CAN_FilterScale = Scale;
+    Filter->CAN_FilterFIFOAssignment = FIFO;
+    Filter->CAN_FilterActivation = ENABLE;
+
+    /* Same register mapping as CAN_FilterInit() */
+    if (Scale == CAN_FilterScale_32bit)
+    {
+        Filter->CAN_FilterIdHigh = (uint16_t)(FR1 >> 16);
+        Filter->CAN_FilterIdLow = (uint16_t)FR1;
+        Filter->CAN_FilterMaskIdHigh = (uint16_t)(FR2 >> 16);
+        Filter->CAN_FilterMaskIdLow = (uint16_t)FR2;
+    }
+    else
+    {
+        Filter->CAN_FilterIdLow = (uint16_t)FR1;
+        Filter->CAN_FilterMaskIdLow = (uint16_t)(FR1 >> 16);
+        Filter->CAN_FilterIdHigh = (uint16_t)FR2;
+        Filter->CAN_FilterMaskIdHigh = (uint16_t)(FR2 >> 16);
+    }
+}
+
 /**
   * @brief  Fills each CAN_InitStruct member with its default value.
   * @param  CAN_InitStruct: pointer to a CAN_InitTypeDef structure which
@@ -636,73 +1176,86 @@ uint16_t CAN_GetTransmitTimeStamp(uint8_t Mailbox)
   */
 void CAN_Receive(uint8_t FIFONumber, CanRxMsg* RxMessage)
 {
+    CanMailbox mailbox;
+
     /* Check the parameters */
     assert_param(IS_CAN_FIFO(FIFONumber));
 
-    if (FIFONumber == CAN_FIFO0)
-    {
-        /* Get the Id */
-        RxMessage->IDE = (uint8_t)0x04 & CAN->RI0R;
+    /* Read the mailbox and release the FIFO */
+    CAN_ReadFIFO(FIFONumber, &mailbox);
 
-        if (RxMessage->IDE == CAN_Id_Standard)
-        {
-            RxMessage->StdId = (uint32_t)0x000007FF & (CAN->RI0R >> 21);
-        }
-        else
-        {
-            RxMessage->ExtId = (uint32_t)0x1FFFFFFF & (CAN->RI0R >> 3);
-        }
+    CAN_DecodeMailbox(&mailbox, RxMessage);
+}
 
-        RxMessage->RTR = (uint8_t)0x02 & CAN->RI0R;
-        /* Get the DLC */
-        RxMessage->DLC = (uint8_t)0x0F & CAN->RDT0R;
-        /* Get the FMI */
-        RxMessage->FMI = (uint8_t)0xFF & (CAN->RDT0R >> 8);
-        /* Get the data field */
-        RxMessage->Data[0] = (uint8_t)0xFF & CAN->RDL0R;
-        RxMessage->Data[1] = (uint8_t)0xFF & (CAN->RDL0R >> 8);
-        RxMessage->Data[2] = (uint8_t)0xFF & (CAN->RDL0R >> 16);
-        RxMessage->Data[3] = (uint8_t)0xFF & (CAN->RDL0R >> 24);
-        RxMessage->Data[4] = (uint8_t)0xFF & CAN->RDH0R;
-        RxMessage->Data[5] = (uint8_t)0xFF & (CAN->RDH0R >> 8);
-        RxMessage->Data[6] = (uint8_t)0xFF & (CAN->RDH0R >> 16);
-        RxMessage->Data[7] = (uint8_t)0xFF & (CAN->RDH0R >> 24);
+/**
+  * @brief  Reads the output mailbox of a FIFO, one access per register, and
+  *         releases the FIFO.
+  * @param  FIFONumber: Receive FIFO number, CAN_FIFO0 or CAN_FIFO1.
+  * @param  Mailbox: receives the mailbox registers.
+  * @retval None.
+  */
+static void CAN_ReadFIFO(uint8_t FIFONumber, CanMailbox* Mailbox)
+{
+    if (FIFONumber == CAN_FIFO0)
+    {
+        Mailbox->IR = CAN->RI0R;
+        Mailbox->DTR = CAN->RDT0R;
+        Mailbox->DLR = CAN->RDL0R;
+        Mailbox->DHR = CAN->RDH0R;
 
         /* Release FIFO0 */
-        CAN->RF0R |= CAN_RF0R_RFOM0;
+        CAN->RF0R = CAN_RF0R_RFOM0;
     }
     else /* FIFONumber == CAN_FIFO1 */
     {
-        /* Get the Id */
-        RxMessage->IDE = (uint8_t)0x04 & CAN->RI1R;
+        Mailbox->IR = CAN->RI1R;
+        Mailbox->DTR = CAN->RDT1R;
+        Mailbox->DLR = CAN->RDL1R;
+        Mailbox->DHR = CAN->RDH1R;
 
-        if (RxMessage->IDE == CAN_Id_Standard)
-        {
-            RxMessage->StdId = (uint32_t)0x000007FF & (CAN->RI1R >> 21);
-        }
-        else
-        {
-            RxMessage->ExtId = (uint32_t)0x1FFFFFFF & (CAN->RI1R >> 3);
-        }
+        /* Release FIFO1 */
+        CAN->RF1R = CAN_RF1R_RFOM1;
+    }
+}
+
+/**
+  * @brief  Converts a received mailbox image to a message.
+  * @param  Mailbox: mailbox registers.
+  * @param  RxMessage: pointer to a structure receive message.
+  * @retval None.
+  */
+static void CAN_DecodeMailbox(const CanMailbox* Mailbox, CanRxMsg* RxMessage)
+{
+    uint32_t data;
 
-        RxMessage->RTR = (uint8_t)0x02 & CAN->RI1R;
-        /* Get the DLC */
-        RxMessage->DLC = (uint8_t)0x0F & CAN->RDT1R;
-        /* Get the FMI */
-        RxMessage->FMI = (uint8_t)0xFF & (CAN->RDT1R >> 8);
-        /* Get the data field */
-        RxMessage->Data[0] = (uint8_t)0xFF & CAN->RDL1R;
-        RxMessage->Data[1] = (uint8_t)0xFF & (CAN->RDL1R >> 8);
-        RxMessage->Data[2] = (uint8_t)0xFF & (CAN->RDL1R >> 16);
-        RxMessage->Data[3] = (uint8_t)0xFF & (CAN->RDL1R >> 24);
-        RxMessage->Data[4] = (uint8_t)0xFF & CAN->RDH1R;
-        RxMessage->Data[5] = (uint8_t)0xFF & (CAN->RDH1R >> 8);
-        RxMessage->Data[6] = (uint8_t)0xFF & (CAN->RDH1R >> 16);
-        RxMessage->Data[7] = (uint8_t)0xFF & (CAN->RDH1R >> 24);
+    /* Get the Id */
+    RxMessage->IDE = (uint8_t)0x04 & Mailbox->IR;
 
-        /* Release FIFO1 */
-        CAN->RF1R |= CAN_RF1R_RFOM1;
+    if (RxMessage->IDE == CAN_Id_Standard)
+    {
+        RxMessage->StdId = (uint32_t)0x000007FF & (Mailbox->IR >> 21);
     }
+    else
+    {
+        RxMessage->ExtId = (uint32_t)0x1FFFFFFF & (Mailbox->IR >> 3);
+    }
+
+    RxMessage->RTR = (uint8_t)0x02 & Mailbox->IR;
+    /* Get the DLC */
+    RxMessage->DLC = (uint8_t)0x0F & Mailbox->DTR;
+    /* Get the FMI */
+    RxMessage->FMI = (uint8_t)0xFF & (Mailbox->DTR >> 8);
+    /* Get the data field */
+    data = Mailbox->DLR;
+    RxMessage->Data[0] = (uint8_t)data;
+    RxMessage->Data[1] = (uint8_t)(data >> 8);
+    RxMessage->Data[2] = (uint8_t)(data >> 16);
+    RxMessage->Data[3] = (uint8_t)(data >> 24);
+    data = Mailbox->DHR;
+    RxMessage->Data[4] = (uint8_t)data;
+    RxMessage->Data[5] = (uint8_t)(data >> 8);
+    RxMessage->Data[6] = (uint8_t)(data >> 16);
+    RxMessage->Data[7] = (uint8_t)(data >> 24);
 }
 
 /**
@@ -1420,6 +1973,370 @@ ITStatus CAN_CheckITStatus(uint32_t CAN_Reg, uint32_t It_Bit)
 
     return pendingbitstatus;
 }
+
+/**
+  * @brief  Initializes the CAN software queues and enables their interrupts.
+  * @note   CAN_QueueIRQHandler() must be called from LCD_CAN_IRQHandler() and
+  *         the LCD_CAN_IRQn interrupt enabled in the NVIC.
+  * @param  Queue: queue state, kept by the driver.
+  * @param  pRxBuffer: RX ring of RxSize frames.
+  * @param  RxSize: RX ring size, a power of two.
+  * @param  pTxBuffer: TX queue of TxSize frames.
+  * @param  TxSize: TX queue size.
+  * @retval None.
+  */
+void CAN_QueueInit(CAN_QueueTypeDef* Queue, CanMailbox* pRxBuffer, uint16_t RxSize,
+                   CanMailbox* pTxBuffer, uint16_t TxSize)
+{
+    /* Check the parameters */
+    assert_param((RxSize != 0) && ((RxSize & (RxSize - 1)) == 0));
+    assert_param(TxSize != 0);
+
+    CAN->IER &= ~(CAN_IT_FMP0 | CAN_IT_FOV0 | CAN_IT_FMP1 | CAN_IT_FOV1 | CAN_IT_TME);
+
+    Queue->pRxBuffer = pRxBuffer;
+    Queue->RxSize = RxSize;
+    Queue->RxHead = 0;
+    Queue->RxTail = 0;
+    Queue->pTxBuffer = pTxBuffer;
+    Queue->TxSize = TxSize;
+    Queue->TxCount = 0;
+    Queue->RxFrames = 0;
+    Queue->RxDropped = 0;
+    Queue->RxOverrun = 0;
+    Queue->TxFrames = 0;
+    Queue->TxFailed = 0;
+    Queue->TxDropped = 0;
+    Queue->Monitor = 0;
+    CanQueue = Queue;
+
+    CAN->IER |= CAN_IT_FMP0 | CAN_IT_FOV0 | CAN_IT_FMP1 | CAN_IT_FOV1 | CAN_IT_TME;
+}
+
+/**
+  * @brief  Sets the function called with each frame received or sent by the
+  *         software queues.
+  * @note   Nothing is done before CAN_QueueInit().
+  * @param  Monitor: frame monitor, NULL to remove it.
+  * @retval None.
+  */
+void CAN_QueueSetMonitor(CAN_QueueMonitor Monitor)
+{
+    if (CanQueue == 0)
+    {
+        return;
+    }
+
+    CanQueue->Monitor = Monitor;
+}
+
+/**
+  * @brief  Queues a message for transmission.
+  * @note   Queued messages are sent by identifier priority, the highest
+  *         priority first. Messages with the same identifier are sent in
+  *         order.
+  * @param  TxMessage: pointer to a structure which contains CAN Id, CAN DLC and CAN data.
+  * @retval CAN_TxStatus_Pending if the message is queued, CAN_TxStatus_Failed
+  *         if the queue is full or CAN_QueueInit() was not called.
+  */
+uint8_t CAN_QueueTransmit(CanTxMsg* TxMessage)
+{
+    CAN_QueueTypeDef* Queue = CanQueue;
+    CanMailbox frame;
+    uint32_t index;
+    uint8_t status = CAN_TxStatus_Pending;
+
+    if (Queue == 0)
+    {
+        return CAN_TxStatus_Failed;
+    }
+
+    /* Check the parameters */
+    assert_param(IS_CAN_IDTYPE(TxMessage->IDE));
+    assert_param(IS_CAN_RTR(TxMessage->RTR));
+    assert_param(IS_CAN_DLC(TxMessage->DLC));
+
+    if (TxMessage->IDE == CAN_Id_Standard)
+    {
+        assert_param(IS_CAN_STDID(TxMessage->StdId));
+        frame.IR = (TxMessage->StdId << 21) | TxMessage->RTR;
+    }
+    else
+    {
+        assert_param(IS_CAN_EXTID(TxMessage->ExtId));
+        frame.IR = (TxMessage->ExtId << 3) | TxMessage->IDE | TxMessage->RTR;
+    }
+
+    frame.DTR = TxMessage->DLC & (uint8_t)0x0F;
+    frame.DLR = ((uint32_t)TxMessage->Data[3] << 24) | ((uint32_t)TxMessage->Data[2] << 16) |
+                ((uint32_t)TxMessage->Data[1] << 8) | ((uint32_t)TxMessage->Data[0]);
+    frame.DHR = ((uint32_t)TxMessage->Data[7] << 24) | ((uint32_t)TxMessage->Data[6] << 16) |
+                ((uint32_t)TxMessage->Data[5] << 8) | ((uint32_t)TxMessage->Data[4]);
+
+    /* Keep the transmit interrupt out of the queue, CAN_QueueIRQHandler()
+       skips the TX queue while it is masked */
+    CAN->IER &= ~CAN_IT_TME;
+
+    if (Queue->TxCount >= Queue->TxSize)
+    {
+        Queue->TxDropped++;
+        status = CAN_TxStatus_Failed;
+    }
+    else
+    {
+        /* The identifier register orders the frames as the bus arbitration
+           does: insert below the frames of higher or equal priority */
+        index = Queue->TxCount;
+
+        while ((index != 0) && (Queue->pTxBuffer[index - 1].IR <= frame.IR))
+        {
+            Queue->pTxBuffer[index] = Queue->pTxBuffer[index - 1];
+            index--;
+        }
+
+        Queue->pTxBuffer[index] = frame;
+        Queue->TxCount++;
+
+        CAN_QueueLoadMailboxes();
+    }
+
+    CAN->IER |= CAN_IT_TME;
+
+    return status;
+}
+
+/**
+  * @brief  Returns the number of messages waiting in the TX queue, the
+  *         messages already in a transmit mailbox excluded.
+  * @retval Number of messages, 0 before CAN_QueueInit().
+  */
+uint16_t CAN_QueueTxPending(void)
+{
+    if (CanQueue == 0)
+    {
+        return 0;
+    }
+
+    return CanQueue->TxCount;
+}
+
+/**
+  * @brief  Takes a message from the RX ring.
+  * @param  RxMessage: pointer to a structure receive message which contains
+  *         CAN Id, CAN DLC, CAN datas and FMI number.
+  * @retval 1 if a message is returned, 0 if the RX ring is empty or
+  *         CAN_QueueInit() was not called.
+  */
+uint8_t CAN_QueueReceive(CanRxMsg* RxMessage)
+{
+    CAN_QueueTypeDef* Queue = CanQueue;
+    uint16_t tail;
+
+    if (Queue == 0)
+    {
+        return 0;
+    }
+
+    tail = Queue->RxTail;
+
+    if (Queue->RxHead == tail)
+    {
+        return 0;
+    }
+
+    /* Read RxHead before the frame it covers */
+    __DMB();
+
+    CAN_DecodeMailbox(&Queue->pRxBuffer[tail & (Queue->RxSize - 1)], RxMessage);
+
+    /* Done with the frame before the interrupt may reuse it */
+    __DMB();
+    Queue->RxTail = tail + 1;
+
+    return 1;
+}
+
+/**
+  * @brief  Returns the number of messages waiting in the RX ring.
+  * @retval Number of messages, 0 before CAN_QueueInit().
+  */
+uint16_t CAN_QueueRxPending(void)
+{
+    if (CanQueue == 0)
+    {
+        return 0;
+    }
+
+    return (uint16_t)(CanQueue->RxHead - CanQueue->RxTail);
+}
+
+/**
+  * @brief  Moves the messages of a FIFO to the RX ring.
+  * @param  FIFONumber: Receive FIFO number, CAN_FIFO0 or CAN_FIFO1.
+  * @retval None.
+  */
+static void CAN_QueueDrainFIFO(uint8_t FIFONumber)
+{
+    CAN_QueueTypeDef* Queue = CanQueue;
+    CanMailbox discard;
+    CanMailbox* frame;
+    uint16_t head = Queue->RxHead;
+    /* RF0R and RF1R have the same layout */
+    __IO uint32_t* rfr = (FIFONumber == CAN_FIFO0) ? &CAN->RF0R : &CAN->RF1R;
+
+    if ((*rfr & CAN_RF0R_FOVR0) != 0)
+    {
+        Queue->RxOverrun++;
+        *rfr = CAN_RF0R_FOVR0;
+    }
+
+    while ((*rfr & CAN_RF0R_FMP0) != 0)
+    {
+        if ((uint16_t)(head - Queue->RxTail) >= Queue->RxSize)
+        {
+            frame = &discard;
+            Queue->RxDropped++;
+        }
+        else
+        {
+            frame = &Queue->pRxBuffer[head & (Queue->RxSize - 1)];
+            head++;
+            Queue->RxFrames++;
+        }
+
+        CAN_ReadFIFO(FIFONumber, frame);
+
+        if (Queue->Monitor != 0)
+        {
+            Queue->Monitor(frame, CAN_Monitor_Rx);
+        }
+    }
+
+    /* Publish the frames after they are stored */
+    __DMB();
+    Queue->RxHead = head;
+}
+
+/**
+  * @brief  Loads the empty transmit mailboxes from the TX queue.
+  * @note   Called with the transmit interrupt masked or from it.
+  * @retval None.
+  */
+static void CAN_QueueLoadMailboxes(void)
+{
+    CAN_QueueTypeDef* Queue = CanQueue;
+    CanMailbox* frame;
+    __IO uint32_t* mailbox;
+    uint32_t tsr = CAN->TSR;
+    uint32_t index;
+    uint32_t empty;
+
+    while (Queue->TxCount != 0)
+    {
+        frame = &Queue->pTxBuffer[Queue->TxCount - 1];
+        empty = 3;
+
+        for (index = 0; index < 3; index++)
+        {
+            mailbox = (__IO uint32_t*)((uint32_t)(&(CAN->TI0R)) + 0x10 * index);
+
+            if ((tsr & (CAN_TSR_TME0 << index)) != 0)
+            {
+                if (empty == 3)
+                {
+                    empty = index;
+                }
+            }
+            else if ((*mailbox & ~TMIDxR_TXRQ) == frame->IR)
+            {
+                /* The mailboxes would not keep the order of frames with the
+                   same identifier: wait for the pending one */
+                return;
+            }
+        }
+
+        if (empty == 3)
+        {
+            return;
+        }
+
+        mailbox = (__IO uint32_t*)((uint32_t)(&(CAN->TI0R)) + 0x10 * empty);
+        mailbox[1] = (mailbox[1] & (uint32_t)0xFFFFFFF0) | frame->DTR;
+        mailbox[2] = frame->DLR;
+        mailbox[3] = frame->DHR;
+        mailbox[0] = frame->IR | TMIDxR_TXRQ;
+
+        tsr &= ~(CAN_TSR_TME0 << empty);
+        Queue->TxCount--;
+    }
+}
+
+/**
+  * @brief  Handles the CAN interrupts of the software queues.
+  * @note   To be called from LCD_CAN_IRQHandler().
+  * @retval None.
+  */
+void CAN_QueueIRQHandler(void)
+{
+    CAN_QueueTypeDef* Queue = CanQueue;
+    CanMailbox frame;
+    __IO uint32_t* mailbox;
+    uint32_t tsr;
+    uint32_t index;
+
+    if (Queue == 0)
+    {
+        return;
+    }
+
+    CAN_QueueDrainFIFO(CAN_FIFO0);
+    CAN_QueueDrainFIFO(CAN_FIFO1);
+
+    /* The FIFO interrupts share the vector: while CAN_QueueTransmit() masks
+       the transmit interrupt to update the TX queue, leave it alone. The
+       completed requests raise the interrupt again once it is unmasked */
+    if ((CAN->IER & CAN_IT_TME) == 0)
+    {
+        return;
+    }
+
+    tsr = CAN->TSR & (CAN_TSR_RQCP0 | CAN_TSR_TXOK0 | CAN_TSR_RQCP1 | CAN_TSR_TXOK1 |
+                      CAN_TSR_RQCP2 | CAN_TSR_TXOK2);
+
+    if (tsr != 0)
+    {
+        for (index = 0; index < 3; index++)
+        {
+            if ((tsr & (CAN_TSR_RQCP0 << (8 * index))) != 0)
+            {
+                if ((tsr & (CAN_TSR_TXOK0 << (8 * index))) != 0)
+                {
+                    Queue->TxFrames++;
+
+                    if (Queue->Monitor != 0)
+                    {
+                        mailbox = (__IO uint32_t*)((uint32_t)(&(CAN->TI0R)) + 0x10 * index);
+                        frame.IR = mailbox[0];
+                        frame.DTR = mailbox[1];
+                        frame.DLR = mailbox[2];
+                        frame.DHR = mailbox[3];
+                        Queue->Monitor(&frame, CAN_Monitor_Tx);
+                    }
+                }
+                else
+                {
+                    Queue->TxFailed++;
+                }
+            }
+        }
+
+        /* Clear the request completed flags */
+        CAN->TSR = tsr & (CAN_TSR_RQCP0 | CAN_TSR_RQCP1 | CAN_TSR_RQCP2);
+
+        CAN_QueueLoadMailboxes();
+    }
+}
+
 /**
   * @}
   */
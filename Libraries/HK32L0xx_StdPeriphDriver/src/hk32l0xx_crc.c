@@ -11,6 +11,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "hk32l0xx_crc.h"
+#include "hk32l0xx_dma.h"
 
 /** @addtogroup HK32L0xx_StdPeriph_Driver
   * @{
@@ -23,9 +24,30 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+#define CRC_DMA_CHANNEL_SIZE          ((uint32_t)(DMA_Channel2_BASE - DMA_Channel1_BASE))
+
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+/* CRC of a nibble, MSB first */
+static const uint32_t CrcNibbleTable[16] =
+{
+    0x00000000, 0x04C11DB7, 0x09823B6E, 0x0D4326D9,
+    0x130476DC, 0x17C56B6B, 0x1A864DB2, 0x1E475005,
+    0x2608EDB8, 0x22C9F00F, 0x2F8AD6D6, 0x2B4BCB61,
+    0x350C9B64, 0x31CD86D3, 0x3C8EA00A, 0x384FBDBD
+};
+
+/* Bit reversal of a nibble */
+static const uint8_t CrcReverseNibble[16] =
+{
+    0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE,
+    0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF
+};
+
 /* Private function prototypes -----------------------------------------------*/
+static ErrorStatus CRC_StreamDMA(DMA_Channel_TypeDef* DMAy_Channelx, const uint8_t* pData,
+                                 uint32_t Count, uint32_t DataSize);
+
 /* Private functions ---------------------------------------------------------*/
 
 /** @defgroup CRC_Private_Functions CRC_Private_Functions
@@ -173,7 +195,7 @@ uint32_t CRC_CalcCRC(uint32_t CRC_Data)
   */
 uint32_t CRC_CalcCRC16bits(uint16_t CRC_Data)
 {
-    *(uint16_t*)(CRC_BASE) = (uint16_t) CRC_Data;
+    *(__IO uint16_t*)(&CRC->DR) = (uint16_t) CRC_Data;
 
     return (CRC->DR);
 }
@@ -185,7 +207,7 @@ uint32_t CRC_CalcCRC16bits(uint16_t CRC_Data)
   */
 uint32_t CRC_CalcCRC8bits(uint8_t CRC_Data)
 {
-    *(uint8_t*)(CRC_BASE) = (uint8_t) CRC_Data;
+    *(__IO uint8_t*)(&CRC->DR) = (uint8_t) CRC_Data;
 
     return (CRC->DR);
 }
@@ -252,6 +274,276 @@ uint8_t CRC_GetIDRegister(void)
     return (CRC->IDR);
 }
 
+/**
+  * @}
+  */
+
+/** @defgroup CRC_Group4 CRC streaming computation functions
+ *  @brief   CRC computation of byte streams
+ *
+@verbatim
+ ===============================================================================
+                 ##### CRC streaming computation functions #####
+ ===============================================================================
+    [..] A CRC_ContextTypeDef holds the parameters and the running value of
+         a CRC over a byte stream:
+         (+) CRC_StreamInit() starts a new CRC.
+         (+) CRC_StreamUpdate() adds a buffer of any length and alignment. The
+             running value is loaded in the unit and saved back, so that other
+             users of the unit can run between two updates. CR and INIT are
+             restored on return, DR is not.
+         (+) CRC_StreamUpdateSoft() does the same without the CRC unit, with
+             a bit-identical result.
+         (+) CRC_StreamFinal() returns the CRC.
+    [..] The data is written to DR with 8 bits accesses, except the aligned
+         words of the buffer. Buffers of at least CRC_STREAM_DMA_MIN_LENGTH
+         bytes are fed by a memory to memory DMA transfer when a channel is
+         given, with 32 bits accesses when ReflectInput is enabled and 8 bits
+         accesses otherwise.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Starts a new CRC on a stream context.
+  * @param  CRC_Context: context whose Init, XorOut, ReflectInput,
+  *         ReflectOutput and DMAy_Channelx fields are set.
+  * @retval None
+  */
+void CRC_StreamInit(CRC_ContextTypeDef* CRC_Context)
+{
+    CRC_Context->State = CRC_Context->Init;
+}
+
+/**
+  * @brief  Feeds DR with a memory to memory DMA transfer and waits for its end.
+  * @param  DMAy_Channelx: DMA channel to use
+  * @param  pData: data, 32 bits aligned for word transfers
+  * @param  Count: number of data, CRC_STREAM_DMA_MAX_LENGTH at most
+  * @param  DataSize: DMA_PeripheralDataSize_Byte or DMA_PeripheralDataSize_Word
+  * @retval SUCCESS, or ERROR on a DMA transfer error
+  */
+static ErrorStatus CRC_StreamDMA(DMA_Channel_TypeDef* DMAy_Channelx, const uint8_t* pData,
+                                 uint32_t Count, uint32_t DataSize)
+{
+    DMA_InitTypeDef DMA_InitStructure;
+    uint32_t shift;
+    uint32_t flags;
+
+    shift = (((uint32_t)DMAy_Channelx - DMA_Channel1_BASE) / CRC_DMA_CHANNEL_SIZE) * 4;
+
+    /* The source is given as peripheral, DR as memory */
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)pData;
+    DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)&CRC->DR;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
+    DMA_InitStructure.DMA_BufferSize = Count;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Enable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Disable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DataSize;
+    DMA_InitStructure.DMA_MemoryDataSize = (DataSize == DMA_PeripheralDataSize_Word) ?
+                                           DMA_MemoryDataSize_Word : DMA_MemoryDataSize_Byte;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_Medium;
+    DMA_InitStructure.DMA_M2M = DMA_M2M_Enable;
+
+    DMA_Cmd(DMAy_Channelx, DISABLE);
+    DMA_Init(DMAy_Channelx, &DMA_InitStructure);
+    DMA->IFCR = DMA_IFCR_CGIF1 << shift;
+    DMA_Cmd(DMAy_Channelx, ENABLE);
+
+    /* Wait for the transfer complete or transfer error flag */
+    do
+    {
+        flags = (DMA->ISR >> shift) & (DMA_ISR_TCIF1 | DMA_ISR_TEIF1);
+    } while (flags == 0);
+
+    DMA_Cmd(DMAy_Channelx, DISABLE);
+    DMA->IFCR = DMA_IFCR_CGIF1 << shift;
+
+    return ((flags & DMA_ISR_TEIF1) != 0) ? ERROR : SUCCESS;
+}
+
+/**
+  * @brief  Adds a buffer to the CRC of a stream context, with the CRC unit.
+  * @note   The CRC unit must not be used by an interrupt during the call.
+  * @param  CRC_Context: stream context
+  * @param  pData: data, no alignment required
+  * @param  Length: number of bytes
+  * @retval SUCCESS, or ERROR on a DMA transfer error. The context is not
+  *         updated on error.
+  */
+ErrorStatus CRC_StreamUpdate(CRC_ContextTypeDef* CRC_Context, const uint8_t* pData, uint32_t Length)
+{
+    ErrorStatus status = SUCCESS;
+    uint32_t savedcr = CRC->CR;
+    uint32_t savedinit = CRC->INIT;
+    uint32_t revbyte = CRC_ReverseInputData_No;
+    uint32_t revword = CRC_ReverseInputData_No;
+    uint32_t count;
+
+    if (CRC_Context->ReflectInput != DISABLE)
+    {
+        revbyte = CRC_ReverseInputData_8bits;
+        revword = CRC_ReverseInputData_32bits;
+    }
+
+    /* Restore the running value */
+    CRC->INIT = CRC_Context->State;
+    CRC->CR = revbyte | CRC_CR_RESET;
+
+    if ((CRC_Context->DMAy_Channelx != NULL) && (Length >= CRC_STREAM_DMA_MIN_LENGTH))
+    {
+        if (CRC_Context->ReflectInput == DISABLE)
+        {
+            /* Words would be processed from their last byte: DMA byte by byte */
+            while ((Length != 0) && (status == SUCCESS))
+            {
+                count = (Length > CRC_STREAM_DMA_MAX_LENGTH) ? CRC_STREAM_DMA_MAX_LENGTH : Length;
+                status = CRC_StreamDMA(CRC_Context->DMAy_Channelx, pData, count, DMA_PeripheralDataSize_Byte);
+                pData += count;
+                Length -= count;
+            }
+        }
+        else
+        {
+            /* Unaligned head */
+            while (((uint32_t)pData & 3) != 0)
+            {
+                *(__IO uint8_t*)(&CRC->DR) = *pData++;
+                Length--;
+            }
+
+            CRC->CR = revword;
+
+            while ((Length >= 4) && (status == SUCCESS))
+            {
+                count = Length / 4;
+
+                if (count > CRC_STREAM_DMA_MAX_LENGTH)
+                {
+                    count = CRC_STREAM_DMA_MAX_LENGTH;
+                }
+
+                status = CRC_StreamDMA(CRC_Context->DMAy_Channelx, pData, count, DMA_PeripheralDataSize_Word);
+                pData += count * 4;
+                Length -= count * 4;
+            }
+
+            CRC->CR = revbyte;
+        }
+    }
+    else if (Length >= 4)
+    {
+        /* Unaligned head */
+        while (((uint32_t)pData & 3) != 0)
+        {
+            *(__IO uint8_t*)(&CRC->DR) = *pData++;
+            Length--;
+        }
+
+        CRC->CR = revword;
+
+        if (CRC_Context->ReflectInput != DISABLE)
+        {
+            while (Length >= 4)
+            {
+                CRC->DR = *(const uint32_t*)pData;
+                pData += 4;
+                Length -= 4;
+            }
+        }
+        else
+        {
+            /* Process the bytes of each word in memory order */
+            while (Length >= 4)
+            {
+                CRC->DR = __REV(*(const uint32_t*)pData);
+                pData += 4;
+                Length -= 4;
+            }
+        }
+
+        CRC->CR = revbyte;
+    }
+
+    /* Tail */
+    while ((Length != 0) && (status == SUCCESS))
+    {
+        *(__IO uint8_t*)(&CRC->DR) = *pData++;
+        Length--;
+    }
+
+    /* Save the running value */
+    if (status == SUCCESS)
+    {
+        CRC_Context->State = CRC->DR;
+    }
+
+    CRC->INIT = savedinit;
+    CRC->CR = savedcr & ~CRC_CR_RESET;
+
+    return status;
+}
+
+/**
+  * @brief  Adds a buffer to the CRC of a stream context, without the CRC unit.
+  * @note   Table driven with 4 bits per step, the result is identical to
+  *         CRC_StreamUpdate(). Contexts can be updated by both functions.
+  * @param  CRC_Context: stream context
+  * @param  pData: data, no alignment required
+  * @param  Length: number of bytes
+  * @retval None
+  */
+void CRC_StreamUpdateSoft(CRC_ContextTypeDef* CRC_Context, const uint8_t* pData, uint32_t Length)
+{
+    uint32_t crc = CRC_Context->State;
+    uint32_t data;
+
+    while (Length != 0)
+    {
+        data = *pData++;
+
+        if (CRC_Context->ReflectInput != DISABLE)
+        {
+            data = ((uint32_t)CrcReverseNibble[data & 0x0F] << 4) | CrcReverseNibble[data >> 4];
+        }
+
+        crc ^= data << 24;
+        crc = (crc << 4) ^ CrcNibbleTable[crc >> 28];
+        crc = (crc << 4) ^ CrcNibbleTable[crc >> 28];
+        Length--;
+    }
+
+    CRC_Context->State = crc;
+}
+
+/**
+  * @brief  Returns the CRC of a stream context.
+  * @note   The context can still be updated afterwards.
+  * @param  CRC_Context: stream context
+  * @retval 32-bit CRC
+  */
+uint32_t CRC_StreamFinal(CRC_ContextTypeDef* CRC_Context)
+{
+    uint32_t crc = CRC_Context->State;
+    uint32_t rev = 0;
+    uint32_t i;
+
+    if (CRC_Context->ReflectOutput != DISABLE)
+    {
+        for (i = 0; i < 8; i++)
+        {
+            rev = (rev << 4) | CrcReverseNibble[crc & 0x0F];
+            crc >>= 4;
+        }
+
+        crc = rev;
+    }
+
+    return crc ^ CRC_Context->XorOut;
+}
+
 /**
   * @}
   */
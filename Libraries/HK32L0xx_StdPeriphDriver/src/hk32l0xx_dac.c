@@ -55,6 +55,13 @@
 
 /* DOR register offset */
 #define DOR_OFFSET                 ((uint32_t)0x0000002C)
+
+/* Taylor coefficients of sin(pi / 2 x u) in 2.30 format */
+#define SINE_C1                    ((int32_t)1686629713)
+#define SINE_C3                    ((int32_t)-693598668)
+#define SINE_C5                    ((int32_t)85569306)
+#define SINE_C7                    ((int32_t)-5026995)
+#define SINE_C9                    ((int32_t)172272)
 /**
   * @}
   */
@@ -264,13 +271,13 @@ void DAC_WaveGenerationCmd(uint32_t DAC_Wave, FunctionalState NewState)
   */
 void DAC_SetChannelData(uint32_t DAC_Align, uint16_t Data)
 {
-    __IO uint32_t tmp = 0;
+    __IO uint8_t* tmp = 0;
 
     /* Check the parameters */
     assert_param(IS_DAC_ALIGN(DAC_Align));
     assert_param(IS_DAC_DATA(Data));
 
-    tmp = (uint32_t)DAC_BASE;
+    tmp = (__IO uint8_t*)DAC;
     tmp += DHR12R_OFFSET + DAC_Align;
 
     /* Set the DAC channel1 selected data holding register */
@@ -283,11 +290,11 @@ void DAC_SetChannelData(uint32_t DAC_Align, uint16_t Data)
   */
 uint16_t DAC_GetDataOutputValue(void)
 {
-    __IO uint32_t tmp = 0;
+    __IO uint8_t* tmp = 0;
 
     /* Check the parameters */
 
-    tmp = (uint32_t) DAC_BASE ;
+    tmp = (__IO uint8_t*)DAC;
     tmp += DOR_OFFSET;
 
     /* Returns the DAC channel data output register value */
@@ -389,6 +396,516 @@ void DAC_ClearITPendingBit(uint32_t DAC_IT)
     DAC->SR = (DAC_IT );
 }
 
+/**
+  * @}
+  */
+
+/** @defgroup DAC_Wave_Functions DAC Waveform Generator Functions
+ *  @brief   Table synthesis and phase accumulator clocked out by a circular DMA
+ *
+@verbatim
+ ===============================================================================
+          ##### Waveform generator functions #####
+ ===============================================================================
+    [..] A 32 bits phase accumulator steps through one period of the
+         waveform, a table of 2^TableBits samples, with a linear
+         interpolation between the table entries: the frequency is
+         Increment x SampleRate / 2^32, with a resolution of
+         SampleRate / 2^32.
+    [..] DMA_Channel2 writes the samples of a circular buffer of two halves
+         of BlockLength samples to the DAC at each timer trigger.
+         DAC_WaveIRQHandler(), called from the IRQ handler of the channel,
+         synthesizes the half the DMA has just played while it plays the
+         other one. The CPU does not touch the samples while they are
+         written to the DAC.
+    [..] DAC_WaveSetFrequency(), DAC_WaveSetChirp() and DAC_WaveSetTable()
+         only record the request, it is applied at the start of the next half
+         buffer synthesized: the phase accumulator is not reset, the waveform
+         stays continuous. A new table can be synthesized in a second table
+         while the first one is played, then swapped by DAC_WaveSetTable().
+    [..] When the waveform is periodic over the whole buffer (a frequency
+         multiple of SampleRate / (2 x BlockLength)) and nothing changed, a
+         half buffer already holds the right samples: it is not synthesized
+         again, the waveform costs no CPU time at all.
+    [..] A trigger arriving before the DMA has written the next sample sets
+         DMAUDR and the DAC stops its DMA requests: the output holds and no
+         half transfer interrupt follows. The DMA underrun interrupt is
+         enabled, DAC_WaveIRQHandler() counts the underrun and restarts the
+         DMA from the current phase.
+    [..] DAC_WaveSynthSine() and DAC_WaveSynthResample() build tables, and
+         DAC_WaveFill() runs the phase accumulator into any buffer: they do
+         not access the peripherals.
+    [..] Use:
+         (#) Enable the DAC, DMA and timer clocks, configure PA4 in analog mode.
+         (#) Fill a DAC_WaveTypeDef and call DAC_WaveInit(), then
+             DAC_WaveSetFrequency() or DAC_WaveSetChirp().
+         (#) Enable the DMA_CH2_3 and DAC interrupts in the NVIC, call
+             DAC_WaveIRQHandler() from both IRQ handlers.
+         (#) Call DAC_WaveStart(), then start the timer with its TRGO output
+             on the update event at SampleRate.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  sin(2 x pi x Phase / 2^32) in 2.30 format.
+  * @note   Taylor polynomial of sin(pi / 2 x u) up to u^9 on a quarter of
+  *         period, error below 4e-6.
+  * @param  Phase: angle, 2^32 is one period.
+  * @retval Sine in 2.30 format, -2^30 to 2^30.
+  */
+static int32_t DAC_WaveSine(uint32_t Phase)
+{
+    int32_t u = (int32_t)(Phase & 0x3FFFFFFFu);
+    int32_t u2;
+    int32_t acc;
+
+    /* Second and fourth quarters mirror the first and third ones */
+    if ((Phase & 0x40000000u) != 0)
+    {
+        u = 0x40000000 - u;
+    }
+
+    u2 = (int32_t)(((int64_t)u * u) >> 30);
+    acc = SINE_C9;
+    acc = SINE_C7 + (int32_t)(((int64_t)acc * u2) >> 30);
+    acc = SINE_C5 + (int32_t)(((int64_t)acc * u2) >> 30);
+    acc = SINE_C3 + (int32_t)(((int64_t)acc * u2) >> 30);
+    acc = SINE_C1 + (int32_t)(((int64_t)acc * u2) >> 30);
+    acc = (int32_t)(((int64_t)acc * u) >> 30);
+
+    return ((Phase & 0x80000000u) != 0) ? -acc : acc;
+}
+
+/**
+  * @brief  Applies the table, frequency or sweep requested since the last
+  *         half buffer.
+  * @param  Wave: pointer to the waveform generator.
+  * @retval None
+  */
+static void DAC_WaveUpdate(DAC_WaveTypeDef* Wave)
+{
+    if (Wave->TableUpdate != 0)
+    {
+        Wave->Table = Wave->NextTable;
+        Wave->TableBits = Wave->NextTableBits;
+        Wave->TableUpdate = 0;
+    }
+
+    if (Wave->FrequencyUpdate != 0)
+    {
+        Wave->Increment = Wave->NextIncrement;
+        Wave->ChirpStart = Wave->NextIncrement;
+        Wave->ChirpStep = Wave->NextChirpStep;
+        Wave->ChirpStop = Wave->NextChirpStop;
+        Wave->ChirpRepeat = Wave->NextChirpRepeat;
+        Wave->FrequencyUpdate = 0;
+    }
+}
+
+/**
+  * @brief  Synthesizes a half buffer, unless it already holds the samples
+  *         that follow the other half.
+  * @param  Wave: pointer to the waveform generator.
+  * @param  Half: 0 for the first half of the buffer, 1 for the second one.
+  * @retval None
+  */
+static void DAC_WaveFillHalf(DAC_WaveTypeDef* Wave, uint32_t Half)
+{
+    if ((Wave->ChirpStep == 0) && (Wave->HalfTable[Half] == Wave->Table) &&
+            (Wave->HalfPhase[Half] == Wave->Phase) && (Wave->HalfIncrement[Half] == Wave->Increment))
+    {
+        /* Same samples as the last time: only move the phase */
+        Wave->Phase += Wave->Increment * Wave->BlockLength;
+        Wave->Reused++;
+        return;
+    }
+
+    Wave->HalfPhase[Half] = Wave->Phase;
+    Wave->HalfIncrement[Half] = Wave->Increment;
+
+    /* A sweep is never played twice the same */
+    Wave->HalfTable[Half] = (Wave->ChirpStep == 0) ? Wave->Table : NULL;
+
+    DAC_WaveFill(Wave, &Wave->Buffer[Half * Wave->BlockLength], Wave->BlockLength);
+    Wave->Blocks++;
+}
+
+/**
+  * @brief  Configures the DAC and DMA_Channel2 of a waveform generator.
+  * @note   The output is at the first sample of the table and at a null
+  *         frequency until DAC_WaveSetFrequency() or DAC_WaveSetChirp().
+  * @param  Wave: pointer to the waveform generator, its Buffer holds
+  *         2 * BlockLength samples.
+  * @retval SUCCESS, or ERROR if a parameter of Wave is not valid.
+  */
+ErrorStatus DAC_WaveInit(DAC_WaveTypeDef* Wave)
+{
+    DMA_InitTypeDef DMA_InitStructure;
+
+    /* Check the parameters */
+    assert_param(IS_DAC_TRIGGER(Wave->DAC_Trigger));
+
+    if ((Wave->Buffer == NULL) || (Wave->BlockLength == 0) || (Wave->BlockLength > 0x7FFF) ||
+            (Wave->Table == NULL) || !IS_DAC_WAVE_TABLE_BITS(Wave->TableBits) || (Wave->SampleRate == 0))
+    {
+        return ERROR;
+    }
+
+    Wave->Phase = 0;
+    Wave->Increment = 0;
+    Wave->ChirpStep = 0;
+    Wave->ChirpStart = 0;
+    Wave->ChirpStop = 0;
+    Wave->ChirpRepeat = 0;
+    Wave->TableUpdate = 0;
+    Wave->FrequencyUpdate = 0;
+    Wave->HalfTable[0] = NULL;
+    Wave->HalfTable[1] = NULL;
+    Wave->Blocks = 0;
+    Wave->Reused = 0;
+    Wave->Lost = 0;
+    Wave->Underruns = 0;
+
+    /* Trigger, output buffer enabled, no hardware wave */
+    DAC->CR = (DAC->CR & ~(CR_CLEAR_MASK | DAC_CR_DMAEN | DAC_CR_EN)) | Wave->DAC_Trigger;
+    DAC_ITConfig(DAC_IT_DMAUDR, ENABLE);
+
+    /* Circular DMA from the buffer, half transfer and transfer complete interrupts */
+    DMA_RemapConfig(DMA, DMA_CSELR_CH2_DAC_CH1);
+    DMA_DeInit(DMA_Channel2);
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&DAC->DHR12R;
+    DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)Wave->Buffer;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralDST;
+    DMA_InitStructure.DMA_BufferSize = 2 * (uint32_t)Wave->BlockLength;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_HalfWord;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Circular;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+    DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init(DMA_Channel2, &DMA_InitStructure);
+    DMA_ITConfig(DMA_Channel2, DMA_IT_HT | DMA_IT_TC, ENABLE);
+
+    return SUCCESS;
+}
+
+/**
+  * @brief  Starts a waveform generator: both halves of the buffer are
+  *         synthesized, then the DAC waits for the triggers.
+  * @param  Wave: pointer to the waveform generator initialized by DAC_WaveInit().
+  * @retval None
+  */
+void DAC_WaveStart(DAC_WaveTypeDef* Wave)
+{
+    DMA_Cmd(DMA_Channel2, DISABLE);
+
+    DAC_WaveUpdate(Wave);
+    DAC_WaveFillHalf(Wave, 0);
+    DAC_WaveFillHalf(Wave, 1);
+
+    /* The DMA starts at the beginning of the buffer */
+    DMA_SetCurrDataCounter(DMA_Channel2, 2 * Wave->BlockLength);
+    DMA_ClearITPendingBit(DMA1_IT_GL2 | DMA1_IT_HT2 | DMA1_IT_TC2);
+    DMA_Cmd(DMA_Channel2, ENABLE);
+
+    DAC_ClearFlag(DAC_FLAG_DMAUDR);
+    DAC->CR |= DAC_CR_EN | DAC_CR_DMAEN;
+}
+
+/**
+  * @brief  Stops a waveform generator, the output holds the last sample.
+  * @note   DAC_WaveStart() starts again from the current phase.
+  * @param  Wave: pointer to the waveform generator.
+  * @retval None
+  */
+void DAC_WaveStop(DAC_WaveTypeDef* Wave)
+{
+    DAC->CR &= ~DAC_CR_DMAEN;
+    DMA_Cmd(DMA_Channel2, DISABLE);
+
+    /* The position in the buffer is lost: the phase restarts after the last
+       half synthesized */
+    Wave->HalfTable[0] = NULL;
+    Wave->HalfTable[1] = NULL;
+}
+
+/**
+  * @brief  Phase increment per sample of a frequency.
+  * @param  SampleRate: sample frequency in Hz.
+  * @param  Frequency: frequency in Hz, below SampleRate.
+  * @retval Frequency x 2^32 / SampleRate, rounded down.
+  */
+uint32_t DAC_WaveFrequencyToIncrement(uint32_t SampleRate, uint32_t Frequency)
+{
+    if (Frequency >= SampleRate)
+    {
+        return 0xFFFFFFFFu;
+    }
+
+    return (uint32_t)(((uint64_t)Frequency << 32) / SampleRate);
+}
+
+/**
+  * @brief  Sets a fixed frequency, from the next half buffer on.
+  * @note   Ends a sweep. To be called from thread mode, not from a higher
+  *         priority interrupt than the DMA one.
+  * @param  Wave: pointer to the waveform generator.
+  * @param  Frequency: frequency in Hz, below SampleRate / 2.
+  * @retval None
+  */
+void DAC_WaveSetFrequency(DAC_WaveTypeDef* Wave, uint32_t Frequency)
+{
+    /* The DMA interrupt never sees a request half written */
+    Wave->FrequencyUpdate = 0;
+    Wave->NextIncrement = DAC_WaveFrequencyToIncrement(Wave->SampleRate, Frequency);
+    Wave->NextChirpStep = 0;
+    Wave->NextChirpStop = Wave->NextIncrement;
+    Wave->NextChirpRepeat = 0;
+    Wave->FrequencyUpdate = 1;
+}
+
+/**
+  * @brief  Starts a linear frequency sweep at the next half buffer.
+  * @note   The increment changes at each sample, the phase stays continuous.
+  *         To be called from thread mode, not from a higher priority
+  *         interrupt than the DMA one.
+  * @param  Wave: pointer to the waveform generator.
+  * @param  StartFrequency: first frequency in Hz, below SampleRate / 2.
+  * @param  StopFrequency: last frequency in Hz, below SampleRate / 2.
+  * @param  Samples: length of the sweep in samples.
+  * @param  Repeat: ENABLE to restart the sweep at StartFrequency,
+  *         DISABLE to stay at StopFrequency.
+  * @retval None
+  */
+void DAC_WaveSetChirp(DAC_WaveTypeDef* Wave, uint32_t StartFrequency, uint32_t StopFrequency,
+                      uint32_t Samples, FunctionalState Repeat)
+{
+    uint32_t start = DAC_WaveFrequencyToIncrement(Wave->SampleRate, StartFrequency);
+    uint32_t stop = DAC_WaveFrequencyToIncrement(Wave->SampleRate, StopFrequency);
+    int32_t step = 0;
+
+    /* Check the parameters */
+    assert_param(IS_FUNCTIONAL_STATE(Repeat));
+
+    if (Samples != 0)
+    {
+        step = (int32_t)(((int64_t)stop - (int64_t)start) / (int64_t)Samples);
+    }
+
+    Wave->FrequencyUpdate = 0;
+
+    if (step == 0)
+    {
+        /* Too short or too narrow: the stop frequency at once */
+        Wave->NextIncrement = stop;
+    }
+    else
+    {
+        Wave->NextIncrement = start;
+    }
+
+    Wave->NextChirpStep = step;
+    Wave->NextChirpStop = stop;
+    Wave->NextChirpRepeat = (Repeat != DISABLE) ? 1 : 0;
+    Wave->FrequencyUpdate = 1;
+}
+
+/**
+  * @brief  Replaces the table of the waveform at the next half buffer.
+  * @note   The table in use must not be modified until the next half buffer
+  *         has been synthesized, Blocks or Reused then change. To be called
+  *         from thread mode, not from a higher priority interrupt than the
+  *         DMA one.
+  * @param  Wave: pointer to the waveform generator.
+  * @param  Table: one period of the new waveform, 2^TableBits samples.
+  * @param  TableBits: log2 of the table length, 1 to DAC_WAVE_TABLE_BITS_MAX.
+  * @retval None
+  */
+void DAC_WaveSetTable(DAC_WaveTypeDef* Wave, const uint16_t* Table, uint8_t TableBits)
+{
+    /* Check the parameters */
+    assert_param(IS_DAC_WAVE_TABLE_BITS(TableBits));
+
+    Wave->TableUpdate = 0;
+    Wave->NextTable = Table;
+    Wave->NextTableBits = TableBits;
+    Wave->TableUpdate = 1;
+}
+
+/**
+  * @brief  Fills a table with one period of a sine wave.
+  * @param  Table: 2^TableBits samples.
+  * @param  TableBits: log2 of the table length, 1 to DAC_WAVE_TABLE_BITS_MAX.
+  * @param  Amplitude: peak amplitude in LSB, 0 to 2047.
+  * @param  Offset: middle value in LSB, Offset - Amplitude to
+  *         Offset + Amplitude is clipped to 0 - 4095.
+  * @retval None
+  */
+void DAC_WaveSynthSine(uint16_t* Table, uint8_t TableBits, uint16_t Amplitude, uint16_t Offset)
+{
+    uint32_t length = (uint32_t)1 << TableBits;
+    uint32_t i;
+    int32_t sample;
+
+    /* Check the parameters */
+    assert_param(IS_DAC_WAVE_TABLE_BITS(TableBits));
+
+    for (i = 0; i < length; i++)
+    {
+        sample = (int32_t)Offset + (int32_t)((((int64_t)Amplitude * DAC_WaveSine(i << (32 - TableBits))) + 0x20000000) >> 30);
+
+        if (sample < 0)
+        {
+            sample = 0;
+        }
+        else if (sample > DAC_WAVE_SAMPLE_MAX)
+        {
+            sample = DAC_WAVE_SAMPLE_MAX;
+        }
+
+        Table[i] = (uint16_t)sample;
+    }
+}
+
+/**
+  * @brief  Fills a table with one period of an arbitrary waveform given by
+  *         NbPoints equally spaced points, linearly interpolated.
+  * @note   The waveform is periodic: the last point is joined to the first.
+  * @param  Table: 2^TableBits samples.
+  * @param  TableBits: log2 of the table length, 1 to DAC_WAVE_TABLE_BITS_MAX.
+  * @param  Points: NbPoints samples of 12 bits, the first one at phase 0.
+  * @param  NbPoints: number of points, 1 to 65535.
+  * @retval None
+  */
+void DAC_WaveSynthResample(uint16_t* Table, uint8_t TableBits, const uint16_t* Points, uint32_t NbPoints)
+{
+    uint32_t length = (uint32_t)1 << TableBits;
+    uint32_t mask = length - 1;
+    uint32_t position;
+    uint32_t point;
+    uint32_t frac;
+    int32_t a, b;
+    uint32_t i;
+
+    /* Check the parameters */
+    assert_param(IS_DAC_WAVE_TABLE_BITS(TableBits));
+    assert_param((NbPoints != 0) && (NbPoints <= 0xFFFF));
+
+    for (i = 0; i < length; i++)
+    {
+        /* Position i x NbPoints / length, fraction on 16 bits */
+        position = i * NbPoints;
+        point = position >> TableBits;
+        frac = ((position & mask) << 16) >> TableBits;
+
+        a = Points[point];
+        b = Points[(point + 1 < NbPoints) ? (point + 1) : 0];
+
+        Table[i] = (uint16_t)(a + (((b - a) * (int32_t)frac) >> 16));
+    }
+}
+
+/**
+  * @brief  Runs the phase accumulator of a waveform generator into a buffer.
+  * @note   Each sample interpolates linearly between two entries of the
+  *         table. Phase, Increment and the sweep move on by Length samples.
+  *         Does not access the peripherals.
+  * @param  Wave: pointer to the waveform generator.
+  * @param  Block: Length samples of 12 bits.
+  * @param  Length: number of samples.
+  * @retval None
+  */
+void DAC_WaveFill(DAC_WaveTypeDef* Wave, uint16_t* Block, uint32_t Length)
+{
+    const uint16_t* table = Wave->Table;
+    uint32_t bits = Wave->TableBits;
+    uint32_t mask = ((uint32_t)1 << bits) - 1;
+    uint32_t phase = Wave->Phase;
+    uint32_t increment = Wave->Increment;
+    int32_t step = Wave->ChirpStep;
+    uint32_t index;
+    int32_t frac;
+    int32_t a, b;
+
+    while (Length-- != 0)
+    {
+        index = phase >> (32 - bits);
+        frac = (int32_t)((phase << bits) >> 16);
+        a = table[index];
+        b = table[(index + 1) & mask];
+        *Block++ = (uint16_t)(a + (((b - a) * frac) >> 16));
+
+        phase += increment;
+
+        if (step != 0)
+        {
+            increment += (uint32_t)step;
+
+            if ((step > 0) ? (increment >= Wave->ChirpStop) : (increment <= Wave->ChirpStop))
+            {
+                if (Wave->ChirpRepeat != 0)
+                {
+                    increment = Wave->ChirpStart;
+                }
+                else
+                {
+                    increment = Wave->ChirpStop;
+                    step = 0;
+                }
+            }
+        }
+    }
+
+    Wave->Phase = phase;
+    Wave->Increment = increment;
+    Wave->ChirpStep = step;
+}
+
+/**
+  * @brief  Synthesizes the half buffer the DMA has just played, or restarts
+  *         the DMA after an underrun.
+  * @note   To be called from the DMA_CH2_3 and DAC IRQ handlers.
+  * @param  Wave: pointer to the waveform generator.
+  * @retval None
+  */
+void DAC_WaveIRQHandler(DAC_WaveTypeDef* Wave)
+{
+    uint32_t flags;
+
+    if ((DAC->SR & DAC_SR_DMAUDR) != 0)
+    {
+        /* The DAC stopped its DMA requests: DAC_WaveStart() clears DMAUDR,
+           sets DMAEN again and refills the buffer from the current phase */
+        Wave->Underruns++;
+        DAC_WaveStop(Wave);
+        DAC_WaveStart(Wave);
+        return;
+    }
+
+    flags = DMA->ISR & (DMA_ISR_HTIF2 | DMA_ISR_TCIF2);
+
+    if (flags == 0)
+    {
+        return;
+    }
+
+    DMA_ClearITPendingBit(DMA1_IT_GL2 | DMA1_IT_HT2 | DMA1_IT_TC2);
+
+    if (flags == (DMA_ISR_HTIF2 | DMA_ISR_TCIF2))
+    {
+        /* Late: fill the half the DMA is not reading, the other one is
+           played again */
+        Wave->Lost++;
+        flags = (DMA_Channel2->CHDTR > Wave->BlockLength) ? DMA_ISR_TCIF2 : DMA_ISR_HTIF2;
+    }
+
+    DAC_WaveUpdate(Wave);
+    DAC_WaveFillHalf(Wave, (flags == DMA_ISR_HTIF2) ? 0 : 1);
+}
+
 /**
   * @}
   */
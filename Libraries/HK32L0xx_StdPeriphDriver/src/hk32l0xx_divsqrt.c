@@ -132,6 +132,254 @@ uint16_t DVSQ_SqrtH(uint32_t Radicand, uint16_t *fraction)
     return result;
 }
 
+/**
+  * @brief  Unsigned division of two arrays
+  * @note   The operands of the next division are loaded and the results of
+  *         the previous one are stored while DVSQ computes.
+  * @param  pDividend: array of Count 32bits Unsigned dividends
+  * @param  pDivisor: array of Count 32bits Unsigned divisors
+  * @param  pQuotient: array receiving the Count quotients
+  * @param  pRemainder: array receiving the Count remainders, NULL if not needed
+  * @param  Count: number of divisions
+  * @retval None
+  */
+void DVSQ_UDivsionVector(const uint32_t *pDividend, const uint32_t *pDivisor,
+                         uint32_t *pQuotient, uint32_t *pRemainder, uint32_t Count)
+{
+    uint32_t Dividend;
+    uint32_t Divisor;
+    uint32_t i;
+
+    if (Count == 0)
+    {
+        return;
+    }
+
+    DVSQ_Wait();
+    DVSQ_ConfigDivUnsigned();
+    DVSQ_EnableDivFastStart();
+    DVSQ_StartDiv(pDividend[0], pDivisor[0]);
+
+    for (i = 1; i < Count; i++)
+    {
+        /* Load the next operands during the division */
+        Dividend = pDividend[i];
+        Divisor = pDivisor[i];
+        DVSQ_Wait();
+        pQuotient[i - 1] = DVSQ->RES;
+
+        if (pRemainder != NULL)
+        {
+            pRemainder[i - 1] = DVSQ->REMAINDER;
+        }
+
+        DVSQ_StartDiv(Dividend, Divisor);
+    }
+
+    pQuotient[Count - 1] = DVSQ_FetchResult();
+
+    if (pRemainder != NULL)
+    {
+        pRemainder[Count - 1] = DVSQ->REMAINDER;
+    }
+}
+
+/**
+  * @brief  Signed division of two arrays
+  * @note   The operands of the next division are loaded and the results of
+  *         the previous one are stored while DVSQ computes.
+  * @param  pDividend: array of Count 32bits Signed dividends
+  * @param  pDivisor: array of Count 32bits Signed divisors
+  * @param  pQuotient: array receiving the Count quotients
+  * @param  pRemainder: array receiving the Count remainders, NULL if not needed
+  * @param  Count: number of divisions
+  * @retval None
+  */
+void DVSQ_DivsionVector(const int32_t *pDividend, const int32_t *pDivisor,
+                        int32_t *pQuotient, int32_t *pRemainder, uint32_t Count)
+{
+    int32_t Dividend;
+    int32_t Divisor;
+    uint32_t i;
+
+    if (Count == 0)
+    {
+        return;
+    }
+
+    DVSQ_Wait();
+    // config for signed division operation
+    DVSQ_ConfigDivSigned();
+    DVSQ_EnableDivFastStart();
+    DVSQ_StartDiv(pDividend[0], pDivisor[0]);
+
+    for (i = 1; i < Count; i++)
+    {
+        /* Load the next operands during the division */
+        Dividend = pDividend[i];
+        Divisor = pDivisor[i];
+        DVSQ_Wait();
+        pQuotient[i - 1] = (int32_t)DVSQ->RES;
+
+        if (pRemainder != NULL)
+        {
+            pRemainder[i - 1] = (int32_t)DVSQ->REMAINDER;
+        }
+
+        DVSQ_StartDiv(Dividend, Divisor);
+    }
+
+    pQuotient[Count - 1] = (int32_t)DVSQ_FetchResult();
+
+    if (pRemainder != NULL)
+    {
+        pRemainder[Count - 1] = (int32_t)DVSQ->REMAINDER;
+    }
+}
+
+/**
+  * @brief  Square root of an array
+  * @note   The next radicand is loaded and the previous result is stored
+  *         while DVSQ computes.
+  * @param  pRadicand: array of Count radicands
+  * @param  pResult: array receiving the Count square roots
+  * @param  Count: number of square roots
+  * @retval None
+  */
+void DVSQ_SqrtVector(const uint32_t *pRadicand, uint32_t *pResult, uint32_t Count)
+{
+    uint32_t Radicand;
+    uint32_t i;
+
+    if (Count == 0)
+    {
+        return;
+    }
+
+    DVSQ_Wait();
+    // config for normal square root operation
+    DVSQ_ConfigSqrtPresNormal();
+    DVSQ_StartSqrt(pRadicand[0]);
+
+    for (i = 1; i < Count; i++)
+    {
+        Radicand = pRadicand[i];
+        pResult[i - 1] = DVSQ_FetchResult();
+        DVSQ_StartSqrt(Radicand);
+    }
+
+    pResult[Count - 1] = DVSQ_FetchResult();
+}
+
+/**
+  * @brief  High precision square root of an array
+  * @note   The next radicand is loaded and the previous result is stored
+  *         while DVSQ computes.
+  * @param  pRadicand: array of Count radicands
+  * @param  pResult: array receiving the Count square roots, the integer part
+  *         in the upper 16 bits and the decimal part in the lower 16 bits
+  * @param  Count: number of square roots
+  * @retval None
+  */
+void DVSQ_SqrtHVector(const uint32_t *pRadicand, uint32_t *pResult, uint32_t Count)
+{
+    uint32_t Radicand;
+    uint32_t i;
+
+    if (Count == 0)
+    {
+        return;
+    }
+
+    DVSQ_Wait();
+    // config for high precision square root operation
+    DVSQ_ConfigSqrtPresHigh();
+    DVSQ_StartSqrt(pRadicand[0]);
+
+    for (i = 1; i < Count; i++)
+    {
+        Radicand = pRadicand[i];
+        pResult[i - 1] = DVSQ_FetchResult();
+        DVSQ_StartSqrt(Radicand);
+    }
+
+    pResult[Count - 1] = DVSQ_FetchResult();
+}
+
+/**
+  * @brief  Software model of the square root operation
+  * @note   Bit by bit integer square root, rounded down. It does not use
+  *         DVSQ and can be used to check its results, on the target or on a
+  *         host.
+  * @param  Radicand: the radicand
+  * @retval Square root operation result
+  */
+uint32_t DVSQ_ModelSqrt(uint32_t Radicand)
+{
+    uint32_t root = 0;
+    uint32_t bit = (uint32_t)1 << 30;
+
+    while (bit > Radicand)
+    {
+        bit >>= 2;
+    }
+
+    while (bit != 0)
+    {
+        if (Radicand >= root + bit)
+        {
+            Radicand -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+
+        bit >>= 2;
+    }
+
+    return root;
+}
+
+/**
+  * @brief  Software model of the high precision square root operation
+  * @note   Square root of Radicand * 2^32, rounded down. It does not use DVSQ
+  *         and can be used to check its results, on the target or on a host.
+  * @param  Radicand: the radicand
+  * @param  fraction: The data pointer used to storeDecimal part of the square root result
+  * @retval The integer part of the square root result
+  */
+uint16_t DVSQ_ModelSqrtH(uint32_t Radicand, uint16_t *fraction)
+{
+    uint64_t rem = (uint64_t)Radicand << 32;
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while (bit > rem)
+    {
+        bit >>= 2;
+    }
+
+    while (bit != 0)
+    {
+        if (rem >= root + bit)
+        {
+            rem -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+
+        bit >>= 2;
+    }
+
+    *fraction = (uint16_t)(root & 0xffff);
+    return (uint16_t)(root >> 16);
+}
+
 /**
   * @}
   */
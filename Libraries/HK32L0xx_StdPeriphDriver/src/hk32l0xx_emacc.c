@@ -27,6 +27,10 @@
 */
 /*Private typedef -----------------------------------------------------------*/
 /*Private define ------------------------------------------------------------*/
+#define EMACC_DIVSQRT_3           ((int32_t)0x49E6)   /* 1/sqrt(3) in q15 */
+#define EMACC_CORDIC_STEPS        (16)
+#define EMACC_CORDIC_GUARD        (8)                 /* Extra bits of the CORDIC */
+#define EMACC_CORDIC_GAIN         ((int32_t)5093851)  /* 32767/K with the guard bits */
 
 
 /** @defgroup EMACC_Private_Variables EMACC_Private_Variables
@@ -44,11 +48,28 @@ static uint16_t MMItable[65] =
     24392, 24287, 24183, 24081, 23980, 23880, 23782, 23684, 23588, 23493,
     23400, 23307, 23215, 23125
 };
+
+/* atan(2^-i) with 0x8000 as PI, with the guard bits */
+static const int32_t CordicAtanTable[EMACC_CORDIC_STEPS] =
+{
+    2097152, 1238021, 654136, 332050, 166669, 83416, 41718, 20860,
+    10430, 5215, 2608, 1304, 652, 326, 163, 81
+};
+
+static EMACC_CalCallback CalCallback = 0;
+
+/* Batch in progress, advanced by EMACC_CalPoll() */
+static const EMACC_Sample* BatchSample = 0;
+static Volt_Components* BatchResult = 0;
+static __IO uint32_t BatchCount = 0;
 /**
   * @}
   */
 
 /* Private function prototypes -----------------------------------------------*/
+static int16_t EMACC_ModelSat16(int32_t wValue);
+static int16_t EMACC_ModelPI(EMACC_PI_InitTypeDef* PI, int32_t* pIntegralTerm, int32_t wError);
+
 /* Private functions ---------------------------------------------------------*/
 /** @defgroup EMACC_Private_Functions EMACC_Private_Functions
   * @{
@@ -202,33 +223,183 @@ void EMACC_SetEleAngle(int16_t ElAngle)
   */
 Volt_Components EMACC_Cal(int16_t hElAngle, Curr_Components Iab, Curr_Components Iqdref)
 {
-    __IO uint32_t CaleStatus = 0;
-    Volt_Components Valphabeta;
+    EMACC_SetIqdRef(Iqdref);
+
+    EMACC_StartCal(hElAngle, Iab);
+
+    /*wait result*/
+    while ((EMACC->SR & EMACC_SR_RPARK_CF) == 0)
+    {
+    }
+
+    return EMACC_GetCalResult();
+}
+
+/**
+  * @brief  Set the reference current of the D axis PI.
+  * @param  hIdref: reference current of the D axis
+  * @retval None
+  */
+void EMACC_SetIdRef(int16_t hIdref)
+{
+    EMACC->ID_REF = (uint32_t)(uint16_t)hIdref << 16;
+}
 
-    /*input ref */
-    EMACC->ID_REF = Iqdref.qI_Component2 << 16 | Iqdref.qI_Component1;
-    EMACC->IQ_REF = Iqdref.qI_Component2 << 16 | Iqdref.qI_Component1;
+/**
+  * @brief  Set the reference current of the Q axis PI.
+  * @param  hIqref: reference current of the Q axis
+  * @retval None
+  */
+void EMACC_SetIqRef(int16_t hIqref)
+{
+    EMACC->IQ_REF = (uint16_t)hIqref;
+}
+
+/**
+  * @brief  Set the reference currents of both PI.
+  * @param  Iqdref: Reference current of the d&q coordinate axis,
+  *         qI_Component1 is Iq and qI_Component2 is Id
+  * @retval None
+  */
+void EMACC_SetIqdRef(Curr_Components Iqdref)
+{
+    EMACC_SetIdRef(Iqdref.qI_Component2);
+    EMACC_SetIqRef(Iqdref.qI_Component1);
+}
 
+/**
+  * @brief  Start the EMACC chain without waiting for the result.
+  * @note   The references set by EMACC_SetIqdRef() are used. Loading Iab
+  *         starts the calculation, the result is read by EMACC_GetCalResult()
+  *         once the EMACC_RPARK_STATUS flag is set, or passed to the callback
+  *         by EMACC_CalPoll(). It can be called from the ADC injected
+  *         conversion interrupt.
+  * @param  hElAngle: electric degress
+  * @param  Iab: current of the A axls and B axls
+  * @retval None
+  */
+void EMACC_StartCal(int16_t hElAngle, Curr_Components Iab)
+{
     /*input hElAngle*/
-    EMACC->ANG_LDR = hElAngle;
+    EMACC->ANG_LDR = (uint16_t)hElAngle;
 
     /*input Iab */
-    EMACC->CLARKE_LDR = (uint16_t)(Iab.qI_Component2) | ((uint16_t)(Iab.qI_Component1) << 16) ;
+    EMACC->CLARKE_LDR = (uint16_t)(Iab.qI_Component2) | ((uint32_t)(uint16_t)(Iab.qI_Component1) << 16);
+}
 
-    /*wait result*/
-    do
-    {
-        CaleStatus = EMACC->SR & EMACC_SR_RPARK_CF;
-    } while (CaleStatus == 0);
+/**
+  * @brief  Read the result of the EMACC chain and clear the status flags.
+  * @note   The EMACC_RPARK_STATUS flag must be set.
+  * @retval Valpha in qV_Component1 and Vbeta in qV_Component2
+  */
+Volt_Components EMACC_GetCalResult(void)
+{
+    uint32_t tmpreg;
+    Volt_Components Valphabeta;
 
-    Valphabeta.qV_Component1 = (EMACC->REVPARK_OUT >> 16) & 0xFFFF;
-    Valphabeta.qV_Component2 = EMACC->REVPARK_OUT & 0xFFFF;
+    tmpreg = EMACC->REVPARK_OUT;
+    Valphabeta.qV_Component1 = (int16_t)(tmpreg >> 16);
+    Valphabeta.qV_Component2 = (int16_t)(tmpreg & 0xFFFF);
 
     /*clear status*/
-    EMACC->CLRSR |= EMACC_CLEAR_STATUS_MASK;
+    EMACC->CLRSR = EMACC_CLEAR_STATUS_MASK;
 
     return Valphabeta;
 }
+
+/**
+  * @brief  Set the function called by EMACC_CalPoll() with the result.
+  * @param  Callback: function to call, 0 to disable.
+  * @retval None
+  */
+void EMACC_SetCalCallback(EMACC_CalCallback Callback)
+{
+    CalCallback = Callback;
+}
+
+/**
+  * @brief  Collect the result of a calculation started by EMACC_StartCal()
+  *         or advance the batch started by EMACC_CalBatch() by one sample.
+  * @note   The EMACC has no interrupt enable bit, so nothing calls this
+  *         function on completion: it is a step function polled by the
+  *         application, e.g. from the main loop or from the next interrupt
+  *         of the control loop, the chain taking a few tens of cycles. It
+  *         returns at once while the chain is still running.
+  * @note   During a batch each result is stored and the next sample is
+  *         started at once, the callback is only called with the result of
+  *         the last sample.
+  * @retval None
+  */
+void EMACC_CalPoll(void)
+{
+    Volt_Components Valphabeta;
+
+    if ((EMACC->SR & EMACC_SR_RPARK_CF) == 0)
+    {
+        return;
+    }
+
+    Valphabeta = EMACC_GetCalResult();
+
+    if (BatchCount != 0)
+    {
+        *BatchResult++ = Valphabeta;
+
+        if (--BatchCount != 0)
+        {
+            EMACC_StartCal(BatchSample->hElAngle, BatchSample->Iab);
+            BatchSample++;
+            return;
+        }
+    }
+
+    if (CalCallback != 0)
+    {
+        CalCallback(Valphabeta);
+    }
+}
+
+/**
+  * @brief  Start the EMACC chain on an array of samples.
+  * @note   The first sample is started here and each following one by
+  *         EMACC_CalPoll() when it finds the previous result, so the CPU can
+  *         do other work between the polls instead of waiting for the chain.
+  *         The end of the batch is signaled by the callback set by
+  *         EMACC_SetCalCallback() or by EMACC_GetCalBatchCount() returning 0.
+  * @note   The PI integral terms are carried from one sample to the next, as
+  *         in the control loop. The arrays must stay valid until the end of
+  *         the batch.
+  * @param  pSample: angle and Iab of each sample
+  * @param  Iqdref: Reference current of the d&q coordinate axis
+  * @param  pValphabeta: receives Valpha and Vbeta of each sample
+  * @param  Count: number of samples
+  * @retval None
+  */
+void EMACC_CalBatch(const EMACC_Sample* pSample, Curr_Components Iqdref,
+                    Volt_Components* pValphabeta, uint32_t Count)
+{
+    if (Count == 0)
+    {
+        return;
+    }
+
+    EMACC_SetIqdRef(Iqdref);
+
+    BatchSample = pSample + 1;
+    BatchResult = pValphabeta;
+    BatchCount = Count;
+
+    EMACC_StartCal(pSample->hElAngle, pSample->Iab);
+}
+
+/**
+  * @brief  Get the number of samples of the batch still to be calculated.
+  * @retval Number of samples, 0 when the batch is complete.
+  */
+uint32_t EMACC_GetCalBatchCount(void)
+{
+    return BatchCount;
+}
 /**
   * @}
   */
@@ -405,6 +576,231 @@ void EMACC_ClearFlag( uint16_t EMACC_FLAG)
     /* Clear the flags */
     EMACC->CLRSR |= (uint16_t)EMACC_FLAG;
 }
+/** @defgroup EMACC_Group5 EMACC Software model
+ *  @brief   Software model of the EMACC chain.
+ *
+@verbatim
+ ===============================================================================
+                ##### EMACC Software model #####
+ ===============================================================================
+    [..] The model runs the CORDIC, Clarke, Park, PI, circle limitation and
+         reverse Park stages with the integer arithmetic of the EMACC, so
+         that the results of the hardware can be checked, on the target or
+         on a host. It does not access the peripheral.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Saturate a 32 bits value to the q15 range, -32768 excluded.
+  * @param  wValue: value to saturate
+  * @retval Saturated value
+  */
+static int16_t EMACC_ModelSat16(int32_t wValue)
+{
+    if (wValue > 32767)
+    {
+        wValue = 32767;
+    }
+    else if (wValue < -32767)
+    {
+        wValue = -32767;
+    }
+
+    return (int16_t)wValue;
+}
+
+/**
+  * @brief  Run one PI of the model.
+  * @param  PI: PI configuration
+  * @param  pIntegralTerm: integral term, updated
+  * @param  wError: reference minus measure
+  * @retval PI output
+  */
+static int16_t EMACC_ModelPI(EMACC_PI_InitTypeDef* PI, int32_t* pIntegralTerm, int32_t wError)
+{
+    int32_t wKp = (int16_t)(PI->wKpiGain >> 16);
+    int32_t wKi = (int16_t)(PI->wKpiGain & 0xFFFF);
+    int32_t wIntegral;
+    int32_t wSum;
+    int32_t wOutput;
+
+    if (wKi == 0)
+    {
+        *pIntegralTerm = 0;
+    }
+    else
+    {
+        wIntegral = wKi * wError;
+        wSum = (int32_t)((uint32_t)*pIntegralTerm + (uint32_t)wIntegral);
+
+        /* Saturate on overflow */
+        if ((*pIntegralTerm > 0) && (wIntegral > 0) && (wSum < 0))
+        {
+            wSum = 0x7FFFFFFF;
+        }
+        else if ((*pIntegralTerm < 0) && (wIntegral < 0) && (wSum >= 0))
+        {
+            wSum = -0x7FFFFFFF;
+        }
+
+        if (wSum > (int32_t)PI->wUpperIntegralLimit)
+        {
+            wSum = (int32_t)PI->wUpperIntegralLimit;
+        }
+        else if (wSum < (int32_t)PI->wLowerIntegralLimit)
+        {
+            wSum = (int32_t)PI->wLowerIntegralLimit;
+        }
+
+        *pIntegralTerm = wSum;
+    }
+
+    wOutput = ((wKp * wError) >> PI->hKpDivisorPOW2) + (*pIntegralTerm >> PI->hKiDivisorPOW2);
+
+    if (wOutput > PI->hUpperOutputLimit)
+    {
+        wOutput = PI->hUpperOutputLimit;
+    }
+    else if (wOutput < PI->hLowerOutputLimit)
+    {
+        wOutput = PI->hLowerOutputLimit;
+    }
+
+    return (int16_t)wOutput;
+}
+
+/**
+  * @brief  Initializes the software model like EMACC_Init() does the EMACC.
+  * @param  Model: model to initialize
+  * @param  EMACC_ID_InitStruct: PI configuration of the D axis
+  * @param  EMACC_IQ_InitStruct: PI configuration of the Q axis
+  * @retval None
+  */
+void EMACC_ModelInit(EMACC_ModelTypeDef* Model, EMACC_PI_InitTypeDef* EMACC_ID_InitStruct,
+                     EMACC_PI_InitTypeDef* EMACC_IQ_InitStruct)
+{
+    Model->PI_D = *EMACC_ID_InitStruct;
+    Model->PI_Q = *EMACC_IQ_InitStruct;
+    Model->wIntegralTermD = 0;
+    Model->wIntegralTermQ = 0;
+    Model->hMaxModule = CIRCLELIM_MAXMODULE;
+    Model->hStartIndex = CIRCLELIM_TABLE_INDEX;
+}
+
+/**
+  * @brief  Execute the software model of the EMACC chain.
+  * @param  Model: model state, holds the stage results on return
+  * @param  hElAngle: electric degress
+  * @param  Iab: current of the A axls and B axls
+  * @param  Iqdref: Reference current of the d&q coordinate axis
+  * @retval Valpha in qV_Component1 and Vbeta in qV_Component2
+  */
+Volt_Components EMACC_ModelCal(EMACC_ModelTypeDef* Model, int16_t hElAngle,
+                               Curr_Components Iab, Curr_Components Iqdref)
+{
+    int32_t x, y, z, tmp;
+    int32_t i;
+    uint8_t bNegate;
+    uint32_t wModule;
+    uint32_t wIndex;
+    int16_t hCos, hSin;
+    Volt_Components Vqd;
+    Volt_Components Valphabeta;
+
+    /* CORDIC: rotate outside of +/-PI/2 by PI, then negate the result */
+    z = hElAngle;
+    bNegate = 0;
+
+    if ((z > 16384) || (z < -16384))
+    {
+        z = (int16_t)(z + 32768);
+        bNegate = 1;
+    }
+
+    z = z * (1 << EMACC_CORDIC_GUARD);
+
+    x = EMACC_CORDIC_GAIN;
+    y = 0;
+
+    for (i = 0; i < EMACC_CORDIC_STEPS; i++)
+    {
+        tmp = x;
+
+        if (z >= 0)
+        {
+            x = x - (y >> i);
+            y = y + (tmp >> i);
+            z -= CordicAtanTable[i];
+        }
+        else
+        {
+            x = x + (y >> i);
+            y = y - (tmp >> i);
+            z += CordicAtanTable[i];
+        }
+    }
+
+    if (bNegate != 0)
+    {
+        x = -x;
+        y = -y;
+    }
+
+    hCos = EMACC_ModelSat16((x + (1 << (EMACC_CORDIC_GUARD - 1))) >> EMACC_CORDIC_GUARD);
+    hSin = EMACC_ModelSat16((y + (1 << (EMACC_CORDIC_GUARD - 1))) >> EMACC_CORDIC_GUARD);
+    Model->hCos = hCos;
+    Model->hSin = hSin;
+
+    /* Clarke */
+    Model->Ialphabeta.qI_Component1 = Iab.qI_Component1;
+    Model->Ialphabeta.qI_Component2 = EMACC_ModelSat16((-(EMACC_DIVSQRT_3 * Iab.qI_Component1)
+                                                        - (2 * EMACC_DIVSQRT_3 * Iab.qI_Component2)) >> 15);
+
+    /* Park */
+    Model->Iqd.qI_Component1 = EMACC_ModelSat16(((int32_t)Model->Ialphabeta.qI_Component1 * hCos
+                                                 - (int32_t)Model->Ialphabeta.qI_Component2 * hSin) >> 15);
+    Model->Iqd.qI_Component2 = EMACC_ModelSat16(((int32_t)Model->Ialphabeta.qI_Component1 * hSin
+                                                 + (int32_t)Model->Ialphabeta.qI_Component2 * hCos) >> 15);
+
+    /* PI */
+    Vqd.qV_Component1 = EMACC_ModelPI(&Model->PI_Q, &Model->wIntegralTermQ,
+                                      (int32_t)Iqdref.qI_Component1 - Model->Iqd.qI_Component1);
+    Vqd.qV_Component2 = EMACC_ModelPI(&Model->PI_D, &Model->wIntegralTermD,
+                                      (int32_t)Iqdref.qI_Component2 - Model->Iqd.qI_Component2);
+
+    /* Circle limitation with MMItable */
+    wModule = (uint32_t)((int32_t)Vqd.qV_Component1 * Vqd.qV_Component1)
+              + (uint32_t)((int32_t)Vqd.qV_Component2 * Vqd.qV_Component2);
+
+    if (wModule > (uint32_t)Model->hMaxModule * Model->hMaxModule)
+    {
+        wIndex = (wModule >> 24) - Model->hStartIndex;
+
+        if (wIndex > 64)
+        {
+            wIndex = 64;
+        }
+
+        Vqd.qV_Component1 = (int16_t)(((int32_t)Vqd.qV_Component1 * MMItable[wIndex]) / 32768);
+        Vqd.qV_Component2 = (int16_t)(((int32_t)Vqd.qV_Component2 * MMItable[wIndex]) / 32768);
+    }
+
+    Model->Vqd = Vqd;
+
+    /* Reverse Park */
+    Valphabeta.qV_Component1 = (int16_t)(((int32_t)Vqd.qV_Component1 * hCos
+                                          + (int32_t)Vqd.qV_Component2 * hSin) >> 15);
+    Valphabeta.qV_Component2 = (int16_t)(((int32_t)Vqd.qV_Component2 * hCos
+                                          - (int32_t)Vqd.qV_Component1 * hSin) >> 15);
+
+    return Valphabeta;
+}
+/**
+  * @}
+  */
+
 /**
   * @}
   */
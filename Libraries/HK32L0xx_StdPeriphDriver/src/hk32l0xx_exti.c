@@ -106,7 +106,7 @@ void EXTI_DeInit(void)
   */
 void EXTI_Init(EXTI_InitTypeDef* EXTI_InitStruct)
 {
-    uint32_t tmp = 0;
+    __IO uint8_t* tmp = 0;
 
     /* Check the parameters */
     assert_param(IS_EXTI_MODE(EXTI_InitStruct->EXTI_Mode));
@@ -114,7 +114,7 @@ void EXTI_Init(EXTI_InitTypeDef* EXTI_InitStruct)
     assert_param(IS_EXTI_LINE(EXTI_InitStruct->EXTI_Line));
     assert_param(IS_FUNCTIONAL_STATE(EXTI_InitStruct->EXTI_LineCmd));
 
-    tmp = (uint32_t)EXTI_BASE;
+    tmp = (__IO uint8_t*)EXTI;
 
     if (EXTI_InitStruct->EXTI_LineCmd != DISABLE)
     {
@@ -139,7 +139,7 @@ void EXTI_Init(EXTI_InitTypeDef* EXTI_InitStruct)
         }
         else
         {
-            tmp = (uint32_t)EXTI_BASE;
+            tmp = (__IO uint8_t*)EXTI;
             tmp += EXTI_InitStruct->EXTI_Trigger;
 
             *(__IO uint32_t *) tmp |= EXTI_InitStruct->EXTI_Line;
@@ -36,6 +36,8 @@
            (++) Lock and Unlock the Flash interface.
            (++) Erase function: Erase Page, erase all pages.
            (++) Program functions: Half Word and Word write.
+           (++) Buffer program functions, run from SRAM, blocking or
+                interrupt driven.
 
        (#) FLASH Option Bytes Programming functions: this group includes all
            needed functions to:
@@ -76,7 +78,21 @@
 
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+/** @defgroup FLASH_Private_Variables FLASH_Private_Variables
+  * @{
+  */
+/* Buffer programmed by FLASH_ProgramBufferIT() */
+static __IO uint32_t* FLASH_BufferDest;
+static const uint32_t* FLASH_BufferData;
+static __IO uint32_t FLASH_BufferCount = 0;
+static __IO FLASH_Status FLASH_BufferStatus = FLASH_COMPLETE;
+/**
+  * @}
+  */
+
 /* Private function prototypes -----------------------------------------------*/
+static FLASH_RAMFUNC FLASH_Status FLASH_WaitForLastOperationRAM(uint32_t Timeout);
+static FLASH_RAMFUNC void FLASH_ProgramBufferEnd(FLASH_Status Status);
 /* Private functions ---------------------------------------------------------*/
 /** @defgroup FLASH_Private_Functions FLASH_Private_Functions
   * @{
@@ -200,12 +216,32 @@ FlagStatus FLASH_GetPrefetchBufferStatus(void)
        (+) FLASH_Status FLASH_ErasePage(uint32_t Page_Address);
        (+) FLASH_Status FLASH_EraseAllPages(void);
        (+) FLASH_Status FLASH_ProgramWord(uint32_t Address, uint32_t Data);
+       (+) FLASH_Status FLASH_ProgramBuffer(uint32_t Address, const uint32_t* pData, uint32_t NbWords);
+       (+) FLASH_Status FLASH_ProgramBufferIT(uint32_t Address, const uint32_t* pData, uint32_t NbWords);
+       (+) void FLASH_ProgramBufferIRQHandler(void);
+       (+) FLASH_Status FLASH_GetProgramBufferStatus(void);
     [..] Any operation of erase or program should follow these steps:
        (#) Call the FLASH_Unlock() function to enable the flash control register and
            program memory access
        (#) Call the desired function to erase page or program data
        (#) Call the FLASH_Lock() to disable the flash program memory access
       (recommended to protect the FLASH memory against possible unwanted operation)
+    [..] The CPU stalls on any fetch from the flash while an operation is
+         ongoing. FLASH_ProgramBuffer() and FLASH_ProgramBufferIRQHandler() are
+         placed in SRAM with FLASH_RAMFUNC (see the linker notes in
+         hk32l0xx_flash.h) and keep WPG set for the whole buffer:
+       (#) FLASH_ProgramBuffer() programs the buffer and returns when done.
+           Interrupts stay enabled: handlers marked FLASH_RAMFUNC run without
+           delay, handlers in flash wait for the end of the current word.
+       (#) FLASH_ProgramBufferIT() programs the first word and returns. The
+           next words are programmed on the end of operation interrupt: call
+           FLASH_ProgramBufferIRQHandler() from FLASH_IRQHandler(), enable
+           FLASH_IRQn in the NVIC and poll FLASH_GetProgramBufferStatus().
+       (#) To keep the latency of a critical interrupt during the programming,
+           mark its handler and all the functions it calls with FLASH_RAMFUNC.
+           The vector table is fetched from the flash too: copy it to the
+           start of SRAM and remap SRAM at address 0 with
+           SYSCFG_MemoryRemapConfig(SYSCFG_MemoryRemap_SRAM).
 @endverbatim
   * @{
   */
@@ -384,6 +420,199 @@ FLASH_Status FLASH_ProgramWord(uint32_t Address, uint32_t Data)
     return status;
 }
 
+/**
+  * @brief  Programs a buffer of words from SRAM.
+  * @note   To correctly run this function, the FLASH_Unlock() function must be called before.
+  * @note   WPG stays set from the first to the last word, and only the busy
+  *         flag is polled between two words. The function makes no call to
+  *         the flash, the parameters are not checked by assert_param().
+  * @param  Address: specifies the address to be programmed, word aligned.
+  * @param  pData: pointer to the words to be programmed.
+  * @param  NbWords: number of words to be programmed.
+  * @retval FLASH Status: The returned value can be: FLASH_ERROR_PROGRAM,
+  *         FLASH_ERROR_WRP, FLASH_COMPLETE or FLASH_TIMEOUT.
+  */
+FLASH_RAMFUNC FLASH_Status FLASH_ProgramBuffer(uint32_t Address, const uint32_t* pData, uint32_t NbWords)
+{
+    FLASH_Status status = FLASH_COMPLETE;
+    __IO uint32_t* pdest = (__IO uint32_t*)Address;
+
+    /* Wait for last operation to be completed */
+    status = FLASH_WaitForLastOperationRAM(FLASH_ER_PRG_TIMEOUT);
+
+    if ((status == FLASH_COMPLETE) && (NbWords != 0))
+    {
+        /* Enable the PG Bit once for the whole buffer */
+        FLASH->CR |= FLASH_CR_WPG;
+
+        do
+        {
+            *pdest++ = *pData++;
+
+            /* Wait for the word to be programmed */
+            status = FLASH_WaitForLastOperationRAM(FLASH_ER_PRG_TIMEOUT);
+            NbWords--;
+        }
+        while ((status == FLASH_COMPLETE) && (NbWords != 0));
+
+        /* Disable the PG Bit */
+        FLASH->CR &= ~FLASH_CR_WPG;
+    }
+
+    /* Return the Program Status */
+    return status;
+}
+
+/**
+  * @brief  Starts the interrupt driven programming of a buffer of words.
+  * @note   To correctly run this function, the FLASH_Unlock() function must be
+  *         called before, and the flash must stay unlocked until the end.
+  * @note   The first word is programmed here, the next ones by
+  *         FLASH_ProgramBufferIRQHandler() on the end of operation interrupt.
+  *         The buffer must stay valid until FLASH_GetProgramBufferStatus()
+  *         returns another value than FLASH_BUSY.
+  * @param  Address: specifies the address to be programmed, word aligned.
+  * @param  pData: pointer to the words to be programmed.
+  * @param  NbWords: number of words to be programmed.
+  * @retval FLASH Status: FLASH_COMPLETE if the programming is started or there
+  *         is nothing to program, FLASH_BUSY if a buffer or another operation
+  *         is ongoing, FLASH_ERROR_PROGRAM or FLASH_ERROR_WRP if an error flag
+  *         of a previous operation is still set.
+  */
+FLASH_Status FLASH_ProgramBufferIT(uint32_t Address, const uint32_t* pData, uint32_t NbWords)
+{
+    FLASH_Status status = FLASH_COMPLETE;
+
+    /* Check the parameters */
+    assert_param(IS_FLASH_PROGRAM_ADDRESS(Address));
+    assert_param(IS_FLASH_PROGRAM_ADDRESS(Address + (NbWords << 2) - 1));
+
+    if (FLASH_BufferStatus == FLASH_BUSY)
+    {
+        status = FLASH_BUSY;
+    }
+    else
+    {
+        status = FLASH_GetStatus();
+    }
+
+    if ((status == FLASH_COMPLETE) && (NbWords != 0))
+    {
+        FLASH_BufferDest = (__IO uint32_t*)Address;
+        FLASH_BufferData = pData + 1;
+        FLASH_BufferCount = NbWords;
+        FLASH_BufferStatus = FLASH_BUSY;
+
+        /* Enable the PG Bit and the interrupts once for the whole buffer */
+        FLASH->SR = FLASH_FLAG_EOP;
+        FLASH->CR |= FLASH_CR_WPG | FLASH_IT_EOP | FLASH_IT_ERR;
+
+        *FLASH_BufferDest = *pData;
+    }
+
+    return status;
+}
+
+/**
+  * @brief  Programs the next word of the buffer started by FLASH_ProgramBufferIT().
+  * @note   This function must be called from FLASH_IRQHandler(). It runs from
+  *         SRAM: FLASH_IRQHandler() should be marked FLASH_RAMFUNC too.
+  * @retval None
+  */
+FLASH_RAMFUNC void FLASH_ProgramBufferIRQHandler(void)
+{
+    uint32_t sr = FLASH->SR;
+
+    if (FLASH_BufferStatus != FLASH_BUSY)
+    {
+        return;
+    }
+
+    if ((sr & FLASH_FLAG_WRPERR) != (uint32_t)RESET)
+    {
+        FLASH_ProgramBufferEnd(FLASH_ERROR_WRP);
+    }
+    else if ((sr & (FLASH_FLAG_PGERR | FLASH_FLAG_SIZE_ERR)) != (uint32_t)RESET)
+    {
+        FLASH_ProgramBufferEnd(FLASH_ERROR_PROGRAM);
+    }
+    else if ((sr & FLASH_FLAG_EOP) != (uint32_t)RESET)
+    {
+        /* Clear the end of operation flag */
+        FLASH->SR = FLASH_FLAG_EOP;
+
+        if (--FLASH_BufferCount == 0)
+        {
+            FLASH_ProgramBufferEnd(FLASH_COMPLETE);
+        }
+        else
+        {
+            FLASH_BufferDest++;
+            *FLASH_BufferDest = *FLASH_BufferData++;
+        }
+    }
+}
+
+/**
+  * @brief  Returns the status of the buffer started by FLASH_ProgramBufferIT().
+  * @note   Runs from SRAM, to be polled by code in SRAM while the buffer is
+  *         programmed.
+  * @retval FLASH Status: The returned value can be: FLASH_BUSY while the
+  *         buffer is programmed, FLASH_ERROR_PROGRAM, FLASH_ERROR_WRP or
+  *         FLASH_COMPLETE.
+  */
+FLASH_RAMFUNC FLASH_Status FLASH_GetProgramBufferStatus(void)
+{
+    return FLASH_BufferStatus;
+}
+
+/**
+  * @brief  Waits for a FLASH operation to complete or a TIMEOUT to occur,
+  *         without any fetch from the flash.
+  * @param  Timeout: FLASH programming Timeout
+  * @retval FLASH Status: The returned value can be: FLASH_ERROR_PROGRAM,
+  *         FLASH_ERROR_WRP, FLASH_COMPLETE or FLASH_TIMEOUT.
+  */
+static FLASH_RAMFUNC FLASH_Status FLASH_WaitForLastOperationRAM(uint32_t Timeout)
+{
+    FLASH_Status status = FLASH_COMPLETE;
+    uint32_t sr = FLASH->SR;
+
+    while (((sr & FLASH_FLAG_BSY) != (uint32_t)RESET) && (Timeout != 0x00))
+    {
+        sr = FLASH->SR;
+        Timeout--;
+    }
+
+    if ((sr & FLASH_FLAG_BSY) != (uint32_t)RESET)
+    {
+        status = FLASH_TIMEOUT;
+    }
+    else if ((sr & FLASH_FLAG_WRPERR) != (uint32_t)RESET)
+    {
+        status = FLASH_ERROR_WRP;
+    }
+    else if ((sr & (FLASH_FLAG_PGERR | FLASH_FLAG_SIZE_ERR)) != (uint32_t)RESET)
+    {
+        status = FLASH_ERROR_PROGRAM;
+    }
+
+    return status;
+}
+
+/**
+  * @brief  Ends the buffer started by FLASH_ProgramBufferIT().
+  * @param  Status: final status of the buffer.
+  * @retval None
+  */
+static FLASH_RAMFUNC void FLASH_ProgramBufferEnd(FLASH_Status Status)
+{
+    /* Disable the PG Bit and the interrupts */
+    FLASH->CR &= ~(FLASH_CR_WPG | FLASH_IT_EOP | FLASH_IT_ERR);
+    FLASH_BufferCount = 0;
+    FLASH_BufferStatus = Status;
+}
+
 /**
   * @}
   */
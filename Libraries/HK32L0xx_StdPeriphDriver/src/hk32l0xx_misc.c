@@ -23,8 +23,13 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+#define NVIC_SHARED_VECTORS          6
+
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+/* Handler tables of the shared vectors, indexed by NVIC_SharedIndex() */
+static NVIC_SharedVectorTypeDef* NVIC_SharedTable[NVIC_SHARED_VECTORS] = {NULL};
+
 /* Private function prototypes -----------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
 /** @defgroup MISC_Private_Functions MISC_Private_Functions
@@ -132,6 +137,224 @@ void SysTick_CLKSourceConfig(uint32_t SysTick_CLKSource)
     }
 }
 
+/**
+  *
+@verbatim
+    ===============================================================================
+                      ##### Shared vector functions #####
+    ===============================================================================
+    [..] DMA_CH4_7, ADC_COMP1_2, UART3_4, AES_TRNG_EMACC, LCD_CAN and USB_DVSQ
+         are each shared by several sources. Instead of a chain of flag tests
+         in the IRQ handler, the sources are registered in a handler table in
+         RAM with the status register and the bits telling they are pending:
+         (#) NVIC_SharedInit() attaches a NVIC_SharedVectorTypeDef table to
+             the vector.
+         (#) NVIC_SharedRegister() adds a source; the sources are served in
+             the order they were registered.
+         (#) The IRQ handler of the vector calls NVIC_SharedDispatch().
+    [..] The dispatch reads each status register once (sources using the same
+         register must be registered one after the other) and only calls the
+         handlers of the pending sources.
+    [..] For each source the table keeps the number of calls and, while
+         SysTick runs, the longest call in SysTick counts. The counts are
+         core cycles when SysTick is clocked by HCLK; a call longer than the
+         SysTick period is not measured correctly.
+@endverbatim
+*/
+
+/**
+  * @brief  Index of a shared vector in NVIC_SharedTable.
+  * @param  IRQn: shared vector.
+  * @retval Index, NVIC_SHARED_VECTORS if IRQn is not shared.
+  */
+static uint32_t NVIC_SharedIndex(IRQn_Type IRQn)
+{
+    switch (IRQn)
+    {
+        case DMA_CH4_7_IRQn:
+            return 0;
+
+        case ADC_COMP1_2_IRQn:
+            return 1;
+
+        case UART3_4_IRQn:
+            return 2;
+
+        case AES_TRNG_EMACC_IRQn:
+            return 3;
+
+        case LCD_CAN_IRQn:
+            return 4;
+
+        case USB_DVSQ_IRQn:
+            return 5;
+
+        default:
+            return NVIC_SHARED_VECTORS;
+    }
+}
+
+/**
+  * @brief  Attaches an empty handler table to a shared vector.
+  * @note   Call it with the vector disabled in the NVIC.
+  * @param  Vector: pointer to the handler table, kept by the driver.
+  * @param  IRQn: shared vector, one of DMA_CH4_7_IRQn, ADC_COMP1_2_IRQn,
+  *         UART3_4_IRQn, AES_TRNG_EMACC_IRQn, LCD_CAN_IRQn or USB_DVSQ_IRQn.
+  * @retval None
+  */
+void NVIC_SharedInit(NVIC_SharedVectorTypeDef* Vector, IRQn_Type IRQn)
+{
+    uint32_t index = NVIC_SharedIndex(IRQn);
+
+    /* Check the parameters */
+    assert_param(IS_NVIC_SHARED_IRQ(IRQn));
+
+    Vector->NbSources = 0;
+    NVIC_SharedResetStats(Vector);
+
+    if (index < NVIC_SHARED_VECTORS)
+    {
+        NVIC_SharedTable[index] = Vector;
+    }
+}
+
+/**
+  * @brief  Adds a source to a shared vector.
+  * @note   The source is served by the next interrupt of the vector: its
+  *         entry is complete before NbSources includes it.
+  * @param  Vector: pointer to the handler table.
+  * @param  Handler: function called while the source is pending.
+  * @param  Status: status register of the source, NULL to call Handler on
+  *         every interrupt of the vector.
+  * @param  Mask: bits of Status telling the source is pending, for example
+  *         DMA1_IT_GL4 with &DMA->ISR.
+  * @retval SUCCESS, or ERROR if the table is full.
+  */
+ErrorStatus NVIC_SharedRegister(NVIC_SharedVectorTypeDef* Vector, void (*Handler)(void),
+                                __I uint32_t* Status, uint32_t Mask)
+{
+    NVIC_SharedSourceTypeDef* source;
+
+    if ((Handler == NULL) || (Vector->NbSources >= NVIC_SHARED_SOURCES_MAX))
+    {
+        return ERROR;
+    }
+
+    source = &Vector->Source[Vector->NbSources];
+    source->Handler = Handler;
+    source->Status = Status;
+    source->Mask = Mask;
+    source->Count = 0;
+    source->MaxCycles = 0;
+
+    Vector->NbSources++;
+
+    return SUCCESS;
+}
+
+/**
+  * @brief  Calls the handlers of the pending sources of a shared vector.
+  * @note   To be called from the IRQ handler of the vector. A source that is
+  *         still pending afterwards raises the interrupt again.
+  * @param  IRQn: shared vector.
+  * @retval None
+  */
+void NVIC_SharedDispatch(IRQn_Type IRQn)
+{
+    uint32_t index = NVIC_SharedIndex(IRQn);
+    NVIC_SharedVectorTypeDef* vector;
+    NVIC_SharedSourceTypeDef* source;
+    __I uint32_t* status = NULL;
+    uint32_t value = 0;
+    uint32_t served = 0;
+    uint32_t reload;
+    uint32_t start;
+    uint32_t end;
+    uint32_t cycles;
+    uint32_t i;
+
+    if (index >= NVIC_SHARED_VECTORS)
+    {
+        return;
+    }
+
+    vector = NVIC_SharedTable[index];
+
+    if (vector == NULL)
+    {
+        return;
+    }
+
+    vector->Count++;
+
+    for (i = 0; i < vector->NbSources; i++)
+    {
+        source = &vector->Source[i];
+
+        if (source->Status != NULL)
+        {
+            /* One read per status register */
+            if (source->Status != status)
+            {
+                status = source->Status;
+                value = *status;
+            }
+
+            if ((value & source->Mask) == 0)
+            {
+                continue;
+            }
+        }
+
+        if ((SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) != 0)
+        {
+            reload = SysTick->LOAD;
+            start = SysTick->VAL;
+            source->Handler();
+            end = SysTick->VAL;
+
+            /* SysTick counts down from LOAD to 0 */
+            cycles = (start >= end) ? (start - end) : (start + reload + 1 - end);
+
+            if (cycles > source->MaxCycles)
+            {
+                source->MaxCycles = cycles;
+            }
+        }
+        else
+        {
+            source->Handler();
+        }
+
+        source->Count++;
+        served++;
+    }
+
+    if (served == 0)
+    {
+        vector->Spurious++;
+    }
+}
+
+/**
+  * @brief  Clears the call counts and longest calls of a shared vector.
+  * @param  Vector: pointer to the handler table.
+  * @retval None
+  */
+void NVIC_SharedResetStats(NVIC_SharedVectorTypeDef* Vector)
+{
+    uint32_t i;
+
+    for (i = 0; i < NVIC_SHARED_SOURCES_MAX; i++)
+    {
+        Vector->Source[i].Count = 0;
+        Vector->Source[i].MaxCycles = 0;
+    }
+
+    Vector->Count = 0;
+    Vector->Spurious = 0;
+}
+
 /**
   * @}
   */
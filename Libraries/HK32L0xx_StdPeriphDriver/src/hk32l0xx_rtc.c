@@ -2160,16 +2160,16 @@ void RTC_TamperPullUpCmd(FunctionalState NewState)
   */
 void RTC_WriteBackupRegister(uint32_t RTC_BKP_DR, uint32_t Data)
 {
-    __IO uint32_t tmp = 0;
+    __IO uint32_t* tmp = 0;
 
     /* Check the parameters */
     assert_param(IS_RTC_BKP(RTC_BKP_DR));
 
-    tmp = RTC_BASE + 0x50;
-    tmp += (RTC_BKP_DR * 4);
+    tmp = &RTC->BKP0R;
+    tmp += RTC_BKP_DR;
 
     /* Write the specified register */
-    *(__IO uint32_t *)tmp = (uint32_t)Data;
+    *tmp = (uint32_t)Data;
 }
 
 /**
@@ -2181,16 +2181,16 @@ void RTC_WriteBackupRegister(uint32_t RTC_BKP_DR, uint32_t Data)
   */
 uint32_t RTC_ReadBackupRegister(uint32_t RTC_BKP_DR)
 {
-    __IO uint32_t tmp = 0;
+    __IO uint32_t* tmp = 0;
 
     /* Check the parameters */
     assert_param(IS_RTC_BKP(RTC_BKP_DR));
 
-    tmp = RTC_BASE + 0x50;
-    tmp += (RTC_BKP_DR * 4);
+    tmp = &RTC->BKP0R;
+    tmp += RTC_BKP_DR;
 
     /* Read the specified register */
-    return (*(__IO uint32_t *)tmp);
+    return (*tmp);
 }
 
 /**
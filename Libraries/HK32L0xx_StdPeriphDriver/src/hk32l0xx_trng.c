@@ -28,6 +28,15 @@
   * @}
   */
 
+/** @defgroup TRNG_Private_Variables  TRNG_Private_Variables
+  * @{
+  */
+/* Pool filled by AES_TRNG_IRQHandler(), set by TRNG_PoolStart() */
+static TRNG_PoolTypeDef* TRNG_ActivePool = NULL;
+/**
+  * @}
+  */
+
 /** @defgroup TRNG_Private_Functions    TRNG_Private_Functions
   * @{
   */
@@ -313,6 +322,317 @@ void TRNG_ClearITPendingBit(uint32_t TRNG_IT)
   * @}
   */
 
+/** @defgroup TRNG_Group4 Entropy pool functions
+ *  @brief    Entropy pool functions
+ *
+ @verbatim
+ ===============================================================================
+                      ##### Entropy pool functions #####
+ ===============================================================================
+    [..]  The entropy pool keeps TRNG_POOL_SIZE words converted in the
+          background so that a reader such as the AES_DRBG never waits on the
+          TRNG. AES_TRNG_IRQHandler() must be called from the
+          AES_TRNG_EMACC_IRQHandler() vector; it stores each conversion and
+          starts the next one until the pool is full. TRNG_PoolGet() restarts
+          the conversions once it has made room.
+    [..]  Every word goes through two continuous health tests on its four byte
+          samples, after SP 800-90B 4.4 for an assumed 4 bits of entropy per
+          byte and a false positive rate of 2^-20:
+      (+) Repetition count test: TRNG_POOL_RCT_CUTOFF equal samples in a row.
+      (+) Adaptive proportion test: TRNG_POOL_APT_CUTOFF occurrences of the
+          first sample of a TRNG_POOL_APT_WINDOW sample window.
+    [..]  The first TRNG_POOL_STARTUP_WORDS words are tested but not kept. A
+          failure or a seed error discards the pool content and runs the
+          startup test again; after TRNG_POOL_MAX_FAILURES failures without a
+          complete startup test in between the pool stops and Error is set.
+    [..]  TRNG_PoolInit(), TRNG_PoolAdd() and TRNG_PoolRead() do not access the
+          TRNG and can be fed from any sample source.
+
+ @endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Discards the pool content and restarts the health tests after a
+  *         failure.
+  * @param  Pool: pointer to the entropy pool.
+  * @retval None
+  */
+static void TRNG_PoolFail(TRNG_PoolTypeDef* Pool)
+{
+    /* The reader skips every word written so far */
+    Pool->Flush = Pool->Head;
+    Pool->RctCount = 0;
+    Pool->AptIndex = 0;
+    Pool->Startup = TRNG_POOL_STARTUP_WORDS;
+
+    if (++Pool->Failures >= TRNG_POOL_MAX_FAILURES)
+    {
+        Pool->Error = 1;
+    }
+}
+
+/**
+  * @brief  Initializes an entropy pool, empty and in startup test.
+  * @param  Pool: pointer to the entropy pool.
+  * @retval None
+  */
+void TRNG_PoolInit(TRNG_PoolTypeDef* Pool)
+{
+    uint32_t i;
+
+    for (i = 0; i < TRNG_POOL_SIZE; i++)
+    {
+        Pool->Buffer[i] = 0;
+    }
+
+    Pool->Head = 0;
+    Pool->Tail = 0;
+    Pool->Flush = 0;
+    Pool->Running = 0;
+    Pool->Error = 0;
+    Pool->Failures = 0;
+    Pool->RctSample = 0;
+    Pool->RctCount = 0;
+    Pool->AptSample = 0;
+    Pool->AptCount = 0;
+    Pool->AptIndex = 0;
+    Pool->Startup = TRNG_POOL_STARTUP_WORDS;
+    Pool->Words = 0;
+    Pool->HealthFailures = 0;
+    Pool->SeedErrors = 0;
+}
+
+/**
+  * @brief  Runs the health tests on a TRNG word and keeps it in the pool.
+  * @note   The word is dropped when the pool is full or in startup test.
+  * @param  Pool: pointer to the entropy pool.
+  * @param  Sample: 32-bit word read from the TRNG.
+  * @retval SUCCESS if the word passed the health tests, ERROR otherwise.
+  */
+ErrorStatus TRNG_PoolAdd(TRNG_PoolTypeDef* Pool, uint32_t Sample)
+{
+    uint32_t i;
+    uint8_t byte;
+    uint8_t failed = 0;
+
+    if (Pool->Error != 0)
+    {
+        return ERROR;
+    }
+
+    for (i = 0; i < 4; i++)
+    {
+        byte = (uint8_t)(Sample >> (8 * i));
+
+        /* Repetition count test */
+        if ((Pool->RctCount != 0) && (byte == Pool->RctSample))
+        {
+            if (++Pool->RctCount >= TRNG_POOL_RCT_CUTOFF)
+            {
+                failed = 1;
+            }
+        }
+        else
+        {
+            Pool->RctSample = byte;
+            Pool->RctCount = 1;
+        }
+
+        /* Adaptive proportion test */
+        if (Pool->AptIndex == 0)
+        {
+            Pool->AptSample = byte;
+            Pool->AptCount = 1;
+        }
+        else if (byte == Pool->AptSample)
+        {
+            if (++Pool->AptCount >= TRNG_POOL_APT_CUTOFF)
+            {
+                failed = 1;
+            }
+        }
+
+        if (++Pool->AptIndex >= TRNG_POOL_APT_WINDOW)
+        {
+            Pool->AptIndex = 0;
+        }
+    }
+
+    if (failed != 0)
+    {
+        Pool->HealthFailures++;
+        TRNG_PoolFail(Pool);
+        return ERROR;
+    }
+
+    if (Pool->Startup != 0)
+    {
+        if (--Pool->Startup == 0)
+        {
+            Pool->Failures = 0;
+        }
+        return SUCCESS;
+    }
+
+    /* Words not read yet, flushed ones included, are never overwritten */
+    if ((Pool->Head - Pool->Tail) < TRNG_POOL_SIZE)
+    {
+        Pool->Buffer[Pool->Head & (TRNG_POOL_SIZE - 1)] = Sample;
+        Pool->Head++;
+        Pool->Words++;
+    }
+
+    return SUCCESS;
+}
+
+/**
+  * @brief  Returns the number of bytes the pool can deliver.
+  * @param  Pool: pointer to the entropy pool.
+  * @retval Number of bytes.
+  */
+uint32_t TRNG_PoolGetCount(TRNG_PoolTypeDef* Pool)
+{
+    uint32_t tail = Pool->Tail;
+    uint32_t flush = Pool->Flush;
+
+    if ((int32_t)(flush - tail) > 0)
+    {
+        tail = flush;
+    }
+
+    return (Pool->Head - tail) * 4;
+}
+
+/**
+  * @brief  Reads bytes from the pool, all of them or none.
+  * @note   Each word is read once and wiped; the unused bytes of the last
+  *         word are discarded.
+  * @param  Pool: pointer to the entropy pool.
+  * @param  pData: pointer to the output buffer.
+  * @param  Length: number of bytes to read.
+  * @retval SUCCESS if Length bytes were read, ERROR if the pool holds less.
+  */
+ErrorStatus TRNG_PoolRead(TRNG_PoolTypeDef* Pool, uint8_t* pData, uint32_t Length)
+{
+    uint32_t tail = Pool->Tail;
+    uint32_t flush = Pool->Flush;
+    uint32_t word = 0;
+    uint32_t i;
+
+    if ((int32_t)(flush - tail) > 0)
+    {
+        tail = flush;
+    }
+
+    if ((Pool->Head - tail) < ((Length + 3) / 4))
+    {
+        Pool->Tail = tail;
+        return ERROR;
+    }
+
+    for (i = 0; i < Length; i++)
+    {
+        if ((i & 3) == 0)
+        {
+            word = Pool->Buffer[tail & (TRNG_POOL_SIZE - 1)];
+            Pool->Buffer[tail & (TRNG_POOL_SIZE - 1)] = 0;
+            tail++;
+        }
+
+        pData[i] = (uint8_t)word;
+        word >>= 8;
+    }
+
+    /* Frees the words for the interrupt once they are copied */
+    Pool->Tail = tail;
+
+    return SUCCESS;
+}
+
+/**
+  * @brief  Starts filling a pool from the TRNG in the background.
+  * @note   The TRNG must be initialized and the AES_TRNG_EMACC_IRQn interrupt
+  *         enabled in the NVIC. The pool is stopped for good when its Error
+  *         field is set.
+  * @param  Pool: pointer to the entropy pool, initialized by TRNG_PoolInit().
+  * @retval None
+  */
+void TRNG_PoolStart(TRNG_PoolTypeDef* Pool)
+{
+    TRNG_ActivePool = Pool;
+
+    if (Pool->Error == 0)
+    {
+        Pool->Running = 1;
+        TRNG_ITConfig(ENABLE);
+        TRNG_Cmd(ENABLE);
+    }
+}
+
+/**
+  * @brief  Reads bytes from the pool and restarts the conversions it stopped
+  *         when full.
+  * @param  Pool: pointer to the entropy pool started by TRNG_PoolStart().
+  * @param  pData: pointer to the output buffer.
+  * @param  Length: number of bytes to read.
+  * @retval SUCCESS if Length bytes were read, ERROR if the pool holds less.
+  */
+ErrorStatus TRNG_PoolGet(TRNG_PoolTypeDef* Pool, uint8_t* pData, uint32_t Length)
+{
+    ErrorStatus status = TRNG_PoolRead(Pool, pData, Length);
+
+    if ((Pool->Running == 0) && (Pool->Error == 0))
+    {
+        TRNG_PoolStart(Pool);
+    }
+
+    return status;
+}
+
+/**
+  * @brief  Fills the pool started by TRNG_PoolStart() from the TRNG.
+  * @note   To be called from AES_TRNG_EMACC_IRQHandler().
+  * @retval None
+  */
+void AES_TRNG_IRQHandler(void)
+{
+    TRNG_PoolTypeDef* pool = TRNG_ActivePool;
+
+    if (pool == NULL)
+    {
+        return;
+    }
+
+    if ((TRNG->SR & TRNG_IT_SEI) != (uint32_t)RESET)
+    {
+        /* Seed error: the conversion is lost and the pool content is suspect */
+        TRNG_ClearITPendingBit(TRNG_IT_SEI);
+        TRNG_Cmd(DISABLE);
+        pool->SeedErrors++;
+        TRNG_PoolFail(pool);
+    }
+    else if ((TRNG->SR & TRNG_FLAG_DRDY) != (uint32_t)RESET)
+    {
+        (void)TRNG_PoolAdd(pool, TRNG->DR);
+    }
+
+    if ((pool->Error != 0) || ((pool->Head - pool->Tail) >= TRNG_POOL_SIZE))
+    {
+        TRNG_ITConfig(DISABLE);
+        TRNG_Cmd(DISABLE);
+        pool->Running = 0;
+    }
+    else
+    {
+        /* Next conversion */
+        TRNG_Cmd(ENABLE);
+    }
+}
+/**
+  * @}
+  */
+
 /**
   * @}
   */
@@ -0,0 +1,28 @@
+@echo off
+REM ɾǰĿ¼ļмĿ¼ļ
+for /f "delims=" %%a in ('dir /b/s/ad') do (
+    REM ɾKEILļ
+    if "%%~na"=="DebugConfig" rd /s /q "%%a" 2>nul
+    if "%%~na"=="Listings" rd /s /q "%%a" 2>nul
+    if "%%~na"=="Objects" rd /s /q "%%a" 2>nul
+    
+    REM ɾIARļ
+    if "%%~na"=="Debug" rd /s /q "%%a" 2>nul
+    if "%%~na"=="settings" rd /s /q "%%a" 2>nul
+)
+
+REM ǰĿ¼Ŀ¼ĶӦ׺ļ
+for /f "delims=" %%i in ('dir /b /a-d /s "*.bak"') do del /a/f/q "%%i"
+for /f "delims=" %%i in ('dir /b /a-d /s "*.plg"') do del /a/f/q "%%i"
+for /f "delims=" %%i in ('dir /b /a-d /s "*.dep"') do del /a/f/q "%%i"
+for /f "delims=" %%i in ('dir /b /a-d /s "*.scvd"') do del /a/f/q "%%i"
+for /f "delims=" %%i in ('dir /b /a-d /s "*.ini"') do del /a/f/q "%%i"
+for /f "delims=" %%i in ('dir /b /a-d /s "*.uvguix.*"') do del /a/f/q "%%i"
+for /f "delims=" %%i in ('dir /b /a-d /s "*.txt"') do del /a/f/q "%%i"
+
+IAR๤ɾഴļ
+for /D %%i in ("../EWARM/*") do (
+	rd /s /q "%%i"
+)
+
+exit
\ No newline at end of file
@@ -0,0 +1,99 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  hk32l0xx_it.c
+* @brief:     Interrupt Service Routines
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-04
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "hk32l0xx_it.h"
+#include "hk32l0xx_eval.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+extern ADC_StreamTypeDef ADC_Stream;
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/******************************************************************************/
+/*            Cortex-M0 Processor Exceptions Handlers                         */
+/******************************************************************************/
+
+/**
+  * @brief  This function handles NMI exception.
+  * @retval None
+  */
+void NMI_Handler(void)
+{
+}
+
+/**
+  * @brief  This function handles Hard Fault exception.
+  * @retval None
+  */
+void HardFault_Handler(void)
+{
+    /* Go to infinite loop when Hard Fault exception occurs */
+    while (1)
+    {
+    }
+}
+
+/**
+  * @brief  This function handles SVCall exception.
+  * @retval None
+  */
+void SVC_Handler(void)
+{
+}
+
+/**
+  * @brief  This function handles PendSVC exception.
+  * @retval None
+  */
+void PendSV_Handler(void)
+{
+}
+
+/**
+  * @brief  This function handles SysTick Handler.
+  * @retval None
+  */
+void SysTick_Handler(void)
+{
+}
+
+/******************************************************************************/
+/*                 HK32L0xx Peripherals Interrupt Handlers                   */
+/*  Add here the Interrupt Handler for the used peripheral(s) (PPP), for the  */
+/*  available peripheral interrupt handler's name please refer to the startup */
+/*  file (KEIL_Startup_hk32l0xx.s).                                               */
+/******************************************************************************/
+
+/**
+  * @brief  This function handles DMA_CH1_IRQHandler Handler.
+  * @retval None
+  */
+void DMA_CH1_IRQHandler(void)
+{
+    /* Half and full buffer of the ADC acquisition */
+    ADC_StreamIRQHandler(ADC, &ADC_Stream);
+}
+
+/**
+  * @brief  This function handles ADC interrupts requests.
+  * @retval None
+  */
+void ADC_COMP_IRQHandler(void)
+{
+    /* Overrun: the acquisition starts again */
+    ADC_StreamIRQHandler(ADC, &ADC_Stream);
+}
+
+
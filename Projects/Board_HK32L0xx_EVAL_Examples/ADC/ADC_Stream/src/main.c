@@ -0,0 +1,313 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  main.c
+* @brief:     Main program body
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-19
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "hk32l0xx_eval.h"
+
+/** @addtogroup HK32L0xx_StdPeriph_Examples
+  * @{
+  */
+
+/** @addtogroup ADC_Stream
+  * @{
+  */
+
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define STREAM_CHANNELS         (ADC_Channel_0 | ADC_Channel_Vrefint | ADC_Channel_TempSensor)
+#define STREAM_NB_CHANNELS      3
+#define STREAM_BLOCK_LENGTH     64          /* Scans per half buffer */
+#define STREAM_RATE             10000       /* Scans per second, TIM1 update rate */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static uint16_t StreamBuffer[2 * STREAM_BLOCK_LENGTH * STREAM_NB_CHANNELS];
+static uint16_t StreamOutput[STREAM_BLOCK_LENGTH * STREAM_NB_CHANNELS];
+
+/* Calibration context, built with the first block */
+static ADC_CalibTypeDef ADC_Calib;
+static uint8_t CalibReady = 0;
+
+/* Converted samples of the last block */
+static uint16_t Millivolts[STREAM_BLOCK_LENGTH];
+static int16_t CentiDegrees[STREAM_BLOCK_LENGTH];
+
+/* Means over the last block */
+__IO uint32_t Pa0Millivolts = 0;
+__IO int32_t SensorCentiDegrees = 0;
+
+static void Stream_Block(ADC_StreamTypeDef* Stream, const uint16_t* Block);
+
+ADC_StreamTypeDef ADC_Stream =
+{
+    STREAM_CHANNELS,
+    ADC_SampleTime_55_5Cycles,
+    ADC_ExternalTrigConv_T1_TRGO,
+    ADC_ExternalTrigConvEdge_Rising,
+    ADC_OVS_RATIO_4,
+    ADC_OVS_SHIFT_RIGHT_2,
+    DMA_Channel1,
+    StreamBuffer,
+    STREAM_BLOCK_LENGTH,
+    StreamOutput,
+    Stream_Block,
+    0,
+    0,
+    0,
+    0
+};
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+static void ADC_Config(void);
+static void TIM1_Config(void);
+static void Display(void);
+static void USART_Config(void);
+
+/**
+  * @brief  Main program.
+  * @retval None
+  */
+int main(void)
+{
+    uint32_t lastBlocks = 0;
+
+    /* USART configuration */
+    USART_Config();
+
+    /* ADC, DMA and trigger timer configuration */
+    ADC_Config();
+    TIM1_Config();
+
+    printf("ADC stream: %d channels, %d scans per second, oversampling x4\r\n",
+           STREAM_NB_CHANNELS, STREAM_RATE);
+
+    /* Infinite loop */
+    while (1)
+    {
+        /* About once per second */
+        if ((ADC_Stream.Blocks - lastBlocks) >= (STREAM_RATE / STREAM_BLOCK_LENGTH))
+        {
+            lastBlocks = ADC_Stream.Blocks;
+            Display();
+        }
+    }
+}
+
+/**
+  * @brief  Called by the DMA interrupt with each block, one channel after
+  *         the other: measures VDDA with the Vrefint samples, converts the
+  *         PA0 and sensor samples and keeps their means.
+  * @param  Stream: the acquisition.
+  * @param  Block: STREAM_BLOCK_LENGTH samples per channel.
+  * @retval None
+  */
+static void Stream_Block(ADC_StreamTypeDef* Stream, const uint16_t* Block)
+{
+    const uint16_t* pa0 = &Block[ADC_StreamGetIndex(Stream, ADC_Channel_0) * STREAM_BLOCK_LENGTH];
+    const uint16_t* vrefint = &Block[ADC_StreamGetIndex(Stream, ADC_Channel_Vrefint) * STREAM_BLOCK_LENGTH];
+    const uint16_t* sensor = &Block[ADC_StreamGetIndex(Stream, ADC_Channel_TempSensor) * STREAM_BLOCK_LENGTH];
+    uint32_t sumMv = 0;
+    int32_t sumCenti = 0;
+    uint32_t i;
+
+    if (CalibReady == 0)
+    {
+        /* Reads the calibration words once */
+        if (ADC_CalibInit(&ADC_Calib, vrefint[0]) != SUCCESS)
+        {
+            return;
+        }
+
+        CalibReady = 1;
+    }
+
+    /* VDDA from the mean of the Vrefint samples, one divide per block */
+    ADC_CalibUpdateVdda(&ADC_Calib, vrefint, STREAM_BLOCK_LENGTH);
+
+    ADC_CalibBufferToMillivolts(&ADC_Calib, pa0, Millivolts, STREAM_BLOCK_LENGTH);
+    ADC_CalibBufferToCentiDegrees(&ADC_Calib, sensor, CentiDegrees, STREAM_BLOCK_LENGTH);
+
+    for (i = 0; i < STREAM_BLOCK_LENGTH; i++)
+    {
+        sumMv += Millivolts[i];
+        sumCenti += CentiDegrees[i];
+    }
+
+    Pa0Millivolts = sumMv / STREAM_BLOCK_LENGTH;
+    SensorCentiDegrees = sumCenti / STREAM_BLOCK_LENGTH;
+}
+
+/**
+  * @brief  Configure the USART Device
+  * @retval None
+  */
+static void USART_Config(void)
+{
+    USART_InitTypeDef USART_InitStructure;
+
+    /* USARTx configured as follow:
+    - BaudRate = 115200 baud
+    - Word Length = 8 Bits
+    - Stop Bit = 1 Stop Bit
+    - Parity = No Parity
+    - Hardware flow control disabled (RTS and CTS signals)
+    - Receive and transmit enabled
+    */
+    USART_InitStructure.USART_BaudRate = 115200;
+    USART_InitStructure.USART_WordLength = USART_WordLength_8b;
+    USART_InitStructure.USART_StopBits = USART_StopBits_1;
+    USART_InitStructure.USART_Parity = USART_Parity_No;
+    USART_InitStructure.USART_HardwareFlowControl = USART_HardwareFlowControl_None;
+    USART_InitStructure.USART_Mode = USART_Mode_Rx | USART_Mode_Tx;
+    HK_EVAL_COMInit(COM1, &USART_InitStructure);
+}
+
+/**
+  * @brief  ADC and DMA configuration of the acquisition
+  * @retval None
+  */
+static void ADC_Config(void)
+{
+    GPIO_InitTypeDef    GPIO_InitStructure;
+    NVIC_InitTypeDef    NVIC_InitStructure;
+
+    /* ADC DeInit */
+    ADC_DeInit(ADC);
+
+    /* GPIOA, SYSCFG and DMA Periph clock enable */
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_GPIOA, ENABLE);
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA, ENABLE);
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_SYSCFG, ENABLE);
+
+    /* Enable Vrefint ADC  */
+    SYSCFG_ADCVrefEnableCmd(ENABLE);
+
+    /* ADC Periph clock enable */
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_ADC, ENABLE);
+
+    /* Configure ADC channel0 as analog input */
+    GPIO_InitStructure.GPIO_Pin = GPIO_Pin_0;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AN;
+    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_NOPULL ;
+    GPIO_Init(GPIOA, &GPIO_InitStructure);
+
+    /* Internal channels */
+    ADC_TempSensorCmd(ADC, ENABLE);
+    ADC_VrefintCmd(ADC, ENABLE);
+    ADC_SetClock(ADC, ADC_ClockMode_SynClkDiv4);
+
+    /* Scans triggered by TIM1, circular DMA on channel 1 */
+    if (ADC_StreamInit(ADC, &ADC_Stream) != SUCCESS)
+    {
+        printf("ADC not ready\r\n");
+    }
+
+    /* DMA channel 1 interrupt, half and full buffer */
+    NVIC_InitStructure.NVIC_IRQChannel = DMA_CH1_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+
+    /* ADC interrupt, overrun */
+    NVIC_InitStructure.NVIC_IRQChannel = ADC_COMP1_2_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+
+    ADC_StreamStart(ADC, &ADC_Stream);
+}
+
+/**
+  * @brief  TIM1 update event on TRGO at STREAM_RATE.
+  * @retval None
+  */
+static void TIM1_Config(void)
+{
+    TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure;
+
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_TIM1, ENABLE);
+
+    /* TIM1 DeInit */
+    TIM_DeInit(TIM1);
+    TIM_TimeBaseStructInit(&TIM_TimeBaseStructure);
+
+    /* Time base configuration: 1 MHz counter */
+    TIM_TimeBaseStructure.TIM_Period = (1000000 / STREAM_RATE) - 1;
+    TIM_TimeBaseStructure.TIM_Prescaler = (SystemCoreClock / 1000000) - 1;
+    TIM_TimeBaseStructure.TIM_ClockDivision = 0x0;
+    TIM_TimeBaseStructure.TIM_CounterMode = TIM_CounterMode_Up;
+    TIM_TimeBaseInit(TIM1, &TIM_TimeBaseStructure);
+
+    TIM_SelectOutputTrigger(TIM1, TIM_TRGOSource_Update);
+
+    /* TIM1 enable counter */
+    TIM_Cmd(TIM1, ENABLE);
+}
+
+/**
+  * @brief  Display the converted means and the acquisition counters by UART.
+  * @retval None
+  */
+static void Display(void)
+{
+    int32_t temp = SensorCentiDegrees;
+    uint32_t absTemp = (temp < 0) ? (uint32_t)(-temp) : (uint32_t)temp;
+
+    if (CalibReady == 0)
+    {
+        printf(" Calibration words not valid\r\n");
+    }
+    else
+    {
+        printf(" VDDA    = %d mV\r\n", (int)ADC_Calib.Vdda);
+        printf(" V(PA0)  = %d mV\r\n", (int)Pa0Millivolts);
+        printf(" Sensor  = %s%d.%02d degree celsius\r\n", (temp < 0) ? "-" : "",
+               (int)(absTemp / 100), (int)(absTemp % 100));
+    }
+
+    printf(" Blocks %u, lost %u, overruns %u\r\n\r\n", (unsigned int)ADC_Stream.Blocks,
+           (unsigned int)ADC_Stream.Lost, (unsigned int)ADC_Stream.Overruns);
+}
+
+#ifdef  USE_FULL_ASSERT
+
+/**
+  * @brief  Reports the name of the source file and the source line number
+  *         where the assert_param error has occurred.
+  * @param  file: pointer to the source file name
+  * @param  line: assert_param error line source number
+  * @retval None
+  */
+void assert_failed(uint8_t* file, uint32_t line)
+{
+    /* User can add his own implementation to report the file name and line number,
+       ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
+
+    /* Infinite loop */
+    while (1)
+    {
+    }
+}
+#endif
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+
+
@@ -0,0 +1,486 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  main.c
+* @brief:     Main program body, checks the AES chaining modes against the NIST
+*             examples with the CPU, the DMA and the software model, then
+*             measures their cost.
+* @author:    AE Team
+* @version:   V1.0.0/2024-12-16
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/** @addtogroup HK32L0xx_StdPeriph_Examples
+  * @{
+  */
+
+/** @addtogroup AES_ChainingModes
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Way the blocks are computed */
+typedef struct
+{
+    const char* Name;
+    DMA_Channel_TypeDef* DMAIn_Channelx;
+    DMA_Channel_TypeDef* DMAOut_Channelx;
+    AES_ModelTypeDef* Model;
+} Engine_TypeDef;
+
+/* Key and expected results of one key size */
+typedef struct
+{
+    const uint8_t* Key;
+    uint32_t KeySize;
+    const uint8_t* CBCCipher;
+    const uint8_t* CTRCipher;
+    const uint8_t* CMAC;
+} KeyVectors_TypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define AES_DMA_CLK             RCC_AHBPeriph_DMA
+#define AES_DMA_IN_CHANNEL      DMA_Channel1
+#define AES_DMA_IN_REMAP        DMA_CSELR_CH1_AES_IN
+#define AES_DMA_OUT_CHANNEL     DMA_Channel2
+#define AES_DMA_OUT_REMAP       DMA_CSELR_CH2_AES_OUT
+
+#define ENGINE_COUNT            3
+#define VECTOR_SIZE             64
+#define BENCH_SIZE              1024
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* NIST SP 800-38A F.2 and F.5: plain text of the CBC and CTR examples, also the
+   message of the SP 800-38B CMAC examples (64 bytes) */
+static const uint8_t Plain[64] =
+{
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96,
+    0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+    0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c,
+    0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+    0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11,
+    0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+    0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17,
+    0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10
+};
+
+static const uint8_t Key128[16] =
+{
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+
+static const uint8_t Key256[32] =
+{
+    0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe,
+    0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+    0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7,
+    0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4
+};
+
+static const uint8_t CBCIV[16] =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+
+static const uint8_t CTRCounter[16] =
+{
+    0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+    0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
+};
+
+/* F.2.1 and F.2.5 */
+static const uint8_t CBCCipher128[64] =
+{
+    0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46,
+    0xce, 0xe9, 0x8e, 0x9b, 0x12, 0xe9, 0x19, 0x7d,
+    0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee,
+    0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2,
+    0x73, 0xbe, 0xd6, 0xb8, 0xe3, 0xc1, 0x74, 0x3b,
+    0x71, 0x16, 0xe6, 0x9e, 0x22, 0x22, 0x95, 0x16,
+    0x3f, 0xf1, 0xca, 0xa1, 0x68, 0x1f, 0xac, 0x09,
+    0x12, 0x0e, 0xca, 0x30, 0x75, 0x86, 0xe1, 0xa7
+};
+
+static const uint8_t CBCCipher256[64] =
+{
+    0xf5, 0x8c, 0x4c, 0x04, 0xd6, 0xe5, 0xf1, 0xba,
+    0x77, 0x9e, 0xab, 0xfb, 0x5f, 0x7b, 0xfb, 0xd6,
+    0x9c, 0xfc, 0x4e, 0x96, 0x7e, 0xdb, 0x80, 0x8d,
+    0x67, 0x9f, 0x77, 0x7b, 0xc6, 0x70, 0x2c, 0x7d,
+    0x39, 0xf2, 0x33, 0x69, 0xa9, 0xd9, 0xba, 0xcf,
+    0xa5, 0x30, 0xe2, 0x63, 0x04, 0x23, 0x14, 0x61,
+    0xb2, 0xeb, 0x05, 0xe2, 0xc3, 0x9b, 0xe9, 0xfc,
+    0xda, 0x6c, 0x19, 0x07, 0x8c, 0x6a, 0x9d, 0x1b
+};
+
+/* F.5.1 and F.5.5 */
+static const uint8_t CTRCipher128[64] =
+{
+    0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26,
+    0x1b, 0xef, 0x68, 0x64, 0x99, 0x0d, 0xb6, 0xce,
+    0x98, 0x06, 0xf6, 0x6b, 0x79, 0x70, 0xfd, 0xff,
+    0x86, 0x17, 0x18, 0x7b, 0xb9, 0xff, 0xfd, 0xff,
+    0x5a, 0xe4, 0xdf, 0x3e, 0xdb, 0xd5, 0xd3, 0x5e,
+    0x5b, 0x4f, 0x09, 0x02, 0x0d, 0xb0, 0x3e, 0xab,
+    0x1e, 0x03, 0x1d, 0xda, 0x2f, 0xbe, 0x03, 0xd1,
+    0x79, 0x21, 0x70, 0xa0, 0xf3, 0x00, 0x9c, 0xee
+};
+
+static const uint8_t CTRCipher256[64] =
+{
+    0x60, 0x1e, 0xc3, 0x13, 0x77, 0x57, 0x89, 0xa5,
+    0xb7, 0xa7, 0xf5, 0x04, 0xbb, 0xf3, 0xd2, 0x28,
+    0xf4, 0x43, 0xe3, 0xca, 0x4d, 0x62, 0xb5, 0x9a,
+    0xca, 0x84, 0xe9, 0x90, 0xca, 0xca, 0xf5, 0xc5,
+    0x2b, 0x09, 0x30, 0xda, 0xa2, 0x3d, 0xe9, 0x4c,
+    0xe8, 0x70, 0x17, 0xba, 0x2d, 0x84, 0x98, 0x8d,
+    0xdf, 0xc9, 0xc5, 0x8d, 0xb6, 0x7a, 0xad, 0xa6,
+    0x13, 0xc2, 0xdd, 0x08, 0x45, 0x79, 0x41, 0xa6
+};
+
+/* SP 800-38B D.1 and D.3, 64 bytes message */
+static const uint8_t CMAC128[16] =
+{
+    0x51, 0xf0, 0xbe, 0xbf, 0x7e, 0x3b, 0x9d, 0x92,
+    0xfc, 0x49, 0x74, 0x17, 0x79, 0x36, 0x3c, 0xfe
+};
+
+static const uint8_t CMAC256[16] =
+{
+    0xe1, 0x99, 0x21, 0x90, 0x54, 0x9f, 0x6e, 0xd5,
+    0x69, 0x6a, 0x2c, 0x05, 0x6c, 0x31, 0x54, 0x10
+};
+
+/* SP 800-38C C.3 */
+static const uint8_t CCMKey[16] =
+{
+    0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47,
+    0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f
+};
+
+static const uint8_t CCMNonce[12] =
+{
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1a, 0x1b
+};
+
+static const uint8_t CCMAData[20] =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13
+};
+
+static const uint8_t CCMPlain[24] =
+{
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27,
+    0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37
+};
+
+static const uint8_t CCMCipher[24] =
+{
+    0xe3, 0xb2, 0x01, 0xa9, 0xf5, 0xb7, 0x1a, 0x7a,
+    0x9b, 0x1c, 0xea, 0xec, 0xcd, 0x97, 0xe7, 0x0b,
+    0x61, 0x76, 0xaa, 0xd9, 0xa4, 0x42, 0x8a, 0xa5
+};
+
+static const uint8_t CCMTag[8] =
+{
+    0x48, 0x43, 0x92, 0xfb, 0xc1, 0xb0, 0x99, 0x51
+};
+
+static const KeyVectors_TypeDef KeyVectors[2] =
+{
+    {Key128, AES_KEYSIZE_128B, CBCCipher128, CTRCipher128, CMAC128},
+    {Key256, AES_KEYSIZE_256B, CBCCipher256, CTRCipher256, CMAC256}
+};
+
+static AES_ModelTypeDef Model;
+
+static const Engine_TypeDef Engines[ENGINE_COUNT] =
+{
+    {"CPU",   NULL,               NULL,                NULL},
+    {"DMA",   AES_DMA_IN_CHANNEL, AES_DMA_OUT_CHANNEL, NULL},
+    {"Model", NULL,               NULL,                &Model}
+};
+
+static AES_ContextTypeDef AES_Context;
+static uint32_t Buffer[VECTOR_SIZE / 4];
+static uint32_t BenchBuffer[BENCH_SIZE / 4];
+
+/* Private function prototypes -----------------------------------------------*/
+static void AES_ContextSelect(const Engine_TypeDef* Engine);
+static uint32_t AES_CheckVectors(void);
+static void AES_Benchmark(void);
+static void SysTick_Start(void);
+static uint32_t SysTick_Elapsed(uint32_t Start);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Main program.
+  * @param  None
+  * @retval None
+  */
+int main(void)
+{
+    USART_InitTypeDef USART_InitStructure;
+    uint32_t errors = 0;
+    uint32_t engine;
+
+    /*!< At this stage the microcontroller clock setting is already configured,
+         this is done through SystemInit() function which is called from startup
+         file (KEIL_Startup_hk32l0xx.s) before to branch to application main.
+         To reconfigure the default setting of SystemInit() function, refer to
+         system_hk32l0xx.c file
+       */
+
+    HK_EVAL_LEDInit(LED1);
+    HK_EVAL_LEDInit(LED2);
+
+    /* USARTx configured as follow:
+          - BaudRate = 115200 baud
+          - Word Length = 8 Bits
+          - One Stop Bit
+          - No parity
+          - Hardware flow control disabled (RTS and CTS signals)
+          - Receive and transmit enabled
+    */
+    USART_InitStructure.USART_BaudRate = 115200;
+    USART_InitStructure.USART_WordLength = USART_WordLength_8b;
+    USART_InitStructure.USART_StopBits = USART_StopBits_1;
+    USART_InitStructure.USART_Parity = USART_Parity_No;
+    USART_InitStructure.USART_HardwareFlowControl = USART_HardwareFlowControl_None;
+    USART_InitStructure.USART_Mode = USART_Mode_Rx | USART_Mode_Tx;
+    HK_EVAL_COMInit(COM1, &USART_InitStructure);
+
+    /* AES clock, DMA channels remapped to the AES requests */
+    AES_DeInit();
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRYPT, ENABLE);
+    RCC_AHBPeriphClockCmd(AES_DMA_CLK, ENABLE);
+    DMA_RemapConfig(DMA, AES_DMA_IN_REMAP);
+    DMA_RemapConfig(DMA, AES_DMA_OUT_REMAP);
+
+    printf("\r\n  ******************** AES Chaining Modes Example ********************\r\n");
+
+    for (engine = 0; engine < ENGINE_COUNT; engine++)
+    {
+        AES_ContextSelect(&Engines[engine]);
+        errors += AES_CheckVectors();
+    }
+
+    AES_Benchmark();
+
+    /* LED1 on: all results match, LED2 on: at least one does not */
+    if (errors == 0)
+    {
+        HK_EVAL_LEDOn(LED1);
+    }
+    else
+    {
+        HK_EVAL_LEDOn(LED2);
+    }
+
+    /* Infinite loop */
+    while (1)
+    {
+    }
+}
+
+/**
+  * @brief  Sets the way the blocks of AES_Context are computed.
+  * @param  Engine: CPU, DMA or software model
+  * @retval None
+  */
+static void AES_ContextSelect(const Engine_TypeDef* Engine)
+{
+    AES_Context.DMAIn_Channelx = Engine->DMAIn_Channelx;
+    AES_Context.DMAOut_Channelx = Engine->DMAOut_Channelx;
+    AES_Context.Model = Engine->Model;
+}
+
+/**
+  * @brief  Checks CBC, CTR and CMAC with 128 and 256 bits keys and CCM against
+  *         the NIST examples, with the engine selected in AES_Context.
+  * @param  None
+  * @retval Number of results that differ from the examples
+  */
+static uint32_t AES_CheckVectors(void)
+{
+    uint8_t* pbuffer = (uint8_t*)Buffer;
+    uint8_t iv[AES_BLOCK_SIZE];
+    uint8_t tag[AES_BLOCK_SIZE];
+    uint32_t errors = 0;
+    uint32_t i;
+
+    for (i = 0; i < 2; i++)
+    {
+        AES_ModeInit(&AES_Context, KeyVectors[i].Key, KeyVectors[i].KeySize);
+
+        /* CBC, in place */
+        memcpy(pbuffer, Plain, VECTOR_SIZE);
+        memcpy(iv, CBCIV, AES_BLOCK_SIZE);
+
+        if ((AES_CBCEncrypt(&AES_Context, iv, pbuffer, VECTOR_SIZE, pbuffer) != SUCCESS)
+                || (memcmp(pbuffer, KeyVectors[i].CBCCipher, VECTOR_SIZE) != 0))
+        {
+            errors++;
+        }
+
+        memcpy(iv, CBCIV, AES_BLOCK_SIZE);
+
+        if ((AES_CBCDecrypt(&AES_Context, iv, pbuffer, VECTOR_SIZE, pbuffer) != SUCCESS)
+                || (memcmp(pbuffer, Plain, VECTOR_SIZE) != 0))
+        {
+            errors++;
+        }
+
+        /* CTR */
+        memcpy(iv, CTRCounter, AES_BLOCK_SIZE);
+
+        if ((AES_CTRCrypt(&AES_Context, iv, Plain, VECTOR_SIZE, pbuffer) != SUCCESS)
+                || (memcmp(pbuffer, KeyVectors[i].CTRCipher, VECTOR_SIZE) != 0))
+        {
+            errors++;
+        }
+
+        /* CMAC */
+        if ((AES_CMACCompute(&AES_Context, Plain, VECTOR_SIZE, tag) != SUCCESS)
+                || (memcmp(tag, KeyVectors[i].CMAC, AES_BLOCK_SIZE) != 0))
+        {
+            errors++;
+        }
+    }
+
+    /* CCM, then a forged tag must be rejected */
+    AES_ModeInit(&AES_Context, CCMKey, AES_KEYSIZE_128B);
+
+    if ((AES_CCMEncrypt(&AES_Context, CCMNonce, sizeof(CCMNonce), CCMAData, sizeof(CCMAData),
+                        CCMPlain, sizeof(CCMPlain), pbuffer, tag, sizeof(CCMTag)) != SUCCESS)
+            || (memcmp(pbuffer, CCMCipher, sizeof(CCMCipher)) != 0)
+            || (memcmp(tag, CCMTag, sizeof(CCMTag)) != 0))
+    {
+        errors++;
+    }
+
+    if ((AES_CCMDecrypt(&AES_Context, CCMNonce, sizeof(CCMNonce), CCMAData, sizeof(CCMAData),
+                        CCMCipher, sizeof(CCMCipher), pbuffer, CCMTag, sizeof(CCMTag)) != SUCCESS)
+            || (memcmp(pbuffer, CCMPlain, sizeof(CCMPlain)) != 0))
+    {
+        errors++;
+    }
+
+    tag[0] ^= 0x01;
+
+    if (AES_CCMDecrypt(&AES_Context, CCMNonce, sizeof(CCMNonce), CCMAData, sizeof(CCMAData),
+                       CCMCipher, sizeof(CCMCipher), pbuffer, tag, sizeof(CCMTag)) != ERROR)
+    {
+        errors++;
+    }
+
+    printf("\r\n [%s] CBC, CTR, CMAC (128 and 256 bits keys) and CCM: %d errors\r\n",
+           (AES_Context.Model != NULL) ? "Model" : ((AES_Context.DMAIn_Channelx != NULL) ? "DMA" : "CPU"),
+           errors);
+
+    return errors;
+}
+
+/**
+  * @brief  Measures CTR, CBC decryption and CMAC of BENCH_SIZE bytes with a
+  *         128 bits key, with each engine.
+  * @note   The cycles are counted by SysTick, clocked by HCLK.
+  * @param  None
+  * @retval None
+  */
+static void AES_Benchmark(void)
+{
+    uint8_t iv[AES_BLOCK_SIZE] = {0};
+    uint8_t mac[AES_BLOCK_SIZE];
+    uint32_t ctr_cycles, cbc_cycles, cmac_cycles;
+    uint32_t engine;
+    uint32_t start;
+
+    for (engine = 0; engine < ENGINE_COUNT; engine++)
+    {
+        AES_ContextSelect(&Engines[engine]);
+        AES_ModeInit(&AES_Context, Key128, AES_KEYSIZE_128B);
+
+        SysTick_Start();
+
+        start = SysTick->VAL;
+        AES_CTRCrypt(&AES_Context, iv, (const uint8_t*)BenchBuffer, BENCH_SIZE, (uint8_t*)BenchBuffer);
+        ctr_cycles = SysTick_Elapsed(start);
+
+        start = SysTick->VAL;
+        AES_CBCDecrypt(&AES_Context, iv, (const uint8_t*)BenchBuffer, BENCH_SIZE, (uint8_t*)BenchBuffer);
+        cbc_cycles = SysTick_Elapsed(start);
+
+        start = SysTick->VAL;
+        AES_CMACCompute(&AES_Context, (const uint8_t*)BenchBuffer, BENCH_SIZE, mac);
+        cmac_cycles = SysTick_Elapsed(start);
+
+        SysTick->CTRL = 0;
+
+        printf("\r\n [Benchmark %s] %d bytes: CTR %d, CBC decryption %d, CMAC %d cycles\r\n",
+               Engines[engine].Name, BENCH_SIZE, ctr_cycles, cbc_cycles, cmac_cycles);
+    }
+}
+
+/**
+  * @brief  Starts SysTick as a free running down counter clocked by HCLK.
+  * @param  None
+  * @retval None
+  */
+static void SysTick_Start(void)
+{
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+}
+
+/**
+  * @brief  Returns the cycles elapsed since a SysTick value.
+  * @param  Start: SysTick->VAL read at the start
+  * @retval Number of cycles, less than 2^24
+  */
+static uint32_t SysTick_Elapsed(uint32_t Start)
+{
+    return (Start - SysTick->VAL) & SysTick_LOAD_RELOAD_Msk;
+}
+
+#ifdef  USE_FULL_ASSERT
+
+/**
+  * @brief  Reports the name of the source file and the source line number
+  *         where the assert_param error has occurred.
+  * @param  file: pointer to the source file name
+  * @param  line: assert_param error line source number
+  * @retval None
+  */
+void assert_failed(uint8_t* file, uint32_t line)
+{
+    /* User can add his own implementation to report the file name and line number,
+       ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
+
+    /* Infinite loop */
+    while (1)
+    {
+    }
+}
+#endif
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,93 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  aes_record.h
+* @brief:     Header for aes_record.c file.
+* @author:    AE Team
+*******************************************************************************/
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __AES_RECORD_H
+#define __AES_RECORD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "hk32l0xx.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* Largest payload of a record, a longer write is split in several records */
+#ifndef RECORD_PAYLOAD_MAX
+#define RECORD_PAYLOAD_MAX          256
+#endif
+
+#define RECORD_HEADER_SIZE          8       /* SOF, type, length (2), sequence (4) */
+#define RECORD_TAG_SIZE             8       /* CCM tag appended to the payload */
+#define RECORD_SALT_SIZE            8       /* TRNG nonce prefix of a sender */
+#define RECORD_SIZE_MAX             (RECORD_HEADER_SIZE + RECORD_PAYLOAD_MAX + RECORD_TAG_SIZE)
+
+/* Exported types ------------------------------------------------------------*/
+/**
+  * @brief  Link access of a record layer.
+  * @note   Transmit starts sending Length bytes and returns, the buffer is not
+  *         written again until TxBusy returns 0. Deliver is called from
+  *         Record_Receive() with the plain text of each authenticated record.
+  */
+typedef struct
+{
+    void (*Transmit)(const uint8_t* pData, uint32_t Length);    /*!< Starts a transmission */
+    uint8_t (*TxBusy)(void);                                    /*!< Nonzero while transmitting */
+    void (*Random)(uint8_t* pData, uint32_t Length);            /*!< Fills a buffer from the TRNG */
+    void (*Deliver)(const uint8_t* pData, uint32_t Length);     /*!< Receives a decrypted payload */
+} Record_PortTypeDef;
+
+/**
+  * @brief  Record layer of one end of the link: two transmit buffers, one on
+  *         the wire while the other is sealed, and one receive record.
+  */
+typedef struct
+{
+    const Record_PortTypeDef* pPort;            /*!< Link access */
+    AES_ContextTypeDef* pAes;                   /*!< AES context, keyed with the shared key */
+    uint8_t Salt[RECORD_SALT_SIZE];             /*!< Nonce prefix of the records sent */
+    uint8_t PeerSalt[RECORD_SALT_SIZE];         /*!< Nonce prefix of the records received */
+    uint8_t PeerOffer[RECORD_SALT_SIZE];        /*!< Salt of the last HELLO received, echoed in the HELLO records sent */
+    uint8_t PeerKnown;                          /*!< PeerSalt adopted from a HELLO record echoing Salt */
+    uint8_t HelloPending;                       /*!< HELLO record to send */
+    uint32_t TxSequence;                        /*!< Sequence number of the last record sent */
+    uint32_t RxSequence;                        /*!< Sequence number of the last record accepted from PeerSalt */
+    uint8_t TxBuffer[2][RECORD_SIZE_MAX];       /*!< Sealed records */
+    uint16_t TxLength[2];                       /*!< Bytes of each sealed record */
+    uint8_t TxFill;                             /*!< Next buffer to seal */
+    uint8_t TxSend;                             /*!< Next buffer to transmit */
+    uint8_t TxPending;                          /*!< Sealed buffers not yet sent, 0 to 2 */
+    uint8_t TxOnWire;                           /*!< Buffer TxSend is being transmitted */
+    uint8_t RxRecord[RECORD_SIZE_MAX];          /*!< Record being received */
+    uint8_t RxPayload[RECORD_PAYLOAD_MAX];      /*!< Plain text of the record opened */
+    uint32_t RxIndex;                           /*!< Bytes of RxRecord received */
+    uint32_t RxNeeded;                          /*!< Bytes of RxRecord expected */
+    uint32_t TxRecords;                         /*!< Records sent */
+    uint32_t RxRecords;                         /*!< Records accepted */
+    uint32_t RxAuthErrors;                      /*!< Records with a wrong tag */
+    uint32_t RxReplays;                         /*!< Records with an old sequence number */
+    uint32_t RxDiscarded;                       /*!< Bytes dropped while searching a header */
+} Record_LinkTypeDef;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void Record_Init(Record_LinkTypeDef* Link, const Record_PortTypeDef* pPort, AES_ContextTypeDef* pAes);
+void Record_Hello(Record_LinkTypeDef* Link);
+uint8_t Record_IsReady(Record_LinkTypeDef* Link);
+uint32_t Record_Write(Record_LinkTypeDef* Link, const uint8_t* pData, uint32_t Length);
+void Record_Poll(Record_LinkTypeDef* Link);
+void Record_Receive(Record_LinkTypeDef* Link, const uint8_t* pData, uint32_t Length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*__AES_RECORD_H */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
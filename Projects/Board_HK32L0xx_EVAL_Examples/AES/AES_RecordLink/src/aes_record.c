@@ -0,0 +1,497 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  aes_record.c
+* @brief:     Authenticated encryption record layer over a byte stream link.
+*             ===================================================================
+*             A write is split in records of at most RECORD_PAYLOAD_MAX bytes:
+*               byte 0:     RECORD_SOF
+*               byte 1:     type, RECORD_TYPE_DATA or RECORD_TYPE_HELLO
+*               byte 2..3:  payload length, little endian
+*               byte 4..7:  sequence number, little endian
+*               payload:    AES-CCM cipher text (HELLO: plain text)
+*               tag:        RECORD_TAG_SIZE bytes of AES-CCM tag
+*             The CCM nonce is the sender salt, the sequence number (big
+*             endian) and the type. The salt is drawn from the TRNG at
+*             initialization and the sequence number is incremented for each
+*             record, so a nonce is never used twice with the shared key.
+*             Bytes 1 to 7 of the header are authenticated with the payload,
+*             followed by the salt of the receiver for a DATA record and by
+*             the HELLO payload for a HELLO record.
+*             A HELLO record carries the salt of its sender and the last salt
+*             received in a HELLO record of the peer, its challenge. The salt
+*             of the peer is only adopted from a HELLO record that echoes the
+*             local salt, so a HELLO record replayed from an older session
+*             is answered but never adopted. A HELLO record is sent at
+*             initialization, in reply to a HELLO record that does not echo
+*             the local salt and once the salt of the peer is adopted.
+*             A receiver session lasts as long as the local salt: once a peer
+*             salt is adopted, a HELLO record of another peer salt draws a new
+*             local salt before the exchange starts again.
+*             A record is accepted only if its sequence number is higher than
+*             the one of the last record accepted in the receiver session,
+*             which is never lowered, and a DATA record bound to an older
+*             local salt fails its tag, so a record replayed from this or a
+*             previous session is dropped.
+*             Two transmit buffers are used: a record is sealed in one while
+*             the other one is on the wire.
+*             ===================================================================
+* @author:    AE Team
+* @version:   V1.0.0/2024-12-23
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "aes_record.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define RECORD_SOF                  ((uint8_t)0xA5)
+#define RECORD_TYPE_DATA            ((uint8_t)0x01)
+#define RECORD_TYPE_HELLO           ((uint8_t)0x02)
+
+#define RECORD_HELLO_SIZE           (2 * RECORD_SALT_SIZE)    /* Own salt, echoed peer salt */
+#define RECORD_NONCE_SIZE           (RECORD_SALT_SIZE + 5)    /* Salt, sequence, type */
+#define RECORD_ADATA_SIZE           (RECORD_HEADER_SIZE - 1 + RECORD_HELLO_SIZE)
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void Record_NewSalt(Record_LinkTypeDef* Link);
+static void Record_Nonce(uint8_t* pNonce, const uint8_t* pSalt, const uint8_t* pHeader);
+static uint32_t Record_Seal(Record_LinkTypeDef* Link, uint8_t Type, const uint8_t* pData, uint32_t Length);
+static void Record_Open(Record_LinkTypeDef* Link);
+static void Record_HelloReceived(Record_LinkTypeDef* Link, const uint8_t* pHello, uint32_t Sequence,
+                                 uint8_t Current);
+static void Record_Shift(Record_LinkTypeDef* Link, uint32_t Count);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Initializes a record layer and queues its first HELLO record.
+  * @param  Link: record layer to initialize.
+  * @param  pPort: link access, kept by the record layer.
+  * @param  pAes: AES context keyed with the key shared by both ends.
+  * @retval None
+  */
+void Record_Init(Record_LinkTypeDef* Link, const Record_PortTypeDef* pPort, AES_ContextTypeDef* pAes)
+{
+    memset(Link, 0, sizeof(Record_LinkTypeDef));
+    Link->pPort = pPort;
+    Link->pAes = pAes;
+    Link->RxNeeded = RECORD_HEADER_SIZE;
+
+    Record_NewSalt(Link);
+}
+
+/**
+  * @brief  Queues a HELLO record, to be called again while Record_IsReady()
+  *         returns 0 in case the peer was not listening.
+  * @param  Link: record layer.
+  * @retval None
+  */
+void Record_Hello(Record_LinkTypeDef* Link)
+{
+    Link->HelloPending = 1;
+    Record_Poll(Link);
+}
+
+/**
+  * @brief  Tells whether DATA records can be sent.
+  * @param  Link: record layer.
+  * @retval 1 once the salt of the peer is known, 0 otherwise.
+  */
+uint8_t Record_IsReady(Record_LinkTypeDef* Link)
+{
+    return Link->PeerKnown;
+}
+
+/**
+  * @brief  Seals bytes in DATA records while a transmit buffer is free.
+  * @note   A record is sealed while the previous one is on the wire, the call
+  *         returns once both buffers are in use.
+  * @param  Link: record layer.
+  * @param  pData: bytes to send.
+  * @param  Length: number of bytes.
+  * @retval Number of bytes sealed, the caller writes the others again later.
+  */
+uint32_t Record_Write(Record_LinkTypeDef* Link, const uint8_t* pData, uint32_t Length)
+{
+    uint32_t written = 0;
+    uint32_t size;
+
+    Record_Poll(Link);
+
+    while ((Link->PeerKnown != 0) && (Link->TxPending < 2) && (written < Length))
+    {
+        size = Length - written;
+
+        if (size > RECORD_PAYLOAD_MAX)
+        {
+            size = RECORD_PAYLOAD_MAX;
+        }
+
+        if (Record_Seal(Link, RECORD_TYPE_DATA, &pData[written], size) == 0)
+        {
+            break;
+        }
+
+        written += size;
+        Record_Poll(Link);
+    }
+
+    return written;
+}
+
+/**
+  * @brief  Releases the buffer sent and starts the transmission of the next
+  *         sealed record, to be called from the main loop.
+  * @param  Link: record layer.
+  * @retval None
+  */
+void Record_Poll(Record_LinkTypeDef* Link)
+{
+    uint8_t hello[RECORD_HELLO_SIZE];
+
+    if ((Link->TxOnWire != 0) && (Link->pPort->TxBusy() == 0))
+    {
+        Link->TxOnWire = 0;
+        Link->TxSend ^= 1;
+        Link->TxPending--;
+        Link->TxRecords++;
+    }
+
+    if ((Link->HelloPending != 0) && (Link->TxPending < 2))
+    {
+        memcpy(hello, Link->Salt, RECORD_SALT_SIZE);
+        memcpy(&hello[RECORD_SALT_SIZE], Link->PeerOffer, RECORD_SALT_SIZE);
+
+        if (Record_Seal(Link, RECORD_TYPE_HELLO, hello, RECORD_HELLO_SIZE) != 0)
+        {
+            Link->HelloPending = 0;
+        }
+    }
+
+    if ((Link->TxOnWire == 0) && (Link->TxPending != 0))
+    {
+        Link->TxOnWire = 1;
+        Link->pPort->Transmit(Link->TxBuffer[Link->TxSend], Link->TxLength[Link->TxSend]);
+    }
+}
+
+/**
+  * @brief  Parses received bytes, decrypts each complete record and delivers
+  *         its payload.
+  * @note   Records can be split across calls. A record is opened while the
+  *         next one is received, a receive DMA must keep running meanwhile.
+  * @param  Link: record layer.
+  * @param  pData: bytes received.
+  * @param  Length: number of bytes.
+  * @retval None
+  */
+void Record_Receive(Record_LinkTypeDef* Link, const uint8_t* pData, uint32_t Length)
+{
+    uint32_t size;
+    uint32_t payload;
+
+    for (;;)
+    {
+        if (Link->RxIndex < Link->RxNeeded)
+        {
+            if (Length == 0)
+            {
+                break;
+            }
+
+            /* Search the start of a record */
+            if ((Link->RxIndex == 0) && (*pData != RECORD_SOF))
+            {
+                Link->RxDiscarded++;
+                pData++;
+                Length--;
+                continue;
+            }
+
+            size = Link->RxNeeded - Link->RxIndex;
+
+            if (size > Length)
+            {
+                size = Length;
+            }
+
+            memcpy(&Link->RxRecord[Link->RxIndex], pData, size);
+            Link->RxIndex += size;
+            pData += size;
+            Length -= size;
+        }
+        else if (Link->RxNeeded == RECORD_HEADER_SIZE)
+        {
+            payload = Link->RxRecord[2] | ((uint32_t)Link->RxRecord[3] << 8);
+
+            if (((Link->RxRecord[1] == RECORD_TYPE_DATA) && (payload <= RECORD_PAYLOAD_MAX)) ||
+                ((Link->RxRecord[1] == RECORD_TYPE_HELLO) && (payload == RECORD_HELLO_SIZE)))
+            {
+                Link->RxNeeded = RECORD_HEADER_SIZE + payload + RECORD_TAG_SIZE;
+            }
+            else
+            {
+                Link->RxDiscarded++;
+                Record_Shift(Link, 1);
+            }
+        }
+        else
+        {
+            Record_Open(Link);
+        }
+    }
+}
+
+/**
+  * @brief  Draws a new salt and restarts the sequence numbers: a new receiver
+  *         session starts, the salt of the peer is exchanged again.
+  * @param  Link: record layer.
+  * @retval None
+  */
+static void Record_NewSalt(Record_LinkTypeDef* Link)
+{
+    Link->pPort->Random(Link->Salt, RECORD_SALT_SIZE);
+    Link->TxSequence = 0;
+    Link->PeerKnown = 0;
+    Link->HelloPending = 1;
+}
+
+/**
+  * @brief  Builds the CCM nonce of a record.
+  * @param  pNonce: RECORD_NONCE_SIZE bytes.
+  * @param  pSalt: salt of the sender.
+  * @param  pHeader: record header.
+  * @retval None
+  */
+static void Record_Nonce(uint8_t* pNonce, const uint8_t* pSalt, const uint8_t* pHeader)
+{
+    memcpy(pNonce, pSalt, RECORD_SALT_SIZE);
+    pNonce[RECORD_SALT_SIZE] = pHeader[7];
+    pNonce[RECORD_SALT_SIZE + 1] = pHeader[6];
+    pNonce[RECORD_SALT_SIZE + 2] = pHeader[5];
+    pNonce[RECORD_SALT_SIZE + 3] = pHeader[4];
+    pNonce[RECORD_SALT_SIZE + 4] = pHeader[1];
+}
+
+/**
+  * @brief  Seals a record in the free transmit buffer.
+  * @param  Link: record layer, with a free transmit buffer.
+  * @param  Type: RECORD_TYPE_DATA or RECORD_TYPE_HELLO.
+  * @param  pData: payload.
+  * @param  Length: payload length, at most RECORD_PAYLOAD_MAX.
+  * @retval Record length, 0 if the AES failed.
+  */
+static uint32_t Record_Seal(Record_LinkTypeDef* Link, uint8_t Type, const uint8_t* pData, uint32_t Length)
+{
+    uint8_t* record = Link->TxBuffer[Link->TxFill];
+    uint8_t nonce[RECORD_NONCE_SIZE];
+    uint8_t adata[RECORD_ADATA_SIZE];
+    uint32_t adatasize;
+    uint32_t sequence;
+    ErrorStatus status;
+
+    /* The sequence numbers are exhausted, restart them with a new salt. The
+       HELLO record announcing it is sealed first. */
+    if (Link->TxSequence == 0xFFFFFFFF)
+    {
+        Record_NewSalt(Link);
+        return 0;
+    }
+
+    sequence = ++Link->TxSequence;
+
+    record[0] = RECORD_SOF;
+    record[1] = Type;
+    record[2] = (uint8_t)Length;
+    record[3] = (uint8_t)(Length >> 8);
+    record[4] = (uint8_t)sequence;
+    record[5] = (uint8_t)(sequence >> 8);
+    record[6] = (uint8_t)(sequence >> 16);
+    record[7] = (uint8_t)(sequence >> 24);
+
+    Record_Nonce(nonce, Link->Salt, record);
+    memcpy(adata, &record[1], RECORD_HEADER_SIZE - 1);
+
+    if (Type == RECORD_TYPE_HELLO)
+    {
+        /* The payload is authenticated but sent in plain text */
+        memcpy(&adata[RECORD_HEADER_SIZE - 1], pData, Length);
+        memcpy(&record[RECORD_HEADER_SIZE], pData, Length);
+        adatasize = RECORD_HEADER_SIZE - 1 + Length;
+        status = AES_CCMEncrypt(Link->pAes, nonce, RECORD_NONCE_SIZE, adata, adatasize,
+                                pData, 0, &record[RECORD_HEADER_SIZE],
+                                &record[RECORD_HEADER_SIZE + Length], RECORD_TAG_SIZE);
+    }
+    else
+    {
+        /* Bound to the current salt of the receiver */
+        memcpy(&adata[RECORD_HEADER_SIZE - 1], Link->PeerSalt, RECORD_SALT_SIZE);
+        adatasize = RECORD_HEADER_SIZE - 1 + RECORD_SALT_SIZE;
+        status = AES_CCMEncrypt(Link->pAes, nonce, RECORD_NONCE_SIZE, adata, adatasize,
+                                pData, Length, &record[RECORD_HEADER_SIZE],
+                                &record[RECORD_HEADER_SIZE + Length], RECORD_TAG_SIZE);
+    }
+
+    if (status != SUCCESS)
+    {
+        return 0;
+    }
+
+    Link->TxLength[Link->TxFill] = (uint16_t)(RECORD_HEADER_SIZE + Length + RECORD_TAG_SIZE);
+    Link->TxFill ^= 1;
+    Link->TxPending++;
+
+    return RECORD_HEADER_SIZE + Length + RECORD_TAG_SIZE;
+}
+
+/**
+  * @brief  Verifies the complete record in RxRecord and delivers its payload.
+  * @note   The record is authenticated before its sequence number is checked:
+  *         bytes that only look like a header are searched for the next SOF,
+  *         a genuine old record is skipped whole.
+  * @param  Link: record layer.
+  * @retval None
+  */
+static void Record_Open(Record_LinkTypeDef* Link)
+{
+    uint8_t* record = Link->RxRecord;
+    uint8_t* payload = &record[RECORD_HEADER_SIZE];
+    uint32_t length = record[2] | ((uint32_t)record[3] << 8);
+    uint32_t sequence = record[4] | ((uint32_t)record[5] << 8) | ((uint32_t)record[6] << 16) |
+                        ((uint32_t)record[7] << 24);
+    uint8_t nonce[RECORD_NONCE_SIZE];
+    uint8_t adata[RECORD_ADATA_SIZE];
+    uint8_t current;
+    ErrorStatus status = ERROR;
+
+    memcpy(adata, &record[1], RECORD_HEADER_SIZE - 1);
+
+    if (record[1] == RECORD_TYPE_HELLO)
+    {
+        /* The nonce uses the salt carried by the record */
+        Record_Nonce(nonce, payload, record);
+        memcpy(&adata[RECORD_HEADER_SIZE - 1], payload, length);
+        status = AES_CCMDecrypt(Link->pAes, nonce, RECORD_NONCE_SIZE, adata, RECORD_HEADER_SIZE - 1 + length,
+                                payload, 0, Link->RxPayload, &payload[length], RECORD_TAG_SIZE);
+    }
+    else if (Link->PeerKnown != 0)
+    {
+        /* Decrypted aside: the received bytes are kept if the tag is wrong */
+        Record_Nonce(nonce, Link->PeerSalt, record);
+        memcpy(&adata[RECORD_HEADER_SIZE - 1], Link->Salt, RECORD_SALT_SIZE);
+        status = AES_CCMDecrypt(Link->pAes, nonce, RECORD_NONCE_SIZE, adata, RECORD_HEADER_SIZE - 1 + RECORD_SALT_SIZE,
+                                payload, length, Link->RxPayload, &payload[length], RECORD_TAG_SIZE);
+    }
+
+    if (status != SUCCESS)
+    {
+        /* Without a peer salt a DATA record cannot be verified */
+        if ((record[1] == RECORD_TYPE_HELLO) || (Link->PeerKnown != 0))
+        {
+            Link->RxAuthErrors++;
+        }
+        Link->RxDiscarded++;
+        Record_Shift(Link, 1);
+        return;
+    }
+
+    /* Record of the peer salt of the receiver session */
+    current = (uint8_t)((Link->PeerKnown != 0) &&
+                        ((record[1] == RECORD_TYPE_DATA) ||
+                         (memcmp(Link->PeerSalt, payload, RECORD_SALT_SIZE) == 0)));
+
+    if ((current != 0) && (sequence <= Link->RxSequence))
+    {
+        Link->RxReplays++;
+        Record_Shift(Link, Link->RxNeeded);
+        return;
+    }
+
+    Link->RxRecords++;
+
+    if (record[1] == RECORD_TYPE_HELLO)
+    {
+        Record_HelloReceived(Link, payload, sequence, current);
+    }
+    else
+    {
+        Link->RxSequence = sequence;
+        Link->pPort->Deliver(Link->RxPayload, length);
+    }
+
+    Record_Shift(Link, Link->RxNeeded);
+}
+
+/**
+  * @brief  Runs the salt exchange on an authenticated HELLO record.
+  * @param  Link: record layer.
+  * @param  pHello: HELLO payload, salt of the sender then echoed salt.
+  * @param  Sequence: sequence number of the record.
+  * @param  Current: 1 if the record comes from the peer salt of the receiver
+  *         session, its sequence number is then higher than RxSequence.
+  * @retval None
+  */
+static void Record_HelloReceived(Record_LinkTypeDef* Link, const uint8_t* pHello, uint32_t Sequence,
+                                 uint8_t Current)
+{
+    if (Current != 0)
+    {
+        Link->RxSequence = Sequence;
+    }
+
+    if (memcmp(&pHello[RECORD_SALT_SIZE], Link->Salt, RECORD_SALT_SIZE) != 0)
+    {
+        /* Challenge the sender with its salt, it is adopted once echoed */
+        memcpy(Link->PeerOffer, pHello, RECORD_SALT_SIZE);
+        Link->HelloPending = 1;
+    }
+    else if (Current == 0)
+    {
+        memcpy(Link->PeerOffer, pHello, RECORD_SALT_SIZE);
+
+        if (Link->PeerKnown != 0)
+        {
+            /* Another peer salt: its sequence numbers restart in a new
+               receiver session, the older records are bound to this salt */
+            Record_NewSalt(Link);
+        }
+        else
+        {
+            /* The sender is live, it answered the local salt */
+            memcpy(Link->PeerSalt, pHello, RECORD_SALT_SIZE);
+            Link->PeerKnown = 1;
+            Link->RxSequence = Sequence;
+            Link->HelloPending = 1;
+        }
+    }
+}
+
+/**
+  * @brief  Removes bytes from the head of RxRecord, then the bytes before the
+  *         next SOF, and restarts the parsing with the bytes left.
+  * @note   RxRecord holds the bytes as received, a record rejected from its
+  *         header or tag may hide the SOF of the next one in any byte.
+  * @param  Link: record layer.
+  * @param  Count: bytes to remove, at most RxIndex.
+  * @retval None
+  */
+static void Record_Shift(Record_LinkTypeDef* Link, uint32_t Count)
+{
+    uint32_t i = Count;
+
+    while ((i < Link->RxIndex) && (Link->RxRecord[i] != RECORD_SOF))
+    {
+        i++;
+    }
+
+    Link->RxDiscarded += i - Count;
+    Link->RxIndex -= i;
+    memmove(Link->RxRecord, &Link->RxRecord[i], Link->RxIndex);
+    Link->RxNeeded = RECORD_HEADER_SIZE;
+}
@@ -0,0 +1,108 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  hk32l0xx_it.c
+* @brief:     Interrupt Service Routines
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-04
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "hk32l0xx_it.h"
+#include "hk32l0xx_eval.h"
+#include "main.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/*  A plate processing flow  */
+#ifdef AES_TWO_BOARD_A
+    extern __IO uint8_t ubButtonPress;
+#endif
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/******************************************************************************/
+/*            Cortex-M0 Processor Exceptions Handlers                         */
+/******************************************************************************/
+
+/**
+  * @brief  This function handles NMI exception.
+  * @retval None
+  */
+void NMI_Handler(void)
+{
+}
+
+/**
+  * @brief  This function handles Hard Fault exception.
+  * @retval None
+  */
+void HardFault_Handler(void)
+{
+    /* Go to infinite loop when Hard Fault exception occurs */
+    while (1)
+    {
+    }
+}
+
+/**
+  * @brief  This function handles SVCall exception.
+  * @retval None
+  */
+void SVC_Handler(void)
+{
+}
+
+/**
+  * @brief  This function handles PendSVC exception.
+  * @retval None
+  */
+void PendSV_Handler(void)
+{
+}
+
+/**
+  * @brief  This function handles SysTick Handler.
+  * @retval None
+  */
+void SysTick_Handler(void)
+{
+    TickCount++;
+}
+
+/******************************************************************************/
+/*                 HK32L0xx Peripherals Interrupt Handlers                   */
+/*  Add here the Interrupt Handler for the used peripheral(s) (PPP), for the  */
+/*  available peripheral interrupt handler's name please refer to the startup */
+/*  file (KEIL_Startup_hk32l0xx.s).                                               */
+/******************************************************************************/
+
+#ifdef AES_TWO_BOARD_A
+/**
+  * @brief  This function handles external lines 2 to 3 interrupt request.
+  * @param  None
+  * @retval None
+  */
+void EXTI2_3_IRQHandler(void)
+{
+    if (EXTI_GetITStatus(EXTI_Line2) != RESET)
+    {
+        ubButtonPress = 1;
+
+        /* Clear the EXTI line 2 pending bit */
+        EXTI_ClearITPendingBit(EXTI_Line2);
+    }
+}
+#endif
+
+/**
+  * @brief  This function handles PPP interrupt request.
+  * @retval None
+  */
+/*void PPP_IRQHandler(void)
+{
+}*/
@@ -0,0 +1,486 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  main.c
+* @brief:     Main program body, streams data from board A to board B in
+*             AES-CCM records over USART2, Can Switch project A and B
+* @author:    AE Team
+* @version:   V1.0.0/2024-12-23
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/** @addtogroup HK32L0xx_StdPeriph_Examples
+  * @{
+  */
+
+/** @addtogroup AES_RecordLink
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define AES_DMA_CLK             RCC_AHBPeriph_DMA
+#define AES_DMA_IN_CHANNEL      DMA_Channel1
+#define AES_DMA_IN_REMAP        DMA_CSELR_CH1_AES_IN
+#define AES_DMA_OUT_CHANNEL     DMA_Channel2
+#define AES_DMA_OUT_REMAP       DMA_CSELR_CH2_AES_OUT
+
+/* Link between the boards: USART2 sent and received by DMA */
+#define LINK_USART              USART2
+#define LINK_BAUDRATE           115200
+#define LINK_TX_DMA_CHANNEL     DMA_Channel4
+#define LINK_TX_DMA_REMAP       DMA_CSELR_CH4_USART2_TX
+#define LINK_RX_DMA_CHANNEL     DMA_Channel5
+#define LINK_RX_DMA_REMAP       DMA_CSELR_CH5_USART2_RX
+#define LINK_RX_BUFFER_SIZE     1024                     /* Bytes received while a record is opened */
+
+#define HELLO_PERIOD            500                      /* ms between two HELLO records */
+#define STREAM_SIZE             16384                    /* Bytes of a stream */
+#define CHUNK_SIZE_MAX          600                      /* Largest write of board A */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void Link_Config(void);
+static void Link_Receive(void);
+static void Link_Transmit(const uint8_t* pData, uint32_t Length);
+static uint8_t Link_TxBusy(void);
+static void Link_Random(uint8_t* pData, uint32_t Length);
+static void Link_Deliver(const uint8_t* pData, uint32_t Length);
+static uint8_t Stream_Byte(uint32_t Offset);
+#ifdef AES_TWO_BOARD_A
+static uint8_t Stream_Send(void);
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+/* Key for encryption and decryption on board A and board B*/
+static const uint8_t BoardAB_EncryptionKey[16] =
+{
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+
+static AES_ContextTypeDef AES_Context =
+{
+    0,
+    {0},
+    AES_DMA_IN_CHANNEL,
+    AES_DMA_OUT_CHANNEL,
+    NULL,
+    0
+};
+
+static const Record_PortTypeDef Link_Port =
+{
+    Link_Transmit,
+    Link_TxBusy,
+    Link_Random,
+    Link_Deliver
+};
+
+static Record_LinkTypeDef Link;
+static DMA_InitTypeDef LinkTxDma;
+static uint8_t LinkRxBuffer[LINK_RX_BUFFER_SIZE];
+static uint32_t LinkRxRead = 0;
+
+/* Stream position and errors of the bytes delivered */
+static uint32_t RxOffset = 0;
+static uint32_t RxErrors = 0;
+
+__IO uint32_t TickCount = 0;
+
+/* A plate processing flow  */
+#ifdef AES_TWO_BOARD_A
+__IO uint8_t ubButtonPress = 0;
+
+static uint8_t Chunk[CHUNK_SIZE_MAX];
+static uint32_t ChunkLength = 0;
+static uint32_t ChunkSent = 0;
+static uint32_t TxOffset = STREAM_SIZE;
+static uint32_t ChunkSeed = 1;
+#endif
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Main program.
+  * @param  None
+  * @retval None
+  */
+int main(void)
+{
+    USART_InitTypeDef USART_InitStructure;
+    uint32_t hello = 0;
+#ifdef AES_TWO_BOARD_A
+    uint32_t start = 0;
+#endif
+
+    /* Before executing the main function, the SystemInit() function has been called in the startup file xxstartup.s to configure the system clock. */
+
+    HK_EVAL_LEDInit(LED1);
+    HK_EVAL_LEDInit(LED2);
+
+    /* USARTx configured as follow:
+          - BaudRate = 115200 baud
+          - Word Length = 8 Bits
+          - One Stop Bit
+          - No parity
+          - Hardware flow control disabled (RTS and CTS signals)
+          - Receive and transmit enabled
+    */
+    USART_InitStructure.USART_BaudRate = 115200;
+    USART_InitStructure.USART_WordLength = USART_WordLength_8b;
+    USART_InitStructure.USART_StopBits = USART_StopBits_1;
+    USART_InitStructure.USART_Parity = USART_Parity_No;
+    USART_InitStructure.USART_HardwareFlowControl = USART_HardwareFlowControl_None;
+    USART_InitStructure.USART_Mode = USART_Mode_Rx | USART_Mode_Tx;
+    HK_EVAL_COMInit(COM1, &USART_InitStructure);
+
+    /* 1 ms time base */
+    if (SysTick_Config(SystemCoreClock / 1000))
+    {
+        /* Capture error */
+        while (1)
+        {
+        }
+    }
+
+    /* TRNG for the record salts */
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_TRNG, ENABLE);
+
+    /* AES clock, DMA channels remapped to the AES requests */
+    AES_DeInit();
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRYPT, ENABLE);
+    RCC_AHBPeriphClockCmd(AES_DMA_CLK, ENABLE);
+    DMA_RemapConfig(DMA, AES_DMA_IN_REMAP);
+    DMA_RemapConfig(DMA, AES_DMA_OUT_REMAP);
+    AES_ModeInit(&AES_Context, BoardAB_EncryptionKey, AES_KEYSIZE_128B);
+
+    /* Serial port 2 configuration for communication between A and B boards */
+    Link_Config();
+    Record_Init(&Link, &Link_Port, &AES_Context);
+
+    printf("AES Record Link, board A streams %d bytes to board B in AES-CCM records.\r\n", STREAM_SIZE);
+
+#ifdef AES_TWO_BOARD_A
+    /* Initialize User push-button in EXTI mode */
+    HK_EVAL_PBInit(BUTTON_KEY1, BUTTON_MODE_EXTI);
+    printf("board A: press KEY1 to send a stream\r\n");
+#else
+    printf("board B: waiting for streams\r\n");
+#endif
+
+    /* Infinite loop */
+    while (1)
+    {
+        Link_Receive();
+        Record_Poll(&Link);
+
+        /* Announce the salt until the peer answers */
+        if ((Record_IsReady(&Link) == 0) && ((TickCount - hello) >= HELLO_PERIOD))
+        {
+            hello = TickCount;
+            Record_Hello(&Link);
+        }
+
+        /* LED1 on once the salts are exchanged, LED2 on before */
+        if (Record_IsReady(&Link) != 0)
+        {
+            HK_EVAL_LEDOn(LED1);
+            HK_EVAL_LEDOff(LED2);
+        }
+        else
+        {
+            HK_EVAL_LEDOn(LED2);
+        }
+
+#ifdef AES_TWO_BOARD_A
+
+        if ((ubButtonPress != 0) && (TxOffset == STREAM_SIZE) && (Record_IsReady(&Link) != 0))
+        {
+            ubButtonPress = 0;
+            TxOffset = 0;
+            start = TickCount;
+        }
+
+        if ((TxOffset < STREAM_SIZE) && (Stream_Send() != 0))
+        {
+            printf("board A: %d bytes sealed and sent in %d ms, %d records\r\n",
+                   STREAM_SIZE, (int)(TickCount - start), (int)Link.TxRecords);
+        }
+
+#else
+
+        if (RxOffset >= STREAM_SIZE)
+        {
+            printf("board B: %d bytes received, %d errors\r\n", (int)RxOffset, (int)RxErrors);
+            printf("board B: records %d, tag errors %d, replays %d, discarded bytes %d\r\n",
+                   (int)Link.RxRecords, (int)Link.RxAuthErrors, (int)Link.RxReplays, (int)Link.RxDiscarded);
+            RxOffset = 0;
+            RxErrors = 0;
+        }
+
+#endif
+    }
+}
+
+/**
+  * @brief  Configures USART2, sent by DMA and received by DMA in circular mode.
+  * @param  None
+  * @retval None
+  */
+static void Link_Config(void)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+    USART_InitTypeDef USART_InitStructure;
+    DMA_InitTypeDef DMA_InitStructure;
+
+    /* Enable GPIOA clock */
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_GPIOA, ENABLE);
+
+    /* Configure GPIO of USART Tx and Rx to push-pull multiplexing mode*/
+    GPIO_InitStructure.GPIO_Pin = GPIO_Pin_2 | GPIO_Pin_3;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;
+    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_UP;
+    GPIO_Init(GPIOA, &GPIO_InitStructure);
+
+    GPIO_PinAFConfig(GPIOA, GPIO_PinSource2, GPIO_AF_4);
+    GPIO_PinAFConfig(GPIOA, GPIO_PinSource3, GPIO_AF_4);
+
+    /* Enable USART2 clock */
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_USART2, ENABLE);
+
+    USART_InitStructure.USART_BaudRate = LINK_BAUDRATE;
+    USART_InitStructure.USART_HardwareFlowControl = USART_HardwareFlowControl_None;
+    USART_InitStructure.USART_Mode = USART_Mode_Rx | USART_Mode_Tx;
+    USART_InitStructure.USART_Parity = USART_Parity_No;
+    USART_InitStructure.USART_StopBits = USART_StopBits_1;
+    USART_InitStructure.USART_WordLength = USART_WordLength_8b;
+    USART_Init(LINK_USART, &USART_InitStructure);
+
+    /* The DMA keeps receiving on overrun, a record with lost bytes fails its
+       tag and the parsing restarts at the next SOF */
+    USART_OverrunDetectionConfig(LINK_USART, USART_OVRDetection_Disable);
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA, ENABLE);
+    DMA_RemapConfig(DMA, LINK_TX_DMA_REMAP);
+    DMA_RemapConfig(DMA, LINK_RX_DMA_REMAP);
+
+    /* Reception in circular mode */
+    DMA_DeInit(LINK_RX_DMA_CHANNEL);
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&LINK_USART->RDR;
+    DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)LinkRxBuffer;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
+    DMA_InitStructure.DMA_BufferSize = LINK_RX_BUFFER_SIZE;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Circular;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_VeryHigh;
+    DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init(LINK_RX_DMA_CHANNEL, &DMA_InitStructure);
+    DMA_Cmd(LINK_RX_DMA_CHANNEL, ENABLE);
+
+    /* Transmission, the memory address and size are set by Link_Transmit() */
+    DMA_DeInit(LINK_TX_DMA_CHANNEL);
+    LinkTxDma = DMA_InitStructure;
+    LinkTxDma.DMA_PeripheralBaseAddr = (uint32_t)&LINK_USART->TDR;
+    LinkTxDma.DMA_DIR = DMA_DIR_PeripheralDST;
+    LinkTxDma.DMA_Mode = DMA_Mode_Normal;
+    LinkTxDma.DMA_Priority = DMA_Priority_Low;
+
+    USART_DMACmd(LINK_USART, USART_DMAReq_Rx | USART_DMAReq_Tx, ENABLE);
+    USART_Cmd(LINK_USART, ENABLE);
+}
+
+/**
+  * @brief  Passes the bytes written by the receive DMA since the last call to
+  *         the record layer.
+  * @param  None
+  * @retval None
+  */
+static void Link_Receive(void)
+{
+    uint32_t write = LINK_RX_BUFFER_SIZE - DMA_GetCurrDataCounter(LINK_RX_DMA_CHANNEL);
+
+    if (write == LINK_RX_BUFFER_SIZE)
+    {
+        write = 0;
+    }
+
+    if (write < LinkRxRead)
+    {
+        Record_Receive(&Link, &LinkRxBuffer[LinkRxRead], LINK_RX_BUFFER_SIZE - LinkRxRead);
+        LinkRxRead = 0;
+    }
+
+    if (write > LinkRxRead)
+    {
+        Record_Receive(&Link, &LinkRxBuffer[LinkRxRead], write - LinkRxRead);
+        LinkRxRead = write;
+    }
+}
+
+/**
+  * @brief  Starts the transmission of a sealed record.
+  * @param  pData: record, kept until Link_TxBusy() returns 0.
+  * @param  Length: number of bytes.
+  * @retval None
+  */
+static void Link_Transmit(const uint8_t* pData, uint32_t Length)
+{
+    DMA_Cmd(LINK_TX_DMA_CHANNEL, DISABLE);
+    LinkTxDma.DMA_MemoryBaseAddr = (uint32_t)pData;
+    LinkTxDma.DMA_BufferSize = Length;
+    DMA_Init(LINK_TX_DMA_CHANNEL, &LinkTxDma);
+    DMA_Cmd(LINK_TX_DMA_CHANNEL, ENABLE);
+}
+
+/**
+  * @brief  Tells whether the transmit DMA still reads the record.
+  * @param  None
+  * @retval 1 while bytes are left, 0 otherwise.
+  */
+static uint8_t Link_TxBusy(void)
+{
+    return (uint8_t)(DMA_GetCurrDataCounter(LINK_TX_DMA_CHANNEL) != 0);
+}
+
+/**
+  * @brief  Fills a buffer with TRNG output.
+  * @param  pData: buffer to fill.
+  * @param  Length: number of bytes.
+  * @retval None
+  */
+static void Link_Random(uint8_t* pData, uint32_t Length)
+{
+    uint32_t random = 0;
+    uint32_t i;
+
+    for (i = 0; i < Length; i++)
+    {
+        if ((i & 3) == 0)
+        {
+            TRNG_Cmd(ENABLE);
+
+            while (TRNG_GetRandomNumber(&random) != SUCCESS)
+            {
+            }
+        }
+
+        pData[i] = (uint8_t)random;
+        random >>= 8;
+    }
+}
+
+/**
+  * @brief  Checks the payload of an authenticated record against the stream.
+  * @param  pData: plain text.
+  * @param  Length: number of bytes.
+  * @retval None
+  */
+static void Link_Deliver(const uint8_t* pData, uint32_t Length)
+{
+    uint32_t i;
+
+    for (i = 0; i < Length; i++)
+    {
+        if (pData[i] != Stream_Byte(RxOffset))
+        {
+            RxErrors++;
+        }
+
+        RxOffset++;
+    }
+}
+
+/**
+  * @brief  Returns a byte of the stream.
+  * @param  Offset: byte offset from the start of the stream.
+  * @retval Byte value.
+  */
+static uint8_t Stream_Byte(uint32_t Offset)
+{
+    return (uint8_t)((Offset * 7) ^ (Offset >> 8));
+}
+
+/* A plate processing flow  */
+#ifdef AES_TWO_BOARD_A
+/**
+  * @brief  Writes the stream in chunks of random length, the record layer
+  *         splits them in records.
+  * @param  None
+  * @retval 1 once the last record is sent, 0 otherwise.
+  */
+static uint8_t Stream_Send(void)
+{
+    uint32_t i;
+
+    if ((ChunkSent == ChunkLength) && (TxOffset + ChunkLength < STREAM_SIZE))
+    {
+        TxOffset += ChunkLength;
+        ChunkSeed = ChunkSeed * 1103515245 + 12345;
+        ChunkLength = 1 + ((ChunkSeed >> 16) % CHUNK_SIZE_MAX);
+
+        if (ChunkLength > STREAM_SIZE - TxOffset)
+        {
+            ChunkLength = STREAM_SIZE - TxOffset;
+        }
+
+        for (i = 0; i < ChunkLength; i++)
+        {
+            Chunk[i] = Stream_Byte(TxOffset + i);
+        }
+
+        ChunkSent = 0;
+    }
+
+    ChunkSent += Record_Write(&Link, &Chunk[ChunkSent], ChunkLength - ChunkSent);
+
+    /* Done once the last chunk is sealed and both buffers are sent */
+    if ((ChunkSent == ChunkLength) && (TxOffset + ChunkLength == STREAM_SIZE) && (Link.TxPending == 0))
+    {
+        TxOffset = STREAM_SIZE;
+        ChunkLength = 0;
+        ChunkSent = 0;
+        return 1;
+    }
+
+    return 0;
+}
+#endif
+
+#ifdef  USE_FULL_ASSERT
+
+/**
+  * @brief  Reports the name of the source file and the source line number
+  *         where the assert_param error has occurred.
+  * @param  file: pointer to the source file name
+  * @param  line: assert_param error line source number
+  * @retval None
+  */
+void assert_failed(uint8_t* file, uint32_t line)
+{
+    /* User can add his own implementation to report the file name and line number,
+       ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
+
+    /* Infinite loop */
+    while (1)
+    {
+    }
+}
+#endif
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
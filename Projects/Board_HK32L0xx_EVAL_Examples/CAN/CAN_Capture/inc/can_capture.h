@@ -0,0 +1,150 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  can_capture.h
+* @brief:     Header for can_capture.c file.
+* @author:    AE Team
+*******************************************************************************/
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __CAN_CAPTURE_H
+#define __CAN_CAPTURE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "hk32l0xx.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* Record flags */
+#define CAN_CAPTURE_TX              ((uint8_t)0x80)  /*!< Frame sent, else received */
+#define CAN_CAPTURE_IDE             ((uint8_t)0x40)  /*!< Extended identifier */
+#define CAN_CAPTURE_RTR             ((uint8_t)0x20)  /*!< Remote frame */
+#define CAN_CAPTURE_TIME32          ((uint8_t)0x10)  /*!< Encoded record: 32-bit time */
+#define CAN_CAPTURE_DLC             ((uint8_t)0x0F)  /*!< Encoded record: DLC field */
+
+/* Largest encoded record: flags, 32-bit time, extended identifier, 8 data bytes */
+#define CAN_CAPTURE_RECORD_MAX      17
+
+/* Number of identifiers followed by the statistics */
+#ifndef CAN_CAPTURE_STAT_IDS
+#define CAN_CAPTURE_STAT_IDS        16
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+/**
+  * @brief  Captured frame.
+  */
+typedef struct
+{
+    uint32_t Time;              /*!< Time stamp, in CAN bit times */
+    uint32_t Id;                /*!< Standard or extended identifier */
+    uint8_t Flags;              /*!< CAN_CAPTURE_TX, CAN_CAPTURE_IDE and CAN_CAPTURE_RTR */
+    uint8_t DLC;                /*!< Data length code, 0 to 8 */
+    uint8_t Data[8];            /*!< Data bytes, none for a remote frame */
+} CANCapture_RecordTypeDef;
+
+/**
+  * @brief  Capture log: records encoded in a single producer / single
+  *         consumer byte ring.
+  * @note   The producer is the CAN interrupt, the consumer drains the raw
+  *         bytes or whole records, e.g. to a USART. Head and Tail run freely and Size must be
+  *         a power of two.
+  */
+typedef struct
+{
+    uint8_t* pBuffer;           /*!< Storage, Size bytes */
+    uint32_t Size;              /*!< Storage size, power of two */
+    __IO uint32_t Head;         /*!< Write index, owned by the producer */
+    __IO uint32_t Tail;         /*!< Read index, owned by the consumer */
+    __IO uint32_t Dropped;      /*!< Records dropped because the ring was full */
+    uint32_t Reference;         /*!< Current time estimate, in CAN bit times */
+    uint8_t Synced;             /*!< Reference follows the CAN timer */
+    uint32_t LastTime;          /*!< Time of the last record written */
+} CANCapture_TypeDef;
+
+/**
+  * @brief  Statistics of one identifier.
+  */
+typedef struct
+{
+    uint32_t Id;                /*!< Identifier */
+    uint8_t Flags;              /*!< CAN_CAPTURE_IDE for an extended identifier */
+    uint32_t Frames;            /*!< Frames in the current window */
+    uint32_t Total;             /*!< Frames since CANCapture_StatsInit() */
+    uint32_t Rate;              /*!< Frames per second over the last window */
+} CANCapture_IdStatTypeDef;
+
+/**
+  * @brief  Traffic statistics, computed over windows closed by
+  *         CANCapture_StatsWindow().
+  */
+typedef struct
+{
+    CANCapture_IdStatTypeDef Ids[CAN_CAPTURE_STAT_IDS]; /*!< Identifiers seen first */
+    uint32_t NbIds;             /*!< Entries used in Ids */
+    uint32_t Others;            /*!< Frames of the identifiers not in Ids */
+    uint32_t WindowStart;       /*!< Start time of the current window */
+    uint32_t WindowBits;        /*!< Bus bits used in the current window */
+    uint16_t BusLoad;           /*!< Bus load of the last window, in 0.01 % */
+    uint16_t BusLoadMax;        /*!< Highest bus load of a window */
+    uint8_t Rec;                /*!< Receive error counter at the last window */
+    uint8_t Tec;                /*!< Transmit error counter at the last window */
+    int16_t RecTrend;           /*!< Change of Rec over the last window */
+    int16_t TecTrend;           /*!< Change of Tec over the last window */
+    uint8_t RecMax;             /*!< Highest Rec sampled */
+    uint8_t TecMax;             /*!< Highest Tec sampled */
+} CANCapture_StatsTypeDef;
+
+/**
+  * @brief  Replay of a capture log.
+  */
+typedef struct
+{
+    const uint8_t* pData;       /*!< Capture log */
+    uint32_t Length;            /*!< Log length, in bytes */
+    uint32_t Offset;            /*!< Offset of the record after Next */
+    uint32_t PrevTime;          /*!< Decoder time base */
+    uint32_t Origin;            /*!< Capture time of the first record */
+    uint32_t Start;             /*!< Replay time of the first record */
+    uint8_t Pending;            /*!< Next holds a record */
+    CANCapture_RecordTypeDef Next; /*!< Next record to replay */
+} CANCapture_ReplayTypeDef;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+/* Capture log */
+void CANCapture_Init(CANCapture_TypeDef* Capture, uint8_t* pBuffer, uint32_t Size);
+void CANCapture_Tick(CANCapture_TypeDef* Capture, uint32_t BitTimes);
+uint32_t CANCapture_ExtendTime(CANCapture_TypeDef* Capture, uint16_t Stamp);
+uint32_t CANCapture_Write(CANCapture_TypeDef* Capture, const CANCapture_RecordTypeDef* Record);
+uint32_t CANCapture_Read(CANCapture_TypeDef* Capture, uint8_t* pData, uint32_t Length);
+uint32_t CANCapture_ReadRecord(CANCapture_TypeDef* Capture, uint8_t* pData);
+
+/* Record format */
+uint32_t CANCapture_Encode(const CANCapture_RecordTypeDef* Record, uint32_t PrevTime, uint8_t* pData);
+uint32_t CANCapture_Decode(const uint8_t* pData, uint32_t Length, uint32_t* pPrevTime,
+                           CANCapture_RecordTypeDef* Record);
+uint32_t CANCapture_FrameBits(const CANCapture_RecordTypeDef* Record);
+
+/* Statistics */
+void CANCapture_StatsInit(CANCapture_StatsTypeDef* Stats, uint32_t Time);
+void CANCapture_StatsAdd(CANCapture_StatsTypeDef* Stats, const CANCapture_RecordTypeDef* Record);
+void CANCapture_StatsWindow(CANCapture_StatsTypeDef* Stats, uint32_t Time, uint32_t BitRate,
+                            uint8_t Rec, uint8_t Tec);
+
+/* Replay */
+void CANCapture_ReplayInit(CANCapture_ReplayTypeDef* Replay, const uint8_t* pData, uint32_t Length,
+                           uint32_t Now);
+uint32_t CANCapture_ReplayPoll(CANCapture_ReplayTypeDef* Replay, uint32_t Now,
+                               CANCapture_RecordTypeDef* Record);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*__CAN_CAPTURE_H */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,618 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  can_capture.c
+* @brief:     CAN frame capture log, replay and traffic statistics.
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-04
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "can_capture.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Bit stream of a frame, for the stuff bits and the CRC */
+typedef struct
+{
+    uint32_t Crc;
+    uint32_t Last;
+    uint32_t Run;
+    uint32_t Bits;
+} CANCapture_BitStream;
+
+/* Private define ------------------------------------------------------------*/
+/* CRC-15 polynomial of the CAN frames */
+#define CAN_CRC15_POLY              ((uint32_t)0x4599)
+
+/* CRC delimiter, ACK slot, ACK delimiter, end of frame and intermission */
+#define CAN_FRAME_TAIL_BITS         13
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t CANCapture_Length(uint32_t Flags);
+static void CANCapture_PushBits(CANCapture_BitStream* Stream, uint32_t Value, uint32_t Count,
+                                uint32_t Crc);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Initializes an empty capture log.
+  * @param  Capture: capture log.
+  * @param  pBuffer: storage of Size bytes.
+  * @param  Size: storage size, must be a power of two.
+  * @retval None
+  */
+void CANCapture_Init(CANCapture_TypeDef* Capture, uint8_t* pBuffer, uint32_t Size)
+{
+    Capture->pBuffer = pBuffer;
+    Capture->Size = Size;
+    Capture->Head = 0;
+    Capture->Tail = 0;
+    Capture->Dropped = 0;
+    Capture->Reference = 0;
+    Capture->Synced = 0;
+    Capture->LastTime = 0;
+}
+
+/**
+  * @brief  Advances the time estimate used to extend the time stamps.
+  * @note   To be called with the time elapsed on a free running timer, at
+  *         the priority of the CAN interrupt, at least every 32768 bit
+  *         times. It lets CANCapture_ExtendTime() resolve bus idle times
+  *         longer than the 16-bit CAN timer.
+  * @param  Capture: capture log.
+  * @param  BitTimes: CAN bit times elapsed since the last call.
+  * @retval None
+  */
+void CANCapture_Tick(CANCapture_TypeDef* Capture, uint32_t BitTimes)
+{
+    Capture->Reference += BitTimes;
+}
+
+/**
+  * @brief  Extends a 16-bit CAN time stamp to 32 bits.
+  * @note   The result is the time closest to the current estimate with the
+  *         same 16 low bits, so frames may be stamped slightly out of order
+  *         (a frame sent is reported after the frames received meanwhile).
+  *         The estimate must stay within 32768 bit times of the CAN timer.
+  * @param  Capture: capture log.
+  * @param  Stamp: 16-bit time stamp.
+  * @retval 32-bit time stamp, in CAN bit times.
+  */
+uint32_t CANCapture_ExtendTime(CANCapture_TypeDef* Capture, uint16_t Stamp)
+{
+    if (Capture->Synced == 0)
+    {
+        Capture->Reference = Stamp;
+        Capture->Synced = 1;
+    }
+    else
+    {
+        Capture->Reference += (int16_t)(Stamp - (uint16_t)Capture->Reference);
+    }
+
+    return Capture->Reference;
+}
+
+/**
+  * @brief  Appends a record to the capture log (producer side).
+  * @note   A record which does not fit is dropped and counted in Dropped.
+  * @param  Capture: capture log.
+  * @param  Record: frame to log.
+  * @retval 1 if the record is logged, 0 if it is dropped.
+  */
+uint32_t CANCapture_Write(CANCapture_TypeDef* Capture, const CANCapture_RecordTypeDef* Record)
+{
+    uint8_t encoded[CAN_CAPTURE_RECORD_MAX];
+    uint32_t head = Capture->Head;
+    uint32_t length;
+    uint32_t index;
+
+    length = CANCapture_Encode(Record, Capture->LastTime, encoded);
+
+    if (length > (Capture->Size - (head - Capture->Tail)))
+    {
+        Capture->Dropped++;
+        return 0;
+    }
+
+    for (index = 0; index < length; index++)
+    {
+        Capture->pBuffer[(head + index) & (Capture->Size - 1)] = encoded[index];
+    }
+
+    Capture->LastTime = Record->Time;
+
+    /* Publish the record after it is stored */
+    __DMB();
+    Capture->Head = head + length;
+
+    return 1;
+}
+
+/**
+  * @brief  Copies encoded records out of the capture log (consumer side).
+  * @note   The bytes are the records in the format of CANCapture_Encode(),
+  *         each time relative to the previous record, the first one to 0.
+  * @param  Capture: capture log.
+  * @param  pData: destination.
+  * @param  Length: maximum number of bytes to read.
+  * @retval Number of bytes read.
+  */
+uint32_t CANCapture_Read(CANCapture_TypeDef* Capture, uint8_t* pData, uint32_t Length)
+{
+    uint32_t tail = Capture->Tail;
+    uint32_t count = Capture->Head - tail;
+    uint32_t index;
+
+    if (Length > count)
+    {
+        Length = count;
+    }
+
+    /* Read Head before the data it covers */
+    __DMB();
+
+    for (index = 0; index < Length; index++)
+    {
+        pData[index] = Capture->pBuffer[(tail + index) & (Capture->Size - 1)];
+    }
+
+    /* Done with the data before the producer may reuse it */
+    __DMB();
+    Capture->Tail = tail + Length;
+
+    return Length;
+}
+
+/**
+  * @brief  Copies the oldest record out of the capture log (consumer side).
+  * @note   The producer publishes whole records, so a record is never read
+  *         in part.
+  * @param  Capture: capture log.
+  * @param  pData: destination, CAN_CAPTURE_RECORD_MAX bytes.
+  * @retval Length of the record, 0 if the log is empty.
+  */
+uint32_t CANCapture_ReadRecord(CANCapture_TypeDef* Capture, uint8_t* pData)
+{
+    uint32_t tail = Capture->Tail;
+
+    if (Capture->Head == tail)
+    {
+        return 0;
+    }
+
+    /* Read Head before the record it covers */
+    __DMB();
+
+    return CANCapture_Read(Capture, pData,
+                           CANCapture_Length(Capture->pBuffer[tail & (Capture->Size - 1)]));
+}
+
+/**
+  * @brief  Encodes a record.
+  * @note   Record layout, multi-byte fields little endian:
+  *         - flags: CAN_CAPTURE_TX, CAN_CAPTURE_IDE, CAN_CAPTURE_RTR,
+  *           CAN_CAPTURE_TIME32 and the DLC in CAN_CAPTURE_DLC,
+  *         - time: 16-bit delta to PrevTime, or the 32-bit time if
+  *           CAN_CAPTURE_TIME32 is set,
+  *         - identifier: 16 bits, 32 bits if CAN_CAPTURE_IDE is set,
+  *         - data: DLC bytes (at most 8), none for a remote frame.
+  * @param  Record: record to encode.
+  * @param  PrevTime: time of the previous record, 0 for the first one.
+  * @param  pData: destination, CAN_CAPTURE_RECORD_MAX bytes.
+  * @retval Length of the encoded record.
+  */
+uint32_t CANCapture_Encode(const CANCapture_RecordTypeDef* Record, uint32_t PrevTime, uint8_t* pData)
+{
+    uint32_t delta = Record->Time - PrevTime;
+    uint32_t length = 1;
+    uint32_t count;
+    uint32_t index;
+
+    pData[0] = (Record->Flags & (CAN_CAPTURE_TX | CAN_CAPTURE_IDE | CAN_CAPTURE_RTR)) |
+               (Record->DLC & CAN_CAPTURE_DLC);
+
+    if (delta > 0xFFFF)
+    {
+        pData[0] |= CAN_CAPTURE_TIME32;
+        delta = Record->Time;
+        pData[length++] = (uint8_t)delta;
+        pData[length++] = (uint8_t)(delta >> 8);
+        pData[length++] = (uint8_t)(delta >> 16);
+        pData[length++] = (uint8_t)(delta >> 24);
+    }
+    else
+    {
+        pData[length++] = (uint8_t)delta;
+        pData[length++] = (uint8_t)(delta >> 8);
+    }
+
+    pData[length++] = (uint8_t)Record->Id;
+    pData[length++] = (uint8_t)(Record->Id >> 8);
+
+    if ((Record->Flags & CAN_CAPTURE_IDE) != 0)
+    {
+        pData[length++] = (uint8_t)(Record->Id >> 16);
+        pData[length++] = (uint8_t)(Record->Id >> 24);
+    }
+
+    if ((Record->Flags & CAN_CAPTURE_RTR) == 0)
+    {
+        count = (Record->DLC & CAN_CAPTURE_DLC) > 8 ? 8 : (Record->DLC & CAN_CAPTURE_DLC);
+
+        for (index = 0; index < count; index++)
+        {
+            pData[length++] = Record->Data[index];
+        }
+    }
+
+    return length;
+}
+
+/**
+  * @brief  Decodes a record.
+  * @param  pData: encoded records.
+  * @param  Length: number of bytes available in pData.
+  * @param  pPrevTime: time of the previous record, 0 before the first one,
+  *         updated with the time of the decoded record.
+  * @param  Record: receives the decoded record.
+  * @retval Length of the decoded record, 0 if pData does not hold a whole record.
+  */
+uint32_t CANCapture_Decode(const uint8_t* pData, uint32_t Length, uint32_t* pPrevTime,
+                           CANCapture_RecordTypeDef* Record)
+{
+    uint32_t flags;
+    uint32_t needed;
+    uint32_t count = 0;
+    uint32_t index;
+    uint32_t offset = 1;
+
+    if (Length == 0)
+    {
+        return 0;
+    }
+
+    flags = pData[0];
+
+    if ((flags & CAN_CAPTURE_RTR) == 0)
+    {
+        count = (flags & CAN_CAPTURE_DLC) > 8 ? 8 : (flags & CAN_CAPTURE_DLC);
+    }
+
+    needed = CANCapture_Length(flags);
+
+    if (Length < needed)
+    {
+        return 0;
+    }
+
+    if ((flags & CAN_CAPTURE_TIME32) != 0)
+    {
+        Record->Time = (uint32_t)pData[1] | ((uint32_t)pData[2] << 8) |
+                       ((uint32_t)pData[3] << 16) | ((uint32_t)pData[4] << 24);
+        offset = 5;
+    }
+    else
+    {
+        Record->Time = *pPrevTime + ((uint32_t)pData[1] | ((uint32_t)pData[2] << 8));
+        offset = 3;
+    }
+
+    *pPrevTime = Record->Time;
+
+    Record->Id = (uint32_t)pData[offset] | ((uint32_t)pData[offset + 1] << 8);
+    offset += 2;
+
+    if ((flags & CAN_CAPTURE_IDE) != 0)
+    {
+        Record->Id |= ((uint32_t)pData[offset] << 16) | ((uint32_t)pData[offset + 1] << 24);
+        offset += 2;
+    }
+
+    Record->Flags = (uint8_t)(flags & (CAN_CAPTURE_TX | CAN_CAPTURE_IDE | CAN_CAPTURE_RTR));
+    Record->DLC = (uint8_t)(flags & CAN_CAPTURE_DLC);
+
+    for (index = 0; index < count; index++)
+    {
+        Record->Data[index] = pData[offset++];
+    }
+
+    return needed;
+}
+
+/**
+  * @brief  Returns the length of an encoded record.
+  * @param  Flags: first byte of the record.
+  * @retval Length of the record.
+  */
+static uint32_t CANCapture_Length(uint32_t Flags)
+{
+    uint32_t count = 0;
+
+    if ((Flags & CAN_CAPTURE_RTR) == 0)
+    {
+        count = (Flags & CAN_CAPTURE_DLC) > 8 ? 8 : (Flags & CAN_CAPTURE_DLC);
+    }
+
+    return 1 + (((Flags & CAN_CAPTURE_TIME32) != 0) ? 4 : 2) +
+           (((Flags & CAN_CAPTURE_IDE) != 0) ? 4 : 2) + count;
+}
+
+/**
+  * @brief  Returns the number of bus bits a frame takes.
+  * @note   Counts the stuff bits of the actual frame content and the 3 bits
+  *         of intermission.
+  * @param  Record: frame.
+  * @retval Number of bits.
+  */
+uint32_t CANCapture_FrameBits(const CANCapture_RecordTypeDef* Record)
+{
+    CANCapture_BitStream stream;
+    uint32_t rtr = ((Record->Flags & CAN_CAPTURE_RTR) != 0) ? 1 : 0;
+    uint32_t count = 0;
+    uint32_t index;
+
+    /* The bus is recessive before the start of frame */
+    stream.Crc = 0;
+    stream.Last = 1;
+    stream.Run = 0;
+    stream.Bits = 0;
+
+    /* Start of frame */
+    CANCapture_PushBits(&stream, 0, 1, 1);
+
+    if ((Record->Flags & CAN_CAPTURE_IDE) == 0)
+    {
+        /* Identifier, RTR, IDE, r0 */
+        CANCapture_PushBits(&stream, Record->Id & 0x7FF, 11, 1);
+        CANCapture_PushBits(&stream, rtr << 2, 3, 1);
+    }
+    else
+    {
+        /* Base identifier, SRR, IDE, identifier extension, RTR, r1, r0 */
+        CANCapture_PushBits(&stream, (Record->Id >> 18) & 0x7FF, 11, 1);
+        CANCapture_PushBits(&stream, 3, 2, 1);
+        CANCapture_PushBits(&stream, Record->Id & 0x3FFFF, 18, 1);
+        CANCapture_PushBits(&stream, rtr << 2, 3, 1);
+    }
+
+    CANCapture_PushBits(&stream, Record->DLC & 0x0F, 4, 1);
+
+    if (rtr == 0)
+    {
+        count = (Record->DLC & 0x0F) > 8 ? 8 : (Record->DLC & 0x0F);
+    }
+
+    for (index = 0; index < count; index++)
+    {
+        CANCapture_PushBits(&stream, Record->Data[index], 8, 1);
+    }
+
+    CANCapture_PushBits(&stream, stream.Crc, 15, 0);
+
+    return stream.Bits + CAN_FRAME_TAIL_BITS;
+}
+
+/**
+  * @brief  Sends bits of a frame through the CRC and the bit stuffing.
+  * @param  Stream: frame bit stream.
+  * @param  Value: bits to send, the most significant first.
+  * @param  Count: number of bits.
+  * @param  Crc: 1 if the bits are covered by the CRC.
+  * @retval None
+  */
+static void CANCapture_PushBits(CANCapture_BitStream* Stream, uint32_t Value, uint32_t Count,
+                                uint32_t Crc)
+{
+    uint32_t bit;
+
+    while (Count != 0)
+    {
+        Count--;
+        bit = (Value >> Count) & 1;
+
+        if (Crc != 0)
+        {
+            Stream->Crc = ((Stream->Crc << 1) & 0x7FFF) ^
+                          ((bit ^ (Stream->Crc >> 14)) != 0 ? CAN_CRC15_POLY : 0);
+        }
+
+        Stream->Bits++;
+
+        if (bit == Stream->Last)
+        {
+            Stream->Run++;
+        }
+        else
+        {
+            Stream->Last = bit;
+            Stream->Run = 1;
+        }
+
+        /* Five equal bits: a complementary stuff bit follows */
+        if (Stream->Run == 5)
+        {
+            Stream->Bits++;
+            Stream->Last = bit ^ 1;
+            Stream->Run = 1;
+        }
+    }
+}
+
+/**
+  * @brief  Clears the statistics and starts a window.
+  * @param  Stats: statistics.
+  * @param  Time: window start, in CAN bit times.
+  * @retval None
+  */
+void CANCapture_StatsInit(CANCapture_StatsTypeDef* Stats, uint32_t Time)
+{
+    Stats->NbIds = 0;
+    Stats->Others = 0;
+    Stats->WindowStart = Time;
+    Stats->WindowBits = 0;
+    Stats->BusLoad = 0;
+    Stats->BusLoadMax = 0;
+    Stats->Rec = 0;
+    Stats->Tec = 0;
+    Stats->RecTrend = 0;
+    Stats->TecTrend = 0;
+    Stats->RecMax = 0;
+    Stats->TecMax = 0;
+}
+
+/**
+  * @brief  Accounts a frame in the current window.
+  * @param  Stats: statistics.
+  * @param  Record: frame received or sent.
+  * @retval None
+  */
+void CANCapture_StatsAdd(CANCapture_StatsTypeDef* Stats, const CANCapture_RecordTypeDef* Record)
+{
+    uint8_t ide = Record->Flags & CAN_CAPTURE_IDE;
+    uint32_t index;
+
+    Stats->WindowBits += CANCapture_FrameBits(Record);
+
+    for (index = 0; index < Stats->NbIds; index++)
+    {
+        if ((Stats->Ids[index].Id == Record->Id) && (Stats->Ids[index].Flags == ide))
+        {
+            break;
+        }
+    }
+
+    if (index == Stats->NbIds)
+    {
+        if (index == CAN_CAPTURE_STAT_IDS)
+        {
+            Stats->Others++;
+            return;
+        }
+
+        Stats->Ids[index].Id = Record->Id;
+        Stats->Ids[index].Flags = ide;
+        Stats->Ids[index].Frames = 0;
+        Stats->Ids[index].Total = 0;
+        Stats->Ids[index].Rate = 0;
+        Stats->NbIds++;
+    }
+
+    Stats->Ids[index].Frames++;
+    Stats->Ids[index].Total++;
+}
+
+/**
+  * @brief  Closes the current window: computes the bus load and the frame
+  *         rates, samples the error counters and starts the next window.
+  * @param  Stats: statistics.
+  * @param  Time: window end, in CAN bit times.
+  * @param  BitRate: CAN bit rate, in bit/s.
+  * @param  Rec: receive error counter, CAN_GetReceiveErrorCounter().
+  * @param  Tec: transmit error counter, CAN_GetLSBTransmitErrorCounter().
+  * @retval None
+  */
+void CANCapture_StatsWindow(CANCapture_StatsTypeDef* Stats, uint32_t Time, uint32_t BitRate,
+                            uint8_t Rec, uint8_t Tec)
+{
+    uint32_t window = Time - Stats->WindowStart;
+    uint32_t index;
+    uint64_t load;
+
+    if (window == 0)
+    {
+        return;
+    }
+
+    load = ((uint64_t)Stats->WindowBits * 10000) / window;
+    Stats->BusLoad = (load > 10000) ? 10000 : (uint16_t)load;
+
+    if (Stats->BusLoad > Stats->BusLoadMax)
+    {
+        Stats->BusLoadMax = Stats->BusLoad;
+    }
+
+    for (index = 0; index < Stats->NbIds; index++)
+    {
+        Stats->Ids[index].Rate = (uint32_t)(((uint64_t)Stats->Ids[index].Frames * BitRate) / window);
+        Stats->Ids[index].Frames = 0;
+    }
+
+    Stats->RecTrend = (int16_t)Rec - (int16_t)Stats->Rec;
+    Stats->TecTrend = (int16_t)Tec - (int16_t)Stats->Tec;
+    Stats->Rec = Rec;
+    Stats->Tec = Tec;
+
+    if (Rec > Stats->RecMax)
+    {
+        Stats->RecMax = Rec;
+    }
+
+    if (Tec > Stats->TecMax)
+    {
+        Stats->TecMax = Tec;
+    }
+
+    Stats->Others = 0;
+    Stats->WindowStart = Time;
+    Stats->WindowBits = 0;
+}
+
+/**
+  * @brief  Starts the replay of a capture log.
+  * @param  Replay: replay state.
+  * @param  pData: capture log, as read by CANCapture_Read().
+  * @param  Length: log length, in bytes.
+  * @param  Now: current time, in CAN bit times.
+  * @retval None
+  */
+void CANCapture_ReplayInit(CANCapture_ReplayTypeDef* Replay, const uint8_t* pData, uint32_t Length,
+                           uint32_t Now)
+{
+    Replay->pData = pData;
+    Replay->Length = Length;
+    Replay->PrevTime = 0;
+    Replay->Offset = CANCapture_Decode(pData, Length, &Replay->PrevTime, &Replay->Next);
+    Replay->Pending = (Replay->Offset != 0) ? 1 : 0;
+    Replay->Origin = Replay->Next.Time;
+    Replay->Start = Now;
+}
+
+/**
+  * @brief  Returns the next record of the replay once its time has come.
+  * @note   The records keep their capture time offsets from the first one.
+  * @param  Replay: replay state.
+  * @param  Now: current time, in CAN bit times.
+  * @param  Record: receives the record to send.
+  * @retval 1 if a record is returned, 0 if none is due or the replay is over.
+  */
+uint32_t CANCapture_ReplayPoll(CANCapture_ReplayTypeDef* Replay, uint32_t Now,
+                               CANCapture_RecordTypeDef* Record)
+{
+    uint32_t length;
+
+    if (Replay->Pending == 0)
+    {
+        return 0;
+    }
+
+    if ((int32_t)((Now - Replay->Start) - (Replay->Next.Time - Replay->Origin)) < 0)
+    {
+        return 0;
+    }
+
+    *Record = Replay->Next;
+
+    length = CANCapture_Decode(Replay->pData + Replay->Offset, Replay->Length - Replay->Offset,
+                               &Replay->PrevTime, &Replay->Next);
+    Replay->Offset += length;
+    Replay->Pending = (length != 0) ? 1 : 0;
+
+    return 1;
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
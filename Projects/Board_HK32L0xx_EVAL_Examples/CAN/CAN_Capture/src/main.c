@@ -0,0 +1,451 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  main.c
+* @brief:     Main program body
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-04
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "hk32l0xx_eval.h"
+#include "can_capture.h"
+
+/** @addtogroup HK32L0xx_StdPeriph_Examples
+  * @{
+  */
+
+/** @addtogroup CAN_Capture
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* CAN bit rate, bit/s */
+#define CAN_BITRATE         1000000
+
+/* Capture log ring, power of two */
+#define CAPTURE_SIZE        2048
+
+/* Start of the capture kept for the replay */
+#define REPLAY_SIZE         2048
+
+/* Statistics window, CAN bit times: 1 s */
+#define STATS_PERIOD        CAN_BITRATE
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static CanMailbox RxFrames[16];
+static CanMailbox TxFrames[8];
+static CAN_QueueTypeDef CanQueue;
+
+static uint8_t CaptureBuffer[CAPTURE_SIZE];
+static uint8_t ReplayBuffer[REPLAY_SIZE];
+static uint32_t ReplayLength = 0;
+static uint8_t ReplayFrozen = 0;
+static CANCapture_ReplayTypeDef Replay;
+static CANCapture_RecordTypeDef ReplayRecord;
+static uint8_t ReplayHeld = 0;
+static uint8_t Replaying = 0;
+
+/* Record being sent to COM1 */
+static uint8_t DrainRecord[CAN_CAPTURE_RECORD_MAX];
+static uint32_t DrainLength = 0;
+static uint32_t DrainSent = 0;
+static uint32_t DrainTime = 0;
+
+/* Last value of the time base counter */
+static uint16_t TimerLast = 0;
+
+CANCapture_TypeDef Capture;
+CANCapture_StatsTypeDef Stats;
+
+/* Private function prototypes -----------------------------------------------*/
+static void CAN_Config(void);
+static void COM_Config(void);
+static void TIM_Config(void);
+static void Capture_Update(void);
+static void CAN_Monitor(const CanMailbox* Frame, uint8_t Direction);
+static void Capture_Drain(void);
+static void Replay_Process(uint32_t Now);
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Main program.
+  * @param  None
+  * @retval None
+  */
+int main(void)
+{
+    CanRxMsg RxMessage;
+    uint32_t now;
+
+    /* Configures LED1 and LED2 */
+    HK_EVAL_LEDInit(LED1);
+    HK_EVAL_LEDInit(LED2);
+
+    /* Configure Push button key */
+    HK_EVAL_PBInit(BUTTON_KEY1, BUTTON_MODE_GPIO);
+
+    /* The capture log is drained to COM1 */
+    COM_Config();
+
+    CANCapture_Init(&Capture, CaptureBuffer, CAPTURE_SIZE);
+    CANCapture_StatsInit(&Stats, 0);
+
+    /* Time base counting CAN bit times */
+    TIM_Config();
+
+    /* CAN configuration */
+    CAN_Config();
+
+    /* Infinite loop */
+    while (1)
+    {
+        /* The frames are only captured */
+        while (CAN_QueueReceive(&RxMessage) != 0)
+        {
+        }
+
+        NVIC_DisableIRQ(LCD_CAN_IRQn);
+        Capture_Update();
+        now = Capture.Reference;
+        NVIC_EnableIRQ(LCD_CAN_IRQn);
+
+        Capture_Drain();
+
+        /* KEY1 replays the start of the capture */
+        if ((HK_EVAL_PBGetState(BUTTON_KEY1) == RESET) && (Replaying == 0) && (ReplayLength != 0))
+        {
+            CANCapture_ReplayInit(&Replay, ReplayBuffer, ReplayLength, now);
+            ReplayFrozen = 1;
+            Replaying = 1;
+            HK_EVAL_LEDOn(LED2);
+        }
+
+        Replay_Process(now);
+
+        /* Close a statistics window every STATS_PERIOD bit times */
+        if ((now - Stats.WindowStart) >= STATS_PERIOD)
+        {
+            CANCapture_StatsWindow(&Stats, now, CAN_BITRATE,
+                                   CAN_GetReceiveErrorCounter(), CAN_GetLSBTransmitErrorCounter());
+
+            HK_EVAL_LEDToggle(LED1);
+        }
+    }
+}
+
+/**
+  * @brief  Advances the capture time base by the bit times counted by TIM14.
+  * @note   Called from the CAN interrupt and from the main loop with the CAN
+  *         interrupt disabled, more often than the 65536 bit times period
+  *         of the counter.
+  * @param  None
+  * @retval None
+  */
+static void Capture_Update(void)
+{
+    uint16_t counter = (uint16_t)TIM_GetCounter(TIM14);
+
+    CANCapture_Tick(&Capture, (uint16_t)(counter - TimerLast));
+    TimerLast = counter;
+}
+
+/**
+  * @brief  Logs each frame received or sent, from the CAN interrupt.
+  * @param  Frame: frame received or sent.
+  * @param  Direction: CAN_Monitor_Rx or CAN_Monitor_Tx.
+  * @retval None
+  */
+static void CAN_Monitor(const CanMailbox* Frame, uint8_t Direction)
+{
+    CANCapture_RecordTypeDef record;
+
+    Capture_Update();
+
+    /* Time triggered mode: the time stamp is in the TIME field */
+    record.Time = CANCapture_ExtendTime(&Capture, (uint16_t)(Frame->DTR >> 16));
+    record.Flags = (Direction == CAN_Monitor_Tx) ? CAN_CAPTURE_TX : 0;
+
+    if ((Frame->IR & CAN_Id_Extended) != 0)
+    {
+        record.Flags |= CAN_CAPTURE_IDE;
+        record.Id = Frame->IR >> 3;
+    }
+    else
+    {
+        record.Id = Frame->IR >> 21;
+    }
+
+    if ((Frame->IR & CAN_RTR_Remote) != 0)
+    {
+        record.Flags |= CAN_CAPTURE_RTR;
+    }
+
+    record.DLC = (uint8_t)(Frame->DTR & 0x0F);
+    record.Data[0] = (uint8_t)Frame->DLR;
+    record.Data[1] = (uint8_t)(Frame->DLR >> 8);
+    record.Data[2] = (uint8_t)(Frame->DLR >> 16);
+    record.Data[3] = (uint8_t)(Frame->DLR >> 24);
+    record.Data[4] = (uint8_t)Frame->DHR;
+    record.Data[5] = (uint8_t)(Frame->DHR >> 8);
+    record.Data[6] = (uint8_t)(Frame->DHR >> 16);
+    record.Data[7] = (uint8_t)(Frame->DHR >> 24);
+
+    CANCapture_Write(&Capture, &record);
+}
+
+/**
+  * @brief  Accounts the logged frames in the statistics, sends the log to
+  *         COM1 and keeps its start for the replay.
+  * @note   Only the bytes COM1 takes at once are sent, the main loop never
+  *         waits for the USART. Frames dropped from a full log are counted
+  *         in Capture.Dropped, not in the statistics.
+  * @param  None
+  * @retval None
+  */
+static void Capture_Drain(void)
+{
+    CANCapture_RecordTypeDef record;
+    uint32_t index;
+
+    while (1)
+    {
+        if (DrainSent == DrainLength)
+        {
+            DrainLength = CANCapture_ReadRecord(&Capture, DrainRecord);
+            DrainSent = 0;
+
+            if (DrainLength == 0)
+            {
+                return;
+            }
+
+            CANCapture_Decode(DrainRecord, DrainLength, &DrainTime, &record);
+            CANCapture_StatsAdd(&Stats, &record);
+
+            /* Whole records, up to the first replay */
+            if ((ReplayFrozen == 0) && ((ReplayLength + DrainLength) <= REPLAY_SIZE))
+            {
+                for (index = 0; index < DrainLength; index++)
+                {
+                    ReplayBuffer[ReplayLength++] = DrainRecord[index];
+                }
+            }
+        }
+
+        if (USART_GetFlagStatus(EVAL_COM1, USART_FLAG_TXE) == RESET)
+        {
+            return;
+        }
+
+        USART_SendData(EVAL_COM1, DrainRecord[DrainSent++]);
+    }
+}
+
+/**
+  * @brief  Sends the replayed frames when their time has come.
+  * @note   A frame the TX queue cannot take is kept and sent again on the
+  *         next call, before the frames after it.
+  * @param  Now: current time, in CAN bit times.
+  * @retval None
+  */
+static void Replay_Process(uint32_t Now)
+{
+    CanTxMsg TxMessage;
+    uint32_t index;
+
+    if (Replaying == 0)
+    {
+        return;
+    }
+
+    while (1)
+    {
+        if (ReplayHeld == 0)
+        {
+            if (CANCapture_ReplayPoll(&Replay, Now, &ReplayRecord) == 0)
+            {
+                break;
+            }
+
+            ReplayHeld = 1;
+        }
+
+        TxMessage.StdId = ReplayRecord.Id;
+        TxMessage.ExtId = ReplayRecord.Id;
+        TxMessage.IDE = ((ReplayRecord.Flags & CAN_CAPTURE_IDE) != 0) ? CAN_Id_Extended : CAN_Id_Standard;
+        TxMessage.RTR = ((ReplayRecord.Flags & CAN_CAPTURE_RTR) != 0) ? CAN_RTR_Remote : CAN_RTR_Data;
+        TxMessage.DLC = (ReplayRecord.DLC > 8) ? 8 : ReplayRecord.DLC;
+
+        for (index = 0; index < 8; index++)
+        {
+            TxMessage.Data[index] = ReplayRecord.Data[index];
+        }
+
+        /* TX queue full: back off until the mailboxes drain it */
+        if (CAN_QueueTransmit(&TxMessage) == CAN_TxStatus_Failed)
+        {
+            return;
+        }
+
+        ReplayHeld = 0;
+    }
+
+    if (Replay.Pending == 0)
+    {
+        Replaying = 0;
+        HK_EVAL_LEDOff(LED2);
+    }
+}
+
+/**
+  * @brief  Configures COM1: 115200 baud, 8 data bits, 1 stop bit, no parity.
+  * @param  None
+  * @retval None
+  */
+static void COM_Config(void)
+{
+    USART_InitTypeDef USART_InitStructure;
+
+    USART_InitStructure.USART_BaudRate = 115200;
+    USART_InitStructure.USART_WordLength = USART_WordLength_8b;
+    USART_InitStructure.USART_StopBits = USART_StopBits_1;
+    USART_InitStructure.USART_Parity = USART_Parity_No;
+    USART_InitStructure.USART_HardwareFlowControl = USART_HardwareFlowControl_None;
+    USART_InitStructure.USART_Mode = USART_Mode_Rx | USART_Mode_Tx;
+    HK_EVAL_COMInit(COM1, &USART_InitStructure);
+}
+
+/**
+  * @brief  Configures TIM14 as a free running counter of CAN bit times.
+  * @param  None
+  * @retval None
+  */
+static void TIM_Config(void)
+{
+    TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure;
+
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM14, ENABLE);
+
+    TIM_TimeBaseStructure.TIM_Period = 0xFFFF;
+    TIM_TimeBaseStructure.TIM_Prescaler = (uint16_t)(SystemCoreClock / CAN_BITRATE - 1);
+    TIM_TimeBaseStructure.TIM_ClockDivision = 0;
+    TIM_TimeBaseStructure.TIM_CounterMode = TIM_CounterMode_Up;
+    TIM_TimeBaseStructure.TIM_RepetitionCounter = 0;
+    TIM_TimeBaseInit(TIM14, &TIM_TimeBaseStructure);
+
+    TIM_Cmd(TIM14, ENABLE);
+    TimerLast = (uint16_t)TIM_GetCounter(TIM14);
+}
+
+/**
+  * @brief  Configures the CAN.
+  * @param  None
+  * @retval None
+  */
+static void CAN_Config(void)
+{
+    GPIO_InitTypeDef  GPIO_InitStructure;
+    NVIC_InitTypeDef  NVIC_InitStructure;
+    CAN_InitTypeDef        CAN_InitStructure;
+    CAN_FilterInitTypeDef  CAN_FilterInitStructure;
+
+    /* CAN GPIOs configuration **************************************************/
+
+    /* Enable GPIO clock */
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_GPIOA, ENABLE);
+
+    /* Connect CAN pins to AF4 */
+    GPIO_PinAFConfig(GPIOA, GPIO_PinSource11, GPIO_AF_4);
+    GPIO_PinAFConfig(GPIOA, GPIO_PinSource12, GPIO_AF_4);
+
+    /* Configure CAN RX and TX pins */
+    GPIO_InitStructure.GPIO_Pin = GPIO_Pin_11 | GPIO_Pin_12;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;
+    GPIO_InitStructure.GPIO_PuPd  = GPIO_PuPd_UP;
+    GPIO_Init(GPIOA, &GPIO_InitStructure);
+
+    /* NVIC configuration *******************************************************/
+    NVIC_InitStructure.NVIC_IRQChannel = LCD_CAN_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPriority = 0x0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+
+    /* CAN configuration ********************************************************/
+
+    /* Enable CAN clock */
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_CAN, ENABLE);
+
+    /* CAN register init */
+    CAN_DeInit();
+    CAN_StructInit(&CAN_InitStructure);
+
+    /* CAN cell init, time triggered mode for the frame time stamps */
+    CAN_InitStructure.CAN_TTCM = ENABLE;
+    CAN_InitStructure.CAN_ABOM = DISABLE;
+    CAN_InitStructure.CAN_AWUM = DISABLE;
+    CAN_InitStructure.CAN_NART = DISABLE;
+    CAN_InitStructure.CAN_RFLM = DISABLE;
+    CAN_InitStructure.CAN_TXFP = DISABLE;
+    CAN_InitStructure.CAN_Mode = CAN_Mode_Normal;
+    CAN_InitStructure.CAN_SJW = CAN_SJW_1tq;
+
+    /* CAN Baudrate = 1MBps (CAN clocked at 48 MHz) */
+    CAN_InitStructure.CAN_BS1 = CAN_BS1_10tq;
+    CAN_InitStructure.CAN_BS2 = CAN_BS2_5tq;
+    CAN_InitStructure.CAN_Prescaler = 3;
+    CAN_Init(&CAN_InitStructure);
+
+    /* CAN filter init: accept all frames */
+    CAN_FilterInitStructure.CAN_FilterNumber = 0;
+    CAN_FilterInitStructure.CAN_FilterMode = CAN_FilterMode_IdMask;
+    CAN_FilterInitStructure.CAN_FilterScale = CAN_FilterScale_32bit;
+    CAN_FilterInitStructure.CAN_FilterIdHigh = 0x0000;
+    CAN_FilterInitStructure.CAN_FilterIdLow = 0x0000;
+    CAN_FilterInitStructure.CAN_FilterMaskIdHigh = 0x0000;
+    CAN_FilterInitStructure.CAN_FilterMaskIdLow = 0x0000;
+    CAN_FilterInitStructure.CAN_FilterFIFOAssignment = 0;
+    CAN_FilterInitStructure.CAN_FilterActivation = ENABLE;
+    CAN_FilterInit(&CAN_FilterInitStructure);
+
+    /* Software queues, with the capture monitor */
+    CAN_QueueInit(&CanQueue, RxFrames, 16, TxFrames, 8);
+    CAN_QueueSetMonitor(CAN_Monitor);
+}
+
+#ifdef  USE_FULL_ASSERT
+
+/**
+  * @brief  Reports the name of the source file and the source line number
+  *         where the assert_param error has occurred.
+  * @param  file: pointer to the source file name
+  * @param  line: assert_param error line source number
+  * @retval None
+  */
+void assert_failed(uint8_t* file, uint32_t line)
+{
+    /* User can add his own implementation to report the file name and line number,
+       ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
+
+    /* Infinite loop */
+    while (1)
+    {
+    }
+}
+#endif
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
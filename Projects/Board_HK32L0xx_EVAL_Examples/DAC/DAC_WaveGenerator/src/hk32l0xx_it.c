@@ -0,0 +1,124 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  hk32l0xx_it.c
+* @brief:     Interrupt Service Routines
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-04
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "hk32l0xx_it.h"
+#include "hk32l0xx_eval.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+extern __IO uint8_t SelectedWavesForm, WaveChange;
+extern DAC_WaveTypeDef Wave;
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/******************************************************************************/
+/*            Cortex-M0 Processor Exceptions Handlers                         */
+/******************************************************************************/
+
+/**
+  * @brief  This function handles NMI exception.
+  * @retval None
+  */
+void NMI_Handler(void)
+{
+}
+
+/**
+  * @brief  This function handles Hard Fault exception.
+  * @retval None
+  */
+void HardFault_Handler(void)
+{
+    /* Go to infinite loop when Hard Fault exception occurs */
+    while (1)
+    {
+    }
+}
+
+/**
+  * @brief  This function handles SVCall exception.
+  * @retval None
+  */
+void SVC_Handler(void)
+{
+}
+
+/**
+  * @brief  This function handles PendSVC exception.
+  * @retval None
+  */
+void PendSV_Handler(void)
+{
+}
+
+/**
+  * @brief  This function handles SysTick Handler.
+  * @retval None
+  */
+void SysTick_Handler(void)
+{
+}
+
+/******************************************************************************/
+/*                 HK32L0xx Peripherals Interrupt Handlers                   */
+/*  Add here the Interrupt Handler for the used peripheral(s) (PPP), for the  */
+/*  available peripheral interrupt handler's name please refer to the startup */
+/*  file (KEIL_Startup_hk32l0xx.s).                                               */
+/******************************************************************************/
+
+/**
+  * @brief  This function handles DMA Channel 2 and 3 interrupt request:
+  *         synthesizes the next half buffer of the waveform.
+  * @param  None
+  * @retval None
+  */
+void DMA_CH2_3_IRQHandler(void)
+{
+    DAC_WaveIRQHandler(&Wave);
+}
+
+/**
+  * @brief  This function handles DAC interrupt request: restarts the DMA
+  *         of the waveform after an underrun.
+  * @param  None
+  * @retval None
+  */
+void DAC_IRQHandler(void)
+{
+    DAC_WaveIRQHandler(&Wave);
+}
+
+/**
+  * @brief  This function handles External line2-3 interrupt request.
+  * @param  None
+  * @retval None
+  */
+void EXTI2_3_IRQHandler(void)
+{
+    if (EXTI_GetITStatus(KEY1_BUTTON_EXTI_LINE) != RESET)
+    {
+        /* Next wave form */
+        SelectedWavesForm = (SelectedWavesForm + 1) % 4;
+
+        /* Change the wave */
+        WaveChange = 1;
+
+        /* Clear the Right Button EXTI line pending bit */
+        EXTI_ClearITPendingBit(KEY1_BUTTON_EXTI_LINE);
+    }
+}
+
+
+
+
@@ -0,0 +1,247 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  main.c
+* @brief:     Main program body
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial Version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "hk32l0xx_eval.h"
+
+/** @addtogroup HK32L0xx_StdPeriph_Examples
+  * @{
+  */
+
+/** @addtogroup DAC_WaveGenerator
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define SAMPLE_RATE              64000      /* DAC samples per second */
+#define BLOCK_LENGTH             64         /* Samples of a half buffer */
+#define TABLE_BITS               9          /* 512 samples per period */
+
+#define WAVE_SINE_1KHZ           0
+#define WAVE_SINE_2KHZ5          1
+#define WAVE_ARBITRARY           2
+#define WAVE_CHIRP               3
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Arbitrary waveform: one period given by a few points */
+static const uint16_t ArbitraryPoints[12] =
+{
+    2048, 2048, 2300, 2048, 1800, 4000, 200, 2048, 2048, 2600, 2900, 2048
+};
+
+static uint16_t WaveBuffer[2 * BLOCK_LENGTH];
+static uint16_t WaveTable[2][1 << TABLE_BITS];
+static uint8_t  FreeTable = 1;
+DAC_WaveTypeDef Wave;
+__IO uint8_t  SelectedWavesForm = WAVE_SINE_1KHZ;
+__IO uint8_t WaveChange = 0;
+
+/* Private function prototypes -----------------------------------------------*/
+static void DAC_Config(void);
+static void TIM_Config(void);
+static void Wave_SwapTable(void);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Main program.
+  * @param  None
+  * @retval None
+  */
+int main(void)
+{
+    /*!< At this stage the microcontroller clock setting is already configured,
+         this is done through SystemInit() function which is called from startup
+         file (startup_kh32l0xx.s) before to branch to application main.
+         To reconfigure the default setting of SystemInit() function, refer to
+         system_hk32l0xx.c file
+       */
+
+    /* Preconfiguration before using DAC----------------------------------------*/
+    DAC_Config();
+
+    /* Waveform generator: sine at 1 kHz */
+    DAC_WaveSynthSine(WaveTable[0], TABLE_BITS, 2047, 2048);
+    Wave.DAC_Trigger = DAC_Trigger_T2_TRGO;
+    Wave.SampleRate = SAMPLE_RATE;
+    Wave.Buffer = WaveBuffer;
+    Wave.BlockLength = BLOCK_LENGTH;
+    Wave.Table = WaveTable[0];
+    Wave.TableBits = TABLE_BITS;
+
+    if (DAC_WaveInit(&Wave) != SUCCESS)
+    {
+        while (1)
+        {
+        }
+    }
+
+    DAC_WaveSetFrequency(&Wave, 1000);
+
+    NVIC_SetPriority(DMA_CH2_3_IRQn, 0);
+    NVIC_EnableIRQ(DMA_CH2_3_IRQn);
+    NVIC_SetPriority(DAC_IRQn, 0);
+    NVIC_EnableIRQ(DAC_IRQn);
+
+    DAC_WaveStart(&Wave);
+
+    /* TIM2 configuration */
+    TIM_Config();
+
+    /* Configures Button GPIO and EXTI Line */
+    HK_EVAL_PBInit(BUTTON_KEY1, BUTTON_MODE_EXTI);
+
+    /* Infinite loop */
+    while (1)
+    {
+        /* If the wave form is changed */
+        if (WaveChange == 1)
+        {
+            WaveChange = 0;
+
+            switch (SelectedWavesForm)
+            {
+                case WAVE_SINE_1KHZ:
+                    /* Back to the sine table */
+                    DAC_WaveSynthSine(WaveTable[FreeTable], TABLE_BITS, 2047, 2048);
+                    Wave_SwapTable();
+                    DAC_WaveSetFrequency(&Wave, 1000);
+                    break;
+
+                case WAVE_SINE_2KHZ5:
+                    /* Same table, the phase goes on at the new frequency */
+                    DAC_WaveSetFrequency(&Wave, 2500);
+                    break;
+
+                case WAVE_ARBITRARY:
+                    /* Built in the table not played, then swapped */
+                    DAC_WaveSynthResample(WaveTable[FreeTable], TABLE_BITS, ArbitraryPoints,
+                                          sizeof(ArbitraryPoints) / sizeof(ArbitraryPoints[0]));
+                    Wave_SwapTable();
+                    DAC_WaveSetFrequency(&Wave, 1000);
+                    break;
+
+                default:
+                    /* Sine sweep from 100 Hz to 5 kHz in one second */
+                    DAC_WaveSynthSine(WaveTable[FreeTable], TABLE_BITS, 2047, 2048);
+                    Wave_SwapTable();
+                    DAC_WaveSetChirp(&Wave, 100, 5000, SAMPLE_RATE, ENABLE);
+                    break;
+            }
+        }
+    }
+}
+
+/**
+  * @brief  Plays the free table, and waits until the other one is no more
+  *         read to free it.
+  * @param  None
+  * @retval None
+  */
+static void Wave_SwapTable(void)
+{
+    uint32_t halves = Wave.Blocks + Wave.Reused;
+
+    DAC_WaveSetTable(&Wave, WaveTable[FreeTable], TABLE_BITS);
+
+    /* The new table is used from the next half buffer */
+    while ((Wave.Blocks + Wave.Reused) == halves)
+    {
+    }
+
+    FreeTable = !FreeTable;
+}
+
+/**
+  * @brief  PrecConfiguration: configure PA4 in analog,
+  *         enable DAC clock, enable DMA1 clock
+  * @param  None
+  * @retval None
+  */
+static void DAC_Config(void)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+
+    /* DMA clock enable (to be used with DAC) */
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA, ENABLE);
+
+    /* DAC Periph clock enable */
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_DAC, ENABLE);
+
+    /* GPIOA clock enable */
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_GPIOA, ENABLE);
+
+    /* Configure PA.04 (DAC_OUT) as analog */
+    GPIO_StructInit(&GPIO_InitStructure);
+    GPIO_InitStructure.GPIO_Pin =  GPIO_Pin_4;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AN;
+    GPIO_Init(GPIOA, &GPIO_InitStructure);
+}
+
+/**
+  * @brief  TIM2 Configuration: TRGO at SAMPLE_RATE
+  * @param  None
+  * @retval None
+  */
+static void TIM_Config(void)
+{
+    TIM_TimeBaseInitTypeDef    TIM_TimeBaseStructure;
+
+    /* TIM2 Periph clock enable */
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM2, ENABLE);
+
+    /* Time base configuration */
+    TIM_TimeBaseStructInit(&TIM_TimeBaseStructure);
+    TIM_TimeBaseStructure.TIM_Period = SystemCoreClock / SAMPLE_RATE - 1;
+    TIM_TimeBaseStructure.TIM_Prescaler = 0x0;
+    TIM_TimeBaseStructure.TIM_ClockDivision = 0x0;
+    TIM_TimeBaseStructure.TIM_CounterMode = TIM_CounterMode_Up;
+    TIM_TimeBaseInit(TIM2, &TIM_TimeBaseStructure);
+
+    /* TIM2 TRGO selection */
+    TIM_SelectOutputTrigger(TIM2, TIM_TRGOSource_Update);
+
+    /* TIM2 enable counter */
+    TIM_Cmd(TIM2, ENABLE);
+}
+
+#ifdef  USE_FULL_ASSERT
+
+/**
+  * @brief  Reports the name of the source file and the source line number
+  *         where the assert_param error has occurred.
+  * @param  file: pointer to the source file name
+  * @param  line: assert_param error line source number
+  * @retval None
+  */
+void assert_failed(uint8_t* file, uint32_t line)
+{
+    /* User can add his own implementation to report the file name and line number,
+       ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
+
+    /* Infinite loop */
+    while (1)
+    {
+    }
+}
+#endif
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
@@ -23,9 +23,18 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+#define BENCH_COUNT      64
+
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+static uint32_t BenchDividend[BENCH_COUNT];
+static uint32_t BenchDivisor[BENCH_COUNT];
+static uint32_t BenchQuotient[BENCH_COUNT];
+static uint32_t BenchSoftQuotient[BENCH_COUNT];
+
 /* Private function prototypes -----------------------------------------------*/
+static void DVSQ_Benchmark(void);
+
 /* Private functions ---------------------------------------------------------*/
 
 /**
@@ -79,18 +88,22 @@ int main(void)
 
         /* Unsigned division operation */
         result_div = DVSQ_UDivsion(dividend, divisor, &remainder);
-        printf("\n\r [Unsigned division] %d/%d=%d...%d\n\r", dividend, divisor, result_div, remainder);
+        printf("\n\r [Unsigned division] %lu/%lu=%lu...%lu\n\r", (unsigned long)dividend, (unsigned long)divisor,
+               (unsigned long)result_div, (unsigned long)remainder);
 
         /* Square root operation */
         result_sqr = DVSQ_Sqrt(dividend);
-        printf("\n\r [Square root] Suare(%d)=%d\n\r", dividend, result_sqr);
+        printf("\n\r [Square root] Suare(%lu)=%lu\n\r", (unsigned long)dividend, (unsigned long)result_sqr);
 
         /* High precision square root operation */
         result_sqr = DVSQ_SqrtH(dividend, &result_sqr_fraction);
 
         /* Fractional Part */
         fraction = (float)result_sqr_fraction / 65536;
-        printf("\n\r [Square root High precision] Suare(%d)=%f\n\r", dividend, (float)(result_sqr + fraction));
+        printf("\n\r [Square root High precision] Suare(%lu)=%f\n\r", (unsigned long)dividend, (double)(result_sqr + fraction));
+
+        /* Compare DVSQ with the software division and model */
+        DVSQ_Benchmark();
     }
 
     /* Infinite loop */
@@ -100,6 +113,73 @@ int main(void)
 }
 
 
+/**
+  * @brief  Measure BENCH_COUNT unsigned divisions done by DVSQ_UDivsionVector()
+  *         and by the C library (__aeabi_uidiv on Cortex-M0), and check the
+  *         DVSQ square roots against the software model.
+  * @note   The cycles are counted by SysTick, clocked by HCLK.
+  * @retval None
+  */
+static void DVSQ_Benchmark(void)
+{
+    uint32_t i;
+    uint32_t seed = 0x12345678;
+    uint32_t start;
+    uint32_t dvsq_cycles, soft_cycles;
+    uint32_t errors = 0;
+    uint16_t fraction, model_fraction;
+
+    /* Pseudo random operands */
+    for (i = 0; i < BENCH_COUNT; i++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        BenchDividend[i] = seed;
+        BenchDivisor[i] = (seed >> (i & 31)) | 1;
+    }
+
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+
+    start = SysTick->VAL;
+    DVSQ_UDivsionVector(BenchDividend, BenchDivisor, BenchQuotient, NULL, BENCH_COUNT);
+    dvsq_cycles = (start - SysTick->VAL) & SysTick_LOAD_RELOAD_Msk;
+
+    start = SysTick->VAL;
+
+    for (i = 0; i < BENCH_COUNT; i++)
+    {
+        BenchSoftQuotient[i] = BenchDividend[i] / BenchDivisor[i];
+    }
+
+    soft_cycles = (start - SysTick->VAL) & SysTick_LOAD_RELOAD_Msk;
+
+    SysTick->CTRL = 0;
+
+    for (i = 0; i < BENCH_COUNT; i++)
+    {
+        if (BenchQuotient[i] != BenchSoftQuotient[i])
+        {
+            errors++;
+        }
+
+        if (DVSQ_Sqrt(BenchDividend[i]) != DVSQ_ModelSqrt(BenchDividend[i]))
+        {
+            errors++;
+        }
+
+        if ((DVSQ_SqrtH(BenchDividend[i], &fraction) != DVSQ_ModelSqrtH(BenchDividend[i], &model_fraction))
+                || (fraction != model_fraction))
+        {
+            errors++;
+        }
+    }
+
+    printf("\n\r [Benchmark] %u divisions: DVSQ %lu cycles, software %lu cycles\n\r",
+           (unsigned int)BENCH_COUNT, (unsigned long)dvsq_cycles, (unsigned long)soft_cycles);
+    printf("\n\r [Benchmark] %lu errors against the software results\n\r", (unsigned long)errors);
+}
+
 #ifdef  USE_FULL_ASSERT
 
 /**
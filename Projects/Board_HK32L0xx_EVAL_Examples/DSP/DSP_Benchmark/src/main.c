@@ -0,0 +1,377 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  main.c
+* @brief:     Main program body
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-22
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "hk32l0xx_eval.h"
+#include "arm_math_ext.h"
+#include "arm_common_tables.h"
+/** @addtogroup HK32L0xx_StdPeriph_Examples
+  * @{
+  */
+
+/** @addtogroup DSP_Benchmark
+  * @{
+  */
+
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define BLOCK_SIZE          64      /* Samples per filter call */
+#define FIR_TAPS            32
+#define BIQUAD_STAGES       2
+#define FFT_LEN             256     /* Real FFT length */
+#define SIGNAL_BIN          8       /* Bin of the test tone */
+#define SQRT_COUNT          64
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static q15_t Signal_q15[FFT_LEN];
+static q31_t Signal_q31[FFT_LEN];
+static q15_t Work_q15[FFT_LEN];
+static q31_t Work_q31[FFT_LEN];
+static q15_t Out_q15[2 * FFT_LEN];
+static q31_t Out_q31[2 * FFT_LEN];
+
+static q15_t FirCoeffs_q15[FIR_TAPS];
+static q31_t FirCoeffs_q31[FIR_TAPS];
+static q15_t FirState_q15[FIR_TAPS + BLOCK_SIZE - 1];
+static q31_t FirState_q31[FIR_TAPS + BLOCK_SIZE - 1];
+
+/* Two second order lowpass sections, coefficients divided by 2 (postShift 1):
+   {b0, 0, b1, b2, a1, a2} for Q15, {b0, b1, b2, a1, a2} for Q31 */
+static q15_t BiquadCoeffs_q15[6 * BIQUAD_STAGES] =
+{
+    1106, 0, 2212, 1106, 18727, -6763,
+    3277, 0, 6554, 3277, 6054, -3208
+};
+static q31_t BiquadCoeffs_q31[5 * BIQUAD_STAGES] =
+{
+    72477573, 144955146, 72477573, 1227286905, -443240625,
+    214748365, 429496730, 214748365, 396747604, -210238649
+};
+static q15_t BiquadState_q15[4 * BIQUAD_STAGES];
+static q31_t BiquadState_q31[4 * BIQUAD_STAGES];
+
+static q15_t AverageState_q15[16];
+
+/* Private function prototypes -----------------------------------------------*/
+static void DSP_SignalInit(void);
+static void DSP_Benchmark(void);
+static uint32_t Bench_Start(void);
+static uint32_t Bench_Stop(uint32_t Start);
+static void Bench_Print(const char* Name, uint32_t Cycles, uint32_t Samples);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Main program.
+  * @param  None
+  * @retval None
+  */
+int main(void)
+{
+    /*!< At this stage the microcontroller clock setting is already configured,
+         this is done through SystemInit() function which is called from startup
+         file (startup_hk32l0xx.s) before to branch to application main.
+         To reconfigure the default setting of SystemInit() function, refer to
+         system_hk32l0xx.c file
+       */
+    USART_InitTypeDef USART_InitStructure;
+
+    /* USARTx configured as follow:
+          - BaudRate = 115200 baud
+          - Word Length = 8 Bits
+          - One Stop Bit
+          - No parity
+          - Hardware flow control disabled (RTS and CTS signals)
+          - Receive and transmit enabled
+    */
+    USART_InitStructure.USART_BaudRate = 115200;
+    USART_InitStructure.USART_WordLength = USART_WordLength_8b;
+    USART_InitStructure.USART_StopBits = USART_StopBits_1;
+    USART_InitStructure.USART_Parity = USART_Parity_No;
+    USART_InitStructure.USART_HardwareFlowControl = USART_HardwareFlowControl_None;
+    USART_InitStructure.USART_Mode = USART_Mode_Rx | USART_Mode_Tx;
+    HK_EVAL_COMInit(COM1, &USART_InitStructure);
+    HK_EVAL_LEDInit(LED1);
+
+    /* Configure LEDs */
+    HK_EVAL_LEDOn(LED1);
+
+    /* Output a message on Hyperterminal using printf function */
+    printf("\n\r  *********************** DSP Benchmark Example ***********************\n\r");
+
+#if defined(ARM_MATH_DVSQ)
+    /* Divisions and square roots of the library on DVSQ */
+    DVSQ_Init();
+    printf("\n\r [Build] ARM_MATH_DVSQ: divisions and square roots on DVSQ\n\r");
+#else
+    printf("\n\r [Build] divisions and square roots in software\n\r");
+#endif
+
+    DSP_SignalInit();
+    DSP_Benchmark();
+
+    /* Infinite loop */
+    while (1)
+    {
+    }
+}
+
+/**
+  * @brief  Builds the test signal, a tone of amplitude 1/2 on bin SIGNAL_BIN
+  *         of the real FFT plus a small pseudo random noise, and the FIR
+  *         coefficients, a 32 taps moving sum scaled by 1/32.
+  * @note   The tone is read from the twiddle table of the FFT, entry k
+  *         holding sin(2 x pi x k / 256) for k below 192.
+  * @retval None
+  */
+static void DSP_SignalInit(void)
+{
+    uint32_t i;
+    uint32_t k;
+    uint32_t seed = 0x12345678;
+    q31_t sample;
+
+    for (i = 0; i < FFT_LEN; i++)
+    {
+        k = (i * SIGNAL_BIN * (256u / FFT_LEN)) & 0xFFu;
+
+        /* sin(x) = -sin(x - pi) */
+        if (k < 128u)
+        {
+            sample = twiddleCoef_256_q15[(2u * k) + 1u];
+        }
+        else
+        {
+            sample = -twiddleCoef_256_q15[(2u * (k - 128u)) + 1u];
+        }
+
+        seed = seed * 1664525 + 1013904223;
+        sample = (sample >> 1) + ((q31_t)seed >> 24);
+
+        Signal_q15[i] = (q15_t)sample;
+        Signal_q31[i] = sample << 16;
+    }
+
+    for (i = 0; i < FIR_TAPS; i++)
+    {
+        FirCoeffs_q15[i] = 0x7FFF / FIR_TAPS;
+        FirCoeffs_q31[i] = 0x7FFFFFFF / FIR_TAPS;
+    }
+}
+
+/**
+  * @brief  Measures the kernels of the DSP library on the test signal and
+  *         prints the cycles of each call and per sample.
+  * @note   The cycles are counted by SysTick, clocked by HCLK. The real FFT
+  *         overwrites its input, so each FFT runs on a copy of the signal.
+  * @retval None
+  */
+static void DSP_Benchmark(void)
+{
+    arm_fir_instance_q15 fir_q15;
+    arm_fir_instance_q31 fir_q31;
+    arm_biquad_casd_df1_inst_q15 biquad_q15;
+    arm_biquad_casd_df1_inst_q31 biquad_q31;
+    arm_moving_average_instance_q15 average_q15;
+    arm_rfft_instance_q15 rfft_q15;
+    arm_rfft_instance_q31 rfft_q31;
+    uint32_t start;
+    uint32_t i;
+    uint32_t index;
+    q15_t value_q15;
+    q31_t value_q31;
+    q31_t magnitude;
+    q31_t peak = 0;
+    uint32_t peak_bin = 0;
+
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+
+    /* Filters */
+    arm_fir_init_q15(&fir_q15, FIR_TAPS, FirCoeffs_q15, FirState_q15, BLOCK_SIZE);
+    start = Bench_Start();
+    arm_fir_q15(&fir_q15, Signal_q15, Out_q15, BLOCK_SIZE);
+    Bench_Print("arm_fir_q15, 32 taps", Bench_Stop(start), BLOCK_SIZE);
+
+    arm_fir_init_q31(&fir_q31, FIR_TAPS, FirCoeffs_q31, FirState_q31, BLOCK_SIZE);
+    start = Bench_Start();
+    arm_fir_q31(&fir_q31, Signal_q31, Out_q31, BLOCK_SIZE);
+    Bench_Print("arm_fir_q31, 32 taps", Bench_Stop(start), BLOCK_SIZE);
+
+    arm_biquad_cascade_df1_init_q15(&biquad_q15, BIQUAD_STAGES, BiquadCoeffs_q15, BiquadState_q15, 1);
+    start = Bench_Start();
+    arm_biquad_cascade_df1_q15(&biquad_q15, Signal_q15, Out_q15, BLOCK_SIZE);
+    Bench_Print("arm_biquad_cascade_df1_q15, 2 stages", Bench_Stop(start), BLOCK_SIZE);
+
+    arm_biquad_cascade_df1_init_q31(&biquad_q31, BIQUAD_STAGES, BiquadCoeffs_q31, BiquadState_q31, 1);
+    start = Bench_Start();
+    arm_biquad_cascade_df1_q31(&biquad_q31, Signal_q31, Out_q31, BLOCK_SIZE);
+    Bench_Print("arm_biquad_cascade_df1_q31, 2 stages", Bench_Stop(start), BLOCK_SIZE);
+
+    arm_moving_average_init_q15(&average_q15, 16, AverageState_q15);
+    start = Bench_Start();
+    arm_moving_average_q15(&average_q15, Signal_q15, Out_q15, BLOCK_SIZE);
+    Bench_Print("arm_moving_average_q15, 16 samples", Bench_Stop(start), BLOCK_SIZE);
+
+    arm_moving_average_init_q15(&average_q15, 10, AverageState_q15);
+    start = Bench_Start();
+    arm_moving_average_q15(&average_q15, Signal_q15, Out_q15, BLOCK_SIZE);
+    Bench_Print("arm_moving_average_q15, 10 samples", Bench_Stop(start), BLOCK_SIZE);
+
+    /* Statistics */
+    start = Bench_Start();
+    arm_mean_q15(Signal_q15, FFT_LEN, &value_q15);
+    Bench_Print("arm_mean_q15", Bench_Stop(start), FFT_LEN);
+
+    start = Bench_Start();
+    arm_rms_q15(Signal_q15, FFT_LEN, &value_q15);
+    Bench_Print("arm_rms_q15", Bench_Stop(start), FFT_LEN);
+    printf("    rms %d, expected about 11585 (0.5 / sqrt(2))\n\r", value_q15);
+
+    start = Bench_Start();
+    arm_rms_q31(Signal_q31, FFT_LEN, &value_q31);
+    Bench_Print("arm_rms_q31", Bench_Stop(start), FFT_LEN);
+
+    start = Bench_Start();
+    arm_max_q15(Signal_q15, FFT_LEN, &value_q15, &index);
+    Bench_Print("arm_max_q15", Bench_Stop(start), FFT_LEN);
+
+    start = Bench_Start();
+
+    for (i = 0; i < SQRT_COUNT; i++)
+    {
+        arm_sqrt_q15((q15_t)(i << 9), &value_q15);
+    }
+
+    Bench_Print("arm_sqrt_q15", Bench_Stop(start), SQRT_COUNT);
+
+    start = Bench_Start();
+
+    for (i = 0; i < SQRT_COUNT; i++)
+    {
+        arm_sqrt_q31((q31_t)(i << 25), &value_q31);
+    }
+
+    Bench_Print("arm_sqrt_q31", Bench_Stop(start), SQRT_COUNT);
+
+    /* Transforms */
+    arm_rfft_init_q15(&rfft_q15, FFT_LEN, 0, 1);
+
+    for (i = 0; i < FFT_LEN; i++)
+    {
+        Work_q15[i] = Signal_q15[i];
+    }
+
+    start = Bench_Start();
+    arm_rfft_q15(&rfft_q15, Work_q15, Out_q15);
+    Bench_Print("arm_rfft_q15, 256 points", Bench_Stop(start), FFT_LEN);
+
+    /* Largest |Re| + |Im| of the first half of the spectrum */
+    for (i = 1; i < (FFT_LEN / 2); i++)
+    {
+        magnitude = Out_q15[2 * i];
+        magnitude = (magnitude < 0) ? -magnitude : magnitude;
+        magnitude += (Out_q15[(2 * i) + 1] < 0) ? -Out_q15[(2 * i) + 1] : Out_q15[(2 * i) + 1];
+
+        if (magnitude > peak)
+        {
+            peak = magnitude;
+            peak_bin = i;
+        }
+    }
+
+    printf("    peak on bin %d, expected %d\n\r", peak_bin, SIGNAL_BIN);
+
+    arm_rfft_init_q31(&rfft_q31, FFT_LEN, 0, 1);
+
+    for (i = 0; i < FFT_LEN; i++)
+    {
+        Work_q31[i] = Signal_q31[i];
+    }
+
+    start = Bench_Start();
+    arm_rfft_q31(&rfft_q31, Work_q31, Out_q31);
+    Bench_Print("arm_rfft_q31, 256 points", Bench_Stop(start), FFT_LEN);
+
+    /* Inverse transform of the Q15 spectrum */
+    arm_rfft_init_q15(&rfft_q15, FFT_LEN, 1, 1);
+    start = Bench_Start();
+    arm_rfft_q15(&rfft_q15, Out_q15, Work_q15);
+    Bench_Print("arm_rfft_q15 inverse, 256 points", Bench_Stop(start), FFT_LEN);
+
+    SysTick->CTRL = 0;
+}
+
+/**
+  * @brief  Reads SysTick at the start of a measure.
+  * @retval SysTick current value
+  */
+static uint32_t Bench_Start(void)
+{
+    return SysTick->VAL;
+}
+
+/**
+  * @brief  Cycles since Bench_Start(), SysTick counting down on 24 bits.
+  * @param  Start: value returned by Bench_Start().
+  * @retval Elapsed HCLK cycles
+  */
+static uint32_t Bench_Stop(uint32_t Start)
+{
+    return (Start - SysTick->VAL) & SysTick_LOAD_RELOAD_Msk;
+}
+
+/**
+  * @brief  Prints the cycles of a kernel, in total and per sample.
+  * @param  Name: name of the kernel.
+  * @param  Cycles: HCLK cycles of the call.
+  * @param  Samples: samples processed by the call.
+  * @retval None
+  */
+static void Bench_Print(const char* Name, uint32_t Cycles, uint32_t Samples)
+{
+    printf("\n\r [Benchmark] %s: %d cycles, %d cycles/sample\n\r", Name, Cycles, Cycles / Samples);
+}
+
+#ifdef  USE_FULL_ASSERT
+
+/**
+  * @brief  Reports the name of the source file and the source line number
+  *         where the assert_param error has occurred.
+  * @param  file: pointer to the source file name
+  * @param  line: assert_param error line source number
+  * @retval None
+  */
+void assert_failed(uint8_t* file, uint32_t line)
+{
+    /* User can add his own implementation to report the file name and line number,
+       ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
+
+    /* Infinite loop */
+    while (1)
+    {
+    }
+}
+#endif
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+
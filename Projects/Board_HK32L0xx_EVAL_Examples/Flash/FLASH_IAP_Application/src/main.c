@@ -0,0 +1,334 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  main.c
+* @brief:     Main program body
+* @author:    AE Team
+* @version:   V1.0.0/2024-12-09
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define FLASH_HALF_PAGE_SIZE    ((uint32_t)0x00000200)   /* FLASH_HalfErasePage() unit */
+#define APP_ADDRESS             (IAP_FLASH_BASE + IAP_APP_OFFSET)
+#define VECTOR_TABLE_SRAM_ADDR  ((uint32_t)0x20000000)
+#define VECTOR_TABLE_WORDS      48                       /* 16 system + 32 peripheral vectors */
+
+/* COM port reception by circular DMA */
+#define COM_RX_DMA_CLK          RCC_AHBPeriph_DMA
+#define COM_RX_DMA_CHANNEL      DMA_Channel6
+#define COM_RX_DMA_REMAP        DMA_CSELR_CH6_UART3_RX
+#define COM_RX_BUFFER_SIZE      1024                     /* Bytes received during a chunk erase and program */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void VectorTable_Relocate(void);
+static void COM_Config(void);
+static void COM_Receive(void);
+static void COM_Send(const uint8_t* pData, uint32_t Length);
+static IAP_Status IAP_FlashErase(uint32_t Offset);
+static IAP_Status IAP_FlashProgram(uint32_t Offset, const uint32_t* pData, uint32_t NbWords);
+static void IAP_CrcInit(void);
+static void IAP_CrcUpdate(const uint8_t* pData, uint32_t Length);
+static uint32_t IAP_CrcFinal(void);
+
+/* Private variables ---------------------------------------------------------*/
+static const IAP_PortTypeDef IAP_Port =
+{
+    (const uint8_t*)IAP_FLASH_BASE,
+    IAP_APP_OFFSET,
+    IAP_STAGING_OFFSET,
+    IAP_IMAGE_SIZE,
+    IAP_RECORD_OFFSET,
+    FLASH_HALF_PAGE_SIZE,
+    IAP_FlashErase,
+    IAP_FlashProgram,
+    IAP_CrcInit,
+    IAP_CrcUpdate,
+    IAP_CrcFinal,
+    NULL,
+    COM_Send
+};
+
+/* CRC-32 (zlib) of the image */
+static CRC_ContextTypeDef CrcContext =
+{
+    0xFFFFFFFF,
+    0xFFFFFFFF,
+    ENABLE,
+    ENABLE,
+    NULL,
+    0
+};
+
+static uint8_t RxBuffer[COM_RX_BUFFER_SIZE];
+static uint32_t RxRead = 0;
+
+IAP_UpdateTypeDef Update;
+__IO IAP_State UpdateState = IAP_STATE_IDLE;
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Main program.
+  * @param  None
+  * @retval None
+  */
+int main(void)
+{
+    /*!< At this stage the microcontroller clock setting is already configured,
+         this is done through SystemInit() function which is called from startup
+         file (KEIL_Startup_hk32l0xx.s) before to branch to application main.
+         To reconfigure the default setting of SystemInit() function, refer to
+         system_hk32l0xx.c file
+       */
+
+    /* The application is started by the bootloader at APP_ADDRESS */
+    VectorTable_Relocate();
+
+    /* LED1 blinks while the application runs */
+    HK_EVAL_LEDInit(LED1);
+    HK_EVAL_LEDInit(LED2);
+    SysTick_Config(SystemCoreClock / 4);
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC, ENABLE);
+    COM_Config();
+
+    IAP_UpdateInit(&Update, &IAP_Port);
+
+    /* Infinite loop */
+    while (1)
+    {
+        /* The DMA receives the next chunk while the current one is programmed */
+        COM_Receive();
+        UpdateState = IAP_UpdateProcess(&Update);
+
+        if (UpdateState == IAP_STATE_RECEIVE)
+        {
+            HK_EVAL_LEDOn(LED2);
+        }
+        else if (UpdateState == IAP_STATE_COMMITTED)
+        {
+            /* Let the last response go out, the bootloader copies the image */
+            while (USART_GetFlagStatus(EVAL_COM1, USART_FLAG_TC) == RESET)
+            {
+            }
+
+            NVIC_SystemReset();
+        }
+        else
+        {
+            HK_EVAL_LEDOff(LED2);
+        }
+    }
+}
+
+/**
+  * @brief  Copies the vector table to SRAM and remaps SRAM at address 0.
+  * @note   The Cortex-M0 has no vector table offset register. The first
+  *         VECTOR_TABLE_WORDS words of SRAM are kept out of the linker
+  *         RAM region.
+  * @param  None
+  * @retval None
+  */
+static void VectorTable_Relocate(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < VECTOR_TABLE_WORDS; i++)
+    {
+        ((__IO uint32_t*)VECTOR_TABLE_SRAM_ADDR)[i] = ((const uint32_t*)APP_ADDRESS)[i];
+    }
+
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_SYSCFG, ENABLE);
+    SYSCFG_MemoryRemapConfig(SYSCFG_MemoryRemap_SRAM);
+}
+
+/**
+  * @brief  Configures the COM port, received by DMA in circular mode.
+  * @param  None
+  * @retval None
+  */
+static void COM_Config(void)
+{
+    USART_InitTypeDef USART_InitStructure;
+    DMA_InitTypeDef DMA_InitStructure;
+
+    USART_InitStructure.USART_BaudRate = 115200;
+    USART_InitStructure.USART_WordLength = USART_WordLength_8b;
+    USART_InitStructure.USART_StopBits = USART_StopBits_1;
+    USART_InitStructure.USART_Parity = USART_Parity_No;
+    USART_InitStructure.USART_HardwareFlowControl = USART_HardwareFlowControl_None;
+    USART_InitStructure.USART_Mode = USART_Mode_Rx | USART_Mode_Tx;
+    HK_EVAL_COMInit(COM1, &USART_InitStructure);
+
+    /* The DMA keeps receiving on overrun, a frame with lost bytes fails its CRC
+       and is sent again */
+    USART_Cmd(EVAL_COM1, DISABLE);
+    USART_OverrunDetectionConfig(EVAL_COM1, USART_OVRDetection_Disable);
+
+    RCC_AHBPeriphClockCmd(COM_RX_DMA_CLK, ENABLE);
+    DMA_DeInit(COM_RX_DMA_CHANNEL);
+    DMA_RemapConfig(DMA, COM_RX_DMA_REMAP);
+
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&EVAL_COM1->RDR;
+    DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)RxBuffer;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
+    DMA_InitStructure.DMA_BufferSize = COM_RX_BUFFER_SIZE;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Circular;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+    DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init(COM_RX_DMA_CHANNEL, &DMA_InitStructure);
+    DMA_Cmd(COM_RX_DMA_CHANNEL, ENABLE);
+
+    USART_DMACmd(EVAL_COM1, USART_DMAReq_Rx, ENABLE);
+    USART_Cmd(EVAL_COM1, ENABLE);
+}
+
+/**
+  * @brief  Delivers the bytes written by the DMA since the last call.
+  * @param  None
+  * @retval None
+  */
+static void COM_Receive(void)
+{
+    uint32_t write = COM_RX_BUFFER_SIZE - DMA_GetCurrDataCounter(COM_RX_DMA_CHANNEL);
+
+    if (write == COM_RX_BUFFER_SIZE)
+    {
+        write = 0;
+    }
+
+    if (write < RxRead)
+    {
+        IAP_UpdateReceive(&Update, &RxBuffer[RxRead], COM_RX_BUFFER_SIZE - RxRead);
+        RxRead = 0;
+    }
+
+    if (write > RxRead)
+    {
+        IAP_UpdateReceive(&Update, &RxBuffer[RxRead], write - RxRead);
+        RxRead = write;
+    }
+}
+
+/**
+  * @brief  Sends a response on the COM port.
+  * @param  pData: bytes to send.
+  * @param  Length: number of bytes.
+  * @retval None
+  */
+static void COM_Send(const uint8_t* pData, uint32_t Length)
+{
+    while (Length-- != 0)
+    {
+        while (USART_GetFlagStatus(EVAL_COM1, USART_FLAG_TXE) == RESET)
+        {
+        }
+
+        USART_SendData(EVAL_COM1, *pData++);
+    }
+}
+
+/**
+  * @brief  Erases a half page.
+  * @param  Offset: half page offset from IAP_FLASH_BASE.
+  * @retval IAP_OK or IAP_FLASH_ERROR.
+  */
+static IAP_Status IAP_FlashErase(uint32_t Offset)
+{
+    FLASH_Status status;
+
+    FLASH_Unlock();
+    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPERR | FLASH_FLAG_SIZE_ERR);
+    status = FLASH_HalfErasePage(IAP_FLASH_BASE + Offset);
+    FLASH_Lock();
+
+    return (status == FLASH_COMPLETE) ? IAP_OK : IAP_FLASH_ERROR;
+}
+
+/**
+  * @brief  Programs words, WPG is kept set for the whole buffer.
+  * @note   FLASH_ProgramBuffer() runs from SRAM: its .RamFunc section is
+  *         placed in RW_IRAM1 by HK32L0xx_IAP_Application.sct (MDK-ARM).
+  * @param  Offset: word offset from IAP_FLASH_BASE.
+  * @param  pData: words to program.
+  * @param  NbWords: number of words.
+  * @retval IAP_OK or IAP_FLASH_ERROR.
+  */
+static IAP_Status IAP_FlashProgram(uint32_t Offset, const uint32_t* pData, uint32_t NbWords)
+{
+    FLASH_Status status;
+
+    FLASH_Unlock();
+    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPERR | FLASH_FLAG_SIZE_ERR);
+    status = FLASH_ProgramBuffer(IAP_FLASH_BASE + Offset, pData, NbWords);
+    FLASH_Lock();
+
+    return (status == FLASH_COMPLETE) ? IAP_OK : IAP_FLASH_ERROR;
+}
+
+/**
+  * @brief  Starts the image CRC.
+  * @param  None
+  * @retval None
+  */
+static void IAP_CrcInit(void)
+{
+    CRC_StreamInit(&CrcContext);
+}
+
+/**
+  * @brief  Adds bytes to the image CRC.
+  * @param  pData: bytes to add.
+  * @param  Length: number of bytes.
+  * @retval None
+  */
+static void IAP_CrcUpdate(const uint8_t* pData, uint32_t Length)
+{
+    CRC_StreamUpdate(&CrcContext, pData, Length);
+}
+
+/**
+  * @brief  Returns the image CRC.
+  * @param  None
+  * @retval CRC-32.
+  */
+static uint32_t IAP_CrcFinal(void)
+{
+    return CRC_StreamFinal(&CrcContext);
+}
+
+#ifdef  USE_FULL_ASSERT
+
+/**
+  * @brief  Reports the name of the source file and the source line number
+  *         where the assert_param error has occurred.
+  * @param  file: pointer to the source file name
+  * @param  line: assert_param error line source number
+  * @retval None
+  */
+void assert_failed(uint8_t* file, uint32_t line)
+{
+    /* User can add his own implementation to report the file name and line number,
+       ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
+
+    /* Infinite loop */
+    while (1)
+    {
+    }
+}
+#endif
+
+/**
+  * @}
+  */
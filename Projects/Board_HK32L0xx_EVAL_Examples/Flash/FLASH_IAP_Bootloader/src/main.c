@@ -0,0 +1,248 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  main.c
+* @brief:     Main program body
+* @author:    AE Team
+* @version:   V1.0.0/2024-12-09
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef void (*pFunction)(void);
+
+/* Private define ------------------------------------------------------------*/
+#define FLASH_HALF_PAGE_SIZE    ((uint32_t)0x00000200)   /* FLASH_HalfErasePage() unit */
+#define APP_ADDRESS             (IAP_FLASH_BASE + IAP_APP_OFFSET)
+#define SRAM_START_ADDR         ((uint32_t)0x20000000)
+#define SRAM_END_ADDR           ((uint32_t)0x20005000)
+#define BOOT_UPDATE_TRIALS      3
+
+/* Private macro -------------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static IAP_Status IAP_FlashErase(uint32_t Offset);
+static IAP_Status IAP_FlashProgram(uint32_t Offset, const uint32_t* pData, uint32_t NbWords);
+static void IAP_CrcInit(void);
+static void IAP_CrcUpdate(const uint8_t* pData, uint32_t Length);
+static uint32_t IAP_CrcFinal(void);
+static uint8_t Boot_ApplicationIsValid(void);
+static void Boot_JumpToApplication(void);
+
+/* Private variables ---------------------------------------------------------*/
+static const IAP_PortTypeDef IAP_Port =
+{
+    (const uint8_t*)IAP_FLASH_BASE,
+    IAP_APP_OFFSET,
+    IAP_STAGING_OFFSET,
+    IAP_IMAGE_SIZE,
+    IAP_RECORD_OFFSET,
+    FLASH_HALF_PAGE_SIZE,
+    IAP_FlashErase,
+    IAP_FlashProgram,
+    IAP_CrcInit,
+    IAP_CrcUpdate,
+    IAP_CrcFinal,
+    NULL,
+    NULL
+};
+
+/* CRC-32 (zlib) of the images */
+static CRC_ContextTypeDef CrcContext =
+{
+    0xFFFFFFFF,
+    0xFFFFFFFF,
+    ENABLE,
+    ENABLE,
+    NULL,
+    0
+};
+
+__IO IAP_Status UpdateStatus = IAP_NO_UPDATE;
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Main program.
+  * @param  None
+  * @retval None
+  */
+int main(void)
+{
+    uint32_t trial;
+
+    /*!< At this stage the microcontroller clock setting is already configured,
+         this is done through SystemInit() function which is called from startup
+         file (KEIL_Startup_hk32l0xx.s) before to branch to application main.
+         To reconfigure the default setting of SystemInit() function, refer to
+         system_hk32l0xx.c file
+       */
+
+    HK_EVAL_LEDInit(LED1);
+    HK_EVAL_LEDInit(LED2);
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC, ENABLE);
+
+    /* Copy a committed image. A copy interrupted by a reset restarts here,
+       the application is started only once its CRC matches */
+    if (IAP_BootPending(&IAP_Port) != 0)
+    {
+        HK_EVAL_LEDOn(LED1);
+
+        for (trial = 0; trial < BOOT_UPDATE_TRIALS; trial++)
+        {
+            UpdateStatus = IAP_BootUpdate(&IAP_Port);
+
+            if (UpdateStatus != IAP_FLASH_ERROR)
+            {
+                break;
+            }
+        }
+
+        HK_EVAL_LEDOff(LED1);
+    }
+
+    if ((UpdateStatus != IAP_FLASH_ERROR) && (Boot_ApplicationIsValid() != 0))
+    {
+        Boot_JumpToApplication();
+    }
+
+    /* No application to start: LED2 blinks */
+    SysTick_Config(SystemCoreClock / 10);
+
+    while (1)
+    {
+        __WFI();
+    }
+}
+
+/**
+  * @brief  Checks the vector table of the application.
+  * @param  None
+  * @retval 1 if the stack pointer and the reset handler are in range, 0 otherwise.
+  */
+static uint8_t Boot_ApplicationIsValid(void)
+{
+    const uint32_t* vectors = (const uint32_t*)APP_ADDRESS;
+
+    return (uint8_t)((vectors[0] > SRAM_START_ADDR) && (vectors[0] <= SRAM_END_ADDR) &&
+                     ((vectors[1] & 1) != 0) &&
+                     (vectors[1] > APP_ADDRESS) && (vectors[1] < APP_ADDRESS + IAP_IMAGE_SIZE));
+}
+
+/**
+  * @brief  Starts the application with the reset state of the used peripherals.
+  * @note   The application copies its vector table to SRAM and remaps SRAM at
+  *         address 0, the Cortex-M0 has no vector table offset register.
+  * @param  None
+  * @retval None
+  */
+static void Boot_JumpToApplication(void)
+{
+    const uint32_t* vectors = (const uint32_t*)APP_ADDRESS;
+    pFunction reset = (pFunction)vectors[1];
+
+    CRC_DeInit();
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC, DISABLE);
+    HK_EVAL_LEDOff(LED1);
+    HK_EVAL_LEDOff(LED2);
+
+    __set_MSP(vectors[0]);
+    reset();
+}
+
+/**
+  * @brief  Erases a half page.
+  * @param  Offset: half page offset from IAP_FLASH_BASE.
+  * @retval IAP_OK or IAP_FLASH_ERROR.
+  */
+static IAP_Status IAP_FlashErase(uint32_t Offset)
+{
+    FLASH_Status status;
+
+    FLASH_Unlock();
+    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPERR | FLASH_FLAG_SIZE_ERR);
+    status = FLASH_HalfErasePage(IAP_FLASH_BASE + Offset);
+    FLASH_Lock();
+
+    return (status == FLASH_COMPLETE) ? IAP_OK : IAP_FLASH_ERROR;
+}
+
+/**
+  * @brief  Programs words, WPG is kept set for the whole buffer.
+  * @note   FLASH_ProgramBuffer() runs from SRAM: its .RamFunc section is
+  *         placed in RW_IRAM1 by HK32L0xx_IAP_Bootloader.sct (MDK-ARM).
+  * @param  Offset: word offset from IAP_FLASH_BASE.
+  * @param  pData: words to program, may be in FLASH.
+  * @param  NbWords: number of words.
+  * @retval IAP_OK or IAP_FLASH_ERROR.
+  */
+static IAP_Status IAP_FlashProgram(uint32_t Offset, const uint32_t* pData, uint32_t NbWords)
+{
+    FLASH_Status status;
+
+    FLASH_Unlock();
+    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPERR | FLASH_FLAG_SIZE_ERR);
+    status = FLASH_ProgramBuffer(IAP_FLASH_BASE + Offset, pData, NbWords);
+    FLASH_Lock();
+
+    return (status == FLASH_COMPLETE) ? IAP_OK : IAP_FLASH_ERROR;
+}
+
+/**
+  * @brief  Starts an image CRC.
+  * @param  None
+  * @retval None
+  */
+static void IAP_CrcInit(void)
+{
+    CRC_StreamInit(&CrcContext);
+}
+
+/**
+  * @brief  Adds bytes to the image CRC.
+  * @param  pData: bytes to add.
+  * @param  Length: number of bytes.
+  * @retval None
+  */
+static void IAP_CrcUpdate(const uint8_t* pData, uint32_t Length)
+{
+    CRC_StreamUpdate(&CrcContext, pData, Length);
+}
+
+/**
+  * @brief  Returns the image CRC.
+  * @param  None
+  * @retval CRC-32.
+  */
+static uint32_t IAP_CrcFinal(void)
+{
+    return CRC_StreamFinal(&CrcContext);
+}
+
+#ifdef  USE_FULL_ASSERT
+
+/**
+  * @brief  Reports the name of the source file and the source line number
+  *         where the assert_param error has occurred.
+  * @param  file: pointer to the source file name
+  * @param  line: assert_param error line source number
+  * @retval None
+  */
+void assert_failed(uint8_t* file, uint32_t line)
+{
+    /* User can add his own implementation to report the file name and line number,
+       ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
+
+    /* Infinite loop */
+    while (1)
+    {
+    }
+}
+#endif
+
+/**
+  * @}
+  */
@@ -0,0 +1,104 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  kv_store.h
+* @brief:     Header for kv_store.c file.
+* @author:    AE Team
+*******************************************************************************/
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __KV_STORE_H
+#define __KV_STORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "hk32l0xx.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* Largest number of page sets of a store */
+#ifndef KVSTORE_MAX_SETS
+#define KVSTORE_MAX_SETS            4
+#endif
+
+/* Largest value length, in bytes */
+#define KVSTORE_MAX_LENGTH          254
+
+/* Reserved key, never stored */
+#define KVSTORE_KEY_INVALID         ((uint16_t)0xFFFF)
+
+/* Exported types ------------------------------------------------------------*/
+/**
+  * @brief  Store operation status
+  */
+typedef enum
+{
+    KVSTORE_OK           = 0,   /*!< Operation done */
+    KVSTORE_NOT_FOUND    = 1,   /*!< Key not stored */
+    KVSTORE_NO_SPACE     = 2,   /*!< Live data or index full */
+    KVSTORE_FLASH_ERROR  = 3,   /*!< Program or erase failed */
+    KVSTORE_INVALID      = 4    /*!< Invalid parameter or geometry */
+} KVStore_Status;
+
+/**
+  * @brief  Flash access of a store.
+  * @note   The store area is NbSets page sets of SetSize bytes, read through
+  *         pArea and written through the callbacks. Offsets are in bytes from
+  *         the start of the area. Program must only clear bits of an erased
+  *         word, EraseHalfPage sets HalfPageSize bytes to 0xFF.
+  */
+typedef struct
+{
+    const uint32_t* pArea;      /*!< Memory mapped store area, word aligned */
+    uint32_t SetSize;           /*!< Bytes per page set, multiple of HalfPageSize */
+    uint32_t HalfPageSize;      /*!< Smallest erasable unit, in bytes */
+    uint8_t NbSets;             /*!< Number of page sets, 2 to KVSTORE_MAX_SETS */
+    KVStore_Status (*Program)(uint32_t Offset, uint32_t Data);  /*!< Programs one word */
+    KVStore_Status (*EraseHalfPage)(uint32_t Offset);           /*!< Erases one half page */
+} KVStore_FlashTypeDef;
+
+/**
+  * @brief  Key/value store: an append-only record log in the active page set,
+  *         with a RAM index of the live records.
+  */
+typedef struct
+{
+    const KVStore_FlashTypeDef* pFlash;     /*!< Flash access */
+    uint32_t* pIndex;                       /*!< Index slots: key << 16 | record word offset */
+    uint32_t IndexSize;                     /*!< Number of index slots, power of two */
+    uint32_t NbKeys;                        /*!< Live keys */
+    uint8_t Active;                         /*!< Page set holding the log */
+    uint32_t Sequence;                      /*!< Generation of the active page set */
+    uint32_t Free;                          /*!< Word offset of the first free word in the log */
+    uint32_t SetWords;                      /*!< Words per page set */
+    uint32_t Wear[KVSTORE_MAX_SETS];        /*!< Erase count of each page set */
+    uint16_t EraseLeft[KVSTORE_MAX_SETS];   /*!< Half pages still to erase, 0 if none */
+    uint8_t Spare[KVSTORE_MAX_SETS];        /*!< Page set erased and ready for a copy */
+    uint32_t UserBytes;                     /*!< Value bytes written by the application */
+    uint32_t ProgramWords;                  /*!< Words programmed, records and copies */
+    uint32_t HalfPageErases;                /*!< Half page erases */
+    uint32_t Compactions;                   /*!< Garbage collections */
+    uint32_t MountWords;                    /*!< Words read by the last KVStore_Mount() */
+} KVStore_TypeDef;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+KVStore_Status KVStore_Mount(KVStore_TypeDef* Store, const KVStore_FlashTypeDef* pFlash,
+                             uint32_t* pIndex, uint32_t IndexSize);
+KVStore_Status KVStore_Read(KVStore_TypeDef* Store, uint16_t Key, uint8_t* pData, uint32_t Size,
+                            uint32_t* pLength);
+KVStore_Status KVStore_Write(KVStore_TypeDef* Store, uint16_t Key, const uint8_t* pData, uint32_t Length);
+KVStore_Status KVStore_Delete(KVStore_TypeDef* Store, uint16_t Key);
+KVStore_Status KVStore_Compact(KVStore_TypeDef* Store);
+KVStore_Status KVStore_Maintain(KVStore_TypeDef* Store, uint32_t* pPending);
+uint32_t KVStore_GetFree(KVStore_TypeDef* Store);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*__KV_STORE_H */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -0,0 +1,979 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  kv_store.c
+* @brief:     Wear levelled key/value store over internal flash page sets.
+*             ===================================================================
+*             The store area is split in page sets. One set holds the record
+*             log, the others are erased spares. Each set starts with a four
+*             word header, programmed in this order:
+*               word 0: KVSTORE_MAGIC       once the set is erased
+*               word 1: erase count         with the magic
+*               word 2: sequence number     when a compaction starts copying
+*               word 3: KVSTORE_ACTIVE      when the copy is complete
+*             Records are appended after the header and never overwritten:
+*               header: key (bits 15:0), length (bits 23:16, 0xFF for a
+*                       deleted key), check byte (bits 31:24)
+*               data:   value bytes, padded with 0xFF to a word
+*               footer: CRC-16/CCITT of the header and data words (bits 15:0),
+*                       key (bits 31:16)
+*             The footer is programmed last, a record whose footer does not
+*             match is ignored, so an interrupted write keeps the old value.
+*             When the log is full the live records are copied to the spare
+*             with the lowest erase count, which becomes active once its
+*             KVSTORE_ACTIVE word is programmed. The old set is then erased
+*             half page by half page from KVStore_Maintain(), its header half
+*             page last, so every state left by a power failure is recognized
+*             by KVStore_Mount().
+*             The module does not access the FLASH registers, the flash is
+*             reached through a KVStore_FlashTypeDef.
+*             ===================================================================
+* @author:    AE Team
+* @version:   V1.0.0/2024-12-02
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "kv_store.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define KVSTORE_MAGIC               ((uint32_t)0x4B565331)  /* "KVS1" */
+#define KVSTORE_ACTIVE              ((uint32_t)0x41435456)  /* "ACTV" */
+#define KVSTORE_ERASED              ((uint32_t)0xFFFFFFFF)
+
+/* Page set header */
+#define KVSTORE_HDR_MAGIC           0
+#define KVSTORE_HDR_WEAR            1
+#define KVSTORE_HDR_SEQUENCE        2
+#define KVSTORE_HDR_ACTIVE          3
+#define KVSTORE_HEADER_WORDS        4
+
+/* Record length of a deleted key */
+#define KVSTORE_DELETED             0xFF
+
+/* Free index slot */
+#define KVSTORE_SLOT_EMPTY          ((uint32_t)0xFFFFFFFF)
+
+/* Private macro -------------------------------------------------------------*/
+#define KVSTORE_SLOT_KEY(SLOT)      ((uint16_t)((SLOT) >> 16))
+#define KVSTORE_SLOT_OFFSET(SLOT)   ((SLOT) & 0xFFFF)
+#define KVSTORE_RECORD_KEY(HDR)     ((uint16_t)((HDR) & 0xFFFF))
+#define KVSTORE_RECORD_LENGTH(HDR)  (((HDR) >> 16) & 0xFF)
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t KVStore_Word(KVStore_TypeDef* Store, uint8_t Set, uint32_t Word);
+static KVStore_Status KVStore_Program(KVStore_TypeDef* Store, uint8_t Set, uint32_t Word, uint32_t Data);
+static uint32_t KVStore_Header(uint16_t Key, uint32_t Length);
+static uint32_t KVStore_RecordWords(uint32_t Header);
+static uint16_t KVStore_Crc(uint16_t Crc, uint32_t Data);
+static uint32_t KVStore_CheckRecord(KVStore_TypeDef* Store, uint8_t Set, uint32_t Word, uint8_t* pValid);
+static uint8_t KVStore_IsBlank(KVStore_TypeDef* Store, uint8_t Set, uint32_t Word);
+static uint32_t KVStore_Hash(KVStore_TypeDef* Store, uint16_t Key);
+static int32_t KVStore_IndexFind(KVStore_TypeDef* Store, uint16_t Key);
+static void KVStore_IndexSet(KVStore_TypeDef* Store, uint16_t Key, uint32_t Offset);
+static void KVStore_IndexRemove(KVStore_TypeDef* Store, uint32_t Slot);
+static KVStore_Status KVStore_Scan(KVStore_TypeDef* Store);
+static KVStore_Status KVStore_Append(KVStore_TypeDef* Store, uint32_t Header, const uint8_t* pData);
+static KVStore_Status KVStore_PrepareSpare(KVStore_TypeDef* Store, uint8_t Set);
+static KVStore_Status KVStore_EraseStep(KVStore_TypeDef* Store, uint8_t Set);
+static KVStore_Status KVStore_GetSpare(KVStore_TypeDef* Store, uint8_t* pSet);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Reads a word of a page set.
+  * @param  Store: key/value store.
+  * @param  Set: page set.
+  * @param  Word: word offset in the page set.
+  * @retval Word value.
+  */
+static uint32_t KVStore_Word(KVStore_TypeDef* Store, uint8_t Set, uint32_t Word)
+{
+    return Store->pFlash->pArea[(uint32_t)Set * Store->SetWords + Word];
+}
+
+/**
+  * @brief  Programs a word of a page set.
+  * @param  Store: key/value store.
+  * @param  Set: page set.
+  * @param  Word: word offset in the page set.
+  * @param  Data: value to program.
+  * @retval KVSTORE_OK or KVSTORE_FLASH_ERROR.
+  */
+static KVStore_Status KVStore_Program(KVStore_TypeDef* Store, uint8_t Set, uint32_t Word, uint32_t Data)
+{
+    Store->ProgramWords++;
+
+    return Store->pFlash->Program(((uint32_t)Set * Store->SetWords + Word) * 4, Data);
+}
+
+/**
+  * @brief  Builds a record header.
+  * @param  Key: record key.
+  * @param  Length: value length, or KVSTORE_DELETED.
+  * @retval Header word.
+  */
+static uint32_t KVStore_Header(uint16_t Key, uint32_t Length)
+{
+    uint8_t check = (uint8_t)~((Key & 0xFF) ^ (Key >> 8) ^ Length);
+
+    return (uint32_t)Key | (Length << 16) | ((uint32_t)check << 24);
+}
+
+/**
+  * @brief  Returns the size of a record.
+  * @param  Header: record header.
+  * @retval Number of words, header and footer included.
+  */
+static uint32_t KVStore_RecordWords(uint32_t Header)
+{
+    uint32_t length = KVSTORE_RECORD_LENGTH(Header);
+
+    if (length == KVSTORE_DELETED)
+    {
+        length = 0;
+    }
+
+    return 2 + ((length + 3) / 4);
+}
+
+/**
+  * @brief  Updates a CRC-16/CCITT with the four bytes of a word, LSB first.
+  * @param  Crc: current CRC.
+  * @param  Data: word to add.
+  * @retval Updated CRC.
+  */
+static uint16_t KVStore_Crc(uint16_t Crc, uint32_t Data)
+{
+    uint32_t i;
+
+    for (i = 0; i < 32; i++)
+    {
+        if ((i & 7) == 0)
+        {
+            Crc ^= (uint16_t)(((Data >> i) & 0xFF) << 8);
+        }
+
+        Crc = (Crc & 0x8000) ? (uint16_t)((Crc << 1) ^ 0x1021) : (uint16_t)(Crc << 1);
+    }
+
+    return Crc;
+}
+
+/**
+  * @brief  Checks the record at a word offset of a page set.
+  * @param  Store: key/value store.
+  * @param  Set: page set.
+  * @param  Word: word offset of the record header.
+  * @param  pValid: set to 1 if the footer matches the record, else 0.
+  * @retval Record size in words, 0 if the header is not valid or the record
+  *         does not fit in the page set.
+  */
+static uint32_t KVStore_CheckRecord(KVStore_TypeDef* Store, uint8_t Set, uint32_t Word, uint8_t* pValid)
+{
+    uint32_t header = KVStore_Word(Store, Set, Word);
+    uint32_t words;
+    uint32_t i;
+    uint16_t crc = 0xFFFF;
+
+    *pValid = 0;
+
+    if ((KVSTORE_RECORD_KEY(header) == KVSTORE_KEY_INVALID) ||
+        (header != KVStore_Header(KVSTORE_RECORD_KEY(header), KVSTORE_RECORD_LENGTH(header))))
+    {
+        return 0;
+    }
+
+    words = KVStore_RecordWords(header);
+
+    if ((KVSTORE_RECORD_LENGTH(header) != KVSTORE_DELETED) &&
+        (KVSTORE_RECORD_LENGTH(header) > KVSTORE_MAX_LENGTH))
+    {
+        return 0;
+    }
+
+    if (Word + words > Store->SetWords)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < words - 1; i++)
+    {
+        crc = KVStore_Crc(crc, KVStore_Word(Store, Set, Word + i));
+    }
+
+    Store->MountWords += words;
+
+    if (KVStore_Word(Store, Set, Word + words - 1) == (((header & 0xFFFF) << 16) | crc))
+    {
+        *pValid = 1;
+    }
+
+    return words;
+}
+
+/**
+  * @brief  Tells whether a page set is erased from a word offset to its end.
+  * @param  Store: key/value store.
+  * @param  Set: page set.
+  * @param  Word: first word to check.
+  * @retval 1 if erased, 0 otherwise.
+  */
+static uint8_t KVStore_IsBlank(KVStore_TypeDef* Store, uint8_t Set, uint32_t Word)
+{
+    for (; Word < Store->SetWords; Word++)
+    {
+        Store->MountWords++;
+
+        if (KVStore_Word(Store, Set, Word) != KVSTORE_ERASED)
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+  * @brief  Returns the home slot of a key in the index.
+  * @param  Store: key/value store.
+  * @param  Key: key.
+  * @retval Slot number.
+  */
+static uint32_t KVStore_Hash(KVStore_TypeDef* Store, uint16_t Key)
+{
+    return (((uint32_t)Key * 0x9E3779B1) >> 16) & (Store->IndexSize - 1);
+}
+
+/**
+  * @brief  Looks a key up in the index (linear probing).
+  * @param  Store: key/value store.
+  * @param  Key: key.
+  * @retval Slot of the key, -1 if the key is not stored.
+  */
+static int32_t KVStore_IndexFind(KVStore_TypeDef* Store, uint16_t Key)
+{
+    uint32_t slot = KVStore_Hash(Store, Key);
+    uint32_t n;
+
+    for (n = 0; n < Store->IndexSize; n++)
+    {
+        if (Store->pIndex[slot] == KVSTORE_SLOT_EMPTY)
+        {
+            break;
+        }
+
+        if (KVSTORE_SLOT_KEY(Store->pIndex[slot]) == Key)
+        {
+            return (int32_t)slot;
+        }
+
+        slot = (slot + 1) & (Store->IndexSize - 1);
+    }
+
+    return -1;
+}
+
+/**
+  * @brief  Records the location of a key, adding the key if needed.
+  * @note   The caller checks that a free slot exists for a new key.
+  * @param  Store: key/value store.
+  * @param  Key: key.
+  * @param  Offset: word offset of the record in the active page set.
+  * @retval None
+  */
+static void KVStore_IndexSet(KVStore_TypeDef* Store, uint16_t Key, uint32_t Offset)
+{
+    uint32_t slot = KVStore_Hash(Store, Key);
+
+    while ((Store->pIndex[slot] != KVSTORE_SLOT_EMPTY) && (KVSTORE_SLOT_KEY(Store->pIndex[slot]) != Key))
+    {
+        slot = (slot + 1) & (Store->IndexSize - 1);
+    }
+
+    if (Store->pIndex[slot] == KVSTORE_SLOT_EMPTY)
+    {
+        Store->NbKeys++;
+    }
+
+    Store->pIndex[slot] = ((uint32_t)Key << 16) | Offset;
+}
+
+/**
+  * @brief  Removes a key from the index.
+  * @note   The following entries of the probe sequence are moved back, so
+  *         lookups never need deleted markers.
+  * @param  Store: key/value store.
+  * @param  Slot: slot of the key.
+  * @retval None
+  */
+static void KVStore_IndexRemove(KVStore_TypeDef* Store, uint32_t Slot)
+{
+    uint32_t mask = Store->IndexSize - 1;
+    uint32_t next = Slot;
+    uint32_t home;
+
+    Store->NbKeys--;
+
+    while (1)
+    {
+        Store->pIndex[Slot] = KVSTORE_SLOT_EMPTY;
+
+        do
+        {
+            next = (next + 1) & mask;
+
+            if (Store->pIndex[next] == KVSTORE_SLOT_EMPTY)
+            {
+                return;
+            }
+
+            home = KVStore_Hash(Store, KVSTORE_SLOT_KEY(Store->pIndex[next]));
+        }
+        /* Keep the entry if its home lies cyclically in (Slot, next] */
+        while (((next - home) & mask) < ((next - Slot) & mask));
+
+        Store->pIndex[Slot] = Store->pIndex[next];
+        Slot = next;
+    }
+}
+
+/**
+  * @brief  Builds the index from the log of the active page set.
+  * @note   A record with a bad footer is skipped. A bad header ends the log:
+  *         the rest of the page set is not used until the next compaction.
+  * @param  Store: key/value store.
+  * @retval KVSTORE_OK, or KVSTORE_NO_SPACE if the index is too small.
+  */
+static KVStore_Status KVStore_Scan(KVStore_TypeDef* Store)
+{
+    KVStore_Status status = KVSTORE_OK;
+    uint32_t word = KVSTORE_HEADER_WORDS;
+    uint32_t header;
+    uint32_t words;
+    uint8_t valid;
+    int32_t slot;
+
+    while (word < Store->SetWords)
+    {
+        header = KVStore_Word(Store, Store->Active, word);
+
+        if (header == KVSTORE_ERASED)
+        {
+            break;
+        }
+
+        words = KVStore_CheckRecord(Store, Store->Active, word, &valid);
+
+        if (words == 0)
+        {
+            word = Store->SetWords;
+            break;
+        }
+
+        if (valid != 0)
+        {
+            slot = KVStore_IndexFind(Store, KVSTORE_RECORD_KEY(header));
+
+            if (KVSTORE_RECORD_LENGTH(header) == KVSTORE_DELETED)
+            {
+                if (slot >= 0)
+                {
+                    KVStore_IndexRemove(Store, (uint32_t)slot);
+                }
+            }
+            else if ((slot >= 0) || (Store->NbKeys < Store->IndexSize))
+            {
+                KVStore_IndexSet(Store, KVSTORE_RECORD_KEY(header), word);
+            }
+            else
+            {
+                status = KVSTORE_NO_SPACE;
+            }
+        }
+
+        word += words;
+    }
+
+    Store->Free = word;
+
+    return status;
+}
+
+/**
+  * @brief  Appends a record to the log, the footer last.
+  * @note   The space is consumed even if programming fails.
+  * @param  Store: key/value store.
+  * @param  Header: record header.
+  * @param  pData: value bytes.
+  * @retval KVSTORE_OK or KVSTORE_FLASH_ERROR.
+  */
+static KVStore_Status KVStore_Append(KVStore_TypeDef* Store, uint32_t Header, const uint8_t* pData)
+{
+    uint32_t words = KVStore_RecordWords(Header);
+    uint32_t word = Store->Free;
+    uint32_t length = KVSTORE_RECORD_LENGTH(Header);
+    uint32_t data;
+    uint32_t i;
+    uint16_t crc;
+
+    Store->Free += words;
+
+    crc = KVStore_Crc(0xFFFF, Header);
+
+    if (KVStore_Program(Store, Store->Active, word++, Header) != KVSTORE_OK)
+    {
+        return KVSTORE_FLASH_ERROR;
+    }
+
+    if (length == KVSTORE_DELETED)
+    {
+        length = 0;
+    }
+
+    for (i = 0; i < length; i += 4)
+    {
+        data = KVSTORE_ERASED;
+        memcpy(&data, &pData[i], (length - i < 4) ? (length - i) : 4);
+        crc = KVStore_Crc(crc, data);
+
+        if (KVStore_Program(Store, Store->Active, word++, data) != KVSTORE_OK)
+        {
+            return KVSTORE_FLASH_ERROR;
+        }
+    }
+
+    return KVStore_Program(Store, Store->Active, word, ((Header & 0xFFFF) << 16) | crc);
+}
+
+/**
+  * @brief  Programs the header of an erased page set, which becomes a spare.
+  * @param  Store: key/value store.
+  * @param  Set: erased page set.
+  * @retval KVSTORE_OK or KVSTORE_FLASH_ERROR.
+  */
+static KVStore_Status KVStore_PrepareSpare(KVStore_TypeDef* Store, uint8_t Set)
+{
+    if ((KVStore_Program(Store, Set, KVSTORE_HDR_MAGIC, KVSTORE_MAGIC) != KVSTORE_OK) ||
+        (KVStore_Program(Store, Set, KVSTORE_HDR_WEAR, Store->Wear[Set]) != KVSTORE_OK))
+    {
+        Store->EraseLeft[Set] = (uint16_t)(Store->pFlash->SetSize / Store->pFlash->HalfPageSize);
+
+        return KVSTORE_FLASH_ERROR;
+    }
+
+    Store->Spare[Set] = 1;
+
+    return KVSTORE_OK;
+}
+
+/**
+  * @brief  Erases the next half page of a page set being erased.
+  * @note   The half pages are erased from the end, the header last.
+  * @param  Store: key/value store.
+  * @param  Set: page set being erased.
+  * @retval KVSTORE_OK or KVSTORE_FLASH_ERROR.
+  */
+static KVStore_Status KVStore_EraseStep(KVStore_TypeDef* Store, uint8_t Set)
+{
+    uint32_t offset;
+
+    if (Store->EraseLeft[Set] == 0)
+    {
+        return KVSTORE_OK;
+    }
+
+    offset = (uint32_t)Set * Store->pFlash->SetSize +
+             (uint32_t)(Store->EraseLeft[Set] - 1) * Store->pFlash->HalfPageSize;
+
+    Store->HalfPageErases++;
+
+    if (Store->pFlash->EraseHalfPage(offset) != KVSTORE_OK)
+    {
+        return KVSTORE_FLASH_ERROR;
+    }
+
+    if (--Store->EraseLeft[Set] != 0)
+    {
+        return KVSTORE_OK;
+    }
+
+    Store->Wear[Set]++;
+
+    return KVStore_PrepareSpare(Store, Set);
+}
+
+/**
+  * @brief  Selects the spare page set with the lowest erase count, completing
+  *         the pending erases if no spare is ready.
+  * @param  Store: key/value store.
+  * @param  pSet: receives the spare page set.
+  * @retval KVSTORE_OK, KVSTORE_FLASH_ERROR or KVSTORE_NO_SPACE.
+  */
+static KVStore_Status KVStore_GetSpare(KVStore_TypeDef* Store, uint8_t* pSet)
+{
+    uint8_t set;
+    uint8_t best = 0xFF;
+
+    for (set = 0; set < Store->pFlash->NbSets; set++)
+    {
+        if ((Store->Spare[set] != 0) && ((best == 0xFF) || (Store->Wear[set] < Store->Wear[best])))
+        {
+            best = set;
+        }
+    }
+
+    if (best == 0xFF)
+    {
+        for (set = 0; set < Store->pFlash->NbSets; set++)
+        {
+            while ((set != Store->Active) && (Store->EraseLeft[set] != 0))
+            {
+                if (KVStore_EraseStep(Store, set) != KVSTORE_OK)
+                {
+                    return KVSTORE_FLASH_ERROR;
+                }
+            }
+
+            if (Store->Spare[set] != 0)
+            {
+                best = set;
+                break;
+            }
+        }
+    }
+
+    if (best == 0xFF)
+    {
+        return KVSTORE_NO_SPACE;
+    }
+
+    *pSet = best;
+
+    return KVSTORE_OK;
+}
+
+/**
+  * @brief  Mounts a store: recovers from an interrupted compaction or erase,
+  *         selects the active page set and builds the index.
+  * @note   A blank area is formatted. The erase count of a page set whose
+  *         header was lost is set to the highest one of the area.
+  * @param  Store: key/value store to initialize.
+  * @param  pFlash: flash access, must stay valid while the store is used.
+  * @param  pIndex: index storage of IndexSize words.
+  * @param  IndexSize: number of index slots, power of two, at least the
+  *         number of keys stored.
+  * @retval KVSTORE_OK, KVSTORE_INVALID, KVSTORE_FLASH_ERROR, or
+  *         KVSTORE_NO_SPACE if the index is too small for the stored keys.
+  */
+KVStore_Status KVStore_Mount(KVStore_TypeDef* Store, const KVStore_FlashTypeDef* pFlash,
+                             uint32_t* pIndex, uint32_t IndexSize)
+{
+    uint8_t blank[KVSTORE_MAX_SETS];
+    uint8_t known[KVSTORE_MAX_SETS];
+    uint32_t maxWear = 0;
+    uint8_t set;
+    uint8_t active = 0xFF;
+    uint32_t h[KVSTORE_HEADER_WORDS];
+    uint32_t i;
+
+    if ((pFlash->NbSets < 2) || (pFlash->NbSets > KVSTORE_MAX_SETS) ||
+        (pFlash->HalfPageSize == 0) || ((pFlash->HalfPageSize & 3) != 0) ||
+        ((pFlash->SetSize % pFlash->HalfPageSize) != 0) ||
+        ((pFlash->SetSize / 4) <= KVSTORE_HEADER_WORDS) || ((pFlash->SetSize / 4) > 0x10000) ||
+        (IndexSize == 0) || ((IndexSize & (IndexSize - 1)) != 0))
+    {
+        return KVSTORE_INVALID;
+    }
+
+    memset(Store, 0, sizeof(*Store));
+    Store->pFlash = pFlash;
+    Store->pIndex = pIndex;
+    Store->IndexSize = IndexSize;
+    Store->SetWords = pFlash->SetSize / 4;
+
+    for (i = 0; i < IndexSize; i++)
+    {
+        pIndex[i] = KVSTORE_SLOT_EMPTY;
+    }
+
+    /* Classify the page sets from their header */
+    for (set = 0; set < pFlash->NbSets; set++)
+    {
+        for (i = 0; i < KVSTORE_HEADER_WORDS; i++)
+        {
+            h[i] = KVStore_Word(Store, set, i);
+        }
+
+        Store->MountWords += KVSTORE_HEADER_WORDS;
+        blank[set] = 0;
+        known[set] = ((h[KVSTORE_HDR_MAGIC] == KVSTORE_MAGIC) && (h[KVSTORE_HDR_WEAR] != KVSTORE_ERASED)) ? 1 : 0;
+
+        if (known[set] != 0)
+        {
+            Store->Wear[set] = h[KVSTORE_HDR_WEAR];
+
+            if (Store->Wear[set] > maxWear)
+            {
+                maxWear = Store->Wear[set];
+            }
+        }
+
+        if ((known[set] != 0) && (h[KVSTORE_HDR_ACTIVE] == KVSTORE_ACTIVE) &&
+            (h[KVSTORE_HDR_SEQUENCE] != KVSTORE_ERASED))
+        {
+            /* Of two complete logs, the older one was being erased */
+            if ((active == 0xFF) || (h[KVSTORE_HDR_SEQUENCE] > Store->Sequence))
+            {
+                if (active != 0xFF)
+                {
+                    Store->EraseLeft[active] = (uint16_t)(pFlash->SetSize / pFlash->HalfPageSize);
+                }
+
+                active = set;
+                Store->Sequence = h[KVSTORE_HDR_SEQUENCE];
+                continue;
+            }
+        }
+        else if (KVStore_IsBlank(Store, set, (known[set] != 0) ? KVSTORE_HDR_SEQUENCE : 0) != 0)
+        {
+            blank[set] = (known[set] != 0) ? 0 : 1;
+            Store->Spare[set] = known[set];
+            continue;
+        }
+
+        /* Interrupted compaction or erase, stale log, unknown content */
+        Store->EraseLeft[set] = (uint16_t)(pFlash->SetSize / pFlash->HalfPageSize);
+    }
+
+    for (set = 0; set < pFlash->NbSets; set++)
+    {
+        if (known[set] == 0)
+        {
+            Store->Wear[set] = maxWear;
+        }
+
+        if ((blank[set] != 0) && (KVStore_PrepareSpare(Store, set) != KVSTORE_OK))
+        {
+            return KVSTORE_FLASH_ERROR;
+        }
+    }
+
+    if (active != 0xFF)
+    {
+        Store->Active = active;
+
+        return KVStore_Scan(Store);
+    }
+
+    /* No log yet: format */
+    Store->Active = 0xFF;
+
+    if (KVStore_GetSpare(Store, &set) != KVSTORE_OK)
+    {
+        return KVSTORE_FLASH_ERROR;
+    }
+
+    Store->Sequence = 1;
+
+    if ((KVStore_Program(Store, set, KVSTORE_HDR_SEQUENCE, Store->Sequence) != KVSTORE_OK) ||
+        (KVStore_Program(Store, set, KVSTORE_HDR_ACTIVE, KVSTORE_ACTIVE) != KVSTORE_OK))
+    {
+        return KVSTORE_FLASH_ERROR;
+    }
+
+    Store->Spare[set] = 0;
+    Store->Active = set;
+    Store->Free = KVSTORE_HEADER_WORDS;
+
+    return KVSTORE_OK;
+}
+
+/**
+  * @brief  Reads the value of a key.
+  * @param  Store: key/value store.
+  * @param  Key: key.
+  * @param  pData: buffer for the value.
+  * @param  Size: buffer size, a longer value is truncated.
+  * @param  pLength: receives the value length, may be NULL.
+  * @retval KVSTORE_OK or KVSTORE_NOT_FOUND.
+  */
+KVStore_Status KVStore_Read(KVStore_TypeDef* Store, uint16_t Key, uint8_t* pData, uint32_t Size,
+                            uint32_t* pLength)
+{
+    int32_t slot = KVStore_IndexFind(Store, Key);
+    uint32_t word;
+    uint32_t length;
+
+    if (slot < 0)
+    {
+        return KVSTORE_NOT_FOUND;
+    }
+
+    word = KVSTORE_SLOT_OFFSET(Store->pIndex[slot]);
+    length = KVSTORE_RECORD_LENGTH(KVStore_Word(Store, Store->Active, word));
+
+    if (pLength != 0)
+    {
+        *pLength = length;
+    }
+
+    memcpy(pData, &Store->pFlash->pArea[(uint32_t)Store->Active * Store->SetWords + word + 1],
+           (length < Size) ? length : Size);
+
+    return KVSTORE_OK;
+}
+
+/**
+  * @brief  Writes the value of a key.
+  * @note   A value equal to the stored one is not written again. The log is
+  *         compacted when it is full, which may first complete the erase of a
+  *         page set.
+  * @param  Store: key/value store.
+  * @param  Key: key, any value but KVSTORE_KEY_INVALID.
+  * @param  pData: value bytes.
+  * @param  Length: value length, 0 to KVSTORE_MAX_LENGTH.
+  * @retval KVSTORE_OK, KVSTORE_INVALID, KVSTORE_NO_SPACE or KVSTORE_FLASH_ERROR.
+  */
+KVStore_Status KVStore_Write(KVStore_TypeDef* Store, uint16_t Key, const uint8_t* pData, uint32_t Length)
+{
+    int32_t slot;
+    uint32_t header;
+    uint32_t word;
+    KVStore_Status status;
+
+    if ((Key == KVSTORE_KEY_INVALID) || (Length > KVSTORE_MAX_LENGTH))
+    {
+        return KVSTORE_INVALID;
+    }
+
+    slot = KVStore_IndexFind(Store, Key);
+
+    if (slot >= 0)
+    {
+        word = KVSTORE_SLOT_OFFSET(Store->pIndex[slot]);
+
+        if ((KVSTORE_RECORD_LENGTH(KVStore_Word(Store, Store->Active, word)) == Length) &&
+            (memcmp(&Store->pFlash->pArea[(uint32_t)Store->Active * Store->SetWords + word + 1],
+                    pData, Length) == 0))
+        {
+            return KVSTORE_OK;
+        }
+    }
+    else if (Store->NbKeys >= Store->IndexSize)
+    {
+        return KVSTORE_NO_SPACE;
+    }
+
+    header = KVStore_Header(Key, Length);
+
+    if (Store->Free + KVStore_RecordWords(header) > Store->SetWords)
+    {
+        status = KVStore_Compact(Store);
+
+        if (status != KVSTORE_OK)
+        {
+            return status;
+        }
+
+        if (Store->Free + KVStore_RecordWords(header) > Store->SetWords)
+        {
+            return KVSTORE_NO_SPACE;
+        }
+    }
+
+    word = Store->Free;
+    status = KVStore_Append(Store, header, pData);
+
+    if (status == KVSTORE_OK)
+    {
+        KVStore_IndexSet(Store, Key, word);
+        Store->UserBytes += Length;
+    }
+
+    return status;
+}
+
+/**
+  * @brief  Deletes a key.
+  * @note   The key stays in the index until its deletion is in the flash:
+  *         after an error it is still readable, as after a remount.
+  * @param  Store: key/value store.
+  * @param  Key: key.
+  * @retval KVSTORE_OK, KVSTORE_NOT_FOUND, KVSTORE_NO_SPACE or KVSTORE_FLASH_ERROR.
+  */
+KVStore_Status KVStore_Delete(KVStore_TypeDef* Store, uint16_t Key)
+{
+    int32_t slot = KVStore_IndexFind(Store, Key);
+    uint32_t header = KVStore_Header(Key, KVSTORE_DELETED);
+    uint32_t word;
+    KVStore_Status status;
+
+    if (slot < 0)
+    {
+        return KVSTORE_NOT_FOUND;
+    }
+
+    /* A compaction without the key deletes it, no deletion record is needed
+       then. Until the copy is active the old log holds the key */
+    if (Store->Free + KVStore_RecordWords(header) > Store->SetWords)
+    {
+        word = KVSTORE_SLOT_OFFSET(Store->pIndex[slot]);
+        KVStore_IndexRemove(Store, (uint32_t)slot);
+        status = KVStore_Compact(Store);
+
+        if (status != KVSTORE_OK)
+        {
+            KVStore_IndexSet(Store, Key, word);
+        }
+
+        return status;
+    }
+
+    status = KVStore_Append(Store, header, 0);
+
+    if (status == KVSTORE_OK)
+    {
+        KVStore_IndexRemove(Store, (uint32_t)slot);
+    }
+
+    return status;
+}
+
+/**
+  * @brief  Copies the live records to the spare page set with the lowest
+  *         erase count, which becomes the active one.
+  * @note   The previous page set is erased later by KVStore_Maintain(). If
+  *         the copy is interrupted, KVStore_Mount() keeps the previous set.
+  * @param  Store: key/value store.
+  * @retval KVSTORE_OK, KVSTORE_NO_SPACE or KVSTORE_FLASH_ERROR.
+  */
+KVStore_Status KVStore_Compact(KVStore_TypeDef* Store)
+{
+    uint8_t target;
+    uint32_t slot;
+    uint32_t src;
+    uint32_t dst = KVSTORE_HEADER_WORDS;
+    uint32_t words;
+    uint32_t i;
+    KVStore_Status status;
+
+    status = KVStore_GetSpare(Store, &target);
+
+    if (status != KVSTORE_OK)
+    {
+        return status;
+    }
+
+    Store->Spare[target] = 0;
+    status = KVStore_Program(Store, target, KVSTORE_HDR_SEQUENCE, Store->Sequence + 1);
+
+    /* Copy the live records, the index keeps the old offsets until the end */
+    for (slot = 0; (slot < Store->IndexSize) && (status == KVSTORE_OK); slot++)
+    {
+        if (Store->pIndex[slot] == KVSTORE_SLOT_EMPTY)
+        {
+            continue;
+        }
+
+        src = KVSTORE_SLOT_OFFSET(Store->pIndex[slot]);
+        words = KVStore_RecordWords(KVStore_Word(Store, Store->Active, src));
+
+        for (i = 0; (i < words) && (status == KVSTORE_OK); i++)
+        {
+            status = KVStore_Program(Store, target, dst + i, KVStore_Word(Store, Store->Active, src + i));
+        }
+
+        dst += words;
+    }
+
+    if (status == KVSTORE_OK)
+    {
+        status = KVStore_Program(Store, target, KVSTORE_HDR_ACTIVE, KVSTORE_ACTIVE);
+    }
+
+    if (status != KVSTORE_OK)
+    {
+        Store->EraseLeft[target] = (uint16_t)(Store->pFlash->SetSize / Store->pFlash->HalfPageSize);
+
+        return status;
+    }
+
+    /* Same walk again to move the index to the new offsets */
+    dst = KVSTORE_HEADER_WORDS;
+
+    for (slot = 0; slot < Store->IndexSize; slot++)
+    {
+        if (Store->pIndex[slot] != KVSTORE_SLOT_EMPTY)
+        {
+            src = KVSTORE_SLOT_OFFSET(Store->pIndex[slot]);
+            Store->pIndex[slot] = (Store->pIndex[slot] & 0xFFFF0000) | dst;
+            dst += KVStore_RecordWords(KVStore_Word(Store, Store->Active, src));
+        }
+    }
+
+    Store->EraseLeft[Store->Active] = (uint16_t)(Store->pFlash->SetSize / Store->pFlash->HalfPageSize);
+    Store->Active = target;
+    Store->Sequence++;
+    Store->Free = dst;
+    Store->Compactions++;
+
+    return KVSTORE_OK;
+}
+
+/**
+  * @brief  Performs one half page erase of a page set released by a
+  *         compaction, to be called when the application is idle.
+  * @note   Spreading the erase keeps each flash stall to one half page. A
+  *         failed erase is retried by the next call.
+  * @param  Store: key/value store.
+  * @param  pPending: receives the number of half page erases still pending,
+  *         may be NULL.
+  * @retval KVSTORE_OK or KVSTORE_FLASH_ERROR.
+  */
+KVStore_Status KVStore_Maintain(KVStore_TypeDef* Store, uint32_t* pPending)
+{
+    KVStore_Status status = KVSTORE_OK;
+    uint32_t pending = 0;
+    uint8_t done = 0;
+    uint8_t set;
+
+    for (set = 0; set < Store->pFlash->NbSets; set++)
+    {
+        if ((set == Store->Active) || (Store->EraseLeft[set] == 0))
+        {
+            continue;
+        }
+
+        if (done == 0)
+        {
+            status = KVStore_EraseStep(Store, set);
+            done = 1;
+        }
+
+        pending += Store->EraseLeft[set];
+    }
+
+    if (pPending != 0)
+    {
+        *pPending = pending;
+    }
+
+    return status;
+}
+
+/**
+  * @brief  Returns the space left in the log before the next compaction.
+  * @param  Store: key/value store.
+  * @retval Number of free bytes, record headers and footers included.
+  */
+uint32_t KVStore_GetFree(KVStore_TypeDef* Store)
+{
+    return (Store->SetWords - Store->Free) * 4;
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
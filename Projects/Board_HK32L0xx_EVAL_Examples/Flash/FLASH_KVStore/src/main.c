@@ -0,0 +1,240 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  main.c
+* @brief:     Main program body
+* @author:    AE Team
+* @version:   V1.0.0/2024-12-02
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum {FAILED = 0, PASSED = !FAILED} TestStatus;
+
+/**
+  * @brief  Settings kept in the store under KEY_SETTINGS
+  */
+typedef struct
+{
+    uint32_t BaudRate;
+    uint16_t Threshold;
+    uint8_t Mode;
+    uint8_t Reserved;
+} Settings_TypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define FLASH_PAGE_SIZE         ((uint32_t)0x00000400)   /* FLASH Page Size */
+#define FLASH_HALF_PAGE_SIZE    (FLASH_PAGE_SIZE / 2)    /* FLASH_HalfErasePage() unit */
+#define KV_AREA_ADDR            ((uint32_t)0x0801E000)   /* Start @ of the store area */
+#define KV_SET_PAGES            2                        /* Pages per page set */
+#define KV_NB_SETS              4                        /* 8 Kbytes up to the end of the FLASH */
+#define KV_INDEX_SIZE           32                       /* Keys the store can hold */
+
+/* Keys */
+#define KEY_BOOT_COUNT          0x0001
+#define KEY_SETTINGS            0x0002
+#define KEY_LOG_BASE            0x0100                   /* 8 rotating log entries */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static KVStore_Status KV_FlashProgram(uint32_t Offset, uint32_t Data);
+static KVStore_Status KV_FlashEraseHalfPage(uint32_t Offset);
+static void Settings_Load(void);
+static void Log_Append(uint32_t Sequence);
+
+/* Private variables ---------------------------------------------------------*/
+static const KVStore_FlashTypeDef KV_Flash =
+{
+    (const uint32_t*)KV_AREA_ADDR,
+    KV_SET_PAGES * FLASH_PAGE_SIZE,
+    FLASH_HALF_PAGE_SIZE,
+    KV_NB_SETS,
+    KV_FlashProgram,
+    KV_FlashEraseHalfPage
+};
+
+KVStore_TypeDef Store;
+uint32_t StoreIndex[KV_INDEX_SIZE];
+Settings_TypeDef Settings;
+uint32_t BootCount = 0;
+__IO KVStore_Status StoreStatus = KVSTORE_OK;
+__IO TestStatus MemoryProgramStatus = PASSED;
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Main program.
+  * @param  None
+  * @retval None
+  */
+int main(void)
+{
+    uint32_t length;
+    uint32_t value;
+    uint32_t sequence;
+
+    /*!< At this stage the microcontroller clock setting is already configured,
+         this is done through SystemInit() function which is called from startup
+         file (KEIL_Startup_hk32l0xx.s) before to branch to application main.
+         To reconfigure the default setting of SystemInit() function, refer to
+         system_hk32l0xx.c file
+       */
+
+    /* Recover the store: a compaction or erase interrupted by a reset is
+       completed or rolled back here */
+    StoreStatus = KVStore_Mount(&Store, &KV_Flash, StoreIndex, KV_INDEX_SIZE);
+
+    if (StoreStatus != KVSTORE_OK)
+    {
+        MemoryProgramStatus = FAILED;
+
+        while (1)
+        {
+        }
+    }
+
+    /* Count the resets */
+    if (KVStore_Read(&Store, KEY_BOOT_COUNT, (uint8_t*)&BootCount, sizeof(BootCount), &length) != KVSTORE_OK)
+    {
+        BootCount = 0;
+    }
+
+    BootCount++;
+    StoreStatus = KVStore_Write(&Store, KEY_BOOT_COUNT, (uint8_t*)&BootCount, sizeof(BootCount));
+
+    Settings_Load();
+
+    /* Append log entries to exercise the compaction, then check the last ones */
+    for (sequence = 0; (sequence < 200) && (StoreStatus == KVSTORE_OK); sequence++)
+    {
+        Log_Append(sequence);
+
+        /* Idle time: erase the released page sets half a page at a time */
+        if (StoreStatus == KVSTORE_OK)
+        {
+            StoreStatus = KVStore_Maintain(&Store, 0);
+        }
+    }
+
+    for (sequence = 192; sequence < 200; sequence++)
+    {
+        if ((KVStore_Read(&Store, KEY_LOG_BASE + (sequence & 7), (uint8_t*)&value, sizeof(value), &length) != KVSTORE_OK) ||
+            (value != BootCount * 1000 + sequence))
+        {
+            MemoryProgramStatus = FAILED;
+        }
+    }
+
+    if (StoreStatus != KVSTORE_OK)
+    {
+        MemoryProgramStatus = FAILED;
+    }
+
+    /* Infinite loop */
+    while (1)
+    {
+        /* Store.Wear holds the erase count of each page set,
+           Store.ProgramWords * 4 / Store.UserBytes the write amplification */
+        if (KVStore_Maintain(&Store, 0) != KVSTORE_OK)
+        {
+            MemoryProgramStatus = FAILED;
+        }
+    }
+}
+
+/**
+  * @brief  Reads the settings, stores the defaults on first start.
+  * @param  None
+  * @retval None
+  */
+static void Settings_Load(void)
+{
+    uint32_t length;
+
+    if ((KVStore_Read(&Store, KEY_SETTINGS, (uint8_t*)&Settings, sizeof(Settings), &length) != KVSTORE_OK) ||
+        (length != sizeof(Settings)))
+    {
+        Settings.BaudRate = 115200;
+        Settings.Threshold = 2048;
+        Settings.Mode = 1;
+        Settings.Reserved = 0;
+
+        StoreStatus = KVStore_Write(&Store, KEY_SETTINGS, (uint8_t*)&Settings, sizeof(Settings));
+    }
+}
+
+/**
+  * @brief  Writes a log entry, the 8 latest entries are kept.
+  * @param  Sequence: entry number, the entry value also holds BootCount.
+  * @retval None
+  */
+static void Log_Append(uint32_t Sequence)
+{
+    uint32_t value = BootCount * 1000 + Sequence;
+
+    StoreStatus = KVStore_Write(&Store, KEY_LOG_BASE + (Sequence & 7), (uint8_t*)&value, sizeof(value));
+}
+
+/**
+  * @brief  Programs a word of the store area.
+  * @param  Offset: byte offset in the store area.
+  * @param  Data: value to program.
+  * @retval KVSTORE_OK or KVSTORE_FLASH_ERROR.
+  */
+static KVStore_Status KV_FlashProgram(uint32_t Offset, uint32_t Data)
+{
+    FLASH_Status status;
+
+    FLASH_Unlock();
+    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPERR | FLASH_FLAG_SIZE_ERR);
+    status = FLASH_ProgramWord(KV_AREA_ADDR + Offset, Data);
+    FLASH_Lock();
+
+    return (status == FLASH_COMPLETE) ? KVSTORE_OK : KVSTORE_FLASH_ERROR;
+}
+
+/**
+  * @brief  Erases a half page of the store area.
+  * @param  Offset: byte offset of the half page in the store area.
+  * @retval KVSTORE_OK or KVSTORE_FLASH_ERROR.
+  */
+static KVStore_Status KV_FlashEraseHalfPage(uint32_t Offset)
+{
+    FLASH_Status status;
+
+    FLASH_Unlock();
+    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPERR | FLASH_FLAG_SIZE_ERR);
+    status = FLASH_HalfErasePage(KV_AREA_ADDR + Offset);
+    FLASH_Lock();
+
+    return (status == FLASH_COMPLETE) ? KVSTORE_OK : KVSTORE_FLASH_ERROR;
+}
+
+#ifdef  USE_FULL_ASSERT
+
+/**
+  * @brief  Reports the name of the source file and the source line number
+  *         where the assert_param error has occurred.
+  * @param  file: pointer to the source file name
+  * @param  line: assert_param error line source number
+  * @retval None
+  */
+void assert_failed(uint8_t* file, uint32_t line)
+{
+    /* User can add his own implementation to report the file name and line number,
+       ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
+
+    /* Infinite loop */
+    while (1)
+    {
+    }
+}
+#endif
+
+/**
+  * @}
+  */
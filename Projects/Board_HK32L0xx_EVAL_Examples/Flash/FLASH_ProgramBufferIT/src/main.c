@@ -0,0 +1,176 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  main.c
+* @brief:     Main program body
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-04
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum {FAILED = 0, PASSED = !FAILED} TestStatus;
+
+/* Private define ------------------------------------------------------------*/
+#define FLASH_PAGE_SIZE         ((uint32_t)0x00000400)   /* FLASH Page Size */
+#define FLASH_USER_START_ADDR   ((uint32_t)0x08006000)   /* Start @ of user Flash area */
+#define FLASH_USER_END_ADDR     ((uint32_t)0x08007000)   /* End @ of user Flash area */
+#define BUFFER_WORDS            (FLASH_PAGE_SIZE / 4)    /* One page per buffer */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+uint32_t EraseCounter = 0x00, Address = 0x00;
+uint32_t Data = 0x00;
+uint32_t NbrOfPage = 0x00;
+uint32_t Buffer[BUFFER_WORDS];
+__IO uint32_t BackgroundCount = 0;
+__IO FLASH_Status FLASHStatus = FLASH_COMPLETE;
+__IO TestStatus MemoryProgramStatus = PASSED;
+
+/* Private function prototypes -----------------------------------------------*/
+static FLASH_RAMFUNC FLASH_Status Background_Work(void);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Main program.
+  * @param  None
+  * @retval None
+  */
+int main(void)
+{
+    NVIC_InitTypeDef NVIC_InitStructure;
+    uint32_t i;
+
+    /*!< At this stage the microcontroller clock setting is already configured,
+         this is done through SystemInit() function which is called from startup
+         file (KEIL_Startup_hk32l0xx.s) before to branch to application main.
+         To reconfigure the default setting of SystemInit() function, refer to
+         system_hk32l0xx.c file
+       */
+
+    /* Data to program, kept in SRAM until the end of each buffer */
+    for (i = 0; i < BUFFER_WORDS; i++)
+    {
+        Buffer[i] = (i * 0x01010101) ^ 0x5AA5C33C;
+    }
+
+    /* FLASH_IRQHandler() programs the next word of the buffer on the end of
+       operation interrupt */
+    NVIC_InitStructure.NVIC_IRQChannel = FLASH_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+
+    /* Unlock the Flash to enable the flash control register access *************/
+    FLASH_Unlock();
+
+    /* Clear pending flags (if any) */
+    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPERR | FLASH_FLAG_SIZE_ERR);
+
+    /* Define the number of page to be erased */
+    NbrOfPage = (FLASH_USER_END_ADDR - FLASH_USER_START_ADDR) / FLASH_PAGE_SIZE;
+
+    /* Erase the FLASH pages */
+    for (EraseCounter = 0; EraseCounter < NbrOfPage; EraseCounter++)
+    {
+        if (FLASH_ErasePage(FLASH_USER_START_ADDR + (FLASH_PAGE_SIZE * EraseCounter)) != FLASH_COMPLETE)
+        {
+            /* Error occurred while sector erase.
+                User can add here some code to deal with this error  */
+            while (1)
+            {
+            }
+        }
+    }
+
+    /* Program the user Flash area a page at a time, the CPU keeps running
+       from SRAM while the words are programmed *********************************/
+    for (Address = FLASH_USER_START_ADDR; (Address < FLASH_USER_END_ADDR) && (FLASHStatus == FLASH_COMPLETE);
+         Address += FLASH_PAGE_SIZE)
+    {
+        FLASHStatus = FLASH_ProgramBufferIT(Address, Buffer, BUFFER_WORDS);
+
+        if (FLASHStatus == FLASH_COMPLETE)
+        {
+            FLASHStatus = Background_Work();
+        }
+    }
+
+    /* Lock the Flash to disable the flash control register access (recommended
+       to protect the FLASH memory against possible unwanted operation) *********/
+    FLASH_Lock();
+
+    /* Check if the programmed data is OK
+        MemoryProgramStatus = PASSED: data programmed correctly
+        MemoryProgramStatus = FAILED: error or data not programmed correctly ***/
+    MemoryProgramStatus = (FLASHStatus == FLASH_COMPLETE) ? PASSED : FAILED;
+
+    for (Address = FLASH_USER_START_ADDR; Address < FLASH_USER_END_ADDR; Address += 4)
+    {
+        Data = *(__IO uint32_t *)Address;
+
+        if (Data != Buffer[((Address - FLASH_USER_START_ADDR) % FLASH_PAGE_SIZE) / 4])
+        {
+            MemoryProgramStatus = FAILED;
+        }
+    }
+
+    /* Infinite loop */
+    while (1)
+    {
+    }
+}
+
+/**
+  * @brief  Work done from SRAM until the end of the buffer.
+  * @note   Nothing here may be fetched from the flash, or the CPU would stall
+  *         until the end of the word being programmed.
+  * @param  None
+  * @retval Final status of the buffer.
+  */
+static FLASH_RAMFUNC FLASH_Status Background_Work(void)
+{
+    FLASH_Status status;
+
+    do
+    {
+        BackgroundCount++;
+        status = FLASH_GetProgramBufferStatus();
+    }
+    while (status == FLASH_BUSY);
+
+    return status;
+}
+
+#ifdef  USE_FULL_ASSERT
+
+/**
+  * @brief  Reports the name of the source file and the source line number
+  *         where the assert_param error has occurred.
+  * @param  file: pointer to the source file name
+  * @param  line: assert_param error line source number
+  * @retval None
+  */
+void assert_failed(uint8_t* file, uint32_t line)
+{
+    /* User can add his own implementation to report the file name and line number,
+       ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
+
+    /* Infinite loop */
+    while (1)
+    {
+    }
+}
+#endif
+
+/**
+  * @}
+  */
+
+
+
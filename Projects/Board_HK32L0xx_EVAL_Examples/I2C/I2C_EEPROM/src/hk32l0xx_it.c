@@ -11,6 +11,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "hk32l0xx_it.h"
+#include "main.h"
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
@@ -65,6 +66,7 @@ void PendSV_Handler(void)
   */
 void SysTick_Handler(void)
 {
+    sEE_AsyncTick();
 }
 
 /******************************************************************************/
@@ -74,6 +76,15 @@ void SysTick_Handler(void)
 /*  file (KEIL_Startup_hk32l0xx.s).                                               */
 /******************************************************************************/
 
+/**
+  * @brief  This function handles I2C1 interrupt request.
+  * @retval None
+  */
+void I2C1_IRQHandler(void)
+{
+    sEE_I2C_IRQHandler();
+}
+
 /**
   * @brief  This function handles PPP interrupt request.
   * @retval None
@@ -31,12 +31,16 @@ uint8_t Tx2_Buffer[] = "/* I2C Firmware Library EEPROM driver example, Tx2_Buffe
 uint8_t Rx1_Buffer[BUFFER_SIZE1], Rx2_Buffer[BUFFER_SIZE2];
 
 volatile TestStatus TransferStatus1 = FAILED, TransferStatus2 = FAILED;
-volatile uint16_t NumDataRead = 0;
+volatile uint32_t ControlLoopCount = 0;
+
+/* Descriptors of the asynchronous EEPROM transfers */
+sEE_TransferTypeDef WriteTransfer, ReadTransfer;
 
 /* Private function prototypes -----------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
 TestStatus Buffercmp(uint8_t* pBuffer1, uint8_t* pBuffer2, uint16_t BufferLength);
 static void USART_Config(void);
+static void Transfer_Wait(sEE_TransferTypeDef* Transfer);
 
 /**
   * @brief  Main program
@@ -50,33 +54,22 @@ int main(void)
 
     /* Initialize the I2C EEPROM driver ----------------------------------------*/
     sEE_Init();
+    sEE_AsyncInit();
 
-    /* First write in the memory followed by a read of the written data --------*/
-
-    /* Write on I2C EEPROM from sEE_WRITE_ADDRESS1 */
-    sEE_WriteBuffer(Tx1_Buffer, sEE_WRITE_ADDRESS1, BUFFER_SIZE1);
+    /* 1 ms time base of the asynchronous transfers (sEE_AsyncTick) */
+    SysTick_Config(SystemCoreClock / 1000);
 
-    /* Set the Number of data to be read */
-    NumDataRead = BUFFER_SIZE1;
+    /* First write in the memory followed by a read of the written data --------*/
 
-    /* Read from I2C EEPROM from sEE_READ_ADDRESS1 */
-    sEE_ReadBuffer(Rx1_Buffer, sEE_READ_ADDRESS1, (uint16_t *)(&NumDataRead));
+    /* Write on I2C EEPROM from sEE_WRITE_ADDRESS1, page by page */
+    sEE_WriteBufferAsync(&WriteTransfer, Tx1_Buffer, sEE_WRITE_ADDRESS1, BUFFER_SIZE1);
 
-    /* Wait till DMA transfer is complete (Transfer complete interrupt handler
-      resets the variable holding the number of data to be read) */
-    while (NumDataRead > 0)
-    {
-        /* Starting from this point, if the requested number of data is higher than 1,
-           then only the DMA is managing the data transfer. Meanwhile, CPU is free to
-           perform other tasks:
+    /* Read from I2C EEPROM from sEE_READ_ADDRESS1, queued behind the write */
+    sEE_ReadBufferAsync(&ReadTransfer, Rx1_Buffer, sEE_READ_ADDRESS1, BUFFER_SIZE1);
 
-          // Add your code here:
-          //...
-          //...
-
-           For simplicity reasons, this example is just waiting till the end of the
-           transfer. */
-    }
+    /* The DMA moves the data and the write cycles are polled from SysTick,
+       the CPU keeps running the control loop meanwhile */
+    Transfer_Wait(&ReadTransfer);
 
     /* Check if the data written to the memory is read correctly */
     TransferStatus1 = Buffercmp(Tx1_Buffer, Rx1_Buffer, BUFFER_SIZE1);
@@ -99,28 +92,15 @@ int main(void)
     }
 
     /* Second write in the memory followed by a read of the written data -------*/
-    /* Write on I2C EEPROM from sEE_WRITE_ADDRESS2 */
-    sEE_WriteBuffer(Tx2_Buffer, sEE_WRITE_ADDRESS2, BUFFER_SIZE2);
-    /* Set the Number of data to be read */
-    NumDataRead = BUFFER_SIZE2;
-    /* Read from I2C EEPROM from sEE_READ_ADDRESS2 */
-    sEE_ReadBuffer(Rx2_Buffer, sEE_READ_ADDRESS2, (uint16_t *)(&NumDataRead));
-
-    /* Wait till DMA transfer is complete (Transfer complete interrupt handler
-      resets the variable holding the number of data to be read) */
-    while (NumDataRead > 0)
-    {
-        /* Starting from this point, if the requested number of data is higher than 1,
-           then only the DMA is managing the data transfer. Meanwhile, CPU is free to
-           perform other tasks:
+    /* Write on I2C EEPROM from sEE_WRITE_ADDRESS2, page by page */
+    sEE_WriteBufferAsync(&WriteTransfer, Tx2_Buffer, sEE_WRITE_ADDRESS2, BUFFER_SIZE2);
 
-          // Add your code here:
-          //...
-          //...
+    /* Read from I2C EEPROM from sEE_READ_ADDRESS2, queued behind the write */
+    sEE_ReadBufferAsync(&ReadTransfer, Rx2_Buffer, sEE_READ_ADDRESS2, BUFFER_SIZE2);
 
-           For simplicity reasons, this example is just waiting till the end of the
-           transfer. */
-    }
+    /* The DMA moves the data and the write cycles are polled from SysTick,
+       the CPU keeps running the control loop meanwhile */
+    Transfer_Wait(&ReadTransfer);
 
     /* Check if the data written to the memory is read correctly */
     TransferStatus2 = Buffercmp(Tx2_Buffer, Rx2_Buffer, BUFFER_SIZE2);
@@ -143,6 +123,7 @@ int main(void)
     }
 
     /* Free all used resources */
+    sEE_AsyncDeInit();
     sEE_DeInit();
 
     while (1)
@@ -150,6 +131,21 @@ int main(void)
     }
 }
 
+/**
+  * @brief  Runs the control loop until an asynchronous transfer completes.
+  * @param  Transfer: submitted transfer.
+  * @retval None
+  */
+static void Transfer_Wait(sEE_TransferTypeDef* Transfer)
+{
+    while ((Transfer->Status == sEE_TRANSFER_QUEUED) || (Transfer->Status == sEE_TRANSFER_ACTIVE))
+    {
+        /* Add your code here: the bus transfers and the 5 ms write cycles
+           do not need the CPU */
+        ControlLoopCount++;
+    }
+}
+
 /**
   * @brief  Compares two buffers.
   * @param  pBuffer1, pBuffer2: buffers to be compared.
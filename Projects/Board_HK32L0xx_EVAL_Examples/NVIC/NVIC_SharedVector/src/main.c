@@ -0,0 +1,319 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  main.c
+* @brief:     Main program body
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-04
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "hk32l0xx_eval.h"
+/** @addtogroup HK32L0xx_StdPeriph_Examples
+  * @{
+  */
+
+/** @addtogroup NVIC_SharedVector
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define SMALL_BUFFER_SIZE       16      /* Words copied by DMA channel 4 */
+#define LARGE_BUFFER_SIZE       256     /* Words copied by DMA channel 6 */
+#define TRANSFER_PERIOD         10      /* Milliseconds between two DMA copies */
+#define RANDOM_PERIOD           5       /* Milliseconds between two entropy pool reads */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+uint8_t ubButtonPress = 0;
+__IO uint32_t TickCount = 0;
+USART_InitTypeDef USART_InitStructure;
+
+/* Handler tables of the two shared vectors */
+NVIC_SharedVectorTypeDef DMA_CH4_7_Vector;
+NVIC_SharedVectorTypeDef AES_TRNG_Vector;
+
+/* Entropy pool filled by AES_TRNG_IRQHandler() */
+TRNG_PoolTypeDef TRNG_Pool;
+
+static uint32_t SmallSrc[SMALL_BUFFER_SIZE];
+static uint32_t SmallDst[SMALL_BUFFER_SIZE];
+static uint32_t LargeSrc[LARGE_BUFFER_SIZE];
+static uint32_t LargeDst[LARGE_BUFFER_SIZE];
+static __IO uint8_t SmallDone = 1;
+static __IO uint8_t LargeDone = 1;
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+static void Configure_Config(void);
+static void DMA_Config(DMA_Channel_TypeDef* DMAy_Channelx, uint32_t* pSrc, uint32_t* pDst, uint16_t Size);
+static void DMA_Restart(DMA_Channel_TypeDef* DMAy_Channelx, uint16_t Size);
+static void DMA_Channel4_Handler(void);
+static void DMA_Channel6_Handler(void);
+static void Display_Vector(const char* Name, NVIC_SharedVectorTypeDef* Vector, const char* const* Sources);
+
+/**
+  * @brief  Main program.
+  * @param  None
+  * @retval None
+  */
+int main(void)
+{
+    static const char* const DMASources[] = {"DMA channel 4", "DMA channel 6"};
+    static const char* const AESTRNGSources[] = {"TRNG pool"};
+    uint32_t lastTransfer = 0;
+    uint32_t lastRandom = 0;
+    uint8_t random[16];
+    uint32_t i;
+
+    /* Initialize LED2 */
+    HK_EVAL_LEDInit(LED2);
+    /*------------------------------- USART-------------------------------------*/
+
+    /* USARTx configured as follow:
+    - BaudRate = 115200
+    - Word Length = USART_WordLength_8b
+    - Stop Bit = USART_StopBits_1
+    - Parity = USART_Parity_No
+    - Hardware flow control disabled (RTS and CTS signals)
+    - Receive and transmit enabled
+    */
+    USART_InitStructure.USART_BaudRate = 115200;
+    USART_InitStructure.USART_WordLength = USART_WordLength_8b;
+    USART_InitStructure.USART_StopBits = USART_StopBits_1;
+    USART_InitStructure.USART_Parity = USART_Parity_No;
+    USART_InitStructure.USART_HardwareFlowControl = USART_HardwareFlowControl_None;
+    USART_InitStructure.USART_Mode = USART_Mode_Tx | USART_Mode_Rx;
+
+    /* Initialize UART3 */
+    HK_EVAL_COMInit(COM1, &USART_InitStructure);
+
+    /* Initialize User push-button in EXTI mode */
+    HK_EVAL_PBInit(BUTTON_KEY1, BUTTON_MODE_EXTI);
+
+    for (i = 0; i < LARGE_BUFFER_SIZE; i++)
+    {
+        LargeSrc[i] = i * 0x01010101;
+    }
+
+    for (i = 0; i < SMALL_BUFFER_SIZE; i++)
+    {
+        SmallSrc[i] = ~i;
+    }
+
+    /* Handler tables, DMA sources share DMA->ISR */
+    NVIC_SharedInit(&DMA_CH4_7_Vector, DMA_CH4_7_IRQn);
+    NVIC_SharedRegister(&DMA_CH4_7_Vector, DMA_Channel4_Handler, &DMA->ISR, DMA1_IT_GL4);
+    NVIC_SharedRegister(&DMA_CH4_7_Vector, DMA_Channel6_Handler, &DMA->ISR, DMA1_IT_GL6);
+
+    NVIC_SharedInit(&AES_TRNG_Vector, AES_TRNG_EMACC_IRQn);
+    NVIC_SharedRegister(&AES_TRNG_Vector, AES_TRNG_IRQHandler, &TRNG->SR, TRNG_SR_DRDY | TRNG_SR_SEIS);
+
+    /* Clocks, DMA channels, NVIC and SysTick */
+    Configure_Config();
+
+    /* Fill the entropy pool in the background */
+    TRNG_PoolInit(&TRNG_Pool);
+    TRNG_PoolStart(&TRNG_Pool);
+
+    printf("Shared vector dispatch: DMA_CH4_7 and AES_TRNG_EMACC, press KEY1 for the counters\r\n");
+
+    /* Infinite loop */
+    while (1)
+    {
+        if ((TickCount - lastTransfer) >= TRANSFER_PERIOD)
+        {
+            lastTransfer = TickCount;
+
+            if (SmallDone != 0)
+            {
+                SmallDone = 0;
+                DMA_Restart(DMA_Channel4, SMALL_BUFFER_SIZE);
+            }
+
+            if (LargeDone != 0)
+            {
+                LargeDone = 0;
+                DMA_Restart(DMA_Channel6, LARGE_BUFFER_SIZE);
+            }
+        }
+
+        if ((TickCount - lastRandom) >= RANDOM_PERIOD)
+        {
+            lastRandom = TickCount;
+            (void)TRNG_PoolGet(&TRNG_Pool, random, sizeof(random));
+        }
+
+        if (ubButtonPress != 0)
+        {
+            ubButtonPress = 0;
+            Display_Vector("DMA_CH4_7", &DMA_CH4_7_Vector, DMASources);
+            Display_Vector("AES_TRNG_EMACC", &AES_TRNG_Vector, AESTRNGSources);
+            HK_EVAL_LEDToggle(LED2);
+        }
+    }
+}
+
+/**
+  * @brief  End of the DMA channel 4 copy.
+  * @param  None
+  * @retval None
+  */
+static void DMA_Channel4_Handler(void)
+{
+    DMA_ClearITPendingBit(DMA1_IT_GL4);
+    DMA_Cmd(DMA_Channel4, DISABLE);
+    SmallDone = 1;
+}
+
+/**
+  * @brief  End of the DMA channel 6 copy.
+  * @param  None
+  * @retval None
+  */
+static void DMA_Channel6_Handler(void)
+{
+    DMA_ClearITPendingBit(DMA1_IT_GL6);
+    DMA_Cmd(DMA_Channel6, DISABLE);
+    LargeDone = 1;
+}
+
+/**
+  * @brief  Displays the counters of a shared vector.
+  * @param  Name: name of the vector.
+  * @param  Vector: pointer to the handler table.
+  * @param  Sources: names of the sources, in registration order.
+  * @retval None
+  */
+static void Display_Vector(const char* Name, NVIC_SharedVectorTypeDef* Vector, const char* const* Sources)
+{
+    uint32_t i;
+
+    printf("%s: %u interrupts, %u spurious\r\n", Name, (unsigned int)Vector->Count,
+           (unsigned int)Vector->Spurious);
+
+    for (i = 0; i < Vector->NbSources; i++)
+    {
+        printf("    %-14s %8u calls, longest %u cycles\r\n", Sources[i],
+               (unsigned int)Vector->Source[i].Count, (unsigned int)Vector->Source[i].MaxCycles);
+    }
+}
+
+/**
+  * @brief  Configures a DMA channel for a memory to memory copy with its
+  *         transfer complete interrupt.
+  * @param  DMAy_Channelx: DMA channel.
+  * @param  pSrc: source buffer.
+  * @param  pDst: destination buffer.
+  * @param  Size: number of words.
+  * @retval None
+  */
+static void DMA_Config(DMA_Channel_TypeDef* DMAy_Channelx, uint32_t* pSrc, uint32_t* pDst, uint16_t Size)
+{
+    DMA_InitTypeDef DMA_InitStructure;
+
+    DMA_DeInit(DMAy_Channelx);
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)pSrc;
+    DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)pDst;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
+    DMA_InitStructure.DMA_BufferSize = Size;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Enable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Word;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Word;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_Low;
+    DMA_InitStructure.DMA_M2M = DMA_M2M_Enable;
+    DMA_Init(DMAy_Channelx, &DMA_InitStructure);
+
+    DMA_ITConfig(DMAy_Channelx, DMA_IT_TC, ENABLE);
+}
+
+/**
+  * @brief  Starts a new copy on a DMA channel.
+  * @param  DMAy_Channelx: DMA channel, disabled by its handler.
+  * @param  Size: number of words.
+  * @retval None
+  */
+static void DMA_Restart(DMA_Channel_TypeDef* DMAy_Channelx, uint16_t Size)
+{
+    DMA_SetCurrDataCounter(DMAy_Channelx, Size);
+    DMA_Cmd(DMAy_Channelx, ENABLE);
+}
+
+/**
+  * @brief  This function configures the peripherals of the example.
+  * @note   This function is used to :
+  *         -1- Enable peripheral clocks for TRNG and DMA.
+  *         -2- Configure DMA channels 4 and 6 for memory to memory copies.
+  *         -3- NVIC Configuration for the two shared vectors.
+  *         -4- SysTick 1 ms time base, also used to measure the handlers.
+  * @param  None
+  * @retval None
+  */
+static void Configure_Config(void)
+{
+    NVIC_InitTypeDef NVIC_InitStruct;
+
+    /* Enable TRNG and DMA clock sources */
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_TRNG, ENABLE);
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA, ENABLE);
+
+    DMA_Config(DMA_Channel4, SmallSrc, SmallDst, SMALL_BUFFER_SIZE);
+    DMA_Config(DMA_Channel6, LargeSrc, LargeDst, LARGE_BUFFER_SIZE);
+
+    /* NVIC Configuration for the shared vectors */
+    NVIC_InitStruct.NVIC_IRQChannel = DMA_CH4_7_IRQn;
+    NVIC_InitStruct.NVIC_IRQChannelPriority = 1;
+    NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStruct);
+
+    NVIC_InitStruct.NVIC_IRQChannel = AES_TRNG_EMACC_IRQn;
+    NVIC_InitStruct.NVIC_IRQChannelPriority = 2;
+    NVIC_Init(&NVIC_InitStruct);
+
+    /* 1 ms time base, SysTick counts core cycles */
+    if (SysTick_Config(SystemCoreClock / 1000))
+    {
+        /* Capture error */
+        while (1)
+        {
+        }
+    }
+}
+
+#ifdef  USE_FULL_ASSERT
+
+/**
+  * @brief  Reports the name of the source file and the source line number
+  *         where the assert_param error has occurred.
+  * @param  file: pointer to the source file name
+  * @param  line: assert_param error line source number
+  * @retval None
+  */
+void assert_failed(uint8_t* file, uint32_t line)
+{
+    /* User can add his own implementation to report the file name and line number,
+       ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
+
+    /* Infinite loop */
+    while (1)
+    {
+    }
+}
+#endif
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+
+
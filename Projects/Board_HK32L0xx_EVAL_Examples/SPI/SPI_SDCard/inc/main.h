@@ -18,6 +18,7 @@ extern "C" {
 #include <stdio.h>
 #include "hk32l0xx.h"
 #include "hk32l0xx_eval_spi_sd.h"
+#include "hk32l0xx_eval_spi_dma.h"
 #include "hk32l0xx_eval.h"
 /* Exported types ------------------------------------------------------------*/
 /* Exported constants --------------------------------------------------------*/
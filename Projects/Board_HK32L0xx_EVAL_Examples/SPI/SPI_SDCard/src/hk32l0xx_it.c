@@ -11,6 +11,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "hk32l0xx_it.h"
+#include "hk32l0xx_eval_spi_dma.h"
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
@@ -74,6 +75,16 @@ void SysTick_Handler(void)
 /*  file (KEIL_Startup_hk32l0xx.s).                                               */
 /******************************************************************************/
 
+/**
+  * @brief  This function handles DMA Channel 2 and 3 interrupt request.
+  * @retval None
+  */
+void DMA_CH2_3_IRQHandler(void)
+{
+    /* SD card data blocks streamed by the SPI DMA engine */
+    HK_SPI_DMA_IRQHandler();
+}
+
 /**
   * @brief  This function handles PPP interrupt request.
   * @retval None
@@ -49,6 +49,10 @@ int main(void)
 
     Status = SD_Init();
 
+    /* HK_SPI_DMA_IRQHandler() is called from DMA_CH2_3_IRQHandler(): the data
+       transfers complete in the interrupt while the core sleeps */
+    HK_SPI_DMA_ITConfig(ENABLE);
+
     /* If SD is responding */
     if (Status == SD_RESPONSE_NO_ERROR)
     {
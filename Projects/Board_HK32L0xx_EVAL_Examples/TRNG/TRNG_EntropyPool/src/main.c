@@ -0,0 +1,356 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  main.c
+* @brief:     Main program body
+* @author:    AE Team
+* @version:   V1.0.0/2024-01-04
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "hk32l0xx_eval.h"
+/** @addtogroup HK32L0xx_StdPeriph_Examples
+  * @{
+  */
+
+/** @addtogroup TRNG_EntropyPool
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define AES_DMA_CLK             RCC_AHBPeriph_DMA
+#define AES_DMA_IN_CHANNEL      DMA_Channel1
+#define AES_DMA_IN_REMAP        DMA_CSELR_CH1_AES_IN
+#define AES_DMA_OUT_CHANNEL     DMA_Channel2
+#define AES_DMA_OUT_REMAP       DMA_CSELR_CH2_AES_OUT
+
+#define BENCH_SIZE              1024    /* Bytes generated by each method of the benchmark */
+#define DRBG_RESEED_INTERVAL    1024    /* Requests served between two reseeds from the pool */
+#define NB_OF_DISPLAYED_BYTES   32      /* Random bytes displayed after each User button press */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+uint8_t ubButtonPress = 0;
+USART_InitTypeDef USART_InitStructure;
+
+/* Entropy pool filled by AES_TRNG_IRQHandler() */
+TRNG_PoolTypeDef TRNG_Pool;
+
+static AES_ContextTypeDef AES_Context =
+{
+    0,
+    {0},
+    AES_DMA_IN_CHANNEL,
+    AES_DMA_OUT_CHANNEL,
+    NULL,
+    0
+};
+
+static ErrorStatus DRBG_GetEntropy(uint8_t* pData, uint32_t Length);
+
+static AES_DRBGTypeDef AES_DRBG =
+{
+    &AES_Context,
+    DRBG_RESEED_INTERVAL,
+    DRBG_GetEntropy,
+    {0},
+    {0},
+    0,
+    0
+};
+
+/* Personalization string of the DRBG, unique per device in a real product */
+static const uint8_t DRBG_Personalization[] = "HK32L0xx TRNG_EntropyPool";
+
+static uint8_t aRandom[BENCH_SIZE];
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+static void Configure_Config(void);
+static void DRBG_Start(void);
+static void Benchmark(void);
+static void Display_Random(void);
+static void Display_PoolStatus(void);
+static uint32_t Cycles_Elapsed(uint32_t Start);
+static void Delay(__IO uint32_t nCount);
+
+/**
+  * @brief  Main program.
+  * @param  None
+  * @retval None
+  */
+int main(void)
+{
+    /* Initialize LED2 */
+    HK_EVAL_LEDInit(LED2);
+    /*------------------------------- USART-------------------------------------*/
+
+    /* USARTx configured as follow:
+    - BaudRate = 115200
+    - Word Length = USART_WordLength_8b
+    - Stop Bit = USART_StopBits_1
+    - Parity = USART_Parity_No
+    - Hardware flow control disabled (RTS and CTS signals)
+    - Receive and transmit enabled
+    */
+    USART_InitStructure.USART_BaudRate = 115200;
+    USART_InitStructure.USART_WordLength = USART_WordLength_8b;
+    USART_InitStructure.USART_StopBits = USART_StopBits_1;
+    USART_InitStructure.USART_Parity = USART_Parity_No;
+    USART_InitStructure.USART_HardwareFlowControl = USART_HardwareFlowControl_None;
+    USART_InitStructure.USART_Mode = USART_Mode_Tx | USART_Mode_Rx;
+
+    /* Initialize UART3 */
+    HK_EVAL_COMInit(COM1, &USART_InitStructure);
+
+    /* Initialize User push-button in EXTI mode */
+    HK_EVAL_PBInit(BUTTON_KEY1, BUTTON_MODE_EXTI);
+
+    /* Configure TRNG, AES and DMA clocks and the TRNG interrupt */
+    Configure_Config();
+
+    /* Fill the entropy pool in the background */
+    TRNG_PoolInit(&TRNG_Pool);
+    TRNG_PoolStart(&TRNG_Pool);
+
+    /* Seed the DRBG from the pool */
+    DRBG_Start();
+
+    printf("TRNG entropy pool and AES CTR_DRBG\r\n");
+    Benchmark();
+    Display_PoolStatus();
+
+    /* Infinite loop */
+    while (1)
+    {
+        if (ubButtonPress != 0)
+        {
+            ubButtonPress = 0;
+            Display_Random();
+            Display_PoolStatus();
+        }
+
+        if (TRNG_Pool.Error != 0)
+        {
+            /* The TRNG failed the health tests, LED2 blinks */
+            HK_EVAL_LEDToggle(LED2);
+            Delay(0x2FFFF);
+        }
+    }
+}
+
+/**
+  * @brief  Entropy input of the DRBG reseeds, taken from the pool without
+  *         waiting: the DRBG keeps its state if the pool is short.
+  * @param  pData: pointer to the entropy buffer.
+  * @param  Length: number of bytes.
+  * @retval SUCCESS if Length bytes were read.
+  */
+static ErrorStatus DRBG_GetEntropy(uint8_t* pData, uint32_t Length)
+{
+    return TRNG_PoolGet(&TRNG_Pool, pData, Length);
+}
+
+/**
+  * @brief  Instantiates the DRBG with AES_DRBG_ENTROPY_SIZE bytes of entropy
+  *         and a 16-byte nonce from the pool.
+  * @note   The pool is empty until its startup test is complete.
+  * @param  None
+  * @retval None
+  */
+static void DRBG_Start(void)
+{
+    uint8_t seed[AES_DRBG_ENTROPY_SIZE + 16];
+
+    while (TRNG_PoolGet(&TRNG_Pool, seed, sizeof(seed)) != SUCCESS)
+    {
+        if (TRNG_Pool.Error != 0)
+        {
+            printf("TRNG health tests failed, no seed\r\n");
+
+            while (1)
+            {
+                HK_EVAL_LEDToggle(LED2);
+                Delay(0x2FFFF);
+            }
+        }
+    }
+
+    if (AES_DRBGInstantiate(&AES_DRBG, seed, AES_DRBG_ENTROPY_SIZE, &seed[AES_DRBG_ENTROPY_SIZE], 16,
+                            DRBG_Personalization, sizeof(DRBG_Personalization) - 1) != SUCCESS)
+    {
+        printf("DRBG instantiation failed\r\n");
+    }
+
+    memset(seed, 0, sizeof(seed));
+}
+
+/**
+  * @brief  Compares BENCH_SIZE bytes read from the TRNG one conversion at a
+  *         time with the same amount served by the DRBG.
+  * @note   SysTick runs as a free 24-bit down counter of core cycles.
+  * @param  None
+  * @retval None
+  */
+static void Benchmark(void)
+{
+    uint32_t start;
+    uint32_t cycles;
+    uint32_t i;
+    uint32_t word = 0;
+
+    /* Direct reads: the pool interrupt is stopped meanwhile */
+    NVIC_DisableIRQ(AES_TRNG_EMACC_IRQn);
+    TRNG_ITConfig(DISABLE);
+    start = SysTick->VAL;
+
+    for (i = 0; i < BENCH_SIZE; i += 4)
+    {
+        TRNG_Cmd(ENABLE);
+        (void)TRNG_GetRandomNumber(&word);
+        memcpy(&aRandom[i], &word, 4);
+    }
+
+    cycles = Cycles_Elapsed(start);
+    printf("TRNG polling : %d bytes in %u cycles\r\n", BENCH_SIZE, (unsigned int)cycles);
+
+    TRNG_Cmd(DISABLE);
+    NVIC_EnableIRQ(AES_TRNG_EMACC_IRQn);
+    TRNG_PoolStart(&TRNG_Pool);
+
+    start = SysTick->VAL;
+    (void)AES_DRBGGenerate(&AES_DRBG, aRandom, BENCH_SIZE, NULL, 0);
+    cycles = Cycles_Elapsed(start);
+    printf("AES CTR_DRBG : %d bytes in %u cycles\r\n", BENCH_SIZE, (unsigned int)cycles);
+}
+
+/**
+  * @brief  Displays NB_OF_DISPLAYED_BYTES bytes from the DRBG.
+  * @param  None
+  * @retval None
+  */
+static void Display_Random(void)
+{
+    uint32_t i;
+
+    if (AES_DRBGGenerate(&AES_DRBG, aRandom, NB_OF_DISPLAYED_BYTES, NULL, 0) != SUCCESS)
+    {
+        printf("DRBG request failed\r\n");
+        return;
+    }
+
+    for (i = 0; i < NB_OF_DISPLAYED_BYTES; i++)
+    {
+        printf("%02x%s", aRandom[i], ((i & 15) == 15) ? "\r\n" : " ");
+    }
+}
+
+/**
+  * @brief  Displays the pool and DRBG counters.
+  * @param  None
+  * @retval None
+  */
+static void Display_PoolStatus(void)
+{
+    printf("Pool: %u bytes, %u words kept, %u health failures, %u seed errors%s\r\n",
+           (unsigned int)TRNG_PoolGetCount(&TRNG_Pool), (unsigned int)TRNG_Pool.Words,
+           (unsigned int)TRNG_Pool.HealthFailures, (unsigned int)TRNG_Pool.SeedErrors,
+           (TRNG_Pool.Error != 0) ? ", stopped" : "");
+    printf("DRBG: %u reseeds\r\n", (unsigned int)AES_DRBG.Reseeds);
+}
+
+/**
+  * @brief  Core cycles since a SysTick value, below 2^24.
+  * @param  Start: SysTick->VAL at the start of the measure.
+  * @retval Number of cycles.
+  */
+static uint32_t Cycles_Elapsed(uint32_t Start)
+{
+    return (Start - SysTick->VAL) & SysTick_LOAD_RELOAD_Msk;
+}
+
+/**
+  * @brief  Inserts a delay time.
+  * @param  nCount: specifies the delay time length.
+  * @retval None
+  */
+static void Delay(__IO uint32_t nCount)
+{
+    /* Decrement nCount value */
+    while (nCount != 0)
+    {
+        nCount--;
+    }
+}
+
+/**
+  * @brief  This function configures TRNG, AES and DMA.
+  * @note   This function is used to :
+  *         -1- Enable peripheral clocks for TRNG, AES and DMA.
+  *         -2- Remap DMA channels 1 and 2 to the AES requests.
+  *         -3- NVIC Configuration for TRNG interrupts.
+  *         -4- SysTick as a free-running cycle counter.
+  * @param  None
+  * @retval None
+  */
+static void Configure_Config(void)
+{
+    NVIC_InitTypeDef NVIC_InitStruct;
+
+    /* Enable TRNG clock source */
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_TRNG, ENABLE);
+
+    /* AES clock, DMA channels remapped to the AES requests */
+    AES_DeInit();
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRYPT, ENABLE);
+    RCC_AHBPeriphClockCmd(AES_DMA_CLK, ENABLE);
+    DMA_RemapConfig(DMA, AES_DMA_IN_REMAP);
+    DMA_RemapConfig(DMA, AES_DMA_OUT_REMAP);
+
+    /* NVIC Configuration for TRNG interrupts */
+    NVIC_InitStruct.NVIC_IRQChannel = AES_TRNG_EMACC_IRQn;
+    NVIC_InitStruct.NVIC_IRQChannelPriority = 1;
+    NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStruct);
+
+    /* SysTick counts core cycles, without interrupt */
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+}
+
+#ifdef  USE_FULL_ASSERT
+
+/**
+  * @brief  Reports the name of the source file and the source line number
+  *         where the assert_param error has occurred.
+  * @param  file: pointer to the source file name
+  * @param  line: assert_param error line source number
+  * @retval None
+  */
+void assert_failed(uint8_t* file, uint32_t line)
+{
+    /* User can add his own implementation to report the file name and line number,
+       ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
+
+    /* Infinite loop */
+    while (1)
+    {
+    }
+}
+#endif
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+
+
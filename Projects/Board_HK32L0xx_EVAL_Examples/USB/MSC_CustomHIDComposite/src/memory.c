@@ -29,7 +29,7 @@ __IO uint32_t Block_Read_count = 0;
 __IO uint32_t Block_offset;
 __IO uint32_t Counter = 0;
 uint32_t  Idx;
-uint32_t Data_Buffer[1024]; /* 1024 bytes*/
+uint32_t Data_Buffer[1024]; /* one 4 KB block */
 uint8_t TransferState = TXFR_IDLE;
 
 /* Extern variables ----------------------------------------------------------*/
@@ -47,6 +47,12 @@ extern uint32_t Mass_Block_Size[2];
 
 /**
   * @brief  Handle the Read operation from the microSD card.
+  * @note   The next block is read ahead in place: once a packet is copied to
+  *         the PMA and validated, its slot in Data_Buffer is refilled with the
+  *         same slice of the next block while the packet is on the bus. A
+  *         4 KB block leaves no RAM for a second buffer, and the slot is free
+  *         as soon as USB_SIL_Write() returns. Only the first block of a
+  *         transfer is read before its first packet.
   * @retval None.
   */
 void Read_Memory(uint8_t lun, uint32_t Memory_Offset, uint32_t Transfer_Length)
@@ -58,32 +64,41 @@ void Read_Memory(uint8_t lun, uint32_t Memory_Offset, uint32_t Transfer_Length)
         Offset = Memory_Offset * Mass_Block_Size[lun];
         Length = Transfer_Length * Mass_Block_Size[lun];
         TransferState = TXFR_ONGOING;
+
+        MAL_Read(lun,
+                 Offset,
+                 Data_Buffer,
+                 Mass_Block_Size[lun]);
+
+        Block_Read_count = Mass_Block_Size[lun];
+        Block_offset = 0;
     }
 
     if (TransferState == TXFR_ONGOING )
     {
-        if (!Block_Read_count)
+        USB_SIL_Write(EP2_IN, (uint8_t *)Data_Buffer + Block_offset, BULK_MAX_PACKET_SIZE);
+
+        SetEPTxCount(ENDP2, BULK_MAX_PACKET_SIZE);
+        SetEPTxStatus(ENDP2, EP_TX_VALID);
+
+        /* Read the same slice of the next block while the packet is sent */
+        if (Length > Mass_Block_Size[lun])
         {
             MAL_Read(lun,
-                     Offset,
-                     Data_Buffer,
-                     Mass_Block_Size[lun]);
+                     Offset + Mass_Block_Size[lun],
+                     (uint32_t *)((uint8_t *)Data_Buffer + Block_offset),
+                     BULK_MAX_PACKET_SIZE);
+        }
 
-            USB_SIL_Write(EP2_IN, (uint8_t *)Data_Buffer, BULK_MAX_PACKET_SIZE);
+        Block_Read_count -= BULK_MAX_PACKET_SIZE;
+        Block_offset += BULK_MAX_PACKET_SIZE;
 
-            Block_Read_count = Mass_Block_Size[lun] - BULK_MAX_PACKET_SIZE;
-            Block_offset = BULK_MAX_PACKET_SIZE;
-        }
-        else
+        if (Block_Read_count == 0)
         {
-            USB_SIL_Write(EP2_IN, (uint8_t *)Data_Buffer + Block_offset, BULK_MAX_PACKET_SIZE);
-
-            Block_Read_count -= BULK_MAX_PACKET_SIZE;
-            Block_offset += BULK_MAX_PACKET_SIZE;
+            Block_Read_count = Mass_Block_Size[lun];
+            Block_offset = 0;
         }
 
-        SetEPTxCount(ENDP2, BULK_MAX_PACKET_SIZE);
-        SetEPTxStatus(ENDP2, EP_TX_VALID);
         Offset += BULK_MAX_PACKET_SIZE;
         Length -= BULK_MAX_PACKET_SIZE;
 
@@ -21,6 +21,10 @@ extern "C" {
 #define MAL_FAIL 1
 #define MAX_LUN  1
 
+/* Block size seen by the host, the write-back cache merges the blocks of a
+   SPI FLASH sector */
+#define MAL_BLOCK_SIZE  512
+
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
 
@@ -28,6 +32,10 @@ uint16_t MAL_Init (uint8_t lun);
 uint16_t MAL_GetStatus (uint8_t lun);
 uint16_t MAL_Read(uint8_t lun, uint32_t Memory_Offset, uint32_t *Readbuff, uint16_t Transfer_Length);
 uint16_t MAL_Write(uint8_t lun, uint32_t Memory_Offset, uint32_t *Writebuff, uint16_t Transfer_Length);
+uint16_t MAL_Flush(uint8_t lun);
+void MAL_Process(void);
+
+extern __IO uint8_t MAL_FlushRequest;
 
 #ifdef __cplusplus
 }
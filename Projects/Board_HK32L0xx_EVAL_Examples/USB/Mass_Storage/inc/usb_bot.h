@@ -77,6 +77,8 @@ void CBW_Decode(void);
 void Transfer_Data_Request(uint8_t* Data_Pointer, uint16_t Data_Len);
 void Set_CSW (uint8_t CSW_Status, uint8_t Send_Permission);
 void Bot_Abort(uint8_t Direction);
+void Bot_Reset_Buffers(uint8_t Direction);
+void Bot_Send_EP1(uint8_t* Data_Pointer, uint16_t Data_Len);
 
 #ifdef __cplusplus
 }
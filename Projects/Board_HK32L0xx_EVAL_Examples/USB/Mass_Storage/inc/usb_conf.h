@@ -41,12 +41,14 @@ extern "C" {
 #define ENDP0_TXADDR        (0x58)
 
 /* EP1  */
-/* tx buffer base address */
-#define ENDP1_TXADDR        (0x98)
+/* double buffered tx buffer base addresses */
+#define ENDP1_BUF0ADDR      (0x98)
+#define ENDP1_BUF1ADDR      (0xD8)
 
 /* EP2  */
-/* Rx buffer base address */
-#define ENDP2_RXADDR        (0xD8)
+/* double buffered rx buffer base addresses */
+#define ENDP2_BUF0ADDR      (0x118)
+#define ENDP2_BUF1ADDR      (0x158)
 
 
 /* ISTR events */
@@ -56,6 +58,15 @@ extern "C" {
 #define IMR_MSK (CNTR_CTRM  | CNTR_WKUPM | CNTR_SUSPM | CNTR_ERRM  | CNTR_SOFM \
                  | CNTR_ESOFM | CNTR_RESETM )
 
+/*#define CTR_CALLBACK*/
+/*#define DOVR_CALLBACK*/
+/*#define ERR_CALLBACK*/
+/*#define WKUP_CALLBACK*/
+/*#define SUSP_CALLBACK*/
+/*#define RESET_CALLBACK*/
+#define SOF_CALLBACK
+/*#define ESOF_CALLBACK*/
+
 /* CTR service routines */
 /* associated to defined endpoints */
 //#define  EP1_IN_Callback   NOP_Process
@@ -51,6 +51,7 @@ extern "C" {
 
 #define SCSI_SEND_DIAGNOSTIC                        0x1D
 #define SCSI_READ_FORMAT_CAPACITIES                 0x23
+#define SCSI_SYNCHRONIZE_CACHE10                    0x35
 
 #define NO_SENSE                            0
 #define RECOVERED_ERROR                         1
@@ -75,6 +76,7 @@ extern "C" {
 #define ADDRESS_OUT_OF_RANGE                        0x21
 #define MEDIUM_NOT_PRESENT              0x3A
 #define MEDIUM_HAVE_CHANGED             0x28
+#define WRITE_FAULT                     0x03
 
 #define READ_FORMAT_CAPACITY_DATA_LEN               0x0C
 #define READ_CAPACITY10_DATA_LEN                    0x08
@@ -105,6 +107,7 @@ void SCSI_ModeSense10_Cmd (uint8_t lun);
 void SCSI_Write10_Cmd(uint8_t lun, uint32_t LBA, uint32_t BlockNbr);
 void SCSI_Read10_Cmd(uint8_t lun, uint32_t LBA, uint32_t BlockNbr);
 void SCSI_Verify10_Cmd(uint8_t lun);
+void SCSI_SynchronizeCache_Cmd(uint8_t lun);
 
 void SCSI_Invalid_Cmd(uint8_t lun);
 void SCSI_Valid_Cmd(uint8_t lun);
@@ -13,6 +13,7 @@
 #include "main.h"
 #include "hw_config.h"
 #include "spi_flash.h"
+#include "mass_mal.h"
 
 /** @addtogroup HK32L0xx_StdPeriph_Examples
   * @{
@@ -57,7 +58,8 @@ int main(void)
     /* Infinite loop */
     while (1)
     {
-
+        /* Write back the MAL cache when the USB bus is idle */
+        MAL_Process();
     }
 }
 
@@ -13,19 +13,110 @@
 #include "platform_config.h"
 #include "mass_mal.h"
 #include "spi_flash.h"
+#include <string.h>
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+#define MAL_CACHE_SIZE          FLASH_SectorSize
+#define MAL_CACHE_INVALID       0xFFFFFFFF
+#define MAL_CACHE_PAGES         (MAL_CACHE_SIZE / SPI_FLASH_PageSize)
+#define MAL_COMPARE_CHUNK       64
+
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 uint32_t Mass_Memory_Size[2];
 uint32_t Mass_Block_Size[2];
 uint32_t Mass_Block_Count[2];
 __IO uint32_t Status = 0;
+__IO uint8_t MAL_FlushRequest = 0;
+
+/* Write-back cache holding one erase sector of the SPI FLASH */
+static uint32_t MAL_Cache[MAL_CACHE_SIZE / 4];
+static uint32_t MAL_CacheAddr = MAL_CACHE_INVALID;
+static uint8_t MAL_CacheDirty = 0;
 
 /* Private function prototypes -----------------------------------------------*/
+static uint16_t MAL_CacheWriteBack(void);
+
 /* Private functions ---------------------------------------------------------*/
 
+/**
+  * @brief  Write the cached sector back to the SPI FLASH.
+  * @note   The sector is compared with the FLASH content first: unchanged
+  *         data is not written at all, and the erase is skipped when the new
+  *         data only clears bits (e.g. the sector is already erased). Only
+  *         the pages which need programming are written, then read back.
+  * @retval MAL_OK, or MAL_FAIL when the FLASH content differs from the cache
+  */
+static uint16_t MAL_CacheWriteBack(void)
+{
+    uint8_t Chunk[MAL_COMPARE_CHUNK];
+    uint8_t* pCache = (uint8_t *)MAL_Cache;
+    uint32_t Offset, i;
+    uint32_t DiffPages = 0, DataPages = 0;
+    uint8_t NeedErase = 0;
+
+    for (Offset = 0; Offset < MAL_CACHE_SIZE; Offset += MAL_COMPARE_CHUNK)
+    {
+        SPI_FLASH_BufferRead(Chunk, MAL_CacheAddr + Offset, MAL_COMPARE_CHUNK);
+
+        for (i = 0; i < MAL_COMPARE_CHUNK; i++)
+        {
+            if (pCache[Offset + i] != 0xFF)
+            {
+                DataPages |= (uint32_t)1 << ((Offset + i) / SPI_FLASH_PageSize);
+            }
+
+            if (Chunk[i] != pCache[Offset + i])
+            {
+                DiffPages |= (uint32_t)1 << ((Offset + i) / SPI_FLASH_PageSize);
+
+                /* NOR FLASH programming can only clear bits */
+                if ((Chunk[i] & pCache[Offset + i]) != pCache[Offset + i])
+                {
+                    NeedErase = 1;
+                }
+            }
+        }
+    }
+
+    if (NeedErase)
+    {
+        SPI_FLASH_SectorErase(MAL_CacheAddr);
+
+        /* Erased pages already read back as 0xFF */
+        DiffPages = DataPages;
+    }
+
+    for (i = 0; i < MAL_CACHE_PAGES; i++)
+    {
+        if (DiffPages & ((uint32_t)1 << i))
+        {
+            SPI_FLASH_PageWrite(pCache + (i * SPI_FLASH_PageSize),
+                                MAL_CacheAddr + (i * SPI_FLASH_PageSize),
+                                SPI_FLASH_PageSize);
+        }
+    }
+
+    /* A worn or write protected sector does not keep the data */
+    for (Offset = 0; Offset < MAL_CACHE_SIZE; Offset += MAL_COMPARE_CHUNK)
+    {
+        if (!(DiffPages & ((uint32_t)1 << (Offset / SPI_FLASH_PageSize))))
+        {
+            continue;
+        }
+
+        SPI_FLASH_BufferRead(Chunk, MAL_CacheAddr + Offset, MAL_COMPARE_CHUNK);
+
+        if (memcmp(Chunk, pCache + Offset, MAL_COMPARE_CHUNK) != 0)
+        {
+            return MAL_FAIL;
+        }
+    }
+
+    return MAL_OK;
+}
+
 /**
   * @brief  Initializes the Media on the HK32
   * @retval None
@@ -60,17 +151,57 @@ uint16_t MAL_Init(uint8_t lun)
 
 /**
   * @brief  Write sectors
-  * @retval None
+  * @note   The data is stored in the write-back cache, it reaches the FLASH
+  *         when another sector is written or when MAL_Flush() is called.
+  *         The host writes MAL_BLOCK_SIZE blocks, so consecutive blocks of a
+  *         FLASH sector are merged in the cache and programmed once.
+  * @retval MAL_OK, or MAL_FAIL when the previous cached sector could not be
+  *         written back (the new data is not stored)
   */
 uint16_t MAL_Write(uint8_t lun, uint32_t Memory_Offset, uint32_t *Writebuff, uint16_t Transfer_Length)
 {
+    const uint8_t* pBuffer = (const uint8_t *)Writebuff;
+    uint32_t Sector, Offset, Count;
 
     switch (lun)
     {
         case 0:
             //printf("write add =%d.length=%d\n",Memory_Offset,Transfer_Length);
-            SPI_FLASH_SectorErase(Memory_Offset);
-            SPI_FLASH_BufferWrite((uint8_t *)Writebuff, Memory_Offset, Transfer_Length);
+            while (Transfer_Length)
+            {
+                Sector = Memory_Offset & ~((uint32_t)MAL_CACHE_SIZE - 1);
+                Offset = Memory_Offset - Sector;
+                Count = MAL_CACHE_SIZE - Offset;
+
+                if (Count > Transfer_Length)
+                {
+                    Count = Transfer_Length;
+                }
+
+                if (Sector != MAL_CacheAddr)
+                {
+                    if (MAL_Flush(lun) != MAL_OK)
+                    {
+                        return MAL_FAIL;
+                    }
+
+                    /* A partial write is merged with the current sector content */
+                    if (Count != MAL_CACHE_SIZE)
+                    {
+                        SPI_FLASH_BufferRead((uint8_t *)MAL_Cache, Sector, MAL_CACHE_SIZE);
+                    }
+
+                    MAL_CacheAddr = Sector;
+                }
+
+                memcpy((uint8_t *)MAL_Cache + Offset, pBuffer, Count);
+                MAL_CacheDirty = 1;
+
+                pBuffer += Count;
+                Memory_Offset += Count;
+                Transfer_Length -= Count;
+            }
+
             break;
 
         default:
@@ -86,12 +217,68 @@ uint16_t MAL_Write(uint8_t lun, uint32_t Memory_Offset, uint32_t *Writebuff, uin
   */
 uint16_t MAL_Read(uint8_t lun, uint32_t Memory_Offset, uint32_t *Readbuff, uint16_t Transfer_Length)
 {
+    uint8_t* pBuffer = (uint8_t *)Readbuff;
+    uint32_t Sector, Offset, Count;
 
     switch (lun)
     {
         case 0:
             //printf("read add =%d.length=%d\n",Memory_Offset,Transfer_Length);
-            SPI_FLASH_BufferRead((uint8_t *)Readbuff, Memory_Offset, Transfer_Length);
+            while (Transfer_Length)
+            {
+                Sector = Memory_Offset & ~((uint32_t)MAL_CACHE_SIZE - 1);
+                Offset = Memory_Offset - Sector;
+                Count = MAL_CACHE_SIZE - Offset;
+
+                if (Count > Transfer_Length)
+                {
+                    Count = Transfer_Length;
+                }
+
+                if (Sector == MAL_CacheAddr)
+                {
+                    memcpy(pBuffer, (uint8_t *)MAL_Cache + Offset, Count);
+                }
+                else
+                {
+                    SPI_FLASH_BufferRead(pBuffer, Memory_Offset, Count);
+                }
+
+                pBuffer += Count;
+                Memory_Offset += Count;
+                Transfer_Length -= Count;
+            }
+
+            break;
+
+        default:
+            return MAL_FAIL;
+    }
+
+    return MAL_OK;
+}
+
+/**
+  * @brief  Write the cached sector back to the media.
+  * @note   Called on SYNCHRONIZE CACHE, on eject and from MAL_Process() when
+  *         the bus is idle. A failed sector stays dirty and is retried.
+  * @retval MAL_OK or MAL_FAIL
+  */
+uint16_t MAL_Flush(uint8_t lun)
+{
+    switch (lun)
+    {
+        case 0:
+            if (MAL_CacheDirty)
+            {
+                if (MAL_CacheWriteBack() != MAL_OK)
+                {
+                    return MAL_FAIL;
+                }
+
+                MAL_CacheDirty = 0;
+            }
+
             break;
 
         default:
@@ -101,6 +288,25 @@ uint16_t MAL_Read(uint8_t lun, uint32_t Memory_Offset, uint32_t *Readbuff, uint1
     return MAL_OK;
 }
 
+/**
+  * @brief  Write back the cache when the SOF callback saw an idle bus.
+  * @note   Called from the main loop. The USB interrupt, which also accesses
+  *         the cache and the SPI FLASH, is masked during the write-back: a
+  *         packet received meanwhile is NAKed until it is serviced. A failure
+  *         is reported by the next SYNCHRONIZE CACHE.
+  * @retval None
+  */
+void MAL_Process(void)
+{
+    if (MAL_FlushRequest)
+    {
+        NVIC_DisableIRQ(USB_DVSQ_IRQn);
+        MAL_FlushRequest = 0;
+        MAL_Flush(0);
+        NVIC_EnableIRQ(USB_DVSQ_IRQn);
+    }
+}
+
 /**
   * @brief  Get status
   * @retval None
@@ -113,11 +319,11 @@ uint16_t MAL_GetStatus(uint8_t lun)
 
         if (SPI_FLASH_ReadID() == sFLASH_ID)
         {
-            //Flash Sector size
-            Mass_Block_Size[0]  = FLASH_SectorSize;
+            //Logical block size, several blocks per Flash Sector
+            Mass_Block_Size[0]  = MAL_BLOCK_SIZE;
 
-            //Flash Sector number
-            Mass_Block_Count[0] = FLASH_SectorNum;
+            //Logical block number
+            Mass_Block_Count[0] = FLASH_SectorNum * (FLASH_SectorSize / MAL_BLOCK_SIZE);
 
             //Flash memory size
             Mass_Memory_Size[0] = Mass_Block_Size[0] * Mass_Block_Count[0];
@@ -24,17 +24,17 @@
 /* Private define ------------------------------------------------------------*/
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
-__IO uint32_t Block_Read_count = 0;
 __IO uint32_t Block_offset;
 __IO uint32_t Counter = 0;
 uint32_t  Idx;
-uint32_t Data_Buffer[1024]; /* 1024 bytes*/
+uint32_t Data_Buffer[2 * MAL_BLOCK_SIZE / 4]; /* block being sent, block read ahead */
 uint8_t TransferState = TXFR_IDLE;
 
 /* Extern variables ----------------------------------------------------------*/
 extern uint8_t Bulk_Data_Buff[BULK_MAX_PACKET_SIZE];  /* data buffer*/
 extern uint16_t Data_Len;
 extern uint8_t Bot_State;
+extern uint8_t Bot_Tx_Pending;
 extern Bulk_Only_CBW CBW;
 extern Bulk_Only_CSW CSW;
 extern uint32_t Mass_Memory_Size[2];
@@ -46,43 +46,59 @@ extern uint32_t Mass_Block_Size[2];
 
 /**
   * @brief  Handle the Read operation from the microSD card.
+  * @note   Data_Buffer holds two blocks. While block N is sent from one half,
+  *         block N+1 is read into the other half one packet-sized slice per
+  *         packet of block N. Each slice is read while the previous packet is
+  *         on the bus, so the FLASH read of the next block overlaps the USB
+  *         transfer of the current one instead of stalling the bus at every
+  *         block boundary. Only the first block of a transfer is read up front.
   * @retval None.
   */
 void Read_Memory(uint8_t lun, uint32_t Memory_Offset, uint32_t Transfer_Length)
 {
     static uint32_t Offset, Length;
+    static uint32_t Block_Half;
+    uint8_t* block;
 
     if (TransferState == TXFR_IDLE )
     {
         Offset = Memory_Offset * Mass_Block_Size[lun];
         Length = Transfer_Length * Mass_Block_Size[lun];
         TransferState = TXFR_ONGOING;
+        Block_offset = 0;
+        Block_Half = 0;
+
+        MAL_Read(lun,
+                 Offset,
+                 Data_Buffer,
+                 Mass_Block_Size[lun]);
     }
 
-    if (TransferState == TXFR_ONGOING )
+    while ((TransferState == TXFR_ONGOING) && (Length != 0) && !Bot_Tx_Pending)
     {
-        if (!Block_Read_count)
+        block = (uint8_t *)Data_Buffer + Block_Half * MAL_BLOCK_SIZE;
+
+        Bot_Send_EP1(block + Block_offset, BULK_MAX_PACKET_SIZE);
+
+        /* Read the same slice of the next block into the other half */
+        if (Length > Mass_Block_Size[lun])
         {
+            block = (uint8_t *)Data_Buffer + (Block_Half ^ 1) * MAL_BLOCK_SIZE;
+
             MAL_Read(lun,
-                     Offset,
-                     Data_Buffer,
-                     Mass_Block_Size[lun]);
+                     Offset + Mass_Block_Size[lun],
+                     (uint32_t *)(block + Block_offset),
+                     BULK_MAX_PACKET_SIZE);
+        }
 
-            USB_SIL_Write(EP1_IN, (uint8_t *)Data_Buffer, BULK_MAX_PACKET_SIZE);
+        Block_offset += BULK_MAX_PACKET_SIZE;
 
-            Block_Read_count = Mass_Block_Size[lun] - BULK_MAX_PACKET_SIZE;
-            Block_offset = BULK_MAX_PACKET_SIZE;
-        }
-        else
+        if (Block_offset == Mass_Block_Size[lun])
         {
-            USB_SIL_Write(EP1_IN, (uint8_t *)Data_Buffer + Block_offset, BULK_MAX_PACKET_SIZE);
-
-            Block_Read_count -= BULK_MAX_PACKET_SIZE;
-            Block_offset += BULK_MAX_PACKET_SIZE;
+            Block_offset = 0;
+            Block_Half ^= 1;
         }
 
-        SetEPTxCount(ENDP1, BULK_MAX_PACKET_SIZE);
-        SetEPTxStatus(ENDP1, EP_TX_VALID);
         Offset += BULK_MAX_PACKET_SIZE;
         Length -= BULK_MAX_PACKET_SIZE;
 
@@ -91,7 +107,6 @@ void Read_Memory(uint8_t lun, uint32_t Memory_Offset, uint32_t Transfer_Length)
 
     if (Length == 0)
     {
-        Block_Read_count = 0;
         Block_offset = 0;
         Offset = 0;
         Bot_State = BOT_DATA_IN_LAST;
@@ -107,6 +122,7 @@ void Write_Memory(uint8_t lun, uint32_t Memory_Offset, uint32_t Transfer_Length)
 {
 
     static uint32_t W_Offset, W_Length;
+    static uint8_t W_Failed;
 
     uint32_t temp =  Counter + 64;
 
@@ -114,6 +130,7 @@ void Write_Memory(uint8_t lun, uint32_t Memory_Offset, uint32_t Transfer_Length)
     {
         W_Offset = Memory_Offset * Mass_Block_Size[lun];
         W_Length = Transfer_Length * Mass_Block_Size[lun];
+        W_Failed = 0;
         TransferState = TXFR_ONGOING;
     }
 
@@ -131,10 +148,14 @@ void Write_Memory(uint8_t lun, uint32_t Memory_Offset, uint32_t Transfer_Length)
         if (!(W_Length % Mass_Block_Size[lun]))
         {
             Counter = 0;
-            MAL_Write(lun,
-                      W_Offset - Mass_Block_Size[lun],
-                      Data_Buffer,
-                      Mass_Block_Size[lun]);
+
+            if (MAL_Write(lun,
+                          W_Offset - Mass_Block_Size[lun],
+                          Data_Buffer,
+                          Mass_Block_Size[lun]) != MAL_OK)
+            {
+                W_Failed = 1;
+            }
         }
 
         CSW.dDataResidue -= Data_Len;
@@ -144,7 +165,17 @@ void Write_Memory(uint8_t lun, uint32_t Memory_Offset, uint32_t Transfer_Length)
     if ((W_Length == 0) || (Bot_State == BOT_CSW_Send))
     {
         Counter = 0;
-        Set_CSW (CSW_CMD_PASSED, SEND_CSW_ENABLE);
+
+        if (W_Failed)
+        {
+            Set_Scsi_Sense_Data(lun, MEDIUM_ERROR, WRITE_FAULT);
+            Set_CSW (CSW_CMD_FAILED, SEND_CSW_ENABLE);
+        }
+        else
+        {
+            Set_CSW (CSW_CMD_PASSED, SEND_CSW_ENABLE);
+        }
+
         TransferState = TXFR_IDLE;
     }
 }
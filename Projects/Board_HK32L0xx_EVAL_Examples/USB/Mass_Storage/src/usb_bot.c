@@ -29,10 +29,13 @@ uint16_t Data_Len;
 Bulk_Only_CBW CBW;
 Bulk_Only_CSW CSW;
 uint32_t SCSI_LBA, SCSI_BlkLen;
+uint8_t Bot_Tx_Pending = 0;    /* EP1 buffer filled but not yet handed to the USB */
 extern uint32_t Max_Lun;
 
 /* Extern variables ----------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
+static uint16_t Bot_Receive_EP2(uint8_t* Data_Pointer);
+
 /* Extern function prototypes ------------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
 
@@ -42,6 +45,19 @@ extern uint32_t Max_Lun;
   */
 void Mass_Storage_In(void)
 {
+    /* A packet prepared while the previous one was on the bus is handed to
+       the USB now. Only the data stage has something more to prepare */
+    if (Bot_Tx_Pending)
+    {
+        Bot_Tx_Pending = 0;
+        FreeUserBuffer(ENDP1, EP_DBUF_IN);
+
+        if (Bot_State != BOT_DATA_IN)
+        {
+            return;
+        }
+    }
+
     switch (Bot_State)
     {
         case BOT_CSW_Send:
@@ -86,7 +102,7 @@ void Mass_Storage_Out(void)
     uint8_t CMD;
     CMD = CBW.CB[0];
 
-    Data_Len = USB_SIL_Read(EP2_OUT, Bulk_Data_Buff);
+    Data_Len = Bot_Receive_EP2(Bulk_Data_Buff);
 
     switch (Bot_State)
     {
@@ -216,6 +232,10 @@ void CBW_Decode(void)
                     SCSI_Format_Cmd(CBW.bLUN);
                     break;
 
+                case SCSI_SYNCHRONIZE_CACHE10:
+                    SCSI_SynchronizeCache_Cmd(CBW.bLUN);
+                    break;
+
                 /*Unsupported command*/
                 case SCSI_MODE_SELECT10:
                     SCSI_Mode_Select10_Cmd(CBW.bLUN);
@@ -291,7 +311,7 @@ void CBW_Decode(void)
   */
 void Transfer_Data_Request(uint8_t* Data_Pointer, uint16_t Data_Len)
 {
-    USB_SIL_Write(EP1_IN, Data_Pointer, Data_Len);
+    Bot_Send_EP1(Data_Pointer, Data_Len);
 
     SetEPTxStatus(ENDP1, EP_TX_VALID);
 
@@ -311,13 +331,13 @@ void Set_CSW(uint8_t CSW_Status, uint8_t Send_Permission)
     CSW.dSignature = BOT_CSW_SIGNATURE;
     CSW.bStatus = CSW_Status;
 
-    USB_SIL_Write(EP1_IN, ((uint8_t *)& CSW), CSW_DATA_LENGTH);
-
+    /* Without permission the CSW is sent once the stall is cleared */
     Bot_State = BOT_ERROR;
 
     if (Send_Permission)
     {
         Bot_State = BOT_CSW_Send;
+        Bot_Send_EP1(((uint8_t *)& CSW), CSW_DATA_LENGTH);
         SetEPTxStatus(ENDP1, EP_TX_VALID);
     }
 }
@@ -349,5 +369,94 @@ void Bot_Abort(uint8_t Direction)
     }
 }
 
+/**
+  * @brief  Queue a packet on the double buffered EP1.
+  * @note   The packet is copied to the buffer owned by the application. It is
+  *         handed to the USB at once when the bus is idle, otherwise it waits
+  *         for the end of the packet being sent (see Mass_Storage_In).
+  * @param  Data_Pointer : point to the data to transfer.
+  * @param  Data_Len : the number of Bytes to transfer.
+  * @retval None.
+  */
+void Bot_Send_EP1(uint8_t* Data_Pointer, uint16_t Data_Len)
+{
+    uint16_t wEPVal = GetENDPOINT(ENDP1);
+
+    /* For an IN endpoint SW_BUF is the DTOG_RX bit */
+    if (wEPVal & EP_DTOG_RX)
+    {
+        UserToPMABufferCopy(Data_Pointer, ENDP1_BUF1ADDR, Data_Len);
+        SetEPDblBuf1Count(ENDP1, EP_DBUF_IN, Data_Len);
+    }
+    else
+    {
+        UserToPMABufferCopy(Data_Pointer, ENDP1_BUF0ADDR, Data_Len);
+        SetEPDblBuf0Count(ENDP1, EP_DBUF_IN, Data_Len);
+    }
+
+    /* The USB owns a buffer as long as DTOG_TX differs from SW_BUF */
+    if (((wEPVal & EP_DTOG_TX) != 0) != ((wEPVal & EP_DTOG_RX) != 0))
+    {
+        Bot_Tx_Pending = 1;
+    }
+    else
+    {
+        FreeUserBuffer(ENDP1, EP_DBUF_IN);
+    }
+}
+
+/**
+  * @brief  Read the packet received on the double buffered EP2.
+  * @note   SW_BUF is toggled first so that the USB can receive the next
+  *         packet in the other buffer while this one is processed.
+  * @param  Data_Pointer : point to the buffer receiving the data.
+  * @retval Number of received data (in Bytes).
+  */
+static uint16_t Bot_Receive_EP2(uint8_t* Data_Pointer)
+{
+    uint16_t Len;
+
+    FreeUserBuffer(ENDP2, EP_DBUF_OUT);
+
+    /* For an OUT endpoint SW_BUF is the DTOG_TX bit */
+    if (GetENDPOINT(ENDP2) & EP_DTOG_TX)
+    {
+        Len = GetEPDblBuf1Count(ENDP2);
+        PMAToUserBufferCopy(Data_Pointer, ENDP2_BUF1ADDR, Len);
+    }
+    else
+    {
+        Len = GetEPDblBuf0Count(ENDP2);
+        PMAToUserBufferCopy(Data_Pointer, ENDP2_BUF0ADDR, Len);
+    }
+
+    return Len;
+}
+
+/**
+  * @brief  Reset the data toggle and the buffer ownership of the bulk
+  *         endpoints.
+  * @param  Endpoint direction IN, OUT or both directions
+  * @retval None.
+  */
+void Bot_Reset_Buffers(uint8_t Direction)
+{
+    if (Direction != DIR_OUT)
+    {
+        /* EP1: nothing queued, the application owns buffer 0 */
+        ClearDTOG_TX(ENDP1);
+        ClearDTOG_RX(ENDP1);
+        Bot_Tx_Pending = 0;
+    }
+
+    if (Direction != DIR_IN)
+    {
+        /* EP2: the USB receives in buffer 0, the application owns buffer 1 */
+        ClearDTOG_RX(ENDP2);
+        ClearDTOG_TX(ENDP2);
+        FreeUserBuffer(ENDP2, EP_DBUF_OUT);
+    }
+}
+
 /************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
 
@@ -13,11 +13,19 @@
 #include "usb_lib.h"
 #include "usb_bot.h"
 #include "usb_istr.h"
+#include "usb_pwr.h"
+#include "mass_mal.h"
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+/* Number of idle frames (ms) before the MAL write cache is flushed */
+#define MASS_IDLE_FLUSH_FRAMES      100
+
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+extern uint8_t Bot_State;
+
 /* Private function prototypes -----------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
 
@@ -39,6 +47,28 @@ void EP2_OUT_Callback(void)
     Mass_Storage_Out();
 }
 
+/**
+  * @brief  sof callback
+  * @retval None.
+  */
+void SOF_Callback(void)
+{
+    static uint32_t IdleFrames = 0;
+
+    if ((bDeviceState != CONFIGURED) || (Bot_State != BOT_IDLE))
+    {
+        IdleFrames = 0;
+        return;
+    }
+
+    /* Let the main loop write back the cached sector once the host stopped
+       accessing the disk: programming the FLASH takes too long for an ISR */
+    if (++IdleFrames == MASS_IDLE_FLUSH_FRAMES)
+    {
+        MAL_FlushRequest = 1;
+    }
+}
+
 /************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
 
 
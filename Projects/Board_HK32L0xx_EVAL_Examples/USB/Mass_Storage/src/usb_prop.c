@@ -85,6 +85,7 @@ ONE_DESCRIPTOR String_Descriptor[5] =
 /* Extern variables ----------------------------------------------------------*/
 extern unsigned char Bot_State;
 extern Bulk_Only_CBW CBW;
+extern Bulk_Only_CSW CSW;
 
 /* Private function prototypes -----------------------------------------------*/
 
@@ -135,19 +136,25 @@ void MASS_Reset()
     Clear_Status_Out(ENDP0);
     SetEPRxValid(ENDP0);
 
-    /* Initialize Endpoint 1 */
+    /* Initialize Endpoint 1, double buffered: the endpoint stays valid and
+       NAKs by itself as long as no buffer is handed to the USB */
     SetEPType(ENDP1, EP_BULK);
-    SetEPTxAddr(ENDP1, ENDP1_TXADDR);
-    SetEPTxStatus(ENDP1, EP_TX_NAK);
+    SetEPDoubleBuff(ENDP1);
+    SetEPDblBuffAddr(ENDP1, ENDP1_BUF0ADDR, ENDP1_BUF1ADDR);
+    SetEPDblBuffCount(ENDP1, EP_DBUF_IN, 0);
+    SetEPTxStatus(ENDP1, EP_TX_VALID);
     SetEPRxStatus(ENDP1, EP_RX_DIS);
 
-    /* Initialize Endpoint 2 */
+    /* Initialize Endpoint 2, double buffered */
     SetEPType(ENDP2, EP_BULK);
-    SetEPRxAddr(ENDP2, ENDP2_RXADDR);
-    SetEPRxCount(ENDP2, Device_Property.MaxPacketSize);
+    SetEPDoubleBuff(ENDP2);
+    SetEPDblBuffAddr(ENDP2, ENDP2_BUF0ADDR, ENDP2_BUF1ADDR);
+    SetEPDblBuffCount(ENDP2, EP_DBUF_OUT, Device_Property.MaxPacketSize);
     SetEPRxStatus(ENDP2, EP_RX_VALID);
     SetEPTxStatus(ENDP2, EP_TX_DIS);
 
+    Bot_Reset_Buffers(BOTH_DIR);
+
 
     SetEPRxCount(ENDP0, Device_Property.MaxPacketSize);
     SetEPRxValid(ENDP0);
@@ -172,8 +179,7 @@ void Mass_Storage_SetConfiguration(void)
         /* Device configured */
         bDeviceState = CONFIGURED;
 
-        ClearDTOG_TX(ENDP1);
-        ClearDTOG_RX(ENDP2);
+        Bot_Reset_Buffers(BOTH_DIR);
 
         Bot_State = BOT_IDLE; /* set the Bot state machine to the IDLE state */
     }
@@ -190,6 +196,25 @@ void Mass_Storage_ClearFeature(void)
     if (CBW.dSignature != BOT_CBW_SIGNATURE)
     {
         Bot_Abort(BOTH_DIR);
+        return;
+    }
+
+    /* The core only clears the data toggle, also give the buffers of the
+       released endpoint back to their initial owner */
+    if (pInformation->USBwIndex0 & 0x80)
+    {
+        Bot_Reset_Buffers(DIR_IN);
+    }
+    else
+    {
+        Bot_Reset_Buffers(DIR_OUT);
+    }
+
+    /* Send the CSW held back when the endpoint was stalled */
+    if ((Bot_State == BOT_ERROR) && (GetEPTxStatus(ENDP1) == EP_TX_VALID))
+    {
+        Bot_State = BOT_CSW_Send;
+        Bot_Send_EP1((uint8_t *)&CSW, CSW_DATA_LENGTH);
     }
 }
 
@@ -266,11 +291,8 @@ RESULT MASS_NoData_Setup(uint8_t RequestNo)
             && (RequestNo == MASS_STORAGE_RESET) && (pInformation->USBwValue == 0)
             && (pInformation->USBwIndex == 0) && (pInformation->USBwLength == 0x00))
     {
-        /* Initialize Endpoint 1 */
-        ClearDTOG_TX(ENDP1);
-
-        /* Initialize Endpoint 2 */
-        ClearDTOG_RX(ENDP2);
+        /* Initialize Endpoint 1 and Endpoint 2 */
+        Bot_Reset_Buffers(BOTH_DIR);
 
         /*initialize the CBW signature to enable the clear feature*/
         CBW.dSignature = BOT_CBW_SIGNATURE;
@@ -180,6 +180,30 @@ void Set_Scsi_Sense_Data(uint8_t lun, uint8_t Sens_Key, uint8_t Asc)
   */
 void SCSI_Start_Stop_Unit_Cmd(uint8_t lun)
 {
+    /* The medium may be removed after this command, write back the cache */
+    if (MAL_Flush(lun) != MAL_OK)
+    {
+        Set_Scsi_Sense_Data(CBW.bLUN, MEDIUM_ERROR, WRITE_FAULT);
+        Set_CSW (CSW_CMD_FAILED, SEND_CSW_ENABLE);
+        return;
+    }
+
+    Set_CSW (CSW_CMD_PASSED, SEND_CSW_ENABLE);
+}
+
+/**
+  * @brief  SCSI Synchronize_Cache10 Command routine.
+  * @retval None.
+  */
+void SCSI_SynchronizeCache_Cmd(uint8_t lun)
+{
+    if (MAL_Flush(lun) != MAL_OK)
+    {
+        Set_Scsi_Sense_Data(CBW.bLUN, MEDIUM_ERROR, WRITE_FAULT);
+        Set_CSW (CSW_CMD_FAILED, SEND_CSW_ENABLE);
+        return;
+    }
+
     Set_CSW (CSW_CMD_PASSED, SEND_CSW_ENABLE);
 }
 
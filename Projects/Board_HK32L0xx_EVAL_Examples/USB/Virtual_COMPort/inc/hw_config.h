@@ -31,7 +31,7 @@ void USB_Interrupts_Config(void);
 void USB_Cable_Config (FunctionalState NewState);
 bool USART_Config(void);
 void USB_To_USART_Send_Data(uint8_t* data_buffer, uint8_t Nb_bytes);
-void USART_To_USB_Send_Data(void);
+void USART_To_USB_Send_Data(uint32_t Halves);
 void Handle_USBAsynchXfer (void);
 void GPIO_Configuration(void);
 void EXTI_Configuration(void);
@@ -60,6 +60,15 @@ extern "C" {
 #define VCP_USARTx_IRQn                   UART3_4_IRQn
 #define VCP_USARTx_IRQHandler             UART3_4_IRQHandler
 
+#define VCP_USARTx_RX_DMA_CLK             RCC_AHBPeriph_DMA
+#define VCP_USARTx_RX_DMA_CHANNEL         DMA_Channel6
+#define VCP_USARTx_RX_DMA_REMAP           DMA_CSELR_CH6_UART3_RX
+#define VCP_USARTx_RX_DMA_FLAG_HT         DMA1_FLAG_HT6
+#define VCP_USARTx_RX_DMA_FLAG_TC         DMA1_FLAG_TC6
+#define VCP_USARTx_RX_DMA_FLAG_GL         DMA1_FLAG_GL6
+#define VCP_USARTx_RX_DMA_IRQn            DMA_CH4_7_IRQn
+#define VCP_USARTx_RX_DMA_IRQHandler      DMA_CH4_7_IRQHandler
+
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
 
@@ -0,0 +1,59 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  ring_buffer.h
+* @brief:     Header for ring_buffer.c file.
+* @author:    AE Team
+*******************************************************************************/
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __RING_BUFFER_H
+#define __RING_BUFFER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "hk32l0xx.h"
+
+/* Exported types ------------------------------------------------------------*/
+/**
+  * @brief  Single producer / single consumer byte ring buffer.
+  * @note   Head is only written by the producer and Tail only by the
+  *         consumer. Both run freely and are reduced modulo Size on access,
+  *         so Head - Tail is the number of stored bytes even when the
+  *         buffer is full. Size must be a power of two.
+  */
+typedef struct
+{
+    uint8_t* pBuffer;           /*!< Storage, Size bytes */
+    uint32_t Size;              /*!< Storage size, power of two */
+    __IO uint32_t Head;         /*!< Write index, owned by the producer */
+    __IO uint32_t Tail;         /*!< Read index, owned by the consumer */
+    __IO uint32_t Overrun;      /*!< Bytes dropped by the producer */
+} RingBuffer_TypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void RingBuffer_Init(RingBuffer_TypeDef* Ring, uint8_t* pBuffer, uint32_t Size);
+uint32_t RingBuffer_GetCount(RingBuffer_TypeDef* Ring);
+uint32_t RingBuffer_GetFree(RingBuffer_TypeDef* Ring);
+
+/* Producer side */
+uint32_t RingBuffer_Write(RingBuffer_TypeDef* Ring, const uint8_t* pData, uint32_t Length);
+void RingBuffer_SetWritePosition(RingBuffer_TypeDef* Ring, uint32_t Position, uint32_t Halves);
+
+/* Consumer side */
+uint32_t RingBuffer_Read(RingBuffer_TypeDef* Ring, uint8_t* pData, uint32_t Length);
+uint32_t RingBuffer_GetReadSpan(RingBuffer_TypeDef* Ring, uint8_t** ppData);
+void RingBuffer_Consume(RingBuffer_TypeDef* Ring, uint32_t Length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*__RING_BUFFER_H */
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
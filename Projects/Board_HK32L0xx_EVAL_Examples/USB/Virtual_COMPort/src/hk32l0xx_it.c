@@ -97,16 +97,42 @@ void USB_DVSQ_IRQHandler(void)
   */
 void VCP_USARTx_IRQHandler(void)
 {
-    if (USART_GetITStatus(VCP_USARTx, USART_IT_RXNE) != RESET)
+    if (USART_GetITStatus(VCP_USARTx, USART_IT_IDLE) != RESET)
     {
-        /* Send the received data to the PC Host*/
-        USART_To_USB_Send_Data();
+        USART_ClearITPendingBit(VCP_USARTx, USART_IT_IDLE);
+
+        /* End of a burst: send the received data to the PC Host*/
+        USART_To_USB_Send_Data(0);
+    }
+}
+
+/**
+  * @brief  This function handles USART Rx DMA interrupt request.
+  * @param  None
+  * @retval None
+  */
+void VCP_USARTx_RX_DMA_IRQHandler(void)
+{
+    uint32_t Halves = 0;
+
+    /* Each flag is one half of the buffer filled, only the flags counted are
+       cleared so that a boundary crossed meanwhile is not lost */
+    if (DMA_GetFlagStatus(VCP_USARTx_RX_DMA_FLAG_HT) != RESET)
+    {
+        DMA_ClearFlag(VCP_USARTx_RX_DMA_FLAG_HT);
+        Halves++;
     }
 
-    /* If overrun condition occurs, clear the ORE flag and recover communication */
-    if (USART_GetFlagStatus(VCP_USARTx, USART_FLAG_ORE) != RESET)
+    if (DMA_GetFlagStatus(VCP_USARTx_RX_DMA_FLAG_TC) != RESET)
     {
-        (void)USART_ReceiveData(VCP_USARTx);
+        DMA_ClearFlag(VCP_USARTx_RX_DMA_FLAG_TC);
+        Halves++;
+    }
+
+    if (Halves != 0)
+    {
+        /* Send the received data to the PC Host*/
+        USART_To_USB_Send_Data(Halves);
     }
 }
 
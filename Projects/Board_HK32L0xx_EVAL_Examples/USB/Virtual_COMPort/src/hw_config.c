@@ -23,10 +23,6 @@
 /* Extern variables ----------------------------------------------------------*/
 EXTI_InitTypeDef EXTI_InitStructure;
 
-uint32_t USART_Rx_ptr_in = 0;
-uint32_t USART_Rx_ptr_out = 0;
-uint32_t USART_Rx_length  = 0;
-
 uint8_t  USB_Tx_State = 0;
 extern LINE_CODING linecoding;
 /* Private function prototypes -----------------------------------------------*/
@@ -138,6 +134,13 @@ void USB_Interrupts_Config(void)
     NVIC_InitStructure.NVIC_IRQChannelPriority = 1;
     NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
     NVIC_Init(&NVIC_InitStructure);
+
+    /* Enable USART Rx DMA Interrupt, same priority as the USB so that the
+       producer and the consumer of the Rx ring buffer never preempt each other */
+    NVIC_InitStructure.NVIC_IRQChannel = VCP_USARTx_RX_DMA_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPriority = 1;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
 }
 
 /**
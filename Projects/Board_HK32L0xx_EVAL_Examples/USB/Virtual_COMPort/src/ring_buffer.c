@@ -0,0 +1,236 @@
+/*******************************************************************************
+* @copyright: Shenzhen Hangshun Chip Technology R&D Co., Ltd
+* @filename:  ring_buffer.c
+* @brief:     Single producer / single consumer ring buffer.
+* @author:    AE Team
+* @version:   V1.0.0/2023-11-10
+*             1.Initial version
+* @log:
+*******************************************************************************/
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "ring_buffer.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Initializes an empty ring buffer.
+  * @param  Ring: ring buffer to initialize.
+  * @param  pBuffer: storage of Size bytes.
+  * @param  Size: storage size, must be a power of two.
+  * @retval None
+  */
+void RingBuffer_Init(RingBuffer_TypeDef* Ring, uint8_t* pBuffer, uint32_t Size)
+{
+    Ring->pBuffer = pBuffer;
+    Ring->Size = Size;
+    Ring->Head = 0;
+    Ring->Tail = 0;
+    Ring->Overrun = 0;
+}
+
+/**
+  * @brief  Returns the number of bytes waiting in the ring buffer.
+  * @param  Ring: ring buffer.
+  * @retval Number of bytes.
+  */
+uint32_t RingBuffer_GetCount(RingBuffer_TypeDef* Ring)
+{
+    return Ring->Head - Ring->Tail;
+}
+
+/**
+  * @brief  Returns the number of bytes which can still be written.
+  * @param  Ring: ring buffer.
+  * @retval Number of bytes.
+  */
+uint32_t RingBuffer_GetFree(RingBuffer_TypeDef* Ring)
+{
+    return Ring->Size - (Ring->Head - Ring->Tail);
+}
+
+/**
+  * @brief  Copies data into the ring buffer (producer side).
+  * @note   The data is stored before Head is published, so the consumer never
+  *         sees a byte which is not written yet. Data which does not fit is
+  *         dropped and counted in Overrun.
+  * @param  Ring: ring buffer.
+  * @param  pData: data to store.
+  * @param  Length: number of bytes to store.
+  * @retval Number of bytes stored.
+  */
+uint32_t RingBuffer_Write(RingBuffer_TypeDef* Ring, const uint8_t* pData, uint32_t Length)
+{
+    uint32_t head = Ring->Head;
+    uint32_t index = head & (Ring->Size - 1);
+    uint32_t free = Ring->Size - (head - Ring->Tail);
+    uint32_t span;
+
+    if (Length > free)
+    {
+        Ring->Overrun += Length - free;
+        Length = free;
+    }
+
+    span = Ring->Size - index;
+
+    if (span > Length)
+    {
+        span = Length;
+    }
+
+    memcpy(&Ring->pBuffer[index], pData, span);
+    memcpy(Ring->pBuffer, pData + span, Length - span);
+
+    __DMB();
+    Ring->Head = head + Length;
+
+    return Length;
+}
+
+/**
+  * @brief  Publishes data written into the storage by a peripheral (producer
+  *         side), e.g. a DMA channel in circular mode over the storage.
+  * @note   Position is the storage index of the next byte the peripheral
+  *         writes, it repeats every lap. Halves tells the laps apart: it is
+  *         the number of half storage boundaries the peripheral crossed since
+  *         RingBuffer_Init(), e.g. counted on the DMA half and complete
+  *         transfer interrupts. It may lag by one boundary whose interrupt is
+  *         still pending, so a full lap between two calls is seen as a full
+  *         lap and not as an empty buffer. Halves must be counted before
+  *         Position is sampled.
+  * @note   Data overwritten before the consumer read it is counted in Overrun
+  *         and skipped, the whole storage is then treated as unread. While
+  *         the consumer stays lapped, only the bytes written since the last
+  *         call are counted again.
+  * @param  Ring: ring buffer.
+  * @param  Position: write position in the storage, 0 to Size - 1.
+  * @param  Halves: half storage boundaries crossed, free running.
+  * @retval None
+  */
+void RingBuffer_SetWritePosition(RingBuffer_TypeDef* Ring, uint32_t Position, uint32_t Halves)
+{
+    uint32_t head = Halves * (Ring->Size / 2);
+    uint32_t tail = Ring->Tail;
+    uint32_t lost;
+
+    /* First write count not below the last crossed boundary at this position */
+    head += (Position - head) & (Ring->Size - 1);
+
+    lost = head - tail;
+
+    if (lost > Ring->Size)
+    {
+        lost -= Ring->Size;
+
+        /* The previous call already counted the bytes lost up to its head */
+        if ((Ring->Head - tail) > Ring->Size)
+        {
+            lost = head - Ring->Head;
+        }
+
+        Ring->Overrun += lost;
+    }
+
+    __DMB();
+    Ring->Head = head;
+}
+
+/**
+  * @brief  Copies data out of the ring buffer (consumer side).
+  * @param  Ring: ring buffer.
+  * @param  pData: destination.
+  * @param  Length: maximum number of bytes to read.
+  * @retval Number of bytes read.
+  */
+uint32_t RingBuffer_Read(RingBuffer_TypeDef* Ring, uint8_t* pData, uint32_t Length)
+{
+    uint8_t* pSpan;
+    uint32_t span;
+    uint32_t total = 0;
+
+    while (Length != 0)
+    {
+        span = RingBuffer_GetReadSpan(Ring, &pSpan);
+
+        if (span == 0)
+        {
+            break;
+        }
+
+        if (span > Length)
+        {
+            span = Length;
+        }
+
+        memcpy(pData, pSpan, span);
+        RingBuffer_Consume(Ring, span);
+
+        pData += span;
+        Length -= span;
+        total += span;
+    }
+
+    return total;
+}
+
+/**
+  * @brief  Returns the contiguous block of data at the read position
+  *         (consumer side), without copying it.
+  * @note   The block stays valid until RingBuffer_Consume() is called.
+  * @param  Ring: ring buffer.
+  * @param  ppData: receives the address of the first byte.
+  * @retval Number of contiguous bytes, 0 if the ring buffer is empty.
+  */
+uint32_t RingBuffer_GetReadSpan(RingBuffer_TypeDef* Ring, uint8_t** ppData)
+{
+    uint32_t tail = Ring->Tail;
+    uint32_t count = Ring->Head - tail;
+    uint32_t index;
+    uint32_t span;
+
+    /* The producer lapped the consumer, restart from the oldest valid byte */
+    if (count > Ring->Size)
+    {
+        tail = Ring->Head - Ring->Size;
+        Ring->Tail = tail;
+        count = Ring->Size;
+    }
+
+    /* Read Head before the data it covers */
+    __DMB();
+
+    index = tail & (Ring->Size - 1);
+    span = Ring->Size - index;
+
+    if (span > count)
+    {
+        span = count;
+    }
+
+    *ppData = &Ring->pBuffer[index];
+
+    return span;
+}
+
+/**
+  * @brief  Releases data returned by RingBuffer_GetReadSpan() (consumer side).
+  * @param  Ring: ring buffer.
+  * @param  Length: number of bytes to release.
+  * @retval None
+  */
+void RingBuffer_Consume(RingBuffer_TypeDef* Ring, uint32_t Length)
+{
+    /* Done with the data before the producer may reuse it */
+    __DMB();
+    Ring->Tail += Length;
+}
+
+/************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
@@ -16,27 +16,29 @@
 #include "usb_lib.h"
 #include "usb_desc.h"
 #include "usb_prop.h"
+#include "ring_buffer.h"
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
-#define USART_RX_DATA_SIZE   512
+#define USART_RX_DATA_SIZE   512    /* Power of two, see RingBuffer_Init() */
 
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 USART_InitTypeDef USART_InitStructure;
 
 uint8_t  USART_Rx_Buffer[USART_RX_DATA_SIZE];
-extern uint32_t USART_Rx_ptr_in ;
-extern uint32_t USART_Rx_ptr_out ;
-extern uint32_t USART_Rx_length ;
+RingBuffer_TypeDef USART_Rx_Ring;
+static uint32_t USART_Rx_Halves;        /* Half buffer boundaries crossed by the DMA */
+static uint8_t USART_Rx_Packet[VIRTUAL_COM_PORT_DATA_SIZE];
 extern uint8_t  USB_Tx_State ;
-uint16_t USB_Tx_length;
-uint16_t USB_Tx_ptr;
 
 /* Extern variables ----------------------------------------------------------*/
 extern LINE_CODING linecoding;
 
 /* Private function prototypes -----------------------------------------------*/
+static void VCP_RxDMAConfig(void);
+static uint16_t VCP_LoadRxPacket(void);
+
 /* Private functions ---------------------------------------------------------*/
 
 /**
@@ -82,13 +84,59 @@ void HK_EVAL_VCPComInit(USART_InitTypeDef* USART_InitStruct)
     /* USART configuration */
     USART_Init(VCP_USARTx, USART_InitStruct);
 
-    /* Enable the USART Receive interrupt */
-    USART_ITConfig(VCP_USARTx, USART_IT_RXNE, ENABLE);
+    /* The DMA keeps receiving on overrun, the lost bytes cannot be recovered */
+    USART_OverrunDetectionConfig(VCP_USARTx, USART_OVRDetection_Disable);
+
+    /* Receive into USART_Rx_Buffer by DMA in circular mode */
+    VCP_RxDMAConfig();
+    USART_DMACmd(VCP_USARTx, USART_DMAReq_Rx, ENABLE);
+
+    /* Enable the USART Idle line interrupt to hand over partial packets */
+    USART_ClearITPendingBit(VCP_USARTx, USART_IT_IDLE);
+    USART_ITConfig(VCP_USARTx, USART_IT_IDLE, ENABLE);
 
     /* Enable USART */
     USART_Cmd(VCP_USARTx, ENABLE);
 }
 
+/**
+  * @brief  Configures the circular DMA reception of the COM port.
+  * @note   The DMA half transfer and transfer complete interrupts publish the
+  *         received data while the line is busy, the USART Idle line
+  *         interrupt publishes the end of a burst.
+  * @retval None
+  */
+static void VCP_RxDMAConfig(void)
+{
+    DMA_InitTypeDef DMA_InitStructure;
+
+    RCC_AHBPeriphClockCmd(VCP_USARTx_RX_DMA_CLK, ENABLE);
+
+    DMA_Cmd(VCP_USARTx_RX_DMA_CHANNEL, DISABLE);
+    DMA_DeInit(VCP_USARTx_RX_DMA_CHANNEL);
+    DMA_RemapConfig(DMA, VCP_USARTx_RX_DMA_REMAP);
+
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&VCP_USARTx->RDR;
+    DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)USART_Rx_Buffer;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
+    DMA_InitStructure.DMA_BufferSize = USART_RX_DATA_SIZE;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Circular;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+    DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init(VCP_USARTx_RX_DMA_CHANNEL, &DMA_InitStructure);
+
+    RingBuffer_Init(&USART_Rx_Ring, USART_Rx_Buffer, USART_RX_DATA_SIZE);
+    USART_Rx_Halves = 0;
+
+    DMA_ClearFlag(VCP_USARTx_RX_DMA_FLAG_GL);
+    DMA_ITConfig(VCP_USARTx_RX_DMA_CHANNEL, DMA_IT_HT | DMA_IT_TC, ENABLE);
+    DMA_Cmd(VCP_USARTx_RX_DMA_CHANNEL, ENABLE);
+}
+
 
 /**
   * @brief  configure the EVAL_COM1 with default values.
@@ -115,9 +163,6 @@ void USART_Config_Default(void)
 
     /* Configure and enable the USART */
     HK_EVAL_VCPComInit(&USART_InitStructure);
-
-    /* Enable the USART Receive interrupt */
-    USART_ITConfig(VCP_USARTx, USART_IT_RXNE, ENABLE);
 }
 
 /**
@@ -229,48 +274,68 @@ void USB_To_USART_Send_Data(uint8_t* data_buffer, uint8_t Nb_bytes)
     }
 }
 
+/**
+  * @brief  Copy the next packet of received data to the EP1 buffer and
+  *         validate it.
+  * @note   The packet is taken from a contiguous span of the ring buffer, so
+  *         it goes to the PMA in one copy. The storage is written by the DMA
+  *         and is never modified here: 7 bits data is masked in a copy.
+  * @retval Number of bytes sent, 0 if there is no received data.
+  */
+static uint16_t VCP_LoadRxPacket(void)
+{
+    uint8_t* pData;
+    uint32_t Length;
+    uint32_t i;
+
+    Length = RingBuffer_GetReadSpan(&USART_Rx_Ring, &pData);
+
+    if (Length == 0)
+    {
+        return 0;
+    }
+
+    if (Length > VIRTUAL_COM_PORT_DATA_SIZE)
+    {
+        Length = VIRTUAL_COM_PORT_DATA_SIZE;
+    }
+
+    /* 7 data bits: the 8th bit received is the parity bit */
+    if (linecoding.datatype == 7)
+    {
+        for (i = 0; i < Length; i++)
+        {
+            USART_Rx_Packet[i] = pData[i] & 0x7F;
+        }
+
+        pData = USART_Rx_Packet;
+    }
+
+    UserToPMABufferCopy(pData, ENDP1_TXADDR, Length);
+    RingBuffer_Consume(&USART_Rx_Ring, Length);
+
+    SetEPTxCount(ENDP1, Length);
+    SetEPTxValid(ENDP1);
+
+    return Length;
+}
+
 /**
   * @brief  send data from USART_Rx_Buffer to the USB. Manage the segmentation
   *         into USB FIFO buffer. Commit one packet to the USB at each call.
   * @param  globals:
   *         - USB_Tx_State: transmit state variable
-  *         - USART_Rx_Buffer: buffer of data to be sent
-  *         - USART_Rx_length: amount of data (in bytes) ready to be sent
-  *         - USART_Rx_ptr_out: index in USART_Rx_Buffer of the first data to send
+  *         - USART_Rx_Ring: ring buffer of data to be sent
   * @retval none.
   */
 void VCP_SendRxBufPacketToUsb(void)
 {
-    uint16_t USB_Tx_ptr;
-    uint16_t USB_Tx_length;
-
     if (USB_Tx_State == 1)
     {
-        if (USART_Rx_length == 0)
+        if (VCP_LoadRxPacket() == 0)
         {
             USB_Tx_State = 0;
         }
-        else
-        {
-            if (USART_Rx_length > VIRTUAL_COM_PORT_DATA_SIZE)
-            {
-                USB_Tx_ptr = USART_Rx_ptr_out;
-                USB_Tx_length = VIRTUAL_COM_PORT_DATA_SIZE;
-                USART_Rx_ptr_out += VIRTUAL_COM_PORT_DATA_SIZE;
-                USART_Rx_length -= VIRTUAL_COM_PORT_DATA_SIZE;
-            }
-            else
-            {
-                USB_Tx_ptr = USART_Rx_ptr_out;
-                USB_Tx_length = USART_Rx_length;
-                USART_Rx_ptr_out += USART_Rx_length;
-                USART_Rx_length = 0;
-            }
-
-            UserToPMABufferCopy(&USART_Rx_Buffer[USB_Tx_ptr], ENDP1_TXADDR, USB_Tx_length);
-            SetEPTxCount(ENDP1, USB_Tx_length);
-            SetEPTxValid(ENDP1);
-        }
     }
 }
 
@@ -282,72 +347,30 @@ void Handle_USBAsynchXfer(void)
 {
     if (USB_Tx_State != 1)
     {
-        if (USART_Rx_ptr_out == USART_RX_DATA_SIZE)
+        if (VCP_LoadRxPacket() != 0)
         {
-            USART_Rx_ptr_out = 0;
+            USB_Tx_State = 1;
         }
-
-        if (USART_Rx_ptr_out == USART_Rx_ptr_in)
-        {
-            USB_Tx_State = 0;
-            return;
-        }
-
-        if (USART_Rx_ptr_out > USART_Rx_ptr_in) /* rollback */
-        {
-            USART_Rx_length = USART_RX_DATA_SIZE - USART_Rx_ptr_out;
-        }
-        else
-        {
-            USART_Rx_length = USART_Rx_ptr_in - USART_Rx_ptr_out;
-        }
-
-        if (USART_Rx_length > VIRTUAL_COM_PORT_DATA_SIZE)
-        {
-            USB_Tx_ptr = USART_Rx_ptr_out;
-            USB_Tx_length = VIRTUAL_COM_PORT_DATA_SIZE;
-            USART_Rx_ptr_out += VIRTUAL_COM_PORT_DATA_SIZE;
-            USART_Rx_length -= VIRTUAL_COM_PORT_DATA_SIZE;
-        }
-        else
-        {
-            USB_Tx_ptr = USART_Rx_ptr_out;
-            USB_Tx_length = USART_Rx_length;
-            USART_Rx_ptr_out += USART_Rx_length;
-            USART_Rx_length = 0;
-        }
-
-        USB_Tx_State = 1;
-        UserToPMABufferCopy(&USART_Rx_Buffer[USB_Tx_ptr], ENDP1_TXADDR, USB_Tx_length);
-        SetEPTxCount(ENDP1, USB_Tx_length);
-        SetEPTxValid(ENDP1);
     }
 }
 
 /**
-  * @brief  send the received data from UART 0 to USB
+  * @brief  Publish the data received by DMA in USART_Rx_Buffer, to be sent to
+  *         the USB.
+  * @note   Called from the USART Idle line and the DMA half/complete transfer
+  *         interrupts, which are the only producer of USART_Rx_Ring.
+  * @param  Halves: number of half/complete transfer flags found set by the
+  *         DMA interrupt, 0 from the Idle line interrupt.
   * @retval none.
   */
-void USART_To_USB_Send_Data(void)
+void USART_To_USB_Send_Data(uint32_t Halves)
 {
-    if (linecoding.datatype == 7)
-    {
-        USART_Rx_Buffer[USART_Rx_ptr_in] = USART_ReceiveData(VCP_USARTx) & 0x7F;
-    }
-    else if (linecoding.datatype == 8)
-    {
-        USART_Rx_Buffer[USART_Rx_ptr_in] = USART_ReceiveData(VCP_USARTx);
-    }
+    USART_Rx_Halves += Halves;
 
-    USART_Rx_ptr_in++;
-
-    /* To avoid buffer overflow */
-    if (USART_Rx_ptr_in == USART_RX_DATA_SIZE)
-    {
-        USART_Rx_ptr_in = 0;
-    }
+    RingBuffer_SetWritePosition(&USART_Rx_Ring, USART_RX_DATA_SIZE -
+                                DMA_GetCurrDataCounter(VCP_USARTx_RX_DMA_CHANNEL),
+                                USART_Rx_Halves);
 }
 
-
 /************************ (C) COPYRIGHT HK Microelectronics *****END OF FILE****/
 